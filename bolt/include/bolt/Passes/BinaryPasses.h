@@ -18,6 +18,7 @@
 #include "bolt/Core/DynoStats.h"
 #include "llvm/Support/CommandLine.h"
 #include <atomic>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_set>
@@ -353,10 +354,11 @@ public:
 /// when the target address points somewhere inside a read-only section.
 ///
 class SimplifyRODataLoads : public BinaryFunctionPass {
-  uint64_t NumLoadsSimplified{0};
-  uint64_t NumDynamicLoadsSimplified{0};
-  uint64_t NumLoadsFound{0};
-  uint64_t NumDynamicLoadsFound{0};
+  std::atomic<uint64_t> NumLoadsSimplified{0};
+  std::atomic<uint64_t> NumDynamicLoadsSimplified{0};
+  std::atomic<uint64_t> NumLoadsFound{0};
+  std::atomic<uint64_t> NumDynamicLoadsFound{0};
+  std::mutex ModifiedMutex;
   std::unordered_set<const BinaryFunction *> Modified;
 
   bool simplifyRODataLoads(BinaryFunction &BF);
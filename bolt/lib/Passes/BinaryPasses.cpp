@@ -524,13 +524,13 @@ bool ReorderBasicBlocks::modifyFunctionLayout(BinaryFunction &BF,
 }
 
 Error FixupBranches::runOnFunctions(BinaryContext &BC) {
-  for (auto &It : BC.getBinaryFunctions()) {
-    BinaryFunction &Function = It.second;
-    if (!BC.shouldEmit(Function) || !Function.isSimple())
-      continue;
-
-    Function.fixBranches();
-  }
+  ParallelUtilities::runOnEachFunction(
+      BC, ParallelUtilities::SchedulingPolicy::SP_BB_LINEAR,
+      [&](BinaryFunction &BF) { BF.fixBranches(); },
+      [&](const BinaryFunction &BF) {
+        return !BC.shouldEmit(BF) || !BF.isSimple();
+      },
+      "FixupBranches");
   return Error::success();
 }
 
@@ -1218,11 +1218,16 @@ bool SimplifyRODataLoads::simplifyRODataLoads(BinaryFunction &BF) {
 }
 
 Error SimplifyRODataLoads::runOnFunctions(BinaryContext &BC) {
-  for (auto &It : BC.getBinaryFunctions()) {
-    BinaryFunction &Function = It.second;
-    if (shouldOptimize(Function) && simplifyRODataLoads(Function))
-      Modified.insert(&Function);
-  }
+  ParallelUtilities::runOnEachFunction(
+      BC, ParallelUtilities::SchedulingPolicy::SP_INST_LINEAR,
+      [&](BinaryFunction &BF) {
+        if (simplifyRODataLoads(BF)) {
+          std::lock_guard<std::mutex> Lock(ModifiedMutex);
+          Modified.insert(&BF);
+        }
+      },
+      [&](const BinaryFunction &BF) { return !shouldOptimize(BF); },
+      "SimplifyRODataLoads");
 
   BC.outs() << "BOLT-INFO: simplified " << NumLoadsSimplified << " out of "
             << NumLoadsFound << " loads from a statically computed address.\n"
@@ -1679,10 +1684,14 @@ Error PrintProgramStats::runOnFunctions(BinaryContext &BC) {
 }
 
 Error InstructionLowering::runOnFunctions(BinaryContext &BC) {
-  for (auto &BFI : BC.getBinaryFunctions())
-    for (BinaryBasicBlock &BB : BFI.second)
-      for (MCInst &Instruction : BB)
-        BC.MIB->lowerTailCall(Instruction);
+  ParallelUtilities::runOnEachFunction(
+      BC, ParallelUtilities::SchedulingPolicy::SP_INST_LINEAR,
+      [&](BinaryFunction &BF) {
+        for (BinaryBasicBlock &BB : BF)
+          for (MCInst &Instruction : BB)
+            BC.MIB->lowerTailCall(Instruction);
+      },
+      nullptr, "InstructionLowering");
   return Error::success();
 }
 
@@ -1690,19 +1699,23 @@ Error StripRepRet::runOnFunctions(BinaryContext &BC) {
   if (!BC.isX86())
     return Error::success();
 
-  uint64_t NumPrefixesRemoved = 0;
-  uint64_t NumBytesSaved = 0;
-  for (auto &BFI : BC.getBinaryFunctions()) {
-    for (BinaryBasicBlock &BB : BFI.second) {
-      auto LastInstRIter = BB.getLastNonPseudo();
-      if (LastInstRIter == BB.rend() || !BC.MIB->isReturn(*LastInstRIter) ||
-          !BC.MIB->deleteREPPrefix(*LastInstRIter))
-        continue;
+  std::atomic<uint64_t> NumPrefixesRemoved{0};
+  std::atomic<uint64_t> NumBytesSaved{0};
+  ParallelUtilities::runOnEachFunction(
+      BC, ParallelUtilities::SchedulingPolicy::SP_BB_LINEAR,
+      [&](BinaryFunction &BF) {
+        for (BinaryBasicBlock &BB : BF) {
+          auto LastInstRIter = BB.getLastNonPseudo();
+          if (LastInstRIter == BB.rend() ||
+              !BC.MIB->isReturn(*LastInstRIter) ||
+              !BC.MIB->deleteREPPrefix(*LastInstRIter))
+            continue;
 
-      NumPrefixesRemoved += BB.getKnownExecutionCount();
-      ++NumBytesSaved;
-    }
-  }
+          NumPrefixesRemoved += BB.getKnownExecutionCount();
+          ++NumBytesSaved;
+        }
+      },
+      nullptr, "StripRepRet");
 
   if (NumBytesSaved)
     BC.outs() << "BOLT-INFO: removed " << NumBytesSaved
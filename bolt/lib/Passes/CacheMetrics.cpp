@@ -15,6 +15,7 @@
 #include "bolt/Core/BinaryBasicBlock.h"
 #include "bolt/Core/BinaryFunction.h"
 #include <unordered_map>
+#include <unordered_set>
 
 using namespace llvm;
 using namespace bolt;
@@ -187,6 +188,40 @@ double expectedCacheHitRatio(
   return 100.0 * (1.0 - Misses / TotalSamples);
 }
 
+/// Count the pages of the given size that contain executed basic blocks, in
+/// the output layout or, if \p UseInputLayout is set, in the input binary.
+/// Every such page needs an i-TLB entry while the hot code runs.
+size_t countExecutedPages(
+    const std::vector<BinaryFunction *> &BinaryFunctions,
+    const std::unordered_map<BinaryBasicBlock *, uint64_t> &BBAddr,
+    const std::unordered_map<BinaryBasicBlock *, uint64_t> &BBSize,
+    uint64_t PageSize, bool UseInputLayout) {
+  std::unordered_set<uint64_t> Pages;
+  for (BinaryFunction *BF : BinaryFunctions) {
+    for (BinaryBasicBlock &BB : *BF) {
+      if (BB.getKnownExecutionCount() == 0)
+        continue;
+      uint64_t Addr, Size;
+      if (UseInputLayout) {
+        // Skip blocks created by BOLT.
+        if (BB.getInputOffset() == BinaryBasicBlock::INVALID_OFFSET)
+          continue;
+        Addr = BF->getAddress() + BB.getInputOffset();
+        Size = BB.getOriginalSize();
+      } else {
+        Addr = BBAddr.at(&BB);
+        Size = BBSize.at(&BB);
+      }
+      if (Size == 0)
+        continue;
+      const uint64_t LastPage = (Addr + Size - 1) / PageSize;
+      for (uint64_t Page = Addr / PageSize; Page <= LastPage; ++Page)
+        Pages.insert(Page);
+    }
+  }
+  return Pages.size();
+}
+
 } // namespace
 
 void CacheMetrics::printAll(raw_ostream &OS,
@@ -250,6 +285,14 @@ void CacheMetrics::printAll(raw_ostream &OS,
   OS << "  Expected i-TLB cache hit ratio: "
      << format("%.2lf%%\n", expectedCacheHitRatio(BFs, BBAddr, BBSize));
 
+  const uint64_t HugePageSize = 2 << 20;
+  OS << format("  Executed code spans %zu 4 KiB pages and %zu 2 MiB pages "
+               "(%zu and %zu in the input binary)\n",
+               countExecutedPages(BFs, BBAddr, BBSize, ITLBPageSize, false),
+               countExecutedPages(BFs, BBAddr, BBSize, HugePageSize, false),
+               countExecutedPages(BFs, BBAddr, BBSize, ITLBPageSize, true),
+               countExecutedPages(BFs, BBAddr, BBSize, HugePageSize, true));
+
   auto Stats = calcTSPScore(BFs, BBAddr, BBSize);
   OS << "  TSP score: "
      << format("%.2lf%% (%zu out of %zu)\n",
@@ -71,6 +71,17 @@ static cl::opt<unsigned> ReorderDataMaxBytes(
     "reorder-data-max-bytes", cl::desc("maximum number of bytes to reorder"),
     cl::init(std::numeric_limits<unsigned>::max()), cl::cat(BoltOptCategory));
 
+static cl::opt<unsigned> ReorderDataMinAlignment(
+    "reorder-data-min-alignment",
+    cl::desc("minimum alignment of reordered data objects"), cl::init(16),
+    cl::cat(BoltOptCategory));
+
+static cl::opt<unsigned> ReorderDataCacheLine(
+    "reorder-data-cache-line",
+    cl::desc("cache line size; hot data objects that fit in a line are placed "
+             "so that they do not straddle two lines (0 to disable)"),
+    cl::init(64), cl::cat(BoltOptCategory));
+
 static cl::list<std::string>
 ReorderSymbols("reorder-symbols",
   cl::CommaSeparated,
@@ -98,8 +109,6 @@ namespace bolt {
 
 namespace {
 
-static constexpr uint16_t MinAlignment = 16;
-
 bool isSupported(const BinarySection &BS) { return BS.isData() && !BS.isTLS(); }
 
 bool filterSymbol(const BinaryData *BD) {
@@ -327,9 +336,6 @@ ReorderData::sortedByCount(BinaryContext &BC,
   return std::make_pair(Order, SplitPoint);
 }
 
-// TODO
-// add option for cache-line alignment (or just use cache-line when section
-// is writable)?
 void ReorderData::setSectionOrder(BinaryContext &BC,
                                   BinarySection &OutputSection,
                                   DataOrder::iterator Begin,
@@ -362,9 +368,19 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
       break;
     }
 
-    uint16_t Alignment = std::max(BD->getAlignment(), MinAlignment);
+    uint64_t Alignment = std::max<uint64_t>(BD->getAlignment(),
+                                            opts::ReorderDataMinAlignment);
     Offset = alignTo(Offset, Alignment);
 
+    // An access to a hot object that straddles two cache lines touches both.
+    // If the object fits in one line, move it to the start of the next one,
+    // provided that keeps it aligned.
+    const uint64_t Line = opts::ReorderDataCacheLine;
+    if (Line && Begin->second && BD->getSize() && BD->getSize() <= Line &&
+        Line % Alignment == 0 &&
+        Offset / Line != (Offset + BD->getSize() - 1) / Line)
+      Offset = alignTo(Offset, Line);
+
     if ((Offset + BD->getSize()) > opts::ReorderDataMaxBytes) {
       if (!NewOrder.empty())
         LLVM_DEBUG(dbgs() << "BOLT-DEBUG: processing ending on symbol "
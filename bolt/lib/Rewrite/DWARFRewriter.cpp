@@ -41,6 +41,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cstdint>
@@ -365,6 +366,14 @@ static cl::opt<unsigned> BatchSize(
         "better performance, but more memory usage. Default value is 1."),
     cl::Hidden, cl::init(1), cl::cat(BoltCategory));
 
+static cl::opt<unsigned> BatchSizeLimit(
+    "cu-processing-batch-size-limit",
+    cl::desc("Caps the combined size, in KiB of input .debug_info, of the CUs "
+             "processed in one batch, so that a larger "
+             "cu-processing-batch-size does not keep DIEs of too many big CUs "
+             "in memory at once. Default value is 0 (no limit)."),
+    cl::Hidden, cl::init(0), cl::cat(BoltCategory));
+
 static cl::opt<bool> AlwaysConvertToRanges(
     "always-convert-to-ranges",
     cl::desc("This option is for testing purposes only. It forces BOLT to "
@@ -372,6 +381,7 @@ static cl::opt<bool> AlwaysConvertToRanges(
     cl::ReallyHidden, cl::init(false), cl::cat(BoltCategory));
 
 extern cl::opt<std::string> CompDirOverride;
+extern cl::opt<bool> TimeRewrite;
 } // namespace opts
 
 /// If DW_AT_low_pc exists sets LowPC and returns true.
@@ -595,14 +605,20 @@ void DWARFRewriter::addStringHelper(DIEBuilder &DIEBldr, DIE &Die,
                        DIEInteger(NewOffset));
 }
 
+static const char TimerGroupName[] = "dwarf";
+static const char TimerGroupDesc[] = "DWARF rewriting";
+
 using DWARFUnitVec = std::vector<DWARFUnit *>;
 using CUPartitionVector = std::vector<DWARFUnitVec>;
 /// Partitions CUs in to buckets. Bucket size is controlled by
-/// cu-processing-batch-size. All the CUs that have cross CU reference reference
-/// as a source are put in to the same initial bucket.
+/// cu-processing-batch-size and cu-processing-batch-size-limit. All the CUs
+/// that have cross CU reference reference as a source are put in to the same
+/// initial bucket.
 static CUPartitionVector partitionCUs(DWARFContext &DwCtx) {
   CUPartitionVector Vec(2);
   unsigned Counter = 0;
+  uint64_t BucketSize = 0;
+  const uint64_t SizeLimit = uint64_t(opts::BatchSizeLimit) * 1024;
   const DWARFDebugAbbrev *Abbr = DwCtx.getDebugAbbrev();
   for (std::unique_ptr<DWARFUnit> &CU : DwCtx.compile_units()) {
     Expected<const DWARFAbbreviationDeclarationSet *> AbbrDeclSet =
@@ -627,10 +643,16 @@ static CUPartitionVector partitionCUs(DWARFContext &DwCtx) {
       Vec[0].push_back(CU.get());
     } else {
       ++Counter;
+      BucketSize += CU->getLength();
       Vec.back().push_back(CU.get());
     }
-    if (Counter % opts::BatchSize == 0 && !Vec.back().empty())
+    if ((Counter % opts::BatchSize == 0 ||
+         (SizeLimit && BucketSize >= SizeLimit)) &&
+        !Vec.back().empty()) {
       Vec.push_back({});
+      Counter = 0;
+      BucketSize = 0;
+    }
   }
   return Vec;
 }
@@ -797,9 +819,19 @@ void DWARFRewriter::updateDebugInfo() {
   if (SingleThreadedMode) {
     CUPartitionVector PartVec = partitionCUs(*BC.DwCtx);
     for (std::vector<DWARFUnit *> &Vec : PartVec) {
-      DIEBlder.buildCompileUnits(Vec);
-      for (DWARFUnit *CU : DIEBlder.getProcessedCUs())
-        processUnitDIE(CU, &DIEBlder);
+      {
+        NamedRegionTimer T("buildCompileUnits", "build CU DIEs",
+                           TimerGroupName, TimerGroupDesc, opts::TimeRewrite);
+        DIEBlder.buildCompileUnits(Vec);
+      }
+      {
+        NamedRegionTimer T("updateCompileUnits", "update CU DIEs",
+                           TimerGroupName, TimerGroupDesc, opts::TimeRewrite);
+        for (DWARFUnit *CU : DIEBlder.getProcessedCUs())
+          processUnitDIE(CU, &DIEBlder);
+      }
+      NamedRegionTimer T("emitCompileUnits", "emit CUs", TimerGroupName,
+                         TimerGroupDesc, opts::TimeRewrite);
       finalizeCompileUnits(DIEBlder, *Streamer, OffsetMap,
                            DIEBlder.getProcessedCUs());
     }
@@ -10,6 +10,11 @@
 //
 //   $ merge-fdata 1.fdata 2.fdata 3.fdata > merged.fdata
 //
+// With -decay, profiles are weighted by age, oldest first. This allows merging
+// new profiles into an existing one incrementally:
+//
+//   $ merge-fdata -decay=0.5 merged.fdata new.fdata -o merged.fdata
+//
 //===----------------------------------------------------------------------===//
 
 #include "bolt/Profile/ProfileYAMLMapping.h"
@@ -22,6 +27,7 @@
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/ThreadPool.h"
 #include <algorithm>
+#include <cmath>
 #include <mutex>
 #include <unordered_map>
 
@@ -68,6 +74,14 @@ SuppressMergedDataOutput("q",
   cl::Optional,
   cl::cat(MergeFdataCategory));
 
+static cl::opt<double>
+Decay("decay",
+  cl::desc("scale the counts of each input by this factor once for every "
+           "input given after it, so that older profiles, given first, weigh "
+           "less"),
+  cl::init(1.0),
+  cl::cat(MergeFdataCategory));
+
 static cl::opt<std::string>
 OutputFilePath("o",
   cl::value_desc("file"),
@@ -103,6 +117,35 @@ static raw_fd_ostream &output() {
   }
 }
 
+/// Return the weight of the input at \p Index among \p NumInputs inputs.
+static double getInputWeight(size_t Index, size_t NumInputs) {
+  return std::pow(opts::Decay.getValue(), NumInputs - 1 - Index);
+}
+
+static uint64_t scaleCount(uint64_t Count, double Weight) {
+  if (Weight == 1.0)
+    return Count;
+  return std::llround(Count * Weight);
+}
+
+void scaleFunctionProfile(BinaryFunctionProfile &BF, double Weight) {
+  if (Weight == 1.0)
+    return;
+  BF.ExecCount = scaleCount(BF.ExecCount, Weight);
+  for (BinaryBasicBlockProfile &BB : BF.Blocks) {
+    BB.ExecCount = scaleCount(BB.ExecCount, Weight);
+    BB.EventCount = scaleCount(BB.EventCount, Weight);
+    for (CallSiteInfo &CSI : BB.CallSites) {
+      CSI.Count = scaleCount(CSI.Count, Weight);
+      CSI.Mispreds = scaleCount(CSI.Mispreds, Weight);
+    }
+    for (SuccessorInfo &SI : BB.Successors) {
+      SI.Count = scaleCount(SI.Count, Weight);
+      SI.Mispreds = scaleCount(SI.Mispreds, Weight);
+    }
+  }
+}
+
 void mergeProfileHeaders(BinaryProfileHeader &MergedHeader,
                          const BinaryProfileHeader &Header) {
   if (MergedHeader.FileName.empty())
@@ -264,7 +307,8 @@ void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames) {
   std::mutex BoltedCollectionMutex;
   typedef StringMap<uint64_t> ProfileTy;
 
-  auto ParseProfile = [&](const std::string &Filename, auto &Profiles) {
+  auto ParseProfile = [&](const std::string &Filename, double Weight,
+                          auto &Profiles) {
     const llvm::thread::id tid = llvm::this_thread::get_id();
 
     if (isYAML(Filename))
@@ -307,7 +351,7 @@ void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames) {
       uint64_t Count;
       if (Line.substr(Pos + 1, Line.size() - Pos).getAsInteger(10, Count))
         report_error(Filename, "Malformed / corrupted profile counter");
-      Count += Profile->lookup(Signature);
+      Count = scaleCount(Count, Weight) + Profile->lookup(Signature);
       Profile->insert_or_assign(Signature, Count);
     }
   };
@@ -319,8 +363,9 @@ void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames) {
   DefaultThreadPool Pool(S);
   DenseMap<llvm::thread::id, ProfileTy> ParsedProfiles(
       Pool.getMaxConcurrency());
-  for (const auto &Filename : Filenames)
-    Pool.async(ParseProfile, std::cref(Filename), std::ref(ParsedProfiles));
+  for (size_t I = 0, E = Filenames.size(); I != E; ++I)
+    Pool.async(ParseProfile, std::cref(Filenames[I]),
+               getInputWeight(I, Filenames.size()), std::ref(ParsedProfiles));
   Pool.wait();
 
   ProfileTy MergedProfile;
@@ -354,6 +399,9 @@ int main(int argc, char **argv) {
 
   ToolName = argv[0];
 
+  if (!(opts::Decay > 0.0 && opts::Decay <= 1.0))
+    report_error("-decay", "must be in (0, 1]");
+
   // Recursively expand input directories into input file lists.
   SmallVector<std::string> Inputs;
   for (std::string &InputDataFilename : opts::InputDataFilenames) {
@@ -386,7 +434,8 @@ int main(int argc, char **argv) {
   // Merged information for all functions.
   StringMap<BinaryFunctionProfile> MergedBFs;
 
-  for (std::string &InputDataFilename : Inputs) {
+  for (size_t I = 0, E = Inputs.size(); I != E; ++I) {
+    const std::string &InputDataFilename = Inputs[I];
     ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
         MemoryBuffer::getFileOrSTDIN(InputDataFilename);
     if (std::error_code EC = MB.getError())
@@ -411,7 +460,9 @@ int main(int argc, char **argv) {
     mergeProfileHeaders(MergedHeader, BP.Header);
 
     // Do the function merge.
+    const double Weight = getInputWeight(I, Inputs.size());
     for (BinaryFunctionProfile &BF : BP.Functions) {
+      scaleFunctionProfile(BF, Weight);
       if (!MergedBFs.count(BF.Name)) {
         MergedBFs.insert(std::make_pair(BF.Name, BF));
         continue;
@@ -424,7 +424,7 @@ ClangTidyASTConsumerFactory::createASTConsumer(
   std::unique_ptr<ClangTidyProfiling> Profiling;
   if (Context.getEnableProfiling()) {
     Profiling = std::make_unique<ClangTidyProfiling>(
-        Context.getProfileStorageParams());
+        Context.getProfileStorageParams(), Context.getAggregatedProfile());
     FinderOptions.CheckProfiling.emplace(Profiling->Records);
   }
 
@@ -557,6 +557,17 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
   Context.setEnableProfiling(EnableCheckProfile);
   Context.setProfileStoragePrefix(StoreCheckProfile);
 
+  // When profiling several files, also report the totals over all of them
+  // once the last one is done.
+  std::optional<ClangTidyProfiling> TotalProfiling;
+  if (EnableCheckProfile && InputFiles.size() > 1) {
+    std::optional<ClangTidyProfiling::StorageParams> Storage;
+    if (!StoreCheckProfile.empty())
+      Storage.emplace(StoreCheckProfile, "all-files");
+    TotalProfiling.emplace(std::move(Storage));
+    Context.setAggregatedProfile(&TotalProfiling->Records);
+  }
+
   ClangTidyDiagnosticConsumer DiagConsumer(Context, nullptr, true, ApplyAnyFix);
   DiagnosticsEngine DE(new DiagnosticIDs(), new DiagnosticOptions(),
                        &DiagConsumer, /*ShouldOwnClient=*/false);
@@ -600,6 +611,7 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
 
   ActionFactory Factory(Context, std::move(BaseFS));
   Tool.run(&Factory);
+  Context.setAggregatedProfile(nullptr);
   return DiagConsumer.take();
 }
 
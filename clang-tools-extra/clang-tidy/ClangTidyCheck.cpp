@@ -11,6 +11,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/YAMLParser.h"
+#include <chrono>
 #include <optional>
 
 namespace clang::tidy {
@@ -43,7 +44,26 @@ void ClangTidyCheck::run(const ast_matchers::MatchFinder::MatchResult &Result) {
   // For historical reasons, checks don't implement the MatchFinder run()
   // callback directly. We keep the run()/check() distinction to avoid interface
   // churn, and to allow us to add cross-cutting logic in the future.
+  std::chrono::milliseconds Budget = Context->getCheckTimeBudget();
+  if (Budget.count() == 0) {
+    check(Result);
+    return;
+  }
+
+  // A check is created for each translation unit, so the budget applies to
+  // one translation unit at a time.
+  if (OverBudget)
+    return;
+  auto Start = std::chrono::steady_clock::now();
   check(Result);
+  TimeSpent += std::chrono::steady_clock::now() - Start;
+  if (TimeSpent > Budget) {
+    OverBudget = true;
+    configurationDiag("check '%0' exceeded its time budget of %1ms and is "
+                      "disabled for the rest of '%2'")
+        << CheckName << static_cast<unsigned>(Budget.count())
+        << getCurrentMainFile();
+  }
 }
 
 ClangTidyCheck::OptionsView::OptionsView(
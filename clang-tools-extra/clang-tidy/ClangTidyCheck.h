@@ -13,6 +13,7 @@
 #include "ClangTidyOptions.h"
 #include "clang/ASTMatchers/ASTMatchFinder.h"
 #include "clang/Basic/Diagnostic.h"
+#include <chrono>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -485,6 +486,9 @@ private:
   void run(const ast_matchers::MatchFinder::MatchResult &Result) override;
   std::string CheckName;
   ClangTidyContext *Context;
+  // Time spent in check() so far, compared against the context's budget.
+  std::chrono::steady_clock::duration TimeSpent{};
+  bool OverBudget = false;
 
 protected:
   OptionsView Options;
@@ -18,6 +18,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Regex.h"
+#include <chrono>
 #include <optional>
 
 namespace clang {
@@ -174,6 +175,10 @@ public:
   /// counters.
   const ClangTidyStats &getStats() const { return Stats; }
 
+  /// Adds the counters of another context, e.g. one that processed some of the
+  /// input files on another thread.
+  void addStats(const ClangTidyStats &Other);
+
   /// Control profile collection in clang-tidy.
   void setEnableProfiling(bool Profile);
   bool getEnableProfiling() const { return Profile; }
@@ -183,6 +188,24 @@ public:
   std::optional<ClangTidyProfiling::StorageParams>
   getProfileStorageParams() const;
 
+  /// If set, the profile of each translation unit is also added to these
+  /// records.
+  void setAggregatedProfile(llvm::StringMap<llvm::TimeRecord> *Records) {
+    AggregatedProfile = Records;
+  }
+  llvm::StringMap<llvm::TimeRecord> *getAggregatedProfile() const {
+    return AggregatedProfile;
+  }
+
+  /// Control the time a check may spend in its callbacks in one translation
+  /// unit before it is disabled for the rest of it. Zero means no limit.
+  void setCheckTimeBudget(std::chrono::milliseconds Budget) {
+    CheckTimeBudget = Budget;
+  }
+  std::chrono::milliseconds getCheckTimeBudget() const {
+    return CheckTimeBudget;
+  }
+
   /// Should be called when starting to process new translation unit.
   void setCurrentBuildDirectory(StringRef BuildDirectory) {
     CurrentBuildDirectory = std::string(BuildDirectory);
@@ -250,6 +273,8 @@ private:
 
   bool Profile = false;
   std::string ProfilePrefix;
+  llvm::StringMap<llvm::TimeRecord> *AggregatedProfile = nullptr;
+  std::chrono::milliseconds CheckTimeBudget{0};
 
   bool AllowEnablingAnalyzerAlphaCheckers;
   bool EnableModuleHeadersParsing;
@@ -74,10 +74,16 @@ void ClangTidyProfiling::storeProfileData() {
   printAsJSON(OS);
 }
 
-ClangTidyProfiling::ClangTidyProfiling(std::optional<StorageParams> Storage)
-    : Storage(std::move(Storage)) {}
+ClangTidyProfiling::ClangTidyProfiling(
+    std::optional<StorageParams> Storage,
+    llvm::StringMap<llvm::TimeRecord> *Aggregate)
+    : Storage(std::move(Storage)), Aggregate(Aggregate) {}
 
 ClangTidyProfiling::~ClangTidyProfiling() {
+  if (Aggregate)
+    for (const auto &Record : Records)
+      (*Aggregate)[Record.getKey()] += Record.getValue();
+
   TG.emplace("clang-tidy", "clang-tidy checks profiling", Records);
 
   if (!Storage)
@@ -38,6 +38,8 @@ private:
 
   std::optional<StorageParams> Storage;
 
+  llvm::StringMap<llvm::TimeRecord> *Aggregate = nullptr;
+
   void printUserFriendlyTable(llvm::raw_ostream &OS);
   void printAsJSON(llvm::raw_ostream &OS);
 
@@ -48,7 +50,10 @@ public:
 
   ClangTidyProfiling() = default;
 
-  ClangTidyProfiling(std::optional<StorageParams> Storage);
+  /// If \p Aggregate is set, the records are also added to it on destruction,
+  /// to report the totals over several translation units.
+  ClangTidyProfiling(std::optional<StorageParams> Storage,
+                     llvm::StringMap<llvm::TimeRecord> *Aggregate = nullptr);
 
   ~ClangTidyProfiling();
 };
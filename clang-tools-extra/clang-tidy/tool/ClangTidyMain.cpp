@@ -25,7 +25,10 @@
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/WithColor.h"
+#include <atomic>
 #include <optional>
 
 using namespace clang::tooling;
@@ -253,6 +256,26 @@ these per-TU profiles are instead stored as JSON.
                                               cl::value_desc("prefix"),
                                               cl::cat(ClangTidyCategory));
 
+static cl::opt<unsigned> CheckTimeBudget("check-time-budget", desc(R"(
+Maximum time in milliseconds a check may spend
+handling matches in one translation unit. A
+check that exceeds it is disabled for the rest
+of that translation unit, with a warning.
+0 means no limit.
+)"),
+                                         cl::init(0),
+                                         cl::value_desc("ms"),
+                                         cl::cat(ClangTidyCategory));
+
+static cl::opt<unsigned> Jobs("j", desc(R"(
+Number of files to process in parallel, each on
+its own thread. Diagnostics in headers shared by
+several files are reported once. 0 uses all
+hardware threads.
+)"),
+                              cl::init(1), cl::value_desc("jobs"),
+                              cl::cat(ClangTidyCategory));
+
 /// This option allows enabling the experimental alpha checkers from the static
 /// analyzer. This option is set to false and not visible in help, because it is
 /// highly not recommended for users.
@@ -511,9 +534,11 @@ static SmallString<256> makeAbsolute(llvm::StringRef Input) {
   return AbsolutePath;
 }
 
-static llvm::IntrusiveRefCntPtr<vfs::OverlayFileSystem> createBaseFS() {
+static llvm::IntrusiveRefCntPtr<vfs::OverlayFileSystem>
+createBaseFS(llvm::IntrusiveRefCntPtr<vfs::FileSystem> RealFS =
+                 vfs::getRealFileSystem()) {
   llvm::IntrusiveRefCntPtr<vfs::OverlayFileSystem> BaseFS(
-      new vfs::OverlayFileSystem(vfs::getRealFileSystem()));
+      new vfs::OverlayFileSystem(std::move(RealFS)));
 
   if (!VfsOverlay.empty()) {
     IntrusiveRefCntPtr<vfs::FileSystem> VfsFromFile =
@@ -525,6 +550,76 @@ static llvm::IntrusiveRefCntPtr<vfs::OverlayFileSystem> createBaseFS() {
   return BaseFS;
 }
 
+/// Runs clang-tidy on \p InputFiles with \p NumJobs threads, each pulling the
+/// next file from a shared counter. Workers have their own context and file
+/// system, since both keep per-file state: ClangTool changes the working
+/// directory for every compile command, and the real file system would do so
+/// for the whole process. Statistics are added to \p Context.
+static std::optional<std::vector<ClangTidyError>>
+runClangTidyInParallel(ClangTidyContext &Context,
+                       const CompilationDatabase &Compilations,
+                       ArrayRef<std::string> InputFiles, unsigned NumJobs,
+                       StringRef ProfilePrefix) {
+  struct Worker {
+    llvm::IntrusiveRefCntPtr<vfs::OverlayFileSystem> BaseFS;
+    std::unique_ptr<ClangTidyContext> Context;
+    std::vector<ClangTidyError> Errors;
+  };
+  std::vector<Worker> Workers(NumJobs);
+  for (Worker &W : Workers) {
+    W.BaseFS = createBaseFS(vfs::createPhysicalFileSystem());
+    if (!W.BaseFS)
+      return std::nullopt;
+    auto OptionsProvider = createOptionsProvider(W.BaseFS);
+    if (!OptionsProvider)
+      return std::nullopt;
+    W.Context = std::make_unique<ClangTidyContext>(
+        std::move(OptionsProvider), AllowEnablingAnalyzerAlphaCheckers,
+        EnableModuleHeadersParsing);
+    W.Context->setCheckTimeBudget(Context.getCheckTimeBudget());
+  }
+
+  std::atomic<size_t> NextFile = 0;
+  {
+    llvm::DefaultThreadPool Pool(llvm::hardware_concurrency(NumJobs));
+    for (Worker &W : Workers)
+      Pool.async([&, &W] {
+        for (size_t I = NextFile++; I < InputFiles.size(); I = NextFile++) {
+          std::vector<ClangTidyError> Errors =
+              runClangTidy(*W.Context, Compilations, InputFiles[I], W.BaseFS,
+                           FixNotes, EnableCheckProfile, ProfilePrefix);
+          W.Errors.insert(W.Errors.end(),
+                          std::make_move_iterator(Errors.begin()),
+                          std::make_move_iterator(Errors.end()));
+        }
+      });
+    Pool.wait();
+  }
+
+  std::vector<ClangTidyError> Errors;
+  for (Worker &W : Workers) {
+    Context.addStats(W.Context->getStats());
+    Errors.insert(Errors.end(), std::make_move_iterator(W.Errors.begin()),
+                  std::make_move_iterator(W.Errors.end()));
+  }
+  // A diagnostic in a header is reported by every file including it.
+  auto Key = [](const ClangTidyError &E) {
+    return std::tie(E.Message.FilePath, E.Message.FileOffset, E.DiagnosticName,
+                    E.Message.Message);
+  };
+  llvm::stable_sort(Errors, [&](const ClangTidyError &L,
+                                const ClangTidyError &R) {
+    return Key(L) < Key(R);
+  });
+  Errors.erase(std::unique(Errors.begin(), Errors.end(),
+                           [&](const ClangTidyError &L,
+                               const ClangTidyError &R) {
+                             return Key(L) == Key(R);
+                           }),
+               Errors.end());
+  return Errors;
+}
+
 int clangTidyMain(int argc, const char **argv) {
   llvm::InitLLVM X(argc, argv);
 
@@ -652,9 +747,31 @@ int clangTidyMain(int argc, const char **argv) {
   ClangTidyContext Context(std::move(OwningOptionsProvider),
                            AllowEnablingAnalyzerAlphaCheckers,
                            EnableModuleHeadersParsing);
-  std::vector<ClangTidyError> Errors =
-      runClangTidy(Context, OptionsParser->getCompilations(), PathList, BaseFS,
-                   FixNotes, EnableCheckProfile, ProfilePrefix);
+  Context.setCheckTimeBudget(std::chrono::milliseconds(CheckTimeBudget));
+
+  unsigned NumJobs = std::min<size_t>(
+      Jobs ? Jobs : llvm::hardware_concurrency().compute_thread_count(),
+      PathList.size());
+  if (NumJobs > 1 && EnableCheckProfile && StoreCheckProfile.empty()) {
+    llvm::WithColor::warning()
+        << "-enable-check-profile prints its reports to stderr; processing "
+           "files one at a time, use -store-check-profile to run in "
+           "parallel\n";
+    NumJobs = 1;
+  }
+
+  std::vector<ClangTidyError> Errors;
+  if (NumJobs > 1) {
+    auto ParallelErrors =
+        runClangTidyInParallel(Context, OptionsParser->getCompilations(),
+                               PathList, NumJobs, ProfilePrefix);
+    if (!ParallelErrors)
+      return 1;
+    Errors = std::move(*ParallelErrors);
+  } else {
+    Errors = runClangTidy(Context, OptionsParser->getCompilations(), PathList,
+                          BaseFS, FixNotes, EnableCheckProfile, ProfilePrefix);
+  }
   bool FoundErrors = llvm::any_of(Errors, [](const ClangTidyError &E) {
     return E.DiagLevel == ClangTidyError::Error;
   });
@@ -216,6 +216,7 @@ public:
     if (Handler != Server.Handlers.NotificationHandlers.end()) {
       Handler->second(std::move(Params));
       Server.maybeExportMemoryProfile();
+      Server.maybeEnforceMemoryLimit();
       Server.maybeCleanupMemory();
     } else if (!Server.Server) {
       elog("Notification {0} before initialization", Method);
@@ -1440,6 +1441,12 @@ void ClangdLSPServer::maybeExportMemoryProfile() {
   record(MT, "clangd_lsp_server", MemoryUsage);
 }
 
+void ClangdLSPServer::maybeEnforceMemoryLimit() {
+  if (!Server || !Opts.MemoryLimit || !ShouldEnforceMemoryLimit())
+    return;
+  Server->enforceMemoryLimit();
+}
+
 void ClangdLSPServer::maybeCleanupMemory() {
   if (!Opts.MemoryCleanup || !ShouldCleanupMemory())
     return;
@@ -1634,6 +1641,7 @@ ClangdLSPServer::ClangdLSPServer(Transport &Transp, const ThreadsafeFS &TFS,
                     /*Delay=*/std::chrono::minutes(1)),
       ShouldCleanupMemory(/*Period=*/std::chrono::minutes(1),
                           /*Delay=*/std::chrono::minutes(1)),
+      ShouldEnforceMemoryLimit(/*Period=*/std::chrono::seconds(10)),
       BackgroundContext(Context::current().clone()), Transp(Transp),
       MsgHandler(new MessageHandler(*this)), TFS(TFS),
       SupportedSymbolKinds(defaultSymbolKinds()),
@@ -219,6 +219,10 @@ private:
   void maybeCleanupMemory();
   PeriodicThrottler ShouldCleanupMemory;
 
+  /// Runs ClangdServer::enforceMemoryLimit() if it hasn't happened recently.
+  void maybeEnforceMemoryLimit();
+  PeriodicThrottler ShouldEnforceMemoryLimit;
+
   /// Since initialization of CDBs and ClangdServer is done lazily, the
   /// following context captures the one used while creating ClangdLSPServer and
   /// passes it to above mentioned object instances to make sure they share the
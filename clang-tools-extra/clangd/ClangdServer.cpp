@@ -147,6 +147,14 @@ struct UpdateIndexCallbacks : public ParsingCallbacks {
       });
   }
 
+  void onEarlyDiagnostics(PathRef Path, llvm::StringRef Version,
+                          std::vector<Diag> Diags,
+                          PublishFn Publish) override {
+    if (ServerCallbacks)
+      Publish(
+          [&]() { ServerCallbacks->onDiagnosticsReady(Path, Version, Diags); });
+  }
+
   void onFailedAST(PathRef Path, llvm::StringRef Version,
                    std::vector<Diag> Diags, PublishFn Publish) override {
     if (ServerCallbacks)
@@ -208,6 +216,7 @@ ClangdServer::Options::operator TUScheduler::Options() const {
   Opts.UpdateDebounce = UpdateDebounce;
   Opts.ContextProvider = ContextProvider;
   Opts.PreambleThrottler = PreambleThrottler;
+  Opts.EarlyBodyDiagnostics = EarlyBodyDiagnostics;
   return Opts;
 }
 
@@ -222,6 +231,8 @@ ClangdServer::ClangdServer(const GlobalCompilationDatabase &CDB,
       PreambleParseForwardingFunctions(Opts.PreambleParseForwardingFunctions),
       ImportInsertions(Opts.ImportInsertions),
       PublishInactiveRegions(Opts.PublishInactiveRegions),
+      MemoryLimit(Opts.MemoryLimit),
+      StorePreamblesInMemory(Opts.StorePreamblesInMemory),
       WorkspaceRoot(Opts.WorkspaceRoot),
       Transient(Opts.ImplicitCancellation ? TUScheduler::InvalidateOnUpdate
                                           : TUScheduler::NoInvalidation),
@@ -1161,5 +1172,27 @@ void ClangdServer::profile(MemoryTree &MT) const {
     BackgroundIdx->profile(MT.child("background_index"));
   WorkScheduler->profile(MT.child("tuscheduler"));
 }
+
+void ClangdServer::enforceMemoryLimit() {
+  static constexpr trace::Metric MemoryLimitExceeded(
+      "memory_limit_exceeded", trace::Metric::Counter);
+  if (!MemoryLimit)
+    return;
+  trace::Span Tracer("EnforceMemoryLimit");
+  MemoryTree MT;
+  profile(MT);
+  std::size_t Used = MT.total();
+  // Only go back to in-memory preambles with some headroom, so that we don't
+  // alternate between the two on every check.
+  if (StorePreamblesInMemory)
+    WorkScheduler->setStorePreamblesInMemory(Used < MemoryLimit / 10 * 9);
+  if (Used <= MemoryLimit)
+    return;
+  std::size_t Released = WorkScheduler->releaseIdleASTs(Used - MemoryLimit);
+  MemoryLimitExceeded.record(1);
+  log("Memory usage of {0}MB exceeds the limit of {1}MB, released {2}MB of "
+      "idle ASTs",
+      Used >> 20, MemoryLimit >> 20, Released >> 20);
+}
 } // namespace clangd
 } // namespace clang
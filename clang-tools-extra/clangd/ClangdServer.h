@@ -109,6 +109,10 @@ public:
     /// Cached preambles are potentially large. If false, store them on disk.
     bool StorePreamblesInMemory = true;
 
+    /// If non-zero, the number of bytes that idle ASTs, preambles and indexes
+    /// together should stay below. See enforceMemoryLimit().
+    std::size_t MemoryLimit = 0;
+
     /// This throttler controls which preambles may be built at a given time.
     clangd::PreambleThrottler *PreambleThrottler = nullptr;
 
@@ -185,6 +189,13 @@ public:
     /// regions in the document.
     bool PublishInactiveRegions = false;
 
+  std::size_t MemoryLimit = 0;
+  bool StorePreamblesInMemory = true;
+
+    /// Publish early diagnostics for edits within a function body by parsing
+    /// only that body, before rebuilding the whole AST.
+    bool EarlyBodyDiagnostics = false;
+
     explicit operator TUScheduler::Options() const;
   };
   // Sensible default options for use in tests.
@@ -456,6 +467,12 @@ public:
   /// Builds a nested representation of memory used by components.
   void profile(MemoryTree &MT) const;
 
+  /// If the memory reported by profile() exceeds Options::MemoryLimit, drops
+  /// idle ASTs until it fits and stores further preambles on disk until usage
+  /// falls well below the limit again. Like profile(), this must be called
+  /// from the thread that updates files.
+  void enforceMemoryLimit();
+
 private:
   FeatureModuleSet *FeatureModules;
   const GlobalCompilationDatabase &CDB;
@@ -23,6 +23,8 @@
 #include "clang/Frontend/PrecompiledPreamble.h"
 #include "clang/Tooling/CompilationDatabase.h"
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace clang {
@@ -60,6 +62,10 @@ struct ParseInputs {
   TidyProviderRef ClangTidyProvider = {};
   // Used to acquire ASTListeners when parsing files.
   FeatureModuleSet *FeatureModules = nullptr;
+  // If set, only the bodies of functions declared within this range of main
+  // file offsets are parsed; all other bodies are skipped. The resulting AST
+  // is incomplete and only suitable for diagnosing the parsed bodies.
+  std::optional<std::pair<unsigned, unsigned>> ParseBodiesIn;
 };
 
 /// Clears \p CI from options that are not supported by clangd, like codegen or
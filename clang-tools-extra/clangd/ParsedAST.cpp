@@ -93,8 +93,10 @@ template <class T> std::size_t getUsedBytes(const std::vector<T> &Vec) {
 
 class DeclTrackingASTConsumer : public ASTConsumer {
 public:
-  DeclTrackingASTConsumer(std::vector<Decl *> &TopLevelDecls)
-      : TopLevelDecls(TopLevelDecls) {}
+  DeclTrackingASTConsumer(
+      std::vector<Decl *> &TopLevelDecls,
+      std::optional<std::pair<unsigned, unsigned>> ParseBodiesIn)
+      : TopLevelDecls(TopLevelDecls), ParseBodiesIn(ParseBodiesIn) {}
 
   bool HandleTopLevelDecl(DeclGroupRef DG) override {
     for (Decl *D : DG) {
@@ -114,22 +116,41 @@ public:
     return true;
   }
 
+  // Only consulted when SkipFunctionBodies is set, i.e. for ParseBodiesIn.
+  bool shouldSkipFunctionBody(Decl *D) override {
+    if (!ParseBodiesIn)
+      return true;
+    auto &SM = D->getASTContext().getSourceManager();
+    SourceLocation Loc = SM.getFileLoc(D->getLocation());
+    if (!SM.isWrittenInMainFile(Loc))
+      return true;
+    unsigned Offset = SM.getFileOffset(Loc);
+    return Offset < ParseBodiesIn->first || Offset > ParseBodiesIn->second;
+  }
+
 private:
   std::vector<Decl *> &TopLevelDecls;
+  std::optional<std::pair<unsigned, unsigned>> ParseBodiesIn;
 };
 
 class ClangdFrontendAction : public SyntaxOnlyAction {
 public:
+  ClangdFrontendAction(
+      std::optional<std::pair<unsigned, unsigned>> ParseBodiesIn)
+      : ParseBodiesIn(ParseBodiesIn) {}
+
   std::vector<Decl *> takeTopLevelDecls() { return std::move(TopLevelDecls); }
 
 protected:
   std::unique_ptr<ASTConsumer>
   CreateASTConsumer(CompilerInstance &CI, llvm::StringRef InFile) override {
-    return std::make_unique<DeclTrackingASTConsumer>(/*ref*/ TopLevelDecls);
+    return std::make_unique<DeclTrackingASTConsumer>(/*ref*/ TopLevelDecls,
+                                                     ParseBodiesIn);
   }
 
 private:
   std::vector<Decl *> TopLevelDecls;
+  std::optional<std::pair<unsigned, unsigned>> ParseBodiesIn;
 };
 
 // When using a preamble, only preprocessor events outside its bounds are seen.
@@ -430,6 +451,8 @@ ParsedAST::build(llvm::StringRef Filename, const ParseInputs &Inputs,
   // This is on-by-default in windows to allow parsing SDK headers, but it
   // breaks many features. Disable it for the main-file (not preamble).
   CI->getLangOpts().DelayedTemplateParsing = false;
+  // Only the bodies selected by the consumer are parsed, see ParseBodiesIn.
+  CI->getFrontendOpts().SkipFunctionBodies = Inputs.ParseBodiesIn.has_value();
 
   std::vector<std::unique_ptr<FeatureModule::ASTListener>> ASTListeners;
   if (Inputs.FeatureModules) {
@@ -501,7 +524,7 @@ ParsedAST::build(llvm::StringRef Filename, const ParseInputs &Inputs,
       applyWarningOptions(*ClangTidyOpts.ExtraArgs, TidyGroups, Diags);
   }
 
-  auto Action = std::make_unique<ClangdFrontendAction>();
+  auto Action = std::make_unique<ClangdFrontendAction>(Inputs.ParseBodiesIn);
   const FrontendInputFile &MainInput = Clang->getFrontendOpts().Inputs[0];
   if (!Action->BeginSourceFile(*Clang, MainInput)) {
     log("BeginSourceFile() failed when building AST for {0}",
@@ -78,11 +78,31 @@ namespace clang {
 namespace clangd {
 namespace {
 
+// Whether Arg only controls which warnings are emitted. Warning flags do not
+// affect the preamble AST, and when a preamble is loaded the diagnostic state
+// starts from the current command line, so they need not match. Flags that
+// turn warnings into errors do matter, since errors in the preamble are
+// reported at the #include that led to them.
+bool isWarningFlag(llvm::StringRef Arg) {
+  if (Arg == "-w" || Arg == "-pedantic" || Arg == "-Wpedantic")
+    return true;
+  if (!Arg.consume_front("-W") || Arg.empty())
+    return false;
+  // -Wl,<arg>, -Wa,<arg> and -Wp,<arg> pass arguments to other tools.
+  if (Arg.contains(','))
+    return false;
+  Arg.consume_front("no-");
+  return !Arg.starts_with("error") && !Arg.starts_with("fatal-errors");
+}
+
 bool compileCommandsAreEqual(const tooling::CompileCommand &LHS,
                              const tooling::CompileCommand &RHS) {
   // We don't check for Output, it should not matter to clangd.
-  return LHS.Directory == RHS.Directory && LHS.Filename == RHS.Filename &&
-         llvm::ArrayRef(LHS.CommandLine).equals(RHS.CommandLine);
+  if (LHS.Directory != RHS.Directory || LHS.Filename != RHS.Filename)
+    return false;
+  auto IsSignificant = [](llvm::StringRef Arg) { return !isWarningFlag(Arg); };
+  return llvm::equal(llvm::make_filter_range(LHS.CommandLine, IsSignificant),
+                     llvm::make_filter_range(RHS.CommandLine, IsSignificant));
 }
 
 class CppFilePreambleCallbacks : public PreambleCallbacks {
@@ -692,6 +712,7 @@ buildPreamble(PathRef FileName, CompilerInvocation CI,
     auto Result = std::make_shared<PreambleData>(std::move(*BuiltPreamble));
     Result->Version = Inputs.Version;
     Result->CompileCommand = Inputs.CompileCommand;
+    Result->StoredInMemory = StoreInMemory;
     Result->Diags = std::move(Diags);
     Result->Includes = CapturedInfo.takeIncludes();
     Result->Pragmas = std::make_shared<const include_cleaner::PragmaIncludes>(
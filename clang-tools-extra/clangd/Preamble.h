@@ -103,6 +103,8 @@ struct PreambleData {
   // same target (without reparsing CompileCommand).
   std::shared_ptr<TargetOptions> TargetOpts = nullptr;
   PrecompiledPreamble Preamble;
+  // Whether Preamble is kept in memory rather than in a temporary file.
+  bool StoredInMemory = false;
   std::vector<Diag> Diags;
   // Processes like code completions and go-to-definitions will need #include
   // information, and their compile action skips preamble range.
@@ -53,6 +53,7 @@
 #include "Diagnostics.h"
 #include "GlobalCompilationDatabase.h"
 #include "ParsedAST.h"
+#include "Protocol.h"
 #include "Preamble.h"
 #include "clang-include-cleaner/Record.h"
 #include "support/Cancellation.h"
@@ -63,6 +64,9 @@
 #include "support/ThreadCrashReporter.h"
 #include "support/Threading.h"
 #include "support/Trace.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/Stmt.h"
 #include "clang/Basic/Stack.h"
 #include "clang/Frontend/CompilerInvocation.h"
 #include "clang/Tooling/CompilationDatabase.h"
@@ -116,6 +120,12 @@ constexpr trace::Metric PreambleBuildSize("preamble_build_size",
 constexpr trace::Metric PreambleSerializedSize("preamble_serialized_size",
                                                trace::Metric::Distribution);
 
+// Time from scheduling a request on an ASTWorker until it starts running, in
+// seconds. For updates, this includes the debounce delay.
+constexpr trace::Metric RequestQueueLatency("ast_request_queue_latency",
+                                            trace::Metric::Distribution,
+                                            "request_kind");
+
 void reportPreambleBuild(const PreambleBuildStats &Stats,
                          bool IsFirstPreamble) {
   auto RecordWithLabel = [&Stats](llvm::StringRef Label) {
@@ -152,33 +162,53 @@ class TUScheduler::ASTCache {
 public:
   using Key = const ASTWorker *;
 
-  ASTCache(unsigned MaxRetainedASTs) : MaxRetainedASTs(MaxRetainedASTs) {}
+  ASTCache(const ASTRetentionPolicy &Policy)
+      : MaxRetainedASTs(Policy.MaxRetainedASTs),
+        MaxRetainedBytes(Policy.MaxRetainedBytes) {}
 
   /// Returns result of getUsedBytes() for the AST cached by \p K.
   /// If no AST is cached, 0 is returned.
   std::size_t getUsedBytes(Key K) {
     std::lock_guard<std::mutex> Lock(Mut);
     auto It = findByKey(K);
-    if (It == LRU.end() || !It->second)
+    if (It == LRU.end())
       return 0;
-    return It->second->getUsedBytes();
+    return It->Bytes;
   }
 
-  /// Store the value in the pool, possibly removing the last used AST.
+  /// Store the value in the pool, possibly removing the least recently used
+  /// ASTs to stay within the limits of the retention policy.
   /// The value should not be in the pool when this function is called.
   void put(Key K, std::unique_ptr<ParsedAST> V) {
+    std::size_t Bytes = V ? V->getUsedBytes() : 0;
     std::unique_lock<std::mutex> Lock(Mut);
     assert(findByKey(K) == LRU.end());
 
-    LRU.insert(LRU.begin(), {K, std::move(V)});
-    if (LRU.size() <= MaxRetainedASTs)
-      return;
-    // We're past the limit, remove the last element.
-    std::unique_ptr<ParsedAST> ForCleanup = std::move(LRU.back().second);
-    LRU.pop_back();
-    // Run the expensive destructor outside the lock.
+    LRU.insert(LRU.begin(), {K, std::move(V), Bytes});
+    TotalBytes += Bytes;
+    std::vector<std::unique_ptr<ParsedAST>> ForCleanup;
+    while (LRU.size() > MaxRetainedASTs ||
+           (MaxRetainedBytes && TotalBytes > MaxRetainedBytes &&
+            LRU.size() > 1))
+      ForCleanup.push_back(popLeastRecentlyUsed());
+    // Run the expensive destructors outside the lock.
+    Lock.unlock();
+    ForCleanup.clear();
+  }
+
+  /// Removes the least recently used values until at least \p Bytes have been
+  /// released or the pool is empty. Returns the number of bytes released.
+  std::size_t release(std::size_t Bytes) {
+    std::unique_lock<std::mutex> Lock(Mut);
+    std::size_t Released = 0;
+    std::vector<std::unique_ptr<ParsedAST>> ForCleanup;
+    while (Released < Bytes && !LRU.empty()) {
+      Released += LRU.back().Bytes;
+      ForCleanup.push_back(popLeastRecentlyUsed());
+    }
     Lock.unlock();
-    ForCleanup.reset();
+    ForCleanup.clear();
+    return Released;
   }
 
   /// Returns the cached value for \p K, or std::nullopt if the value is not in
@@ -197,7 +227,8 @@ public:
     }
     if (AccessMetric)
       AccessMetric->record(1, "hit");
-    std::unique_ptr<ParsedAST> V = std::move(Existing->second);
+    std::unique_ptr<ParsedAST> V = std::move(Existing->AST);
+    TotalBytes -= Existing->Bytes;
     LRU.erase(Existing);
     // GCC 4.8 fails to compile `return V;`, as it tries to call the copy
     // constructor of unique_ptr, so we call the move ctor explicitly to avoid
@@ -206,17 +237,31 @@ public:
   }
 
 private:
-  using KVPair = std::pair<Key, std::unique_ptr<ParsedAST>>;
+  struct Entry {
+    Key K;
+    std::unique_ptr<ParsedAST> AST;
+    // Result of AST->getUsedBytes() when the entry was added.
+    std::size_t Bytes;
+  };
 
-  std::vector<KVPair>::iterator findByKey(Key K) {
-    return llvm::find_if(LRU, [K](const KVPair &P) { return P.first == K; });
+  std::vector<Entry>::iterator findByKey(Key K) {
+    return llvm::find_if(LRU, [K](const Entry &E) { return E.K == K; });
+  }
+
+  std::unique_ptr<ParsedAST> popLeastRecentlyUsed() {
+    std::unique_ptr<ParsedAST> AST = std::move(LRU.back().AST);
+    TotalBytes -= LRU.back().Bytes;
+    LRU.pop_back();
+    return AST;
   }
 
   std::mutex Mut;
   unsigned MaxRetainedASTs;
+  std::size_t MaxRetainedBytes;
   /// Items sorted in LRU order, i.e. first item is the most recently accessed
   /// one.
-  std::vector<KVPair> LRU; /* GUARDED_BY(Mut) */
+  std::vector<Entry> LRU; /* GUARDED_BY(Mut) */
+  std::size_t TotalBytes = 0; /* GUARDED_BY(Mut) */
 };
 
 /// A map from header files to an opened "proxy" file that includes them.
@@ -425,7 +470,7 @@ private:
 class PreambleThread {
 public:
   PreambleThread(llvm::StringRef FileName, ParsingCallbacks &Callbacks,
-                 bool StorePreambleInMemory, bool RunSync,
+                 const std::atomic<bool> &StorePreambleInMemory, bool RunSync,
                  PreambleThrottler *Throttler, SynchronizedTUStatus &Status,
                  TUScheduler::HeaderIncluderCache &HeaderIncluders,
                  ASTWorker &AW)
@@ -579,7 +624,7 @@ private:
 
   const Path FileName;
   ParsingCallbacks &Callbacks;
-  const bool StoreInMemory;
+  const std::atomic<bool> &StoreInMemory;
   const bool RunSync;
   PreambleThrottler *Throttler;
 
@@ -590,6 +635,57 @@ private:
 
 class ASTWorkerHandle;
 
+/// A function body written in the main file. Early diagnostics for an edit
+/// confined to one body only need that body to be parsed.
+struct FunctionBodyExtent {
+  // Offsets of the function name and of the braces around its body.
+  unsigned NameOffset;
+  unsigned LBraceOffset;
+  unsigned RBraceOffset;
+  // Zero-based lines of the braces.
+  unsigned LBraceLine;
+  unsigned RBraceLine;
+};
+
+void collectFunctionBodies(Decl *D, const SourceManager &SM,
+                           std::vector<FunctionBodyExtent> &Bodies) {
+  if (auto *TD = llvm::dyn_cast<TemplateDecl>(D))
+    if (NamedDecl *Templated = TD->getTemplatedDecl())
+      D = Templated;
+  if (auto *FD = llvm::dyn_cast<FunctionDecl>(D)) {
+    if (!FD->doesThisDeclarationHaveABody())
+      return;
+    auto *Body = llvm::dyn_cast_or_null<CompoundStmt>(FD->getBody());
+    if (!Body)
+      return;
+    SourceLocation Name = FD->getLocation(), LBrace = Body->getLBracLoc(),
+                   RBrace = Body->getRBracLoc();
+    for (SourceLocation Loc : {Name, LBrace, RBrace})
+      if (!Loc.isFileID() || !SM.isWrittenInMainFile(Loc))
+        return;
+    Bodies.push_back({SM.getFileOffset(Name), SM.getFileOffset(LBrace),
+                      SM.getFileOffset(RBrace),
+                      SM.getSpellingLineNumber(LBrace) - 1,
+                      SM.getSpellingLineNumber(RBrace) - 1});
+    return;
+  }
+  if (llvm::isa<NamespaceDecl, LinkageSpecDecl, ExportDecl, CXXRecordDecl>(D))
+    for (Decl *Child : llvm::cast<DeclContext>(D)->decls())
+      collectFunctionBodies(Child, SM, Bodies);
+}
+
+std::vector<FunctionBodyExtent> collectFunctionBodies(ParsedAST &AST) {
+  std::vector<FunctionBodyExtent> Bodies;
+  for (Decl *D : AST.getLocalTopLevelDecls())
+    collectFunctionBodies(D, AST.getSourceManager(), Bodies);
+  return Bodies;
+}
+
+void shiftLines(Range &R, int Delta) {
+  R.start.line += Delta;
+  R.end.line += Delta;
+}
+
 /// Owns one instance of the AST, schedules updates and reads of it.
 /// Also responsible for building and providing access to the preamble.
 /// Each ASTWorker processes the async requests sent to it on a separate
@@ -606,6 +702,7 @@ class ASTWorker {
             TUScheduler::ASTCache &LRUCache,
             TUScheduler::HeaderIncluderCache &HeaderIncluders,
             Semaphore &Barrier, bool RunSync, const TUScheduler::Options &Opts,
+            const std::atomic<bool> &StorePreamblesInMemory,
             ParsingCallbacks &Callbacks);
 
 public:
@@ -614,12 +711,15 @@ public:
   /// is null, all requests will be processed on the calling thread
   /// synchronously instead. \p Barrier is acquired when processing each
   /// request, it is used to limit the number of actively running threads.
+  /// \p StorePreamblesInMemory is read whenever a preamble is built.
   static ASTWorkerHandle
   create(PathRef FileName, const GlobalCompilationDatabase &CDB,
          TUScheduler::ASTCache &IdleASTs,
          TUScheduler::HeaderIncluderCache &HeaderIncluders,
          AsyncTaskRunner *Tasks, Semaphore &Barrier,
-         const TUScheduler::Options &Opts, ParsingCallbacks &Callbacks);
+         const TUScheduler::Options &Opts,
+         const std::atomic<bool> &StorePreamblesInMemory,
+         ParsingCallbacks &Callbacks);
   ~ASTWorker();
 
   void update(ParseInputs Inputs, WantDiagnostics, bool ContentChanged);
@@ -673,6 +773,13 @@ private:
 
   void updateASTSignals(ParsedAST &AST);
 
+  /// If the only difference between \p Inputs and the last diagnosed version
+  /// is inside one function body, parses just that body and publishes its
+  /// diagnostics together with those of the last version for the rest of the
+  /// file. The full rebuild still follows and replaces them.
+  void publishEarlyBodyDiagnostics(const CompilerInvocation &Invocation,
+                                   const ParseInputs &Inputs);
+
   // Must be called exactly once on processing thread. Will return after
   // stop() is called on a separate thread and all pending requests are
   // processed.
@@ -723,6 +830,16 @@ private:
   Semaphore &Barrier;
   /// Whether the 'onMainAST' callback ran for the current FileInputs.
   bool RanASTCallback = false;
+  const bool EarlyBodyDiagnostics;
+  /// The last version of the file that was fully diagnosed, used for early
+  /// body diagnostics. Only accessed by the worker thread.
+  struct DiagnosedVersion {
+    tooling::CompileCommand CompileCommand;
+    std::string Contents;
+    std::vector<Diag> Diags;
+    std::vector<FunctionBodyExtent> Bodies;
+  };
+  std::optional<DiagnosedVersion> LastDiagnosed;
   /// Guards members used by both TUScheduler and the worker thread.
   mutable std::mutex Mutex;
   /// File inputs, currently being used by the worker.
@@ -813,10 +930,11 @@ ASTWorker::create(PathRef FileName, const GlobalCompilationDatabase &CDB,
                   TUScheduler::HeaderIncluderCache &HeaderIncluders,
                   AsyncTaskRunner *Tasks, Semaphore &Barrier,
                   const TUScheduler::Options &Opts,
+                  const std::atomic<bool> &StorePreamblesInMemory,
                   ParsingCallbacks &Callbacks) {
-  std::shared_ptr<ASTWorker> Worker(
-      new ASTWorker(FileName, CDB, IdleASTs, HeaderIncluders, Barrier,
-                    /*RunSync=*/!Tasks, Opts, Callbacks));
+  std::shared_ptr<ASTWorker> Worker(new ASTWorker(
+      FileName, CDB, IdleASTs, HeaderIncluders, Barrier,
+      /*RunSync=*/!Tasks, Opts, StorePreamblesInMemory, Callbacks));
   if (Tasks) {
     Tasks->runAsync("ASTWorker:" + llvm::sys::path::filename(FileName),
                     [Worker]() { Worker->run(); });
@@ -832,12 +950,14 @@ ASTWorker::ASTWorker(PathRef FileName, const GlobalCompilationDatabase &CDB,
                      TUScheduler::HeaderIncluderCache &HeaderIncluders,
                      Semaphore &Barrier, bool RunSync,
                      const TUScheduler::Options &Opts,
+                     const std::atomic<bool> &StorePreamblesInMemory,
                      ParsingCallbacks &Callbacks)
     : IdleASTs(LRUCache), HeaderIncluders(HeaderIncluders), RunSync(RunSync),
       UpdateDebounce(Opts.UpdateDebounce), FileName(FileName),
       ContextProvider(Opts.ContextProvider), CDB(CDB), Callbacks(Callbacks),
-      Barrier(Barrier), Done(false), Status(FileName, Callbacks),
-      PreamblePeer(FileName, Callbacks, Opts.StorePreamblesInMemory, RunSync,
+      Barrier(Barrier), EarlyBodyDiagnostics(Opts.EarlyBodyDiagnostics),
+      Done(false), Status(FileName, Callbacks),
+      PreamblePeer(FileName, Callbacks, StorePreamblesInMemory, RunSync,
                    Opts.PreambleThrottler, Status, HeaderIncluders, *this) {
   // Set a fallback command because compile command can be accessed before
   // `Inputs` is initialized. Other fields are only used after initialization
@@ -1206,6 +1326,8 @@ void ASTWorker::generateDiagnostics(
   std::optional<std::unique_ptr<ParsedAST>> AST =
       IdleASTs.take(this, &ASTAccessForDiag);
   if (!AST || !InputsAreLatest) {
+    if (EarlyBodyDiagnostics)
+      publishEarlyBodyDiagnostics(*Invocation, Inputs);
     auto RebuildStartTime = DebouncePolicy::clock::now();
     std::optional<ParsedAST> NewAST = ParsedAST::build(
         FileName, Inputs, std::move(Invocation), CIDiags, *LatestPreamble);
@@ -1247,7 +1369,15 @@ void ASTWorker::generateDiagnostics(
     trace::Span Span("Running main AST callback");
     Callbacks.onMainAST(FileName, **AST, RunPublish);
     updateASTSignals(**AST);
+    if (EarlyBodyDiagnostics) {
+      auto Diags = (*AST)->getDiagnostics();
+      LastDiagnosed = DiagnosedVersion{
+          Inputs.CompileCommand, Inputs.Contents,
+          std::vector<Diag>(Diags.begin(), Diags.end()),
+          collectFunctionBodies(**AST)};
+    }
   } else {
+    LastDiagnosed.reset();
     // Failed to build the AST, at least report diagnostics from the
     // command line if there were any.
     // FIXME: we might have got more errors while trying to build the
@@ -1264,6 +1394,92 @@ void ASTWorker::generateDiagnostics(
   }
 }
 
+void ASTWorker::publishEarlyBodyDiagnostics(
+    const CompilerInvocation &Invocation, const ParseInputs &Inputs) {
+  static constexpr trace::Metric EarlyBodyDiags(
+      "early_body_diagnostics", trace::Metric::Counter, "result");
+  if (!LastDiagnosed || LastDiagnosed->CompileCommand != Inputs.CompileCommand)
+    return;
+  llvm::StringRef Old = LastDiagnosed->Contents, New = Inputs.Contents;
+  size_t MaxCommon = std::min(Old.size(), New.size());
+  size_t Prefix = 0;
+  while (Prefix < MaxCommon && Old[Prefix] == New[Prefix])
+    ++Prefix;
+  size_t Suffix = 0;
+  while (Suffix < MaxCommon - Prefix &&
+         Old[Old.size() - 1 - Suffix] == New[New.size() - 1 - Suffix])
+    ++Suffix;
+  llvm::StringRef OldText = Old.slice(Prefix, Old.size() - Suffix);
+  llvm::StringRef NewText = New.slice(Prefix, New.size() - Suffix);
+  // Directives in the edit could change the meaning of the rest of the file.
+  if (OldText.contains('#') || NewText.contains('#')) {
+    EarlyBodyDiags.record(1, "not_confined");
+    return;
+  }
+  auto It = llvm::find_if(LastDiagnosed->Bodies, [&](const auto &B) {
+    return B.LBraceOffset < Prefix && Prefix + OldText.size() <= B.RBraceOffset;
+  });
+  if (It == LastDiagnosed->Bodies.end()) {
+    EarlyBodyDiags.record(1, "not_confined");
+    return;
+  }
+  const FunctionBodyExtent &Body = *It;
+  int64_t OffsetDelta = int64_t(NewText.size()) - int64_t(OldText.size());
+  int LineDelta = int(NewText.count('\n')) - int(OldText.count('\n'));
+
+  trace::Span Tracer("EarlyBodyDiagnostics");
+  ParseInputs BodyInputs = Inputs;
+  BodyInputs.ParseBodiesIn = {Body.NameOffset,
+                              unsigned(Body.RBraceOffset + OffsetDelta)};
+  std::optional<ParsedAST> BodyAST = ParsedAST::build(
+      FileName, BodyInputs, std::make_unique<CompilerInvocation>(Invocation),
+      /*CompilerInvocationDiags=*/{}, *LatestPreamble);
+  // The edit must not have changed where the body ends, e.g. by unbalancing
+  // braces or opening a comment.
+  if (!BodyAST || llvm::none_of(collectFunctionBodies(*BodyAST),
+                                [&](const FunctionBodyExtent &B) {
+                                  return B.NameOffset == Body.NameOffset &&
+                                         B.RBraceOffset ==
+                                             Body.RBraceOffset + OffsetDelta;
+                                })) {
+    EarlyBodyDiags.record(1, "structure_changed");
+    return;
+  }
+
+  // Diagnostics of the edited body come from the new parse, the others from
+  // the last full build, moved to account for lines added or removed.
+  int FirstLine = Body.LBraceLine, LastLine = Body.RBraceLine;
+  std::vector<Diag> Diags;
+  for (const Diag &D : LastDiagnosed->Diags)
+    if (D.Range.end.line < FirstLine)
+      Diags.push_back(D);
+  for (const Diag &D : BodyAST->getDiagnostics())
+    if (D.InsideMainFile && D.Range.start.line >= FirstLine &&
+        D.Range.end.line <= LastLine + LineDelta)
+      Diags.push_back(D);
+  for (const Diag &D : LastDiagnosed->Diags) {
+    if (D.Range.start.line <= LastLine)
+      continue;
+    Diag &Moved = Diags.emplace_back(D);
+    shiftLines(Moved.Range, LineDelta);
+    for (Note &N : Moved.Notes)
+      if (N.InsideMainFile && N.Range.start.line > LastLine)
+        shiftLines(N.Range, LineDelta);
+    for (Fix &F : Moved.Fixes)
+      for (TextEdit &E : F.Edits)
+        if (E.range.start.line > LastLine)
+          shiftLines(E.range, LineDelta);
+  }
+  EarlyBodyDiags.record(1, "published");
+  Callbacks.onEarlyDiagnostics(
+      FileName, Inputs.Version, std::move(Diags),
+      [&](llvm::function_ref<void()> Publish) {
+        std::lock_guard<std::mutex> Lock(PublishMu);
+        if (CanPublishResults)
+          Publish();
+      });
+}
+
 std::shared_ptr<const PreambleData> ASTWorker::getPossiblyStalePreamble(
     std::shared_ptr<const ASTSignals> *ASTSignals) const {
   std::lock_guard<std::mutex> Lock(Mutex);
@@ -1290,8 +1506,10 @@ TUScheduler::FileStats ASTWorker::stats() const {
   // the in-flight requests. We used this information for debugging purposes
   // only, so this should be fine.
   Result.UsedBytesAST = IdleASTs.getUsedBytes(this);
-  if (auto Preamble = getPossiblyStalePreamble())
+  if (auto Preamble = getPossiblyStalePreamble()) {
     Result.UsedBytesPreamble = Preamble->Preamble.getSize();
+    Result.PreambleInMemory = Preamble->StoredInMemory;
+  }
   return Result;
 }
 
@@ -1448,8 +1666,16 @@ void ASTWorker::run() {
           Status.ASTActivity.K = ASTAction::Queued;
           Status.ASTActivity.Name = CurrentRequest->Name;
         });
-        Lock.lock();
+        // Reads are what the user is waiting for, let them overtake the AST
+        // rebuilds of other files.
+        Barrier.lock(/*Urgent=*/!CurrentRequest->Update);
+        Lock = std::unique_lock<Semaphore>(Barrier, std::adopt_lock);
       }
+      RequestQueueLatency.record(
+          std::chrono::duration<double>(steady_clock::now() -
+                                        CurrentRequest->AddTime)
+              .count(),
+          CurrentRequest->Update ? "update" : "read");
       WithContext Guard(std::move(CurrentRequest->Ctx));
       Status.update([&](TUStatus &Status) {
         Status.ASTActivity.K = ASTAction::RunningAction;
@@ -1628,11 +1854,12 @@ TUScheduler::TUScheduler(const GlobalCompilationDatabase &CDB,
                          const Options &Opts,
                          std::unique_ptr<ParsingCallbacks> Callbacks)
     : CDB(CDB), Opts(Opts),
+      StorePreamblesInMemory(Opts.StorePreamblesInMemory),
       Callbacks(Callbacks ? std::move(Callbacks)
                           : std::make_unique<ParsingCallbacks>()),
       Barrier(Opts.AsyncThreadsCount), QuickRunBarrier(Opts.AsyncThreadsCount),
       IdleASTs(
-          std::make_unique<ASTCache>(Opts.RetentionPolicy.MaxRetainedASTs)),
+          std::make_unique<ASTCache>(Opts.RetentionPolicy)),
       HeaderIncluders(std::make_unique<HeaderIncluderCache>()) {
   // Avoid null checks everywhere.
   if (!Opts.ContextProvider) {
@@ -1676,7 +1903,8 @@ bool TUScheduler::update(PathRef File, ParseInputs Inputs,
     // Create a new worker to process the AST-related tasks.
     ASTWorkerHandle Worker = ASTWorker::create(
         File, CDB, *IdleASTs, *HeaderIncluders,
-        WorkerThreads ? &*WorkerThreads : nullptr, Barrier, Opts, *Callbacks);
+        WorkerThreads ? &*WorkerThreads : nullptr, Barrier, Opts,
+        StorePreamblesInMemory, *Callbacks);
     FD = std::unique_ptr<FileData>(
         new FileData{Inputs.Contents, std::move(Worker)});
     ContentChanged = true;
@@ -1861,11 +2089,19 @@ void TUScheduler::profile(MemoryTree &MT) const {
   for (const auto &Elem : fileStats()) {
     MT.detail(Elem.first())
         .child("preamble")
-        .addUsage(Opts.StorePreamblesInMemory ? Elem.second.UsedBytesPreamble
-                                              : 0);
+        .addUsage(Elem.second.PreambleInMemory ? Elem.second.UsedBytesPreamble
+                                               : 0);
     MT.detail(Elem.first()).child("ast").addUsage(Elem.second.UsedBytesAST);
     MT.child("header_includer_cache").addUsage(HeaderIncluders->getUsedBytes());
   }
 }
+
+std::size_t TUScheduler::releaseIdleASTs(std::size_t Bytes) {
+  return IdleASTs->release(Bytes);
+}
+
+void TUScheduler::setStorePreamblesInMemory(bool InMemory) {
+  StorePreamblesInMemory = InMemory;
+}
 } // namespace clangd
 } // namespace clang
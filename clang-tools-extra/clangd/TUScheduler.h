@@ -20,6 +20,7 @@
 #include "support/Threading.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <optional>
@@ -64,6 +65,9 @@ struct ASTRetentionPolicy {
   /// Maximum number of ASTs to be retained in memory when there are no pending
   /// requests for them.
   unsigned MaxRetainedASTs = 3;
+  /// Maximum total size of the ASTs retained in memory, in bytes. The most
+  /// recently used AST is retained even if it is larger. 0 means no limit.
+  std::size_t MaxRetainedBytes = 0;
 };
 
 /// Clangd may wait after an update to see if another one comes along.
@@ -192,6 +196,13 @@ public:
 
   /// Called whenever the AST fails to build. \p Diags will have the diagnostics
   /// that led to failure.
+  /// Called before the AST is rebuilt for an edit that is confined to one
+  /// function body, with diagnostics from parsing only that body merged with
+  /// those of the previous version for the rest of the file. onMainAST follows
+  /// with the complete diagnostics. Only used with Options::EarlyBodyDiagnostics.
+  virtual void onEarlyDiagnostics(PathRef Path, llvm::StringRef Version,
+                                  std::vector<Diag> Diags, PublishFn Publish) {}
+
   virtual void onFailedAST(PathRef Path, llvm::StringRef Version,
                            std::vector<Diag> Diags, PublishFn Publish) {}
 
@@ -229,6 +240,10 @@ public:
     /// Determines when to keep idle ASTs in memory for future use.
     ASTRetentionPolicy RetentionPolicy;
 
+    /// Publish early diagnostics for edits within a function body by parsing
+    /// only that body, before rebuilding the whole AST.
+    bool EarlyBodyDiagnostics = false;
+
     /// This throttler controls which preambles may be built at a given time.
     clangd::PreambleThrottler *PreambleThrottler = nullptr;
 
@@ -245,6 +260,7 @@ public:
   struct FileStats {
     std::size_t UsedBytesAST = 0;
     std::size_t UsedBytesPreamble = 0;
+    bool PreambleInMemory = false;
     unsigned PreambleBuilds = 0;
     unsigned ASTBuilds = 0;
   };
@@ -356,12 +372,22 @@ public:
 
   void profile(MemoryTree &MT) const;
 
+  /// Drops idle ASTs, least recently used first, until at least \p Bytes have
+  /// been released or no idle ASTs are left. Returns the bytes released.
+  std::size_t releaseIdleASTs(std::size_t Bytes);
+
+  /// Controls whether preambles built from now on are kept in memory or in
+  /// temporary files. Existing preambles are not affected.
+  void setStorePreamblesInMemory(bool InMemory);
+
 private:
   void runWithSemaphore(llvm::StringRef Name, llvm::StringRef Path,
                         llvm::unique_function<void()> Action, Semaphore &Sem);
 
   const GlobalCompilationDatabase &CDB;
   Options Opts;
+  // Initialized from Opts.StorePreamblesInMemory, read by preamble threads.
+  std::atomic<bool> StorePreamblesInMemory;
   std::unique_ptr<ParsingCallbacks> Callbacks; // not nullptr
   Semaphore Barrier;
   Semaphore QuickRunBarrier;
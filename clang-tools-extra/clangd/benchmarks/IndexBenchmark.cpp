@@ -8,11 +8,14 @@
 
 #include "../index/Serialization.h"
 #include "../index/dex/Dex.h"
+#include "../index/dex/Iterator.h"
+#include "../index/dex/PostingList.h"
 #include "benchmark/benchmark.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Regex.h"
+#include <random>
 #include <string>
 
 const char *IndexFilename;
@@ -97,6 +100,52 @@ static void dexBuild(benchmark::State &State) {
 }
 BENCHMARK(dexBuild);
 
+// Builds a posting list with gaps chosen uniformly from [1, MaxGap].
+dex::PostingList buildPostingList(dex::DocID NumDocs, unsigned MaxGap,
+                                  std::mt19937 &Generator) {
+  std::vector<dex::DocID> Docs;
+  for (dex::DocID D = Generator() % MaxGap; D < NumDocs;
+       D += 1 + Generator() % MaxGap)
+    Docs.push_back(D);
+  return dex::PostingList(Docs);
+}
+
+// Intersects two synthetic posting lists, with the maximal gaps between their
+// documents given by the benchmark arguments.
+static void dexIntersectPostingLists(benchmark::State &State) {
+  constexpr dex::DocID NumDocs = 1 << 20;
+  std::mt19937 Generator(0);
+  const auto L0 = buildPostingList(NumDocs, State.range(0), Generator);
+  const auto L1 = buildPostingList(NumDocs, State.range(1), Generator);
+  dex::Corpus C(NumDocs);
+  for (auto _ : State) {
+    auto It = C.intersect(L0.iterator(), L1.iterator());
+    size_t Matches = 0;
+    for (; !It->reachedEnd(); It->advance())
+      ++Matches;
+    benchmark::DoNotOptimize(Matches);
+  }
+}
+BENCHMARK(dexIntersectPostingLists)
+    ->Args({2, 2})
+    ->Args({2, 64})
+    ->Args({16, 1024})
+    ->Args({256, 256});
+
+// Walks a synthetic posting list with the given maximal gap.
+static void dexIteratePostingList(benchmark::State &State) {
+  std::mt19937 Generator(0);
+  const auto L = buildPostingList(1 << 20, State.range(0), Generator);
+  for (auto _ : State) {
+    auto It = L.iterator();
+    size_t Docs = 0;
+    for (; !It->reachedEnd(); It->advance())
+      ++Docs;
+    benchmark::DoNotOptimize(Docs);
+  }
+}
+BENCHMARK(dexIteratePostingList)->Arg(2)->Arg(64)->Arg(4096);
+
 } // namespace
 } // namespace clangd
 } // namespace clang
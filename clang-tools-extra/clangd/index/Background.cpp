@@ -95,6 +95,7 @@ BackgroundIndex::BackgroundIndex(
     BackgroundIndexStorage::Factory IndexStorageFactory, Options Opts)
     : SwapIndex(std::make_unique<MemIndex>()), TFS(TFS), CDB(CDB),
       IndexingPriority(Opts.IndexingPriority),
+      ThreadPoolSize(Opts.ThreadPoolSize),
       ContextProvider(std::move(Opts.ContextProvider)),
       IndexedSymbols(IndexContents::All),
       Rebuilder(this, &IndexedSymbols, Opts.ThreadPoolSize),
@@ -135,9 +136,22 @@ BackgroundQueue::Task BackgroundIndex::changedFilesTask(
     SPAN_ATTACH(Tracer, "files", int64_t(ChangedFiles.size()));
 
     auto NeedsReIndexing = loadProject(std::move(ChangedFiles));
-    // Run indexing for files that need to be updated.
-    std::shuffle(NeedsReIndexing.begin(), NeedsReIndexing.end(),
-                 std::mt19937(std::random_device{}()));
+    // Run indexing for files that need to be updated, one directory at a time:
+    // neighbouring files mostly include the same headers with the same flags,
+    // so they find them in the OS and filesystem caches, and the shards of
+    // those headers are written once early on. Directories are visited in
+    // random order to cover the codebase evenly.
+    std::mt19937 Generator(std::random_device{}());
+    llvm::StringMap<unsigned> DirectoryOrder;
+    for (const auto &File : NeedsReIndexing)
+      DirectoryOrder.try_emplace(llvm::sys::path::parent_path(File),
+                                 Generator());
+    llvm::sort(NeedsReIndexing, [&](llvm::StringRef L, llvm::StringRef R) {
+      return std::make_pair(
+                 DirectoryOrder.lookup(llvm::sys::path::parent_path(L)), L) <
+             std::make_pair(
+                 DirectoryOrder.lookup(llvm::sys::path::parent_path(R)), R);
+    });
     std::vector<BackgroundQueue::Task> Tasks;
     Tasks.reserve(NeedsReIndexing.size());
     for (const auto &File : NeedsReIndexing)
@@ -157,6 +171,7 @@ static llvm::StringRef filenameWithoutExtension(llvm::StringRef Path) {
 
 BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
   std::string Tag = filenameWithoutExtension(Path).str();
+  std::string Directory = llvm::sys::path::parent_path(Path).str();
   uint64_t Key = llvm::xxh3_64bits(Path);
   BackgroundQueue::Task T([this, Path(std::move(Path))] {
     std::optional<WithContext> WithProvidedContext;
@@ -171,6 +186,7 @@ BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
   T.QueuePri = IndexFile;
   T.ThreadPri = IndexingPriority;
   T.Tag = std::move(Tag);
+  T.GroupTag = std::move(Directory);
   T.Key = Key;
   return T;
 }
@@ -178,6 +194,7 @@ BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
 void BackgroundIndex::boostRelated(llvm::StringRef Path) {
   if (isHeaderFile(Path))
     Queue.boost(filenameWithoutExtension(Path), IndexBoostedFile);
+  Queue.boost(llvm::sys::path::parent_path(Path), IndexBoostedDirectory);
 }
 
 /// Given index results from a TU, only update symbols coming from files that
@@ -367,7 +384,7 @@ BackgroundIndex::loadProject(std::vector<std::string> MainFiles) {
   Rebuilder.startLoading();
   // Load shards for all of the mainfiles.
   const std::vector<LoadedShard> Result =
-      loadIndexShards(MainFiles, IndexStorageFactory, CDB);
+      loadIndexShards(MainFiles, IndexStorageFactory, CDB, ThreadPoolSize);
   size_t LoadedShards = 0;
   {
     // Update in-memory state.
@@ -31,6 +31,7 @@
 #include <queue>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 namespace clang {
@@ -76,10 +77,15 @@ public:
     llvm::ThreadPriority ThreadPri = llvm::ThreadPriority::Low;
     unsigned QueuePri = 0; // Higher-priority tasks will run first.
     std::string Tag;       // Allows priority to be boosted later.
+    std::string GroupTag;  // Like Tag, shared by a group of related tasks.
     uint64_t Key = 0;      // If the key matches a previous task, drop this one.
                            // (in practice this means we never reindex a file).
+    uint64_t Order = 0;    // Set by the queue. Among tasks of equal priority,
+                           // those enqueued first run first.
 
-    bool operator<(const Task &O) const { return QueuePri < O.QueuePri; }
+    bool operator<(const Task &O) const {
+      return std::tie(QueuePri, O.Order) < std::tie(O.QueuePri, Order);
+    }
   };
 
   // Describes the number of tasks processed by the queue.
@@ -96,8 +102,8 @@ public:
   // Add tasks to the queue.
   void push(Task);
   void append(std::vector<Task>);
-  // Boost priority of current and new tasks with matching Tag, if they are
-  // lower priority.
+  // Boost priority of current and new tasks with matching Tag or GroupTag, if
+  // they are lower priority.
   // Reducing the boost of a tag affects future tasks but not current ones.
   void boost(llvm::StringRef Tag, unsigned NewPriority);
 
@@ -126,6 +132,7 @@ private:
   llvm::StringMap<unsigned> Boosts;
   std::function<void(Stats)> OnProgress;
   llvm::DenseSet<uint64_t> SeenKeys;
+  uint64_t NextOrder = 0;
 };
 
 // Builds an in-memory index by by running the static indexer action over
@@ -162,7 +169,8 @@ public:
   }
 
   /// Boosts priority of indexing related to Path.
-  /// Typically used to index TUs when headers are opened.
+  /// Typically used to index TUs when headers are opened, and files in the
+  /// same directory as open files, which tend to share their headers.
   void boostRelated(llvm::StringRef Path);
 
   // Cause background threads to stop after ther current task, any remaining
@@ -198,6 +206,7 @@ private:
   const ThreadsafeFS &TFS;
   const GlobalCompilationDatabase &CDB;
   llvm::ThreadPriority IndexingPriority;
+  size_t ThreadPoolSize;
   std::function<Context(PathRef)> ContextProvider;
 
   llvm::Error index(tooling::CompileCommand);
@@ -218,6 +227,7 @@ private:
   // from lowest to highest priority
   enum QueuePriority {
     IndexFile,
+    IndexBoostedDirectory,
     IndexBoostedFile,
     LoadShards,
   };
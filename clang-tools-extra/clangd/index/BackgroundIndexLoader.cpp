@@ -11,8 +11,10 @@
 #include "index/Background.h"
 #include "support/Logger.h"
 #include "support/Path.h"
+#include "support/Threading.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Path.h"
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,54 +27,45 @@ namespace {
 /// inverse dependency mapping.
 class BackgroundIndexLoader {
 public:
-  BackgroundIndexLoader(BackgroundIndexStorage::Factory &IndexStorageFactory)
-      : IndexStorageFactory(IndexStorageFactory) {}
-  /// Load the shards for \p MainFile and all of its dependencies.
-  void load(PathRef MainFile);
+  BackgroundIndexLoader(BackgroundIndexStorage::Factory &IndexStorageFactory,
+                        unsigned Concurrency)
+      : IndexStorageFactory(IndexStorageFactory), Concurrency(Concurrency) {}
+  /// Load the shards for \p MainFiles and all of their dependencies.
+  void load(llvm::ArrayRef<Path> MainFiles);
 
   /// Consumes the loader and returns all shards.
   std::vector<LoadedShard> takeResult() &&;
 
 private:
-  /// Returns the Shard for \p StartSourceFile from cache or loads it from \p
-  /// Storage. Also returns paths for dependencies of \p StartSourceFile if it
-  /// wasn't cached yet.
-  std::pair<const LoadedShard &, std::vector<Path>>
-  loadShard(PathRef StartSourceFile, PathRef DependentTU);
+  /// Loads the shard for \p LS from storage and returns the paths of its
+  /// dependencies. Called concurrently for different shards.
+  std::vector<Path> loadShard(LoadedShard &LS) const;
 
   /// Cache for Storage lookups.
   llvm::StringMap<LoadedShard> LoadedShards;
 
   BackgroundIndexStorage::Factory &IndexStorageFactory;
+  unsigned Concurrency;
 };
 
-std::pair<const LoadedShard &, std::vector<Path>>
-BackgroundIndexLoader::loadShard(PathRef StartSourceFile, PathRef DependentTU) {
-  auto It = LoadedShards.try_emplace(StartSourceFile);
-  LoadedShard &LS = It.first->getValue();
+std::vector<Path> BackgroundIndexLoader::loadShard(LoadedShard &LS) const {
   std::vector<Path> Edges = {};
-  // Return the cached shard.
-  if (!It.second)
-    return {LS, Edges};
-
-  LS.AbsolutePath = StartSourceFile.str();
-  LS.DependentTU = std::string(DependentTU);
   BackgroundIndexStorage *Storage = IndexStorageFactory(LS.AbsolutePath);
-  auto Shard = Storage->loadShard(StartSourceFile);
+  auto Shard = Storage->loadShard(LS.AbsolutePath);
   if (!Shard || !Shard->Sources) {
-    vlog("Failed to load shard: {0}", StartSourceFile);
-    return {LS, Edges};
+    vlog("Failed to load shard: {0}", LS.AbsolutePath);
+    return Edges;
   }
 
   LS.Shard = std::move(Shard);
   for (const auto &It : *LS.Shard->Sources) {
-    auto AbsPath = URI::resolve(It.getKey(), StartSourceFile);
+    auto AbsPath = URI::resolve(It.getKey(), LS.AbsolutePath);
     if (!AbsPath) {
       elog("Failed to resolve URI: {0}", AbsPath.takeError());
       continue;
     }
     // A shard contains only edges for non main-file sources.
-    if (*AbsPath != StartSourceFile) {
+    if (*AbsPath != LS.AbsolutePath) {
       Edges.push_back(*AbsPath);
       continue;
     }
@@ -84,26 +77,46 @@ BackgroundIndexLoader::loadShard(PathRef StartSourceFile, PathRef DependentTU) {
     LS.HadErrors = IGN.Flags & IncludeGraphNode::SourceFlag::HadErrors;
   }
   assert(LS.Digest != FileDigest{{0}} && "Digest is empty?");
-  return {LS, Edges};
+  return Edges;
 }
 
-void BackgroundIndexLoader::load(PathRef MainFile) {
-  llvm::StringSet<> InQueue;
-  // Following containers points to strings inside InQueue.
-  std::queue<PathRef> ToVisit;
-  InQueue.insert(MainFile);
-  ToVisit.push(MainFile);
-
-  while (!ToVisit.empty()) {
-    PathRef SourceFile = ToVisit.front();
-    ToVisit.pop();
-
-    auto ShardAndEdges = loadShard(SourceFile, MainFile);
-    for (PathRef Edge : ShardAndEdges.second) {
-      auto It = InQueue.insert(Edge);
-      if (It.second)
-        ToVisit.push(It.first->getKey());
+void BackgroundIndexLoader::load(llvm::ArrayRef<Path> MainFiles) {
+  // The include graph is walked breadth-first. The shards of each level only
+  // depend on the previous one, so they are read and decoded in parallel.
+  std::vector<LoadedShard *> Level;
+  auto Enqueue = [&](PathRef SourceFile, PathRef DependentTU) {
+    auto It = LoadedShards.try_emplace(SourceFile);
+    if (!It.second)
+      return;
+    LoadedShard &LS = It.first->getValue();
+    LS.AbsolutePath = SourceFile.str();
+    LS.DependentTU = std::string(DependentTU);
+    Level.push_back(&LS);
+  };
+  for (PathRef MainFile : MainFiles)
+    Enqueue(MainFile, MainFile);
+
+  while (!Level.empty()) {
+    std::vector<std::vector<Path>> Edges(Level.size());
+    std::atomic<size_t> Next = 0;
+    auto LoadShards = [&] {
+      for (size_t I; (I = Next++) < Level.size();)
+        Edges[I] = loadShard(*Level[I]);
+    };
+    if (Concurrency <= 1 || Level.size() == 1) {
+      LoadShards();
+    } else {
+      AsyncTaskRunner Tasks;
+      for (unsigned I = 0; I < std::min<size_t>(Concurrency, Level.size()); ++I)
+        Tasks.runAsync("shard-loader-" + llvm::Twine(I + 1), LoadShards);
+      Tasks.wait();
     }
+
+    std::vector<LoadedShard *> Current = std::move(Level);
+    Level.clear();
+    for (size_t I = 0; I < Current.size(); ++I)
+      for (PathRef Edge : Edges[I])
+        Enqueue(Edge, Current[I]->DependentTU);
   }
 }
 
@@ -119,12 +132,12 @@ std::vector<LoadedShard> BackgroundIndexLoader::takeResult() && {
 std::vector<LoadedShard>
 loadIndexShards(llvm::ArrayRef<Path> MainFiles,
                 BackgroundIndexStorage::Factory &IndexStorageFactory,
-                const GlobalCompilationDatabase &CDB) {
-  BackgroundIndexLoader Loader(IndexStorageFactory);
-  for (llvm::StringRef MainFile : MainFiles) {
-    assert(llvm::sys::path::is_absolute(MainFile));
-    Loader.load(MainFile);
-  }
+                const GlobalCompilationDatabase &CDB, unsigned Concurrency) {
+  assert(llvm::all_of(MainFiles, [](llvm::StringRef MainFile) {
+    return llvm::sys::path::is_absolute(MainFile);
+  }));
+  BackgroundIndexLoader Loader(IndexStorageFactory, Concurrency);
+  Loader.load(MainFiles);
   return std::move(Loader).takeResult();
 }
 
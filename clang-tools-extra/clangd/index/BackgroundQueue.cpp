@@ -83,6 +83,9 @@ bool BackgroundQueue::adjust(Task &T) {
   if (T.Key && !SeenKeys.insert(T.Key).second)
     return false;
   T.QueuePri = std::max(T.QueuePri, Boosts.lookup(T.Tag));
+  if (!T.GroupTag.empty())
+    T.QueuePri = std::max(T.QueuePri, Boosts.lookup(T.GroupTag));
+  T.Order = NextOrder++;
   return true;
 }
 
@@ -124,7 +127,7 @@ void BackgroundQueue::boost(llvm::StringRef Tag, unsigned NewPriority) {
 
   unsigned Changes = 0;
   for (Task &T : Queue)
-    if (Tag == T.Tag && NewPriority > T.QueuePri) {
+    if ((Tag == T.Tag || Tag == T.GroupTag) && NewPriority > T.QueuePri) {
       T.QueuePri = NewPriority;
       ++Changes;
     }
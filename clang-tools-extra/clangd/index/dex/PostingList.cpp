@@ -10,27 +10,68 @@
 #include "index/dex/Iterator.h"
 #include "index/dex/Token.h"
 #include "llvm/Support/MathExtras.h"
-#include <optional>
+#include <array>
 
 namespace clang {
 namespace clangd {
 namespace dex {
 namespace {
 
-/// Implements iterator of PostingList chunks. This requires iterating over two
-/// levels: the first level iterator iterates over the chunks and decompresses
-/// them on-the-fly when the contents of chunk are to be seen.
-class ChunkIterator : public Iterator {
-public:
-  explicit ChunkIterator(const Token *Tok, llvm::ArrayRef<Chunk> Chunks)
-      : Tok(Tok), Chunks(Chunks), CurrentChunk(Chunks.begin()) {
-    if (!Chunks.empty()) {
-      DecompressedChunk = CurrentChunk->decompress();
-      CurrentID = DecompressedChunk.begin();
+constexpr size_t BlockSize = PostingList::BlockSize;
+
+/// The block metadata stores the offset of the packed gaps above the gap
+/// width, which takes this many bits.
+constexpr unsigned WidthBits = 6;
+
+/// The blocks of a posting list, see PostingList::Data.
+struct Blocks {
+  Blocks(uint32_t Size, llvm::ArrayRef<uint32_t> Data)
+      : Size(Size), Count(llvm::divideCeil(Size, BlockSize)),
+        Heads(Data.take_front(Count)), Meta(Data.slice(Count, Count)),
+        Packed(Data.drop_front(2 * Count).data()) {}
+
+  /// Decodes block \p B into \p Out. Returns the number of DocIDs in it.
+  size_t decode(size_t B, DocID *Out) const {
+    size_t Length = std::min<size_t>(BlockSize, Size - B * BlockSize);
+    unsigned Width = Meta[B] & ((1u << WidthBits) - 1);
+    const uint32_t *Words = Packed + (Meta[B] >> WidthBits);
+    uint64_t Mask = (uint64_t(1) << Width) - 1;
+    // Unpack the gaps first, then sum them up: the first loop has no
+    // dependencies between iterations and can be vectorized.
+    Out[0] = Heads[B];
+    for (size_t I = 1; I < Length; ++I) {
+      size_t Bit = (I - 1) * Width;
+      uint64_t Window = Words[Bit / 32] | uint64_t(Words[Bit / 32 + 1]) << 32;
+      Out[I] = DocID((Window >> (Bit % 32)) & Mask);
     }
+    for (size_t I = 1; I < Length; ++I)
+      Out[I] += Out[I - 1];
+    return Length;
   }
 
-  bool reachedEnd() const override { return CurrentChunk == Chunks.end(); }
+  uint32_t Size;
+  size_t Count;
+  /// The first DocID of each block.
+  llvm::ArrayRef<uint32_t> Heads;
+  /// The offset of the packed gaps and their width for each block.
+  llvm::ArrayRef<uint32_t> Meta;
+  const uint32_t *Packed;
+};
+
+/// Implements iterator of PostingList blocks. This requires iterating over two
+/// levels: the first level iterator skips over the blocks using their first
+/// DocIDs and decodes them on-the-fly when the contents of block are to be
+/// seen.
+class BlockIterator : public Iterator {
+public:
+  explicit BlockIterator(const Token *Tok, uint32_t Size,
+                         llvm::ArrayRef<uint32_t> Data)
+      : Tok(Tok), List(Size, Data) {
+    if (List.Count)
+      decodeCurrentBlock();
+  }
+
+  bool reachedEnd() const override { return CurrentBlock == List.Count; }
 
   /// Advances cursor to the next item.
   void advance() override {
@@ -40,23 +81,32 @@ public:
     normalizeCursor();
   }
 
-  /// Applies binary search to advance cursor to the next item with DocID
-  /// equal or higher than the given one.
+  /// Skips to the block which might contain ID, then advances cursor to the
+  /// next item with DocID equal or higher than the given one.
   void advanceTo(DocID ID) override {
     assert(!reachedEnd() &&
            "Posting List iterator can't advance() at the end.");
     if (ID <= peek())
       return;
-    advanceToChunk(ID);
-    // Try to find ID within current chunk.
-    CurrentID = std::partition_point(CurrentID, DecompressedChunk.end(),
-                                     [&](const DocID D) { return D < ID; });
+    advanceToBlock(ID);
+    // Targets are usually close by, so scan the block a window at a time.
+    // Counting the items below ID has no data-dependent branches and is
+    // vectorized.
+    while (CurrentID < DecodedSize) {
+      size_t End = std::min(CurrentID + ScanWindow, DecodedSize);
+      size_t Below = 0;
+      for (size_t I = CurrentID; I < End; ++I)
+        Below += Decoded[I] < ID;
+      CurrentID += Below;
+      if (CurrentID != End)
+        break;
+    }
     normalizeCursor();
   }
 
   DocID peek() const override {
     assert(!reachedEnd() && "Posting List iterator can't peek() at the end.");
-    return *CurrentID;
+    return Decoded[CurrentID];
   }
 
   float consume() override {
@@ -65,9 +115,7 @@ public:
     return 1;
   }
 
-  size_t estimateSize() const override {
-    return Chunks.size() * ApproxEntriesPerChunk;
-  }
+  size_t estimateSize() const override { return List.Size; }
 
 private:
   llvm::raw_ostream &dump(llvm::raw_ostream &OS) const override {
@@ -75,151 +123,94 @@ private:
       return OS << *Tok;
     OS << '[';
     const char *Sep = "";
-    for (const Chunk &C : Chunks)
-      for (const DocID Doc : C.decompress()) {
-        OS << Sep << Doc;
+    std::array<DocID, BlockSize> Block;
+    for (size_t B = 0; B < List.Count; ++B)
+      for (size_t I = 0, E = List.decode(B, Block.data()); I < E; ++I) {
+        OS << Sep << Block[I];
         Sep = " ";
       }
     return OS << ']';
   }
 
-  /// If the cursor is at the end of a chunk, place it at the start of the next
-  /// chunk.
+  void decodeCurrentBlock() {
+    DecodedSize = List.decode(CurrentBlock, Decoded.data());
+    CurrentID = 0;
+  }
+
+  /// If the cursor is at the end of a block, place it at the start of the next
+  /// block.
   void normalizeCursor() {
-    // Invariant is already established if examined chunk is not exhausted.
-    if (CurrentID != std::end(DecompressedChunk))
+    // Invariant is already established if examined block is not exhausted.
+    if (CurrentID != DecodedSize)
       return;
-    // Advance to next chunk if current one is exhausted.
-    ++CurrentChunk;
-    if (CurrentChunk == Chunks.end()) // Reached the end of PostingList.
+    // Advance to next block if current one is exhausted.
+    ++CurrentBlock;
+    if (CurrentBlock == List.Count) // Reached the end of PostingList.
       return;
-    DecompressedChunk = CurrentChunk->decompress();
-    CurrentID = DecompressedChunk.begin();
+    decodeCurrentBlock();
   }
 
-  /// Advances CurrentChunk to the chunk which might contain ID.
-  void advanceToChunk(DocID ID) {
-    if ((CurrentChunk != Chunks.end() - 1) &&
-        ((CurrentChunk + 1)->Head <= ID)) {
-      CurrentChunk =
-          std::partition_point(CurrentChunk + 1, Chunks.end(),
-                               [&](const Chunk &C) { return C.Head < ID; });
-      --CurrentChunk;
-      DecompressedChunk = CurrentChunk->decompress();
-      CurrentID = DecompressedChunk.begin();
+  /// Advances CurrentBlock to the block which might contain ID.
+  void advanceToBlock(DocID ID) {
+    if (CurrentBlock + 1 < List.Count && List.Heads[CurrentBlock + 1] <= ID) {
+      CurrentBlock = std::partition_point(
+                         List.Heads.begin() + CurrentBlock + 1,
+                         List.Heads.end(), [&](DocID Head) { return Head <= ID; }) -
+                     List.Heads.begin() - 1;
+      decodeCurrentBlock();
     }
   }
 
+  static constexpr size_t ScanWindow = 16;
+
   const Token *Tok;
-  llvm::ArrayRef<Chunk> Chunks;
-  /// Iterator over chunks.
-  /// If CurrentChunk is valid, then DecompressedChunk is
-  /// CurrentChunk->decompress() and CurrentID is a valid (non-end) iterator
-  /// into it.
-  decltype(Chunks)::const_iterator CurrentChunk;
-  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> DecompressedChunk;
-  /// Iterator over DecompressedChunk.
-  decltype(DecompressedChunk)::iterator CurrentID;
-
-  static constexpr size_t ApproxEntriesPerChunk = 15;
+  Blocks List;
+  /// Index of the current block. If it is valid, then Decoded holds its
+  /// DecodedSize items and CurrentID is a valid index into them.
+  size_t CurrentBlock = 0;
+  std::array<DocID, BlockSize> Decoded;
+  size_t DecodedSize = 0;
+  size_t CurrentID = 0;
 };
 
-static constexpr size_t BitsPerEncodingByte = 7;
-
-/// Writes a variable length DocID into the buffer and updates the buffer size.
-/// If it doesn't fit, returns false and doesn't write to the buffer.
-bool encodeVByte(DocID Delta, llvm::MutableArrayRef<uint8_t> &Payload) {
-  assert(Delta != 0 && "0 is not a valid PostingList delta.");
-  // Calculate number of bytes Delta encoding would take by examining the
-  // meaningful bits.
-  unsigned Width = 1 + llvm::Log2_64(Delta) / BitsPerEncodingByte;
-  if (Width > Payload.size())
-    return false;
-
-  do {
-    uint8_t Encoding = Delta & 0x7f;
-    Delta >>= 7;
-    Payload.front() = Delta ? Encoding | 0x80 : Encoding;
-    Payload = Payload.drop_front();
-  } while (Delta != 0);
-  return true;
-}
-
-/// Use Variable-length Byte (VByte) delta encoding to compress sorted list of
-/// DocIDs. The compression stores deltas (differences) between subsequent
-/// DocIDs and encodes these deltas utilizing the least possible number of
-/// bytes.
-///
-/// Each encoding byte consists of two parts: the first bit (continuation bit)
-/// indicates whether this is the last byte (0 if this byte is the last) of
-/// current encoding and seven bytes a piece of DocID (payload). DocID contains
-/// 32 bits and therefore it takes up to 5 bytes to encode it (4 full 7-bit
-/// payloads and one 4-bit payload), but in practice it is expected that gaps
-/// (deltas) between subsequent DocIDs are not large enough to require 5 bytes.
-/// In very dense posting lists (with average gaps less than 128) this
-/// representation would be 4 times more efficient than raw DocID array.
-///
-/// PostingList encoding example:
-///
-/// DocIDs    42            47        7000
-/// gaps                    5         6958
-/// Encoding  (raw number)  00000101  10110110 00101110
-std::vector<Chunk> encodeStream(llvm::ArrayRef<DocID> Documents) {
-  assert(!Documents.empty() && "Can't encode empty sequence.");
-  std::vector<Chunk> Result;
-  Result.emplace_back();
-  DocID Last = Result.back().Head = Documents.front();
-  llvm::MutableArrayRef<uint8_t> RemainingPayload = Result.back().Payload;
-  for (DocID Doc : Documents.drop_front()) {
-    if (!encodeVByte(Doc - Last, RemainingPayload)) { // didn't fit, flush chunk
-      Result.emplace_back();
-      Result.back().Head = Doc;
-      RemainingPayload = Result.back().Payload;
-    }
-    Last = Doc;
-  }
-  return std::vector<Chunk>(Result); // no move, shrink-to-fit
-}
-
-/// Reads variable length DocID from the buffer and updates the buffer size. If
-/// the stream is terminated, return std::nullopt.
-std::optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
-  if (Bytes.front() == 0 || Bytes.empty())
-    return std::nullopt;
-  DocID Result = 0;
-  bool HasNextByte = true;
-  for (size_t Length = 0; HasNextByte && !Bytes.empty(); ++Length) {
-    assert(Length <= 5 && "Malformed VByte encoding sequence.");
-    // Write meaningful bits to the correct place in the document decoding.
-    Result |= (Bytes.front() & 0x7f) << (BitsPerEncodingByte * Length);
-    if ((Bytes.front() & 0x80) == 0)
-      HasNextByte = false;
-    Bytes = Bytes.drop_front();
-  }
-  return Result;
-}
-
 } // namespace
 
-llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
-  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result{Head};
-  llvm::ArrayRef<uint8_t> Bytes(Payload);
-  DocID Delta;
-  for (DocID Current = Head; !Bytes.empty(); Current += Delta) {
-    auto MaybeDelta = readVByte(Bytes);
-    if (!MaybeDelta)
-      break;
-    Delta = *MaybeDelta;
-    Result.push_back(Current + Delta);
+PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
+    : Size(Documents.size()) {
+  size_t NumBlocks = llvm::divideCeil(Documents.size(), BlockSize);
+  Data.resize(2 * NumBlocks);
+  for (size_t B = 0; B < NumBlocks; ++B) {
+    llvm::ArrayRef<DocID> Docs =
+        Documents.slice(B * BlockSize).take_front(BlockSize);
+    DocID MaxGap = 1;
+    for (size_t I = 1; I < Docs.size(); ++I) {
+      assert(Docs[I - 1] < Docs[I] && "DocIDs must be sorted and unique.");
+      MaxGap = std::max(MaxGap, Docs[I] - Docs[I - 1]);
+    }
+    unsigned Width = llvm::Log2_32(MaxGap) + 1;
+    size_t Offset = Data.size() - 2 * NumBlocks;
+    assert(Offset < (size_t(1) << (32 - WidthBits)) &&
+           "Posting list is too large.");
+    Data[B] = Docs.front();
+    Data[NumBlocks + B] = Offset << WidthBits | Width;
+
+    Data.resize(Data.size() + llvm::divideCeil((Docs.size() - 1) * Width, 32));
+    uint32_t *Words = Data.data() + 2 * NumBlocks + Offset;
+    for (size_t I = 1; I < Docs.size(); ++I) {
+      size_t Bit = (I - 1) * Width;
+      uint64_t Gap = uint64_t(Docs[I] - Docs[I - 1]) << (Bit % 32);
+      Words[Bit / 32] |= uint32_t(Gap);
+      if (Gap >> 32)
+        Words[Bit / 32 + 1] |= uint32_t(Gap >> 32);
+    }
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
+  // Decoding reads one word past the packed gaps of a block.
+  Data.push_back(0);
+  Data.shrink_to_fit();
 }
 
-PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
-    : Chunks(encodeStream(Documents)) {}
-
 std::unique_ptr<Iterator> PostingList::iterator(const Token *Tok) const {
-  return std::make_unique<ChunkIterator>(Tok, Chunks);
+  return std::make_unique<BlockIterator>(Tok, Size, Data);
 }
 
 } // namespace dex
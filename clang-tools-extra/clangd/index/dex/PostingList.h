@@ -13,10 +13,11 @@
 /// traversed in order using an iterator and are values for inverted index,
 /// which maps search tokens to corresponding posting lists.
 ///
-/// In order to decrease size of Index in-memory representation, Variable Byte
-/// Encoding (VByte) is used for PostingLists compression. An overview of VByte
-/// algorithm can be found in "Introduction to Information Retrieval" book:
-/// https://nlp.stanford.edu/IR-book/html/htmledition/variable-byte-codes-1.html
+/// In order to decrease size of Index in-memory representation, PostingLists
+/// are split into fixed-size blocks, and the gaps between subsequent DocIDs of
+/// each block are bit-packed using the width of the largest gap in the block.
+/// The first DocID of every block is stored separately, so that iterators can
+/// skip over whole blocks without decoding them.
 ///
 //===----------------------------------------------------------------------===//
 
@@ -25,7 +26,6 @@
 
 #include "Iterator.h"
 #include "llvm/ADT/ArrayRef.h"
-#include "llvm/ADT/SmallVector.h"
 #include <cstdint>
 #include <vector>
 
@@ -39,37 +39,28 @@ class Token;
 /// Chunk is a fixed-width piece of PostingList which contains the first DocID
 /// in uncompressed format (Head) and delta-encoded Payload. It can be
 /// decompressed upon request.
-struct Chunk {
-  /// Keep sizeof(Chunk) == 32.
-  static constexpr size_t PayloadSize = 32 - sizeof(DocID);
-
-  llvm::SmallVector<DocID, PayloadSize + 1> decompress() const;
-
-  /// The first element of decompressed Chunk.
-  DocID Head;
-  /// VByte-encoded deltas.
-  std::array<uint8_t, PayloadSize> Payload;
-};
-static_assert(sizeof(Chunk) == 32, "Chunk should take 32 bytes of memory.");
-
-/// PostingList is the storage of DocIDs which can be inserted to the Query
-/// Tree as a leaf by constructing Iterator over the PostingList object. DocIDs
-/// are stored in underlying chunks. Compression saves memory at a small cost
-/// in access time, which is still fast enough in practice.
 class PostingList {
 public:
+  /// Maximum number of DocIDs in each block.
+  static constexpr size_t BlockSize = 64;
+
   explicit PostingList(llvm::ArrayRef<DocID> Documents);
 
   /// Constructs DocumentIterator over given posting list. DocumentIterator will
-  /// go through the chunks and decompress them on-the-fly when necessary.
+  /// skip over the blocks and decode them on-the-fly when necessary.
   /// If given, Tok is only used for the string representation.
   std::unique_ptr<Iterator> iterator(const Token *Tok = nullptr) const;
 
   /// Returns in-memory size of external storage.
-  size_t bytes() const { return Chunks.capacity() * sizeof(Chunk); }
+  size_t bytes() const { return Data.capacity() * sizeof(uint32_t); }
 
 private:
-  const std::vector<Chunk> Chunks;
+  /// The number of DocIDs in the list.
+  uint32_t Size;
+  /// For N blocks, the first DocID of each block, then for each block the
+  /// offset of its first packed word and the width of its gaps, then the
+  /// packed gaps.
+  std::vector<uint32_t> Data;
 };
 
 } // namespace dex
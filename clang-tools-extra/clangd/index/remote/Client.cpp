@@ -15,13 +15,19 @@
 #include "marshalling/Marshalling.h"
 #include "support/Logger.h"
 #include "support/Trace.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 
 #include <atomic>
 #include <chrono>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace clang {
 namespace clangd {
@@ -44,6 +50,60 @@ llvm::StringRef toString(const grpc_connectivity_state &State) {
   llvm_unreachable("Not a valid grpc_connectivity_state.");
 }
 
+constexpr trace::Metric ReplyCacheAccess("remote_index_cache_access",
+                                         trace::Metric::Counter, "result");
+
+// Recently received replies, keyed by the serialized request. The server only
+// reloads its index periodically, so replies stay valid for a while. Streamed
+// results are kept serialized to avoid depending on the message type.
+class ReplyCache {
+public:
+  struct Entry {
+    std::string Key;
+    std::chrono::steady_clock::time_point Time;
+    std::vector<std::string> Results;
+    bool HasMore;
+  };
+
+  ReplyCache(size_t Capacity, std::chrono::steady_clock::duration MaxAge)
+      : Capacity(Capacity), MaxAge(MaxAge) {}
+
+  std::optional<Entry> get(llvm::StringRef Key) {
+    if (!Capacity)
+      return std::nullopt;
+    std::lock_guard<std::mutex> Lock(Mu);
+    auto It = llvm::find_if(LRU, [&](const Entry &E) { return E.Key == Key; });
+    if (It == LRU.end() ||
+        std::chrono::steady_clock::now() - It->Time > MaxAge) {
+      if (It != LRU.end())
+        LRU.erase(It);
+      ReplyCacheAccess.record(1, "miss");
+      return std::nullopt;
+    }
+    LRU.splice(LRU.begin(), LRU, It);
+    ReplyCacheAccess.record(1, "hit");
+    return *It;
+  }
+
+  void put(Entry E) {
+    if (!Capacity)
+      return;
+    E.Time = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> Lock(Mu);
+    LRU.remove_if([&](const Entry &Old) { return Old.Key == E.Key; });
+    LRU.push_front(std::move(E));
+    if (LRU.size() > Capacity)
+      LRU.pop_back();
+  }
+
+private:
+  const size_t Capacity;
+  const std::chrono::steady_clock::duration MaxAge;
+  std::mutex Mu;
+  // Most recently used first.
+  std::list<Entry> LRU;
+};
+
 class IndexClient : public clangd::SymbolIndex {
   void updateConnectionStatus() const {
     auto NewStatus = Channel->GetState(/*try_to_connect=*/false);
@@ -71,6 +131,36 @@ class IndexClient : public clangd::SymbolIndex {
     trace::Span Tracer(RequestT::descriptor()->name());
     const auto RPCRequest = ProtobufMarshaller->toProtobuf(Request);
     SPAN_ATTACH(Tracer, "Request", RPCRequest.DebugString());
+    ReplyT Reply;
+    unsigned Successful = 0;
+    unsigned FailedToParse = 0;
+    auto Deliver = [&](const ReplyT &Message) {
+      auto Response =
+          ProtobufMarshaller->fromProtobuf(Message.stream_result());
+      if (!Response) {
+        elog("Received invalid {0}: {1}. Reason: {2}",
+             ReplyT::descriptor()->name(),
+             Message.stream_result().DebugString(), Response.takeError());
+        ++FailedToParse;
+        return;
+      }
+      Callback(*Response);
+      ++Successful;
+    };
+
+    std::string CacheKey(RequestT::descriptor()->name());
+    CacheKey += '\0';
+    CacheKey += RPCRequest.SerializeAsString();
+    if (auto Cached = Cache.get(CacheKey)) {
+      for (const std::string &Result : Cached->Results) {
+        Reply.mutable_stream_result()->ParseFromString(Result);
+        Deliver(Reply);
+      }
+      SPAN_ATTACH(Tracer, "Cached", true);
+      SPAN_ATTACH(Tracer, "Successful", Successful);
+      return Cached->HasMore;
+    }
+
     grpc::ClientContext Context;
     Context.AddMetadata("version", versionString());
     Context.AddMetadata("features", featureString());
@@ -82,31 +172,28 @@ class IndexClient : public clangd::SymbolIndex {
     auto Reader = (Stub.get()->*RPCCall)(&Context, RPCRequest);
     dlog("Sending {0}: {1}", RequestT::descriptor()->name(),
          RPCRequest.DebugString());
-    ReplyT Reply;
-    unsigned Successful = 0;
-    unsigned FailedToParse = 0;
+    ReplyCache::Entry ToCache;
+    ToCache.Key = std::move(CacheKey);
     while (Reader->Read(&Reply)) {
       if (!Reply.has_stream_result()) {
         HasMore = Reply.final_result().has_more();
         continue;
       }
-      auto Response = ProtobufMarshaller->fromProtobuf(Reply.stream_result());
-      if (!Response) {
-        elog("Received invalid {0}: {1}. Reason: {2}",
-             ReplyT::descriptor()->name(), Reply.stream_result().DebugString(),
-             Response.takeError());
-        ++FailedToParse;
-        continue;
-      }
-      Callback(*Response);
-      ++Successful;
+      ToCache.Results.push_back(Reply.stream_result().SerializeAsString());
+      Deliver(Reply);
     }
     auto Millis = std::chrono::duration_cast<std::chrono::milliseconds>(
                       std::chrono::system_clock::now() - StartTime)
                       .count();
     vlog("Remote index [{0}]: {1} => {2} results in {3}ms.", ServerAddress,
          RequestT::descriptor()->name(), Successful, Millis);
-    SPAN_ATTACH(Tracer, "Status", Reader->Finish().ok());
+    bool OK = Reader->Finish().ok();
+    // Only complete, valid replies are reused.
+    if (OK && !FailedToParse) {
+      ToCache.HasMore = HasMore;
+      Cache.put(std::move(ToCache));
+    }
+    SPAN_ATTACH(Tracer, "Status", OK);
     SPAN_ATTACH(Tracer, "Successful", Successful);
     SPAN_ATTACH(Tracer, "Failed to parse", FailedToParse);
     updateConnectionStatus();
@@ -117,13 +204,15 @@ public:
   IndexClient(
       std::shared_ptr<grpc::Channel> Channel, llvm::StringRef Address,
       llvm::StringRef ProjectRoot,
-      std::chrono::milliseconds DeadlineTime = std::chrono::milliseconds(1000))
+      std::chrono::milliseconds DeadlineTime = std::chrono::milliseconds(1000),
+      size_t CacheCapacity = 256,
+      std::chrono::seconds CacheMaxAge = std::chrono::seconds(30))
       : Stub(remote::v1::SymbolIndex::NewStub(Channel)), Channel(Channel),
         ServerAddress(Address),
         ConnectionStatus(Channel->GetState(/*try_to_connect=*/true)),
         ProtobufMarshaller(new Marshaller(/*RemoteIndexRoot=*/"",
                                           /*LocalIndexRoot=*/ProjectRoot)),
-        DeadlineWaitingTime(DeadlineTime) {
+        DeadlineWaitingTime(DeadlineTime), Cache(CacheCapacity, CacheMaxAge) {
     assert(!ProjectRoot.empty());
   }
 
@@ -178,6 +267,7 @@ private:
   std::unique_ptr<Marshaller> ProtobufMarshaller;
   // Each request will be terminated if it takes too long.
   std::chrono::milliseconds DeadlineWaitingTime;
+  mutable ReplyCache Cache;
 };
 
 } // namespace
@@ -111,8 +111,24 @@ llvm::cl::opt<size_t> LimitResults(
                    "single request. Limit is to keep the server from being "
                    "DOS'd. Defaults to 10000."));
 
+llvm::cl::opt<std::string> MetricsFile(
+    "metrics-file",
+    llvm::cl::desc("Path to the file where request latency and response size "
+                   "metrics will be written as CSV. Ignored if --trace-file "
+                   "is set."));
+
 static Key<grpc::ServerContext *> CurrentRequest;
 
+// Time to serve a request, in milliseconds.
+constexpr trace::Metric RequestLatency("request_latency",
+                                       trace::Metric::Distribution, "request");
+// Bytes of the serialized messages streamed in response to a request.
+constexpr trace::Metric ResponseSize("response_size",
+                                     trace::Metric::Distribution, "request");
+constexpr trace::Metric ResponseResults("response_results",
+                                        trace::Metric::Distribution,
+                                        "request");
+
 class RemoteIndexServer final : public v1::SymbolIndex::Service {
 public:
   RemoteIndexServer(clangd::SymbolIndex &Index, llvm::StringRef IndexRoot)
@@ -141,6 +157,7 @@ private:
     }
     unsigned Sent = 0;
     unsigned FailedToSend = 0;
+    size_t Bytes = 0;
     bool HasMore = false;
     Index.lookup(*Req, [&](const clangd::Symbol &Item) {
       if (Sent >= LimitResults) {
@@ -157,6 +174,7 @@ private:
       LookupReply NextMessage;
       *NextMessage.mutable_stream_result() = *SerializedItem;
       logResponse(NextMessage);
+      Bytes += NextMessage.ByteSizeLong();
       Reply->Write(NextMessage);
       ++Sent;
     });
@@ -165,10 +183,11 @@ private:
     LookupReply LastMessage;
     LastMessage.mutable_final_result()->set_has_more(HasMore);
     logResponse(LastMessage);
+    Bytes += LastMessage.ByteSizeLong();
     Reply->Write(LastMessage);
     SPAN_ATTACH(Tracer, "Sent", Sent);
     SPAN_ATTACH(Tracer, "Failed to send", FailedToSend);
-    logRequestSummary("v1/Lookup", Sent, StartTime);
+    logRequestSummary("v1/Lookup", Sent, Bytes, StartTime);
     return grpc::Status::OK;
   }
 
@@ -192,6 +211,7 @@ private:
     }
     unsigned Sent = 0;
     unsigned FailedToSend = 0;
+    size_t Bytes = 0;
     bool HasMore = Index.fuzzyFind(*Req, [&](const clangd::Symbol &Item) {
       auto SerializedItem = ProtobufMarshaller->toProtobuf(Item);
       if (!SerializedItem) {
@@ -203,16 +223,18 @@ private:
       FuzzyFindReply NextMessage;
       *NextMessage.mutable_stream_result() = *SerializedItem;
       logResponse(NextMessage);
+      Bytes += NextMessage.ByteSizeLong();
       Reply->Write(NextMessage);
       ++Sent;
     });
     FuzzyFindReply LastMessage;
     LastMessage.mutable_final_result()->set_has_more(HasMore);
     logResponse(LastMessage);
+    Bytes += LastMessage.ByteSizeLong();
     Reply->Write(LastMessage);
     SPAN_ATTACH(Tracer, "Sent", Sent);
     SPAN_ATTACH(Tracer, "Failed to send", FailedToSend);
-    logRequestSummary("v1/FuzzyFind", Sent, StartTime);
+    logRequestSummary("v1/FuzzyFind", Sent, Bytes, StartTime);
     return grpc::Status::OK;
   }
 
@@ -234,6 +256,7 @@ private:
     }
     unsigned Sent = 0;
     unsigned FailedToSend = 0;
+    size_t Bytes = 0;
     bool HasMore = Index.refs(*Req, [&](const clangd::Ref &Item) {
       auto SerializedItem = ProtobufMarshaller->toProtobuf(Item);
       if (!SerializedItem) {
@@ -245,16 +268,18 @@ private:
       RefsReply NextMessage;
       *NextMessage.mutable_stream_result() = *SerializedItem;
       logResponse(NextMessage);
+      Bytes += NextMessage.ByteSizeLong();
       Reply->Write(NextMessage);
       ++Sent;
     });
     RefsReply LastMessage;
     LastMessage.mutable_final_result()->set_has_more(HasMore);
     logResponse(LastMessage);
+    Bytes += LastMessage.ByteSizeLong();
     Reply->Write(LastMessage);
     SPAN_ATTACH(Tracer, "Sent", Sent);
     SPAN_ATTACH(Tracer, "Failed to send", FailedToSend);
-    logRequestSummary("v1/Refs", Sent, StartTime);
+    logRequestSummary("v1/Refs", Sent, Bytes, StartTime);
     return grpc::Status::OK;
   }
 
@@ -279,6 +304,7 @@ private:
     }
     unsigned Sent = 0;
     unsigned FailedToSend = 0;
+    size_t Bytes = 0;
     Index.relations(
         *Req, [&](const SymbolID &Subject, const clangd::Symbol &Object) {
           auto SerializedItem = ProtobufMarshaller->toProtobuf(Subject, Object);
@@ -291,16 +317,18 @@ private:
           RelationsReply NextMessage;
           *NextMessage.mutable_stream_result() = *SerializedItem;
           logResponse(NextMessage);
+          Bytes += NextMessage.ByteSizeLong();
           Reply->Write(NextMessage);
           ++Sent;
         });
     RelationsReply LastMessage;
     LastMessage.mutable_final_result()->set_has_more(true);
     logResponse(LastMessage);
+    Bytes += LastMessage.ByteSizeLong();
     Reply->Write(LastMessage);
     SPAN_ATTACH(Tracer, "Sent", Sent);
     SPAN_ATTACH(Tracer, "Failed to send", FailedToSend);
-    logRequestSummary("v1/Relations", Sent, StartTime);
+    logRequestSummary("v1/Relations", Sent, Bytes, StartTime);
     return grpc::Status::OK;
   }
 
@@ -320,12 +348,17 @@ private:
     vlog(">>> {0}\n{1}", M.GetDescriptor()->name(), TextProto{M});
   }
   void logRequestSummary(llvm::StringLiteral RequestName, unsigned Sent,
-                         stopwatch::time_point StartTime) {
+                         size_t Bytes, stopwatch::time_point StartTime) {
     auto Duration = stopwatch::now() - StartTime;
     auto Millis =
         std::chrono::duration_cast<std::chrono::milliseconds>(Duration).count();
-    log("[public] request {0} => OK: {1} results in {2}ms", RequestName, Sent,
-        Millis);
+    log("[public] request {0} => OK: {1} results, {2} bytes in {3}ms",
+        RequestName, Sent, Bytes, Millis);
+    RequestLatency.record(
+        std::chrono::duration<double, std::milli>(Duration).count(),
+        RequestName);
+    ResponseSize.record(Bytes, RequestName);
+    ResponseResults.record(Sent, RequestName);
   }
 
   std::unique_ptr<Marshaller> ProtobufMarshaller;
@@ -506,18 +539,20 @@ int main(int argc, char *argv[]) {
 
   std::optional<llvm::raw_fd_ostream> TracerStream;
   std::unique_ptr<clang::clangd::trace::EventTracer> Tracer;
-  if (!TraceFile.empty()) {
+  llvm::StringRef TracerFile = !TraceFile.empty() ? TraceFile : MetricsFile;
+  if (!TracerFile.empty()) {
     std::error_code EC;
-    TracerStream.emplace(TraceFile, EC,
+    TracerStream.emplace(TracerFile, EC,
                          llvm::sys::fs::FA_Read | llvm::sys::fs::FA_Write);
     if (EC) {
       TracerStream.reset();
-      elog("Error while opening trace file {0}: {1}", TraceFile, EC.message());
+      elog("Error while opening trace file {0}: {1}", TracerFile,
+           EC.message());
     } else {
-      // FIXME(kirillbobyrev): Also create metrics tracer to track latency and
-      // accumulate other request statistics.
-      Tracer = clang::clangd::trace::createJSONTracer(*TracerStream,
-                                                      /*PrettyPrint=*/false);
+      Tracer = !TraceFile.empty()
+                   ? clang::clangd::trace::createJSONTracer(
+                         *TracerStream, /*PrettyPrint=*/false)
+                   : clang::clangd::trace::createCSVMetricTracer(*TracerStream);
       clang::clangd::vlog("Successfully created a tracer.");
     }
   }
@@ -44,30 +44,45 @@ Semaphore::Semaphore(std::size_t MaxLocks) : FreeSlots(MaxLocks) {}
 
 bool Semaphore::try_lock() {
   std::unique_lock<std::mutex> Lock(Mutex);
-  if (FreeSlots > 0) {
+  if (FreeSlots > 0 && UrgentWaiters == 0) {
     --FreeSlots;
     return true;
   }
   return false;
 }
 
-void Semaphore::lock() {
+void Semaphore::lock(bool Urgent) {
   trace::Span Span("WaitForFreeSemaphoreSlot");
   // trace::Span can also acquire locks in ctor and dtor, we make sure it
   // happens when Semaphore's own lock is not held.
+  bool WakeOthers = false;
   {
     std::unique_lock<std::mutex> Lock(Mutex);
-    SlotsChanged.wait(Lock, [&]() { return FreeSlots > 0; });
+    if (Urgent)
+      ++UrgentWaiters;
+    SlotsChanged.wait(Lock, [&]() {
+      return FreeSlots > 0 && (Urgent || UrgentWaiters == 0);
+    });
     --FreeSlots;
+    // Non-urgent waiters may have been passed over for this slot.
+    if (Urgent)
+      WakeOthers = --UrgentWaiters == 0 && FreeSlots > 0;
   }
+  if (WakeOthers)
+    SlotsChanged.notify_all();
 }
 
 void Semaphore::unlock() {
   std::unique_lock<std::mutex> Lock(Mutex);
   ++FreeSlots;
+  bool HasUrgentWaiters = UrgentWaiters > 0;
   Lock.unlock();
 
-  SlotsChanged.notify_one();
+  // Waking a single non-urgent waiter would not let an urgent one through.
+  if (HasUrgentWaiters)
+    SlotsChanged.notify_all();
+  else
+    SlotsChanged.notify_one();
 }
 
 AsyncTaskRunner::~AsyncTaskRunner() { wait(); }
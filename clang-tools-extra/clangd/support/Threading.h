@@ -30,14 +30,18 @@ class Semaphore {
 public:
   Semaphore(std::size_t MaxLocks);
 
+  /// Fails if there are no free slots, or if an urgent lock() is waiting.
   bool try_lock();
-  void lock();
+  void lock() { lock(/*Urgent=*/false); }
+  /// While urgent callers are waiting, free slots are only given to them.
+  void lock(bool Urgent);
   void unlock();
 
 private:
   std::mutex Mutex;
   std::condition_variable SlotsChanged;
   std::size_t FreeSlots;
+  std::size_t UrgentWaiters = 0;
 };
 
 /// A point in time we can wait for.
@@ -405,6 +405,14 @@ opt<PCHStorageFlag> PCHStorage{
     init(PCHStorageFlag::Disk),
 };
 
+opt<unsigned> MemoryLimitMB{
+    "memory-limit",
+    cat(Misc),
+    desc("When ASTs, preambles and indexes use more than this many megabytes, "
+         "drop idle ASTs and store new PCHs on disk. 0 means no limit"),
+    init(0),
+};
+
 opt<bool> Sync{
     "sync",
     cat(Misc),
@@ -513,6 +521,15 @@ opt<bool> PreambleParseForwardingFunctions{
     init(ParseOptions().PreambleParseForwardingFunctions),
 };
 
+opt<bool> EarlyBodyDiagnostics{
+    "early-body-diagnostics",
+    cat(Misc),
+    desc("For edits within a function body, publish diagnostics from parsing "
+         "only that body before rebuilding the whole file"),
+    Hidden,
+    init(ClangdServer::Options().EarlyBodyDiagnostics),
+};
+
 #if defined(__GLIBC__) && CLANGD_MALLOC_TRIM
 opt<bool> EnableMallocTrim{
     "malloc-trim",
@@ -871,6 +888,7 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
     Opts.StorePreamblesInMemory = false;
     break;
   }
+  Opts.MemoryLimit = std::size_t(MemoryLimitMB) << 20;
   if (!ResourceDir.empty())
     Opts.ResourceDir = ResourceDir;
   Opts.BuildDynamicSymbolIndex = true;
@@ -954,6 +972,7 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
   Opts.UseDirtyHeaders = UseDirtyHeaders;
   Opts.PreambleParseForwardingFunctions = PreambleParseForwardingFunctions;
   Opts.ImportInsertions = ImportInsertions;
+  Opts.EarlyBodyDiagnostics = EarlyBodyDiagnostics;
   Opts.QueryDriverGlobs = std::move(QueryDriverGlobs);
   Opts.TweakFilter = [&](const Tweak &T) {
     if (T.hidden() && !HiddenFeatures)
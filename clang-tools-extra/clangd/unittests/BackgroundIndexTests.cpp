@@ -824,6 +824,40 @@ TEST(BackgroundQueueTest, Boost) {
   }
 }
 
+TEST(BackgroundQueueTest, GroupBoost) {
+  std::string Sequence;
+  auto Make = [&](char C, llvm::StringRef Group) {
+    BackgroundQueue::Task T([&Sequence, C] { Sequence.push_back(C); });
+    T.Tag = std::string(1, C);
+    T.GroupTag = Group.str();
+    return T;
+  };
+
+  {
+    BackgroundQueue Q;
+    Q.append({Make('A', "x"), Make('B', "y"), Make('C', "x"), Make('D', "y")});
+    Q.work([&] { Q.stop(); });
+    EXPECT_EQ("ABCD", Sequence) << "equal priorities run in enqueue order";
+  }
+  Sequence.clear();
+  {
+    BackgroundQueue Q;
+    Q.append({Make('A', "x"), Make('B', "y"), Make('C', "x"), Make('D', "y")});
+    Q.boost("y", 1);
+    Q.work([&] { Q.stop(); });
+    EXPECT_EQ("BDAC", Sequence) << "group y was boosted after enqueueing";
+  }
+  Sequence.clear();
+  {
+    BackgroundQueue Q;
+    Q.boost("y", 1);
+    Q.boost("C", 2);
+    Q.append({Make('A', "x"), Make('B', "y"), Make('C', "x"), Make('D', "y")});
+    Q.work([&] { Q.stop(); });
+    EXPECT_EQ("CBDA", Sequence) << "tag boost outranks group boost";
+  }
+}
+
 TEST(BackgroundQueueTest, Duplicates) {
   std::string Sequence;
   BackgroundQueue::Task A([&] { Sequence.push_back('A'); });
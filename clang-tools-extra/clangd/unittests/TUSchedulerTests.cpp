@@ -38,6 +38,7 @@
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -643,6 +644,43 @@ TEST_F(TUSchedulerTests, EvictedAST) {
               UnorderedElementsAre(Foo, AnyOf(Bar, Baz)));
 }
 
+TEST_F(TUSchedulerTests, EvictedASTByteLimit) {
+  auto Opts = optsForTest();
+  Opts.AsyncThreadsCount = 1;
+  Opts.RetentionPolicy.MaxRetainedASTs = 3;
+  // Only the most recently used AST is retained.
+  Opts.RetentionPolicy.MaxRetainedBytes = 1;
+  TUScheduler S(CDB, Opts);
+
+  auto Foo = testPath("foo.cpp");
+  auto Bar = testPath("bar.cpp");
+  updateWithCallback(S, Foo, "int x;", WantDiagnostics::Yes, [] {});
+  updateWithCallback(S, Bar, "int x;", WantDiagnostics::Yes, [] {});
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  EXPECT_THAT(S.getFilesWithCachedAST(), ElementsAre(Bar));
+}
+
+TEST_F(TUSchedulerTests, ReleaseIdleASTs) {
+  auto Opts = optsForTest();
+  Opts.AsyncThreadsCount = 1;
+  Opts.RetentionPolicy.MaxRetainedASTs = 3;
+  TUScheduler S(CDB, Opts);
+
+  auto Foo = testPath("foo.cpp");
+  auto Bar = testPath("bar.cpp");
+  updateWithCallback(S, Foo, "int x;", WantDiagnostics::Yes, [] {});
+  updateWithCallback(S, Bar, "int x;", WantDiagnostics::Yes, [] {});
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  ASSERT_THAT(S.getFilesWithCachedAST(), UnorderedElementsAre(Foo, Bar));
+
+  // The least recently used AST goes first.
+  EXPECT_GT(S.releaseIdleASTs(1), 0u);
+  EXPECT_THAT(S.getFilesWithCachedAST(), ElementsAre(Bar));
+  EXPECT_GT(S.releaseIdleASTs(std::numeric_limits<std::size_t>::max()), 0u);
+  EXPECT_THAT(S.getFilesWithCachedAST(), IsEmpty());
+  EXPECT_EQ(S.releaseIdleASTs(1), 0u);
+}
+
 // We send "empty" changes to TUScheduler when we think some external event
 // *might* have invalidated current state (e.g. a header was edited).
 // Verify that this doesn't evict our cache entries.
@@ -1204,6 +1242,103 @@ TEST_F(TUSchedulerTests, OnlyPublishWhenPreambleIsBuilt) {
   EXPECT_EQ(PreamblePublishCount, 2);
 }
 
+TEST_F(TUSchedulerTests, PreambleReusedAcrossWarningFlags) {
+  struct PreamblePublishCounter : public ParsingCallbacks {
+    PreamblePublishCounter(int &PreamblePublishCount)
+        : PreamblePublishCount(PreamblePublishCount) {}
+    void onPreamblePublished(PathRef File) override { ++PreamblePublishCount; }
+    int &PreamblePublishCount;
+  };
+
+  int PreamblePublishCount = 0;
+  TUScheduler S(CDB, optsForTest(),
+                std::make_unique<PreamblePublishCounter>(PreamblePublishCount));
+
+  Path File = testPath("foo.cpp");
+  auto WithFlags = [&](std::vector<std::string> Flags) {
+    ParseInputs Inputs = getInputs(File, "#define FOO\nint x;");
+    auto &Argv = Inputs.CompileCommand.CommandLine;
+    Argv.insert(Argv.begin() + 1, Flags.begin(), Flags.end());
+    return Inputs;
+  };
+  S.update(File, WithFlags({}), WantDiagnostics::Auto);
+  S.blockUntilIdle(timeoutSeconds(60));
+  EXPECT_EQ(PreamblePublishCount, 1);
+  // Warning flags don't change the preamble.
+  S.update(File, WithFlags({"-Wall", "-Wno-unused", "-w"}),
+           WantDiagnostics::Auto);
+  S.blockUntilIdle(timeoutSeconds(60));
+  EXPECT_EQ(PreamblePublishCount, 1);
+  // Turning warnings into errors does.
+  S.update(File, WithFlags({"-Wall", "-Werror"}), WantDiagnostics::Auto);
+  S.blockUntilIdle(timeoutSeconds(60));
+  EXPECT_EQ(PreamblePublishCount, 2);
+  // So do flags that change the AST.
+  S.update(File, WithFlags({"-Wall", "-Werror", "-DBAR"}),
+           WantDiagnostics::Auto);
+  S.blockUntilIdle(timeoutSeconds(60));
+  EXPECT_EQ(PreamblePublishCount, 3);
+}
+
+TEST_F(TUSchedulerTests, EarlyBodyDiagnostics) {
+  struct CaptureEarlyDiags : public ParsingCallbacks {
+    CaptureEarlyDiags(std::vector<std::vector<std::string>> &Published)
+        : Published(Published) {}
+    void onEarlyDiagnostics(PathRef File, llvm::StringRef Version,
+                            std::vector<Diag> Diags,
+                            PublishFn Publish) override {
+      std::vector<std::string> Lines;
+      for (const Diag &D : Diags)
+        Lines.push_back(llvm::formatv("{0}: {1}", D.Range.start.line,
+                                      D.Message)
+                            .str());
+      Published.push_back(std::move(Lines));
+    }
+    std::vector<std::vector<std::string>> &Published;
+  };
+
+  std::vector<std::vector<std::string>> Published;
+  auto Opts = optsForTest();
+  Opts.EarlyBodyDiagnostics = true;
+  TUScheduler S(CDB, Opts, std::make_unique<CaptureEarlyDiags>(Published));
+
+  Path File = testPath("foo.cpp");
+  S.update(File, getInputs(File, R"cpp(int before() { return a; }
+int edited() {
+  return 0;
+}
+int after() { return c; })cpp"),
+           WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  EXPECT_THAT(Published, IsEmpty());
+
+  // Only the edited body is reparsed, the other diagnostics move with it.
+  S.update(File, getInputs(File, R"cpp(int before() { return a; }
+int edited() {
+  int x;
+  return b;
+}
+int after() { return c; })cpp"),
+           WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  ASSERT_THAT(Published, SizeIs(1));
+  EXPECT_THAT(Published[0],
+              ElementsAre("0: use of undeclared identifier 'a'",
+                          "3: use of undeclared identifier 'b'",
+                          "5: use of undeclared identifier 'c'"));
+
+  // Edits that change the structure of the file need a full rebuild.
+  S.update(File, getInputs(File, R"cpp(int before() { return a; }
+int edited() {
+  int x;
+  return b; }
+}
+int after() { return c; })cpp"),
+           WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  EXPECT_THAT(Published, SizeIs(1));
+}
+
 TEST_F(TUSchedulerTests, PublishWithStalePreamble) {
   // Callbacks that blocks the preamble thread after the first preamble is
   // built and stores preamble/main-file versions for diagnostics released.
@@ -3247,6 +3247,17 @@ public:
   /// declarations were built.
   unsigned NumImplicitDestructorsDeclared = 0;
 
+  /// The number of constant evaluations performed.
+  unsigned NumConstantEvaluations = 0;
+
+  /// The number of evaluation steps taken by the tree-walking constant
+  /// evaluator, as counted against -fconstexpr-steps.
+  uint64_t NumConstexprEvaluatorSteps = 0;
+
+  /// The number of bytecode instructions executed by the experimental
+  /// constant interpreter.
+  uint64_t NumConstexprInterpreterOps = 0;
+
 public:
   /// Initialize built-in types.
   ///
@@ -26,6 +26,11 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
+
+namespace llvm {
+class raw_fd_ostream;
+} // namespace llvm
 
 namespace clang {
 
@@ -84,6 +89,36 @@ public:
                           llvm::vfs::FileSystem &FS) override;
 };
 
+/// A stat cache shared by all the compiler processes of a build on one
+/// machine, through an append-only file in \p CacheDir named after a token
+/// that identifies the build.
+///
+/// Only absolute paths below one of \p Prefixes are cached, including paths
+/// that do not exist. The prefixes should name directories whose contents do
+/// not change while the build is running, such as the system header and SDK
+/// directories, since entries are never invalidated during the build.
+class SharedStatCache : public FileSystemStatCache {
+public:
+  SharedStatCache(StringRef CacheDir, uint64_t BuildToken,
+                  std::vector<std::string> Prefixes);
+
+  std::error_code getStat(StringRef Path, llvm::vfs::Status &Status,
+                          bool isFile,
+                          std::unique_ptr<llvm::vfs::File> *F,
+                          llvm::vfs::FileSystem &FS) override;
+
+private:
+  bool isCacheable(StringRef Path) const;
+  void record(StringRef Path, const llvm::vfs::Status *Status);
+
+  /// Cached results, with std::nullopt for paths that do not exist.
+  llvm::StringMap<std::optional<llvm::vfs::Status>, llvm::BumpPtrAllocator>
+      Entries;
+  std::vector<std::string> Prefixes;
+  /// The cache file, opened for appending, or null if it cannot be written.
+  std::unique_ptr<llvm::raw_fd_ostream> CacheFile;
+};
+
 } // namespace clang
 
 #endif // LLVM_CLANG_BASIC_FILESYSTEMSTATCACHE_H
@@ -72,6 +72,9 @@ public:
   /// stderr.
   std::string HeaderIncludeOutputFile;
 
+  /// The file to write the include cost report to.
+  std::string IncludeCostReportFile;
+
   /// A list of names to use as the targets in the dependency file; this list
   /// must contain at least one entry.
   std::vector<std::string> Targets;
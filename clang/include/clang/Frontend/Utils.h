@@ -185,6 +185,11 @@ void AttachHeaderIncludeGen(Preprocessor &PP,
                             StringRef OutputPath = {},
                             bool ShowDepth = true, bool MSStyle = false);
 
+/// AttachIncludeCostProfiler - Create a profiler that writes the time and
+/// tokens spent in every included header to \p OutputPath, ranked by cost,
+/// and attach it to the given preprocessor.
+void AttachIncludeCostProfiler(Preprocessor &PP, StringRef OutputPath);
+
 /// The ChainedIncludesSource class converts headers to chained PCHs in
 /// memory, mainly for testing.
 IntrusiveRefCntPtr<ExternalSemaSource>
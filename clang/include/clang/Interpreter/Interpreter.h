@@ -87,6 +87,17 @@ public:
   virtual TransformExprFunction *getPrintValueTransformer() = 0;
 };
 
+/// Wall-clock seconds spent on the phases of an input.
+struct InputTiming {
+  /// Parsing and semantic analysis, which clang does in a single pass.
+  double Frontend = 0;
+  /// Generating LLVM IR.
+  double CodeGen = 0;
+  /// Compiling the IR in the JIT and running the input's top-level code. With
+  /// lazy compilation, only the functions that ran are compiled.
+  double Execute = 0;
+};
+
 /// Provides top-level interfaces for incremental compilation and execution.
 class Interpreter {
   std::unique_ptr<llvm::orc::ThreadSafeContext> TSCtx;
@@ -99,6 +110,10 @@ class Interpreter {
 
   unsigned InitPTUSize = 0;
 
+  bool LazyCompilation = false;
+
+  InputTiming LastInputTiming;
+
   // This member holds the last result of the value printing. It's a class
   // member because we might want to access it after more inputs. If no value
   // printing happens, it's in an invalid state.
@@ -154,6 +169,15 @@ public:
   llvm::Error ParseAndExecute(llvm::StringRef Code, Value *V = nullptr);
   llvm::Expected<llvm::orc::ExecutorAddr> CompileDtorCall(CXXRecordDecl *CXXRD);
 
+  /// Compile functions when they are first called instead of when the input
+  /// that defines them is executed. Takes effect when the execution engine is
+  /// created, and is only supported for in-process execution.
+  void setLazyCompilation(bool Enable) { LazyCompilation = Enable; }
+
+  /// \returns the time spent on the last input passed to \c Parse, \c Execute
+  /// or \c ParseAndExecute.
+  const InputTiming &getLastInputTiming() const { return LastInputTiming; }
+
   /// Undo N previous incremental inputs.
   llvm::Error Undo(unsigned N = 1);
 
@@ -28,6 +28,7 @@
 #include <cassert>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -284,6 +285,13 @@ class HeaderSearch {
   /// The index of the first SearchDir that isn't a header map.
   unsigned FirstNonHeaderMapSearchDirIdx = 0;
 
+  /// Lower-cased names of the entries of normal search directories, used with
+  /// -findex-header-search-paths to avoid probing directories that cannot
+  /// contain the requested file. Directories that could not be listed map to
+  /// std::nullopt.
+  llvm::DenseMap<const DirectoryEntry *, std::optional<llvm::StringSet<>>>
+      SearchDirContents;
+
   /// \#include prefixes for which the 'system header' property is
   /// overridden.
   ///
@@ -813,6 +821,10 @@ private:
       FileEntryRef File, StringRef FrameworkName, Module *RequestingModule,
       ModuleMap::KnownHeader *SuggestedModule, bool IsSystemFramework);
 
+  /// Returns false if the search directory \p Dir is known not to contain
+  /// \p Filename, which is relative to it.
+  bool mayContainFile(DirectoryEntryRef Dir, StringRef Filename);
+
   /// Look up the file with the specified name and determine its owning
   /// module.
   OptionalFileEntryRef
@@ -184,6 +184,10 @@ public:
   /// loading.
   uint64_t BuildSessionTimestamp = 0;
 
+  /// The directory holding the stat cache shared by the compilations of the
+  /// build session identified by \c BuildSessionTimestamp, if any.
+  std::string SharedStatCachePath;
+
   /// The set of macro names that should be ignored for the purposes
   /// of computing the module hash.
   llvm::SmallSetVector<llvm::CachedHashString, 16> ModulesIgnoreMacros;
@@ -271,6 +275,17 @@ public:
   LLVM_PREFERRED_TYPE(bool)
   unsigned ModulesIncludeVFSUsage : 1;
 
+  /// Whether to list the contents of each normal search directory once and
+  /// skip directories that cannot contain the file being looked up.
+  LLVM_PREFERRED_TYPE(bool)
+  unsigned IndexSearchPaths : 1;
+
+  /// Whether module files may be memory-mapped instead of read into memory.
+  /// This is only safe if module files are never modified in place while the
+  /// compiler is using them.
+  LLVM_PREFERRED_TYPE(bool)
+  unsigned ModulesMMapFiles : 1;
+
   HeaderSearchOptions(StringRef _Sysroot = "/")
       : Sysroot(_Sysroot), ModuleFormat("raw"), DisableModuleHash(false),
         ImplicitModuleMaps(false), ModuleMapFileHomeIsCwd(false),
@@ -286,7 +301,8 @@ public:
         ModulesSkipHeaderSearchPaths(false),
         ModulesSkipPragmaDiagnosticMappings(false),
         ModulesPruneNonAffectingModuleMaps(true), ModulesHashContent(false),
-        ModulesStrictContextHash(false), ModulesIncludeVFSUsage(false) {}
+        ModulesStrictContextHash(false), ModulesIncludeVFSUsage(false),
+        IndexSearchPaths(false), ModulesMMapFiles(false) {}
 
   /// AddPath - Add the \p Path path to the specified \p Group list.
   void AddPath(StringRef Path, frontend::IncludeDirGroup Group,
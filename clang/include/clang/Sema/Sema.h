@@ -8808,6 +8808,23 @@ public:
   /// The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// The number of class template specializations and function template
+  /// instantiations that were performed in this TU, and of those that were
+  /// imported, with a definition, from an AST file and therefore did not have
+  /// to be instantiated again.
+  unsigned NumClassInstantiations = 0;
+  unsigned NumFunctionInstantiations = 0;
+  unsigned NumImportedClassSpecializationsReused = 0;
+  unsigned NumImportedFunctionDefinitionsReused = 0;
+
+  /// The number of overload candidates that were added, and of those that
+  /// were rejected because of their arity or by a quick check that an argument
+  /// of class type cannot be converted to a scalar parameter, in either case
+  /// before any conversion sequence was computed for them.
+  unsigned NumOverloadCandidates = 0;
+  unsigned NumOverloadCandidatesPrunedByArity = 0;
+  unsigned NumOverloadCandidatesPrunedByConversion = 0;
+
   ArrayRef<sema::FunctionScopeInfo *> getFunctionScopes() const {
     return llvm::ArrayRef(FunctionScopes.begin() + FunctionScopesStart,
                           FunctionScopes.end());
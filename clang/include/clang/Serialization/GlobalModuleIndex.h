@@ -65,6 +65,13 @@ class GlobalModuleIndex {
   /// GlobalModuleIndex.
   void *IdentifierIndex;
 
+  /// The selector index, an array of (selector hash, module ID) pairs of
+  /// little-endian 32-bit integers sorted by hash. Points into \c Buffer.
+  llvm::StringRef SelectorIndex;
+
+  /// Whether the index file has a selector index at all.
+  bool HasSelectorIndex = false;
+
   /// Information about a given module file.
   struct ModuleInfo {
     ModuleInfo() = default;
@@ -111,6 +118,12 @@ class GlobalModuleIndex {
   /// identifier.
   unsigned NumIdentifierLookupHits;
 
+  /// The number of selector lookups we performed.
+  unsigned NumSelectorLookups = 0;
+
+  /// The number of selector lookup hits, where we recognize the selector.
+  unsigned NumSelectorLookupHits = 0;
+
   /// Internal constructor. Use \c readIndex() to read an index.
   explicit GlobalModuleIndex(std::unique_ptr<llvm::MemoryBuffer> Buffer,
                              llvm::BitstreamCursor Cursor);
@@ -155,6 +168,19 @@ public:
   /// \returns true if the identifier is known to the index, false otherwise.
   bool lookupIdentifier(llvm::StringRef Name, HitSet &Hits);
 
+  /// Look for all of the module files whose method pool may have entries for
+  /// a selector.
+  ///
+  /// \param Hash The hash of the selector, see \c serialization::ComputeHash.
+  ///
+  /// \param Hits Will be populated with the set of module files whose method
+  /// pool has a selector with this hash.
+  ///
+  /// \returns true if the index has a selector index, in which case the
+  /// module files known to the index that are not in \p Hits have no method
+  /// pool entry for the selector, false otherwise.
+  bool lookupSelector(unsigned Hash, HitSet &Hits);
+
   /// Note that the given module file has been loaded.
   ///
   /// \returns false if the global module index has information about this
@@ -299,6 +299,14 @@ public:
   ContinuousRangeMap<SourceLocation::UIntTy, SourceLocation::IntTy, 2>
       SLocRemap;
 
+  /// The number of bytes of embedded file contents that were handed to the
+  /// source manager in place, pointing into \c Buffer.
+  uint64_t SLocBufferBytesReferenced = 0;
+
+  /// The number of bytes of embedded file contents that had to be
+  /// decompressed into a separate buffer.
+  uint64_t SLocBufferBytesCopied = 0;
+
   // === Identifiers ===
 
   /// The number of identifiers in this AST file.
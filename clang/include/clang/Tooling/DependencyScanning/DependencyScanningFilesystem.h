@@ -220,9 +220,26 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Sets the directory of an on-disk cache of scanned directive tokens,
+  /// keyed by file contents, that can be shared between processes. An empty
+  /// path disables the cache.
+  void setDirectivesCachePath(StringRef Path) {
+    DirectivesCachePath = Path.str();
+  }
+  StringRef getDirectivesCachePath() const { return DirectivesCachePath; }
+
+  /// Forgets everything cached about the given absolute paths, so that the
+  /// next scan reads them from the underlying file system again. Other names
+  /// of the same files are forgotten as well.
+  ///
+  /// Must not be called while any worker is scanning. The storage of the
+  /// discarded entries is not reclaimed until the cache is destroyed.
+  void invalidateFiles(ArrayRef<std::string> Filenames);
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+  std::string DirectivesCachePath;
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
@@ -1000,6 +1000,9 @@ void ASTContext::PrintStats() const {
   llvm::errs() << NumImplicitDestructorsDeclared << "/"
                << NumImplicitDestructors
                << " implicit destructors created\n";
+  llvm::errs() << NumConstantEvaluations << " constant evaluations, "
+               << NumConstexprEvaluatorSteps << " evaluator steps, "
+               << NumConstexprInterpreterOps << " interpreter instructions\n";
 
   if (ExternalSource) {
     llvm::errs() << "\n";
@@ -1013,6 +1013,9 @@ namespace {
 
     ~EvalInfo() {
       discardCleanups();
+      ++Ctx.NumConstantEvaluations;
+      Ctx.NumConstexprEvaluatorSteps +=
+          Ctx.getLangOpts().ConstexprStepLimit - StepsLeft;
     }
 
     ASTContext &getCtx() const override { return Ctx; }
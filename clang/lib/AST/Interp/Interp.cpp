@@ -21,6 +21,7 @@
 #include "clang/AST/Expr.h"
 #include "clang/AST/ExprCXX.h"
 #include "llvm/ADT/APSInt.h"
+#include "llvm/ADT/ScopeExit.h"
 #include <limits>
 #include <vector>
 
@@ -704,7 +705,12 @@ bool Interpret(InterpState &S, APValue &Result) {
   if (!PC)
     return true;
 
+  uint64_t NumOps = 0;
+  auto CountOps = llvm::make_scope_exit(
+      [&] { S.getCtx().NumConstexprInterpreterOps += NumOps; });
+
   for (;;) {
+    ++NumOps;
     auto Op = PC.read<Opcode>();
     CodePtr OpPC = PC;
 
@@ -11,10 +11,15 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Basic/FileSystemStatCache.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <utility>
 
 using namespace clang;
@@ -118,3 +123,134 @@ MemorizeStatCalls::getStat(StringRef Path, llvm::vfs::Status &Status,
 
   return std::error_code();
 }
+
+// Each entry of a shared stat cache file is a line
+//
+//   <checksum> <type> <device> <inode> <mtime> <uid> <gid> <size> <perms> <path>
+//
+// with type 0 (file_type::status_error) for paths that do not exist. Every
+// line is appended with a single write, so concurrent writers do not
+// interleave within a line. The checksum guards against lines that were cut
+// short by a writer that died.
+static uint32_t checksumStatLine(StringRef Rest) {
+  return static_cast<uint32_t>(llvm::xxh3_64bits(Rest));
+}
+
+static std::optional<std::pair<StringRef, std::optional<llvm::vfs::Status>>>
+parseStatLine(StringRef Line) {
+  auto [Checksum, Rest] = Line.split(' ');
+  uint32_t Expected;
+  if (Checksum.getAsInteger(16, Expected) || checksumStatLine(Rest) != Expected)
+    return std::nullopt;
+
+  uint64_t Fields[8];
+  for (uint64_t &Field : Fields) {
+    StringRef Value;
+    std::tie(Value, Rest) = Rest.split(' ');
+    if (Value.getAsInteger(10, Field))
+      return std::nullopt;
+  }
+  if (!llvm::sys::path::is_absolute(Rest))
+    return std::nullopt;
+
+  auto Type = static_cast<llvm::sys::fs::file_type>(Fields[0]);
+  if (Type == llvm::sys::fs::file_type::status_error)
+    return std::make_pair(Rest, std::nullopt);
+  return std::make_pair(
+      Rest, llvm::vfs::Status(
+                Rest, llvm::sys::fs::UniqueID(Fields[1], Fields[2]),
+                llvm::sys::TimePoint<>(std::chrono::nanoseconds(Fields[3])),
+                Fields[4], Fields[5], Fields[6], Type,
+                static_cast<llvm::sys::fs::perms>(Fields[7])));
+}
+
+SharedStatCache::SharedStatCache(StringRef CacheDir, uint64_t BuildToken,
+                                 std::vector<std::string> Prefixes)
+    : Prefixes(std::move(Prefixes)) {
+  SmallString<256> Path(CacheDir);
+  llvm::sys::path::append(Path, llvm::Twine::utohexstr(BuildToken) + ".statcache");
+
+  if (auto Buf = llvm::MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                             /*RequiresNullTerminator=*/false,
+                                             /*IsVolatile=*/true)) {
+    SmallVector<StringRef, 0> Lines;
+    (*Buf)->getBuffer().split(Lines, '\n', -1, /*KeepEmpty=*/false);
+    for (StringRef Line : Lines)
+      if (auto Entry = parseStatLine(Line))
+        Entries.try_emplace(Entry->first, std::move(Entry->second));
+  }
+
+  if (llvm::sys::fs::create_directories(CacheDir))
+    return;
+  std::error_code EC;
+  auto OS = std::make_unique<llvm::raw_fd_ostream>(
+      Path, EC, llvm::sys::fs::CD_OpenAlways, llvm::sys::fs::FA_Write,
+      llvm::sys::fs::OF_Append);
+  if (EC)
+    return;
+  OS->SetUnbuffered();
+  CacheFile = std::move(OS);
+}
+
+bool SharedStatCache::isCacheable(StringRef Path) const {
+  if (!llvm::sys::path::is_absolute(Path))
+    return false;
+  for (StringRef Prefix : Prefixes)
+    if (Path.starts_with(Prefix) &&
+        (Path.size() == Prefix.size() ||
+         llvm::sys::path::is_separator(Path[Prefix.size()]) ||
+         llvm::sys::path::is_separator(Prefix.back())))
+      return true;
+  return false;
+}
+
+void SharedStatCache::record(StringRef Path, const llvm::vfs::Status *Status) {
+  Entries.try_emplace(Path, Status ? std::optional(*Status) : std::nullopt);
+  if (!CacheFile || Path.contains('\n'))
+    return;
+
+  SmallString<256> Rest;
+  llvm::raw_svector_ostream OS(Rest);
+  if (Status)
+    OS << static_cast<int>(Status->getType()) << ' '
+       << Status->getUniqueID().getDevice() << ' '
+       << Status->getUniqueID().getFile() << ' '
+       << Status->getLastModificationTime().time_since_epoch().count() << ' '
+       << Status->getUser() << ' ' << Status->getGroup() << ' '
+       << Status->getSize() << ' ' << static_cast<int>(Status->getPermissions());
+  else
+    OS << "0 0 0 0 0 0 0 0";
+  OS << ' ' << Path;
+
+  SmallString<256> Line;
+  llvm::raw_svector_ostream(Line)
+      << llvm::format_hex_no_prefix(checksumStatLine(Rest), 8) << ' ' << Rest
+      << '\n';
+  CacheFile->write(Line.data(), Line.size());
+}
+
+std::error_code
+SharedStatCache::getStat(StringRef Path, llvm::vfs::Status &Status,
+                         bool isFile, std::unique_ptr<llvm::vfs::File> *F,
+                         llvm::vfs::FileSystem &FS) {
+  if (!isCacheable(Path))
+    return get(Path, Status, isFile, F, nullptr, FS);
+
+  auto It = Entries.find(Path);
+  if (It != Entries.end()) {
+    if (!It->second)
+      return std::make_error_code(std::errc::no_such_file_or_directory);
+    Status = llvm::vfs::Status::copyWithNewName(*It->second, Path);
+    return std::error_code();
+  }
+
+  // A directoryness mismatch is reported as an error, but Status is still
+  // filled in, and the result is worth caching for the opposite query.
+  std::error_code EC = get(Path, Status, isFile, F, nullptr, FS);
+  if (EC == std::errc::no_such_file_or_directory)
+    record(Path, nullptr);
+  else if (!EC || EC == std::errc::is_a_directory ||
+           EC == std::errc::not_a_directory)
+    record(Path, &Status);
+  return EC;
+}
@@ -3126,6 +3126,18 @@ void CodeGenModule::EmitDeferred() {
   CurDeclsToEmit.swap(DeferredDeclsToEmit);
 
   for (GlobalDecl &D : CurDeclsToEmit) {
+    // Decls can be queued more than once. If this one already has a
+    // definition under its own name, skip it before GetAddrOfGlobal, which
+    // would recompute its LLVM type only for us to discard it below.
+    StringRef MangledName = getMangledName(D);
+    if (llvm::GlobalValue *Existing = GetGlobalValue(MangledName);
+        Existing && !Existing->isDeclaration()) {
+      GlobalDecl OtherGD;
+      if (lookupRepresentativeDecl(MangledName, OtherGD) &&
+          OtherGD.getCanonicalDecl() == D.getCanonicalDecl())
+        continue;
+    }
+
     // We should call GetAddrOfGlobal with IsForDefinition set to true in order
     // to get GlobalValue with exactly the type we need, not something that
     // might had been created for another decl with the same mangled name but
@@ -3137,7 +3149,7 @@ void CodeGenModule::EmitDeferred() {
     // IsForDefinition equal to true. Query mangled names table to get
     // GlobalValue.
     if (!GV)
-      GV = GetGlobalValue(getMangledName(D));
+      GV = GetGlobalValue(MangledName);
 
     // Make sure GetGlobalValue returned non-null.
     assert(GV);
@@ -3966,7 +3966,12 @@ static bool RenderModulesOptions(Compilation &C, const Driver &D,
   Args.AddLastArg(CmdArgs, options::OPT_fmodules_prune_interval);
   Args.AddLastArg(CmdArgs, options::OPT_fmodules_prune_after);
 
-  if (HaveClangModules) {
+  // The build session also identifies the entries of the shared stat cache.
+  bool HaveSharedStatCache =
+      Args.hasArg(options::OPT_fshared_stat_cache_path_EQ);
+  Args.AddLastArg(CmdArgs, options::OPT_fshared_stat_cache_path_EQ);
+
+  if (HaveClangModules || HaveSharedStatCache) {
     Args.AddLastArg(CmdArgs, options::OPT_fbuild_session_timestamp);
 
     if (Arg *A = Args.getLastArg(options::OPT_fbuild_session_file)) {
@@ -3983,7 +3988,12 @@ static bool RenderModulesOptions(Compilation &C, const Driver &D,
                     Status.getLastModificationTime().time_since_epoch())
                     .count())));
     }
+  } else {
+    Args.ClaimAllArgs(options::OPT_fbuild_session_timestamp);
+    Args.ClaimAllArgs(options::OPT_fbuild_session_file);
+  }
 
+  if (HaveClangModules) {
     if (Args.getLastArg(
             options::OPT_fmodules_validate_once_per_build_session)) {
       if (!Args.getLastArg(options::OPT_fbuild_session_timestamp,
@@ -4002,8 +4012,6 @@ static bool RenderModulesOptions(Compilation &C, const Driver &D,
     Args.AddLastArg(CmdArgs,
                     options::OPT_fmodules_disable_diagnostic_validation);
   } else {
-    Args.ClaimAllArgs(options::OPT_fbuild_session_timestamp);
-    Args.ClaimAllArgs(options::OPT_fbuild_session_file);
     Args.ClaimAllArgs(options::OPT_fmodules_validate_once_per_build_session);
     Args.ClaimAllArgs(options::OPT_fmodules_validate_system_headers);
     Args.ClaimAllArgs(options::OPT_fno_modules_validate_system_headers);
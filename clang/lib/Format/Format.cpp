@@ -2409,8 +2409,17 @@ public:
           SmallVectorImpl<AnnotatedLine *> &AnnotatedLines,
           FormatTokenLexer &Tokens) override {
     tooling::Replacements Result;
+    // Unaffected lines only ever produce untouchable whitespace changes, so if
+    // nothing in this run (e.g. one side of an #if) is affected, formatting it
+    // cannot produce replacements. Editors formatting a few lines of a large
+    // file hit this for every preprocessor branch away from the edit.
+    if (!AffectedRangeMgr.computeAffectedLines(AnnotatedLines) &&
+        llvm::none_of(AnnotatedLines, [](const AnnotatedLine *Line) {
+          return Line->LeadingEmptyLinesAffected;
+        })) {
+      return {Result, 0};
+    }
     deriveLocalStyle(AnnotatedLines);
-    AffectedRangeMgr.computeAffectedLines(AnnotatedLines);
     for (AnnotatedLine *Line : AnnotatedLines)
       Annotator.calculateFormattingInformation(*Line);
     Annotator.setCommentLineLevels(AnnotatedLines);
@@ -3747,7 +3756,9 @@ reformat(const FormatStyle &Style, StringRef Code,
     if (NewCode) {
       Fixes = Fixes.merge(PassFixes.first);
       Penalty += PassFixes.second;
-      if (I + 1 < E) {
+      // A pass without fixes leaves the code as it was, so the next one can
+      // reuse the environment instead of setting up a new source manager.
+      if (I + 1 < E && !PassFixes.first.empty()) {
         CurrentCode = std::move(*NewCode);
         Env = Environment::make(
             *CurrentCode, FileName,
@@ -14,6 +14,7 @@
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/DiagnosticOptions.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/FileSystemStatCache.h"
 #include "clang/Basic/LangStandard.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/Stack.h"
@@ -374,6 +375,34 @@ CompilerInstance::createDiagnostics(DiagnosticOptions *Opts,
 
 // File Manager
 
+static std::unique_ptr<FileSystemStatCache>
+createSharedStatCache(const HeaderSearchOptions &HSOpts) {
+  // Without a build session the cache could never be invalidated, and paths
+  // seen through an overlay need not match the real file system.
+  if (HSOpts.SharedStatCachePath.empty() || !HSOpts.BuildSessionTimestamp ||
+      !HSOpts.VFSOverlayFiles.empty())
+    return nullptr;
+
+  // Only directories that do not change during a build are cached, so that
+  // generated headers are never reported as missing.
+  std::vector<std::string> Prefixes;
+  auto AddPrefix = [&](StringRef Path) {
+    if (llvm::sys::path::is_absolute(Path) && Path != "/")
+      Prefixes.push_back(Path.rtrim("/").str());
+  };
+  AddPrefix(HSOpts.ResourceDir);
+  AddPrefix(HSOpts.Sysroot);
+  for (const HeaderSearchOptions::Entry &E : HSOpts.UserEntries)
+    if (E.Group >= frontend::System)
+      AddPrefix(E.Path);
+  if (Prefixes.empty())
+    return nullptr;
+
+  return std::make_unique<SharedStatCache>(HSOpts.SharedStatCachePath,
+                                           HSOpts.BuildSessionTimestamp,
+                                           std::move(Prefixes));
+}
+
 FileManager *CompilerInstance::createFileManager(
     IntrusiveRefCntPtr<llvm::vfs::FileSystem> VFS) {
   if (!VFS)
@@ -382,6 +411,9 @@ FileManager *CompilerInstance::createFileManager(
                                                     getDiagnostics());
   assert(VFS && "FileManager has no VFS?");
   FileMgr = new FileManager(getFileSystemOpts(), std::move(VFS));
+  if (std::unique_ptr<FileSystemStatCache> Cache =
+          createSharedStatCache(getHeaderSearchOpts()))
+    FileMgr->setStatCache(std::move(Cache));
   return FileMgr.get();
 }
 
@@ -536,6 +568,9 @@ void CompilerInstance::createPreprocessor(TranslationUnitKind TUKind) {
                            /*ShowAllHeaders=*/true, /*OutputPath=*/"",
                            /*ShowDepth=*/true, /*MSStyle=*/true);
   }
+
+  if (!DepOpts.IncludeCostReportFile.empty())
+    AttachIncludeCostProfiler(*PP, DepOpts.IncludeCostReportFile);
 }
 
 std::string CompilerInstance::getSpecificModuleCachePath(StringRef ModuleHash) {
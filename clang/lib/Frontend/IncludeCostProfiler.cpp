@@ -0,0 +1,164 @@
+//===--- IncludeCostProfiler.cpp - Report the cost of included files ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements -include-cost-report, which records for every header
+// the wall time and number of tokens spent between entering and leaving it,
+// both including and excluding the headers it includes, and how often an
+// #include of it was skipped because of an include guard or #pragma once.
+// Since the parser pulls tokens from the preprocessor, the time includes
+// parsing and semantic analysis of the header's contents.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/SourceManager.h"
+#include "clang/Frontend/FrontendDiagnostic.h"
+#include "clang/Frontend/Utils.h"
+#include "clang/Lex/Preprocessor.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
+
+using namespace clang;
+
+namespace {
+class IncludeCostProfiler : public PPCallbacks {
+  using Clock = std::chrono::steady_clock;
+
+  struct FileCost {
+    StringRef Name;
+    Clock::duration Inclusive{};
+    Clock::duration Self{};
+    uint64_t InclusiveTokens = 0;
+    uint64_t SelfTokens = 0;
+    unsigned Entered = 0;
+    unsigned Skipped = 0;
+    // Number of frames for this file on the include stack. Only the outermost
+    // one contributes to the inclusive cost of a recursively included file.
+    unsigned Active = 0;
+  };
+
+  struct Frame {
+    FileCost *Cost;
+    Clock::time_point Start;
+    unsigned StartTokens;
+    Clock::duration ChildTime{};
+    uint64_t ChildTokens = 0;
+  };
+
+  const Preprocessor &PP;
+  SourceManager &SM;
+  std::string OutputPath;
+  llvm::DenseMap<const FileEntry *, FileCost> Costs;
+  SmallVector<Frame, 16> Stack;
+
+public:
+  IncludeCostProfiler(const Preprocessor &PP, StringRef OutputPath)
+      : PP(PP), SM(PP.getSourceManager()), OutputPath(OutputPath) {}
+
+  void FileChanged(SourceLocation Loc, FileChangeReason Reason,
+                   SrcMgr::CharacteristicKind FileType,
+                   FileID PrevFID) override;
+
+  void FileSkipped(const FileEntryRef &SkippedFile, const Token &FilenameTok,
+                   SrcMgr::CharacteristicKind FileType) override;
+
+  void EndOfMainFile() override;
+};
+} // namespace
+
+void IncludeCostProfiler::FileChanged(SourceLocation Loc,
+                                      FileChangeReason Reason,
+                                      SrcMgr::CharacteristicKind FileType,
+                                      FileID PrevFID) {
+  if (Reason == EnterFile) {
+    FileCost *Cost = nullptr;
+    // The main file has no include location and is reported as a whole at the
+    // end, so it does not get an entry.
+    FileID FID = SM.getFileID(Loc);
+    if (SM.getIncludeLoc(FID).isValid())
+      if (OptionalFileEntryRef FE = SM.getFileEntryRefForID(FID)) {
+        Cost = &Costs[&FE->getFileEntry()];
+        Cost->Name = FE->getName();
+        ++Cost->Entered;
+        ++Cost->Active;
+      }
+    Stack.push_back({Cost, Clock::now(), PP.getTokenCount()});
+    return;
+  }
+
+  // Only the main file is left on the stack once it is exited.
+  if (Reason != ExitFile || Stack.size() < 2)
+    return;
+
+  Frame F = Stack.pop_back_val();
+  Clock::duration Time = Clock::now() - F.Start;
+  uint64_t Tokens = PP.getTokenCount() - F.StartTokens;
+  if (FileCost *Cost = F.Cost) {
+    if (--Cost->Active == 0) {
+      Cost->Inclusive += Time;
+      Cost->InclusiveTokens += Tokens;
+    }
+    Cost->Self += Time - F.ChildTime;
+    Cost->SelfTokens += Tokens - F.ChildTokens;
+  }
+  Stack.back().ChildTime += Time;
+  Stack.back().ChildTokens += Tokens;
+}
+
+void IncludeCostProfiler::FileSkipped(const FileEntryRef &SkippedFile,
+                                      const Token &FilenameTok,
+                                      SrcMgr::CharacteristicKind FileType) {
+  FileCost &Cost = Costs[&SkippedFile.getFileEntry()];
+  if (Cost.Name.empty())
+    Cost.Name = SkippedFile.getName();
+  ++Cost.Skipped;
+}
+
+void IncludeCostProfiler::EndOfMainFile() {
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(OutputPath, EC, llvm::sys::fs::OF_TextWithCRLF);
+  if (EC) {
+    PP.getDiagnostics().Report(diag::err_fe_unable_to_open_output)
+        << OutputPath << EC.message();
+    return;
+  }
+
+  std::vector<const FileCost *> Sorted;
+  Sorted.reserve(Costs.size());
+  for (const auto &Entry : Costs)
+    Sorted.push_back(&Entry.second);
+  llvm::sort(Sorted, [](const FileCost *A, const FileCost *B) {
+    if (A->Inclusive != B->Inclusive)
+      return A->Inclusive > B->Inclusive;
+    return A->Name < B->Name;
+  });
+
+  auto ToMs = [](Clock::duration D) {
+    return std::chrono::duration<double, std::milli>(D).count();
+  };
+  Clock::duration Total{};
+  if (!Stack.empty())
+    Total = Clock::now() - Stack.front().Start;
+  OS << "Include cost report: " << Costs.size() << " headers, "
+     << llvm::format("%.3f", ToMs(Total)) << " ms, " << PP.getTokenCount()
+     << " tokens\n";
+  OS << llvm::format("%12s %12s %10s %10s %7s %7s  %s\n", "incl-ms", "self-ms",
+                     "incl-tok", "self-tok", "entered", "skipped", "file");
+  for (const FileCost *C : Sorted)
+    OS << llvm::format("%12.3f %12.3f %10llu %10llu %7u %7u  ",
+                       ToMs(C->Inclusive), ToMs(C->Self),
+                       (unsigned long long)C->InclusiveTokens,
+                       (unsigned long long)C->SelfTokens, C->Entered,
+                       C->Skipped)
+       << C->Name << '\n';
+}
+
+void clang::AttachIncludeCostProfiler(Preprocessor &PP, StringRef OutputPath) {
+  PP.addPPCallbacks(std::make_unique<IncludeCostProfiler>(PP, OutputPath));
+}
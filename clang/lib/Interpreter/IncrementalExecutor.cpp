@@ -16,6 +16,7 @@
 #include "clang/Basic/TargetOptions.h"
 #include "clang/Interpreter/PartialTranslationUnit.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h"
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 #include "llvm/ExecutionEngine/Orc/Debugging/DebuggerSupport.h"
 #include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
@@ -53,17 +54,39 @@ IncrementalExecutor::createDefaultJITBuilder(
 
 IncrementalExecutor::IncrementalExecutor(llvm::orc::ThreadSafeContext &TSC,
                                          llvm::orc::LLJITBuilder &JITBuilder,
-                                         llvm::Error &Err)
+                                         bool LazyCompilation, llvm::Error &Err)
     : TSCtx(TSC) {
   using namespace llvm::orc;
   llvm::ErrorAsOutParameter EAO(&Err);
 
-  if (auto JitOrErr = JITBuilder.create())
-    Jit = std::move(*JitOrErr);
-  else {
-    Err = JitOrErr.takeError();
+  if (!LazyCompilation) {
+    if (auto JitOrErr = JITBuilder.create())
+      Jit = std::move(*JitOrErr);
+    else
+      Err = JitOrErr.takeError();
     return;
   }
+
+  // The lazy call-through and stub managers below patch code in this process.
+  if (JITBuilder.EPC || JITBuilder.ES) {
+    Err = llvm::make_error<llvm::StringError>(
+        "Lazy compilation requires in-process execution",
+        llvm::inconvertibleErrorCode());
+    return;
+  }
+
+  // Keep whatever the JIT builder was configured with, and put a
+  // CompileOnDemandLayer on top of it.
+  LLLazyJITBuilder LazyJITBuilder;
+  static_cast<LLJITBuilderState &>(LazyJITBuilder) =
+      std::move(static_cast<LLJITBuilderState &>(JITBuilder));
+  auto LazyJitOrErr = LazyJITBuilder.create();
+  if (!LazyJitOrErr) {
+    Err = LazyJitOrErr.takeError();
+    return;
+  }
+  CODLayer = &(*LazyJitOrErr)->getCompileOnDemandLayer();
+  Jit = std::move(*LazyJitOrErr);
 }
 
 IncrementalExecutor::~IncrementalExecutor() {}
@@ -73,6 +96,8 @@ llvm::Error IncrementalExecutor::addModule(PartialTranslationUnit &PTU) {
       Jit->getMainJITDylib().createResourceTracker();
   ResourceTrackers[&PTU] = RT;
 
+  if (CODLayer)
+    return CODLayer->add(RT, {std::move(PTU.TheModule), TSCtx});
   return Jit->addIRModule(RT, {std::move(PTU.TheModule), TSCtx});
 }
 
@@ -23,6 +23,7 @@
 namespace llvm {
 class Error;
 namespace orc {
+class CompileOnDemandLayer;
 class JITTargetMachineBuilder;
 class LLJIT;
 class LLJITBuilder;
@@ -39,6 +40,8 @@ class IncrementalExecutor {
   using CtorDtorIterator = llvm::orc::CtorDtorIterator;
   std::unique_ptr<llvm::orc::LLJIT> Jit;
   llvm::orc::ThreadSafeContext &TSCtx;
+  // Set when functions are compiled on their first call.
+  llvm::orc::CompileOnDemandLayer *CODLayer = nullptr;
 
   llvm::DenseMap<const PartialTranslationUnit *, llvm::orc::ResourceTrackerSP>
       ResourceTrackers;
@@ -47,7 +50,8 @@ public:
   enum SymbolNameKind { IRName, LinkerName };
 
   IncrementalExecutor(llvm::orc::ThreadSafeContext &TSC,
-                      llvm::orc::LLJITBuilder &JITBuilder, llvm::Error &Err);
+                      llvm::orc::LLJITBuilder &JITBuilder, bool LazyCompilation,
+                      llvm::Error &Err);
   ~IncrementalExecutor();
 
   llvm::Error addModule(PartialTranslationUnit &PTU);
@@ -31,13 +31,31 @@
 
 namespace clang {
 
+/// Adds the wall-clock time spent in its scope to \p Seconds.
+class ScopedWallTime {
+  double &Seconds;
+  llvm::TimeRecord Start;
+
+public:
+  ScopedWallTime(double &Seconds)
+      : Seconds(Seconds), Start(llvm::TimeRecord::getCurrentTime(true)) {}
+  ~ScopedWallTime() {
+    llvm::TimeRecord End = llvm::TimeRecord::getCurrentTime(false);
+    End -= Start;
+    Seconds += End.getWallTime();
+  }
+};
+
 class IncrementalASTConsumer final : public ASTConsumer {
   Interpreter &Interp;
   std::unique_ptr<ASTConsumer> Consumer;
+  // Time spent in the wrapped consumer, which is CodeGen.
+  double &ConsumerTime;
 
 public:
-  IncrementalASTConsumer(Interpreter &InterpRef, std::unique_ptr<ASTConsumer> C)
-      : Interp(InterpRef), Consumer(std::move(C)) {}
+  IncrementalASTConsumer(Interpreter &InterpRef, std::unique_ptr<ASTConsumer> C,
+                         double &ConsumerTime)
+      : Interp(InterpRef), Consumer(std::move(C)), ConsumerTime(ConsumerTime) {}
 
   bool HandleTopLevelDecl(DeclGroupRef DGR) override final {
     if (DGR.isNull())
@@ -50,12 +68,15 @@ public:
           TSD && TSD->isSemiMissing())
         TSD->setStmt(Interp.SynthesizeExpr(cast<Expr>(TSD->getStmt())));
 
+    ScopedWallTime T(ConsumerTime);
     return Consumer->HandleTopLevelDecl(DGR);
   }
   void HandleTranslationUnit(ASTContext &Ctx) override final {
+    ScopedWallTime T(ConsumerTime);
     Consumer->HandleTranslationUnit(Ctx);
   }
   void HandleInlineFunctionDefinition(FunctionDecl *D) override final {
+    ScopedWallTime T(ConsumerTime);
     Consumer->HandleInlineFunctionDefinition(D);
   }
   void HandleInterestingDecl(DeclGroupRef D) override final {
@@ -68,6 +89,7 @@ public:
     Consumer->HandleTagDeclRequiredDefinition(D);
   }
   void HandleCXXImplicitFunctionInstantiation(FunctionDecl *D) override final {
+    ScopedWallTime T(ConsumerTime);
     Consumer->HandleCXXImplicitFunctionInstantiation(D);
   }
   void HandleTopLevelDeclInObjCContainer(DeclGroupRef D) override final {
@@ -214,7 +236,8 @@ IncrementalParser::IncrementalParser(Interpreter &Interp,
     CachedInCodeGenModule = GenModule();
 
   std::unique_ptr<ASTConsumer> IncrConsumer =
-      std::make_unique<IncrementalASTConsumer>(Interp, CI->takeASTConsumer());
+      std::make_unique<IncrementalASTConsumer>(Interp, CI->takeASTConsumer(),
+                                               CodeGenTime);
   CI->setASTConsumer(std::move(IncrConsumer));
   Consumer = &CI->getASTConsumer();
   P.reset(
@@ -307,6 +330,8 @@ IncrementalParser::Parse(llvm::StringRef input) {
   Preprocessor &PP = CI->getPreprocessor();
   assert(PP.isIncrementalProcessingEnabled() && "Not in incremental mode!?");
 
+  CodeGenTime = 0;
+
   std::ostringstream SourceName;
   SourceName << "input_line_" << InputCount++;
 
@@ -356,6 +381,7 @@ IncrementalParser::Parse(llvm::StringRef input) {
            "Lexer must be EOF when starting incremental parse!");
   }
 
+  ScopedWallTime T(CodeGenTime);
   if (std::unique_ptr<llvm::Module> M = GenModule())
     PTU->TheModule = std::move(M);
 
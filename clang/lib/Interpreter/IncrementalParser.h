@@ -62,6 +62,9 @@ protected:
   /// and we must keep it alive.
   std::unique_ptr<llvm::Module> CachedInCodeGenModule;
 
+  /// Wall-clock seconds spent in CodeGen while processing the last input.
+  double CodeGenTime = 0;
+
   IncrementalParser();
 
 public:
@@ -86,6 +89,9 @@ public:
 
   std::list<PartialTranslationUnit> &getPTUs() { return PTUs; }
 
+  /// \returns the wall-clock seconds the last input spent in CodeGen.
+  double getCodeGenTime() const { return CodeGenTime; }
+
   std::unique_ptr<llvm::Module> GenModule();
 
 private:
@@ -35,11 +35,13 @@
 #include "clang/Interpreter/Value.h"
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Sema/Lookup.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ExecutionEngine/JITSymbol.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Host.h"
 using namespace clang;
@@ -357,6 +359,14 @@ size_t Interpreter::getEffectivePTUSize() const {
 
 llvm::Expected<PartialTranslationUnit &>
 Interpreter::Parse(llvm::StringRef Code) {
+  llvm::TimeRecord Start = llvm::TimeRecord::getCurrentTime(true);
+  auto RecordTiming = llvm::make_scope_exit([&] {
+    llvm::TimeRecord Elapsed = llvm::TimeRecord::getCurrentTime(false);
+    Elapsed -= Start;
+    double CodeGen = IncrParser->getCodeGenTime();
+    LastInputTiming = {Elapsed.getWallTime() - CodeGen, CodeGen, 0};
+  });
+
   // If we have a device parser, parse it first.
   // The generated code will be included in the host compilation
   if (DeviceParser) {
@@ -400,7 +410,8 @@ llvm::Error Interpreter::CreateExecutor() {
   if (!JB)
     return JB.takeError();
   llvm::Error Err = llvm::Error::success();
-  auto Executor = std::make_unique<IncrementalExecutor>(*TSCtx, **JB, Err);
+  auto Executor =
+      std::make_unique<IncrementalExecutor>(*TSCtx, **JB, LazyCompilation, Err);
   if (!Err)
     IncrExecutor = std::move(Executor);
 
@@ -411,6 +422,12 @@ void Interpreter::ResetExecutor() { IncrExecutor.reset(); }
 
 llvm::Error Interpreter::Execute(PartialTranslationUnit &T) {
   assert(T.TheModule);
+  llvm::TimeRecord Start = llvm::TimeRecord::getCurrentTime(true);
+  auto RecordTiming = llvm::make_scope_exit([&] {
+    llvm::TimeRecord Elapsed = llvm::TimeRecord::getCurrentTime(false);
+    Elapsed -= Start;
+    LastInputTiming.Execute = Elapsed.getWallTime();
+  });
   if (!IncrExecutor) {
     auto Err = CreateExecutor();
     if (Err)
@@ -433,6 +433,31 @@ StringRef DirectoryLookup::getName() const {
   return getHeaderMap()->getFileName();
 }
 
+bool HeaderSearch::mayContainFile(DirectoryEntryRef Dir, StringRef Filename) {
+  if (!HSOpts->IndexSearchPaths)
+    return true;
+
+  // Only the first component has to be an entry of the directory. Names
+  // are compared case-insensitively so that a hit on a case-insensitive file
+  // system is never missed; false positives just fall back to a stat.
+  StringRef First = *llvm::sys::path::begin(Filename);
+  if (First == "." || First == "..")
+    return true;
+
+  auto [It, Inserted] = SearchDirContents.try_emplace(&Dir.getDirEntry());
+  if (Inserted) {
+    std::error_code EC;
+    llvm::vfs::FileSystem &FS = FileMgr.getVirtualFileSystem();
+    llvm::StringSet<> Names;
+    for (llvm::vfs::directory_iterator I = FS.dir_begin(Dir.getName(), EC), E;
+         !EC && I != E; I.increment(EC))
+      Names.insert(llvm::sys::path::filename(I->path()).lower());
+    if (!EC)
+      It->second = std::move(Names);
+  }
+  return !It->second || It->second->contains(First.lower());
+}
+
 OptionalFileEntryRef HeaderSearch::getFileAndSuggestModule(
     StringRef FileName, SourceLocation IncludeLoc, const DirectoryEntry *Dir,
     bool IsSystemHeaderDir, Module *RequestingModule,
@@ -478,6 +503,9 @@ OptionalFileEntryRef DirectoryLookup::LookupFile(
 
   SmallString<1024> TmpDir;
   if (isNormalDir()) {
+    if (!HS.mayContainFile(*getDirRef(), Filename))
+      return std::nullopt;
+
     // Concatenate the requested file onto the directory.
     TmpDir = getDirRef()->getName();
     llvm::sys::path::append(TmpDir, Filename);
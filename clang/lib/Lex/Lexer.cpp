@@ -51,6 +51,15 @@
 #include <nmmintrin.h>
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -2249,6 +2258,49 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
 
 /// LexRawStringLiteral - Lex the remainder of a raw string literal, after
 /// having lexed R", LR", u8R", uR", or UR".
+/// Skip over the 16-byte blocks starting at \p CurPtr that contain none of
+/// \p C1, \p C2 and \p C3, and no non-ASCII characters if \p StopAtNonASCII
+/// is set. This never reads past \p BufferEnd. The result points into the
+/// first block that may contain an interesting character, which the caller
+/// then scans byte by byte.
+static const char *skipUninterestingBlocks(const char *CurPtr,
+                                           const char *BufferEnd, char C1,
+                                           char C2, char C3,
+                                           bool StopAtNonASCII) {
+#ifdef __SSE2__
+  __m128i V1 = _mm_set1_epi8(C1);
+  __m128i V2 = _mm_set1_epi8(C2);
+  __m128i V3 = _mm_set1_epi8(C3);
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i V = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Hits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(V, V1), _mm_cmpeq_epi8(V, V2)),
+        _mm_cmpeq_epi8(V, V3));
+    int Mask = _mm_movemask_epi8(Hits);
+    if (StopAtNonASCII)
+      Mask |= _mm_movemask_epi8(V);
+    if (Mask != 0)
+      return CurPtr + llvm::countr_zero<unsigned>(Mask);
+    CurPtr += 16;
+  }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  uint8x16_t V1 = vdupq_n_u8(C1);
+  uint8x16_t V2 = vdupq_n_u8(C2);
+  uint8x16_t V3 = vdupq_n_u8(C3);
+  while (CurPtr + 16 <= BufferEnd) {
+    uint8x16_t V = vld1q_u8((const uint8_t *)CurPtr);
+    uint8x16_t Hits =
+        vorrq_u8(vorrq_u8(vceqq_u8(V, V1), vceqq_u8(V, V2)), vceqq_u8(V, V3));
+    if (StopAtNonASCII)
+      Hits = vorrq_u8(Hits, vcgeq_u8(V, vdupq_n_u8(0x80)));
+    if (vmaxvq_u8(Hits) != 0)
+      return CurPtr;
+    CurPtr += 16;
+  }
+#endif
+  return CurPtr;
+}
+
 bool Lexer::LexRawStringLiteral(Token &Result, const char *CurPtr,
                                 tok::TokenKind Kind) {
   // This function doesn't use getAndAdvanceChar because C++0x [lex.pptoken]p3:
@@ -2301,6 +2353,8 @@ bool Lexer::LexRawStringLiteral(Token &Result, const char *CurPtr,
   CurPtr += PrefixLen + 1; // skip over prefix and '('
 
   while (true) {
+    CurPtr = skipUninterestingBlocks(CurPtr, BufferEnd, ')', 0, 0,
+                                     /*StopAtNonASCII=*/false);
     char C = *CurPtr++;
 
     if (C == ')') {
@@ -2579,6 +2633,14 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
 
   char C;
   while (true) {
+    // Skip whole blocks of ordinary characters first.
+    if (const char *BlockEnd = skipUninterestingBlocks(
+            CurPtr, BufferEnd, '\n', '\r', 0, /*StopAtNonASCII=*/true);
+        BlockEnd != CurPtr) {
+      CurPtr = BlockEnd;
+      UnicodeDecodingAlreadyDiagnosed = false;
+    }
+
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (isASCII(C) && C != 0 &&   // Potentially EOF.
@@ -2817,13 +2879,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr, Lexer *L,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
@@ -574,6 +574,16 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumClassInstantiations << " class instantiations, "
+               << NumImportedClassSpecializationsReused
+               << " imported class template specializations reused.\n";
+  llvm::errs() << NumFunctionInstantiations << " function instantiations, "
+               << NumImportedFunctionDefinitionsReused
+               << " imported function definitions reused.\n";
+  llvm::errs() << NumOverloadCandidates << " overload candidates, "
+               << NumOverloadCandidatesPrunedByArity << " rejected by arity, "
+               << NumOverloadCandidatesPrunedByConversion
+               << " rejected by a quick conversion check.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
@@ -6961,6 +6961,19 @@ static bool isNonViableMultiVersionOverload(FunctionDecl *FD) {
 /// \param PartialOverloading true if we are performing "partial" overloading
 /// based on an incomplete set of function arguments. This feature is used by
 /// code completion.
+/// Quickly determine whether an argument of class type certainly cannot be
+/// converted to a parameter of scalar type, because the class has no
+/// conversion functions. This is much cheaper than TryCopyInitialization and
+/// rejects most candidates of large overload sets such as operator<<.
+static bool isTriviallyBadConversion(Expr *Arg, QualType ParamType) {
+  if (!ParamType->isScalarType())
+    return false;
+  const CXXRecordDecl *RD = Arg->getType()->getAsCXXRecordDecl();
+  if (!RD || !(RD = RD->getDefinition()) || RD->isBeingDefined())
+    return false;
+  return RD->getVisibleConversionFunctions().empty();
+}
+
 void Sema::AddOverloadCandidate(
     FunctionDecl *Function, DeclAccessPair FoundDecl, ArrayRef<Expr *> Args,
     OverloadCandidateSet &CandidateSet, bool SuppressUserConversions,
@@ -7019,6 +7032,7 @@ void Sema::AddOverloadCandidate(
     return;
 
   // Add this candidate
+  ++NumOverloadCandidates;
   OverloadCandidate &Candidate =
       CandidateSet.addCandidate(Args.size(), EarlyConversions);
   Candidate.FoundDecl = FoundDecl;
@@ -7120,6 +7134,7 @@ void Sema::AddOverloadCandidate(
       shouldEnforceArgLimit(PartialOverloading, Function)) {
     Candidate.Viable = false;
     Candidate.FailureKind = ovl_fail_too_many_arguments;
+    ++NumOverloadCandidatesPrunedByArity;
     return;
   }
 
@@ -7134,6 +7149,7 @@ void Sema::AddOverloadCandidate(
     // Not enough arguments.
     Candidate.Viable = false;
     Candidate.FailureKind = ovl_fail_too_few_arguments;
+    ++NumOverloadCandidatesPrunedByArity;
     return;
   }
 
@@ -7177,11 +7193,17 @@ void Sema::AddOverloadCandidate(
       // (13.3.3.1) that converts that argument to the corresponding
       // parameter of F.
       QualType ParamType = Proto->getParamType(ArgIdx);
-      Candidate.Conversions[ConvIdx] = TryCopyInitialization(
-          *this, Args[ArgIdx], ParamType, SuppressUserConversions,
-          /*InOverloadResolution=*/true,
-          /*AllowObjCWritebackConversion=*/
-          getLangOpts().ObjCAutoRefCount, AllowExplicitConversions);
+      if (isTriviallyBadConversion(Args[ArgIdx], ParamType)) {
+        ++NumOverloadCandidatesPrunedByConversion;
+        Candidate.Conversions[ConvIdx].setBad(
+            BadConversionSequence::no_conversion, Args[ArgIdx], ParamType);
+      } else {
+        Candidate.Conversions[ConvIdx] = TryCopyInitialization(
+            *this, Args[ArgIdx], ParamType, SuppressUserConversions,
+            /*InOverloadResolution=*/true,
+            /*AllowObjCWritebackConversion=*/
+            getLangOpts().ObjCAutoRefCount, AllowExplicitConversions);
+      }
       if (Candidate.Conversions[ConvIdx].isBad()) {
         Candidate.Viable = false;
         Candidate.FailureKind = ovl_fail_bad_conversion;
@@ -7595,6 +7617,7 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
       *this, Sema::ExpressionEvaluationContext::Unevaluated);
 
   // Add this candidate
+  ++NumOverloadCandidates;
   OverloadCandidate &Candidate =
       CandidateSet.addCandidate(Args.size() + 1, EarlyConversions);
   Candidate.FoundDecl = FoundDecl;
@@ -7616,6 +7639,7 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
       shouldEnforceArgLimit(PartialOverloading, Method)) {
     Candidate.Viable = false;
     Candidate.FailureKind = ovl_fail_too_many_arguments;
+    ++NumOverloadCandidatesPrunedByArity;
     return;
   }
 
@@ -7629,6 +7653,7 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
     // Not enough arguments.
     Candidate.Viable = false;
     Candidate.FailureKind = ovl_fail_too_few_arguments;
+    ++NumOverloadCandidatesPrunedByArity;
     return;
   }
 
@@ -7695,12 +7720,18 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
       // (13.3.3.1) that converts that argument to the corresponding
       // parameter of F.
       QualType ParamType = Proto->getParamType(ArgIdx + ExplicitOffset);
-      Candidate.Conversions[ConvIdx]
-        = TryCopyInitialization(*this, Args[ArgIdx], ParamType,
-                                SuppressUserConversions,
-                                /*InOverloadResolution=*/true,
-                                /*AllowObjCWritebackConversion=*/
-                                  getLangOpts().ObjCAutoRefCount);
+      if (isTriviallyBadConversion(Args[ArgIdx], ParamType)) {
+        ++NumOverloadCandidatesPrunedByConversion;
+        Candidate.Conversions[ConvIdx].setBad(
+            BadConversionSequence::no_conversion, Args[ArgIdx], ParamType);
+      } else {
+        Candidate.Conversions[ConvIdx]
+          = TryCopyInitialization(*this, Args[ArgIdx], ParamType,
+                                  SuppressUserConversions,
+                                  /*InOverloadResolution=*/true,
+                                  /*AllowObjCWritebackConversion=*/
+                                    getLangOpts().ObjCAutoRefCount);
+      }
       if (Candidate.Conversions[ConvIdx].isBad()) {
         Candidate.Viable = false;
         Candidate.FailureKind = ovl_fail_bad_conversion;
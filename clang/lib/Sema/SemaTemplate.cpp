@@ -4612,6 +4612,8 @@ QualType Sema::CheckTemplateIdType(TemplateName Name,
       ClassTemplate->AddSpecialization(Decl, InsertPos);
       if (ClassTemplate->isOutOfLine())
         Decl->setLexicalDeclContext(ClassTemplate->getLexicalDeclContext());
+    } else if (Decl->isFromASTFile() && Decl->hasDefinition()) {
+      ++NumImportedClassSpecializationsReused;
     }
 
     if (Decl->getSpecializationKind() == TSK_Undeclared &&
@@ -1540,7 +1540,7 @@ bool ASTReader::ReadSLocEntry(int ID) {
   // Local helper to read the (possibly-compressed) buffer data following the
   // entry record.
   auto ReadBuffer = [this](
-      BitstreamCursor &SLocEntryCursor,
+      ModuleFile &F, BitstreamCursor &SLocEntryCursor,
       StringRef Name) -> std::unique_ptr<llvm::MemoryBuffer> {
     RecordData Record;
     StringRef Blob;
@@ -1562,24 +1562,38 @@ bool ASTReader::ReadSLocEntry(int ID) {
     if (RecCode == SM_SLOC_BUFFER_BLOB_COMPRESSED) {
       // Inspect the first byte to differentiate zlib (\x78) and zstd
       // (little-endian 0xFD2FB528).
-      const llvm::compression::Format F =
+      const llvm::compression::Format Format =
           Blob.size() > 0 && Blob.data()[0] == 0x78
               ? llvm::compression::Format::Zlib
               : llvm::compression::Format::Zstd;
-      if (const char *Reason = llvm::compression::getReasonIfUnsupported(F)) {
+      if (const char *Reason =
+              llvm::compression::getReasonIfUnsupported(Format)) {
         Error(Reason);
         return nullptr;
       }
-      SmallVector<uint8_t, 0> Decompressed;
-      if (llvm::Error E = llvm::compression::decompress(
-              F, llvm::arrayRefFromStringRef(Blob), Decompressed, Record[0])) {
+      // Decompress straight into the buffer we hand to the source manager.
+      std::unique_ptr<llvm::WritableMemoryBuffer> Buffer =
+          llvm::WritableMemoryBuffer::getNewUninitMemBuffer(Record[0], Name);
+      auto *Output = reinterpret_cast<uint8_t *>(Buffer->getBufferStart());
+      size_t Size = Record[0];
+      llvm::Error E =
+          Format == llvm::compression::Format::Zlib
+              ? llvm::compression::zlib::decompress(
+                    llvm::arrayRefFromStringRef(Blob), Output, Size)
+              : llvm::compression::zstd::decompress(
+                    llvm::arrayRefFromStringRef(Blob), Output, Size);
+      if (!E && Size != Record[0])
+        E = llvm::createStringError(std::errc::invalid_argument,
+                                    "unexpected uncompressed size");
+      if (E) {
         Error("could not decompress embedded file contents: " +
               llvm::toString(std::move(E)));
         return nullptr;
       }
-      return llvm::MemoryBuffer::getMemBufferCopy(
-          llvm::toStringRef(Decompressed), Name);
+      F.SLocBufferBytesCopied += Size;
+      return std::move(Buffer);
     } else if (RecCode == SM_SLOC_BUFFER_BLOB) {
+      F.SLocBufferBytesReferenced += Blob.size() - 1;
       return llvm::MemoryBuffer::getMemBuffer(Blob.drop_back(1), Name, true);
     } else {
       Error("AST record has invalid code");
@@ -1666,7 +1680,7 @@ bool ASTReader::ReadSLocEntry(int ID) {
     if (OverriddenBuffer && !ContentCache.BufferOverridden &&
         ContentCache.ContentsEntry == ContentCache.OrigEntry &&
         !ContentCache.getBufferIfLoaded()) {
-      auto Buffer = ReadBuffer(SLocEntryCursor, File->getName());
+      auto Buffer = ReadBuffer(*F, SLocEntryCursor, File->getName());
       if (!Buffer)
         return true;
       SourceMgr.overrideFileContents(*File, std::move(Buffer));
@@ -1685,7 +1699,7 @@ bool ASTReader::ReadSLocEntry(int ID) {
       IncludeLoc = getImportLocation(F);
     }
 
-    auto Buffer = ReadBuffer(SLocEntryCursor, Name);
+    auto Buffer = ReadBuffer(*F, SLocEntryCursor, Name);
     if (!Buffer)
       return true;
     FileID FID = SourceMgr.createFileID(std::move(Buffer), FileCharacter, ID,
@@ -8149,6 +8163,21 @@ void ASTReader::PrintStats() {
                  NumIdentifierLookupHits, NumIdentifierLookups,
                  (double)NumIdentifierLookupHits*100.0/NumIdentifierLookups);
 
+  if (ModuleMgr.size()) {
+    std::fprintf(stderr, "\n*** Module File Memory:\n");
+    for (ModuleFile &M : ModuleMgr) {
+      bool Mapped = M.Buffer->getBufferKind() ==
+                    llvm::MemoryBuffer::MemoryBuffer_MMap;
+      std::fprintf(stderr,
+                   "  %s: %zu bytes %s, embedded files: %llu bytes "
+                   "referenced, %llu bytes copied\n",
+                   M.FileName.c_str(), M.Buffer->getBufferSize(),
+                   Mapped ? "mapped" : "in memory",
+                   (unsigned long long)M.SLocBufferBytesReferenced,
+                   (unsigned long long)M.SLocBufferBytesCopied);
+    }
+  }
+
   if (GlobalIndex) {
     std::fprintf(stderr, "\n");
     GlobalIndex->printStats();
@@ -8579,10 +8608,19 @@ void ASTReader::ReadMethodPool(Selector Sel) {
   Generation = getGeneration();
   SelectorOutOfDate[Sel] = false;
 
+  // If there is a global index, look there first to determine which modules
+  // provably do not have any methods for this selector.
+  GlobalModuleIndex::HitSet Hits;
+  GlobalModuleIndex::HitSet *HitsPtr = nullptr;
+  if (!loadGlobalIndex()) {
+    if (GlobalIndex->lookupSelector(serialization::ComputeHash(Sel), Hits))
+      HitsPtr = &Hits;
+  }
+
   // Search for methods defined with this selector.
   ++NumMethodPoolLookups;
   ReadMethodPoolVisitor Visitor(*this, Sel, PriorGeneration);
-  ModuleMgr.visit(Visitor);
+  ModuleMgr.visit(Visitor, HitsPtr);
 
   if (Visitor.getInstanceMethods().empty() &&
       Visitor.getFactoryMethods().empty())
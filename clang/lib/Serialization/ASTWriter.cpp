@@ -100,6 +100,7 @@
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/OnDiskHashTable.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SHA1.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -2180,33 +2181,52 @@ void ASTWriter::WriteHeaderSearch(const HeaderSearch &HS) {
     free(const_cast<char *>(SavedStrings[I]));
 }
 
-static void emitBlob(llvm::BitstreamWriter &Stream, StringRef Blob,
+namespace {
+/// The contents of a buffer that is embedded in the AST file, including the
+/// implicit terminating null character, and its compressed form.
+struct SLocBufferBlob {
+  StringRef Blob;
+  SmallVector<uint8_t, 0> CompressedBuffer;
+};
+} // namespace
+
+// Compress the buffer if possible. We expect that almost all PCM consumers
+// will not want its contents.
+static void compressBlob(SLocBufferBlob &B) {
+  if (llvm::compression::zstd::isAvailable())
+    llvm::compression::zstd::compress(
+        llvm::arrayRefFromStringRef(B.Blob.drop_back(1)), B.CompressedBuffer,
+        9);
+  else if (llvm::compression::zlib::isAvailable())
+    llvm::compression::zlib::compress(
+        llvm::arrayRefFromStringRef(B.Blob.drop_back(1)), B.CompressedBuffer);
+}
+
+static void emitBlob(llvm::BitstreamWriter &Stream, const SLocBufferBlob &B,
                      unsigned SLocBufferBlobCompressedAbbrv,
                      unsigned SLocBufferBlobAbbrv) {
   using RecordDataType = ASTWriter::RecordData::value_type;
 
-  // Compress the buffer if possible. We expect that almost all PCM
-  // consumers will not want its contents.
-  SmallVector<uint8_t, 0> CompressedBuffer;
-  if (llvm::compression::zstd::isAvailable()) {
-    llvm::compression::zstd::compress(
-        llvm::arrayRefFromStringRef(Blob.drop_back(1)), CompressedBuffer, 9);
-    RecordDataType Record[] = {SM_SLOC_BUFFER_BLOB_COMPRESSED, Blob.size() - 1};
+  if (llvm::compression::zstd::isAvailable() ||
+      llvm::compression::zlib::isAvailable()) {
+    RecordDataType Record[] = {SM_SLOC_BUFFER_BLOB_COMPRESSED,
+                               B.Blob.size() - 1};
     Stream.EmitRecordWithBlob(SLocBufferBlobCompressedAbbrv, Record,
-                              llvm::toStringRef(CompressedBuffer));
-    return;
-  }
-  if (llvm::compression::zlib::isAvailable()) {
-    llvm::compression::zlib::compress(
-        llvm::arrayRefFromStringRef(Blob.drop_back(1)), CompressedBuffer);
-    RecordDataType Record[] = {SM_SLOC_BUFFER_BLOB_COMPRESSED, Blob.size() - 1};
-    Stream.EmitRecordWithBlob(SLocBufferBlobCompressedAbbrv, Record,
-                              llvm::toStringRef(CompressedBuffer));
+                              llvm::toStringRef(B.CompressedBuffer));
     return;
   }
 
   RecordDataType Record[] = {SM_SLOC_BUFFER_BLOB};
-  Stream.EmitRecordWithBlob(SLocBufferBlobAbbrv, Record, Blob);
+  Stream.EmitRecordWithBlob(SLocBufferBlobAbbrv, Record, B.Blob);
+}
+
+/// Whether the contents of a file need to be embedded in the AST file.
+static bool isEmbeddedSLocBuffer(const SrcMgr::ContentCache &Content) {
+  if (!Content.OrigEntry)
+    return true;
+  assert(Content.OrigEntry == Content.ContentsEntry &&
+         "Writing to AST an overridden file is not supported");
+  return Content.BufferOverridden || Content.IsTransient;
 }
 
 /// Writes the block containing the serialized form of the
@@ -2233,6 +2253,28 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
       CreateSLocBufferBlobAbbrev(Stream, true);
   unsigned SLocExpansionAbbrv = CreateSLocExpansionAbbrev(Stream);
 
+  // Compressing the embedded buffers dominates the cost of this block when
+  // many files are embedded, e.g. with -fmodules-embed-all-files. Each buffer
+  // is compressed on its own, so compress all of them in parallel up front;
+  // the records below are still emitted in order, so the output is the same.
+  SmallVector<SLocBufferBlob, 0> Blobs;
+  for (unsigned I = 1, N = SourceMgr.local_sloc_entry_size(); I != N; ++I) {
+    const SrcMgr::SLocEntry &SLoc = SourceMgr.getLocalSLocEntry(I);
+    if (!SLoc.isFile() || !IsSLocAffecting[I])
+      continue;
+    const SrcMgr::ContentCache &Content = SLoc.getFile().getContentCache();
+    if (!isEmbeddedSLocBuffer(Content))
+      continue;
+    std::optional<llvm::MemoryBufferRef> Buffer =
+        Content.getBufferOrNone(PP.getDiagnostics(), PP.getFileManager());
+    if (!Buffer)
+      Buffer = llvm::MemoryBufferRef("<<<INVALID BUFFER>>>", "");
+    Blobs.emplace_back().Blob =
+        StringRef(Buffer->getBufferStart(), Buffer->getBufferSize() + 1);
+  }
+  llvm::parallelForEach(Blobs, compressBlob);
+  const SLocBufferBlob *NextBlob = Blobs.begin();
+
   // Write out the source location entry table. We skip the first
   // entry, which is always the same dummy entry.
   std::vector<uint32_t> SLocEntryOffsets;
@@ -2275,11 +2317,7 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
       Record.push_back(File.getFileCharacteristic()); // FIXME: stable encoding
       Record.push_back(File.hasLineDirectives());
 
-      bool EmitBlob = false;
       if (Content->OrigEntry) {
-        assert(Content->OrigEntry == Content->ContentsEntry &&
-               "Writing to AST an overridden file is not supported");
-
         // The source location entry is a file. Emit input file ID.
         assert(InputFileIDs[*Content->OrigEntry] != 0 && "Missed file entry");
         Record.push_back(InputFileIDs[*Content->OrigEntry]);
@@ -2296,9 +2334,6 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
         }
 
         Stream.EmitRecordWithAbbrev(SLocFileAbbrv, Record);
-
-        if (Content->BufferOverridden || Content->IsTransient)
-          EmitBlob = true;
       } else {
         // The source location entry is a buffer. The blob associated
         // with this entry contains the contents of the buffer.
@@ -2311,18 +2346,11 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
         StringRef Name = Buffer ? Buffer->getBufferIdentifier() : "";
         Stream.EmitRecordWithBlob(SLocBufferAbbrv, Record,
                                   StringRef(Name.data(), Name.size() + 1));
-        EmitBlob = true;
       }
 
-      if (EmitBlob) {
-        // Include the implicit terminating null character in the on-disk buffer
-        // if we're writing it uncompressed.
-        std::optional<llvm::MemoryBufferRef> Buffer =
-            Content->getBufferOrNone(PP.getDiagnostics(), PP.getFileManager());
-        if (!Buffer)
-          Buffer = llvm::MemoryBufferRef("<<<INVALID BUFFER>>>", "");
-        StringRef Blob(Buffer->getBufferStart(), Buffer->getBufferSize() + 1);
-        emitBlob(Stream, Blob, SLocBufferBlobCompressedAbbrv,
+      if (isEmbeddedSLocBuffer(*Content)) {
+        assert(NextBlob != Blobs.end() && "Missed embedded buffer");
+        emitBlob(Stream, *NextBlob++, SLocBufferBlobCompressedAbbrv,
                  SLocBufferBlobAbbrv);
       }
     } else {
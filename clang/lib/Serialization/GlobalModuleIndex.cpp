@@ -51,7 +51,9 @@ namespace {
     /// Describes a module, including its file name and dependencies.
     MODULE,
     /// The index for identifiers.
-    IDENTIFIER_INDEX
+    IDENTIFIER_INDEX,
+    /// The index for selectors in method pools.
+    SELECTOR_INDEX
   };
 }
 
@@ -240,6 +242,11 @@ GlobalModuleIndex::GlobalModuleIndex(
             (const unsigned char *)Blob.data(), IdentifierIndexReaderTrait());
       }
       break;
+
+    case SELECTOR_INDEX:
+      HasSelectorIndex = true;
+      SelectorIndex = Blob;
+      break;
     }
   }
 }
@@ -324,6 +331,43 @@ bool GlobalModuleIndex::lookupIdentifier(StringRef Name, HitSet &Hits) {
   return true;
 }
 
+bool GlobalModuleIndex::lookupSelector(unsigned Hash, HitSet &Hits) {
+  Hits.clear();
+
+  // If there's no selector index, there is nothing we can do.
+  if (!HasSelectorIndex)
+    return false;
+
+  // Binary search the sorted (hash, module ID) pairs.
+  ++NumSelectorLookups;
+  using namespace llvm::support;
+  const char *Data = SelectorIndex.data();
+  auto HashAt = [&](size_t I) { return endian::read32le(Data + I * 8); };
+  size_t Lo = 0, Hi = SelectorIndex.size() / 8;
+  size_t N = Hi;
+  while (Lo < Hi) {
+    size_t Mid = Lo + (Hi - Lo) / 2;
+    if (HashAt(Mid) < Hash)
+      Lo = Mid + 1;
+    else
+      Hi = Mid;
+  }
+  bool Found = false;
+  for (; Lo != N && HashAt(Lo) == Hash; ++Lo) {
+    Found = true;
+    unsigned ID = endian::read32le(Data + Lo * 8 + 4);
+    if (ID < Modules.size())
+      if (ModuleFile *MF = Modules[ID].File)
+        Hits.insert(MF);
+  }
+  if (Found)
+    ++NumSelectorLookupHits;
+
+  // The index covers the method pools of all module files it knows about, so
+  // those that are not hits provably have no entry for the selector.
+  return true;
+}
+
 bool GlobalModuleIndex::loadedModuleFile(ModuleFile *File) {
   // Look for the module in the global module index based on the module name.
   StringRef Name = File->ModuleName;
@@ -358,6 +402,11 @@ void GlobalModuleIndex::printStats() {
             NumIdentifierLookupHits, NumIdentifierLookups,
             (double)NumIdentifierLookupHits*100.0/NumIdentifierLookups);
   }
+  if (NumSelectorLookups) {
+    fprintf(stderr, "  %u / %u selector lookups succeeded (%f%%)\n",
+            NumSelectorLookupHits, NumSelectorLookups,
+            (double)NumSelectorLookupHits * 100.0 / NumSelectorLookups);
+  }
   std::fprintf(stderr, "\n");
 }
 
@@ -425,6 +474,9 @@ namespace {
     /// files in which those identifiers are considered interesting.
     InterestingIdentifierMap InterestingIdentifiers;
 
+    /// The (selector hash, module file ID) pairs of all method pool entries.
+    std::vector<std::pair<unsigned, unsigned>> SelectorHashes;
+
     /// Write the block-info block for the global module index file.
     void emitBlockInfoBlock(llvm::BitstreamWriter &Stream);
 
@@ -490,6 +542,7 @@ GlobalModuleIndexBuilder::emitBlockInfoBlock(llvm::BitstreamWriter &Stream) {
   RECORD(INDEX_METADATA);
   RECORD(MODULE);
   RECORD(IDENTIFIER_INDEX);
+  RECORD(SELECTOR_INDEX);
 #undef RECORD
 #undef BLOCK
 
@@ -694,6 +747,36 @@ llvm::Error GlobalModuleIndexBuilder::loadModuleFile(FileEntryRef File) {
       }
     }
 
+    // Handle the method pool. Only the hashes of the selectors are recorded,
+    // which avoids resolving the identifiers the keys refer to; a collision
+    // merely makes the reader visit an extra module.
+    if (State == ASTBlock && Code == METHOD_POOL && Record[0] > 0) {
+      using namespace llvm::support;
+      const unsigned char *Base = (const unsigned char *)Blob.data();
+      const unsigned char *Buckets = Base + Record[0];
+      unsigned NumBuckets =
+          endian::readNext<uint32_t, llvm::endianness::little>(Buckets);
+      // Skip the number of entries.
+      Buckets += sizeof(uint32_t);
+      for (unsigned B = 0; B != NumBuckets; ++B) {
+        unsigned Offset =
+            endian::readNext<uint32_t, llvm::endianness::little>(Buckets);
+        if (!Offset)
+          continue;
+        const unsigned char *Items = Base + Offset;
+        unsigned NumItems =
+            endian::readNext<uint16_t, llvm::endianness::little>(Items);
+        for (unsigned I = 0; I != NumItems; ++I) {
+          unsigned Hash =
+              endian::readNext<uint32_t, llvm::endianness::little>(Items);
+          auto [KeyLen, DataLen] =
+              reader::ASTSelectorLookupTrait::ReadKeyDataLength(Items);
+          Items += KeyLen + DataLen;
+          SelectorHashes.emplace_back(Hash, ID);
+        }
+      }
+    }
+
     // Get Signature.
     if (State == DiagnosticOptionsBlock && Code == SIGNATURE) {
       auto Signature = ASTFileSignature::create(Blob.begin(), Blob.end());
@@ -839,6 +922,30 @@ bool GlobalModuleIndexBuilder::writeIndex(llvm::BitstreamWriter &Stream) {
     Stream.EmitRecordWithBlob(IDTableAbbrev, Record, IdentifierTable);
   }
 
+  // Write the selector hash -> module file mapping.
+  {
+    llvm::sort(SelectorHashes);
+    SelectorHashes.erase(llvm::unique(SelectorHashes), SelectorHashes.end());
+
+    SmallString<4096> SelectorTable;
+    {
+      using namespace llvm::support;
+      llvm::raw_svector_ostream Out(SelectorTable);
+      for (const auto &[Hash, ID] : SelectorHashes) {
+        endian::write<uint32_t>(Out, Hash, llvm::endianness::little);
+        endian::write<uint32_t>(Out, ID, llvm::endianness::little);
+      }
+    }
+
+    auto Abbrev = std::make_shared<BitCodeAbbrev>();
+    Abbrev->Add(BitCodeAbbrevOp(SELECTOR_INDEX));
+    Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+    unsigned SelTableAbbrev = Stream.EmitAbbrev(std::move(Abbrev));
+
+    uint64_t Record[] = {SELECTOR_INDEX};
+    Stream.EmitRecordWithBlob(SelTableAbbrev, Record, SelectorTable);
+  }
+
   Stream.ExitBlock();
   return false;
 }
@@ -199,12 +199,15 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
   } else {
     // Get a buffer of the file and close the file descriptor when done.
     // The file is volatile because in a parallel build we expect multiple
-    // compiler processes to use the same module file rebuilding it if needed.
+    // compiler processes to use the same module file rebuilding it if needed,
+    // unless the user promised that module files are only ever replaced, not
+    // modified in place (-fmodules-mmap-files).
     //
     // RequiresNullTerminator is false because module files don't need it, and
     // this allows the file to still be mmapped.
-    auto Buf = FileMgr.getBufferForFile(NewModule->File,
-                                        /*IsVolatile=*/true,
+    bool IsVolatile =
+        !HeaderSearchInfo.getHeaderSearchOpts().ModulesMMapFiles;
+    auto Buf = FileMgr.getBufferForFile(NewModule->File, IsVolatile,
                                         /*RequiresNullTerminator=*/false);
 
     if (!Buf) {
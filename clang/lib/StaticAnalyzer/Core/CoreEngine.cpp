@@ -47,6 +47,8 @@ STATISTIC(NumSTUSteps, "The # of STU steps executed.");
 STATISTIC(NumCTUSteps, "The # of CTU steps executed.");
 STATISTIC(NumReachedMaxSteps,
             "The # of times we reached the max number of steps.");
+STATISTIC(NumReachedMaxMemory,
+          "The # of times we reached the max memory per function.");
 STATISTIC(NumPathsExplored,
             "The # of paths explored by the analyzer.");
 
@@ -135,8 +137,18 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned MaxSteps,
   if(!UnlimitedSteps)
     G.reserve(std::min(MaxSteps, PreReservationCap));
 
-  auto ProcessWList = [this, UnlimitedSteps](unsigned MaxSteps) {
+  // Everything allocated for this function, from exploded nodes to the store
+  // and environment bindings of its states, comes from the graph's allocator,
+  // which is only released when the engine is destroyed.
+  const size_t MaxBytes =
+      size_t(ExprEng.getAnalysisManager().options.MaxMemoryPerFunction) << 20;
+  // Checking the allocator on every step would be wasteful; states grow by far
+  // less than a megabyte per step.
+  const unsigned MemoryCheckInterval = 1024;
+
+  auto ProcessWList = [this, UnlimitedSteps, MaxBytes](unsigned MaxSteps) {
     unsigned Steps = MaxSteps;
+    unsigned StepsUntilMemoryCheck = MemoryCheckInterval;
     while (WList->hasWork()) {
       if (!UnlimitedSteps) {
         if (Steps == 0) {
@@ -146,6 +158,14 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned MaxSteps,
         --Steps;
       }
 
+      if (MaxBytes && --StepsUntilMemoryCheck == 0) {
+        StepsUntilMemoryCheck = MemoryCheckInterval;
+        if (G.getAllocator().getBytesAllocated() > MaxBytes) {
+          NumReachedMaxMemory++;
+          break;
+        }
+      }
+
       NumSteps++;
 
       const WorkListUnit &WU = WList->dequeue();
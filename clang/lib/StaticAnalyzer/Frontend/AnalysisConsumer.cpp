@@ -41,6 +41,7 @@
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <memory>
 #include <queue>
 #include <utility>
@@ -60,6 +61,8 @@ STATISTIC(NumVisitedBlocksInAnalyzedFunctions,
           "The # of visited basic blocks in the analyzed functions.");
 STATISTIC(PercentReachableBlocks, "The % of reachable basic blocks.");
 STATISTIC(MaxCFGSize, "The maximum number of basic blocks in a function.");
+STATISTIC(MaxGraphMemory, "The maximum number of bytes allocated for the "
+                          "exploded graph and states of a function.");
 
 //===----------------------------------------------------------------------===//
 // AnalysisConsumer declaration.
@@ -354,6 +357,8 @@ private:
 
   /// Check if we should skip (not analyze) the given function.
   AnalysisMode getModeForDecl(Decl *D, AnalysisMode Mode);
+  /// Removes the parts of \p Mode that belong to other shards.
+  AnalysisMode getModeForShard(Decl *D, AnalysisMode Mode);
   void runAnalysisOnTranslationUnit(ASTContext &C);
 
   /// Print \p S to stderr if \c Opts.AnalyzerDisplayProgress is set.
@@ -529,11 +534,15 @@ void AnalysisConsumer::runAnalysisOnTranslationUnit(ASTContext &C) {
   BugReporter BR(*Mgr);
   const TranslationUnitDecl *TU = C.getTranslationUnitDecl();
   BR.setAnalysisEntryPoint(TU);
-  if (SyntaxCheckTimer)
-    SyntaxCheckTimer->startTimer();
-  checkerMgr->runCheckersOnASTDecl(TU, *Mgr, BR);
-  if (SyntaxCheckTimer)
-    SyntaxCheckTimer->stopTimer();
+  // With sharding, the checks on the whole translation unit run in shard 0.
+  const bool RunTUChecks = Opts.ShardCount <= 1 || Opts.ShardIndex == 0;
+  if (RunTUChecks) {
+    if (SyntaxCheckTimer)
+      SyntaxCheckTimer->startTimer();
+    checkerMgr->runCheckersOnASTDecl(TU, *Mgr, BR);
+    if (SyntaxCheckTimer)
+      SyntaxCheckTimer->stopTimer();
+  }
 
   // Run the AST-only checks using the order in which functions are defined.
   // If inlining is not turned on, use the simplest function order for path
@@ -558,7 +567,8 @@ void AnalysisConsumer::runAnalysisOnTranslationUnit(ASTContext &C) {
     HandleDeclsCallGraph(LocalTUDeclsSize);
 
   // After all decls handled, run checkers on the entire TranslationUnit.
-  checkerMgr->runCheckersOnEndOfTranslationUnit(TU, *Mgr, BR);
+  if (RunTUChecks)
+    checkerMgr->runCheckersOnEndOfTranslationUnit(TU, *Mgr, BR);
 
   BR.FlushReports();
   RecVisitorBR = nullptr;
@@ -634,7 +644,7 @@ AnalysisConsumer::getModeForDecl(Decl *D, AnalysisMode Mode) {
   // - Header files: run non-path-sensitive checks only.
   // - System headers: don't run any checks.
   if (Opts.AnalyzeAll)
-    return Mode;
+    return getModeForShard(D, Mode);
 
   const SourceManager &SM = Ctx->getSourceManager();
 
@@ -650,8 +660,28 @@ AnalysisConsumer::getModeForDecl(Decl *D, AnalysisMode Mode) {
 
   // Disable path sensitive analysis in user-headers.
   if (!Mgr->isInCodeFile(Loc))
-    return Mode & ~AM_Path;
+    Mode &= ~AM_Path;
+
+  return getModeForShard(D, Mode);
+}
 
+AnalysisConsumer::AnalysisMode
+AnalysisConsumer::getModeForShard(Decl *D, AnalysisMode Mode) {
+  if (Opts.ShardCount <= 1 || Mode == AM_None)
+    return Mode;
+
+  // AST-based checks are cheap compared to path-sensitive analysis and may
+  // look at several declarations at once, so they all run in shard 0.
+  if (Opts.ShardIndex != 0)
+    Mode &= ~AM_Syntax;
+
+  // Assign functions by a hash of their name, which is the same in every
+  // process analyzing this translation unit.
+  if (Mode & AM_Path) {
+    uint64_t Hash = llvm::xxh3_64bits(AnalysisDeclContext::getFunctionName(D));
+    if (Hash % Opts.ShardCount != Opts.ShardIndex)
+      Mode &= ~AM_Path;
+  }
   return Mode;
 }
 
@@ -735,6 +765,8 @@ void AnalysisConsumer::RunPathSensitiveChecks(Decl *D,
     DisplayTime(ExprEngineEndTime);
   }
 
+  MaxGraphMemory.updateMax(Eng.getGraph().getAllocator().getBytesAllocated());
+
   if (!Mgr->options.DumpExplodedGraphTo.empty())
     Eng.DumpGraph(Mgr->options.TrimGraph, Mgr->options.DumpExplodedGraphTo);
 
@@ -7,7 +7,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/Threading.h"
 #include <optional>
@@ -41,6 +46,105 @@ DependencyScanningWorkerFilesystem::readFile(StringRef Filename) {
   return TentativeEntry(Stat, std::move(Buffer));
 }
 
+/// Bump this whenever the cache format or the scanned tokens change.
+static constexpr uint32_t DirectivesCacheVersion = 1;
+
+/// Returns the path of the on-disk directives cache entry for \p Source.
+static SmallString<128> getDirectivesCacheFile(StringRef CacheDir,
+                                               StringRef Source) {
+  auto Hash = llvm::BLAKE3::hash<16>(llvm::arrayRefFromStringRef(Source));
+  SmallString<128> Path(CacheDir);
+  llvm::sys::path::append(Path, llvm::toHex(Hash, /*LowerCase=*/true) + ".ddc");
+  return Path;
+}
+
+/// Writes the scanned directives of a file to the on-disk cache. The entry
+/// consists of a header, the tokens and the directives as token counts:
+///
+///   u32 version, u32 tok::NUM_TOKENS, u32 source size,
+///   u32 token count, u32 directive count,
+///   { u32 offset, u32 length, u16 kind, u16 flags } * token count,
+///   { u32 kind, u32 token count } * directive count
+///
+/// The cache is best effort, so failures are ignored.
+static void
+writeDirectivesCacheFile(StringRef Path, StringRef Source,
+                         ArrayRef<dependency_directives_scan::Token> Tokens,
+                         ArrayRef<dependency_directives_scan::Directive> Dirs) {
+  llvm::consumeError(llvm::writeToOutput(Path, [&](raw_ostream &OS) {
+    llvm::support::endian::Writer W(OS, llvm::endianness::little);
+    W.write<uint32_t>(DirectivesCacheVersion);
+    W.write<uint32_t>(tok::NUM_TOKENS);
+    W.write<uint32_t>(Source.size());
+    W.write<uint32_t>(Tokens.size());
+    W.write<uint32_t>(Dirs.size());
+    for (const dependency_directives_scan::Token &T : Tokens) {
+      W.write<uint32_t>(T.Offset);
+      W.write<uint32_t>(T.Length);
+      W.write<uint16_t>(T.Kind);
+      W.write<uint16_t>(T.Flags);
+    }
+    for (const dependency_directives_scan::Directive &D : Dirs) {
+      W.write<uint32_t>(D.Kind);
+      W.write<uint32_t>(D.Tokens.size());
+    }
+    return Error::success();
+  }));
+}
+
+/// Reads the scanned directives of a file from the on-disk cache. Returns
+/// false if there is no valid entry.
+static bool readDirectivesCacheFile(
+    StringRef Path, StringRef Source,
+    SmallVectorImpl<dependency_directives_scan::Token> &Toks,
+    SmallVectorImpl<dependency_directives_scan::Directive> &Dirs) {
+  auto MaybeBuffer = llvm::MemoryBuffer::getFile(
+      Path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+  if (!MaybeBuffer)
+    return false;
+  StringRef Data = (*MaybeBuffer)->getBuffer();
+  const char *Ptr = Data.data();
+  auto Read32 = [&] {
+    return llvm::support::endian::readNext<uint32_t, llvm::endianness::little>(
+        Ptr);
+  };
+  auto Read16 = [&] {
+    return llvm::support::endian::readNext<uint16_t, llvm::endianness::little>(
+        Ptr);
+  };
+
+  if (Data.size() < 20 || Read32() != DirectivesCacheVersion ||
+      Read32() != tok::NUM_TOKENS || Read32() != Source.size())
+    return false;
+  uint64_t NumTokens = Read32();
+  uint64_t NumDirectives = Read32();
+  if (Data.size() != 20 + NumTokens * 12 + NumDirectives * 8)
+    return false;
+
+  Toks.reserve(NumTokens);
+  for (uint64_t I = 0; I != NumTokens; ++I) {
+    uint32_t Offset = Read32();
+    uint32_t Length = Read32();
+    uint16_t Kind = Read16();
+    uint16_t Flags = Read16();
+    if (Kind >= tok::NUM_TOKENS || uint64_t(Offset) + Length > Source.size())
+      return false;
+    Toks.emplace_back(Offset, Length, tok::TokenKind(Kind), Flags);
+  }
+
+  ArrayRef<dependency_directives_scan::Token> Remaining = Toks;
+  for (uint64_t I = 0; I != NumDirectives; ++I) {
+    uint32_t Kind = Read32();
+    uint32_t Count = Read32();
+    if (Kind > dependency_directives_scan::pp_eof || Count > Remaining.size())
+      return false;
+    Dirs.emplace_back(dependency_directives_scan::DirectiveKind(Kind),
+                      Remaining.take_front(Count));
+    Remaining = Remaining.drop_front(Count);
+  }
+  return Remaining.empty();
+}
+
 bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     EntryRef Ref) {
   auto &Entry = Ref.Entry;
@@ -62,15 +166,33 @@ bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     return true;
 
   SmallVector<dependency_directives_scan::Directive, 64> Directives;
+  StringRef Source = Contents->Original->getBuffer();
+  StringRef CacheDir = SharedCache.getDirectivesCachePath();
+  SmallString<128> CacheFile;
+  if (!CacheDir.empty()) {
+    // Another process may have scanned the same contents already.
+    CacheFile = getDirectivesCacheFile(CacheDir, Source);
+    if (!readDirectivesCacheFile(CacheFile, Source,
+                                 Contents->DepDirectiveTokens, Directives)) {
+      Contents->DepDirectiveTokens.clear();
+      Directives.clear();
+    }
+  }
+
   // Scan the file for preprocessor directives that might affect the
   // dependencies.
-  if (scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
-                                        Contents->DepDirectiveTokens,
-                                        Directives)) {
-    Contents->DepDirectiveTokens.clear();
-    // FIXME: Propagate the diagnostic if desired by the client.
-    Contents->DepDirectives.store(new std::optional<DependencyDirectivesTy>());
-    return false;
+  if (Directives.empty()) {
+    if (scanSourceForDependencyDirectives(Source, Contents->DepDirectiveTokens,
+                                          Directives)) {
+      Contents->DepDirectiveTokens.clear();
+      // FIXME: Propagate the diagnostic if desired by the client.
+      Contents->DepDirectives.store(
+          new std::optional<DependencyDirectivesTy>());
+      return false;
+    }
+    if (!CacheFile.empty())
+      writeDirectivesCacheFile(CacheFile, Source, Contents->DepDirectiveTokens,
+                               Directives);
   }
 
   // This function performed double-checked locking using `DepDirectives`.
@@ -94,6 +216,42 @@ DependencyScanningFilesystemSharedCache::
   CacheShards = std::make_unique<CacheShard[]>(NumShards);
 }
 
+void DependencyScanningFilesystemSharedCache::invalidateFiles(
+    ArrayRef<std::string> Filenames) {
+  llvm::SmallPtrSet<const CachedFileSystemEntry *, 16> Stale;
+  for (StringRef Filename : Filenames) {
+    CacheShard &Shard = getShardForFilename(Filename);
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    auto It = Shard.CacheByFilename.find(Filename);
+    if (It == Shard.CacheByFilename.end())
+      continue;
+    if (const CachedFileSystemEntry *Entry = It->getValue().first)
+      Stale.insert(Entry);
+    Shard.CacheByFilename.erase(It);
+  }
+  if (Stale.empty())
+    return;
+
+  // Entries are shared between all the names of a file and its unique ID.
+  for (unsigned I = 0; I != NumShards; ++I) {
+    CacheShard &Shard = CacheShards[I];
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    for (auto It = Shard.CacheByFilename.begin(),
+              End = Shard.CacheByFilename.end();
+         It != End;) {
+      auto Cur = It++;
+      if (Stale.contains(Cur->getValue().first))
+        Shard.CacheByFilename.erase(Cur);
+    }
+    for (auto It = Shard.EntriesByUID.begin(), End = Shard.EntriesByUID.end();
+         It != End;) {
+      auto Cur = It++;
+      if (Stale.contains(Cur->second))
+        Shard.EntriesByUID.erase(Cur);
+    }
+  }
+}
+
 DependencyScanningFilesystemSharedCache::CacheShard &
 DependencyScanningFilesystemSharedCache::getShardForFilename(
     StringRef Filename) const {
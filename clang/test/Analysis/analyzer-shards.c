@@ -0,0 +1,42 @@
+// Every function is analyzed in exactly one of the shards, and together they
+// find the same bugs as an unsharded run.
+// RUN: %clang_analyze_cc1 -analyzer-checker=core %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=ALL
+// RUN: %clang_analyze_cc1 -analyzer-checker=core \
+// RUN:   -analyzer-config shard-count=2,shard-index=0 %s 2> %t.0
+// RUN: %clang_analyze_cc1 -analyzer-checker=core \
+// RUN:   -analyzer-config shard-count=2,shard-index=1 %s 2> %t.1
+// RUN: cat %t.0 %t.1 | FileCheck %s --check-prefix=ALL
+// RUN: cat %t.0 %t.1 | grep -c "warning:" | FileCheck %s --check-prefix=COUNT
+
+// RUN: not %clang_analyze_cc1 -analyzer-checker=core \
+// RUN:   -analyzer-config shard-count=2,shard-index=2 %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=INVALID
+
+// INVALID: (frontend): invalid input for analyzer-config option 'shard-index'
+
+// ALL-DAG: warning: Dereference of null pointer (loaded from variable 'a')
+// ALL-DAG: warning: Dereference of null pointer (loaded from variable 'b')
+// ALL-DAG: warning: Dereference of null pointer (loaded from variable 'c')
+// ALL-DAG: warning: Dereference of null pointer (loaded from variable 'd')
+// COUNT: 4
+
+int first(void) {
+  int *a = 0;
+  return *a;
+}
+
+int second(void) {
+  int *b = 0;
+  return *b;
+}
+
+int third(void) {
+  int *c = 0;
+  return *c;
+}
+
+int fourth(void) {
+  int *d = 0;
+  return *d;
+}
@@ -0,0 +1,27 @@
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+// RUN: %clang_cc1 -fsyntax-only -I %t -include-cost-report %t/report.txt \
+// RUN:     %t/main.c
+// RUN: FileCheck --input-file=%t/report.txt %s
+
+// CHECK: Include cost report: 2 headers, {{[0-9.]+}} ms, {{[0-9]+}} tokens
+// CHECK-NEXT: incl-ms self-ms incl-tok self-tok entered skipped file
+// CHECK-NEXT: {{[0-9.]+ [0-9.]+}} 8 3 1 1 {{.*}}a.h
+// CHECK-NEXT: {{[0-9.]+ [0-9.]+}} 5 5 1 1 {{.*}}b.h
+
+//--- main.c
+#include "a.h"
+#include "a.h"
+#include "b.h"
+int main;
+
+//--- a.h
+#pragma once
+#include "b.h"
+int a;
+
+//--- b.h
+#ifndef B_H
+#define B_H
+int b1, b2;
+#endif
@@ -0,0 +1,48 @@
+// RUN: rm -rf %t && split-file %s %t
+
+// RUN: %clang_cc1 -fsyntax-only -isystem %t/sys -fbuild-session-timestamp=123 \
+// RUN:   -fshared-stat-cache-path=%t/cache %t/main.c -verify=missing
+// RUN: FileCheck %s --input-file=%t/cache/7B.statcache
+
+// CHECK-DAG: {{^[0-9a-f]{8} 0 0 0 0 0 0 0 0 .*}}sys{{/|\\}}gen.h{{$}}
+// CHECK-DAG: {{^[0-9a-f]{8} [1-9][0-9]* .*}}sys{{/|\\}}a.h{{$}}
+
+// Within the same build session, a header that appears later is still
+// reported as missing.
+// RUN: touch %t/sys/gen.h
+// RUN: %clang_cc1 -fsyntax-only -isystem %t/sys -fbuild-session-timestamp=123 \
+// RUN:   -fshared-stat-cache-path=%t/cache %t/main.c -verify=missing
+
+// A new build session starts from an empty cache.
+// RUN: %clang_cc1 -fsyntax-only -isystem %t/sys -fbuild-session-timestamp=124 \
+// RUN:   -fshared-stat-cache-path=%t/cache %t/main.c -verify=present
+// RUN: ls %t/cache | FileCheck %s --check-prefix=FILES
+// FILES: 7B.statcache
+// FILES: 7C.statcache
+
+// Directories outside the system include paths are never cached.
+// RUN: rm %t/sys/gen.h
+// RUN: %clang_cc1 -fsyntax-only -I %t/sys -fbuild-session-timestamp=125 \
+// RUN:   -fshared-stat-cache-path=%t/cache %t/main.c -verify=missing
+// RUN: touch %t/sys/gen.h
+// RUN: %clang_cc1 -fsyntax-only -I %t/sys -fbuild-session-timestamp=125 \
+// RUN:   -fshared-stat-cache-path=%t/cache %t/main.c -verify=present
+
+// The driver forwards the option and the build session.
+// RUN: %clang -### -fsyntax-only -fshared-stat-cache-path=%t/cache \
+// RUN:   -fbuild-session-timestamp=123 %t/main.c 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=DRIVER
+// DRIVER: "-fshared-stat-cache-path={{.*}}cache"
+// DRIVER-SAME: "-fbuild-session-timestamp=123"
+
+//--- sys/a.h
+int a;
+
+//--- main.c
+#include <a.h>
+
+#if __has_include(<gen.h>)
+#warning gen.h found // present-warning {{gen.h found}}
+#else
+#warning gen.h missing // missing-warning {{gen.h missing}}
+#endif
@@ -1,5 +1,8 @@
 // RUN: rm -rf %t
 // RUN: %clang_cc1 -fmodules-cache-path=%t -fmodules -fimplicit-module-maps -I %S/Inputs %s -verify
+// Run again so that the method pool lookups go through the global module index.
+// RUN: ls %t | grep modules.idx
+// RUN: %clang_cc1 -fmodules-cache-path=%t -fmodules -fimplicit-module-maps -I %S/Inputs %s -verify
 
 
 @import MethodPoolA;
@@ -0,0 +1,21 @@
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+//
+// RUN: %clang_cc1 -fmodules -I%t -fmodules-cache-path=%t -fmodule-name=a \
+// RUN:   -emit-module %t/module.modulemap -fmodules-embed-all-files -o %t/a.pcm
+// RUN: %clang_cc1 -fmodules -I%t -fmodules-cache-path=%t \
+// RUN:   -fmodule-file=%t/a.pcm -fmodules-mmap-files -fsyntax-only \
+// RUN:   -print-stats %t/use.cpp 2>&1 | FileCheck %s
+//
+// CHECK: *** Module File Memory:
+// CHECK-NEXT: a.pcm: {{[0-9]+}} bytes {{mapped|in memory}}, embedded files: {{[0-9]+}} bytes referenced, {{[0-9]+}} bytes copied
+
+//--- module.modulemap
+module a { header "a.h" }
+
+//--- a.h
+[[deprecated]] void f();
+
+//--- use.cpp
+#include "a.h"
+void g() { f(); }
@@ -0,0 +1,30 @@
+// Check that instantiations performed while building a module interface are
+// reused by importers instead of being instantiated again.
+//
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+//
+// RUN: %clang_cc1 -std=c++20 -triple %itanium_abi_triple %t/A.cppm \
+// RUN:   -emit-module-interface -o %t/A.pcm
+// RUN: %clang_cc1 -std=c++20 -triple %itanium_abi_triple \
+// RUN:   -fprebuilt-module-path=%t %t/Use.cpp -fsyntax-only -print-stats \
+// RUN:   2>&1 | FileCheck %s
+//
+// CHECK: *** Semantic Analysis Stats:
+// CHECK: {{[0-9]+}} class instantiations, {{[1-9][0-9]*}} imported class template specializations reused.
+// CHECK-NEXT: {{[0-9]+}} function instantiations, {{[0-9]+}} imported function definitions reused.
+
+//--- A.cppm
+export module A;
+
+export template <typename T> struct S {
+  T t;
+  T get() const { return t; }
+};
+
+export inline int use(S<int> s) { return s.get(); }
+
+//--- Use.cpp
+import A;
+
+int f(S<int> s) { return s.get() + use(s); }
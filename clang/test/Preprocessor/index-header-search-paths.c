@@ -0,0 +1,23 @@
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+// RUN: %clang_cc1 -E -findex-header-search-paths -I %t/a -I %t/a/sub -I %t/b \
+// RUN:     %t/main.c | FileCheck %s
+// RUN: %clang_cc1 -E -I %t/a -I %t/a/sub -I %t/b %t/main.c | FileCheck %s
+
+// CHECK: in_b_foo
+// CHECK: in_a_sub_bar
+// CHECK: in_a_other
+
+//--- main.c
+#include <foo.h>
+#include <sub/bar.h>
+#include <../other.h>
+
+//--- a/other.h
+in_a_other
+
+//--- a/sub/bar.h
+in_a_sub_bar
+
+//--- b/foo.h
+in_b_foo
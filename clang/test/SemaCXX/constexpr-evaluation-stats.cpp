@@ -0,0 +1,17 @@
+// RUN: %clang_cc1 -std=c++20 -fsyntax-only -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=TREE
+// RUN: %clang_cc1 -std=c++20 -fsyntax-only -print-stats %s \
+// RUN:   -fexperimental-new-constant-interpreter 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=INTERP
+
+// TREE: {{[1-9][0-9]*}} constant evaluations, {{[1-9][0-9]*}} evaluator steps, 0 interpreter instructions
+// INTERP: {{[1-9][0-9]*}} constant evaluations, {{[0-9]+}} evaluator steps, {{[1-9][0-9]*}} interpreter instructions
+
+constexpr unsigned fnv1a(const char *S) {
+  unsigned H = 2166136261u;
+  for (; *S; ++S)
+    H = (H ^ static_cast<unsigned char>(*S)) * 16777619u;
+  return H;
+}
+
+static_assert(fnv1a("constant evaluation") != 0);
@@ -0,0 +1,24 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+
+// CHECK: *** Semantic Analysis Stats:
+// CHECK: {{[0-9]+}} overload candidates, {{[1-9][0-9]*}} rejected by arity, 4 rejected by a quick conversion check.
+
+struct Stream {};
+struct Point {};
+struct Bool { operator bool() const; };
+
+void operator<<(Stream &, int);    // expected-note {{no known conversion from 'Point' to 'int' for 2nd argument}}
+void operator<<(Stream &, double); // expected-note {{no known conversion from 'Point' to 'double' for 2nd argument}}
+void operator<<(Stream &, const char *); // expected-note {{no known conversion from 'Point' to 'const char *' for 2nd argument}}
+void operator<<(Stream &, const Point &, int); // expected-note {{requires 3 arguments, but 2 were provided}}
+
+// Classes with conversion functions take the usual path.
+void f(bool);
+void f(Point);
+
+void test(Stream &S, Point P, Bool B) {
+  S << P; // expected-error {{invalid operands to binary expression ('Stream' and 'Point')}}
+  f(B);
+  f(P);
+}
@@ -0,0 +1,250 @@
+//===- ClangCC1Server.cpp - Run cc1 jobs in a persistent process ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// clang-cc1-server keeps a Clang frontend resident and runs cc1 jobs that are
+// sent to it over a UNIX domain socket, so that builds with many small
+// compiles do not pay for process startup and target initialization each
+// time. Jobs run concurrently on a thread pool, each inside a
+// CrashRecoveryContext so that a crashing job does not take the server down.
+//
+//   clang-cc1-server -listen <socket> [-j <N>]
+//   clang-cc1-server -connect <socket> -- <cc1 arguments>
+//
+// The second form sends a single job to a running server, prints the job's
+// diagnostics and exits with its exit code. Build systems can speak the
+// protocol directly instead. All integers are little-endian; a request is
+//
+//   u32 count, count * (u32 length, bytes)
+//
+// whose first string is the working directory of the job and whose others
+// are the cc1 arguments, without the leading "-cc1". The response is
+//
+//   i32 exit code, u32 length, diagnostics text
+//
+// Options that rely on process-wide state, such as -ftime-trace,
+// -ftime-report and -print-stats, are not supported for concurrent jobs.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/Stack.h"
+#include "clang/CodeGen/ObjectFilePCHContainerOperations.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Frontend/CompilerInvocation.h"
+#include "clang/Frontend/TextDiagnosticBuffer.h"
+#include "clang/Frontend/TextDiagnosticPrinter.h"
+#include "clang/FrontendTool/Utils.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/CrashRecoveryContext.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/raw_socket_stream.h"
+
+using namespace clang;
+using namespace llvm;
+
+static cl::OptionCategory ServerCategory("clang-cc1-server options");
+
+static cl::opt<std::string>
+    ListenPath("listen", cl::desc("Serve cc1 jobs on the given UNIX socket"),
+               cl::value_desc("socket"), cl::cat(ServerCategory));
+
+static cl::opt<std::string>
+    ConnectPath("connect",
+                cl::desc("Send the cc1 job given after '--' to the server "
+                         "listening on the given UNIX socket"),
+                cl::value_desc("socket"), cl::cat(ServerCategory));
+
+static cl::opt<unsigned>
+    NumThreads("j", cl::desc("Number of jobs to run concurrently"),
+               cl::init(0), cl::cat(ServerCategory));
+
+static cl::list<std::string> JobArgs(cl::Positional, cl::ZeroOrMore,
+                                     cl::desc("<cc1 arguments>"),
+                                     cl::cat(ServerCategory));
+
+static std::string Argv0;
+static void *MainAddr;
+
+static bool readBytes(raw_socket_stream &S, char *Ptr, size_t Size) {
+  while (Size) {
+    ssize_t N = S.read(Ptr, Size);
+    if (N <= 0)
+      return false;
+    Ptr += N;
+    Size -= N;
+  }
+  return true;
+}
+
+static bool readU32(raw_socket_stream &S, uint32_t &Value) {
+  char Buf[4];
+  if (!readBytes(S, Buf, sizeof(Buf)))
+    return false;
+  Value = support::endian::read32le(Buf);
+  return true;
+}
+
+static bool readString(raw_socket_stream &S, std::string &Str) {
+  uint32_t Size;
+  if (!readU32(S, Size))
+    return false;
+  Str.resize(Size);
+  return readBytes(S, Str.data(), Size);
+}
+
+static void writeString(raw_ostream &OS, StringRef Str) {
+  support::endian::write<uint32_t>(OS, Str.size(), llvm::endianness::little);
+  OS << Str;
+}
+
+/// Run a single cc1 job, much like cc1_main does, but with the diagnostics
+/// written to \p DiagOS and the relative paths resolved against \p WorkingDir.
+static int runJob(StringRef WorkingDir, ArrayRef<std::string> Args,
+                  raw_ostream &DiagOS) {
+  SmallVector<const char *, 64> Argv;
+  Argv.push_back("-working-directory");
+  Argv.push_back(WorkingDir.data());
+  for (const std::string &Arg : Args)
+    Argv.push_back(Arg.c_str());
+
+  auto Clang = std::make_unique<CompilerInstance>();
+  auto PCHOps = Clang->getPCHContainerOperations();
+  PCHOps->registerWriter(std::make_unique<ObjectFilePCHContainerWriter>());
+  PCHOps->registerReader(std::make_unique<ObjectFilePCHContainerReader>());
+
+  IntrusiveRefCntPtr<DiagnosticIDs> DiagID(new DiagnosticIDs());
+  IntrusiveRefCntPtr<DiagnosticOptions> DiagOpts = new DiagnosticOptions();
+  TextDiagnosticBuffer *DiagsBuffer = new TextDiagnosticBuffer;
+  DiagnosticsEngine Diags(DiagID, &*DiagOpts, DiagsBuffer);
+  bool Success = CompilerInvocation::CreateFromArgs(Clang->getInvocation(),
+                                                    Argv, Diags, Argv0.c_str());
+
+  // The server outlives the job, so everything the job allocates must be
+  // released when it is done.
+  Clang->getFrontendOpts().DisableFree = false;
+  Clang->getCodeGenOpts().DisableFree = false;
+
+  if (Clang->getHeaderSearchOpts().UseBuiltinIncludes &&
+      Clang->getHeaderSearchOpts().ResourceDir.empty())
+    Clang->getHeaderSearchOpts().ResourceDir =
+        CompilerInvocation::GetResourcesPath(Argv0.c_str(), MainAddr);
+
+  Clang->createDiagnostics(
+      new TextDiagnosticPrinter(DiagOS, &Clang->getDiagnosticOpts()));
+  DiagsBuffer->FlushDiagnostics(Clang->getDiagnostics());
+  if (!Success) {
+    Clang->getDiagnosticClient().finish();
+    return 1;
+  }
+  return !ExecuteCompilerInvocation(Clang.get());
+}
+
+static void serveConnection(raw_socket_stream &S) {
+  uint32_t Count;
+  std::string WorkingDir;
+  if (!readU32(S, Count) || !Count || !readString(S, WorkingDir))
+    return;
+  std::vector<std::string> Args(Count - 1);
+  for (std::string &Arg : Args)
+    if (!readString(S, Arg))
+      return;
+
+  std::string Diagnostics;
+  raw_string_ostream DiagOS(Diagnostics);
+  int Result = 1;
+  CrashRecoveryContext CRC;
+  if (!CRC.RunSafely([&] { Result = runJob(WorkingDir, Args, DiagOS); })) {
+    DiagOS << "clang-cc1-server: the job crashed\n";
+    Result = CRC.RetCode ? CRC.RetCode : 1;
+  }
+
+  support::endian::write<int32_t>(S, Result, llvm::endianness::little);
+  writeString(S, DiagOS.str());
+  S.flush();
+}
+
+static int runServer() {
+  Expected<ListeningSocket> Socket = ListeningSocket::createUnix(ListenPath);
+  if (!Socket) {
+    errs() << "clang-cc1-server: cannot listen on " << ListenPath << ": "
+           << toString(Socket.takeError()) << '\n';
+    return 1;
+  }
+
+  llvm::InitializeAllTargets();
+  llvm::InitializeAllTargetMCs();
+  llvm::InitializeAllAsmPrinters();
+  llvm::InitializeAllAsmParsers();
+  CrashRecoveryContext::Enable();
+
+  DefaultThreadPool Pool(hardware_concurrency(NumThreads));
+  for (;;) {
+    Expected<std::unique_ptr<raw_socket_stream>> S = Socket->accept();
+    if (!S) {
+      errs() << "clang-cc1-server: " << toString(S.takeError()) << '\n';
+      break;
+    }
+    // ThreadPool tasks must be copyable.
+    std::shared_ptr<raw_socket_stream> Conn = std::move(*S);
+    Pool.async([Conn] { serveConnection(*Conn); });
+  }
+  Pool.wait();
+  return 1;
+}
+
+static int runClient() {
+  Expected<std::unique_ptr<raw_socket_stream>> S =
+      raw_socket_stream::createConnectedUnix(ConnectPath);
+  if (!S) {
+    errs() << "clang-cc1-server: cannot connect to " << ConnectPath << ": "
+           << toString(S.takeError()) << '\n';
+    return 1;
+  }
+
+  SmallString<256> WorkingDir;
+  if (std::error_code EC = sys::fs::current_path(WorkingDir)) {
+    errs() << "clang-cc1-server: " << EC.message() << '\n';
+    return 1;
+  }
+  support::endian::write<uint32_t>(**S, JobArgs.size() + 1,
+                                   llvm::endianness::little);
+  writeString(**S, WorkingDir);
+  for (const std::string &Arg : JobArgs)
+    writeString(**S, Arg);
+  (*S)->flush();
+
+  uint32_t Result;
+  std::string Diagnostics;
+  if (!readU32(**S, Result) || !readString(**S, Diagnostics)) {
+    errs() << "clang-cc1-server: lost connection to the server\n";
+    return 1;
+  }
+  errs() << Diagnostics;
+  return static_cast<int32_t>(Result);
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+  noteBottomOfStack();
+  cl::HideUnrelatedOptions(ServerCategory);
+  cl::ParseCommandLineOptions(argc, argv, "Clang cc1 compilation server\n");
+
+  MainAddr = (void *)(intptr_t)runServer;
+  Argv0 = sys::fs::getMainExecutable(argv[0], MainAddr);
+
+  if (!ListenPath.empty() == !ConnectPath.empty()) {
+    errs() << "clang-cc1-server: exactly one of -listen and -connect must be "
+              "given\n";
+    return 1;
+  }
+  return ListenPath.empty() ? runClient() : runServer();
+}
@@ -21,6 +21,7 @@
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/LineEditor/LineEditor.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/ManagedStatic.h" // llvm_shutdown
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/TargetSelect.h"
@@ -46,6 +47,19 @@ static llvm::cl::opt<bool> OptHostSupportsJit("host-supports-jit",
                                               llvm::cl::Hidden);
 static llvm::cl::list<std::string> OptInputs(llvm::cl::Positional,
                                              llvm::cl::desc("[code to run]"));
+static llvm::cl::opt<bool> OptLazyCompile(
+    "lazy-compile",
+    llvm::cl::desc("Compile functions when they are first called"));
+static llvm::cl::opt<bool>
+    OptPrintTiming("print-timing",
+                   llvm::cl::desc("Print the time spent on each input"));
+
+static void printTiming(const clang::Interpreter &Interp) {
+  const clang::InputTiming &T = Interp.getLastInputTiming();
+  llvm::errs() << llvm::format(
+      "parse+sema: %.1f ms, codegen: %.1f ms, jit+run: %.1f ms\n",
+      T.Frontend * 1000, T.CodeGen * 1000, T.Execute * 1000);
+}
 
 static void LLVMErrorHandler(void *UserData, const char *Message,
                              bool GenCrashDiag) {
@@ -215,12 +229,16 @@ int main(int argc, const char **argv) {
   } else
     Interp = ExitOnErr(clang::Interpreter::create(std::move(CI)));
 
+  Interp->setLazyCompilation(OptLazyCompile);
+
   bool HasError = false;
 
   for (const std::string &input : OptInputs) {
     if (auto Err = Interp->ParseAndExecute(input)) {
       llvm::logAllUnhandledErrors(std::move(Err), llvm::errs(), "error: ");
       HasError = true;
+    } else if (OptPrintTiming) {
+      printTiming(*Interp);
     }
   }
 
@@ -250,6 +268,8 @@ int main(int argc, const char **argv) {
           llvm::logAllUnhandledErrors(std::move(Err), llvm::errs(), "error: ");
       } else if (auto Err = Interp->ParseAndExecute(Input)) {
         llvm::logAllUnhandledErrors(std::move(Err), llvm::errs(), "error: ");
+      } else if (OptPrintTiming) {
+        printTiming(*Interp);
       }
 
       Input = "";
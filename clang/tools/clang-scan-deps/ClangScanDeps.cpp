@@ -8,6 +8,7 @@
 
 #include "clang/Driver/Compilation.h"
 #include "clang/Driver/Driver.h"
+#include "clang/DirectoryWatcher/DirectoryWatcher.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Tooling/CommonOptionsParser.h"
@@ -16,6 +17,7 @@
 #include "clang/Tooling/DependencyScanning/DependencyScanningWorker.h"
 #include "clang/Tooling/JSONCompilationDatabase.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileUtilities.h"
@@ -28,6 +30,7 @@
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/TargetParser/Host.h"
+#include <iostream>
 #include <mutex>
 #include <optional>
 #include <thread>
@@ -82,10 +85,12 @@ static unsigned NumThreads = 0;
 static std::string CompilationDB;
 static std::string ModuleName;
 static std::vector<std::string> ModuleDepTargets;
+static std::string DirectivesCachePath;
 static bool DeprecatedDriverCommand;
 static ResourceDirRecipeKind ResourceDirRecipe;
 static bool Verbose;
 static bool PrintTiming;
+static bool Watch;
 static std::vector<const char *> CommandLine;
 
 #ifndef NDEBUG
@@ -199,6 +204,9 @@ static void ParseArgs(int argc, char **argv) {
   for (const llvm::opt::Arg *A : Args.filtered(OPT_dependency_target_EQ))
     ModuleDepTargets.emplace_back(A->getValue());
 
+  if (const llvm::opt::Arg *A = Args.getLastArg(OPT_directives_cache_path_EQ))
+    DirectivesCachePath = A->getValue();
+
   DeprecatedDriverCommand = Args.hasArg(OPT_deprecated_driver_command);
 
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_resource_dir_recipe_EQ)) {
@@ -219,6 +227,12 @@ static void ParseArgs(int argc, char **argv) {
 
   PrintTiming = Args.hasArg(OPT_print_timing);
 
+  Watch = Args.hasArg(OPT_watch);
+  if (Watch && Format != ScanningOutputFormat::Make) {
+    llvm::errs() << ToolName << ": --watch requires --format=make\n";
+    std::exit(1);
+  }
+
   Verbose = Args.hasArg(OPT_verbose);
 
   RoundTripArgs = Args.hasArg(OPT_round_trip_args);
@@ -781,6 +795,219 @@ getCompilationDatabase(int argc, char **argv, std::string &ErrorMessage) {
       FEOpts.Inputs[0].getFile(), OutputFile, CommandLine);
 }
 
+namespace {
+/// Implements --watch. Watches the directories of the files each input
+/// depends on, and on request rescans only the inputs that may be affected by
+/// the changes seen since the previous scan. The commands, one per line on
+/// stdin, are:
+///
+///   changed  List the inputs that the next scan would rescan.
+///   scan     Rescan those inputs and print their dependency files.
+///   quit     Exit.
+///
+/// The reply to each command is terminated by a "# end" line.
+class WatchingScanner {
+public:
+  WatchingScanner(DependencyScanningService &Service,
+                  const std::vector<tooling::CompileCommand> &Inputs)
+      : Service(Service), Inputs(Inputs), Dirty(Inputs.size(), true),
+        FileDeps(Inputs.size()) {}
+
+  int run(SharedStream &DependencyOS, SharedStream &Errs);
+
+private:
+  void scan(SharedStream &DependencyOS, SharedStream &Errs);
+  void updateDependencies(size_t Index, std::vector<std::string> Deps);
+  void watchDirectory(StringRef Dir);
+  void handleEvents(StringRef Dir, ArrayRef<DirectoryWatcher::Event> Events,
+                    bool IsInitial);
+
+  DependencyScanningService &Service;
+  const std::vector<tooling::CompileCommand> &Inputs;
+
+  /// Protects the members below, which are also used by watcher threads.
+  std::mutex Lock;
+  /// Inputs that need to be rescanned.
+  std::vector<bool> Dirty;
+  /// The absolute paths of the files each input depends on.
+  std::vector<std::vector<std::string>> FileDeps;
+  /// The inputs that depend on each file.
+  llvm::StringMap<llvm::SmallVector<size_t, 1>> Dependents;
+  /// Files that changed since the last scan.
+  std::vector<std::string> ChangedFiles;
+  /// Watched directories whose watcher must be recreated.
+  llvm::StringSet<> InvalidatedDirs;
+
+  /// Only used from the main thread.
+  llvm::StringMap<std::unique_ptr<DirectoryWatcher>> Watchers;
+};
+} // namespace
+
+int WatchingScanner::run(SharedStream &DependencyOS, SharedStream &Errs) {
+  std::string Line;
+  while (std::getline(std::cin, Line)) {
+    StringRef Command = StringRef(Line).trim();
+    if (Command == "quit")
+      break;
+    if (Command == "scan") {
+      scan(DependencyOS, Errs);
+    } else if (Command == "changed") {
+      std::unique_lock<std::mutex> LockGuard(Lock);
+      DependencyOS.applyLocked([&](raw_ostream &OS) {
+        for (size_t I = 0, E = Inputs.size(); I != E; ++I)
+          if (Dirty[I])
+            OS << Inputs[I].Filename << '\n';
+      });
+    } else if (!Command.empty()) {
+      Errs.applyLocked([&](raw_ostream &OS) {
+        OS << "unknown command '" << Command << "'\n";
+      });
+    }
+    DependencyOS.applyLocked([](raw_ostream &OS) { OS << "# end\n"; });
+  }
+  return 0;
+}
+
+void WatchingScanner::scan(SharedStream &DependencyOS, SharedStream &Errs) {
+  std::vector<size_t> Pending;
+  std::vector<std::string> Changed;
+  {
+    std::unique_lock<std::mutex> LockGuard(Lock);
+    for (size_t I = 0, E = Inputs.size(); I != E; ++I)
+      if (Dirty[I]) {
+        Pending.push_back(I);
+        Dirty[I] = false;
+      }
+    Changed = std::move(ChangedFiles);
+    ChangedFiles.clear();
+    for (const auto &Dir : InvalidatedDirs)
+      Watchers.erase(Dir.getKey());
+    InvalidatedDirs.clear();
+  }
+  // Workers must not be scanning while the shared cache is updated.
+  Service.getSharedCache().invalidateFiles(Changed);
+
+  std::atomic<size_t> Next(0);
+  auto ScanningTask = [&]() {
+    DependencyScanningTool WorkerTool(Service);
+    for (size_t I; (I = Next++) < Pending.size();) {
+      const tooling::CompileCommand &Input = Inputs[Pending[I]];
+      std::vector<std::string> Deps;
+      auto MaybeFile =
+          WorkerTool.getDependencyFile(Input.CommandLine, Input.Directory, &Deps);
+      if (handleMakeDependencyToolResult(Input.Filename, MaybeFile,
+                                         DependencyOS, Errs)) {
+        // Retry with the next scan.
+        std::unique_lock<std::mutex> LockGuard(Lock);
+        Dirty[Pending[I]] = true;
+        continue;
+      }
+      for (std::string &Dep : Deps) {
+        SmallString<256> Path(Dep);
+        llvm::sys::fs::make_absolute(Input.Directory, Path);
+        llvm::sys::path::remove_dots(Path, /*remove_dot_dot=*/true);
+        Dep = std::string(Path);
+      }
+      updateDependencies(Pending[I], std::move(Deps));
+    }
+  };
+
+  if (Pending.size() <= 1) {
+    ScanningTask();
+  } else {
+    llvm::DefaultThreadPool Pool(llvm::hardware_concurrency(NumThreads));
+    for (unsigned I = 0; I < Pool.getMaxConcurrency(); ++I)
+      Pool.async(ScanningTask);
+    Pool.wait();
+  }
+
+  // Start watching the directories of new dependencies. Changes made to them
+  // before the watcher is set up are missed.
+  llvm::StringSet<> Dirs;
+  {
+    std::unique_lock<std::mutex> LockGuard(Lock);
+    for (size_t I : Pending)
+      for (StringRef Dep : FileDeps[I])
+        Dirs.insert(llvm::sys::path::parent_path(Dep));
+  }
+  for (const auto &Dir : Dirs)
+    if (!Watchers.count(Dir.getKey()))
+      watchDirectory(Dir.getKey());
+}
+
+void WatchingScanner::updateDependencies(size_t Index,
+                                         std::vector<std::string> Deps) {
+  std::unique_lock<std::mutex> LockGuard(Lock);
+  for (StringRef Dep : FileDeps[Index]) {
+    auto It = Dependents.find(Dep);
+    if (It != Dependents.end())
+      llvm::erase(It->second, Index);
+  }
+  for (StringRef Dep : Deps) {
+    auto &Users = Dependents[Dep];
+    if (!llvm::is_contained(Users, Index))
+      Users.push_back(Index);
+  }
+  FileDeps[Index] = std::move(Deps);
+}
+
+void WatchingScanner::watchDirectory(StringRef Dir) {
+  if (!llvm::sys::fs::is_directory(Dir))
+    return;
+  std::string DirName = Dir.str();
+  auto MaybeWatcher = DirectoryWatcher::create(
+      Dir,
+      [this, DirName](ArrayRef<DirectoryWatcher::Event> Events,
+                      bool IsInitial) {
+        handleEvents(DirName, Events, IsInitial);
+      },
+      /*WaitForInitialSync=*/true);
+  if (!MaybeWatcher) {
+    llvm::errs() << "cannot watch '" << Dir
+                 << "': " << llvm::toString(MaybeWatcher.takeError()) << '\n';
+    return;
+  }
+  Watchers[Dir] = std::move(*MaybeWatcher);
+}
+
+void WatchingScanner::handleEvents(StringRef Dir,
+                                   ArrayRef<DirectoryWatcher::Event> Events,
+                                   bool IsInitial) {
+  // The initial scan lists the existing files, which were just scanned.
+  if (IsInitial)
+    return;
+
+  using EventKind = DirectoryWatcher::Event::EventKind;
+  std::unique_lock<std::mutex> LockGuard(Lock);
+  for (const DirectoryWatcher::Event &Event : Events) {
+    if (Event.Kind == EventKind::WatchedDirRemoved ||
+        Event.Kind == EventKind::WatcherGotInvalidated) {
+      // Changes may have been missed.
+      InvalidatedDirs.insert(Dir);
+      ChangedFiles.push_back(Dir.str());
+      for (const auto &Entry : Dependents)
+        if (llvm::sys::path::parent_path(Entry.getKey()) == Dir)
+          ChangedFiles.push_back(Entry.getKey().str());
+      Dirty.assign(Dirty.size(), true);
+      continue;
+    }
+
+    SmallString<256> Path(Dir);
+    llvm::sys::path::append(Path, Event.Filename);
+    ChangedFiles.push_back(std::string(Path));
+    auto It = Dependents.find(Path);
+    if (It != Dependents.end()) {
+      for (size_t I : It->second)
+        Dirty[I] = true;
+      continue;
+    }
+    // A file nothing depends on appeared or went away. It may change which
+    // file an #include resolves to, so rescan everything; the unaffected
+    // files are still served from the cache.
+    Dirty.assign(Dirty.size(), true);
+  }
+}
+
 int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
   std::string ErrorMessage;
   std::unique_ptr<tooling::CompilationDatabase> Compilations =
@@ -985,6 +1212,10 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
 
   DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
                                     EagerLoadModules);
+  Service.getSharedCache().setDirectivesCachePath(DirectivesCachePath);
+
+  if (Watch)
+    return WatchingScanner(Service, Inputs).run(DependencyOS, Errs);
 
   llvm::Timer T;
   T.startTimer();
@@ -652,6 +652,24 @@ TEST_F(LexerTest, RawAndNormalLexSameForLineComments) {
   EXPECT_TRUE(ToksView.empty());
 }
 
+TEST_F(LexerTest, LongRawStringsAndLineComments) {
+  // Make the bodies long enough to exercise the block-wise scanning, and put
+  // the interesting characters at varying offsets within a block.
+  std::string Body;
+  for (unsigned I = 0; I != 64; ++I)
+    Body += std::string(I, 'x') + ")\"\xc3\xa9";
+  std::string Source = "R\"delim(" + Body + ")delim\";\n"
+                       "// " + Body + "\\\n still a comment\n"
+                       "// " + std::string(100, '-') + "\r\n"
+                       "int x;";
+  LangOpts.CPlusPlus11 = true;
+  std::vector<Token> Toks =
+      CheckLex(Source, {tok::string_literal, tok::semi, tok::kw_int,
+                        tok::identifier, tok::semi});
+  ASSERT_FALSE(Toks.empty());
+  EXPECT_EQ(Toks[0].getLength(), Body.size() + 15);
+}
+
 TEST(LexerPreambleTest, PreambleBounds) {
   std::vector<std::string> Cases = {
       R"cc([[
@@ -8,6 +8,7 @@
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "gtest/gtest.h"
 
@@ -174,3 +175,77 @@ TEST(DependencyScanningFilesystem, CacheStatOnExists) {
   EXPECT_EQ(InstrumentingFS->NumStatusCalls, 2u);
   EXPECT_EQ(InstrumentingFS->NumExistsCalls, 0u);
 }
+
+TEST(DependencyScanningFilesystem, DirectivesCache) {
+  llvm::SmallString<128> CacheDir;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("directives-cache", CacheDir));
+
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile("/foo.h", 0,
+                      llvm::MemoryBuffer::getMemBuffer(
+                          "#ifndef FOO\n#define FOO 1\n#include \"bar.h\"\n"
+                          "int x;\n#endif\n"));
+
+  // Each shared cache stands in for a separate scanning process.
+  auto Scan = [&](DependencyScanningFilesystemSharedCache &SharedCache) {
+    SharedCache.setDirectivesCachePath(CacheDir);
+    DependencyScanningWorkerFilesystem DepFS(SharedCache, InMemoryFS);
+    auto Entry = DepFS.getOrCreateFileSystemEntry("/foo.h");
+    EXPECT_TRUE(Entry);
+    EXPECT_TRUE(DepFS.ensureDirectiveTokensArePopulated(*Entry));
+    std::vector<std::pair<unsigned, std::string>> Result;
+    for (const auto &D : *Entry->getDirectiveTokens()) {
+      std::string Tokens;
+      for (const auto &T : D.Tokens)
+        Tokens += Entry->getContents().substr(T.Offset, T.Length).str() + " ";
+      Result.emplace_back(D.Kind, Tokens);
+    }
+    return Result;
+  };
+
+  DependencyScanningFilesystemSharedCache SharedCache1;
+  auto Directives1 = Scan(SharedCache1);
+  EXPECT_FALSE(Directives1.empty());
+
+  std::error_code EC;
+  unsigned NumCacheFiles = 0;
+  for (llvm::sys::fs::directory_iterator I(CacheDir, EC), E; I != E && !EC;
+       I.increment(EC))
+    ++NumCacheFiles;
+  EXPECT_EQ(NumCacheFiles, 1u);
+
+  DependencyScanningFilesystemSharedCache SharedCache2;
+  EXPECT_EQ(Scan(SharedCache2), Directives1);
+
+  llvm::sys::fs::remove_directories(CacheDir);
+}
+
+TEST(DependencyScanningFilesystem, InvalidateFiles) {
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile("/foo", 0, llvm::MemoryBuffer::getMemBuffer("a"));
+  InMemoryFS->addFile("/bar", 0, llvm::MemoryBuffer::getMemBuffer("b"));
+
+  auto InstrumentingFS =
+      llvm::makeIntrusiveRefCnt<InstrumentingFilesystem>(InMemoryFS);
+
+  DependencyScanningFilesystemSharedCache SharedCache;
+  {
+    DependencyScanningWorkerFilesystem DepFS(SharedCache, InstrumentingFS);
+    DepFS.status("/foo");
+    DepFS.status("/bar");
+    DepFS.status("/missing");
+  }
+  EXPECT_EQ(InstrumentingFS->NumStatusCalls, 3u);
+
+  SharedCache.invalidateFiles({"/foo", "/missing"});
+
+  DependencyScanningWorkerFilesystem DepFS(SharedCache, InstrumentingFS);
+  DepFS.status("/bar");
+  EXPECT_EQ(InstrumentingFS->NumStatusCalls, 3u); // Still cached.
+  DepFS.status("/foo");
+  DepFS.status("/missing");
+  EXPECT_EQ(InstrumentingFS->NumStatusCalls, 5u);
+}
@@ -68,6 +68,39 @@ TEST(AddressSanitizer, BorderAccessBenchmark) {
   delete [] char_7_array;
 }
 
+// Sum up an array in a loop without calls, which -asan-opt-hoist-loop-checks
+// checks once per outer iteration, and store to adjacent fields, which
+// -asan-opt-merge-checks checks together.
+struct Pair {
+  int first;
+  int second;
+};
+
+__attribute__((noinline))
+static int LoopAccessFunc(const int *x, Pair *pairs, size_t n_elements,
+                          size_t n_iter) {
+  int sum = 0;
+  for (size_t iter = 0; iter < n_iter; iter++) {
+    break_optimization(0);
+    for (size_t i = 0; i < n_elements; i++)
+      sum += x[i];
+    for (size_t i = 0; i < n_elements; i++) {
+      pairs[i].first = sum;
+      pairs[i].second = sum;
+    }
+  }
+  return sum;
+}
+
+TEST(AddressSanitizer, LoopAccessBenchmark) {
+  size_t kLen = 1024;
+  int *int_array = new int[kLen]();
+  Pair *pair_array = new Pair[kLen];
+  Ident(LoopAccessFunc(int_array, pair_array, kLen, 1 << 20));
+  delete [] pair_array;
+  delete [] int_array;
+}
+
 static void FunctionWithLargeStack() {
   int stack[1000];
   Ident(stack);
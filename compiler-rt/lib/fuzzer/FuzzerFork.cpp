@@ -14,6 +14,7 @@
 #include "FuzzerInternal.h"
 #include "FuzzerMerge.h"
 #include "FuzzerSHA1.h"
+#include "FuzzerSharedFeatures.h"
 #include "FuzzerTracePC.h"
 #include "FuzzerUtil.h"
 
@@ -93,6 +94,10 @@ struct GlobalEnv {
   std::string DFTDir;
   std::string DataFlowBinary;
   std::set<uint32_t> Features, Cov;
+  // With -fork_shared_features, the features found by all the jobs, which
+  // includes those that were not merged into Features yet.
+  SharedFeatureSet SharedFeatures;
+  std::string SharedFeaturesFile;
   std::set<std::string> FilesWithDFT;
   std::vector<std::string> Files;
   std::vector<std::size_t> FilesSizes;
@@ -111,6 +116,17 @@ struct GlobalEnv {
 
   std::string StopFile() { return DirPlusFile(TempDir, "STOP"); }
 
+  void InitSharedFeatures() {
+    SharedFeaturesFile = DirPlusFile(TempDir, "features.shm");
+    if (!SharedFeatures.Map(SharedFeaturesFile)) {
+      Printf("WARNING: -fork_shared_features is not supported here\n");
+      SharedFeaturesFile.clear();
+      return;
+    }
+    for (auto Ft : Features)
+      SharedFeatures.Insert(Ft);
+  }
+
   size_t secondsSinceProcessStartUp() const {
     return std::chrono::duration_cast<std::chrono::seconds>(
                std::chrono::system_clock::now() - ProcessStartTime)
@@ -129,6 +145,8 @@ struct GlobalEnv {
     Cmd.addFlag("print_funcs", "0");  // no need to spend time symbolizing.
     Cmd.addFlag("max_total_time", std::to_string(std::min((size_t)300, JobId)));
     Cmd.addFlag("stop_file", StopFile());
+    if (!SharedFeaturesFile.empty())
+      Cmd.addFlag("shared_features_file", SharedFeaturesFile);
     if (!DataFlowBinary.empty()) {
       Cmd.addFlag("data_flow_trace", DFTDir);
       if (!Cmd.hasFlag("focus_function"))
@@ -219,22 +237,26 @@ struct GlobalEnv {
         }
       }
     }
-    // if (!FilesToAdd.empty() || Job->ExitCode != 0)
-    Printf("#%zd: cov: %zd ft: %zd corp: %zd exec/s: %zd "
-           "oom/timeout/crash: %zd/%zd/%zd time: %zds job: %zd dft_time: %d\n",
-           NumRuns, Cov.size(), Features.size(), Files.size(),
-           Stats.average_exec_per_sec, NumOOMs, NumTimeouts, NumCrashes,
-           secondsSinceProcessStartUp(), Job->JobId, Job->DftTimeInSeconds);
-
-    if (MergeCandidates.empty()) return;
 
     std::vector<std::string> FilesToAdd;
     std::set<uint32_t> NewFeatures, NewCov;
-    bool IsSetCoverMerge =
-        !Job->Cmd.getFlagValue("set_cover_merge").compare("1");
-    CrashResistantMerge(Args, {}, MergeCandidates, &FilesToAdd, Features,
-                        &NewFeatures, Cov, &NewCov, Job->CFPath, false,
-                        IsSetCoverMerge);
+    if (!MergeCandidates.empty()) {
+      bool IsSetCoverMerge =
+          !Job->Cmd.getFlagValue("set_cover_merge").compare("1");
+      CrashResistantMerge(Args, {}, MergeCandidates, &FilesToAdd, Features,
+                          &NewFeatures, Cov, &NewCov, Job->CFPath, false,
+                          IsSetCoverMerge);
+    }
+
+    // 'new' is the number of inputs from this job that made it into the
+    // corpus, out of those it saved.
+    Printf("#%zd: cov: %zd ft: %zd corp: %zd exec/s: %zd "
+           "oom/timeout/crash: %zd/%zd/%zd time: %zds job: %zd dft_time: %d "
+           "new: %zd/%zd\n",
+           NumRuns, Cov.size(), Features.size(), Files.size(),
+           Stats.average_exec_per_sec, NumOOMs, NumTimeouts, NumCrashes,
+           secondsSinceProcessStartUp(), Job->JobId, Job->DftTimeInSeconds,
+           FilesToAdd.size(), TempFiles.size());
     for (auto &Path : FilesToAdd) {
       auto U = FileToVector(Path);
       auto NewPath = DirPlusFile(MainCorpusDir, Hash(U));
@@ -252,6 +274,9 @@ struct GlobalEnv {
     }
     Features.insert(NewFeatures.begin(), NewFeatures.end());
     Cov.insert(NewCov.begin(), NewCov.end());
+    if (SharedFeatures.IsMapped())
+      for (auto Ft : NewFeatures)
+        SharedFeatures.Insert(Ft);
     for (auto Idx : NewCov)
       if (auto *TE = TPC.PCTableEntryByIdx(Idx))
         if (TPC.PcIsFuncEntry(TE))
@@ -358,6 +383,9 @@ void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
       Env.FilesSizes.push_back(FileSize(path));
   }
 
+  if (Options.ForkSharedFeatures)
+    Env.InitSharedFeatures();
+
   Printf("INFO: -fork=%d: %zd seed inputs, starting to fuzz in %s\n", NumJobs,
          Env.Files.size(), Env.TempDir.c_str());
 
@@ -111,6 +111,11 @@ intptr_t GetHandleFromFd(int fd);
 void MkDir(const std::string &Path);
 void RmDir(const std::string &Path);
 
+// Maps Size bytes of the file at Path, creating or extending it as needed, so
+// that writes are seen by every process mapping it. Returns nullptr on failure
+// or where this is not supported.
+void *MapSharedFile(const std::string &Path, size_t Size);
+
 const std::string &getDevNull();
 
 }  // namespace fuzzer
@@ -17,7 +17,9 @@
 #include <dirent.h>
 #include <fstream>
 #include <iterator>
+#include <fcntl.h>
 #include <libgen.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -161,6 +163,20 @@ void RawPrint(const char *Str) {
   (void)write(2, Str, strlen(Str));
 }
 
+void *MapSharedFile(const std::string &Path, size_t Size) {
+  int Fd = open(Path.c_str(), O_RDWR | O_CREAT, 0600);
+  if (Fd < 0)
+    return nullptr;
+  struct stat St;
+  if (fstat(Fd, &St) || ((size_t)St.st_size < Size && ftruncate(Fd, Size))) {
+    close(Fd);
+    return nullptr;
+  }
+  void *Ptr = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+  close(Fd);
+  return Ptr == MAP_FAILED ? nullptr : Ptr;
+}
+
 void MkDir(const std::string &Path) {
   mkdir(Path.c_str(), 0700);
 }
@@ -401,6 +401,11 @@ void RawPrint(const char *Str) {
   _write(2, Str, strlen(Str));
 }
 
+void *MapSharedFile(const std::string &Path, size_t Size) {
+  // Not supported yet.
+  return nullptr;
+}
+
 void MkDir(const std::string &Path) {
   if (CreateDirectoryA(Path.c_str(), nullptr)) return;
   Printf("CreateDirectoryA failed for %s (Error code: %lu).\n", Path.c_str(),
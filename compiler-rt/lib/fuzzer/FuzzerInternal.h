@@ -17,6 +17,7 @@
 #include "FuzzerInterface.h"
 #include "FuzzerOptions.h"
 #include "FuzzerSHA1.h"
+#include "FuzzerSharedFeatures.h"
 #include "FuzzerValueBitMap.h"
 #include <algorithm>
 #include <atomic>
@@ -108,6 +109,7 @@ private:
                   size_t Features = 0);
   void PrintStatusForNewUnit(const Unit &U, const char *Text);
   void CheckExitOnSrcPosOrItem();
+  bool ClaimSharedFeatures(const std::vector<uint32_t> &Features);
 
   static void StaticDeathCallback();
   void DumpCurrentUnit(const char *Prefix);
@@ -123,6 +125,11 @@ private:
   size_t TotalNumberOfRuns = 0;
   size_t NumberOfNewUnitsAdded = 0;
 
+  // The features found by all the jobs in -fork mode, and whether every
+  // feature of the last unit added to the corpus was already in it.
+  SharedFeatureSet SharedFeatures;
+  bool LastUnitFoundElsewhere = false;
+
   size_t LastCorpusUpdateRun = 0;
 
   bool HasMoreMallocsThanFrees = false;
@@ -0,0 +1,59 @@
+//===- FuzzerSharedFeatures.h - Features shared across processes -*- C++ -* ===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+// SharedFeatureSet.
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_FUZZER_SHARED_FEATURES_H
+#define LLVM_FUZZER_SHARED_FEATURES_H
+
+#include "FuzzerIO.h"
+#include <atomic>
+#include <cstdint>
+
+namespace fuzzer {
+
+// A bit per feature, in a file mapped by the parent and every job of -fork
+// mode, so that all of them see which features were found so far. The bits
+// are set atomically, so exactly one process claims each feature.
+class SharedFeatureSet {
+  // Same as InputCorpus::kFeatureSetSize.
+  static const size_t kMapSizeInBits = 1 << 21;
+  static const size_t kBitsInWord = 64;
+  static const size_t kMapSizeInWords = kMapSizeInBits / kBitsInWord;
+  static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+                "shared words need to have the same layout in every process");
+
+ public:
+  // Maps the set from Path, creating it if it does not exist yet. Returns
+  // false if the set cannot be shared on this platform.
+  bool Map(const std::string &Path) {
+    Words = static_cast<std::atomic<uint64_t> *>(
+        MapSharedFile(Path, kMapSizeInWords * sizeof(uint64_t)));
+    return Words != nullptr;
+  }
+
+  bool IsMapped() const { return Words != nullptr; }
+
+  // Sets the bit of Feature. Returns true if it was not set before by any
+  // process.
+  bool Insert(uint32_t Feature) {
+    uint32_t Idx = Feature % kMapSizeInBits;
+    uint64_t Bit = 1ULL << (Idx % kBitsInWord);
+    auto &Word = Words[Idx / kBitsInWord];
+    if (Word.load(std::memory_order_relaxed) & Bit)
+      return false;
+    return !(Word.fetch_or(Bit, std::memory_order_relaxed) & Bit);
+  }
+
+ private:
+  std::atomic<uint64_t> *Words = nullptr;
+};
+
+}  // namespace fuzzer
+
+#endif  // LLVM_FUZZER_SHARED_FEATURES_H
@@ -92,6 +92,9 @@ static lprofFilename lprofCurFilename = {0,   0, 0, {0}, NULL,
                                          {0}, 0, 0, 0,   PNS_unknown};
 
 static int ProfileMergeRequested = 0;
+/* Offset added to the PID to pick the file of the merge pool. It is only
+ * non-zero while openPoolFileEx looks for a pool file that is not locked. */
+static unsigned ProfilePoolIdOffset = 0;
 static int getProfileFileSizeForMerging(FILE *ProfileFile,
                                         uint64_t *ProfileFileSize);
 
@@ -460,6 +463,36 @@ static void createProfileDir(const char *Filename) {
   }
 }
 
+/* Open \p ProfileFileName with lprofOpenFileEx. With a merge pool of more
+ * than one file (%Nm), first try the files of the pool in turn, starting
+ * with the one picked by the PID, and take the first one that no other
+ * process holds the lock of. Many processes exiting at the same time then
+ * spread over the pool instead of queueing on the lock of a single file.
+ * Block on \p ProfileFileName only if every file of the pool is busy. */
+static FILE *openPoolFileEx(const char *ProfileFileName) {
+  FILE *File;
+  unsigned I;
+
+  if (lprofCurFilename.MergePoolSize <= 1)
+    return lprofOpenFileEx(ProfileFileName);
+
+  int Length = getCurFilenameLength();
+  char *FilenameBuf = (char *)COMPILER_RT_ALLOCA(Length + 1);
+  for (I = 0; I < lprofCurFilename.MergePoolSize; ++I) {
+    ProfilePoolIdOffset = I;
+    const char *Filename = getCurFilename(FilenameBuf, 0);
+    if (!Filename)
+      break;
+    File = lprofTryOpenFileEx(Filename);
+    if (File) {
+      ProfilePoolIdOffset = 0;
+      return File;
+    }
+  }
+  ProfilePoolIdOffset = 0;
+  return lprofOpenFileEx(ProfileFileName);
+}
+
 /* Open the profile data for merging. It opens the file in r+b mode with
  * file locking.  If the file has content which is compatible with the
  * current process, it also reads in the profile data in the file and merge
@@ -479,7 +512,7 @@ static FILE *openFileForMerging(const char *ProfileFileName, int *MergeDone) {
   }
   if (!ProfileFile) {
     createProfileDir(ProfileFileName);
-    ProfileFile = lprofOpenFileEx(ProfileFileName);
+    ProfileFile = openPoolFileEx(ProfileFileName);
   }
   if (!ProfileFile)
     return NULL;
@@ -640,7 +673,7 @@ static void initializeProfileForContinuousMode(void) {
      * the profile, i.e. into each participating process. An increment in one
      * process should be visible to every other process with the same counter
      * section mapped. */
-    File = lprofOpenFileEx(Filename);
+    File = openPoolFileEx(Filename);
     if (!File)
       return;
 
@@ -960,7 +993,8 @@ static const char *getCurFilename(char *FilenameBuf, int ForceUseBuf) {
           continue;
         char LoadModuleSignature[SIGLEN + 1];
         int S;
-        int ProfilePoolId = getpid() % lprofCurFilename.MergePoolSize;
+        int ProfilePoolId = (getpid() + ProfilePoolIdOffset) %
+                            lprofCurFilename.MergePoolSize;
         S = snprintf(LoadModuleSignature, SIGLEN + 1, "%" PRIu64 "_%d",
                      lprofGetLoadModuleSignature(), ProfilePoolId);
         if (S == -1 || S > SIGLEN)
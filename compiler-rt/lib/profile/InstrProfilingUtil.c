@@ -158,6 +158,28 @@ COMPILER_RT_VISIBILITY int lprofLockFd(int fd) {
 #endif
 }
 
+COMPILER_RT_VISIBILITY int lprofTryLockFd(int fd) {
+#ifdef COMPILER_RT_HAS_FCNTL_LCK
+  struct flock s_flock;
+
+  s_flock.l_whence = SEEK_SET;
+  s_flock.l_start = 0;
+  s_flock.l_len = 0; /* Until EOF.  */
+  s_flock.l_pid = getpid();
+  s_flock.l_type = F_WRLCK;
+
+  while (fcntl(fd, F_SETLK, &s_flock) == -1) {
+    if (errno == EACCES || errno == EAGAIN)
+      return 1;
+    if (errno != EINTR)
+      return -1;
+  }
+  return 0;
+#else
+  return flock(fd, LOCK_EX | LOCK_NB) == 0 ? 0 : 1;
+#endif
+}
+
 COMPILER_RT_VISIBILITY int lprofUnlockFd(int fd) {
 #ifdef COMPILER_RT_HAS_FCNTL_LCK
   struct flock s_flock;
@@ -203,7 +225,7 @@ COMPILER_RT_VISIBILITY int lprofUnlockFileHandle(FILE *F) {
   return lprofUnlockFd(fd);
 }
 
-COMPILER_RT_VISIBILITY FILE *lprofOpenFileEx(const char *ProfileName) {
+static FILE *openFileEx(const char *ProfileName, int Wait) {
   FILE *f;
   int fd;
 #ifdef COMPILER_RT_HAS_FCNTL_LCK
@@ -211,7 +233,12 @@ COMPILER_RT_VISIBILITY FILE *lprofOpenFileEx(const char *ProfileName) {
   if (fd < 0)
     return NULL;
 
-  if (lprofLockFd(fd) != 0)
+  if (!Wait) {
+    if (lprofTryLockFd(fd) != 0) {
+      close(fd);
+      return NULL;
+    }
+  } else if (lprofLockFd(fd) != 0)
     PROF_WARN("Data may be corrupted during profile merging : %s\n",
               "Fail to obtain file lock due to system limit.");
 
@@ -230,7 +257,12 @@ COMPILER_RT_VISIBILITY FILE *lprofOpenFileEx(const char *ProfileName) {
     return NULL;
   }
 
-  if (lprofLockFd(fd) != 0)
+  if (!Wait) {
+    if (lprofTryLockFd(fd) != 0) {
+      _close(fd);
+      return NULL;
+    }
+  } else if (lprofLockFd(fd) != 0)
     PROF_WARN("Data may be corrupted during profile merging : %s\n",
               "Fail to obtain file lock due to system limit.");
 
@@ -241,6 +273,7 @@ COMPILER_RT_VISIBILITY FILE *lprofOpenFileEx(const char *ProfileName) {
   }
 #else
   /* Worst case no locking applied.  */
+  (void)Wait;
   PROF_WARN("Concurrent file access is not supported : %s\n",
             "lack file locking");
   fd = open(ProfileName, O_RDWR | O_CREAT, 0666);
@@ -252,6 +285,14 @@ COMPILER_RT_VISIBILITY FILE *lprofOpenFileEx(const char *ProfileName) {
   return f;
 }
 
+COMPILER_RT_VISIBILITY FILE *lprofOpenFileEx(const char *ProfileName) {
+  return openFileEx(ProfileName, /*Wait=*/1);
+}
+
+COMPILER_RT_VISIBILITY FILE *lprofTryOpenFileEx(const char *ProfileName) {
+  return openFileEx(ProfileName, /*Wait=*/0);
+}
+
 COMPILER_RT_VISIBILITY const char *lprofGetPathPrefix(int *PrefixStrip,
                                                       size_t *PrefixLen) {
   const char *Prefix = getenv("GCOV_PREFIX");
@@ -23,6 +23,9 @@ void __llvm_profile_set_dir_mode(unsigned Mode);
 unsigned __llvm_profile_get_dir_mode(void);
 
 int lprofLockFd(int fd);
+/*! Take the write lock of \c fd without waiting. Return 0 if the lock was
+ * taken, 1 if another process holds it and -1 on error. */
+int lprofTryLockFd(int fd);
 int lprofUnlockFd(int fd);
 int lprofLockFileHandle(FILE *F);
 int lprofUnlockFileHandle(FILE *F);
@@ -31,6 +34,9 @@ int lprofUnlockFileHandle(FILE *F);
  * lock for exclusive access. The caller will block
  * if the lock is already held by another process. */
 FILE *lprofOpenFileEx(const char *Filename);
+/*! Same as lprofOpenFileEx, but return NULL instead of blocking if the
+ * lock is already held by another process. */
+FILE *lprofTryOpenFileEx(const char *Filename);
 /* PS4 doesn't have setenv/getenv/fork. Define a shim. */
 #if __ORBIS__
 #include <sys/types.h>
@@ -62,6 +62,35 @@ class MurMur2Hash64Builder {
     return x;
   }
 };
+
+// Hashes arrays of words in four interleaved MurMur2Hash64Builder lanes, so
+// that the multiplications for consecutive words don't wait for each other.
+// This does not compute the same hash as a single MurMur2Hash64Builder.
+class MurMur2Hash64ArrayBuilder {
+  MurMur2Hash64Builder h0, h1, h2, h3;
+
+ public:
+  explicit MurMur2Hash64ArrayBuilder(u64 init = 0)
+      : h0(init), h1(init + 1), h2(init + 2), h3(init + 3) {}
+  void add(const uptr *data, uptr size) {
+    uptr i = 0;
+    for (; i + 4 <= size; i += 4) {
+      h0.add(data[i]);
+      h1.add(data[i + 1]);
+      h2.add(data[i + 2]);
+      h3.add(data[i + 3]);
+    }
+    for (; i < size; i++) h0.add(data[i]);
+  }
+  void add(u64 k) { h0.add(k); }
+  u64 get() {
+    MurMur2Hash64Builder h(h0.get());
+    h.add(h1.get());
+    h.add(h2.get());
+    h.add(h3.get());
+    return h.get();
+  }
+};
 }  // namespace __sanitizer
 
 #endif  // SANITIZER_HASH_H
@@ -35,8 +35,8 @@ struct StackDepotNode {
   }
   static uptr allocated();
   static hash_type hash(const args_type &args) {
-    MurMur2Hash64Builder H(args.size * sizeof(uptr));
-    for (uptr i = 0; i < args.size; i++) H.add(args.trace[i]);
+    MurMur2Hash64ArrayBuilder H(args.size * sizeof(uptr));
+    H.add(args.trace, args.size);
     H.add(args.tag);
     return H.get();
   }
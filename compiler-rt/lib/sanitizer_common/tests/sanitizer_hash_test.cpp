@@ -45,4 +45,22 @@ TEST(SanitizerCommon, Hash64Add) {
   EXPECT_EQ(h.get(), 10843188204560467446ull);
 }
 
+TEST(SanitizerCommon, Hash64Array) {
+  uptr data[123];
+  for (u32 i = 0; i < 123; ++i) data[i] = i;
+  MurMur2Hash64ArrayBuilder h(123 * sizeof(u64));
+  h.add(data, 123);
+  EXPECT_EQ(h.get(), 9833603187787433769ull);
+  h.add(data, 3);
+  EXPECT_EQ(h.get(), 12401434918387662232ull);
+
+  // Words hashed in different lanes must not commute.
+  uptr a[4] = {1, 2, 3, 4};
+  uptr b[4] = {2, 1, 3, 4};
+  MurMur2Hash64ArrayBuilder ha, hb;
+  ha.add(a, 4);
+  hb.add(b, 4);
+  EXPECT_NE(ha.get(), hb.get());
+}
+
 }  // namespace __sanitizer
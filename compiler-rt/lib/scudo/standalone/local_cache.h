@@ -11,6 +11,7 @@
 
 #include "internal_defs.h"
 #include "list.h"
+#include "options.h"
 #include "platform.h"
 #include "report.h"
 #include "stats.h"
@@ -41,6 +42,7 @@ template <class SizeClassAllocator> struct SizeClassAllocatorLocalCache {
     DCHECK_LT(ClassId, NumClasses);
     PerClass *C = &PerClassArray[ClassId];
     if (C->Count == 0) {
+      noteRefillOrDrain(C, ClassId, /*IsDrain=*/false);
       // Refill half of the number of max cached.
       DCHECK_GT(C->MaxCount / 2, 0U);
       if (UNLIKELY(!refill(C, ClassId, C->MaxCount / 2)))
@@ -63,8 +65,10 @@ template <class SizeClassAllocator> struct SizeClassAllocatorLocalCache {
 
     // If the cache is full, drain half of blocks back to the main allocator.
     const bool NeedToDrainCache = C->Count == C->MaxCount;
-    if (NeedToDrainCache)
+    if (NeedToDrainCache) {
+      noteRefillOrDrain(C, ClassId, /*IsDrain=*/true);
       drain(C, ClassId);
+    }
     // See comment in allocate() about memory accesses.
     const uptr ClassSize = C->ClassSize;
     C->Chunks[C->Count++] =
@@ -107,7 +111,8 @@ template <class SizeClassAllocator> struct SizeClassAllocatorLocalCache {
   void getStats(ScopedString *Str) {
     bool EmptyCache = true;
     for (uptr I = 0; I < NumClasses; ++I) {
-      if (PerClassArray[I].Count == 0)
+      if (PerClassArray[I].Count == 0 && PerClassArray[I].Refills == 0 &&
+          PerClassArray[I].Drains == 0)
         continue;
 
       EmptyCache = false;
@@ -118,15 +123,21 @@ template <class SizeClassAllocator> struct SizeClassAllocatorLocalCache {
                                  : PerClassArray[I].ClassSize;
       // Note that the string utils don't support printing u16 thus we cast it
       // to a common use type uptr.
-      Str->append("    %02zu (%6zu): cached: %4zu max: %4zu\n", I, ClassSize,
-                  static_cast<uptr>(PerClassArray[I].Count),
-                  static_cast<uptr>(PerClassArray[I].MaxCount));
+      Str->append("    %02zu (%6zu): cached: %4zu max: %4zu refills: %zu "
+                  "drains: %zu\n",
+                  I, ClassSize, static_cast<uptr>(PerClassArray[I].Count),
+                  static_cast<uptr>(PerClassArray[I].MaxCount),
+                  PerClassArray[I].Refills, PerClassArray[I].Drains);
     }
 
     if (EmptyCache)
       Str->append("    No block is cached.\n");
   }
 
+  u16 getMaxCountTestOnly(uptr ClassId) const {
+    return PerClassArray[ClassId].MaxCount;
+  }
+
   static u16 getMaxCached(uptr Size) {
     return Min(SizeClassMap::MaxNumCachedHint,
                SizeClassMap::getMaxCachedHint(Size));
@@ -135,12 +146,25 @@ template <class SizeClassAllocator> struct SizeClassAllocatorLocalCache {
 private:
   static const uptr NumClasses = SizeClassMap::NumClasses;
   static const uptr BatchClassId = SizeClassMap::BatchClassId;
+  // With the adaptive_caches flag, the cache of a class that keeps going
+  // from full to empty and back is made larger, up to 2^MaxGrowthLog times its
+  // initial size and at most the size of Chunks.
+  static const u16 ThrashThreshold = 16;
+  static const u16 MaxGrowthLog = 2;
+  static const u16 CapacityPerClass = 2 * SizeClassMap::MaxNumCachedHint;
   struct alignas(SCUDO_CACHE_LINE_SIZE) PerClass {
     u16 Count;
     u16 MaxCount;
+    // Number of times the cache went from full to empty or the other way
+    // since MaxCount was last considered for growth.
+    u16 Thrashes;
+    bool LastWasDrain;
     // Note: ClassSize is zero for the transfer batch.
     uptr ClassSize;
-    CompactPtrT Chunks[2 * SizeClassMap::MaxNumCachedHint];
+    // Number of refills from an empty cache and of drains from a full one.
+    uptr Refills;
+    uptr Drains;
+    CompactPtrT Chunks[CapacityPerClass];
   };
   PerClass PerClassArray[NumClasses] = {};
   LocalStats Stats;
@@ -161,6 +185,32 @@ private:
     }
   }
 
+  void noteRefillOrDrain(PerClass *C, uptr ClassId, bool IsDrain) {
+    if (IsDrain)
+      ++C->Drains;
+    else
+      ++C->Refills;
+    // A drain right after a refill, or a refill right after a drain, means
+    // that the cache is too small for the pattern of this class.
+    if (C->LastWasDrain != IsDrain && C->Refills != 0 && C->Drains != 0 &&
+        ++C->Thrashes >= ThrashThreshold) {
+      C->Thrashes = 0;
+      growMaxCount(C, ClassId);
+    }
+    C->LastWasDrain = IsDrain;
+  }
+
+  NOINLINE void growMaxCount(PerClass *C, uptr ClassId) {
+    if (ClassId == BatchClassId ||
+        !Allocator->Options.load().get(OptionBit::AdaptiveCaches))
+      return;
+    const u16 InitialMaxCount = static_cast<u16>(
+        2 * getMaxCached(SizeClassAllocator::getSizeByClassId(ClassId)));
+    const u16 Limit = static_cast<u16>(
+        Min<uptr>(CapacityPerClass, uptr(InitialMaxCount) << MaxGrowthLog));
+    C->MaxCount = static_cast<u16>(Min<uptr>(Limit, 2 * uptr(C->MaxCount)));
+  }
+
   void destroyBatch(uptr ClassId, void *B) {
     if (ClassId != BatchClassId)
       deallocate(BatchClassId, B);
@@ -74,6 +74,11 @@ static void *mmapWrapper(uptr Addr, uptr Size, const char *Name, uptr Flags) {
 #else
   (void)Name;
 #endif
+#if defined(MADV_HUGEPAGE)
+  // This is only a hint, transparent huge pages may be disabled.
+  if (Flags & MAP_HUGEPAGE)
+    madvise(P, Size, MADV_HUGEPAGE);
+#endif
 
   return P;
 }
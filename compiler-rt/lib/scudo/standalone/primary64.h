@@ -355,6 +355,7 @@ public:
   void getStats(ScopedString *Str) {
     // TODO(kostyak): get the RSS per region.
     uptr TotalMapped = 0;
+    uptr MappedHugePages = 0;
     uptr PoppedBlocks = 0;
     uptr PushedBlocks = 0;
     for (uptr I = 0; I < NumClasses; I++) {
@@ -362,6 +363,8 @@ public:
       {
         ScopedLock L(Region->MMLock);
         TotalMapped += Region->MemMapInfo.MappedUser;
+        if (Config::getEnableHugePages())
+          MappedHugePages += getMappedHugePages(Region);
       }
       {
         ScopedLock L(Region->FLLock);
@@ -374,6 +377,13 @@ public:
                 "allocations; remains %zu; ReleaseToOsIntervalMs = %d\n",
                 TotalMapped >> 20, 0U, PoppedBlocks,
                 PoppedBlocks - PushedBlocks, IntervalMs >= 0 ? IntervalMs : -1);
+    if (Config::getEnableHugePages()) {
+      Str->append("  Huge pages: %zu mapped (%zuM, %zu%% of mapped)\n",
+                  MappedHugePages, (MappedHugePages * HugePageSize) >> 20,
+                  TotalMapped ? MappedHugePages * HugePageSize * 100 /
+                                    TotalMapped
+                              : 0U);
+    }
 
     for (uptr I = 0; I < NumClasses; I++) {
       RegionInfo *Region = getRegionInfo(I);
@@ -513,6 +523,9 @@ private:
   static const uptr NumClasses = SizeClassMap::NumClasses;
 
   static const uptr MapSizeIncrement = Config::getMapSizeIncrement();
+  // The size of a transparent huge page mapped at the PMD level with 4K pages,
+  // used when `EnableHugePages` is set.
+  static const uptr HugePageSize = 1UL << 21;
   // Fill at most this number of batches from the newly map'd memory.
   static const u32 MaxNumBatches = SCUDO_ANDROID ? 4U : 8U;
 
@@ -520,6 +533,9 @@ private:
     uptr BytesInFreeListAtLastCheckpoint;
     uptr RangesReleased;
     uptr LastReleasedBytes;
+    // Only updated when `EnableHugePages` is set.
+    uptr HugePagesReleased;
+    uptr LastRetainedBytes;
     u64 LastReleaseAtNs;
   };
 
@@ -1041,19 +1057,28 @@ private:
     // Map more space for blocks, if necessary.
     if (TotalUserBytes > MappedUser) {
       // Do the mmap for the user memory.
-      const uptr MapSize =
-          roundUp(TotalUserBytes - MappedUser, MapSizeIncrement);
+      uptr MapSize = roundUp(TotalUserBytes - MappedUser, MapSizeIncrement);
       const uptr RegionBase = RegionBeg - getRegionBaseByClassId(ClassId);
       if (UNLIKELY(RegionBase + MappedUser + MapSize > RegionSize)) {
         Region->Exhausted = true;
         return 0U;
       }
+      uptr MapFlags = MAP_ALLOWNOMEM | MAP_RESIZABLE |
+                      (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG
+                                                                : 0);
+      if (Config::getEnableHugePages()) {
+        // Extend the mapping up to the next huge page boundary, so that every
+        // huge page of the region but the first one is mapped as a whole.
+        const uptr RegionEnd = RegionBeg - RegionBase + RegionSize;
+        const uptr MapEnd =
+            Min(roundUp(RegionBeg + MappedUser + MapSize, HugePageSize),
+                RegionEnd);
+        MapSize = MapEnd - (RegionBeg + MappedUser);
+        MapFlags |= MAP_HUGEPAGE;
+      }
 
       if (UNLIKELY(!Region->MemMapInfo.MemMap.remap(
-              RegionBeg + MappedUser, MapSize, "scudo:primary",
-              MAP_ALLOWNOMEM | MAP_RESIZABLE |
-                  (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG
-                                                            : 0)))) {
+              RegionBeg + MappedUser, MapSize, "scudo:primary", MapFlags))) {
         return 0U;
       }
       Region->MemMapInfo.MappedUser += MapSize;
@@ -1145,6 +1170,23 @@ private:
         Region->ReleaseInfo.LastReleasedBytes >> 10,
         RegionPushedBytesDelta >> 10, Region->RegionBeg,
         getRegionBaseByClassId(ClassId));
+    if (Config::getEnableHugePages()) {
+      Str->append("      huge pages: mapped: %6zu released: %6zu last "
+                  "retained: %6zuK\n",
+                  getMappedHugePages(Region),
+                  Region->ReleaseInfo.HugePagesReleased,
+                  Region->ReleaseInfo.LastRetainedBytes >> 10);
+    }
+  }
+
+  // Returns the number of huge pages entirely covered by the user memory
+  // mapped in the region, i.e., the ones which may be backed by a transparent
+  // huge page.
+  uptr getMappedHugePages(RegionInfo *Region) REQUIRES(Region->MMLock) {
+    const uptr Beg = roundUp(Region->RegionBeg, HugePageSize);
+    const uptr End = roundDown(
+        Region->RegionBeg + Region->MemMapInfo.MappedUser, HugePageSize);
+    return End > Beg ? (End - Beg) / HugePageSize : 0;
   }
 
   void getRegionFragmentationInfo(RegionInfo *Region, uptr ClassId,
@@ -1259,9 +1301,12 @@ private:
     // ==================================================================== //
     // 4. Release the unused physical pages back to the OS.
     // ==================================================================== //
-    RegionReleaseRecorder<MemMapT> Recorder(&Region->MemMapInfo.MemMap,
-                                            Region->RegionBeg,
-                                            Context.getReleaseOffset());
+    // With huge pages, only the ones which are entirely free are released so
+    // that the others are not split.
+    RegionReleaseRecorder<MemMapT> Recorder(
+        &Region->MemMapInfo.MemMap, Region->RegionBeg,
+        Context.getReleaseOffset(),
+        Config::getEnableHugePages() ? HugePageSize : 0U);
     auto SkipRegion = [](UNUSED uptr RegionIndex) { return false; };
     releaseFreeMemoryToOS(Context, Recorder, SkipRegion);
     if (Recorder.getReleasedRangesCount() > 0) {
@@ -1269,6 +1314,11 @@ private:
       Region->ReleaseInfo.RangesReleased += Recorder.getReleasedRangesCount();
       Region->ReleaseInfo.LastReleasedBytes = Recorder.getReleasedBytes();
     }
+    if (Config::getEnableHugePages()) {
+      Region->ReleaseInfo.HugePagesReleased +=
+          Recorder.getReleasedBytes() / HugePageSize;
+      Region->ReleaseInfo.LastRetainedBytes = Recorder.getRetainedBytes();
+    }
     Region->ReleaseInfo.LastReleaseAtNs = getMonotonicTimeFast();
 
     // ====================================================================== //
@@ -1312,6 +1362,11 @@ private:
     if (RegionPushedBytesDelta < PageSize)
       return false;
 
+    // Only whole huge pages are released, don't bother before one could be.
+    if (Config::getEnableHugePages() && ReleaseType == ReleaseToOS::Normal &&
+        RegionPushedBytesDelta < HugePageSize)
+      return false;
+
     // Releasing smaller blocks is expensive, so we want to make sure that a
     // significant amount of bytes are free, and that there has been a good
     // amount of batches pushed to the freelist before attempting to release.
@@ -19,20 +19,39 @@ namespace scudo {
 
 template <typename MemMapT> class RegionReleaseRecorder {
 public:
-  RegionReleaseRecorder(MemMapT *RegionMemMap, uptr Base, uptr Offset = 0)
-      : RegionMemMap(RegionMemMap), Base(Base), Offset(Offset) {}
+  RegionReleaseRecorder(MemMapT *RegionMemMap, uptr Base, uptr Offset = 0,
+                        uptr HugePageSize = 0)
+      : RegionMemMap(RegionMemMap), Base(Base), Offset(Offset),
+        HugePageSize(HugePageSize) {}
 
   uptr getReleasedRangesCount() const { return ReleasedRangesCount; }
 
   uptr getReleasedBytes() const { return ReleasedBytes; }
 
+  // Bytes of free pages which were kept because releasing them would have
+  // split a huge page.
+  uptr getRetainedBytes() const { return RetainedBytes; }
+
   uptr getBase() const { return Base; }
 
   // Releases [From, To) range of pages back to OS. Note that `From` and `To`
-  // are offseted from `Base` + Offset.
+  // are offseted from `Base` + Offset. If `HugePageSize` is set, only the huge
+  // pages entirely contained in the range are released.
   void releasePageRangeToOS(uptr From, uptr To) {
-    const uptr Size = To - From;
-    RegionMemMap->releasePagesToOS(getBase() + Offset + From, Size);
+    uptr Beg = getBase() + Offset + From;
+    uptr End = getBase() + Offset + To;
+    if (HugePageSize != 0) {
+      const uptr RangeSize = End - Beg;
+      Beg = roundUp(Beg, HugePageSize);
+      End = roundDown(End, HugePageSize);
+      if (Beg >= End) {
+        RetainedBytes += RangeSize;
+        return;
+      }
+      RetainedBytes += RangeSize - (End - Beg);
+    }
+    const uptr Size = End - Beg;
+    RegionMemMap->releasePagesToOS(Beg, Size);
     ReleasedRangesCount++;
     ReleasedBytes += Size;
   }
@@ -40,11 +59,14 @@ public:
 private:
   uptr ReleasedRangesCount = 0;
   uptr ReleasedBytes = 0;
+  uptr RetainedBytes = 0;
   MemMapT *RegionMemMap = nullptr;
   uptr Base = 0;
   // The release offset from Base. This is used when we know a given range after
   // Base will not be released.
   uptr Offset = 0;
+  // The granularity of the release, or 0 to release any page range.
+  uptr HugePageSize = 0;
 };
 
 class ReleaseRecorder {
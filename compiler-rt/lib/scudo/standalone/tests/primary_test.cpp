@@ -150,6 +150,32 @@ template <typename SizeClassMapT> struct TestConfig5 {
   };
 };
 
+// This is the only test config that enables huge pages.
+template <typename SizeClassMapT> struct TestConfig6 {
+  static const bool MaySupportMemoryTagging = false;
+  template <typename> using TSDRegistryT = void;
+  template <typename> using PrimaryT = void;
+  template <typename> using SecondaryT = void;
+
+  struct Primary {
+    using SizeClassMap = SizeClassMapT;
+#if defined(__mips__)
+    // Unable to allocate greater size on QEMU-user.
+    static const scudo::uptr RegionSizeLog = 23U;
+#else
+    static const scudo::uptr RegionSizeLog = 24U;
+#endif
+    static const scudo::uptr GroupSizeLog = 20U;
+    static const scudo::s32 MinReleaseToOsIntervalMs = INT32_MIN;
+    static const scudo::s32 MaxReleaseToOsIntervalMs = INT32_MAX;
+    typedef scudo::uptr CompactPtrT;
+    static const scudo::uptr CompactPtrScale = 0;
+    static const bool EnableRandomOffset = true;
+    static const bool EnableHugePages = true;
+    static const scudo::uptr MapSizeIncrement = 1UL << 18;
+  };
+};
+
 template <template <typename> class BaseConfig, typename SizeClassMapT>
 struct Config : public BaseConfig<SizeClassMapT> {};
 
@@ -191,7 +217,8 @@ struct ScudoPrimaryTest : public Test {};
   SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig2)                            \
   SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig3)                            \
   SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig4)                            \
-  SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig5)
+  SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig5)                            \
+  SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TestConfig6)
 #endif
 
 #define SCUDO_TYPED_TEST_TYPE(FIXTURE, NAME, TYPE)                             \
@@ -408,6 +435,44 @@ SCUDO_TYPED_TEST(ScudoPrimaryTest, ReleaseToOS) {
   EXPECT_GT(Allocator->releaseToOS(scudo::ReleaseToOS::ForceAll), 0U);
 }
 
+SCUDO_TYPED_TEST(ScudoPrimaryTest, AdaptiveCache) {
+  using Primary = TestAllocator<TypeParam, scudo::DefaultSizeClassMap>;
+  std::unique_ptr<Primary> Allocator(new Primary);
+  Allocator->init(/*ReleaseToOsInterval=*/-1);
+  const scudo::uptr Size = scudo::getPageSizeCached();
+  const scudo::uptr ClassId = Primary::SizeClassMap::getClassIdBySize(Size);
+  const scudo::u16 InitialMaxCount = static_cast<scudo::u16>(
+      2 * Primary::CacheT::getMaxCached(
+              Primary::getSizeByClassId(ClassId)));
+
+  // Allocating and freeing more blocks than fit in the cache empties and
+  // fills it over and over.
+  auto Thrash = [&](typename Primary::CacheT &Cache) {
+    std::vector<void *> Blocks;
+    for (scudo::uptr I = 0; I < 64U; ++I) {
+      for (scudo::uptr J = 0; J < 4U * InitialMaxCount; ++J)
+        Blocks.push_back(Cache.allocate(ClassId));
+      for (void *P : Blocks)
+        Cache.deallocate(ClassId, P);
+      Blocks.clear();
+    }
+  };
+
+  typename Primary::CacheT Cache;
+  Cache.init(nullptr, Allocator.get());
+  Thrash(Cache);
+  EXPECT_EQ(Cache.getMaxCountTestOnly(ClassId), InitialMaxCount);
+  Cache.destroy(nullptr);
+
+  Allocator->Options.set(scudo::OptionBit::AdaptiveCaches);
+  typename Primary::CacheT AdaptiveCache;
+  AdaptiveCache.init(nullptr, Allocator.get());
+  Thrash(AdaptiveCache);
+  EXPECT_GT(AdaptiveCache.getMaxCountTestOnly(ClassId), InitialMaxCount);
+  EXPECT_LE(AdaptiveCache.getMaxCountTestOnly(ClassId), 4U * InitialMaxCount);
+  AdaptiveCache.destroy(nullptr);
+}
+
 SCUDO_TYPED_TEST(ScudoPrimaryTest, MemoryGroup) {
   using Primary = TestAllocator<TypeParam, scudo::DefaultSizeClassMap>;
   std::unique_ptr<Primary> Allocator(new Primary);
@@ -17,6 +17,8 @@
 #include <algorithm>
 #include <random>
 #include <set>
+#include <utility>
+#include <vector>
 
 TEST(ScudoReleaseTest, RegionPageMap) {
   for (scudo::uptr I = 0; I < SCUDO_WORDSIZE; I++) {
@@ -626,6 +628,51 @@ TEST(ScudoReleaseTest, RangeReleaseRegionWithSingleBlock) {
   testReleaseRangeWithSingleBlock<scudo::FuchsiaSizeClassMap>();
 }
 
+// Records the ranges passed to releasePagesToOS() instead of releasing them.
+class RecordingMemMap {
+public:
+  std::vector<std::pair<scudo::uptr, scudo::uptr>> Ranges;
+
+  void releasePagesToOS(scudo::uptr From, scudo::uptr Size) {
+    Ranges.push_back({From, Size});
+  }
+};
+
+TEST(ScudoReleaseTest, RegionReleaseRecorderHugePages) {
+  constexpr scudo::uptr HugePageSize = 1UL << 21;
+  const scudo::uptr PageSize = scudo::getPageSizeCached();
+  const scudo::uptr Base = 16 * HugePageSize;
+
+  RecordingMemMap MemMap;
+  scudo::RegionReleaseRecorder<RecordingMemMap> Recorder(
+      &MemMap, Base, /*Offset=*/0, HugePageSize);
+  // Within a single huge page: nothing is released.
+  Recorder.releasePageRangeToOS(PageSize, 4 * PageSize);
+  EXPECT_TRUE(MemMap.Ranges.empty());
+  EXPECT_EQ(Recorder.getReleasedRangesCount(), 0U);
+  EXPECT_EQ(Recorder.getRetainedBytes(), 3 * PageSize);
+  // Covering a huge page and parts of its neighbours: only the whole huge
+  // page is released.
+  Recorder.releasePageRangeToOS(HugePageSize - PageSize,
+                                2 * HugePageSize + PageSize);
+  ASSERT_EQ(MemMap.Ranges.size(), 1U);
+  EXPECT_EQ(MemMap.Ranges[0].first, Base + HugePageSize);
+  EXPECT_EQ(MemMap.Ranges[0].second, HugePageSize);
+  EXPECT_EQ(Recorder.getReleasedRangesCount(), 1U);
+  EXPECT_EQ(Recorder.getReleasedBytes(), HugePageSize);
+  EXPECT_EQ(Recorder.getRetainedBytes(), 5 * PageSize);
+
+  // Without a huge page size, every range is released as is.
+  RecordingMemMap SmallMemMap;
+  scudo::RegionReleaseRecorder<RecordingMemMap> SmallRecorder(&SmallMemMap,
+                                                              Base);
+  SmallRecorder.releasePageRangeToOS(PageSize, 4 * PageSize);
+  ASSERT_EQ(SmallMemMap.Ranges.size(), 1U);
+  EXPECT_EQ(SmallMemMap.Ranges[0].first, Base + PageSize);
+  EXPECT_EQ(SmallMemMap.Ranges[0].second, 3 * PageSize);
+  EXPECT_EQ(SmallRecorder.getRetainedBytes(), 0U);
+}
+
 TEST(ScudoReleaseTest, BufferPool) {
   constexpr scudo::uptr StaticBufferCount = SCUDO_WORDSIZE - 1;
   constexpr scudo::uptr StaticBufferNumElements = 512U;
@@ -27,6 +27,12 @@
 void operator delete(void *, size_t) noexcept;
 void operator delete[](void *, size_t) noexcept;
 
+enum class __hot_cold_t : uint8_t {};
+void *operator new(size_t, __hot_cold_t);
+void *operator new[](size_t, __hot_cold_t);
+void *operator new(size_t, std::align_val_t, const std::nothrow_t &,
+                   __hot_cold_t) noexcept;
+
 extern "C" {
 #ifndef SCUDO_ENABLE_HOOKS_TESTS
 #define SCUDO_ENABLE_HOOKS_TESTS 0
@@ -158,6 +164,35 @@ TEST_F(ScudoWrappersCppDeathTest, New) {
   testCxxNew<Pixel>();
 }
 
+TEST_F(ScudoWrappersCppTest, HotColdNew) {
+  const __hot_cold_t Cold = static_cast<__hot_cold_t>(0);
+  const __hot_cold_t Hot = static_cast<__hot_cold_t>(255);
+  void *P = operator new(32U, Cold);
+  EXPECT_NE(P, nullptr);
+  verifyAllocHookPtr(P);
+  verifyAllocHookSize(32U);
+  memset(P, 0x42, 32U);
+  operator delete(P);
+  verifyDeallocHookPtr(P);
+
+  P = operator new[](64U, Hot);
+  EXPECT_NE(P, nullptr);
+  verifyAllocHookPtr(P);
+  verifyAllocHookSize(64U);
+  operator delete[](P);
+  verifyDeallocHookPtr(P);
+
+  const size_t Alignment = 256U;
+  P = operator new(16U, static_cast<std::align_val_t>(Alignment), std::nothrow,
+                   Cold);
+  EXPECT_NE(P, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(P) % Alignment, 0U);
+  verifyAllocHookPtr(P);
+  verifyAllocHookSize(16U);
+  operator delete(P, static_cast<std::align_val_t>(Alignment));
+  verifyDeallocHookPtr(P);
+}
+
 static std::mutex Mutex;
 static std::condition_variable Cv;
 static bool Ready;
@@ -11,6 +11,7 @@
 
 #include "tsd.h"
 
+#include "flags.h"
 #include "string_utils.h"
 
 #if SCUDO_HAS_PLATFORM_TLS_SLOT
@@ -55,6 +56,11 @@ struct TSDRegistrySharedT {
     const u32 NumberOfCPUs = getNumberOfCPUs();
     setNumberOfTSDs((NumberOfCPUs == 0) ? DefaultTSDCount
                                         : Min(NumberOfCPUs, DefaultTSDCount));
+    // More TSDs than CPUs can't make threads wait any less.
+    MaxAdaptiveTSDs = 0;
+    if (getFlags()->adaptive_caches)
+      MaxAdaptiveTSDs = (NumberOfCPUs == 0) ? TSDsArraySize
+                                            : Min(NumberOfCPUs, TSDsArraySize);
     Initialized = true;
   }
 
@@ -119,6 +125,9 @@ struct TSDRegistrySharedT {
 
     Str->append("Stats: SharedTSDs: %u available; total %u\n", NumberOfTSDs,
                 TSDsArraySize);
+    Str->append("  Contended: %zu; waited: %zu\n",
+                atomic_load_relaxed(&ContendedLocks),
+                atomic_load_relaxed(&WaitedLocks));
     for (uptr I = 0; I < NumberOfTSDs; ++I) {
       TSDs[I].lock();
       // Theoretically, we want to mark TSD::lock()/TSD::unlock() with proper
@@ -212,6 +221,7 @@ private:
   // capability.
   NOINLINE TSD<Allocator> *getTSDAndLockSlow(TSD<Allocator> *CurrentTSD)
       EXCLUDES(MutexTSDs) {
+    atomic_fetch_add(&ContendedLocks, 1U, memory_order_relaxed);
     // Use the Precedence of the current TSD as our random seed. Since we are
     // in the slow path, it means that tryLock failed, and as a result it's
     // very likely that said Precedence is non-zero.
@@ -244,17 +254,38 @@ private:
           Index -= N;
       }
       if (CandidateTSD) {
+        noteWaitedLock(N);
         CandidateTSD->lock();
         setCurrentTSD(CandidateTSD);
         return CandidateTSD;
       }
     }
     // Last resort, stick with the current one.
+    noteWaitedLock(N);
     CurrentTSD->lock();
     return CurrentTSD;
   }
 
+  // Called when no TSD could be locked without waiting. With the
+  // adaptive_caches flag, the number of TSDs in use is doubled every
+  // WaitsPerGrowth * N waits, until there's one per CPU.
+  void noteWaitedLock(u32 N) EXCLUDES(MutexTSDs) {
+    const uptr Waited =
+        atomic_fetch_add(&WaitedLocks, 1U, memory_order_relaxed) + 1;
+    if (MaxAdaptiveTSDs <= N || Waited % (WaitsPerGrowth * N) != 0)
+      return;
+    setNumberOfTSDs(Min(2 * N, MaxAdaptiveTSDs));
+  }
+
+  static const uptr WaitsPerGrowth = 256;
+
   atomic_u32 CurrentIndex = {};
+  // Number of times the TSD of a thread was locked by another thread, and
+  // number of times no other TSD was available either.
+  atomic_uptr ContendedLocks = {};
+  atomic_uptr WaitedLocks = {};
+  // The number of TSDs that adaptive_caches may grow up to, 0 if disabled.
+  u32 MaxAdaptiveTSDs = 0;
   u32 NumberOfTSDs GUARDED_BY(MutexTSDs) = 0;
   u32 NumberOfCoPrimes GUARDED_BY(MutexTSDs) = 0;
   u32 CoPrimes[TSDsArraySize] GUARDED_BY(MutexTSDs) = {};
@@ -24,6 +24,11 @@ struct nothrow_t {};
 enum class align_val_t : size_t {};
 } // namespace std
 
+// The allocation hint that -optimize-hot-cold-new passes for calls marked hot
+// or cold by memprof, with the same ABI as tcmalloc. A hint of 0 is the
+// coldest and 255 the hottest.
+enum class __hot_cold_t : uint8_t {};
+
 static void reportAllocation(void *ptr, size_t size) {
   if (SCUDO_ENABLE_HOOKS)
     if (__scudo_allocate_hook && ptr)
@@ -84,6 +89,42 @@ INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
   return Ptr;
 }
 
+// The hinted variants are accepted so that programs built with hot/cold
+// memprof lowering can link against Scudo, which does not segregate
+// allocations by hotness.
+INTERFACE WEAK void *operator new(size_t size, __hot_cold_t) {
+  return operator new(size);
+}
+INTERFACE WEAK void *operator new[](size_t size, __hot_cold_t) {
+  return operator new[](size);
+}
+INTERFACE WEAK void *operator new(size_t size, std::nothrow_t const &nt,
+                                  __hot_cold_t) NOEXCEPT {
+  return operator new(size, nt);
+}
+INTERFACE WEAK void *operator new[](size_t size, std::nothrow_t const &nt,
+                                    __hot_cold_t) NOEXCEPT {
+  return operator new[](size, nt);
+}
+INTERFACE WEAK void *operator new(size_t size, std::align_val_t align,
+                                  __hot_cold_t) {
+  return operator new(size, align);
+}
+INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
+                                    __hot_cold_t) {
+  return operator new[](size, align);
+}
+INTERFACE WEAK void *operator new(size_t size, std::align_val_t align,
+                                  std::nothrow_t const &nt,
+                                  __hot_cold_t) NOEXCEPT {
+  return operator new(size, align, nt);
+}
+INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
+                                    std::nothrow_t const &nt,
+                                    __hot_cold_t) NOEXCEPT {
+  return operator new[](size, align, nt);
+}
+
 INTERFACE WEAK void operator delete(void *ptr) NOEXCEPT {
   reportDeallocation(ptr);
   Allocator.deallocate(ptr, scudo::Chunk::Origin::New);
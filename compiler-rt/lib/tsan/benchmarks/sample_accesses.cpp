@@ -0,0 +1,82 @@
+// Mini-benchmark for TSAN_OPTIONS=sample_accesses=N.
+// Measures how many of a fixed set of races are still reported, and how long
+// a race-free workload of plain accesses takes, for the flags in use.
+// Every racy variable lives on its own page, so with
+// sample_accesses_by_page=1 about 1/N of the races are expected to be
+// reported, and about 1/N^2 with sample_accesses_by_page=0.
+// Optional first argument is the number of repetitions of the race-free
+// workload.
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+const int kRaces = 1000;
+const int kPageSize = 4096;
+static char racy[kRaces][kPageSize] __attribute__((aligned(4096)));
+static int racy_done;
+static int reports;
+
+extern "C" const char *__tsan_default_options() {
+  return "suppress_equal_stacks=0:suppress_equal_addresses=0";
+}
+
+extern "C" void __tsan_on_report(void *report) {
+  __atomic_fetch_add(&reports, 1, __ATOMIC_RELAXED);
+}
+
+void *RacyWriter(void *arg) {
+  const bool second = !!arg;
+  if (second) {
+    // Relaxed, so that the two writes to each variable are not ordered.
+    while (!__atomic_load_n(&racy_done, __ATOMIC_RELAXED)) {
+    }
+  }
+  for (int i = 0; i < kRaces; i++)
+    *(volatile int *)racy[i] = second;
+  if (!second)
+    __atomic_store_n(&racy_done, 1, __ATOMIC_RELAXED);
+  return 0;
+}
+
+void *PrivateWorker(void *arg) {
+  const int kSize = 64 << 10;
+  static __thread volatile long data[kSize];
+  const int repeat = (long)arg;
+  for (int i = 0; i < repeat; i++) {
+    for (int j = 0; j < kSize; j++)
+      data[j] = data[j] + 1;
+  }
+  return 0;
+}
+
+double Now() {
+  timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+int main(int argc, char **argv) {
+  long repeat = 1000;
+  if (argc > 1)
+    repeat = atol(argv[1]);
+  const char *options = getenv("TSAN_OPTIONS");
+  printf("%s: TSAN_OPTIONS=%s\n", __FILE__, options ? options : "");
+
+  pthread_t t[2];
+  pthread_create(&t[0], 0, RacyWriter, (void *)0);
+  pthread_create(&t[1], 0, RacyWriter, (void *)1);
+  pthread_join(t[0], 0);
+  pthread_join(t[1], 0);
+  printf("races reported: %d of %d\n",
+         __atomic_load_n(&reports, __ATOMIC_RELAXED), kRaces);
+
+  double start = Now();
+  pthread_create(&t[0], 0, PrivateWorker, (void *)repeat);
+  pthread_create(&t[1], 0, PrivateWorker, (void *)repeat);
+  pthread_join(t[0], 0);
+  pthread_join(t[1], 0);
+  printf("race-free workload: %.3f s\n", Now() - start);
+  return 0;
+}
@@ -117,6 +117,11 @@ void InitializeFlags(Flags *f, const char *env, const char *env_option_name) {
            " (must be [0..2])\n");
     Die();
   }
+  if (f->sample_accesses < 0) {
+    Printf("ThreadSanitizer: incorrect value for sample_accesses"
+           " (must be >= 0)\n");
+    Die();
+  }
 }
 
 }  // namespace __tsan
@@ -408,7 +408,7 @@ ThreadState::ThreadState(Tid tid)
     // they may be accessed before the ctor.
     // ignore_reads_and_writes()
     // ignore_interceptors()
-    : tid(tid) {
+    : access_sample_rng(static_cast<u32>(tid) * 2654435761u | 1), tid(tid) {
   CHECK_EQ(reinterpret_cast<uptr>(this) % SANITIZER_CACHE_LINE_SIZE, 0);
 #if !SANITIZER_GO
   // C/C++ uses fixed size shadow stack.
@@ -697,6 +697,7 @@ void Initialize(ThreadState *thr) {
   AvoidCVE_2016_2143();
   __sanitizer::InitializePlatformEarly();
   __tsan::InitializePlatformEarly();
+  InitializeAccessSampling(&ctx->flags);
 
 #if !SANITIZER_GO
   InitializeAllocator();
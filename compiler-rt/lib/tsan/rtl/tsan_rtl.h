@@ -175,6 +175,11 @@ struct ThreadState {
 
   atomic_sint32_t pending_signals;
 
+  // With per thread sample_accesses, the number of memory accesses left until
+  // the next checked one, and the state of the generator of these distances.
+  u32 access_sample_countdown;
+  u32 access_sample_rng;
+
   VectorClock clock;
 
   // This is a slow path flag. On fast path, fast_state.GetIgnoreBit() is read.
@@ -524,6 +529,7 @@ int Finalize(ThreadState *thr);
 void OnUserAlloc(ThreadState *thr, uptr pc, uptr p, uptr sz, bool write);
 void OnUserFree(ThreadState *thr, uptr pc, uptr p, bool write);
 
+void InitializeAccessSampling(const Flags *flags);
 void MemoryAccess(ThreadState *thr, uptr pc, uptr addr, uptr size,
                   AccessType typ);
 void UnalignedMemoryAccess(ThreadState *thr, uptr pc, uptr addr, uptr size,
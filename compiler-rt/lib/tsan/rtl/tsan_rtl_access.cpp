@@ -411,6 +411,58 @@ char* DumpShadow(char* buf, RawShadow raw) {
 // switching trace part. As the result the hottest callbacks contain only tail
 // calls, which effectively makes them leaf functions (can use all registers,
 // no frame setup, etc).
+// The mean distance between checked accesses with sample_accesses, or 0 if
+// all the accesses are checked.
+static u32 access_sample_period;
+// With sample_accesses_by_page, the pages whose hash has none of these bits
+// set are checked.
+static u64 access_sample_page_mask;
+static u64 access_sample_page_seed;
+static constexpr uptr kAccessSamplePageShift = 12;
+
+void InitializeAccessSampling(const Flags* flags) {
+  if (flags->sample_accesses <= 1)
+    return;
+  // Bound the period so that the page hash has enough bits for the mask.
+  const u32 period = Min(flags->sample_accesses, 1 << 20);
+  access_sample_period = period;
+  if (!flags->sample_accesses_by_page)
+    return;
+  access_sample_page_mask = RoundUpToPowerOfTwo(period) - 1;
+  // Sample different pages in different processes.
+  if (!GetRandom(&access_sample_page_seed, sizeof(access_sample_page_seed),
+                 /*blocking=*/false))
+    access_sample_page_seed = NanoTime();
+}
+
+// Returns true if the access to `addr` is not checked because of
+// sample_accesses. Only the race detection is skipped for such accesses,
+// synchronization never goes through here.
+ALWAYS_INLINE bool AccessSampledOut(ThreadState* thr, uptr addr) {
+  if (LIKELY(access_sample_period == 0))
+    return false;
+  if (access_sample_page_mask) {
+    const u64 hash = ((addr >> kAccessSamplePageShift) ^
+                      access_sample_page_seed) *
+                     0x9e3779b97f4a7c15ull;
+    return (hash >> 40) & access_sample_page_mask;
+  }
+  if (thr->access_sample_countdown > 1) {
+    thr->access_sample_countdown--;
+    return true;
+  }
+  // Check this access, and pick the distance to the next checked one
+  // uniformly in [1, 2 * period - 1] so that the sampling doesn't follow the
+  // access patterns of loops.
+  u32 x = thr->access_sample_rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  thr->access_sample_rng = x;
+  thr->access_sample_countdown = 1 + x % (2 * access_sample_period - 1);
+  return false;
+}
+
 NOINLINE void TraceRestartMemoryAccess(ThreadState* thr, uptr pc, uptr addr,
                                        uptr size, AccessType typ) {
   TraceSwitchPart(thr);
@@ -419,6 +471,8 @@ NOINLINE void TraceRestartMemoryAccess(ThreadState* thr, uptr pc, uptr addr,
 
 ALWAYS_INLINE USED void MemoryAccess(ThreadState* thr, uptr pc, uptr addr,
                                      uptr size, AccessType typ) {
+  if (UNLIKELY(AccessSampledOut(thr, addr)))
+    return;
   RawShadow* shadow_mem = MemToShadow(addr);
   UNUSED char memBuf[4][64];
   DPrintf2("#%d: Access: %d@%d %p/%zd typ=0x%x {%s, %s, %s, %s}\n", thr->tid,
@@ -457,6 +511,8 @@ ALWAYS_INLINE USED void MemoryAccess16(ThreadState* thr, uptr pc, uptr addr,
   FastState fast_state = thr->fast_state;
   if (UNLIKELY(fast_state.GetIgnoreBit()))
     return;
+  if (UNLIKELY(AccessSampledOut(thr, addr)))
+    return;
   Shadow cur(fast_state, 0, 8, typ);
   RawShadow* shadow_mem = MemToShadow(addr);
   bool traced = false;
@@ -494,6 +550,8 @@ ALWAYS_INLINE USED void UnalignedMemoryAccess(ThreadState* thr, uptr pc,
   FastState fast_state = thr->fast_state;
   if (UNLIKELY(fast_state.GetIgnoreBit()))
     return;
+  if (UNLIKELY(AccessSampledOut(thr, addr)))
+    return;
   RawShadow* shadow_mem = MemToShadow(addr);
   bool traced = false;
   uptr size1 = Min<uptr>(size, RoundUp(addr + 1, kShadowCell) - addr);
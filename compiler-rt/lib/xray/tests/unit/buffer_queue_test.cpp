@@ -17,6 +17,7 @@
 #include <future>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 namespace __xray {
 namespace {
@@ -120,6 +121,34 @@ TEST(BufferQueueTest, Apply) {
   ASSERT_EQ(Count, 10);
 }
 
+TEST(BufferQueueTest, StreamingDrainsBeforeReuse) {
+  bool Success = false;
+  BufferQueue Buffers(kSize, 2, Success, /*Streaming=*/true);
+  ASSERT_TRUE(Success);
+  BufferQueue::Buffer B;
+  for (int I = 0; I < 2; ++I) {
+    ASSERT_EQ(Buffers.getBuffer(B), BufferQueue::ErrorCode::Ok);
+    atomic_store(B.Extents, I + 1, memory_order_release);
+    ASSERT_EQ(Buffers.releaseBuffer(B), BufferQueue::ErrorCode::Ok);
+  }
+
+  // Both buffers hold records that have not been written out yet.
+  EXPECT_EQ(Buffers.getBuffer(B), BufferQueue::ErrorCode::NotEnoughMemory);
+
+  std::vector<uint64_t> Drained;
+  Buffers.drain([&](const BufferQueue::Buffer &B) {
+    Drained.push_back(atomic_load(B.Extents, memory_order_acquire));
+  });
+  EXPECT_THAT(Drained, ::testing::ElementsAre(1, 2));
+
+  // Buffers are only drained once, and then handed out again.
+  Drained.clear();
+  Buffers.drain([&](const BufferQueue::Buffer &) { Drained.push_back(0); });
+  EXPECT_TRUE(Drained.empty());
+  ASSERT_EQ(Buffers.getBuffer(B), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.releaseBuffer(B), BufferQueue::ErrorCode::Ok);
+}
+
 TEST(BufferQueueTest, GenerationalSupport) {
   bool Success = false;
   BufferQueue Buffers(kSize, 10, Success);
@@ -159,6 +159,17 @@ private:
   // Count of buffers that have been handed out through 'getBuffer'.
   size_t LiveBuffers;
 
+  // Whether released buffers have to go through 'drain' before they are handed
+  // out again.
+  bool Streaming;
+
+  // Pointer to the oldest released buffer that has not been drained yet, when
+  // streaming.
+  BufferRep *Unflushed;
+
+  // Count of released buffers that have not been drained yet, when streaming.
+  size_t UnflushedBuffers;
+
   // We use a generation number to identify buffers and which generation they're
   // associated with.
   atomic_uint64_t Generation;
@@ -195,8 +206,8 @@ public:
   }
 
   /// Initialise a queue of size |N| with buffers of size |B|. We report success
-  /// through |Success|.
-  BufferQueue(size_t B, size_t N, bool &Success);
+  /// through |Success|. See init(...) for |Streaming|.
+  BufferQueue(size_t B, size_t N, bool &Success, bool Streaming = false);
 
   /// Updates |Buf| to contain the pointer to an appropriate buffer. Returns an
   /// error in case there are no available buffers to return when we will run
@@ -221,13 +232,16 @@ public:
   ErrorCode releaseBuffer(Buffer &Buf);
 
   /// Initializes the buffer queue, starting a new generation. We can re-set the
-  /// size of buffers with |BS| along with the buffer count with |BC|.
+  /// size of buffers with |BS| along with the buffer count with |BC|. When
+  /// |Streaming| is true, released buffers are not handed out again until they
+  /// have been passed to drain(...), so that no records are overwritten before
+  /// they have been written out.
   ///
   /// Returns:
   ///   - ErrorCode::Ok when we successfully initialize the buffer. This
   ///   requires that the buffer queue is previously finalized.
   ///   - ErrorCode::AlreadyInitialized when the buffer queue is not finalized.
-  ErrorCode init(size_t BS, size_t BC);
+  ErrorCode init(size_t BS, size_t BC, bool Streaming = false);
 
   bool finalizing() const {
     return atomic_load(&Finalizing, memory_order_acquire);
@@ -258,6 +272,31 @@ public:
       Fn(*I);
   }
 
+  /// In a streaming queue, applies the provided function F to each Buffer
+  /// released since the previous call, in the order they were released, and
+  /// only then makes them available to getBuffer(...) again. F runs without
+  /// holding the queue lock, so it may block (e.g. on I/O). Only one thread may
+  /// drain the queue at a time.
+  template <class F> void drain(F Fn) XRAY_NEVER_INSTRUMENT {
+    BufferRep *B;
+    size_t N;
+    {
+      SpinMutexLock G(&Mutex);
+      B = Unflushed;
+      N = UnflushedBuffers;
+    }
+    // The buffers in [B, B + N) are neither handed out nor overwritten by
+    // releaseBuffer(...) until we account for them below.
+    for (size_t I = 0; I != N; ++I) {
+      Fn(static_cast<const Buffer &>(B->Buff));
+      if (++B == Buffers + BufferCount)
+        B = Buffers;
+    }
+    SpinMutexLock G(&Mutex);
+    Unflushed = B;
+    UnflushedBuffers -= N;
+  }
+
   using const_iterator = Iterator<const Buffer>;
   using iterator = Iterator<Buffer>;
 
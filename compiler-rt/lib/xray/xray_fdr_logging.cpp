@@ -90,6 +90,12 @@ static atomic_uint64_t TicksPerSec{0};
 static atomic_sint32_t LogFlushStatus = {
     XRayLogFlushStatus::XRAY_LOG_NOT_FLUSHING};
 
+// With stream_interval_ms, the log the buffers are streamed to, and the thread
+// that writes them.
+static LogWriter *StreamLW = nullptr;
+static pthread_t StreamThread;
+static atomic_uint8_t StreamStop{0};
+
 // This function will initialize the thread-local data structure used by the FDR
 // logging implementation and return a reference to it. The implementation
 // details require a bit of care to maintain.
@@ -277,6 +283,53 @@ XRayBuffer fdrIterator(const XRayBuffer B) {
   return Result;
 }
 
+static void writeFileHeader(LogWriter *LW) XRAY_NEVER_INSTRUMENT {
+  XRayFileHeader Header = fdrCommonHeaderInfo();
+  Header.FdrData = FdrAdditionalHeaderData{BQ->ConfiguredBufferSize()};
+  LW->WriteAll(reinterpret_cast<char *>(&Header),
+               reinterpret_cast<char *>(&Header) + sizeof(Header));
+}
+
+static void writeBuffer(LogWriter *LW,
+                        const BufferQueue::Buffer &B) XRAY_NEVER_INSTRUMENT {
+  // Starting at version 2 of the FDR logging implementation, we only write
+  // the records identified by the extents of the buffer. We use the Extents
+  // from the Buffer and write that out as the first record in the buffer.  We
+  // still use a Metadata record, but fill in the extents instead for the
+  // data.
+  MetadataRecord ExtentsRecord;
+  auto BufferExtents = atomic_load(B.Extents, memory_order_acquire);
+  DCHECK(BufferExtents <= B.Size);
+  ExtentsRecord.Type = uint8_t(RecordType::Metadata);
+  ExtentsRecord.RecordKind =
+      uint8_t(MetadataRecord::RecordKinds::BufferExtents);
+  internal_memcpy(ExtentsRecord.Data, &BufferExtents, sizeof(BufferExtents));
+  if (BufferExtents > 0) {
+    LW->WriteAll(reinterpret_cast<char *>(&ExtentsRecord),
+                 reinterpret_cast<char *>(&ExtentsRecord) +
+                     sizeof(MetadataRecord));
+    LW->WriteAll(reinterpret_cast<char *>(B.Data),
+                 reinterpret_cast<char *>(B.Data) + BufferExtents);
+  }
+}
+
+static void closeStreamLog() XRAY_NEVER_INSTRUMENT {
+  if (StreamLW == nullptr)
+    return;
+  LogWriter::Close(StreamLW);
+  StreamLW = nullptr;
+}
+
+// Writes the buffers released by the threads to StreamLW as they come in, until
+// the log is flushed.
+static void *fdrStreamBuffers(void *) XRAY_NEVER_INSTRUMENT {
+  while (!atomic_load(&StreamStop, memory_order_acquire)) {
+    SleepForMillis(fdrFlags()->stream_interval_ms);
+    BQ->drain([](const BufferQueue::Buffer &B) { writeBuffer(StreamLW, B); });
+  }
+  return nullptr;
+}
+
 // Must finalize before flushing.
 XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
   if (atomic_load(&LoggingStatus, memory_order_acquire) !=
@@ -330,6 +383,22 @@ XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
     return XRayLogFlushStatus::XRAY_LOG_FLUSHED;
   }
 
+  if (StreamLW != nullptr) {
+    // The header and most buffers are already in the file. Release the current
+    // thread's buffer, then write out whatever the streaming thread has not
+    // gotten to before it stopped.
+    auto &TLD = getThreadLocalData();
+    if (TLD.Controller != nullptr)
+      TLD.Controller->flush();
+    atomic_store(&StreamStop, 1, memory_order_release);
+    pthread_join(StreamThread, nullptr);
+    BQ->drain([](const BufferQueue::Buffer &B) { writeBuffer(StreamLW, B); });
+    closeStreamLog();
+    atomic_store(&LogFlushStatus, XRayLogFlushStatus::XRAY_LOG_FLUSHED,
+                 memory_order_release);
+    return XRayLogFlushStatus::XRAY_LOG_FLUSHED;
+  }
+
   // We write out the file in the following format:
   //
   //   1) We write down the XRay file header with version 1, type FDR_LOG.
@@ -346,10 +415,7 @@ XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
     return Result;
   }
 
-  XRayFileHeader Header = fdrCommonHeaderInfo();
-  Header.FdrData = FdrAdditionalHeaderData{BQ->ConfiguredBufferSize()};
-  LW->WriteAll(reinterpret_cast<char *>(&Header),
-               reinterpret_cast<char *>(&Header) + sizeof(Header));
+  writeFileHeader(LW);
 
   // Release the current thread's buffer before we attempt to write out all the
   // buffers. This ensures that in case we had only a single thread going, that
@@ -358,27 +424,7 @@ XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
   if (TLD.Controller != nullptr)
     TLD.Controller->flush();
 
-  BQ->apply([&](const BufferQueue::Buffer &B) {
-    // Starting at version 2 of the FDR logging implementation, we only write
-    // the records identified by the extents of the buffer. We use the Extents
-    // from the Buffer and write that out as the first record in the buffer.  We
-    // still use a Metadata record, but fill in the extents instead for the
-    // data.
-    MetadataRecord ExtentsRecord;
-    auto BufferExtents = atomic_load(B.Extents, memory_order_acquire);
-    DCHECK(BufferExtents <= B.Size);
-    ExtentsRecord.Type = uint8_t(RecordType::Metadata);
-    ExtentsRecord.RecordKind =
-        uint8_t(MetadataRecord::RecordKinds::BufferExtents);
-    internal_memcpy(ExtentsRecord.Data, &BufferExtents, sizeof(BufferExtents));
-    if (BufferExtents > 0) {
-      LW->WriteAll(reinterpret_cast<char *>(&ExtentsRecord),
-                   reinterpret_cast<char *>(&ExtentsRecord) +
-                       sizeof(MetadataRecord));
-      LW->WriteAll(reinterpret_cast<char *>(B.Data),
-                   reinterpret_cast<char *>(B.Data) + BufferExtents);
-    }
-  });
+  BQ->apply([&](const BufferQueue::Buffer &B) { writeBuffer(LW, B); });
 
   atomic_store(&LogFlushStatus, XRayLogFlushStatus::XRAY_LOG_FLUSHED,
                memory_order_release);
@@ -663,18 +709,43 @@ XRayLogInitStatus fdrLoggingInit(size_t, size_t, void *Options,
   auto BufferSize = FDRFlags.buffer_size;
   auto BufferMax = FDRFlags.buffer_max;
 
+  bool Streaming = FDRFlags.stream_interval_ms > 0 && !FDRFlags.no_file_flush;
+  if (Streaming) {
+    StreamLW = LogWriter::Open();
+    if (StreamLW == nullptr) {
+      Report("XRay FDR: Cannot open the log, not streaming buffers.\n");
+      Streaming = false;
+    }
+  }
+
   if (BQ == nullptr) {
     bool Success = false;
     BQ = reinterpret_cast<BufferQueue *>(&BufferQueueStorage);
-    new (BQ) BufferQueue(BufferSize, BufferMax, Success);
+    new (BQ) BufferQueue(BufferSize, BufferMax, Success, Streaming);
     if (!Success) {
       Report("BufferQueue init failed.\n");
+      closeStreamLog();
       return XRayLogInitStatus::XRAY_LOG_UNINITIALIZED;
     }
   } else {
-    if (BQ->init(BufferSize, BufferMax) != BufferQueue::ErrorCode::Ok) {
+    if (BQ->init(BufferSize, BufferMax, Streaming) !=
+        BufferQueue::ErrorCode::Ok) {
       if (Verbosity())
         Report("Failed to re-initialize global buffer queue. Init failed.\n");
+      closeStreamLog();
+      return XRayLogInitStatus::XRAY_LOG_UNINITIALIZED;
+    }
+  }
+
+  if (Streaming) {
+    writeFileHeader(StreamLW);
+    atomic_store(&StreamStop, 0, memory_order_release);
+    if (pthread_create(&StreamThread, nullptr, fdrStreamBuffers, nullptr)) {
+      Report("XRay FDR: Cannot start the thread streaming buffers.\n");
+      BQ->finalize();
+      closeStreamLog();
+      atomic_store(&LoggingStatus, XRayLogInitStatus::XRAY_LOG_UNINITIALIZED,
+                   memory_order_release);
       return XRayLogInitStatus::XRAY_LOG_UNINITIALIZED;
     }
   }
@@ -715,8 +786,10 @@ XRayLogInitStatus fdrLoggingInit(size_t, size_t, void *Options,
   __xray_set_customevent_handler(fdrLoggingHandleCustomEvent);
   __xray_set_typedevent_handler(fdrLoggingHandleTypedEvent);
 
-  // Install the buffer iterator implementation.
-  __xray_log_set_buffer_iterator(fdrIterator);
+  // Install the buffer iterator implementation. Streamed buffers go to the log
+  // file as they are filled, so there would be nothing left to iterate over.
+  if (!Streaming)
+    __xray_log_set_buffer_iterator(fdrIterator);
 
   atomic_store(&LoggingStatus, XRayLogInitStatus::XRAY_LOG_INITIALIZED,
                memory_order_release);
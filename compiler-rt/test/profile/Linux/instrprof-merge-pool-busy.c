@@ -0,0 +1,31 @@
+// Test that processes exiting at the same time with a merge pool (%Nm) spread
+// over the files of the pool without losing counts.
+
+// RUN: %clang_pgogen -o %t %s
+// RUN: rm -rf %t.d
+// RUN: env LLVM_PROFILE_FILE="%t.d/%4m.profraw" %run %t
+// RUN: llvm-profdata merge -o %t.profdata %t.d
+// RUN: llvm-profdata show --counts --function=foo %t.profdata | FileCheck %s
+
+// CHECK: Block counts: [32]
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+__attribute__((noinline)) void foo(void) {}
+
+int main(void) {
+  int I;
+  for (I = 0; I < 32; ++I) {
+    pid_t Pid = fork();
+    if (Pid == 0) {
+      foo();
+      return 0;
+    }
+    if (Pid < 0)
+      return 1;
+  }
+  while (wait(0) > 0)
+    ;
+  return 0;
+}
@@ -25,6 +25,8 @@
 #include "flang/Common/uint128.h"
 #include "flang/Runtime/cpp-type.h"
 #include "flang/Runtime/descriptor.h"
+#include <algorithm>
+#include <limits>
 
 namespace Fortran::runtime::io::descr {
 template <typename A>
@@ -44,6 +46,21 @@ inline RT_API_ATTRS A &ExtractElement(IoStatementState &io,
 // automatic repetition counts, like "10*3.14159", for list-directed and
 // NAMELIST array output.
 
+// On output, a repeated data edit descriptor such as 10F12.4 is fetched
+// from the format once and then applied to up to that many consecutive
+// elements, rather than being cued up again for each element.  Input
+// takes one element per data edit, since list-directed input may end
+// early with a null value or a slash.
+template <Direction DIR>
+inline RT_API_ATTRS int MaxOutputRepeat(std::size_t remainingElements) {
+  if constexpr (DIR == Direction::Output) {
+    return static_cast<int>(std::min<std::size_t>(
+        remainingElements, std::numeric_limits<int>::max()));
+  } else {
+    return 1;
+  }
+}
+
 template <int KIND, Direction DIR>
 inline RT_API_ATTRS bool FormattedIntegerIO(
     IoStatementState &io, const Descriptor &descriptor) {
@@ -52,24 +69,28 @@ inline RT_API_ATTRS bool FormattedIntegerIO(
   descriptor.GetLowerBounds(subscripts);
   using IntType = CppTypeFor<TypeCategory::Integer, KIND>;
   bool anyInput{false};
-  for (std::size_t j{0}; j < numElements; ++j) {
-    if (auto edit{io.GetNextDataEdit()}) {
-      IntType &x{ExtractElement<IntType>(io, descriptor, subscripts)};
-      if constexpr (DIR == Direction::Output) {
-        if (!EditIntegerOutput<KIND>(io, *edit, x)) {
-          return false;
+  for (std::size_t j{0}; j < numElements;) {
+    if (auto edit{io.GetNextDataEdit(MaxOutputRepeat<DIR>(numElements - j))}) {
+      for (int k{0}; k < edit->repeat; ++k, ++j) {
+        IntType &x{ExtractElement<IntType>(io, descriptor, subscripts)};
+        if constexpr (DIR == Direction::Output) {
+          if (!EditIntegerOutput<KIND>(io, *edit, x)) {
+            return false;
+          }
+        } else if (edit->descriptor != DataEdit::ListDirectedNullValue) {
+          if (EditIntegerInput(
+                  io, *edit, reinterpret_cast<void *>(&x), KIND)) {
+            anyInput = true;
+          } else {
+            return anyInput && edit->IsNamelist();
+          }
         }
-      } else if (edit->descriptor != DataEdit::ListDirectedNullValue) {
-        if (EditIntegerInput(io, *edit, reinterpret_cast<void *>(&x), KIND)) {
-          anyInput = true;
-        } else {
-          return anyInput && edit->IsNamelist();
+        if (!descriptor.IncrementSubscripts(subscripts) &&
+            j + 1 < numElements) {
+          io.GetIoErrorHandler().Crash(
+              "FormattedIntegerIO: subscripts out of bounds");
         }
       }
-      if (!descriptor.IncrementSubscripts(subscripts) && j + 1 < numElements) {
-        io.GetIoErrorHandler().Crash(
-            "FormattedIntegerIO: subscripts out of bounds");
-      }
     } else {
       return false;
     }
@@ -85,24 +106,27 @@ inline RT_API_ATTRS bool FormattedRealIO(
   descriptor.GetLowerBounds(subscripts);
   using RawType = typename RealOutputEditing<KIND>::BinaryFloatingPoint;
   bool anyInput{false};
-  for (std::size_t j{0}; j < numElements; ++j) {
-    if (auto edit{io.GetNextDataEdit()}) {
-      RawType &x{ExtractElement<RawType>(io, descriptor, subscripts)};
-      if constexpr (DIR == Direction::Output) {
-        if (!RealOutputEditing<KIND>{io, x}.Edit(*edit)) {
-          return false;
+  for (std::size_t j{0}; j < numElements;) {
+    if (auto edit{io.GetNextDataEdit(MaxOutputRepeat<DIR>(numElements - j))}) {
+      for (int k{0}; k < edit->repeat; ++k, ++j) {
+        RawType &x{ExtractElement<RawType>(io, descriptor, subscripts)};
+        if constexpr (DIR == Direction::Output) {
+          if (!RealOutputEditing<KIND>{io, x}.Edit(*edit)) {
+            return false;
+          }
+        } else if (edit->descriptor != DataEdit::ListDirectedNullValue) {
+          if (EditRealInput<KIND>(io, *edit, reinterpret_cast<void *>(&x))) {
+            anyInput = true;
+          } else {
+            return anyInput && edit->IsNamelist();
+          }
         }
-      } else if (edit->descriptor != DataEdit::ListDirectedNullValue) {
-        if (EditRealInput<KIND>(io, *edit, reinterpret_cast<void *>(&x))) {
-          anyInput = true;
-        } else {
-          return anyInput && edit->IsNamelist();
+        if (!descriptor.IncrementSubscripts(subscripts) &&
+            j + 1 < numElements) {
+          io.GetIoErrorHandler().Crash(
+              "FormattedRealIO: subscripts out of bounds");
         }
       }
-      if (!descriptor.IncrementSubscripts(subscripts) && j + 1 < numElements) {
-        io.GetIoErrorHandler().Crash(
-            "FormattedRealIO: subscripts out of bounds");
-      }
     } else {
       return false;
     }
@@ -58,6 +58,10 @@ RT_DIAG_DISABLE_CALL_HOST_FROM_DEVICE_WARN
 //    DO 2 I = 1, NROWS
 //     DO 2 K = 1, N
 //   2  RES(I,J) = RES(I,J) + X(K,I)*Y(K,J) ! loop-invariant last term
+// Four elements of a result column are computed at a time, with their
+// sums held in registers, so that each element of Y that is loaded is
+// used four times and the four sums proceed independently.  Every sum
+// still adds its terms in the order of K.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT,
     bool X_HAS_STRIDED_COLUMNS, bool Y_HAS_STRIDED_COLUMNS>
 inline static RT_API_ATTRS void MatrixTransposedTimesMatrix(
@@ -67,26 +71,49 @@ inline static RT_API_ATTRS void MatrixTransposedTimesMatrix(
     std::size_t yColumnByteStride = 0) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
 
-  std::memset(product, 0, rows * cols * sizeof *product);
+  auto xColumn{[&](SubscriptValue i) -> const XT * {
+    if constexpr (!X_HAS_STRIDED_COLUMNS) {
+      return x + i * n;
+    } else {
+      return reinterpret_cast<const XT *>(
+          reinterpret_cast<const char *>(x) + i * xColumnByteStride);
+    }
+  }};
   for (SubscriptValue j{0}; j < cols; ++j) {
-    for (SubscriptValue i{0}; i < rows; ++i) {
+    const YT *RESTRICT yp;
+    if constexpr (!Y_HAS_STRIDED_COLUMNS) {
+      yp = y + j * n;
+    } else {
+      yp = reinterpret_cast<const YT *>(
+          reinterpret_cast<const char *>(y) + j * yColumnByteStride);
+    }
+    ResultType *RESTRICT p{product + j * rows};
+    SubscriptValue i{0};
+    for (; i + 4 <= rows; i += 4) {
+      const XT *RESTRICT x0{xColumn(i)};
+      const XT *RESTRICT x1{xColumn(i + 1)};
+      const XT *RESTRICT x2{xColumn(i + 2)};
+      const XT *RESTRICT x3{xColumn(i + 3)};
+      ResultType s0{}, s1{}, s2{}, s3{};
       for (SubscriptValue k{0}; k < n; ++k) {
-        ResultType x_ki;
-        if constexpr (!X_HAS_STRIDED_COLUMNS) {
-          x_ki = static_cast<ResultType>(x[i * n + k]);
-        } else {
-          x_ki = static_cast<ResultType>(reinterpret_cast<const XT *>(
-              reinterpret_cast<const char *>(x) + i * xColumnByteStride)[k]);
-        }
-        ResultType y_kj;
-        if constexpr (!Y_HAS_STRIDED_COLUMNS) {
-          y_kj = static_cast<ResultType>(y[j * n + k]);
-        } else {
-          y_kj = static_cast<ResultType>(reinterpret_cast<const YT *>(
-              reinterpret_cast<const char *>(y) + j * yColumnByteStride)[k]);
-        }
-        product[j * rows + i] += x_ki * y_kj;
+        auto y_kj{static_cast<ResultType>(yp[k])};
+        s0 += static_cast<ResultType>(x0[k]) * y_kj;
+        s1 += static_cast<ResultType>(x1[k]) * y_kj;
+        s2 += static_cast<ResultType>(x2[k]) * y_kj;
+        s3 += static_cast<ResultType>(x3[k]) * y_kj;
+      }
+      p[i] = s0;
+      p[i + 1] = s1;
+      p[i + 2] = s2;
+      p[i + 3] = s3;
+    }
+    for (; i < rows; ++i) {
+      const XT *RESTRICT xi{xColumn(i)};
+      ResultType sum{};
+      for (SubscriptValue k{0}; k < n; ++k) {
+        sum += static_cast<ResultType>(xi[k]) * static_cast<ResultType>(yp[k]);
       }
+      p[i] = sum;
     }
   }
 }
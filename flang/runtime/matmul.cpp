@@ -26,6 +26,7 @@
 #include "flang/Runtime/c-or-cpp.h"
 #include "flang/Runtime/cpp-type.h"
 #include "flang/Runtime/descriptor.h"
+#include <algorithm>
 #include <cstring>
 
 namespace Fortran::runtime {
@@ -77,6 +78,11 @@ private:
 //    DO 2 J = 1, NCOLS
 //     DO 2 I = 1, NROWS
 //   2  RES(I,J) = RES(I,J) + X(I,K)*Y(K,J) ! loop-invariant last term
+// The second loop nest is blocked over I and K so that a panel of X
+// stays in cache while it is applied to every column of the result,
+// instead of streaming all of X from memory once per column.  Every
+// element of the result still sums its terms in the order of K, so the
+// result is the same as without blocking.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT,
     bool X_HAS_STRIDED_COLUMNS, bool Y_HAS_STRIDED_COLUMNS>
 inline RT_API_ATTRS void MatrixTimesMatrix(
@@ -85,28 +91,62 @@ inline RT_API_ATTRS void MatrixTimesMatrix(
     SubscriptValue n, std::size_t xColumnByteStride = 0,
     std::size_t yColumnByteStride = 0) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
-  std::memset(product, 0, rows * cols * sizeof *product);
-  const XT *RESTRICT xp0{x};
-  for (SubscriptValue k{0}; k < n; ++k) {
-    ResultType *RESTRICT p{product};
-    for (SubscriptValue j{0}; j < cols; ++j) {
-      const XT *RESTRICT xp{xp0};
-      ResultType yv;
-      if constexpr (!Y_HAS_STRIDED_COLUMNS) {
-        yv = static_cast<ResultType>(y[k + j * n]);
-      } else {
-        yv = static_cast<ResultType>(reinterpret_cast<const YT *>(
-            reinterpret_cast<const char *>(y) + j * yColumnByteStride)[k]);
-      }
-      for (SubscriptValue i{0}; i < rows; ++i) {
-        *p++ += static_cast<ResultType>(*xp++) * yv;
-      }
-    }
+  // A panel holds about 64KiB of the result type, which fits in the L2
+  // cache of current hosts.
+  constexpr SubscriptValue rowBlock{2048 / sizeof(ResultType)};
+  constexpr SubscriptValue kBlock{32};
+  auto xColumn{[&](SubscriptValue k) -> const XT * {
     if constexpr (!X_HAS_STRIDED_COLUMNS) {
-      xp0 += rows;
+      return x + k * rows;
     } else {
-      xp0 = reinterpret_cast<const XT *>(
-          reinterpret_cast<const char *>(xp0) + xColumnByteStride);
+      return reinterpret_cast<const XT *>(
+          reinterpret_cast<const char *>(x) + k * xColumnByteStride);
+    }
+  }};
+  auto yElement{[&](SubscriptValue k, SubscriptValue j) -> ResultType {
+    if constexpr (!Y_HAS_STRIDED_COLUMNS) {
+      return static_cast<ResultType>(y[k + j * n]);
+    } else {
+      return static_cast<ResultType>(reinterpret_cast<const YT *>(
+          reinterpret_cast<const char *>(y) + j * yColumnByteStride)[k]);
+    }
+  }};
+  std::memset(product, 0, rows * cols * sizeof *product);
+  for (SubscriptValue i0{0}; i0 < rows; i0 += rowBlock) {
+    SubscriptValue iEnd{std::min(rows, i0 + rowBlock)};
+    for (SubscriptValue k0{0}; k0 < n; k0 += kBlock) {
+      SubscriptValue kEnd{std::min(n, k0 + kBlock)};
+      for (SubscriptValue j{0}; j < cols; ++j) {
+        ResultType *RESTRICT p{product + j * rows};
+        SubscriptValue k{k0};
+        // Apply four columns of X per pass over the block of the result
+        // column, so that it is loaded and stored a quarter as often.
+        for (; k + 4 <= kEnd; k += 4) {
+          const XT *RESTRICT x0{xColumn(k)};
+          const XT *RESTRICT x1{xColumn(k + 1)};
+          const XT *RESTRICT x2{xColumn(k + 2)};
+          const XT *RESTRICT x3{xColumn(k + 3)};
+          ResultType y0{yElement(k, j)};
+          ResultType y1{yElement(k + 1, j)};
+          ResultType y2{yElement(k + 2, j)};
+          ResultType y3{yElement(k + 3, j)};
+          for (SubscriptValue i{i0}; i < iEnd; ++i) {
+            ResultType sum{p[i]};
+            sum += static_cast<ResultType>(x0[i]) * y0;
+            sum += static_cast<ResultType>(x1[i]) * y1;
+            sum += static_cast<ResultType>(x2[i]) * y2;
+            sum += static_cast<ResultType>(x3[i]) * y3;
+            p[i] = sum;
+          }
+        }
+        for (; k < kEnd; ++k) {
+          const XT *RESTRICT xk{xColumn(k)};
+          ResultType yv{yElement(k, j)};
+          for (SubscriptValue i{i0}; i < iEnd; ++i) {
+            p[i] += static_cast<ResultType>(xk[i]) * yv;
+          }
+        }
+      }
     }
   }
 }
@@ -198,3 +198,35 @@ TEST(Matmul, Basic) {
   EXPECT_TRUE(
       static_cast<bool>(*result.ZeroBasedIndexedElement<std::uint16_t>(3)));
 }
+
+TEST(Matmul, Blocked) {
+  // Large enough to span several row and K blocks of the kernel.
+  constexpr int rows{300}, n{70}, cols{3};
+  std::vector<double> xData(rows * n), yData(n * cols);
+  for (int j{0}; j < rows * n; ++j) {
+    xData[j] = j % 13 - 6;
+  }
+  for (int j{0}; j < n * cols; ++j) {
+    yData[j] = j % 7 - 3;
+  }
+  auto x{MakeArray<TypeCategory::Real, 8>(std::vector<int>{rows, n}, xData)};
+  auto y{MakeArray<TypeCategory::Real, 8>(std::vector<int>{n, cols}, yData)};
+
+  StaticDescriptor<2, true> statDesc;
+  Descriptor &result{statDesc.descriptor()};
+  RTNAME(Matmul)(result, *x, *y, __FILE__, __LINE__);
+  ASSERT_EQ(result.rank(), 2);
+  EXPECT_EQ(result.GetDimension(0).Extent(), rows);
+  EXPECT_EQ(result.GetDimension(1).Extent(), cols);
+  ASSERT_EQ(result.type(), (TypeCode{TypeCategory::Real, 8}));
+  for (int j{0}; j < cols; ++j) {
+    for (int i{0}; i < rows; ++i) {
+      double expect{0};
+      for (int k{0}; k < n; ++k) {
+        expect += xData[i + k * rows] * yData[k + j * n];
+      }
+      EXPECT_EQ(*result.ZeroBasedIndexedElement<double>(i + j * rows), expect);
+    }
+  }
+  result.Destroy();
+}
@@ -233,3 +233,35 @@ TEST(MatmulTranspose, Basic) {
   EXPECT_TRUE(
       static_cast<bool>(*result.ZeroBasedIndexedElement<std::uint16_t>(1)));
 }
+
+TEST(MatmulTranspose, Unrolled) {
+  // The row count leaves a remainder after the groups of four rows.
+  constexpr int rows{11}, n{37}, cols{3};
+  std::vector<double> xData(n * rows), yData(n * cols);
+  for (int j{0}; j < n * rows; ++j) {
+    xData[j] = j % 13 - 6;
+  }
+  for (int j{0}; j < n * cols; ++j) {
+    yData[j] = j % 7 - 3;
+  }
+  auto x{MakeArray<TypeCategory::Real, 8>(std::vector<int>{n, rows}, xData)};
+  auto y{MakeArray<TypeCategory::Real, 8>(std::vector<int>{n, cols}, yData)};
+
+  StaticDescriptor<2, true> statDesc;
+  Descriptor &result{statDesc.descriptor()};
+  RTNAME(MatmulTranspose)(result, *x, *y, __FILE__, __LINE__);
+  ASSERT_EQ(result.rank(), 2);
+  EXPECT_EQ(result.GetDimension(0).Extent(), rows);
+  EXPECT_EQ(result.GetDimension(1).Extent(), cols);
+  ASSERT_EQ(result.type(), (TypeCode{TypeCategory::Real, 8}));
+  for (int j{0}; j < cols; ++j) {
+    for (int i{0}; i < rows; ++i) {
+      double expect{0};
+      for (int k{0}; k < n; ++k) {
+        expect += xData[k + i * n] * yData[k + j * n];
+      }
+      EXPECT_EQ(*result.ZeroBasedIndexedElement<double>(i + j * rows), expect);
+    }
+  }
+  result.Destroy();
+}
@@ -975,3 +975,45 @@ TEST(IOApiTests, ConfusingMinimization) {
   EXPECT_TRUE(CompareFormattedStrings(" 65504. ", got))
       << "expected ' 65504. ', got '" << got << '\''; // not 65500.!
 }
+
+// Repeated data edit descriptors applied to whole arrays, including repeat
+// counts that end in the middle of an array and format reversion.
+TEST(IOApiTests, RepeatedEditArrayOutput) {
+  static constexpr int numLines{3};
+  static constexpr int lineLength{24};
+  char buffer[numLines][lineLength];
+  StaticDescriptor<1> wholeStaticDescriptor;
+  Descriptor &whole{wholeStaticDescriptor.descriptor()};
+  static const SubscriptValue lineExtent[]{numLines};
+  whole.Establish(TypeCode{CFI_type_char}, /*elementBytes=*/lineLength, &buffer,
+      1, lineExtent, CFI_attribute_pointer);
+
+  const char *format{"(I3,2I4/(3F6.1))"};
+  auto cookie{IONAME(BeginInternalArrayFormattedOutput)(
+      whole, format, std::strlen(format))};
+
+  std::int32_t ints[]{1, 22, 333};
+  StaticDescriptor<1> intStaticDescriptor;
+  Descriptor &intDesc{intStaticDescriptor.descriptor()};
+  static const SubscriptValue intExtent[]{3};
+  intDesc.Establish(TypeCode{CFI_type_int32_t}, sizeof ints[0], ints, 1,
+      intExtent);
+  EXPECT_TRUE(IONAME(OutputDescriptor)(cookie, intDesc));
+
+  double reals[]{0.5, 1.5, 2.5, 3.5, 4.5};
+  StaticDescriptor<1> realStaticDescriptor;
+  Descriptor &realDesc{realStaticDescriptor.descriptor()};
+  static const SubscriptValue realExtent[]{5};
+  realDesc.Establish(TypeCode{CFI_type_double}, sizeof reals[0], reals, 1,
+      realExtent);
+  EXPECT_TRUE(IONAME(OutputDescriptor)(cookie, realDesc));
+
+  auto status{IONAME(EndIoStatement)(cookie)};
+  ASSERT_EQ(status, 0);
+  static const std::string expect{"  1  22 333             "
+                                  "   0.5   1.5   2.5      "
+                                  "   3.5   4.5            "};
+  std::string got{buffer[0], sizeof buffer};
+  EXPECT_TRUE(CompareFormattedStrings(expect, got))
+      << "Expected '" << expect << "' but got '" << got << "'";
+}
@@ -0,0 +1,15 @@
+//===--- Tracking whether the process has started threads -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/__support/threads/single_threaded.h"
+
+namespace LIBC_NAMESPACE {
+
+cpp::Atomic<bool> process_started_threads(false);
+
+} // namespace LIBC_NAMESPACE
@@ -0,0 +1,40 @@
+//===--- Tracking whether the process has started threads -------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC___SUPPORT_THREADS_SINGLE_THREADED_H
+#define LLVM_LIBC_SRC___SUPPORT_THREADS_SINGLE_THREADED_H
+
+#include "src/__support/CPP/atomic.h"
+#include "src/__support/macros/attributes.h" // LIBC_INLINE
+
+namespace LIBC_NAMESPACE {
+
+// Set before the first thread of the process is started and never cleared,
+// even once that thread exits: a lock may still be held on its behalf, and
+// memory it wrote may still be in flight.
+extern cpp::Atomic<bool> process_started_threads;
+
+// Returns true while the calling thread is the only thread the process ever
+// had. Internal locks that only protect against other threads of this process,
+// like the lock of a FILE, may be skipped while this holds. Code that skips a
+// lock must remember that it did and not unlock it, since a thread can be
+// started while the lock would have been held.
+LIBC_INLINE bool is_single_threaded() {
+  // Only the calling thread can start the first thread, so it observes its own
+  // store and a relaxed load is enough.
+  return !process_started_threads.load(cpp::MemoryOrder::RELAXED);
+}
+
+// Called by the thread creation functions before starting a thread.
+LIBC_INLINE void mark_process_multi_threaded() {
+  process_started_threads.store(true, cpp::MemoryOrder::RELAXED);
+}
+
+} // namespace LIBC_NAMESPACE
+
+#endif // LLVM_LIBC_SRC___SUPPORT_THREADS_SINGLE_THREADED_H
@@ -17,6 +17,7 @@
 
 #include "src/__support/common.h"
 #include "src/__support/macros/optimization.h"
+#include "src/__support/threads/single_threaded.h"
 #include "src/__support/threads/thread.h"
 
 #include <errno.h>
@@ -76,6 +77,9 @@ LLVM_LIBC_FUNCTION(int, pthread_create,
   // Thread::run will check validity of the `stack` argument (stack alignment is
   // universal, not sure a pthread requirement).
 
+  // From here on locks that only guard against other threads can't be elided.
+  mark_process_multi_threaded();
+
   auto *thread = reinterpret_cast<LIBC_NAMESPACE::Thread *>(th);
   int result = thread->run(func, arg, stack, stacksize, guardsize,
                            detachstate == PTHREAD_CREATE_DETACHED);
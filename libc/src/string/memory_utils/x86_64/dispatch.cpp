@@ -0,0 +1,86 @@
+//===-- Selection of the x86_64 memory functions variant ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/string/memory_utils/x86_64/dispatch.h"
+
+#include <stdint.h>
+
+namespace LIBC_NAMESPACE {
+namespace x86_64_dispatch {
+
+const MemoryFunctions *selected_functions = nullptr;
+
+namespace {
+
+struct CpuidResult {
+  uint32_t eax, ebx, ecx, edx;
+};
+
+CpuidResult cpuid(uint32_t leaf, uint32_t subleaf) {
+  CpuidResult r;
+  asm volatile("cpuid"
+               : "=a"(r.eax), "=b"(r.ebx), "=c"(r.ecx), "=d"(r.edx)
+               : "a"(leaf), "c"(subleaf));
+  return r;
+}
+
+// The register state the OS saves on context switches (XCR0).
+uint64_t xgetbv() {
+  uint32_t eax, edx;
+  asm volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (uint64_t(edx) << 32) | eax;
+}
+
+bool bit(uint32_t reg, int i) { return (reg >> i) & 1; }
+
+const MemoryFunctions *choose() {
+  const uint32_t max_leaf = cpuid(0, 0).eax;
+  const CpuidResult leaf1 = cpuid(1, 0);
+  if (!bit(leaf1.ecx, 20)) // SSE4.2
+    return &sse2_functions;
+
+  // AVX registers are only usable if the OS saves them.
+  const uint64_t xcr0 = bit(leaf1.ecx, 27) ? xgetbv() : 0; // OSXSAVE
+  const bool os_ymm = (xcr0 & 0x6) == 0x6;   // XMM and YMM state
+  const bool os_zmm = (xcr0 & 0xe6) == 0xe6; // and opmask and ZMM state
+  const CpuidResult leaf7 = max_leaf >= 7 ? cpuid(7, 0) : CpuidResult{};
+  const uint32_t max_ext_leaf = cpuid(0x80000000, 0).eax;
+  const CpuidResult ext_leaf1 =
+      max_ext_leaf >= 0x80000001 ? cpuid(0x80000001, 0) : CpuidResult{};
+
+  // The features -march=haswell lets the compiler use.
+  const bool haswell = os_ymm && bit(leaf1.ecx, 28) &&     // AVX
+                       bit(leaf1.ecx, 12) &&               // FMA
+                       bit(leaf1.ecx, 22) &&               // MOVBE
+                       bit(leaf1.ecx, 23) &&               // POPCNT
+                       bit(leaf1.ecx, 29) &&               // F16C
+                       bit(leaf7.ebx, 5) &&                // AVX2
+                       bit(leaf7.ebx, 3) && bit(leaf7.ebx, 8) && // BMI1, BMI2
+                       bit(ext_leaf1.ecx, 5);              // LZCNT
+  if (!haswell)
+    return &sse4_functions;
+
+  // And the ones -march=skylake-avx512 adds.
+  const bool skylake_avx512 = os_zmm && bit(leaf7.ebx, 16) && // AVX512F
+                              bit(leaf7.ebx, 17) &&           // AVX512DQ
+                              bit(leaf7.ebx, 28) &&           // AVX512CD
+                              bit(leaf7.ebx, 30) &&           // AVX512BW
+                              bit(leaf7.ebx, 31);             // AVX512VL
+  return skylake_avx512 ? &avx512_functions : &avx2_functions;
+}
+
+} // namespace
+
+const MemoryFunctions *select_memory_functions() {
+  const MemoryFunctions *functions = choose();
+  __atomic_store_n(&selected_functions, functions, __ATOMIC_RELAXED);
+  return functions;
+}
+
+} // namespace x86_64_dispatch
+} // namespace LIBC_NAMESPACE
@@ -0,0 +1,63 @@
+//===-- Runtime dispatch of the x86_64 memory functions ---------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// The memory functions are normally built for the instruction set the library
+// is compiled for. With LIBC_CONF_STRING_RUNTIME_DISPATCH the library instead
+// carries one copy of them per microarchitecture level and picks one the first
+// time a memory function is called, based on CPUID.
+//
+// Statically linked binaries don't run IRELATIVE relocations, so the choice is
+// cached in a pointer instead of going through an ifunc.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STRING_MEMORY_UTILS_X86_64_DISPATCH_H
+#define LLVM_LIBC_SRC_STRING_MEMORY_UTILS_X86_64_DISPATCH_H
+
+#include "src/__support/macros/attributes.h"   // LIBC_INLINE
+#include "src/__support/macros/optimization.h" // LIBC_UNLIKELY
+
+#include <stddef.h> // size_t
+
+namespace LIBC_NAMESPACE {
+namespace x86_64_dispatch {
+
+struct MemoryFunctions {
+  void *(*memcpy)(void *__restrict, const void *__restrict, size_t);
+  void *(*memmove)(void *, const void *, size_t);
+  void *(*memset)(void *, int, size_t);
+  int (*memcmp)(const void *, const void *, size_t);
+  int (*bcmp)(const void *, const void *, size_t);
+};
+
+// Defined by dispatch_variant.cpp, which is built once per instruction set.
+extern const MemoryFunctions sse2_functions;   // -march=k8
+extern const MemoryFunctions sse4_functions;   // -march=nehalem
+extern const MemoryFunctions avx2_functions;   // -march=haswell
+extern const MemoryFunctions avx512_functions; // -march=skylake-avx512
+
+// The variant chosen for the running CPU, or nullptr before the first call.
+extern const MemoryFunctions *selected_functions;
+
+// Chooses the variant for the running CPU and stores it in selected_functions.
+const MemoryFunctions *select_memory_functions();
+
+LIBC_INLINE const MemoryFunctions &memory_functions() {
+  // The tables are constant, so a relaxed load is enough. Threads racing on
+  // the first call all store the same pointer.
+  const MemoryFunctions *functions =
+      __atomic_load_n(&selected_functions, __ATOMIC_RELAXED);
+  if (LIBC_UNLIKELY(functions == nullptr))
+    functions = select_memory_functions();
+  return *functions;
+}
+
+} // namespace x86_64_dispatch
+} // namespace LIBC_NAMESPACE
+
+#endif // LLVM_LIBC_SRC_STRING_MEMORY_UTILS_X86_64_DISPATCH_H
@@ -0,0 +1,67 @@
+//===-- One instruction set variant of the memory functions ---------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file is built once per entry of dispatch.h, with the -march of that
+// entry and LIBC_COPT_STRING_DISPATCH_VARIANT set to its name. The inline
+// implementations pick their code paths from the target macros (__AVX2__,
+// __AVX512F__...) so every build gets the loops of its instruction set.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/string/memory_utils/x86_64/dispatch.h"
+
+#include "src/string/memory_utils/inline_bcmp.h"
+#include "src/string/memory_utils/inline_memcmp.h"
+#include "src/string/memory_utils/inline_memcpy.h"
+#include "src/string/memory_utils/inline_memmove.h"
+#include "src/string/memory_utils/inline_memset.h"
+
+#ifndef LIBC_COPT_STRING_DISPATCH_VARIANT
+#error "LIBC_COPT_STRING_DISPATCH_VARIANT must name the variant being built."
+#endif
+
+#define LIBC_DISPATCH_CONCAT_IMPL(a, b) a##b
+#define LIBC_DISPATCH_CONCAT(a, b) LIBC_DISPATCH_CONCAT_IMPL(a, b)
+
+namespace LIBC_NAMESPACE {
+namespace x86_64_dispatch {
+namespace {
+
+void *memcpy_variant(void *__restrict dst, const void *__restrict src,
+                     size_t count) {
+  inline_memcpy(dst, src, count);
+  return dst;
+}
+
+void *memmove_variant(void *dst, const void *src, size_t count) {
+  inline_memmove(dst, src, count);
+  return dst;
+}
+
+void *memset_variant(void *dst, int value, size_t count) {
+  inline_memset(dst, static_cast<uint8_t>(value), count);
+  return dst;
+}
+
+int memcmp_variant(const void *lhs, const void *rhs, size_t count) {
+  return inline_memcmp(lhs, rhs, count);
+}
+
+int bcmp_variant(const void *lhs, const void *rhs, size_t count) {
+  return inline_bcmp(lhs, rhs, count);
+}
+
+} // namespace
+
+extern const MemoryFunctions
+    LIBC_DISPATCH_CONCAT(LIBC_COPT_STRING_DISPATCH_VARIANT, _functions) = {
+        memcpy_variant, memmove_variant, memset_variant, memcmp_variant,
+        bcmp_variant};
+
+} // namespace x86_64_dispatch
+} // namespace LIBC_NAMESPACE
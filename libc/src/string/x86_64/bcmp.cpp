@@ -0,0 +1,20 @@
+//===-- Implementation of bcmp with runtime dispatch ----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/string/bcmp.h"
+#include "src/__support/common.h"
+#include "src/string/memory_utils/x86_64/dispatch.h"
+
+namespace LIBC_NAMESPACE {
+
+LLVM_LIBC_FUNCTION(int, bcmp,
+                   (const void *lhs, const void *rhs, size_t count)) {
+  return x86_64_dispatch::memory_functions().bcmp(lhs, rhs, count);
+}
+
+} // namespace LIBC_NAMESPACE
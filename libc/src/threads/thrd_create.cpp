@@ -8,6 +8,7 @@
 
 #include "src/threads/thrd_create.h"
 #include "src/__support/common.h"
+#include "src/__support/threads/single_threaded.h"
 #include "src/__support/threads/thread.h"
 
 #include <errno.h>
@@ -20,6 +21,9 @@ static_assert(sizeof(thrd_t) == sizeof(LIBC_NAMESPACE::Thread),
 
 LLVM_LIBC_FUNCTION(int, thrd_create,
                    (thrd_t * th, thrd_start_t func, void *arg)) {
+  // From here on locks that only guard against other threads can't be elided.
+  mark_process_multi_threaded();
+
   auto *thread = reinterpret_cast<LIBC_NAMESPACE::Thread *>(th);
   int result = thread->run(func, arg);
   if (result == 0)
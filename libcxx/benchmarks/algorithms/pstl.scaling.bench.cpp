@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Compares the parallel algorithms run with std::execution::par against the same calls with std::execution::seq,
+// to show how the configured PSTL backend scales.
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <random>
+#include <vector>
+
+template <class Policy>
+static void bm_for_each(benchmark::State& state, Policy policy) {
+  std::vector<double> vec(state.range(), 1.5);
+  for (auto _ : state) {
+    std::for_each(policy, vec.begin(), vec.end(), [](double& d) { d = std::sqrt(d * d + 1.0); });
+    benchmark::DoNotOptimize(vec);
+  }
+}
+BENCHMARK_CAPTURE(bm_for_each, seq, std::execution::seq)->Range(1 << 10, 1 << 24);
+BENCHMARK_CAPTURE(bm_for_each, par, std::execution::par)->Range(1 << 10, 1 << 24);
+
+template <class Policy>
+static void bm_transform_reduce(benchmark::State& state, Policy policy) {
+  std::vector<double> vec(state.range(), 1.5);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec);
+    benchmark::DoNotOptimize(std::transform_reduce(
+        policy, vec.begin(), vec.end(), 0.0, std::plus<>(), [](double d) { return std::sqrt(d); }));
+  }
+}
+BENCHMARK_CAPTURE(bm_transform_reduce, seq, std::execution::seq)->Range(1 << 10, 1 << 24);
+BENCHMARK_CAPTURE(bm_transform_reduce, par, std::execution::par)->Range(1 << 10, 1 << 24);
+
+template <class Policy>
+static void bm_stable_sort(benchmark::State& state, Policy policy) {
+  std::vector<std::uint64_t> input(state.range());
+  std::mt19937_64 rng(42);
+  for (auto& e : input)
+    e = rng();
+
+  std::vector<std::uint64_t> vec;
+  for (auto _ : state) {
+    state.PauseTiming();
+    vec = input;
+    state.ResumeTiming();
+    std::stable_sort(policy, vec.begin(), vec.end());
+    benchmark::DoNotOptimize(vec);
+  }
+}
+BENCHMARK_CAPTURE(bm_stable_sort, seq, std::execution::seq)->Range(1 << 10, 1 << 22);
+BENCHMARK_CAPTURE(bm_stable_sort, par, std::execution::par)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Compares the vectorized std::find, std::count and std::mismatch on contiguous ranges with the scalar loops they
+// replace. The *_scalar benchmarks run the loop libc++ used before on the same data.
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+template <class T>
+__attribute__((noinline)) const T* scalar_find(const T* first, const T* last, T value) {
+  for (; first != last; ++first)
+    if (*first == value)
+      break;
+  return first;
+}
+
+template <class T>
+__attribute__((noinline)) std::ptrdiff_t scalar_count(const T* first, const T* last, T value) {
+  std::ptrdiff_t r = 0;
+  for (; first != last; ++first)
+    if (*first == value)
+      ++r;
+  return r;
+}
+
+template <class T>
+__attribute__((noinline)) const T* scalar_mismatch(const T* first1, const T* last1, const T* first2) {
+  for (; first1 != last1; ++first1, ++first2)
+    if (!(*first1 == *first2))
+      break;
+  return first1;
+}
+
+template <class T, bool Scalar>
+static void bm_find(benchmark::State& state) {
+  std::vector<T> vec(state.range(), T(1));
+  std::mt19937_64 rng(std::random_device{}());
+
+  for (auto _ : state) {
+    auto idx = rng() % vec.size();
+    vec[idx] = T(2);
+    benchmark::DoNotOptimize(vec);
+    if constexpr (Scalar)
+      benchmark::DoNotOptimize(scalar_find(vec.data(), vec.data() + vec.size(), T(2)));
+    else
+      benchmark::DoNotOptimize(std::find(vec.begin(), vec.end(), T(2)));
+    vec[idx] = T(1);
+  }
+}
+BENCHMARK(bm_find<std::uint16_t, false>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_find<std::uint16_t, true>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_find<std::uint64_t, false>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_find<std::uint64_t, true>)->DenseRange(1, 8)->Range(16, 1 << 20);
+
+template <class T, bool Scalar>
+static void bm_count(benchmark::State& state) {
+  std::vector<T> vec(state.range());
+  std::mt19937_64 rng(std::random_device{}());
+  for (auto& e : vec)
+    e = T(rng() % 4);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec);
+    if constexpr (Scalar)
+      benchmark::DoNotOptimize(scalar_count(vec.data(), vec.data() + vec.size(), T(1)));
+    else
+      benchmark::DoNotOptimize(std::count(vec.begin(), vec.end(), T(1)));
+  }
+}
+BENCHMARK(bm_count<std::uint8_t, false>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_count<std::uint8_t, true>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_count<std::uint32_t, false>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_count<std::uint32_t, true>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_count<std::uint64_t, false>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_count<std::uint64_t, true>)->DenseRange(1, 8)->Range(16, 1 << 20);
+
+template <class T, bool Scalar>
+static void bm_mismatch(benchmark::State& state) {
+  std::vector<T> vec1(state.range(), T(1));
+  std::vector<T> vec2(state.range(), T(1));
+  std::mt19937_64 rng(std::random_device{}());
+
+  for (auto _ : state) {
+    auto idx  = rng() % vec1.size();
+    vec1[idx] = T(2);
+    benchmark::DoNotOptimize(vec1);
+    if constexpr (Scalar)
+      benchmark::DoNotOptimize(scalar_mismatch(vec1.data(), vec1.data() + vec1.size(), vec2.data()));
+    else
+      benchmark::DoNotOptimize(std::mismatch(vec1.begin(), vec1.end(), vec2.begin()));
+    vec1[idx] = T(1);
+  }
+}
+BENCHMARK(bm_mismatch<int*, false>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_mismatch<int*, true>)->DenseRange(1, 8)->Range(16, 1 << 20);
+
+BENCHMARK_MAIN();
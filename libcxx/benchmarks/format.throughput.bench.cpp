@@ -0,0 +1,112 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Measures the throughput of formatting log-like lines, which mix runs of literal text with a few replacement fields.
+// The benchmarks report the number of bytes produced per second.
+
+#include <format>
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "benchmark/benchmark.h"
+#include "make_string.h"
+#include "test_macros.h"
+
+#define CSTR(S) MAKE_CSTRING(CharT, S)
+
+template <class CharT>
+static void BM_format_literal(benchmark::State& state) {
+  std::basic_string<CharT> result;
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    result = std::format(CSTR("the quick brown fox jumps over the lazy dog, twice; then it rests for a while"));
+    benchmark::DoNotOptimize(result);
+    bytes += result.size() * sizeof(CharT);
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_format_literal<char>);
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+BENCHMARK(BM_format_literal<wchar_t>);
+#endif
+
+template <class CharT>
+static void BM_format_log_line(benchmark::State& state) {
+  std::basic_string<CharT> result;
+  std::size_t bytes = 0;
+  int request       = 0;
+  for (auto _ : state) {
+    result = std::format(
+        CSTR("[worker {:>2}] request {} finished: status={} elapsed={:.3f}ms path={}"),
+        request % 16,
+        request,
+        200,
+        request * 0.125,
+        std::basic_string_view<CharT>{CSTR("/api/v1/items")});
+    benchmark::DoNotOptimize(result);
+    bytes += result.size() * sizeof(CharT);
+    ++request;
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_format_log_line<char>);
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+BENCHMARK(BM_format_log_line<wchar_t>);
+#endif
+
+template <class CharT>
+static void BM_format_to_log_line(benchmark::State& state) {
+  std::basic_string<CharT> result;
+  std::size_t bytes = 0;
+  int request       = 0;
+  for (auto _ : state) {
+    // Reuse the storage of the previous iteration, like a logger appending to its buffer.
+    result.clear();
+    std::format_to(std::back_inserter(result),
+                   CSTR("[worker {:>2}] request {} finished: status={} path={}\n"),
+                   request % 16,
+                   request,
+                   200,
+                   std::basic_string_view<CharT>{CSTR("/api/v1/items")});
+    benchmark::DoNotOptimize(result);
+    bytes += result.size() * sizeof(CharT);
+    ++request;
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_format_to_log_line<char>);
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+BENCHMARK(BM_format_to_log_line<wchar_t>);
+#endif
+
+template <class CharT>
+static void BM_format_escaped_braces(benchmark::State& state) {
+  std::basic_string<CharT> result;
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    result = std::format(CSTR("{{\"id\": {}, \"name\": \"{}\", \"tags\": {{}}}}"), 42, CSTR("item"));
+    benchmark::DoNotOptimize(result);
+    bytes += result.size() * sizeof(CharT);
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_format_escaped_braces<char>);
+#ifndef TEST_HAS_NO_WIDE_CHARACTERS
+BENCHMARK(BM_format_escaped_braces<wchar_t>);
+#endif
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  benchmark::RunSpecifiedBenchmarks();
+}
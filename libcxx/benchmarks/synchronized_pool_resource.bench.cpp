@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Measures allocations and deallocations from a pmr::synchronized_pool_resource shared by a growing number of
+// threads. Each thread keeps a window of live blocks of mixed small sizes, so blocks are reused as they would be by
+// containers using the resource. The new_delete_resource benchmarks show the cost without a pool.
+
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+static std::pmr::synchronized_pool_resource& shared_pool() {
+  static std::pmr::synchronized_pool_resource pool;
+  return pool;
+}
+
+template <class GetResource>
+static void run(benchmark::State& state, GetResource get_resource) {
+  std::pmr::memory_resource* resource = get_resource();
+  const std::size_t window            = 64;
+  std::vector<std::pair<void*, std::size_t>> live(window, {nullptr, 0});
+  std::size_t next = 0;
+
+  for (auto _ : state) {
+    auto& [ptr, size] = live[next % window];
+    if (ptr != nullptr)
+      resource->deallocate(ptr, size);
+    size = 8 << (next % 7); // 8 to 512 bytes
+    ptr  = resource->allocate(size);
+    benchmark::DoNotOptimize(ptr);
+    ++next;
+  }
+
+  for (auto& [ptr, size] : live)
+    if (ptr != nullptr)
+      resource->deallocate(ptr, size);
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_synchronized_pool_resource(benchmark::State& state) { run(state, shared_pool); }
+BENCHMARK(BM_synchronized_pool_resource)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_new_delete_resource(benchmark::State& state) { run(state, std::pmr::new_delete_resource); }
+BENCHMARK(BM_new_delete_resource)->ThreadRange(1, 32)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -12,7 +12,9 @@
 
 #include <__algorithm/find_segment_if.h>
 #include <__algorithm/min.h>
+#include <__algorithm/simd_utils.h>
 #include <__algorithm/unwrap_iter.h>
+#include <__bit/bit_cast.h>
 #include <__bit/countr.h>
 #include <__bit/invert_if.h>
 #include <__config>
@@ -21,9 +23,13 @@
 #include <__fwd/bit_reference.h>
 #include <__iterator/segmented_iterator.h>
 #include <__string/constexpr_c_functions.h>
+#include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/is_equality_comparable.h>
 #include <__type_traits/is_integral.h>
 #include <__type_traits/is_same.h>
 #include <__type_traits/is_signed.h>
+#include <__type_traits/is_volatile.h>
+#include <__type_traits/remove_cv.h>
 #include <__utility/move.h>
 #include <limits>
 
@@ -77,6 +83,78 @@ _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _Tp* __find(_Tp* __first, _T
 }
 #endif // _LIBCPP_HAS_NO_WIDE_CHARACTERS
 
+#if _LIBCPP_VECTORIZE_ALGORITHMS
+template <class _Tp>
+_LIBCPP_HIDE_FROM_ABI const _Tp* __find_vectorized(const _Tp* __first, const _Tp* __last, _Tp __value) {
+  constexpr size_t __unroll_count = 4;
+  constexpr size_t __vec_size     = __native_vector_size<_Tp>;
+  using __vec                     = __simd_vector<_Tp, __vec_size>;
+
+  auto __orig_first = __first;
+  while (static_cast<size_t>(__last - __first) >= __unroll_count * __vec_size) [[__unlikely__]] {
+    __vec __vecs[__unroll_count];
+
+    for (size_t __i = 0; __i != __unroll_count; ++__i)
+      __vecs[__i] = std::__load_vector<__vec>(__first + __i * __vec_size);
+
+    for (size_t __i = 0; __i != __unroll_count; ++__i) {
+      if (auto __cmp_res = __vecs[__i] == __value; std::__any_of(__cmp_res))
+        return __first + __i * __vec_size + std::__find_first_set(__cmp_res);
+    }
+
+    __first += __unroll_count * __vec_size;
+  }
+
+  // check the remaining 0-3 vectors
+  while (static_cast<size_t>(__last - __first) >= __vec_size) {
+    if (auto __cmp_res = std::__load_vector<__vec>(__first) == __value; std::__any_of(__cmp_res))
+      return __first + std::__find_first_set(__cmp_res);
+    __first += __vec_size;
+  }
+
+  if (__last - __first == 0)
+    return __first;
+
+  // Check if we can load elements in front of the current pointer. If that's the case load a vector at
+  // (last - vector_size) to check the remaining elements. The elements in front of __first are known not to match, so
+  // the first match in that vector is the first match in the range.
+  if (static_cast<size_t>(__first - __orig_first) >= __vec_size) {
+    __first = __last - __vec_size;
+    return __first + std::__find_first_set(std::__load_vector<__vec>(__first) == __value);
+  }
+
+  for (; __first != __last; ++__first)
+    if (*__first == __value)
+      break;
+  return __first;
+}
+
+// Element types that aren't handled by memchr or wmemchr above, but can be compared as unsigned integers.
+template <class _Tp, class _Up, class _Proj>
+inline constexpr bool __find_vectorizable_v =
+    __is_identity<_Proj>::value && __libcpp_is_trivially_equality_comparable<_Tp, _Up>::value &&
+    !is_volatile<_Tp>::value && __can_map_to_integer_v<_Tp> && sizeof(_Tp) != 1
+#  ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
+    && !(sizeof(_Tp) == sizeof(wchar_t) && _LIBCPP_ALIGNOF(_Tp) >= _LIBCPP_ALIGNOF(wchar_t))
+#  endif
+    ;
+
+template <class _Tp, class _Up, class _Proj, __enable_if_t<__find_vectorizable_v<_Tp, _Up, _Proj>, int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _Tp*
+__find(_Tp* __first, _Tp* __last, const _Up& __value, _Proj&) {
+  if (!__libcpp_is_constant_evaluated()) {
+    using _Int        = __get_as_integer_type_t<__remove_cv_t<_Tp> >;
+    const _Int* __ptr = reinterpret_cast<const _Int*>(__first);
+    return __first +
+           (std::__find_vectorized(__ptr, __ptr + (__last - __first), std::__bit_cast<_Int>(__value)) - __ptr);
+  }
+  for (; __first != __last; ++__first)
+    if (*__first == __value)
+      break;
+  return __first;
+}
+#endif // _LIBCPP_VECTORIZE_ALGORITHMS
+
 // TODO: This should also be possible to get right with different signedness
 // cast integral types to allow vectorization
 template <class _Tp,
@@ -28,6 +28,7 @@
 #include <__format/formatter_char.h>
 #include <__format/formatter_floating_point.h>
 #include <__format/formatter_integer.h>
+#include <__format/formatter_output.h>
 #include <__format/formatter_pointer.h>
 #include <__format/formatter_string.h>
 #include <__format/parser_std_format_spec.h>
@@ -35,6 +36,8 @@
 #include <__iterator/concepts.h>
 #include <__iterator/incrementable_traits.h>
 #include <__iterator/iterator_traits.h> // iter_value_t
+#include <__type_traits/is_constant_evaluated.h>
+#include <__utility/move.h>
 #include <__variant/monostate.h>
 #include <array>
 #include <string>
@@ -330,8 +333,16 @@ _LIBCPP_HIDE_FROM_ABI constexpr typename _Ctx::iterator __vformat_to(_ParseCtx&&
       break;
     }
 
-    // Copy the character to the output verbatim.
-    *__out_it++ = *__begin++;
+    // Copy the literal text up to the next '{' or '}' verbatim. Writing the
+    // run in one go lets an __output_buffer copy it with its mass output
+    // function instead of storing the characters one at a time. While
+    // validating a basic_format_string nothing is written.
+    auto __first = __begin;
+    do
+      ++__begin;
+    while (__begin != __end && *__begin != _CharT('{') && *__begin != _CharT('}'));
+    if (!std::is_constant_evaluated())
+      __out_it = __formatter::__copy(__first, __begin, std::move(__out_it));
   }
   return __out_it;
 }
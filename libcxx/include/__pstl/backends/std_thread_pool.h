@@ -0,0 +1,174 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___PSTL_BACKENDS_STD_THREAD_POOL_H
+#define _LIBCPP___PSTL_BACKENDS_STD_THREAD_POOL_H
+
+#include <__algorithm/inplace_merge.h>
+#include <__config>
+#include <__iterator/iterator_traits.h>
+#include <__memory/allocator.h>
+#include <__memory/construct_at.h>
+#include <__memory/unique_ptr.h>
+#include <__utility/empty.h>
+#include <__utility/move.h>
+#include <cstddef>
+#include <optional>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#  pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+#if _LIBCPP_STD_VER >= 17
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __pstl {
+namespace __std_thread {
+
+// Runs __func(__context, __chunk) for every __chunk in [0, __chunk_count) on a thread pool that is created on first
+// use and reused by every later call. The pool has one worker less than the number of CPUs the process may run on,
+// because the calling thread runs chunks as well. Chunks are handed out one at a time, so threads that finish their
+// chunks early take over the remaining ones. Calls made from inside a chunk, or while the pool is busy with another
+// call, run their chunks on the calling thread.
+_LIBCPP_EXPORTED_FROM_ABI void
+__parallel_apply(size_t __chunk_count, void* __context, void (*__func)(void* __context, size_t __chunk)) noexcept;
+
+template <class _Func>
+_LIBCPP_HIDE_FROM_ABI void __parallel_apply(size_t __chunk_count, _Func __func) noexcept {
+  __std_thread::__parallel_apply(__chunk_count, &__func, [](void* __context, size_t __chunk) {
+    (*static_cast<_Func*>(__context))(__chunk);
+  });
+}
+
+struct __chunk_partitions {
+  ptrdiff_t __chunk_count_; // includes the first chunk
+  ptrdiff_t __chunk_size_;
+  ptrdiff_t __first_chunk_size_;
+};
+
+// Splits __size elements into a few chunks per thread of the pool, so that uneven chunks can be balanced between
+// threads. The first chunk takes the remainder.
+_LIBCPP_EXPORTED_FROM_ABI __chunk_partitions __partition_chunks(ptrdiff_t __size) noexcept;
+
+// Returns the offset of the first element of __chunk.
+_LIBCPP_HIDE_FROM_ABI inline ptrdiff_t __chunk_offset(__chunk_partitions __partitions, ptrdiff_t __chunk) noexcept {
+  if (__chunk == 0)
+    return 0;
+  return __partitions.__first_chunk_size_ + (__chunk - 1) * __partitions.__chunk_size_;
+}
+
+template <class _RandomAccessIterator, class _Functor>
+_LIBCPP_HIDE_FROM_ABI void
+__dispatch_parallel_for(__chunk_partitions __partitions, _RandomAccessIterator __first, _Functor __func) noexcept {
+  __std_thread::__parallel_apply(__partitions.__chunk_count_, [&](size_t __chunk) {
+    auto __index           = __std_thread::__chunk_offset(__partitions, __chunk);
+    auto __this_chunk_size = __chunk == 0 ? __partitions.__first_chunk_size_ : __partitions.__chunk_size_;
+    __func(__chunk, __first + __index, __first + __index + __this_chunk_size);
+  });
+}
+
+template <class _RandomAccessIterator, class _Functor>
+_LIBCPP_HIDE_FROM_ABI optional<__empty>
+__for_each(_RandomAccessIterator __first, _RandomAccessIterator __last, _Functor __func) noexcept {
+  __std_thread::__dispatch_parallel_for(
+      __std_thread::__partition_chunks(__last - __first),
+      std::move(__first),
+      [&](size_t, _RandomAccessIterator __chunk_first, _RandomAccessIterator __chunk_last) {
+        __func(std::move(__chunk_first), std::move(__chunk_last));
+      });
+  return __empty{};
+}
+
+template <class _Index, class _Transform, class _Value, class _Combiner, class _Reduction>
+_LIBCPP_HIDE_FROM_ABI optional<_Value> __transform_reduce(
+    _Index __first,
+    _Index __last,
+    _Transform __transform,
+    _Value __init,
+    _Combiner __combiner,
+    _Reduction __reduction) {
+  if (__first == __last)
+    return __init;
+
+  auto __partitions = __std_thread::__partition_chunks(__last - __first);
+  if (__partitions.__chunk_count_ == 1)
+    return __reduction(std::move(__first), std::move(__last), std::move(__init));
+
+  // Every chunk reduces into its own slot, and the slots are combined on the calling thread in chunk order.
+  size_t __size  = static_cast<size_t>(__partitions.__chunk_count_);
+  auto __destroy = [__size](_Value* __ptr) {
+    for (size_t __i = 0; __i != __size; ++__i)
+      std::__destroy_at(__ptr + __i);
+    allocator<_Value>().deallocate(__ptr, __size);
+  };
+  unique_ptr<_Value[], decltype(__destroy)> __values(allocator<_Value>().allocate(__size), __destroy);
+
+  __std_thread::__dispatch_parallel_for(
+      __partitions, __first, [&](size_t __chunk, _Index __chunk_first, _Index __chunk_last) {
+        std::__construct_at(
+            __values.get() + __chunk, __reduction(__chunk_first + 1, __chunk_last, __transform(*__chunk_first)));
+      });
+
+  for (size_t __i = 0; __i != __size; ++__i)
+    __init = __combiner(std::move(__init), std::move(__values[__i]));
+  return __init;
+}
+
+template <class _RandomAccessIterator, class _Comp, class _LeafSort>
+_LIBCPP_HIDE_FROM_ABI optional<__empty>
+__stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Comp __comp, _LeafSort __leaf_sort) {
+  auto __partitions = __std_thread::__partition_chunks(__last - __first);
+  if (__partitions.__chunk_count_ <= 1) {
+    __leaf_sort(__first, __last, __comp);
+    return __empty{};
+  }
+
+  // Sort the chunks in parallel, then merge neighbouring runs in rounds. The merges of a round are independent of
+  // each other and run in parallel as well.
+  __std_thread::__dispatch_parallel_for(
+      __partitions,
+      __first,
+      [&](size_t, _RandomAccessIterator __chunk_first, _RandomAccessIterator __chunk_last) {
+        __leaf_sort(__chunk_first, __chunk_last, __comp);
+      });
+
+  auto __run_begin = [&](ptrdiff_t __run) -> ptrdiff_t {
+    if (__run >= __partitions.__chunk_count_)
+      return __last - __first;
+    return __std_thread::__chunk_offset(__partitions, __run);
+  };
+  for (ptrdiff_t __width = 1; __width < __partitions.__chunk_count_; __width *= 2) {
+    size_t __merges = static_cast<size_t>((__partitions.__chunk_count_ + 2 * __width - 1) / (2 * __width));
+    __std_thread::__parallel_apply(__merges, [&](size_t __merge) {
+      ptrdiff_t __left = static_cast<ptrdiff_t>(__merge) * 2 * __width;
+      if (__left + __width >= __partitions.__chunk_count_)
+        return;
+      std::inplace_merge(__first + __run_begin(__left),
+                         __first + __run_begin(__left + __width),
+                         __first + __run_begin(__left + 2 * __width),
+                         __comp);
+    });
+  }
+  return __empty{};
+}
+
+} // namespace __std_thread
+} // namespace __pstl
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // _LIBCPP_STD_VER >= 17
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___PSTL_BACKENDS_STD_THREAD_POOL_H
@@ -18,6 +18,13 @@
 #  endif
 #endif
 
+#if defined(_LIBCPP_ABI_PMR_SYNCHRONIZED_POOL_THREAD_CACHE) && !defined(_LIBCPP_HAS_NO_THREADS)
+#  include <algorithm>
+#  include <atomic>
+#  include <mutex>
+#  include <thread>
+#endif
+
 _LIBCPP_BEGIN_NAMESPACE_STD
 
 namespace pmr {
@@ -410,6 +417,204 @@ void unsynchronized_pool_resource::do_deallocate(void* p, size_t bytes, size_t a
 
 bool synchronized_pool_resource::do_is_equal(const memory_resource& other) const noexcept { return &other == this; }
 
+#if defined(_LIBCPP_ABI_PMR_SYNCHRONIZED_POOL_THREAD_CACHE) && !defined(_LIBCPP_HAS_NO_THREADS)
+
+// Every thread that uses a synchronized_pool_resource gets a cache with a free
+// list per small block size. Allocations and deallocations of those sizes are
+// served from the cache of the calling thread without taking the lock. Only when
+// a free list runs empty, or grows past twice the batch size, does the thread
+// take the lock and move a batch of blocks from or to __unsync_. Blocks of one
+// size are interchangeable, so a block may be returned to the cache of another
+// thread than the one that allocated it.
+//
+// The caches are owned by the resource and live until it is destroyed; a thread
+// finds its cache through a few thread_local slots keyed by the id of the
+// resource. Ids are never reused, so the slots of a destroyed resource never
+// match again.
+
+static const int __log2_smallest_cached_block_size = 3;
+static const int __max_cached_sizes                = 8; // 8 to 1024 bytes
+static const size_t __cache_batch_size             = 32;
+
+static size_t __cached_block_size(int i) { return size_t(1) << (i + __log2_smallest_cached_block_size); }
+
+static size_t __cached_block_align(int i) { return std::min(__cached_block_size(i), alignof(max_align_t)); }
+
+// Returns the free list that serves bytes and align, or -1 if they aren't cached.
+static int __cached_size_index(size_t bytes, size_t align, int num_cached_sizes) {
+  if (align > alignof(max_align_t))
+    return -1;
+  bytes = std::max(bytes, align);
+  for (int i = 0; i != num_cached_sizes; ++i)
+    if (bytes <= __cached_block_size(i))
+      return i;
+  return -1;
+}
+
+struct synchronized_pool_resource::__thread_cache {
+  struct __free_block {
+    __free_block* __next_;
+  };
+
+  struct __free_list {
+    __free_block* __head_;
+    size_t __count_;
+  };
+
+  __thread_cache* __next_;
+  thread::id __owner_;
+  size_t __generation_;
+  __free_list __lists_[__max_cached_sizes];
+};
+
+namespace {
+
+struct __cache_slot {
+  unsigned long long __id_;
+  void* __cache_;
+};
+
+const int __num_cache_slots = 4;
+
+thread_local __cache_slot __cache_slots[__num_cache_slots];
+thread_local unsigned __next_cache_slot = 0;
+
+atomic<unsigned long long> __next_resource_id{1};
+
+} // namespace
+
+synchronized_pool_resource::synchronized_pool_resource(const pool_options& opts, memory_resource* upstream)
+    : __unsync_(opts, upstream),
+      __id_(__next_resource_id.fetch_add(1, memory_order_relaxed)),
+      __num_cached_sizes_(0),
+      __generation_(0),
+      __caches_(nullptr) {
+  size_t largest_block_size = __unsync_.options().largest_required_pool_block;
+  while (__num_cached_sizes_ != __max_cached_sizes && __cached_block_size(__num_cached_sizes_) <= largest_block_size)
+    ++__num_cached_sizes_;
+}
+
+synchronized_pool_resource::~synchronized_pool_resource() {
+  // The cached blocks belong to the chunks of __unsync_, which returns them upstream.
+  while (__caches_ != nullptr) {
+    __thread_cache* next = __caches_->__next_;
+    upstream_resource()->deallocate(__caches_, sizeof(__thread_cache), alignof(__thread_cache));
+    __caches_ = next;
+  }
+}
+
+void synchronized_pool_resource::release() {
+  unique_lock<mutex> __lk(__mut_);
+  // The caches point into the chunks released below. Other threads can't be
+  // touched here, so each thread empties its cache when it next uses it.
+  __generation_.fetch_add(1, memory_order_relaxed);
+  __unsync_.release();
+}
+
+synchronized_pool_resource::__thread_cache* synchronized_pool_resource::__cache_for_this_thread() {
+  for (__cache_slot& slot : __cache_slots)
+    if (slot.__id_ == __id_)
+      return static_cast<__thread_cache*>(slot.__cache_);
+
+  __thread_cache* cache;
+  {
+    unique_lock<mutex> __lk(__mut_);
+    // The cache of this thread may have been evicted from the slots by other
+    // resources; keep using it, so there is at most one cache per thread.
+    thread::id self = this_thread::get_id();
+    for (cache = __caches_; cache != nullptr; cache = cache->__next_)
+      if (cache->__owner_ == self)
+        break;
+
+    if (cache == nullptr) {
+      cache = static_cast<__thread_cache*>(
+          upstream_resource()->allocate(sizeof(__thread_cache), alignof(__thread_cache)));
+      cache->__next_       = __caches_;
+      cache->__owner_      = self;
+      cache->__generation_ = __generation_.load(memory_order_relaxed);
+      for (__thread_cache::__free_list& list : cache->__lists_)
+        list = {nullptr, 0};
+      __caches_ = cache;
+    }
+  }
+
+  __cache_slots[__next_cache_slot++ % __num_cache_slots] = {__id_, cache};
+  return cache;
+}
+
+void synchronized_pool_resource::__sync_cache(__thread_cache* cache) const noexcept {
+  size_t generation = __generation_.load(memory_order_relaxed);
+  if (cache->__generation_ != generation) {
+    for (__thread_cache::__free_list& list : cache->__lists_)
+      list = {nullptr, 0};
+    cache->__generation_ = generation;
+  }
+}
+
+void* synchronized_pool_resource::do_allocate(size_t bytes, size_t align) {
+  int i = __cached_size_index(bytes, align, __num_cached_sizes_);
+  if (i == -1) {
+    unique_lock<mutex> __lk(__mut_);
+    return __unsync_.allocate(bytes, align);
+  }
+
+  __thread_cache* cache = __cache_for_this_thread();
+  __sync_cache(cache);
+  __thread_cache::__free_list& list = cache->__lists_[i];
+  if (list.__head_ == nullptr) {
+    // Refill the free list with a batch of blocks under a single lock.
+    unique_lock<mutex> __lk(__mut_);
+    __sync_cache(cache);
+    for (size_t n = 0; n != __cache_batch_size; ++n) {
+      auto block = static_cast<__thread_cache::__free_block*>(
+          __unsync_.allocate(__cached_block_size(i), __cached_block_align(i)));
+      block->__next_ = list.__head_;
+      list.__head_   = block;
+      ++list.__count_;
+    }
+  }
+
+  __thread_cache::__free_block* block = list.__head_;
+  list.__head_                        = block->__next_;
+  --list.__count_;
+  return block;
+}
+
+void synchronized_pool_resource::do_deallocate(void* p, size_t bytes, size_t align) {
+  int i = __cached_size_index(bytes, align, __num_cached_sizes_);
+  if (i == -1) {
+    unique_lock<mutex> __lk(__mut_);
+    return __unsync_.deallocate(p, bytes, align);
+  }
+
+  __thread_cache* cache = __cache_for_this_thread();
+  __sync_cache(cache);
+  __thread_cache::__free_list& list = cache->__lists_[i];
+  auto block                        = static_cast<__thread_cache::__free_block*>(p);
+  block->__next_                    = list.__head_;
+  list.__head_                      = block;
+  if (++list.__count_ != 2 * __cache_batch_size)
+    return;
+
+  // Keep the most recently freed batch, which is likely still in the CPU cache,
+  // and return the older blocks under a single lock.
+  __thread_cache::__free_block* last = list.__head_;
+  for (size_t n = 1; n != __cache_batch_size; ++n)
+    last = last->__next_;
+  block         = last->__next_;
+  last->__next_ = nullptr;
+  list.__count_ = __cache_batch_size;
+
+  unique_lock<mutex> __lk(__mut_);
+  while (block != nullptr) {
+    __thread_cache::__free_block* next = block->__next_;
+    __unsync_.deallocate(block, __cached_block_size(i), __cached_block_align(i));
+    block = next;
+  }
+}
+
+#endif // defined(_LIBCPP_ABI_PMR_SYNCHRONIZED_POOL_THREAD_CACHE) && !defined(_LIBCPP_HAS_NO_THREADS)
+
 // 23.12.6, mem.res.monotonic.buffer
 
 static void* align_down(size_t align, size_t size, void*& ptr, size_t& space) {
@@ -0,0 +1,171 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <__config>
+#include <__pstl/backends/std_thread_pool.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#  include <sched.h>
+#endif
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __pstl::__std_thread {
+
+namespace {
+
+// Chunks smaller than this aren't worth handing to another thread.
+constexpr ptrdiff_t __min_chunk_size = 2048;
+
+// Number of chunks per thread, so that threads which get cheaper chunks can take over part of the work of the
+// others.
+constexpr ptrdiff_t __chunks_per_thread = 4;
+
+unsigned __available_cpus() noexcept {
+#if defined(__linux__)
+  cpu_set_t __set;
+  if (::sched_getaffinity(0, sizeof(__set), &__set) == 0)
+    return std::max(1, CPU_COUNT(&__set));
+#endif
+  return std::max(1u, thread::hardware_concurrency());
+}
+
+thread_local bool __in_chunk = false;
+
+class __thread_pool {
+  struct __job {
+    size_t __count_;
+    void* __context_;
+    void (*__func_)(void*, size_t);
+    atomic<size_t> __next_{0};
+  };
+
+public:
+  explicit __thread_pool(unsigned __workers) {
+#ifndef _LIBCPP_HAS_NO_EXCEPTIONS
+    try {
+#endif
+      for (unsigned __i = 0; __i != __workers; ++__i) {
+        thread(&__thread_pool::__worker, this).detach();
+        ++__workers_;
+      }
+#ifndef _LIBCPP_HAS_NO_EXCEPTIONS
+    } catch (...) {
+      // Run with the workers that could be created.
+    }
+#endif
+  }
+
+  // Number of threads that run chunks, including the calling thread.
+  unsigned __threads() const noexcept { return __workers_ + 1; }
+
+  void __apply(size_t __count, void* __context, void (*__func)(void*, size_t)) noexcept {
+    // Nested calls and calls from other threads while the pool is busy don't wait for the pool.
+    if (__count <= 1 || __workers_ == 0 || __in_chunk || __busy_.exchange(true, memory_order_acquire)) {
+      __run_serially(__count, __context, __func);
+      return;
+    }
+
+    __job __j{__count, __context, __func};
+    {
+      unique_lock<mutex> __lock(__mut_);
+      __job_ = &__j;
+      ++__generation_;
+    }
+    __work_cv_.notify_all();
+
+    __run_chunks(__j);
+
+    {
+      unique_lock<mutex> __lock(__mut_);
+      // Workers that haven't picked up the job yet won't see it anymore. Wait for those that did to finish their
+      // chunks; all other chunks were run by this thread.
+      __job_ = nullptr;
+      __done_cv_.wait(__lock, [this] { return __active_ == 0; });
+    }
+    __busy_.store(false, memory_order_release);
+  }
+
+private:
+  static void __run_serially(size_t __count, void* __context, void (*__func)(void*, size_t)) noexcept {
+    for (size_t __i = 0; __i != __count; ++__i)
+      __func(__context, __i);
+  }
+
+  static void __run_chunks(__job& __j) noexcept {
+    bool __was_in_chunk = __in_chunk;
+    __in_chunk          = true;
+    for (size_t __i = __j.__next_.fetch_add(1, memory_order_relaxed); __i < __j.__count_;
+         __i        = __j.__next_.fetch_add(1, memory_order_relaxed))
+      __j.__func_(__j.__context_, __i);
+    __in_chunk = __was_in_chunk;
+  }
+
+  [[noreturn]] void __worker() noexcept {
+    unsigned long long __seen = 0;
+    for (;;) {
+      __job* __j;
+      {
+        unique_lock<mutex> __lock(__mut_);
+        __work_cv_.wait(__lock, [&] { return __job_ != nullptr && __generation_ != __seen; });
+        __seen = __generation_;
+        __j    = __job_;
+        ++__active_;
+      }
+      __run_chunks(*__j);
+      {
+        unique_lock<mutex> __lock(__mut_);
+        if (--__active_ != 0)
+          continue;
+      }
+      __done_cv_.notify_all();
+    }
+  }
+
+  unsigned __workers_ = 0;
+  atomic<bool> __busy_{false};
+  mutex __mut_;
+  condition_variable __work_cv_;
+  condition_variable __done_cv_;
+  // The following are guarded by __mut_.
+  __job* __job_                    = nullptr;
+  unsigned long long __generation_ = 0;
+  unsigned __active_               = 0;
+};
+
+__thread_pool& __get_pool() noexcept {
+  // The workers never exit, so the pool is intentionally leaked rather than destroyed at exit.
+  static __thread_pool* __pool = new __thread_pool(__available_cpus() - 1);
+  return *__pool;
+}
+
+} // namespace
+
+void __parallel_apply(size_t __chunk_count, void* __context, void (*__func)(void* __context, size_t __chunk)) noexcept {
+  __get_pool().__apply(__chunk_count, __context, __func);
+}
+
+__chunk_partitions __partition_chunks(ptrdiff_t __element_count) noexcept {
+  ptrdiff_t __max_chunks = static_cast<ptrdiff_t>(__get_pool().__threads()) * __chunks_per_thread;
+
+  __chunk_partitions __partitions;
+  __partitions.__chunk_count_      = std::clamp<ptrdiff_t>(__element_count / __min_chunk_size, 1, __max_chunks);
+  __partitions.__chunk_size_       = __element_count / __partitions.__chunk_count_;
+  __partitions.__first_chunk_size_ = __partitions.__chunk_size_ + __element_count % __partitions.__chunk_count_;
+  return __partitions;
+}
+
+} // namespace __pstl::__std_thread
+
+_LIBCPP_END_NAMESPACE_STD
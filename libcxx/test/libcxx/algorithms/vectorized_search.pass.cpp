@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+
+// Check the vectorized std::find, std::count and std::mismatch around the vector size and the unrolled loop size,
+// where they switch between full vectors, overlapping tail loads and scalar loops.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "test_macros.h"
+
+template <class T>
+constexpr T make(std::size_t i) {
+  return static_cast<T>(i % 7 + 1);
+}
+
+template <class T>
+void test_type() {
+  for (std::size_t size = 0; size != 300; ++size) {
+    std::vector<T> vec(size);
+    for (std::size_t i = 0; i != size; ++i)
+      vec[i] = make<T>(i);
+    const std::vector<T> copy = vec;
+
+    for (std::size_t i = 0; i != size; ++i) {
+      T* const ptr = vec.data();
+      T old        = vec[i];
+      vec[i]       = T(0);
+      assert(std::find(vec.begin(), vec.end(), T(0)) == vec.begin() + i);
+      assert(std::find(copy.begin(), copy.end(), T(0)) == copy.end());
+      assert(std::count(ptr, ptr + size, T(0)) == 1);
+      assert(std::mismatch(vec.begin(), vec.end(), copy.begin()).first == vec.begin() + i);
+      vec[i] = old;
+    }
+
+    std::ptrdiff_t expected = 0;
+    for (std::size_t i = 0; i != size; ++i)
+      expected += vec[i] == make<T>(3);
+    assert(std::count(vec.begin(), vec.end(), make<T>(3)) == expected);
+    assert(std::mismatch(vec.begin(), vec.end(), copy.begin()).first == vec.end());
+  }
+}
+
+void test_pointers() {
+  int objs[2];
+  for (std::size_t size = 0; size != 100; ++size) {
+    std::vector<int*> vec(size, &objs[0]);
+    std::vector<int*> copy = vec;
+    for (std::size_t i = 0; i != size; ++i) {
+      vec[i] = &objs[1];
+      assert(std::find(vec.begin(), vec.end(), &objs[1]) == vec.begin() + i);
+      assert(std::count(vec.begin(), vec.end(), &objs[1]) == 1);
+      assert(std::mismatch(vec.begin(), vec.end(), copy.begin()).first == vec.begin() + i);
+      vec[i] = &objs[0];
+    }
+  }
+}
+
+constexpr bool test_constexpr() {
+  std::uint16_t arr[40] = {};
+  arr[37]               = 3;
+  assert(std::find(arr, arr + 40, std::uint16_t(3)) == arr + 37);
+  assert(std::count(arr, arr + 40, std::uint16_t(0)) == 39);
+  return true;
+}
+
+int main(int, char**) {
+  test_type<std::uint8_t>();
+  test_type<std::int16_t>();
+  test_type<std::uint16_t>();
+  test_type<std::uint32_t>();
+  test_type<std::int64_t>();
+  test_type<std::uint64_t>();
+  test_pointers();
+  test_constexpr();
+  static_assert(test_constexpr());
+
+  return 0;
+}
@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// ADDITIONAL_COMPILE_FLAGS: -D_LIBCPP_ABI_HASH_TABLE_POWER2_BUCKETS
+
+// Check that with _LIBCPP_ABI_HASH_TABLE_POWER2_BUCKETS unordered containers only use power-of-two bucket counts,
+// and that keys which only differ in their high bits don't all end up in the same bucket.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "test_macros.h"
+
+static bool is_power2(std::size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+int main(int, char**) {
+  {
+    std::unordered_set<std::size_t> s;
+    for (std::size_t i = 0; i != 1000; ++i) {
+      s.insert(i << 20);
+      assert(is_power2(s.bucket_count()));
+    }
+    std::size_t largest_bucket = 0;
+    for (std::size_t b = 0; b != s.bucket_count(); ++b)
+      largest_bucket = std::max(largest_bucket, s.bucket_size(b));
+    assert(largest_bucket < 16);
+    for (std::size_t i = 0; i != 1000; ++i) {
+      assert(s.count(i << 20) == 1);
+      assert(s.bucket(i << 20) < s.bucket_count());
+    }
+  }
+  {
+    std::unordered_multimap<int, int> m;
+    m.rehash(100);
+    assert(is_power2(m.bucket_count()));
+    assert(m.bucket_count() >= 100);
+    for (int i = 0; i != 100; ++i) {
+      m.emplace(i, i);
+      m.emplace(i, -i);
+    }
+    for (int i = 0; i != 100; ++i)
+      assert(m.count(i) == 2);
+    m.clear();
+    m.rehash(0);
+    assert(is_power2(m.bucket_count()) || m.bucket_count() == 0);
+  }
+
+  return 0;
+}
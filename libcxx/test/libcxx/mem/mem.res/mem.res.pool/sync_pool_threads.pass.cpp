@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: no-threads
+// XFAIL: availability-pmr-missing
+
+// Check that a synchronized_pool_resource shared by several threads hands out
+// distinct blocks, including when blocks are deallocated by another thread than
+// the one that allocated them, and that it can be reused after release().
+// With _LIBCPP_ABI_PMR_SYNCHRONIZED_POOL_THREAD_CACHE this goes through the
+// per-thread caches and the batched refills and returns between them.
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "make_test_thread.h"
+#include "test_macros.h"
+
+struct Block {
+  unsigned char* ptr;
+  std::size_t size;
+  std::size_t align;
+};
+
+const int num_threads = 4;
+
+std::vector<Block> allocate_blocks(std::pmr::memory_resource& res, unsigned char tag) {
+  std::vector<Block> blocks;
+  for (int i = 0; i != 2000; ++i) {
+    std::size_t size  = 1 + (i * 37) % 2000;
+    std::size_t align = i % 5 == 0 ? 64 : alignof(std::max_align_t);
+    auto ptr          = static_cast<unsigned char*>(res.allocate(size, align));
+    assert(reinterpret_cast<std::uintptr_t>(ptr) % align == 0);
+    std::memset(ptr, tag, size);
+    blocks.push_back({ptr, size, align});
+  }
+  return blocks;
+}
+
+void deallocate_blocks(std::pmr::memory_resource& res, const std::vector<Block>& blocks, unsigned char tag) {
+  for (const Block& b : blocks) {
+    for (std::size_t i = 0; i != b.size; ++i)
+      assert(b.ptr[i] == tag);
+    res.deallocate(b.ptr, b.size, b.align);
+  }
+}
+
+void test(std::pmr::synchronized_pool_resource& res) {
+  std::vector<Block> blocks[num_threads];
+  std::vector<std::thread> threads;
+  for (int t = 0; t != num_threads; ++t)
+    threads.push_back(support::make_test_thread([&, t] {
+      blocks[t] = allocate_blocks(res, static_cast<unsigned char>(t + 1));
+      // Churn through the cache of this thread while the other threads do the same.
+      unsigned char tag = static_cast<unsigned char>(t + 101);
+      for (int round = 0; round != 10; ++round)
+        deallocate_blocks(res, allocate_blocks(res, tag), tag);
+    }));
+  for (std::thread& thread : threads)
+    thread.join();
+  threads.clear();
+
+  // Return every block from another thread than the one that allocated it.
+  for (int t = 0; t != num_threads; ++t)
+    threads.push_back(support::make_test_thread([&, t] {
+      int owner = (t + 1) % num_threads;
+      deallocate_blocks(res, blocks[owner], static_cast<unsigned char>(owner + 1));
+    }));
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
+int main(int, char**) {
+  std::pmr::synchronized_pool_resource res;
+  test(res);
+  test(res);
+
+  res.release();
+  test(res);
+
+  // A second resource must not pick up the state of the first one.
+  {
+    std::pmr::synchronized_pool_resource other(std::pmr::pool_options{0, 256});
+    test(other);
+  }
+  test(res);
+
+  return 0;
+}
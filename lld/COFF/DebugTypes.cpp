@@ -30,6 +30,7 @@
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TimeProfiler.h"
+#include <numeric>
 
 using namespace llvm;
 using namespace llvm::codeview;
@@ -1131,10 +1132,29 @@ void TypeMerger::mergeTypesWithGHash() {
   // - item records
   //   - source 0, type 1...
   //   - source 1, type 0...
+  //
+  // The table is large, so scan it in parallel: count the non-empty cells of
+  // each shard, then copy them to their position in the output.
   std::vector<GHashCell> entries;
-  for (const GHashCell &cell : ArrayRef(ghashState.table.table, tableSize)) {
-    if (!cell.isEmpty())
-      entries.push_back(cell);
+  {
+    ArrayRef<GHashCell> cells(ghashState.table.table, tableSize);
+    constexpr size_t shardSize = 1 << 16;
+    size_t numShards = divideCeil(tableSize, shardSize);
+    std::vector<size_t> shardBegin(numShards + 1);
+    auto getShard = [&](size_t i) {
+      size_t begin = i * shardSize;
+      return cells.slice(begin, std::min<size_t>(shardSize, tableSize - begin));
+    };
+    parallelFor(0, numShards, [&](size_t i) {
+      shardBegin[i + 1] = count_if(
+          getShard(i), [](const GHashCell &cell) { return !cell.isEmpty(); });
+    });
+    std::partial_sum(shardBegin.begin(), shardBegin.end(), shardBegin.begin());
+    entries.resize(shardBegin[numShards]);
+    parallelFor(0, numShards, [&](size_t i) {
+      copy_if(getShard(i), entries.begin() + shardBegin[i],
+              [](const GHashCell &cell) { return !cell.isEmpty(); });
+    });
   }
   parallelSort(entries, std::less<GHashCell>());
   log(formatv("ghash table load factor: {0:p} (size {1} / capacity {2})\n",
@@ -1155,20 +1175,21 @@ void TypeMerger::mergeTypesWithGHash() {
   // merging will skip indices not on this list. Store the destination PDB type
   // index for these unique types in the tpiMap for each source. The entries for
   // non-unique types will be filled in prior to type merging.
-  for (uint32_t i = 0, e = entries.size(); i < e; ++i) {
-    auto &cell = entries[i];
-    uint32_t tpiSrcIdx = cell.getTpiSrcIdx();
-    TpiSource *source = ctx.tpiSourceList[tpiSrcIdx];
-    source->uniqueTypes.push_back(cell.getGHashIdx());
-
-    // Update the ghash table to store the destination PDB type index in the
-    // table.
+  for (const GHashCell &cell : entries)
+    ctx.tpiSourceList[cell.getTpiSrcIdx()]->uniqueTypes.push_back(
+        cell.getGHashIdx());
+
+  // Update the ghash table to store the destination PDB type index in the
+  // table. Each entry updates a distinct cell, so do this in parallel.
+  parallelFor(0, entries.size(), [&](size_t i) {
+    const GHashCell &cell = entries[i];
+    TpiSource *source = ctx.tpiSourceList[cell.getTpiSrcIdx()];
     uint32_t pdbTypeIndex = i < numTypes ? i : i - numTypes;
     uint32_t ghashCellIndex =
         source->indexMapStorage[cell.getGHashIdx()].toArrayIndex();
     ghashState.table.table[ghashCellIndex] =
         GHashCell(cell.isItem(), cell.getTpiSrcIdx(), pdbTypeIndex);
-  }
+  });
 
   // In parallel, remap all types.
   for (TpiSource *source : dependencySources)
@@ -100,7 +100,9 @@ void ArchiveFile::parse() {
   // Parse a MemoryBufferRef as an archive file.
   file = CHECK(Archive::create(mb), this);
 
-  // Read the symbol table to construct Lazy objects.
+  // Read the symbol table to construct Lazy objects. The archive is mapped
+  // into memory, so members are only read when they are pulled in.
+  ctx.symtab.reserve(file->getNumberOfSymbols());
   for (const Archive::Symbol &sym : file->symbols())
     ctx.symtab.addLazyArchive(this, sym);
 }
@@ -89,6 +89,9 @@ public:
 
   Symbol *addUndefined(StringRef name, InputFile *f, bool isWeakAlias);
   void addLazyArchive(ArchiveFile *f, const Archive::Symbol &sym);
+  // Makes room for n more symbols so that adding a large archive symbol
+  // table does not rehash the symbol map repeatedly.
+  void reserve(size_t n) { symMap.reserve(symMap.size() + n); }
   void addLazyObject(InputFile *f, StringRef n);
   void addLazyDLLSymbol(DLLFile *f, DLLFile::Symbol *sym, StringRef n);
   Symbol *addAbsolute(StringRef n, COFFSymbolRef s);
@@ -9,31 +9,99 @@
 #include "lld/Common/Timer.h"
 #include "lld/Common/ErrorHandler.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Process.h"
 #include <ratio>
+#if LLVM_ON_UNIX
+#include <sys/resource.h>
+#endif
 
 using namespace lld;
 using namespace llvm;
 
+// Returns the CPU time consumed by all threads of the process so far.
+static std::chrono::nanoseconds getCPUTime() {
+  sys::TimePoint<> elapsed;
+  std::chrono::nanoseconds user, sys;
+  sys::Process::GetTimeUsage(elapsed, user, sys);
+  return user + sys;
+}
+
+// Returns the high-water mark of the resident set size of the process, or 0
+// if it is unavailable.
+static uint64_t getPeakRSS() {
+#if LLVM_ON_UNIX
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) != 0)
+    return 0;
+  // ru_maxrss is in bytes on macOS and in kilobytes elsewhere.
+#ifdef __APPLE__
+  return ru.ru_maxrss;
+#else
+  return uint64_t(ru.ru_maxrss) * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
 ScopedTimer::ScopedTimer(Timer &t) : t(&t) {
   startTime = std::chrono::high_resolution_clock::now();
+  startCPUTime = getCPUTime();
 }
 
 void ScopedTimer::stop() {
   if (!t)
     return;
   t->addToTotal(std::chrono::high_resolution_clock::now() - startTime);
+  t->addToCPUTotal(getCPUTime() - startCPUTime);
+  t->updatePeakRSS(getPeakRSS());
   t = nullptr;
 }
 
 ScopedTimer::~ScopedTimer() { stop(); }
 
-Timer::Timer(llvm::StringRef name) : total(0), name(std::string(name)) {}
+Timer::Timer(llvm::StringRef name)
+    : total(0), cpuTotal(0), peakRSS(0), name(std::string(name)) {}
 Timer::Timer(llvm::StringRef name, Timer &parent)
-    : total(0), name(std::string(name)) {
+    : total(0), cpuTotal(0), peakRSS(0), name(std::string(name)) {
   parent.children.push_back(this);
 }
 
+void Timer::updatePeakRSS(uint64_t rss) {
+  uint64_t cur = peakRSS.load(std::memory_order_relaxed);
+  while (cur < rss && !peakRSS.compare_exchange_weak(cur, rss))
+    ;
+}
+
+void Timer::reset() {
+  total = 0;
+  cpuTotal = 0;
+  peakRSS = 0;
+  for (Timer *child : children)
+    child->reset();
+}
+
+void Timer::writeJSON(json::OStream &os) const {
+  double cpuMillis =
+      std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+          std::chrono::nanoseconds(cpuTotal))
+          .count();
+  os.object([&] {
+    os.attribute("name", name);
+    os.attribute("wall_ms", millis());
+    os.attribute("cpu_ms", cpuMillis);
+    os.attribute("threads", total ? cpuMillis / millis() : 0.0);
+    os.attribute("peak_rss", int64_t(peakRSS));
+    os.attributeArray("children", [&] {
+      for (const Timer *child : children)
+        child->writeJSON(os);
+    });
+  });
+}
+
 void Timer::print() {
   double totalDuration = static_cast<double>(millis());
 
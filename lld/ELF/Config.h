@@ -10,6 +10,7 @@
 #define LLD_ELF_CONFIG_H
 
 #include "lld/Common/ErrorHandler.h"
+#include "lld/Common/Timer.h"
 #include "llvm/ADT/CachedHashString.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
@@ -156,13 +157,16 @@ struct Config {
   llvm::StringMap<uint64_t> sectionStartMap;
   llvm::StringRef bfdname;
   llvm::StringRef chroot;
+  llvm::StringRef decompressCacheDir;
   llvm::StringRef dependencyFile;
   llvm::StringRef dwoDir;
   llvm::StringRef dynamicLinker;
   llvm::StringRef entry;
   llvm::StringRef emulation;
   llvm::StringRef fini;
+  llvm::StringRef incrementalManifest;
   llvm::StringRef init;
+  llvm::StringRef linkReport;
   llvm::StringRef ltoAAPipeline;
   llvm::StringRef ltoCSProfileFile;
   llvm::StringRef ltoNewPmPasses;
@@ -348,8 +352,10 @@ struct Config {
   uint16_t emachine = llvm::ELF::EM_NONE;
   std::optional<uint64_t> imageBase;
   uint64_t commonPageSize;
+  uint64_t compressShardSize;
   uint64_t maxPageSize;
   uint64_t mipsGotSize;
+  uint64_t outputWriteWindow;
   uint64_t zStackSize;
   unsigned ltoPartitions;
   unsigned ltoo;
@@ -504,6 +510,19 @@ struct Ctx {
   llvm::raw_fd_ostream openAuxiliaryFile(llvm::StringRef, std::error_code &);
 
   ArrayRef<uint8_t> aarch64PauthAbiCoreInfo;
+
+  // Timers of the link phases reported by --link-report=.
+  Timer totalTimer;
+  Timer loadTimer;
+  Timer parseTimer;
+  Timer ltoTimer;
+  Timer gcTimer;
+  Timer icfTimer;
+  Timer scanRelocsTimer;
+  Timer thunksTimer;
+  Timer writeTimer;
+
+  Ctx();
 };
 
 LLVM_LIBRARY_VISIBILITY extern Ctx ctx;
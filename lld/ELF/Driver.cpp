@@ -51,20 +51,24 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Config/llvm-config.h"
+#include "llvm/IR/LLVMContext.h"
 #include "llvm/LTO/LTO.h"
 #include "llvm/Object/Archive.h"
 #include "llvm/Object/IRObjectFile.h"
+#include "llvm/ProfileData/SampleProfReader.h"
 #include "llvm/Remarks/HotnessThresholdParser.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/GlobPattern.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cstdlib>
 #include <tuple>
@@ -91,6 +95,15 @@ void elf::errorOrWarn(const Twine &msg) {
     error(msg);
 }
 
+Ctx::Ctx()
+    : totalTimer("Total Linking Time"),
+      loadTimer("Load input files", totalTimer),
+      parseTimer("Parse input files", totalTimer), ltoTimer("LTO", totalTimer),
+      gcTimer("GC", totalTimer), icfTimer("ICF", totalTimer),
+      scanRelocsTimer("Scan relocations", totalTimer),
+      thunksTimer("Finalize address dependent content", totalTimer),
+      writeTimer("Write output file", totalTimer) {}
+
 void Ctx::reset() {
   driver = LinkerDriver();
   memoryBuffers.clear();
@@ -113,6 +126,7 @@ void Ctx::reset() {
   scriptSymOrderCounter = 1;
   scriptSymOrder.clear();
   ltoAllVtablesHaveTypeInfos = false;
+  totalTimer.reset();
 }
 
 llvm::raw_fd_ostream Ctx::openAuxiliaryFile(llvm::StringRef filename,
@@ -576,6 +590,60 @@ constexpr const char *saveTempsValues[] = {
     "resolution", "preopt",     "promote", "internalize",  "import",
     "opt",        "precodegen", "prelink", "combinedindex"};
 
+// Write the --link-report= file. The phases are the timers in ctx, and the
+// counters describe the size of the link so that phase times of different
+// links can be compared.
+static void writeLinkReport() {
+  std::error_code ec;
+  raw_fd_ostream os = ctx.openAuxiliaryFile(config->linkReport, ec);
+  if (ec) {
+    error("cannot open --link-report= file " + config->linkReport + ": " +
+          ec.message());
+    return;
+  }
+
+  uint64_t inputBytes = 0;
+  for (ELFFileBase *file : ctx.objectFiles)
+    inputBytes += file->mb.getBufferSize();
+  for (SharedFile *file : ctx.sharedFiles)
+    inputBytes += file->mb.getBufferSize();
+  for (BitcodeFile *file : ctx.bitcodeFiles)
+    inputBytes += file->mb.getBufferSize();
+  for (BinaryFile *file : ctx.binaryFiles)
+    inputBytes += file->mb.getBufferSize();
+
+  uint64_t numRelocs = 0, numMergeSections = 0, numMergePieces = 0;
+  for (InputSectionBase *sec : ctx.inputSections) {
+    numRelocs += sec->relocs().size();
+    if (auto *ms = dyn_cast<MergeInputSection>(sec)) {
+      ++numMergeSections;
+      numMergePieces += ms->pieces.size();
+    }
+  }
+
+  json::OStream j(os, 2);
+  j.object([&] {
+    j.attribute("version", 1);
+    j.attribute("output", config->outputFile);
+    j.attribute("threads", parallel::strategy.compute_thread_count());
+    j.attributeObject("counters", [&] {
+      j.attribute("input_files",
+                  int64_t(ctx.objectFiles.size() + ctx.sharedFiles.size() +
+                          ctx.bitcodeFiles.size() + ctx.binaryFiles.size()));
+      j.attribute("input_bytes", int64_t(inputBytes));
+      j.attribute("input_sections", int64_t(ctx.inputSections.size()));
+      j.attribute("relocations", int64_t(numRelocs));
+      j.attribute("merge_sections", int64_t(numMergeSections));
+      j.attribute("merge_pieces", int64_t(numMergePieces));
+      j.attribute("output_sections", int64_t(outputSections.size()));
+    });
+    j.attributeBegin("phases");
+    ctx.totalTimer.writeJSON(j);
+    j.attributeEnd();
+  });
+  os << '\n';
+}
+
 void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   ELFOptTable parser;
   opt::InputArgList args = parser.parse(argsArr.slice(1));
@@ -643,9 +711,13 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
 
   {
     llvm::TimeTraceScope timeScope("ExecuteLinker");
+    ScopedTimer totalTimer(ctx.totalTimer);
 
     initLLVM();
-    createFiles(args);
+    {
+      ScopedTimer t(ctx.loadTimer);
+      createFiles(args);
+    }
     if (errorCount())
       return;
 
@@ -658,6 +730,9 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
     invokeELFT(link, args);
   }
 
+  if (!config->linkReport.empty())
+    writeLinkReport();
+
   if (config->timeTraceEnabled) {
     checkError(timeTraceProfilerWrite(
         args.getLastArgValue(OPT_time_trace_eq).str(), config->outputFile));
@@ -946,6 +1021,62 @@ static void readCallGraph(MemoryBufferRef mb) {
   }
 }
 
+// Add the caller-to-callee edges of a sample profile, such as one produced
+// from perf/LBR samples by llvm-profgen or create_llvm_prof. Calls made from
+// inlined code are attributed to the function they were inlined into, as
+// that is where the call instruction resides.
+static void readCallGraphFromSampleProfile(StringRef path) {
+  using namespace llvm::sampleprof;
+  LLVMContext llvmCtx;
+  ErrorOr<std::unique_ptr<SampleProfileReader>> readerOrErr =
+      SampleProfileReader::create(path.str(), llvmCtx,
+                                  *vfs::getRealFileSystem());
+  if (!readerOrErr) {
+    error("cannot open " + path + ": " + readerOrErr.getError().message());
+    return;
+  }
+  SampleProfileReader &reader = **readerOrErr;
+  if (std::error_code ec = reader.read()) {
+    error("cannot read sample profile " + path + ": " + ec.message());
+    return;
+  }
+  SampleProfileMap &profiles = reader.getProfiles();
+  if (FunctionSamples::ProfileIsCS)
+    ProfileConverter::flattenProfile(profiles, /*ProfileIsCS=*/true);
+
+  DenseMap<StringRef, Symbol *> map;
+  for (ELFFileBase *file : ctx.objectFiles)
+    for (Symbol *sym : file->getSymbols())
+      map[sym->getName()] = sym;
+
+  // Profiles usually reference many functions that are not part of the
+  // output, e.g. those in shared libraries, so don't warn about them.
+  auto findSection = [&](StringRef name) -> InputSectionBase * {
+    if (Defined *dr = dyn_cast_or_null<Defined>(map.lookup(name)))
+      return dyn_cast_or_null<InputSectionBase>(dr->section);
+    return nullptr;
+  };
+
+  auto addCalls = [&](InputSectionBase *from, const FunctionSamples &fs,
+                      auto &self) -> void {
+    for (const auto &[loc, record] : fs.getBodySamples())
+      for (const auto &[callee, count] : record.getSortedCallTargets())
+        if (InputSectionBase *to = findSection(callee.stringRef()))
+          config->callGraphProfile[{from, to}] += count;
+    for (const auto &[loc, callees] : fs.getCallsiteSamples())
+      for (const auto &[name, inlined] : callees)
+        self(from, inlined, self);
+  };
+
+  // Visit the profiles in a deterministic order.
+  std::vector<NameFunctionSamples> sorted;
+  sortFuncProfiles(profiles, sorted);
+  for (const NameFunctionSamples &p : sorted)
+    if (InputSectionBase *from =
+            findSection(p.second->getFunction().stringRef()))
+      addCalls(from, *p.second, addCalls);
+}
+
 // If SHT_LLVM_CALL_GRAPH_PROFILE and its relocation section exist, returns
 // true and populates cgProfile and symbolIndices.
 template <class ELFT>
@@ -1233,6 +1364,13 @@ static void readConfigs(opt::InputArgList &args) {
     config->compressDebugSections =
         getCompressionType(arg->getValue(), "--compress-debug-sections");
   }
+  if (int64_t shardSize =
+          args::getInteger(args, OPT_compress_shard_size, 1 << 20);
+      shardSize > 0)
+    config->compressShardSize = shardSize;
+  else
+    error("--compress-shard-size: expected a positive integer, but got " +
+          Twine(shardSize));
   config->cref = args.hasArg(OPT_cref);
   config->optimizeBBJumps =
       args.hasFlag(OPT_optimize_bb_jumps, OPT_no_optimize_bb_jumps, false);
@@ -1280,6 +1418,7 @@ static void readConfigs(opt::InputArgList &args) {
   config->ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
   config->init = args.getLastArgValue(OPT_init, "_init");
+  config->linkReport = args.getLastArgValue(OPT_link_report);
   config->ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   config->ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
   config->ltoCSProfileFile = args.getLastArgValue(OPT_lto_cs_profile_file);
@@ -1314,6 +1453,8 @@ static void readConfigs(opt::InputArgList &args) {
   config->ltoUniqueBasicBlockSectionNames =
       args.hasFlag(OPT_lto_unique_basic_block_section_names,
                    OPT_no_lto_unique_basic_block_section_names, false);
+  config->incrementalManifest =
+      args.getLastArgValue(OPT_incremental_manifest);
   config->mapFile = args.getLastArgValue(OPT_Map);
   config->mipsGotSize = args::getInteger(args, OPT_mips_got_size, 0xfff0);
   config->mergeArmExidx =
@@ -1321,6 +1462,8 @@ static void readConfigs(opt::InputArgList &args) {
   config->mmapOutputFile =
       args.hasFlag(OPT_mmap_output_file, OPT_no_mmap_output_file, true);
   config->nmagic = args.hasFlag(OPT_nmagic, OPT_no_nmagic, false);
+  config->outputWriteWindow =
+      args::getInteger(args, OPT_output_write_window, 0);
   config->noinhibitExec = args.hasArg(OPT_noinhibit_exec);
   config->nostdlib = args.hasArg(OPT_nostdlib);
   config->oFormatBinary = isOutputFormatBinary(args);
@@ -1386,6 +1529,7 @@ static void readConfigs(opt::InputArgList &args) {
   config->target1Rel = args.hasFlag(OPT_target1_rel, OPT_target1_abs, false);
   config->target2 = getTarget2(args);
   config->thinLTOCacheDir = args.getLastArgValue(OPT_thinlto_cache_dir);
+  config->decompressCacheDir = args.getLastArgValue(OPT_decompress_cache_dir);
   config->thinLTOCachePolicy = CHECK(
       parseCachePruningPolicy(args.getLastArgValue(OPT_thinlto_cache_policy)),
       "--thinlto-cache-policy: invalid cache policy");
@@ -2453,6 +2597,7 @@ static void markBuffersAsDontNeed(bool skipLinkedOutput) {
 template <class ELFT>
 void LinkerDriver::compileBitcodeFiles(bool skipLinkedOutput) {
   llvm::TimeTraceScope timeScope("LTO");
+  ScopedTimer t(ctx.ltoTimer);
   // Compile bitcode files and replace bitcode symbols.
   lto.reset(new BitcodeCompiler);
   for (BitcodeFile *file : ctx.bitcodeFiles)
@@ -2783,7 +2928,10 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
   for (StringRef name : config->undefined)
     symtab.addUnusedUndefined(name)->referenced = true;
 
-  parseFiles(files, armCmseImpLib);
+  {
+    ScopedTimer t(ctx.parseTimer);
+    parseFiles(files, armCmseImpLib);
+  }
 
   // Create dynamic sections for dynamic linking and static PIE.
   config->hasDynSymTab = !ctx.sharedFiles.empty() || config->isPic;
@@ -3100,9 +3248,14 @@ template <class ELFT> void LinkerDriver::link(opt::InputArgList &args) {
     if (auto *arg = args.getLastArg(OPT_call_graph_ordering_file))
       if (std::optional<MemoryBufferRef> buffer = readFile(arg->getValue()))
         readCallGraph(*buffer);
+    if (auto *arg = args.getLastArg(OPT_call_graph_sample_profile))
+      readCallGraphFromSampleProfile(arg->getValue());
     readCallGraphsFromObjectFiles<ELFT>();
   }
 
   // Write the result to the file.
   writeResult<ELFT>();
+
+  if (!config->decompressCacheDir.empty())
+    pruneCache(config->decompressCacheDir, CachePruningPolicy());
 }
@@ -437,6 +437,26 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   ++cnt;
 }
 
+// Compute the initial hash of a section from everything equalsConstant()
+// compares exactly: contents, flags, and the offset and type of each
+// relocation. Sections that can be folded always get the same hash, while
+// sections that differ only in their relocations are usually separated here
+// instead of in the quadratic segregate().
+template <class RelTy>
+static uint64_t getConstantHash(const InputSection *isec,
+                                ArrayRef<RelTy> rels) {
+  SmallVector<uint64_t, 0> parts;
+  parts.reserve(2 + rels.size() * 2);
+  parts.push_back(xxh3_64bits(isec->content()));
+  parts.push_back(isec->flags);
+  for (const RelTy &rel : rels) {
+    parts.push_back(rel.r_offset);
+    parts.push_back(rel.getType(config->isMips64EL));
+  }
+  return xxh3_64bits(ArrayRef(reinterpret_cast<const uint8_t *>(parts.data()),
+                              parts.size() * sizeof(uint64_t)));
+}
+
 // Combine the hashes of the sections referenced by the given section into its
 // hash.
 template <class RelTy>
@@ -493,23 +513,29 @@ template <class ELFT> void ICF<ELFT>::run() {
     }
   }
 
-  // Initially, we use hash values to partition sections.
-  parallelForEach(sections, [&](InputSection *s) {
-    // Set MSB to 1 to avoid collisions with unique IDs.
-    s->eqClass[0] = xxh3_64bits(s->content()) | (1U << 31);
-  });
-
-  // Perform 2 rounds of relocation hash propagation. 2 is an empirical value to
-  // reduce the average sizes of equivalence classes, i.e. segregate() which has
-  // a large time complexity will have less work to do.
-  for (unsigned cnt = 0; cnt != 2; ++cnt) {
+  {
+    llvm::TimeTraceScope timeScope("Hash sections");
+    // Initially, we use hash values to partition sections.
     parallelForEach(sections, [&](InputSection *s) {
       const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
-      if (rels.areRelocsRel())
-        combineRelocHashes(cnt, s, rels.rels);
-      else
-        combineRelocHashes(cnt, s, rels.relas);
+      uint64_t hash = rels.areRelocsRel() ? getConstantHash(s, rels.rels)
+                                          : getConstantHash(s, rels.relas);
+      // Set MSB to 1 to avoid collisions with unique IDs.
+      s->eqClass[0] = hash | (1U << 31);
     });
+
+    // Perform 2 rounds of relocation hash propagation. 2 is an empirical value
+    // to reduce the average sizes of equivalence classes, i.e. segregate()
+    // which has a large time complexity will have less work to do.
+    for (unsigned cnt = 0; cnt != 2; ++cnt) {
+      parallelForEach(sections, [&](InputSection *s) {
+        const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+        if (rels.areRelocsRel())
+          combineRelocHashes(cnt, s, rels.rels);
+        else
+          combineRelocHashes(cnt, s, rels.relas);
+      });
+    }
   }
 
   // From now on, sections in Sections vector are ordered so that sections
@@ -522,24 +548,32 @@ template <class ELFT> void ICF<ELFT>::run() {
   // static content. Use a base offset for these IDs to ensure no overlap with
   // the unique IDs already assigned.
   uint32_t eqClassBase = ++uniqueId;
-  forEachClass([&](size_t begin, size_t end) {
-    segregate(begin, end, eqClassBase, true);
-  });
-
-  // Split groups by comparing relocations until convergence is obtained.
-  do {
-    repeat = false;
+  {
+    llvm::TimeTraceScope timeScope("Compare contents");
     forEachClass([&](size_t begin, size_t end) {
-      segregate(begin, end, eqClassBase, false);
+      segregate(begin, end, eqClassBase, true);
     });
-  } while (repeat);
+  }
+
+  // Split groups by comparing relocations until convergence is obtained.
+  {
+    llvm::TimeTraceScope timeScope("Compare relocation targets");
+    do {
+      repeat = false;
+      forEachClass([&](size_t begin, size_t end) {
+        segregate(begin, end, eqClassBase, false);
+      });
+    } while (repeat);
+  }
 
   log("ICF needed " + Twine(cnt) + " iterations");
 
   // Merge sections by the equivalence class.
+  size_t numFolded = 0;
   forEachClassRange(0, sections.size(), [&](size_t begin, size_t end) {
     if (end - begin == 1)
       return;
+    numFolded += end - begin - 1;
     print("selected section " + toString(sections[begin]));
     for (size_t i = begin + 1; i < end; ++i) {
       print("  removing identical section " + toString(sections[i]));
@@ -553,6 +587,9 @@ template <class ELFT> void ICF<ELFT>::run() {
     }
   });
 
+  log("ICF folded " + Twine(numFolded) + " of " + Twine(sections.size()) +
+      " candidate sections");
+
   // Change Defined symbol's section field to the canonical one.
   auto fold = [](Symbol *sym) {
     if (auto *d = dyn_cast<Defined>(sym))
@@ -582,6 +619,7 @@ template <class ELFT> void ICF<ELFT>::run() {
 // ICF entry point function.
 template <class ELFT> void elf::doIcf() {
   llvm::TimeTraceScope timeScope("ICF");
+  ScopedTimer t(ctx.icfTimer);
   ICF<ELFT>().run();
 }
 
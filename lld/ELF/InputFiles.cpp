@@ -25,6 +25,7 @@
 #include "llvm/Support/ARMAttributeParser.h"
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/Endian.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/RISCVAttributeParser.h"
@@ -333,6 +334,19 @@ extern template void ObjFile<ELF64BE>::importCmseSymbols();
 template <class ELFT>
 static void doParseFiles(const std::vector<InputFile *> &files,
                          InputFile *armCmseImpLib) {
+  // Decoding and hashing symbol names is a significant part of symbol
+  // resolution, but it does not depend on the symbol table. Do it for all
+  // object files in parallel so that the serial loop below only has to look
+  // up and resolve symbols. The resolution order is unchanged.
+  {
+    llvm::TimeTraceScope timeScope("Preparse symbol names");
+    parallelForEach(files, [](InputFile *file) {
+      if (file->kind() == InputFile::ObjKind &&
+          cast<ELFFileBase>(file)->ekind == config->ekind)
+        cast<ObjFile<ELFT>>(file)->preparseSymbolNames();
+    });
+  }
+
   // Add all files to the symbol table. This will add almost all symbols that we
   // need to the symbol table. This process might add files to the link due to
   // addDependentLibrary.
@@ -1113,7 +1127,8 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
   // Some entries have been filled by LazyObjFile.
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
     if (!symbols[i])
-      symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+      symbols[i] = insertGlobalSymbol(i, eSyms);
+  preparsedNames = {};
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1871,11 +1886,42 @@ template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
     if (eSyms[i].st_shndx == SHN_UNDEF)
       continue;
-    symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+    symbols[i] = insertGlobalSymbol(i, eSyms);
     symbols[i]->resolve(LazySymbol{*this});
     if (!lazy)
       break;
   }
+
+  // Most archive members are never extracted. Don't keep their names around.
+  if (lazy)
+    preparsedNames = {};
+}
+
+template <class ELFT> void ObjFile<ELFT>::preparseSymbolNames() {
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+  if (eSyms.empty())
+    return;
+  preparsedNames.resize(eSyms.size() - firstGlobal);
+  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
+    Expected<StringRef> nameOrErr = eSyms[i].getName(stringTable);
+    if (!nameOrErr) {
+      // Leave the error to be reported by the serial path.
+      consumeError(nameOrErr.takeError());
+      preparsedNames = {};
+      return;
+    }
+    StringRef stem = getSymbolStem(*nameOrErr);
+    preparsedNames[i - firstGlobal] = {*nameOrErr, uint32_t(stem.size()),
+                                       CachedHashStringRef(stem).hash()};
+  }
+}
+
+template <class ELFT>
+Symbol *ObjFile<ELFT>::insertGlobalSymbol(size_t i, ArrayRef<Elf_Sym> eSyms) {
+  if (preparsedNames.empty())
+    return symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+  const PreparsedName &p = preparsedNames[i - firstGlobal];
+  return symtab.insert(p.name, p.name.take_front(p.stemSize), p.stemHash);
 }
 
 bool InputFile::shouldExtractForCommon(StringRef name) const {
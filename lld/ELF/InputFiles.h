@@ -252,6 +252,11 @@ public:
   void parse(bool ignoreComdats = false);
   void parseLazy();
 
+  // Decode and hash the names of global symbols ahead of parse() or
+  // parseLazy(). This does not access the symbol table, so it may be called
+  // for multiple files in parallel.
+  void preparseSymbolNames();
+
   StringRef getShtGroupSignature(ArrayRef<Elf_Shdr> sections,
                                  const Elf_Shdr &sec);
 
@@ -299,6 +304,8 @@ private:
   void initializeSymbols(const llvm::object::ELFFile<ELFT> &obj);
   void initializeJustSymbols();
 
+  Symbol *insertGlobalSymbol(size_t i, ArrayRef<Elf_Sym> eSyms);
+
   InputSectionBase *getRelocTarget(uint32_t idx, const Elf_Shdr &sec,
                                    uint32_t info);
   InputSectionBase *createInputSection(uint32_t idx, const Elf_Shdr &sec,
@@ -320,6 +327,16 @@ private:
   // If the section does not exist (which is common), the array is empty.
   ArrayRef<Elf_Word> shndxTable;
 
+  // Names of global symbols and hashes of their stems, computed by
+  // preparseSymbolNames(). Indexed by the symbol index minus firstGlobal.
+  // Released once the symbols have been inserted into the symbol table.
+  struct PreparsedName {
+    StringRef name;
+    uint32_t stemSize;
+    uint32_t stemHash;
+  };
+  SmallVector<PreparsedName, 0> preparsedNames;
+
   // Debugging information to retrieve source file and line for error
   // reporting. Linker may find reasonable number of errors in a
   // single object file, so we cache debugging information in order to
@@ -16,9 +16,13 @@
 #include "SyntheticSections.h"
 #include "Target.h"
 #include "lld/Common/CommonLinkerContext.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/BLAKE3.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/Endian.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/xxhash.h"
 #include <algorithm>
 #include <mutex>
@@ -120,10 +124,66 @@ static void decompressAux(const InputSectionBase &sec, uint8_t *out,
           ": decompress failed: " + llvm::toString(std::move(e)));
 }
 
+// Handle --decompress-cache-dir=. The decompressed contents are stored in a
+// file named after a hash of the compressed section (including its header),
+// so unchanged inputs are decompressed only once across links. The file name
+// uses the "llvmcache-" prefix recognized by pruneCache().
+static std::string getDecompressCachePath(ArrayRef<uint8_t> compressed,
+                                          size_t size) {
+  return (config->decompressCacheDir + "/llvmcache-" +
+          toHex(BLAKE3::hash<16>(compressed), /*LowerCase=*/true) + "-" +
+          Twine(size))
+      .str();
+}
+
+static void saveDecompressed(StringRef path, ArrayRef<uint8_t> data) {
+  if (std::error_code ec =
+          sys::fs::create_directories(config->decompressCacheDir)) {
+    log("cannot create " + config->decompressCacheDir + ": " + ec.message());
+    return;
+  }
+  Expected<sys::fs::TempFile> temp =
+      sys::fs::TempFile::create(path + ".tmp-%%%%%%");
+  if (!temp) {
+    log("cannot create a temporary file in " + config->decompressCacheDir +
+        ": " + toString(temp.takeError()));
+    return;
+  }
+  raw_fd_ostream os(temp->FD, /*shouldClose=*/false);
+  os << toStringRef(data);
+  os.flush();
+  if (os.has_error()) {
+    os.clear_error();
+    consumeError(temp->discard());
+    return;
+  }
+  // Another process may have stored the same contents concurrently. Either
+  // copy is fine.
+  if (Error e = temp->keep(path))
+    consumeError(std::move(e));
+}
+
 void InputSectionBase::decompress() const {
+  static std::mutex mu;
+  std::string cachePath;
+  if (!config->decompressCacheDir.empty()) {
+    cachePath =
+        getDecompressCachePath(ArrayRef(content_, compressedSize), size);
+    ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+        MemoryBuffer::getFile(cachePath, /*IsText=*/false,
+                              /*RequiresNullTerminator=*/false);
+    if (mbOrErr && (*mbOrErr)->getBufferSize() == size) {
+      content_ =
+          reinterpret_cast<const uint8_t *>((*mbOrErr)->getBufferStart());
+      compressed = false;
+      std::lock_guard<std::mutex> lock(mu);
+      ctx.memoryBuffers.push_back(std::move(*mbOrErr));
+      return;
+    }
+  }
+
   uint8_t *uncompressedBuf;
   {
-    static std::mutex mu;
     std::lock_guard<std::mutex> lock(mu);
     uncompressedBuf = bAlloc().Allocate<uint8_t>(size);
   }
@@ -131,6 +191,9 @@ void InputSectionBase::decompress() const {
   invokeELFT(decompressAux, *this, uncompressedBuf, size);
   content_ = uncompressedBuf;
   compressed = false;
+
+  if (!cachePath.empty())
+    saveDecompressed(cachePath, ArrayRef(uncompressedBuf, size));
 }
 
 template <class ELFT> RelsOrRelas<ELFT> InputSectionBase::relsOrRelas() const {
@@ -0,0 +1,237 @@
+//===- LayoutManifest.cpp -------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the --incremental-manifest= option. After a successful
+// link, the linker records the content hash of every input file and the
+// placement of every input section in the output, together with the amount
+// of space (including alignment padding) the section occupies:
+//
+//   version  1
+//   file     <xxh3 of contents>  <input file>
+//   section  <output section>  <outSecOff>  <size>  <slot>  <relocs>
+//            <ordinal>  <file>  <name>
+//
+// If the manifest already exists when the next link starts, it is compared
+// against the new link to determine whether the previous layout could be
+// reused: only files whose contents changed would need to be re-read, and
+// each of their sections must still fit into the slot it occupied before.
+// The result is reported with --verbose. Patching the previous output in
+// place is not implemented yet, so the linker always performs a full link.
+//
+//===----------------------------------------------------------------------===//
+
+#include "LayoutManifest.h"
+#include "Config.h"
+#include "InputFiles.h"
+#include "InputSection.h"
+#include "OutputSections.h"
+#include "lld/Common/ErrorHandler.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+using namespace llvm;
+using namespace lld;
+using namespace lld::elf;
+
+static constexpr unsigned manifestVersion = 1;
+
+namespace {
+struct ManifestSection {
+  StringRef osecName;
+  uint64_t outSecOff;
+  uint64_t size;
+  uint64_t slot;
+  uint64_t numRelocs;
+};
+
+struct Manifest {
+  // Input file name to content hash.
+  StringMap<uint64_t> files;
+  // "<file>\0<section name>\0<ordinal>" to the section placement. The ordinal
+  // distinguishes sections with the same name in the same file.
+  StringMap<ManifestSection> sections;
+  // Keys of the maps above in link order, to make the output deterministic.
+  SmallVector<StringRef, 0> fileOrder;
+  SmallVector<StringRef, 0> sectionOrder;
+
+  void addFile(StringRef name, uint64_t hash) {
+    auto [it, inserted] = files.try_emplace(name, hash);
+    if (inserted)
+      fileOrder.push_back(it->getKey());
+  }
+  void addSection(StringRef key, const ManifestSection &s) {
+    auto [it, inserted] = sections.try_emplace(key, s);
+    if (inserted)
+      sectionOrder.push_back(it->getKey());
+  }
+};
+} // namespace
+
+static std::string getSectionKey(StringRef file, StringRef name,
+                                 unsigned ordinal) {
+  return (file + Twine('\0') + name + Twine('\0') + Twine(ordinal)).str();
+}
+
+static void collect(Manifest &m) {
+  SmallVector<ELFFileBase *, 0> files(ctx.objectFiles.begin(),
+                                      ctx.objectFiles.end());
+  SmallVector<uint64_t, 0> hashes(files.size());
+  parallelFor(0, files.size(), [&](size_t i) {
+    hashes[i] = xxh3_64bits(files[i]->mb.getBuffer());
+  });
+  for (size_t i = 0, e = files.size(); i != e; ++i)
+    m.addFile(toString(files[i]), hashes[i]);
+  for (BitcodeFile *file : ctx.bitcodeFiles)
+    m.addFile(toString(file), xxh3_64bits(file->mb.getBuffer()));
+
+  StringMap<unsigned> ordinals;
+  SmallVector<InputSection *, 0> storage;
+  for (OutputSection *osec : outputSections) {
+    ArrayRef<InputSection *> sections = getInputSections(*osec, storage);
+    for (size_t i = 0, e = sections.size(); i != e; ++i) {
+      InputSection *isec = sections[i];
+      if (!isec->file)
+        continue;
+      uint64_t end = i + 1 == e ? osec->size : sections[i + 1]->outSecOff;
+      std::string file = toString(isec->file);
+      unsigned ordinal = ordinals[(file + Twine('\0') + isec->name).str()]++;
+      m.addSection(getSectionKey(file, isec->name, ordinal),
+                   {osec->name, isec->outSecOff, isec->getSize(),
+                    std::max(end, isec->outSecOff) - isec->outSecOff,
+                    isec->relocs().size()});
+    }
+  }
+}
+
+// Parse a manifest written by a previous link. StringRefs in the result point
+// into the buffer.
+static bool parse(StringRef buf, Manifest &m) {
+  SmallVector<StringRef, 0> lines;
+  buf.split(lines, '\n', -1, /*KeepEmpty=*/false);
+  if (lines.empty() ||
+      lines[0] != ("version\t" + Twine(manifestVersion)).str())
+    return false;
+  for (StringRef line : ArrayRef(lines).drop_front()) {
+    SmallVector<StringRef, 8> fields;
+    line.split(fields, '\t');
+    if (fields[0] == "file" && fields.size() == 3) {
+      uint64_t hash;
+      if (fields[1].getAsInteger(16, hash))
+        return false;
+      m.addFile(fields[2], hash);
+    } else if (fields[0] == "section" && fields.size() == 9) {
+      ManifestSection s;
+      unsigned ordinal;
+      s.osecName = fields[1];
+      if (fields[2].getAsInteger(16, s.outSecOff) ||
+          fields[3].getAsInteger(16, s.size) ||
+          fields[4].getAsInteger(16, s.slot) ||
+          fields[5].getAsInteger(10, s.numRelocs) ||
+          fields[6].getAsInteger(10, ordinal))
+        return false;
+      m.addSection(getSectionKey(fields[7], fields[8], ordinal), s);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Report whether the previous layout could have been reused for this link.
+static void compare(const Manifest &prev, const Manifest &cur) {
+  StringMap<bool> changed;
+  for (StringRef name : cur.fileOrder) {
+    auto it = prev.files.find(name);
+    if (it == prev.files.end()) {
+      log("incremental: full relink required: new input " + name);
+      return;
+    }
+    if (it->second != cur.files.lookup(name))
+      changed[name] = true;
+  }
+  if (prev.files.size() != cur.files.size()) {
+    log("incremental: full relink required: input files were removed");
+    return;
+  }
+  if (prev.sections.size() != cur.sections.size()) {
+    log("incremental: full relink required: the set of input sections "
+        "changed");
+    return;
+  }
+
+  for (StringRef key : cur.sectionOrder) {
+    auto it = prev.sections.find(key);
+    StringRef file = key.take_until([](char c) { return c == '\0'; });
+    if (it == prev.sections.end()) {
+      log("incremental: full relink required: new section in " + file);
+      return;
+    }
+    const ManifestSection &p = it->second;
+    const ManifestSection &c = cur.sections.find(key)->second;
+    if (p.osecName != c.osecName) {
+      log("incremental: full relink required: a section of " + file +
+          " moved from " + p.osecName + " to " + c.osecName);
+      return;
+    }
+    if (c.size > p.slot) {
+      log("incremental: full relink required: a section of " + file +
+          " in " + c.osecName + " grew from 0x" + Twine::utohexstr(p.size) +
+          " to 0x" + Twine::utohexstr(c.size) +
+          " bytes, exceeding the available 0x" + Twine::utohexstr(p.slot));
+      return;
+    }
+  }
+
+  log("incremental: previous layout is reusable; " + Twine(changed.size()) +
+      " of " + Twine(cur.files.size()) + " input files changed");
+}
+
+void elf::writeIncrementalManifest() {
+  if (config->incrementalManifest.empty())
+    return;
+
+  llvm::TimeTraceScope timeScope("Write incremental manifest");
+  Manifest cur;
+  collect(cur);
+
+  if (ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+          MemoryBuffer::getFile(config->incrementalManifest)) {
+    Manifest prev;
+    if (parse((*mbOrErr)->getBuffer(), prev))
+      compare(prev, cur);
+    else
+      log("incremental: ignoring malformed manifest " +
+          config->incrementalManifest);
+  }
+
+  std::error_code ec;
+  raw_fd_ostream os = ctx.openAuxiliaryFile(config->incrementalManifest, ec);
+  if (ec) {
+    error("cannot open --incremental-manifest= file " +
+          config->incrementalManifest + ": " + ec.message());
+    return;
+  }
+
+  os << "version\t" << manifestVersion << '\n';
+  for (StringRef name : cur.fileOrder)
+    os << "file\t" << Twine::utohexstr(cur.files.lookup(name)) << '\t' << name
+       << '\n';
+  for (StringRef key : cur.sectionOrder) {
+    const ManifestSection &s = cur.sections.find(key)->second;
+    SmallVector<StringRef, 3> parts;
+    key.split(parts, '\0');
+    os << "section\t" << s.osecName << '\t' << Twine::utohexstr(s.outSecOff)
+       << '\t' << Twine::utohexstr(s.size) << '\t'
+       << Twine::utohexstr(s.slot) << '\t' << s.numRelocs << '\t' << parts[2]
+       << '\t' << parts[0] << '\t' << parts[1] << '\n';
+  }
+}
@@ -17,6 +17,11 @@
 // bits. Writer will then ignore sections whose Live bits are off, so that
 // such sections are not included into output.
 //
+// The main partition is marked level by level. If a level has many sections,
+// their relocations are scanned in parallel for symbols and sections that
+// are not marked yet, and the marks are then set serially, so the result
+// does not depend on the number of threads.
+//
 //===----------------------------------------------------------------------===//
 
 #include "MarkLive.h"
@@ -31,6 +36,7 @@
 #include "lld/Common/Strings.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Object/ELF.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TimeProfiler.h"
 #include <vector>
 
@@ -50,12 +56,25 @@ public:
   void moveToMain();
 
 private:
+  // Symbols and sections referenced by a range of queued sections that are
+  // not marked yet. Filled by markParallel() concurrently.
+  struct Shard {
+    SmallVector<Symbol *, 0> syms;
+    SmallVector<std::pair<InputSectionBase *, uint64_t>, 0> sections;
+  };
+
   void enqueue(InputSectionBase *sec, uint64_t offset);
   void markSymbol(Symbol *sym);
+  void markUsed(Symbol &sym);
+  void visit(InputSectionBase &sec);
   void mark();
+  void markParallel();
 
   template <class RelTy>
   void resolveReloc(InputSectionBase &sec, RelTy &rel, bool fromFDE);
+  template <class RelTy>
+  void collectReloc(InputSectionBase &sec, const RelTy &rel, Shard &shard);
+  void collect(InputSectionBase &sec, Shard &shard);
 
   template <class RelTy>
   void scanEhFrameSection(EhInputSection &eh, ArrayRef<RelTy> rels);
@@ -116,6 +135,11 @@ void MarkLive<ELFT>::resolveReloc(InputSectionBase &sec, RelTy &rel,
     return;
   }
 
+  markUsed(sym);
+}
+
+// Mark a symbol that is not Defined as referenced from a live section.
+template <class ELFT> void MarkLive<ELFT>::markUsed(Symbol &sym) {
   if (auto *ss = dyn_cast<SharedSymbol>(&sym))
     if (!ss->isWeak())
       cast<SharedFile>(ss->file)->isNeeded = true;
@@ -124,6 +148,37 @@ void MarkLive<ELFT>::resolveReloc(InputSectionBase &sec, RelTy &rel,
     enqueue(sec, 0);
 }
 
+// Returns true if enqueue(sec, offset) would have no effect in the main
+// partition.
+static bool isMarked(InputSectionBase *sec, uint64_t offset) {
+  if (auto *ms = dyn_cast<MergeInputSection>(sec))
+    if (!ms->getSectionPiece(offset).live)
+      return false;
+  return sec->partition == 1;
+}
+
+// The concurrent counterpart of resolveReloc() for the main partition. It only
+// reads the marks and records what resolveReloc() would change.
+template <class ELFT>
+template <class RelTy>
+void MarkLive<ELFT>::collectReloc(InputSectionBase &sec, const RelTy &rel,
+                                  Shard &shard) {
+  Symbol &sym = sec.file->getRelocTargetSym(rel);
+  if (!sym.used)
+    shard.syms.push_back(&sym);
+
+  if (auto *d = dyn_cast<Defined>(&sym)) {
+    auto *relSec = dyn_cast_or_null<InputSectionBase>(d->section);
+    if (!relSec)
+      return;
+    uint64_t offset = d->value;
+    if (d->isSection())
+      offset += getAddend<ELFT>(sec, rel);
+    if (!isMarked(relSec, offset))
+      shard.sections.emplace_back(relSec, offset);
+  }
+}
+
 // The .eh_frame section is an unfortunate special case.
 // The section is divided in CIEs and FDEs and the relocations it can have are
 // * CIEs can refer to a personality function.
@@ -297,26 +352,81 @@ template <class ELFT> void MarkLive<ELFT>::run() {
     }
   }
 
-  mark();
+  markParallel();
+}
+
+template <class ELFT> void MarkLive<ELFT>::visit(InputSectionBase &sec) {
+  const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
+  for (const typename ELFT::Rel &rel : rels.rels)
+    resolveReloc(sec, rel, false);
+  for (const typename ELFT::Rela &rel : rels.relas)
+    resolveReloc(sec, rel, false);
+
+  for (InputSectionBase *isec : sec.dependentSections)
+    enqueue(isec, 0);
+
+  // Mark the next group member.
+  if (sec.nextInSectionGroup)
+    enqueue(sec.nextInSectionGroup, 0);
+}
+
+template <class ELFT>
+void MarkLive<ELFT>::collect(InputSectionBase &sec, Shard &shard) {
+  const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
+  for (const typename ELFT::Rel &rel : rels.rels)
+    collectReloc(sec, rel, shard);
+  for (const typename ELFT::Rela &rel : rels.relas)
+    collectReloc(sec, rel, shard);
+
+  for (InputSectionBase *isec : sec.dependentSections)
+    if (!isMarked(isec, 0))
+      shard.sections.emplace_back(isec, 0);
+  if (sec.nextInSectionGroup && !isMarked(sec.nextInSectionGroup, 0))
+    shard.sections.emplace_back(sec.nextInSectionGroup, 0);
 }
 
 template <class ELFT> void MarkLive<ELFT>::mark() {
   // Mark all reachable sections.
-  while (!queue.empty()) {
-    InputSectionBase &sec = *queue.pop_back_val();
-
-    const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
-    for (const typename ELFT::Rel &rel : rels.rels)
-      resolveReloc(sec, rel, false);
-    for (const typename ELFT::Rela &rel : rels.relas)
-      resolveReloc(sec, rel, false);
+  while (!queue.empty())
+    visit(*queue.pop_back_val());
+}
 
-    for (InputSectionBase *isec : sec.dependentSections)
-      enqueue(isec, 0);
+// Mark all reachable sections of the main partition. Unlike mark(), this
+// relies on Symbol::used being unset for symbols that have not been visited,
+// so it cannot be used after other partitions have been processed.
+template <class ELFT> void MarkLive<ELFT>::markParallel() {
+  assert(partition == 1);
+  constexpr size_t shardSize = 256;
+  SmallVector<InputSection *, 0> cur;
+  while (!queue.empty()) {
+    std::swap(cur, queue);
+    queue.clear();
+    if (cur.size() < 2 * shardSize) {
+      for (InputSection *sec : cur)
+        visit(*sec);
+      continue;
+    }
 
-    // Mark the next group member.
-    if (sec.nextInSectionGroup)
-      enqueue(sec.nextInSectionGroup, 0);
+    // Scan the relocations of this level concurrently, then set the marks and
+    // build the next level in a deterministic order.
+    const size_t numShards = divideCeil(cur.size(), shardSize);
+    auto shards = std::make_unique<Shard[]>(numShards);
+    parallelFor(0, numShards, [&](size_t i) {
+      for (InputSection *sec : ArrayRef(cur).slice(
+               i * shardSize, std::min(shardSize, cur.size() - i * shardSize)))
+        collect(*sec, shards[i]);
+    });
+    for (size_t i = 0; i != numShards; ++i) {
+      for (Symbol *sym : shards[i].syms) {
+        if (sym->used)
+          continue;
+        sym->used = true;
+        if (!isa<Defined>(sym))
+          markUsed(*sym);
+      }
+      for (auto [sec, offset] : shards[i].sections)
+        enqueue(sec, offset);
+    }
   }
 }
 
@@ -353,6 +463,7 @@ template <class ELFT> void MarkLive<ELFT>::moveToMain() {
 // so that they are emitted to the output file.
 template <class ELFT> void elf::markLive() {
   llvm::TimeTraceScope timeScope("markLive");
+  ScopedTimer t(ctx.gcTimer);
   // If --gc-sections is not given, retain all input sections.
   if (!config->gcSections) {
     // If a DSO defines a symbol referenced in a regular object, it is needed.
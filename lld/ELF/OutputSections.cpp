@@ -369,9 +369,10 @@ template <class ELFT> void OutputSection::maybeCompress() {
   // useful when there are many compressed output sections.
   addralign = 1;
 
-  // Split input into 1-MiB shards.
-  [[maybe_unused]] constexpr size_t shardSize = 1 << 20;
-  auto shardsIn = split(ArrayRef<uint8_t>(buf.get(), size), shardSize);
+  // Split input into shards (1 MiB by default) that are compressed
+  // independently in parallel.
+  auto shardsIn =
+      split(ArrayRef<uint8_t>(buf.get(), size), config->compressShardSize);
   const size_t numShards = shardsIn.size();
   compressed.numShards = numShards;
   auto shardsOut = std::make_unique<SmallVector<uint8_t, 0>[]>(numShards);
@@ -438,10 +439,12 @@ template <class ELFT> void OutputSection::maybeCompress() {
     compressed.type = ELFCOMPRESS_ZLIB;
     compressed.checksum = checksum;
   }
+#endif
 
+  // Both compressors produce shards. Set them outside of the #if blocks so
+  // that builds with only one of zlib and zstd enabled work.
   compressed.shards = std::move(shardsOut);
   flags |= SHF_COMPRESSED;
-#endif
 }
 
 static void writeInt(uint8_t *buf, uint64_t data, uint64_t size) {
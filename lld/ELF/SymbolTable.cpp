@@ -64,18 +64,14 @@ void SymbolTable::wrap(Symbol *sym, Symbol *real, Symbol *wrap) {
 
 // Find an existing symbol or create a new one.
 Symbol *SymbolTable::insert(StringRef name) {
-  // <name>@@<version> means the symbol is the default version. In that
-  // case <name>@@<version> will be used to resolve references to <name>.
-  //
-  // Since this is a hot path, the following string search code is
-  // optimized for speed. StringRef::find(char) is much faster than
-  // StringRef::find(StringRef).
-  StringRef stem = name;
-  size_t pos = name.find('@');
-  if (pos != StringRef::npos && pos + 1 < name.size() && name[pos + 1] == '@')
-    stem = name.take_front(pos);
-
-  auto p = symMap.insert({CachedHashStringRef(stem), (int)symVector.size()});
+  StringRef stem = getSymbolStem(name);
+  return insert(name, stem, CachedHashStringRef(stem).hash());
+}
+
+Symbol *SymbolTable::insert(StringRef name, StringRef stem,
+                            uint32_t stemHash) {
+  auto p = symMap.insert(
+      {CachedHashStringRef(stem, stemHash), (int)symVector.size()});
   if (!p.second) {
     Symbol *sym = symVector[p.first->second];
     if (stem.size() != name.size()) {
@@ -93,7 +89,7 @@ Symbol *SymbolTable::insert(StringRef name) {
   sym->setName(name);
   sym->partition = 1;
   sym->versionId = VER_NDX_GLOBAL;
-  if (pos != StringRef::npos)
+  if (name.contains('@'))
     sym->hasVersionSuffix = true;
   return sym;
 }
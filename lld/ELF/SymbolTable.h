@@ -36,6 +36,19 @@ struct ArmCmseEntryFunction {
 // to replace the lazy symbol. The logic is implemented in the
 // add*() functions, which are called by input files as they are parsed. There
 // is one add* function per symbol type.
+// <name>@@<version> means the symbol is the default version. In that case
+// <name>@@<version> is used to resolve references to <name>, so symbols are
+// keyed by <name> in the symbol table.
+inline StringRef getSymbolStem(StringRef name) {
+  // Since this is a hot path, the following string search code is
+  // optimized for speed. StringRef::find(char) is much faster than
+  // StringRef::find(StringRef).
+  size_t pos = name.find('@');
+  if (pos != StringRef::npos && pos + 1 < name.size() && name[pos + 1] == '@')
+    return name.take_front(pos);
+  return name;
+}
+
 class SymbolTable {
 public:
   ArrayRef<Symbol *> getSymbols() const { return symVector; }
@@ -43,6 +56,9 @@ public:
   void wrap(Symbol *sym, Symbol *real, Symbol *wrap);
 
   Symbol *insert(StringRef name);
+  // Like insert(), but with the hash of the name's stem (see getSymbolStem)
+  // computed beforehand, possibly on another thread.
+  Symbol *insert(StringRef name, StringRef stem, uint32_t stemHash);
 
   template <typename T> Symbol *addSymbol(const T &newSym) {
     Symbol *sym = insert(newSym.getName());
@@ -12,6 +12,7 @@
 #include "CallGraphSort.h"
 #include "Config.h"
 #include "InputFiles.h"
+#include "LayoutManifest.h"
 #include "LinkerScript.h"
 #include "MapFile.h"
 #include "OutputSections.h"
@@ -77,6 +78,7 @@ private:
   void writeTrapInstr();
   void writeHeader();
   void writeSections();
+  void writeSectionsInWindows();
   void writeSectionsBinary();
   void writeBuildId();
 
@@ -349,6 +351,7 @@ template <class ELFT> void Writer<ELFT>::run() {
 
   {
     llvm::TimeTraceScope timeScope("Write output file");
+    ScopedTimer t(ctx.writeTimer);
     // Write the result down to a file.
     openFile();
     if (errorCount())
@@ -376,6 +379,10 @@ template <class ELFT> void Writer<ELFT>::run() {
     if (!config->cmseOutputLib.empty())
       writeARMCmseImportLib<ELFT>();
   }
+
+  // Handle --incremental-manifest=. Record the layout only once the output
+  // has been written successfully.
+  writeIncrementalManifest();
 }
 
 template <class ELFT, class RelTy>
@@ -1399,6 +1406,7 @@ static void finalizeSynthetic(SyntheticSection *sec) {
 // in Writer<ELFT>::finalizeSections().
 template <class ELFT> void Writer<ELFT>::finalizeAddressDependentContent() {
   llvm::TimeTraceScope timeScope("Finalize address dependent content");
+  ScopedTimer t(ctx.thunksTimer);
   ThunkCreator tc;
   AArch64Err843419Patcher a64p;
   ARMErr657417Patcher a32p;
@@ -1712,6 +1720,7 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
 
   if (!config->relocatable) {
     llvm::TimeTraceScope timeScope("Scan relocations");
+    ScopedTimer t(ctx.scanRelocsTimer);
     // Scan relocations. This must be done after every symbol is declared so
     // that we can correctly decide if a dynamic relocation is needed. This is
     // called after processSymbolAssignments() because it needs to know whether
@@ -2743,7 +2752,9 @@ template <class ELFT> void Writer<ELFT>::writeSections() {
       if (isStaticRelSecType(sec->type))
         sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
   }
-  {
+  if (config->outputWriteWindow) {
+    writeSectionsInWindows();
+  } else {
     parallel::TaskGroup tg;
     for (OutputSection *sec : outputSections)
       if (!isStaticRelSecType(sec->type))
@@ -2758,6 +2769,40 @@ template <class ELFT> void Writer<ELFT>::writeSections() {
   }
 }
 
+// Handle --output-write-window=. Output sections are written in file order in
+// windows of roughly the given size. Sections within a window are written in
+// parallel, and once a window is complete its pages are released so that the
+// resident size is bounded by the window rather than by the whole output. A
+// section larger than the window forms a window of its own.
+template <class ELFT> void Writer<ELFT>::writeSectionsInWindows() {
+  SmallVector<OutputSection *, 0> sections;
+  for (OutputSection *sec : outputSections)
+    if (!isStaticRelSecType(sec->type) && sec->type != SHT_NOBITS)
+      sections.push_back(sec);
+  llvm::stable_sort(sections, [](const OutputSection *a,
+                                 const OutputSection *b) {
+    return a->offset < b->offset;
+  });
+
+  for (size_t begin = 0, end = 0; begin != sections.size(); begin = end) {
+    uint64_t windowStart = sections[begin]->offset;
+    uint64_t windowEnd = windowStart;
+    for (end = begin; end != sections.size(); ++end) {
+      uint64_t secEnd = sections[end]->offset + sections[end]->size;
+      if (end != begin && secEnd - windowStart > config->outputWriteWindow)
+        break;
+      windowEnd = std::max(windowEnd, secEnd);
+    }
+
+    {
+      parallel::TaskGroup tg;
+      for (OutputSection *sec : ArrayRef(sections).slice(begin, end - begin))
+        sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
+    }
+    buffer->releaseRange(windowStart, windowEnd - windowStart);
+  }
+}
+
 // Computes a hash value of Data using a given hash function.
 // In order to utilize multiple cores, we first split data into 1MB
 // chunks, compute a hash for each chunk, and then compute a hash value
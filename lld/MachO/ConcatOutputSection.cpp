@@ -14,7 +14,9 @@
 #include "SyntheticSections.h"
 #include "Target.h"
 #include "lld/Common/CommonLinkerContext.h"
+#include "llvm/ADT/MapVector.h"
 #include "llvm/BinaryFormat/MachO.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/TimeProfiler.h"
 
@@ -131,23 +133,35 @@ bool TextOutputSection::needsThunks() const {
       std::min(target->backwardBranchRange, target->forwardBranchRange))
     return false;
   // Yes, this program is large enough to need thunks.
-  for (ConcatInputSection *isec : inputs) {
-    for (Reloc &r : isec->relocs) {
-      if (!target->hasAttr(r.type, RelocAttrBits::BRANCH))
-        continue;
-      auto *sym = r.referent.get<Symbol *>();
-      // Pre-populate the thunkMap and memoize call site counts for every
-      // InputSection and ThunkInfo. We do this for the benefit of
-      // estimateStubsInRangeVA().
-      ThunkInfo &thunkInfo = thunkMap[sym];
-      // Knowing ThunkInfo call site count will help us know whether or not we
-      // might need to create more for this referent at the time we are
-      // estimating distance to __stubs in estimateStubsInRangeVA().
-      ++thunkInfo.callSiteCount;
-      // We can avoid work on InputSections that have no BRANCH relocs.
-      isec->hasCallSites = true;
-    }
-  }
+  //
+  // Pre-populate the thunkMap and memoize call site counts for every
+  // InputSection and ThunkInfo. We do this for the benefit of
+  // estimateStubsInRangeVA(). Knowing ThunkInfo call site count will help us
+  // know whether or not we might need to create more for this referent at the
+  // time we are estimating distance to __stubs in estimateStubsInRangeVA().
+  //
+  // Scanning the relocations dominates this function for large programs, so
+  // count the call sites of each shard of inputs in parallel and merge the
+  // counts into thunkMap in shard order afterwards.
+  constexpr size_t shardSize = 1024;
+  size_t numShards = divideCeil(inputs.size(), shardSize);
+  auto shardCounts =
+      std::make_unique<MapVector<Symbol *, uint32_t>[]>(numShards);
+  parallelFor(0, numShards, [&](size_t i) {
+    size_t begin = i * shardSize;
+    size_t end = std::min(begin + shardSize, inputs.size());
+    for (ConcatInputSection *isec : ArrayRef(inputs).slice(begin, end - begin))
+      for (Reloc &r : isec->relocs) {
+        if (!target->hasAttr(r.type, RelocAttrBits::BRANCH))
+          continue;
+        ++shardCounts[i][r.referent.get<Symbol *>()];
+        // We can avoid work on InputSections that have no BRANCH relocs.
+        isec->hasCallSites = true;
+      }
+  });
+  for (size_t i = 0; i != numShards; ++i)
+    for (auto [sym, count] : shardCounts[i])
+      thunkMap[sym].callSiteCount += count;
   return true;
 }
 
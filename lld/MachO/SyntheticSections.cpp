@@ -1708,31 +1708,47 @@ void CStringSection::finalizeContents() {
 // `A`, but ld64 will treat them as being 16-byte aligned with an offset of `16
 // % A`.
 void DeduplicatedCStringSection::finalizeContents() {
-  // Find the largest alignment required for each string.
-  for (const CStringInputSection *isec : inputs) {
-    for (const auto &[i, piece] : llvm::enumerate(isec->pieces)) {
-      if (!piece.live)
-        continue;
-      auto s = isec->getCachedHashStringRef(i);
-      assert(isec->align != 0);
-      uint8_t trailingZeros = llvm::countr_zero(isec->align | piece.inSecOff);
-      auto it = stringOffsetMap.insert(
-          std::make_pair(s, StringOffset(trailingZeros)));
-      if (!it.second && it.first->second.trailingZeros < trailingZeros)
-        it.first->second.trailingZeros = trailingZeros;
+  // Concurrency level. Must be a power of 2 to avoid expensive modulo
+  // operations in the following tight loop.
+  const size_t concurrency = llvm::bit_floor(std::min<size_t>(
+      parallel::strategy.compute_thread_count(), numShards));
+
+  // Find the largest alignment required for each string. Each thread handles
+  // the shards whose IDs are congruent to its thread ID, visiting the inputs
+  // in order. Until offsets are assigned, StringPiece::outSecOff holds the
+  // location of the string in its shard.
+  parallelFor(0, concurrency, [&](size_t threadId) {
+    for (CStringInputSection *isec : inputs) {
+      for (const auto &[i, piece] : llvm::enumerate(isec->pieces)) {
+        if (!piece.live)
+          continue;
+        size_t shardId = getShardId(piece.hash);
+        if ((shardId & (concurrency - 1)) != threadId)
+          continue;
+        Shard &shard = shards[shardId];
+        auto s = isec->getCachedHashStringRef(i);
+        assert(isec->align != 0);
+        uint8_t trailingZeros = llvm::countr_zero(isec->align | piece.inSecOff);
+        auto [it, inserted] =
+            shard.indices.try_emplace(s, shard.strings.size());
+        if (inserted)
+          shard.strings.emplace_back(s, StringOffset(trailingZeros));
+        StringOffset &offsetInfo = shard.strings[it->second].second;
+        if (offsetInfo.trailingZeros < trailingZeros)
+          offsetInfo.trailingZeros = trailingZeros;
+        piece.outSecOff = it->second;
+      }
     }
-  }
+  });
 
-  // Assign an offset for each string and save it to the corresponding
-  // StringPieces for easy access.
+  // Assign an offset for each string in the order of first occurrence and
+  // save it to the corresponding StringPieces for easy access.
   for (CStringInputSection *isec : inputs) {
-    for (const auto &[i, piece] : llvm::enumerate(isec->pieces)) {
+    for (StringPiece &piece : isec->pieces) {
       if (!piece.live)
         continue;
-      auto s = isec->getCachedHashStringRef(i);
-      auto it = stringOffsetMap.find(s);
-      assert(it != stringOffsetMap.end());
-      StringOffset &offsetInfo = it->second;
+      auto &[s, offsetInfo] =
+          shards[getShardId(piece.hash)].strings[piece.outSecOff];
       if (offsetInfo.outSecOff == UINT64_MAX) {
         offsetInfo.outSecOff =
             alignToPowerOf2(size, 1ULL << offsetInfo.trailingZeros);
@@ -1746,11 +1762,12 @@ void DeduplicatedCStringSection::finalizeContents() {
 }
 
 void DeduplicatedCStringSection::writeTo(uint8_t *buf) const {
-  for (const auto &p : stringOffsetMap) {
-    StringRef data = p.first.val();
-    uint64_t off = p.second.outSecOff;
-    if (!data.empty())
-      memcpy(buf + off, data.data(), data.size());
+  for (const Shard &shard : shards) {
+    for (const auto &[s, offsetInfo] : shard.strings) {
+      StringRef data = s.val();
+      if (!data.empty())
+        memcpy(buf + offsetInfo.outSecOff, data.data(), data.size());
+    }
   }
 }
 
@@ -1758,10 +1775,11 @@ DeduplicatedCStringSection::StringOffset
 DeduplicatedCStringSection::getStringOffset(StringRef str) const {
   // StringPiece uses 31 bits to store the hashes, so we replicate that
   uint32_t hash = xxh3_64bits(str) & 0x7fffffff;
-  auto offset = stringOffsetMap.find(CachedHashStringRef(str, hash));
-  assert(offset != stringOffsetMap.end() &&
+  const Shard &shard = shards[getShardId(hash)];
+  auto it = shard.indices.find(CachedHashStringRef(str, hash));
+  assert(it != shard.indices.end() &&
          "Looked-up strings should always exist in section");
-  return offset->second;
+  return shard.strings[it->second].second;
 }
 
 // This section is actually emitted as __TEXT,__const by ld64, but clang may
@@ -2464,11 +2482,12 @@ void ChainedFixupsSection::finalizeContents() {
   else
     importFormat = DYLD_CHAINED_IMPORT;
 
-  for (Location &loc : locations)
+  parallelForEach(locations, [](Location &loc) {
     loc.offset =
         loc.isec->parent->getSegmentOffset() + loc.isec->getOffset(loc.offset);
+  });
 
-  llvm::sort(locations, [](const Location &a, const Location &b) {
+  parallelSort(locations, [](const Location &a, const Location &b) {
     const OutputSegment *segA = a.isec->parent->parent;
     const OutputSegment *segB = b.isec->parent->parent;
     if (segA == segB)
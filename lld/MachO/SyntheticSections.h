@@ -579,7 +579,21 @@ public:
   StringOffset getStringOffset(StringRef str) const;
 
 private:
-  llvm::DenseMap<llvm::CachedHashStringRef, StringOffset> stringOffsetMap;
+  // The strings are split into shards by hash so that they can be
+  // deduplicated in parallel. Within a shard, strings are stored in the order
+  // of their first occurrence.
+  static constexpr size_t numShards = 32;
+  struct Shard {
+    llvm::DenseMap<llvm::CachedHashStringRef, uint32_t> indices;
+    std::vector<std::pair<llvm::CachedHashStringRef, StringOffset>> strings;
+  };
+
+  static size_t getShardId(uint32_t hash) {
+    assert((hash >> 31) == 0);
+    return hash >> (31 - llvm::countr_zero(numShards));
+  }
+
+  Shard shards[numShards];
   size_t size = 0;
 };
 
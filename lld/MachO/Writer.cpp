@@ -33,6 +33,7 @@
 #include "llvm/Support/xxhash.h"
 
 #include <algorithm>
+#include <atomic>
 
 using namespace llvm;
 using namespace llvm::MachO;
@@ -1222,36 +1223,46 @@ void Writer::buildFixupChains() {
   const uint64_t pageSize = target->getPageSize();
   constexpr uint32_t stride = 4; // for DYLD_CHAINED_PTR_64
 
-  for (size_t i = 0, count = loc.size(); i < count;) {
+  // Each fixup is linked to the next one if both are on the same page of the
+  // same segment. The links are independent of each other, so they are
+  // written in parallel. Only the error for the first bad link is reported.
+  const size_t count = loc.size();
+  std::atomic<size_t> firstBadIdx = count;
+  parallelFor(1, count, [&](size_t i) {
     const OutputSegment *oseg = loc[i].isec->parent->parent;
-    uint8_t *buf = buffer->getBufferStart() + oseg->fileOff;
-    uint64_t pageIdx = loc[i].offset / pageSize;
-    ++i;
-
-    while (i < count && loc[i].isec->parent->parent == oseg &&
-           (loc[i].offset / pageSize) == pageIdx) {
-      uint64_t offset = loc[i].offset - loc[i - 1].offset;
-
-      auto fail = [&](Twine message) {
-        error(loc[i].isec->getSegName() + "," + loc[i].isec->getName() +
-              ", offset " +
-              Twine(loc[i].offset - loc[i].isec->parent->getSegmentOffset()) +
-              ": " + message);
-      };
-
-      if (offset < target->wordSize)
-        return fail("fixups overlap");
-      if (offset % stride != 0)
-        return fail(
-            "fixups are unaligned (offset " + Twine(offset) +
-            " is not a multiple of the stride). Re-link with -no_fixup_chains");
-
-      // The "next" field is in the same location for bind and rebase entries.
-      reinterpret_cast<dyld_chained_ptr_64_bind *>(buf + loc[i - 1].offset)
-          ->next = offset / stride;
-      ++i;
+    if (loc[i - 1].isec->parent->parent != oseg ||
+        loc[i - 1].offset / pageSize != loc[i].offset / pageSize)
+      return;
+
+    uint64_t offset = loc[i].offset - loc[i - 1].offset;
+    if (offset < target->wordSize || offset % stride != 0) {
+      size_t cur = firstBadIdx.load(std::memory_order_relaxed);
+      while (i < cur && !firstBadIdx.compare_exchange_weak(cur, i))
+        ;
+      return;
     }
-  }
+
+    // The "next" field is in the same location for bind and rebase entries.
+    uint8_t *buf = buffer->getBufferStart() + oseg->fileOff;
+    reinterpret_cast<dyld_chained_ptr_64_bind *>(buf + loc[i - 1].offset)
+        ->next = offset / stride;
+  });
+
+  size_t i = firstBadIdx;
+  if (i == count)
+    return;
+  uint64_t offset = loc[i].offset - loc[i - 1].offset;
+  auto fail = [&](Twine message) {
+    error(loc[i].isec->getSegName() + "," + loc[i].isec->getName() +
+          ", offset " +
+          Twine(loc[i].offset - loc[i].isec->parent->getSegmentOffset()) +
+          ": " + message);
+  };
+  if (offset < target->wordSize)
+    fail("fixups overlap");
+  else
+    fail("fixups are unaligned (offset " + Twine(offset) +
+         " is not a multiple of the stride). Re-link with -no_fixup_chains");
 }
 
 void Writer::writeCodeSignature() {
@@ -18,6 +18,10 @@
 #include <memory>
 #include <vector>
 
+namespace llvm::json {
+class OStream;
+}
+
 namespace lld {
 
 class Timer;
@@ -30,6 +34,7 @@ struct ScopedTimer {
   void stop();
 
   std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+  std::chrono::nanoseconds startCPUTime;
 
   Timer *t = nullptr;
 };
@@ -42,14 +47,28 @@ public:
   explicit Timer(llvm::StringRef name);
 
   void addToTotal(std::chrono::nanoseconds time) { total += time.count(); }
+  void addToCPUTotal(std::chrono::nanoseconds time) {
+    cpuTotal += time.count();
+  }
+  void updatePeakRSS(uint64_t rss);
   void print();
 
+  // Writes this timer and its children as a JSON object with the wall-clock
+  // and CPU time in milliseconds, the average number of busy threads, and the
+  // peak resident set size of the process in bytes at the end of the phase.
+  void writeJSON(llvm::json::OStream &os) const;
+
+  // Resets this timer and its children for the next link.
+  void reset();
+
   double millis() const;
 
 private:
   void print(int depth, double totalDuration, bool recurse = true) const;
 
   std::atomic<std::chrono::nanoseconds::rep> total;
+  std::atomic<std::chrono::nanoseconds::rep> cpuTotal;
+  std::atomic<uint64_t> peakRSS;
   std::vector<Timer *> children;
   std::string name;
 };
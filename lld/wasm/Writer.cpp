@@ -219,9 +219,21 @@ void Writer::writeHeader() {
 
 void Writer::writeSections() {
   uint8_t *buf = buffer->getBufferStart();
-  parallelForEach(outputSections, [buf](OutputSection *s) {
+
+  // The code and data sections write their input chunks in parallel, which
+  // only happens when called from the main thread. Write them first, then
+  // the remaining sections in parallel with each other.
+  auto isSplit = [](OutputSection *s) {
+    return isa<CodeSection>(s) || isa<DataSection>(s);
+  };
+  for (OutputSection *s : outputSections) {
     assert(s->isNeeded());
-    s->writeTo(buf);
+    if (isSplit(s))
+      s->writeTo(buf);
+  }
+  parallelForEach(outputSections, [&](OutputSection *s) {
+    if (!isSplit(s))
+      s->writeTo(buf);
   });
 }
 
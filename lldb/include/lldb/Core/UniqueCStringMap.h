@@ -172,13 +172,31 @@ public:
   /// Sort contents of this map using the provided comparator to break ties for
   /// entries with the same string value.
   template <typename TCompare> void Sort(TCompare tc) {
-    Compare c;
-    llvm::sort(m_map, [&](const Entry &lhs, const Entry &rhs) -> bool {
-      int result = c.ThreeWay(lhs.cstring, rhs.cstring);
-      if (result == 0)
-        return tc(lhs.value, rhs.value);
-      return result < 0;
-    });
+    llvm::sort(m_map, EntryLess(tc));
+  }
+
+  /// Sort contents that consist of consecutive runs of entries which are each
+  /// already sorted with the same comparator, as produced by appending the
+  /// contents of sorted maps.  run_ends holds the index one past the last
+  /// entry of every run, in increasing order. Merging the runs pairwise takes
+  /// O(N log R) time, rather than the O(N log N) of sorting the whole map.
+  template <typename TCompare>
+  void MergeSortedRuns(std::vector<size_t> run_ends, TCompare tc) {
+    auto less = EntryLess(tc);
+    while (run_ends.size() > 1) {
+      std::vector<size_t> merged_ends;
+      merged_ends.reserve((run_ends.size() + 1) / 2);
+      size_t begin = 0;
+      for (size_t i = 0; i < run_ends.size(); i += 2) {
+        if (i + 1 < run_ends.size())
+          std::inplace_merge(m_map.begin() + begin,
+                             m_map.begin() + run_ends[i],
+                             m_map.begin() + run_ends[i + 1], less);
+        begin = run_ends[std::min(i + 1, run_ends.size() - 1)];
+        merged_ends.push_back(begin);
+      }
+      run_ends = std::move(merged_ends);
+    }
   }
 
   // Since we are using a vector to contain our items it will always double its
@@ -206,6 +224,16 @@ public:
   };
 
 protected:
+  /// Orders entries by their string and then by \a tc on their values.
+  template <typename TCompare> static auto EntryLess(TCompare tc) {
+    return [tc](const Entry &lhs, const Entry &rhs) -> bool {
+      int result = Compare().ThreeWay(lhs.cstring, rhs.cstring);
+      if (result == 0)
+        return tc(lhs.value, rhs.value);
+      return result < 0;
+    };
+  }
+
   struct Compare {
     bool operator()(const Entry &lhs, const Entry &rhs) {
       return operator()(lhs.cstring, rhs.cstring);
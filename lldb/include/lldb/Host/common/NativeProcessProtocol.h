@@ -162,6 +162,43 @@ public:
 
   virtual Status RemoveBreakpoint(lldb::addr_t addr, bool hardware = false);
 
+  /// Sets the conditions of the software breakpoint at \a addr. The
+  /// breakpoint only stops the process if one of the conditions evaluates to
+  /// a non-zero value, see EvaluateBreakpointCondition. An empty list makes
+  /// the breakpoint unconditional again.
+  Status SetBreakpointConditions(lldb::addr_t addr,
+                                 std::vector<std::vector<uint8_t>> conditions);
+
+  struct BreakpointConditionStats {
+    /// Number of hits of the breakpoint for which its conditions were
+    /// evaluated.
+    uint64_t evaluations = 0;
+    /// Number of those hits that stopped the process.
+    uint64_t hits = 0;
+  };
+
+  /// Returns how often the conditions of the software breakpoint at \a addr
+  /// were evaluated, or std::nullopt if there is no conditional breakpoint
+  /// there.
+  std::optional<BreakpointConditionStats>
+  GetBreakpointConditionStats(lldb::addr_t addr) const;
+
+  /// Evaluates a breakpoint condition and returns the value left on top of
+  /// the stack.
+  ///
+  /// A condition is a DWARF expression using the literal, constant, stack,
+  /// arithmetic, logical and comparison operations, DW_OP_deref and
+  /// DW_OP_deref_size, and DW_OP_bregN/DW_OP_bregx. Unlike in DWARF, the
+  /// register numbers of the latter are the ones this process uses in the
+  /// 'p' packet.
+  ///
+  /// \param[in] reg_ctx
+  ///     The registers of the thread that hit the breakpoint, or nullptr if
+  ///     the condition must not refer to registers.
+  llvm::Expected<uint64_t>
+  EvaluateBreakpointCondition(llvm::ArrayRef<uint8_t> condition,
+                              NativeRegisterContext *reg_ctx);
+
   // Hardware Breakpoint functions
   virtual const HardwareBreakpointMap &GetHardwareBreakpointMap() const;
 
@@ -268,8 +305,9 @@ public:
     memory_tagging = (1u << 6),
     savecore = (1u << 7),
     siginfo_read = (1u << 8),
+    breakpoint_conditions = (1u << 9),
 
-    LLVM_MARK_AS_BITMASK_ENUM(siginfo_read)
+    LLVM_MARK_AS_BITMASK_ENUM(breakpoint_conditions)
   };
 
   class Manager {
@@ -418,6 +456,8 @@ protected:
     uint32_t ref_count;
     llvm::SmallVector<uint8_t, 4> saved_opcodes;
     llvm::ArrayRef<uint8_t> breakpoint_opcodes;
+    std::vector<std::vector<uint8_t>> conditions;
+    BreakpointConditionStats condition_stats;
   };
 
   std::unordered_map<lldb::addr_t, SoftwareBreakpoint> m_software_breakpoints;
@@ -482,6 +522,18 @@ protected:
   // resets it to point to the breakpoint itself.
   void FixupBreakpointPCAsNeeded(NativeThreadProtocol &thread);
 
+  /// Returns false if \a thread, stopped at the software breakpoint at
+  /// \a addr, should continue because none of the breakpoint's conditions
+  /// hold. Returns true for unconditional breakpoints and for conditions
+  /// that fail to evaluate.
+  bool BreakpointConditionSaysStop(NativeThreadProtocol &thread,
+                                   lldb::addr_t addr);
+
+  /// Writes the trap of the software breakpoint at \a addr, or the original
+  /// instructions if \a enabled is false, without changing its reference
+  /// count. Used to step a thread over the breakpoint.
+  Status SetSoftwareBreakpointTrap(lldb::addr_t addr, bool enabled);
+
   /// Notify the delegate that an exec occurred.
   ///
   /// Provide a mechanism for a delegate to clear out any exec-
@@ -414,6 +414,20 @@ public:
   /// hasn't been indexed yet, or a valid duration if it has.
   virtual StatsDuration::Duration GetDebugInfoIndexTime() { return {}; }
 
+  /// Return the time taken to complete types from the debug information, for
+  /// example by filling in the members and base classes of a class that was
+  /// only forward declared so far.
+  ///
+  /// \returns 0.0 if no types have been completed, or if completing types
+  /// has no cost beyond parsing the debug information.
+  virtual StatsDuration::Duration GetDebugInfoTypeCompletionTime() {
+    return {};
+  }
+
+  /// Return the number of types that were completed from the debug
+  /// information.
+  virtual uint64_t GetDebugInfoTypesCompletedCount() { return 0; }
+
   /// Get the additional modules that this symbol file uses to parse debug info.
   ///
   /// Some debug info is stored in stand alone object files that are represented
@@ -181,6 +181,9 @@ public:
   uint64_t GetDebugInfoSize(bool load_all_debug_info = false) override;
   lldb_private::StatsDuration::Duration GetDebugInfoParseTime() override;
   lldb_private::StatsDuration::Duration GetDebugInfoIndexTime() override;
+  lldb_private::StatsDuration::Duration
+  GetDebugInfoTypeCompletionTime() override;
+  uint64_t GetDebugInfoTypesCompletedCount() override;
 
   uint32_t GetAbilities() override;
 
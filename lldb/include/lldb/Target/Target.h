@@ -12,6 +12,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,7 @@
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/Timeout.h"
 #include "lldb/lldb-public.h"
+#include "llvm/ADT/StringMap.h"
 
 namespace lldb_private {
 
@@ -97,6 +99,10 @@ public:
 
   void SetPreloadSymbols(bool b);
 
+  bool GetParallelModuleLoad() const;
+
+  bool GetCacheExpressions() const;
+
   bool GetDisableASLR() const;
 
   void SetDisableASLR(bool b);
@@ -1174,6 +1180,21 @@ public:
                                const EvaluateExpressionOptions &options,
                                ValueObject *ctx_obj, Status &error);
 
+  /// Removes and returns the expression that was parsed earlier under \a key
+  /// if it can run in \a exe_ctx without being parsed again, or returns null.
+  /// The caller hands it back with CacheUserExpression once it is done, so an
+  /// expression is never executed by two evaluations at the same time.
+  lldb::UserExpressionSP TakeCachedUserExpression(llvm::StringRef key,
+                                                  ExecutionContext &exe_ctx);
+
+  /// Remembers the successfully parsed expression \a expr_sp under \a key.
+  void CacheUserExpression(llvm::StringRef key,
+                           lldb::UserExpressionSP expr_sp);
+
+  /// Forgets all parsed expressions, e.g. because the modules they were
+  /// compiled against changed.
+  void ClearUserExpressionCache();
+
   // Creates a FunctionCaller for the given language, the rest of the
   // parameters have the same meaning as for the FunctionCaller constructor.
   // Since a FunctionCaller can't be
@@ -1567,6 +1588,10 @@ protected:
   lldb::SearchFilterSP m_search_filter_sp;
   PathMappingList m_image_search_paths;
   TypeSystemMap m_scratch_type_system_map;
+  /// Parsed expressions that are reused when the same expression is
+  /// evaluated again, see UserExpression::Evaluate.
+  llvm::StringMap<lldb::UserExpressionSP> m_user_expression_cache;
+  std::mutex m_user_expression_cache_mutex;
 
   typedef std::map<lldb::LanguageType, lldb::REPLSP> REPLMap;
   REPLMap m_repl_map;
@@ -176,6 +176,7 @@ public:
     eServerPacketType_QMemTags, // write memory tags
 
     eServerPacketType_qLLDBSaveCore,
+    eServerPacketType_qBreakpointConditionStats,
     eServerPacketType_QSetIgnoredExceptions,
     eServerPacketType_QNonStop,
     eServerPacketType_vStopped,
@@ -140,6 +140,21 @@ lldb::addr_t UserExpression::GetObjectPointer(lldb::StackFrameSP frame_sp,
   return ret;
 }
 
+/// Returns the key under which the target caches an expression parsed from
+/// the given text and with the given options.
+static std::string GetCacheKey(llvm::StringRef expr, llvm::StringRef prefix,
+                               SourceLanguage language,
+                               Expression::ResultType desired_type,
+                               ExecutionPolicy execution_policy,
+                               bool generate_debug_info) {
+  std::string key;
+  llvm::raw_string_ostream os(key);
+  os << language.name << ':' << language.version << ':' << desired_type << ':'
+     << execution_policy << ':' << generate_debug_info << ':' << prefix.size()
+     << ':' << prefix << expr;
+  return key;
+}
+
 lldb::ExpressionResults
 UserExpression::Evaluate(ExecutionContext &exe_ctx,
                          const EvaluateExpressionOptions &options,
@@ -249,22 +264,42 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, ctx_obj,
-                                           error));
-  if (error.Fail() || !user_expression_sp) {
-    LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
-             error.AsCString());
-    return lldb::eExpressionSetupError;
-  }
-
-  LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
-           expr.str());
-
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
 
+  // Evaluating the same expression again at the same location, as data
+  // formatters and scripts tend to do, can reuse the code compiled the first
+  // time. Expressions that name persistent variables or declarations ($foo)
+  // are not reused since those can be redefined in between.
+  std::string cache_key;
+  if (!ctx_obj && execution_policy != eExecutionPolicyTopLevel &&
+      target->GetCacheExpressions() && !expr.contains('$') &&
+      !full_prefix.contains('$'))
+    cache_key = GetCacheKey(expr, full_prefix, language, desired_type,
+                            execution_policy, generate_debug_info);
+  // A top-level expression can add declarations that change what later
+  // expressions refer to.
+  if (execution_policy == eExecutionPolicyTopLevel)
+    target->ClearUserExpressionCache();
+
+  lldb::UserExpressionSP user_expression_sp;
+  if (!cache_key.empty())
+    user_expression_sp = target->TakeCachedUserExpression(cache_key, exe_ctx);
+  const bool reused_expression = user_expression_sp != nullptr;
+
+  if (!reused_expression) {
+    user_expression_sp.reset(target->GetUserExpressionForLanguage(
+        expr, full_prefix, language, desired_type, options, ctx_obj, error));
+    if (error.Fail() || !user_expression_sp) {
+      LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
+               error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
+  }
+
+  LLDB_LOG(log, "== [UserExpression::Evaluate] {0} expression {1} ==",
+           reused_expression ? "Reusing" : "Parsing", expr.str());
+
   if (options.InvokeCancelCallback(lldb::eExpressionEvaluationParse)) {
     error.SetErrorString("expression interrupted by callback before parse");
     result_valobj_sp = ValueObjectConstResult::Create(
@@ -275,8 +310,13 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
   DiagnosticManager diagnostic_manager;
 
   bool parse_success =
+      reused_expression ||
       user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
                                 keep_expression_in_memory, generate_debug_info);
+  // Only an expression that parsed as written is worth keeping; one that
+  // needed fix-its is keyed on text that does not compile.
+  if (!parse_success || !user_expression_sp->IsParseCacheable())
+    cache_key.clear();
 
   // Calculate the fixed expression always, since we need it for errors.
   std::string tmp_fixed_expression;
@@ -371,6 +411,10 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
           user_expression_sp->Execute(diagnostic_manager, exe_ctx, options,
                                       user_expression_sp, expr_result);
 
+      if (execution_results == lldb::eExpressionCompleted &&
+          !cache_key.empty())
+        target->CacheUserExpression(cache_key, user_expression_sp);
+
       if (execution_results != lldb::eExpressionCompleted) {
         LLDB_LOG(log, "== [UserExpression::Evaluate] Execution completed "
                       "abnormally ==");
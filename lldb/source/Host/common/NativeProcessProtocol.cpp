@@ -14,9 +14,13 @@
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/LLDBLog.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/RegisterValue.h"
 #include "lldb/Utility/State.h"
 #include "lldb/lldb-enumerations.h"
 
+#include "llvm/BinaryFormat/Dwarf.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/LEB128.h"
 #include "llvm/Support/Process.h"
 #include <optional>
 
@@ -646,6 +650,300 @@ Status NativeProcessProtocol::RemoveBreakpoint(lldb::addr_t addr,
     return RemoveSoftwareBreakpoint(addr);
 }
 
+Status NativeProcessProtocol::SetBreakpointConditions(
+    lldb::addr_t addr, std::vector<std::vector<uint8_t>> conditions) {
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end())
+    return Status("Breakpoint not found.");
+  it->second.conditions = std::move(conditions);
+  it->second.condition_stats = {};
+  return Status();
+}
+
+std::optional<NativeProcessProtocol::BreakpointConditionStats>
+NativeProcessProtocol::GetBreakpointConditionStats(lldb::addr_t addr) const {
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end() || it->second.conditions.empty())
+    return std::nullopt;
+  return it->second.condition_stats;
+}
+
+llvm::Expected<uint64_t> NativeProcessProtocol::EvaluateBreakpointCondition(
+    llvm::ArrayRef<uint8_t> condition, NativeRegisterContext *reg_ctx) {
+  using namespace llvm::dwarf;
+
+  auto make_error = [](const llvm::Twine &message) {
+    return llvm::createStringError(llvm::inconvertibleErrorCode(), message);
+  };
+  const uint8_t *pos = condition.begin();
+  const uint8_t *const end = condition.end();
+  auto read_uleb = [&](uint64_t &value) {
+    unsigned size = 0;
+    const char *error = nullptr;
+    value = llvm::decodeULEB128(pos, &size, end, &error);
+    pos += size;
+    return error == nullptr;
+  };
+  auto read_sleb = [&](int64_t &value) {
+    unsigned size = 0;
+    const char *error = nullptr;
+    value = llvm::decodeSLEB128(pos, &size, end, &error);
+    pos += size;
+    return error == nullptr;
+  };
+
+  llvm::SmallVector<uint64_t, 8> stack;
+  while (pos != end) {
+    const uint8_t op = *pos++;
+    // Check the operands an operation needs before popping them.
+    const size_t num_operands = [op]() -> size_t {
+      switch (op) {
+      case DW_OP_dup:
+      case DW_OP_drop:
+      case DW_OP_deref:
+      case DW_OP_deref_size:
+      case DW_OP_plus_uconst:
+      case DW_OP_neg:
+      case DW_OP_not:
+        return 1;
+      case DW_OP_swap:
+      case DW_OP_over:
+      case DW_OP_plus:
+      case DW_OP_minus:
+      case DW_OP_mul:
+      case DW_OP_and:
+      case DW_OP_or:
+      case DW_OP_xor:
+      case DW_OP_shl:
+      case DW_OP_shr:
+      case DW_OP_shra:
+      case DW_OP_eq:
+      case DW_OP_ne:
+      case DW_OP_lt:
+      case DW_OP_gt:
+      case DW_OP_le:
+      case DW_OP_ge:
+        return 2;
+      default:
+        return 0;
+      }
+    }();
+    if (stack.size() < num_operands)
+      return make_error(llvm::formatv("stack underflow at {0}",
+                                      OperationEncodingString(op)));
+
+    if (op >= DW_OP_lit0 && op <= DW_OP_lit31) {
+      stack.push_back(op - DW_OP_lit0);
+      continue;
+    }
+    if ((op >= DW_OP_breg0 && op <= DW_OP_breg31) || op == DW_OP_bregx) {
+      uint64_t regnum = op - DW_OP_breg0;
+      int64_t offset = 0;
+      if ((op == DW_OP_bregx && !read_uleb(regnum)) || !read_sleb(offset))
+        return make_error("truncated register operation");
+      const RegisterInfo *reg_info =
+          reg_ctx ? reg_ctx->GetRegisterInfoAtIndex(regnum) : nullptr;
+      if (!reg_info)
+        return make_error(llvm::formatv("invalid register {0}", regnum));
+      RegisterValue value;
+      Status error = reg_ctx->ReadRegister(reg_info, value);
+      if (error.Fail())
+        return error.ToError();
+      bool success = false;
+      const uint64_t reg_value = value.GetAsUInt64(0, &success);
+      if (!success)
+        return make_error(
+            llvm::formatv("register {0} is not an integer", reg_info->name));
+      stack.push_back(reg_value + offset);
+      continue;
+    }
+
+    switch (op) {
+    case DW_OP_constu: {
+      uint64_t value;
+      if (!read_uleb(value))
+        return make_error("truncated DW_OP_constu");
+      stack.push_back(value);
+      break;
+    }
+    case DW_OP_consts: {
+      int64_t value;
+      if (!read_sleb(value))
+        return make_error("truncated DW_OP_consts");
+      stack.push_back(value);
+      break;
+    }
+    case DW_OP_dup:
+      stack.push_back(stack.back());
+      break;
+    case DW_OP_drop:
+      stack.pop_back();
+      break;
+    case DW_OP_swap:
+      std::swap(stack[stack.size() - 1], stack[stack.size() - 2]);
+      break;
+    case DW_OP_over:
+      stack.push_back(stack[stack.size() - 2]);
+      break;
+    case DW_OP_deref:
+    case DW_OP_deref_size: {
+      size_t size = GetAddressByteSize();
+      if (op == DW_OP_deref_size) {
+        if (pos == end)
+          return make_error("truncated DW_OP_deref_size");
+        size = *pos++;
+      }
+      if (size == 0 || size > sizeof(uint64_t))
+        return make_error(llvm::formatv("invalid dereference size {0}", size));
+      uint8_t bytes[sizeof(uint64_t)];
+      size_t bytes_read = 0;
+      Status error =
+          ReadMemoryWithoutTrap(stack.back(), bytes, size, bytes_read);
+      if (error.Fail())
+        return error.ToError();
+      if (bytes_read != size)
+        return make_error(
+            llvm::formatv("failed to read memory at {0:x}", stack.back()));
+      uint64_t value = 0;
+      for (size_t i = 0; i < size; ++i) {
+        const size_t byte =
+            GetByteOrder() == lldb::eByteOrderBig ? i : size - 1 - i;
+        value = (value << 8) | bytes[byte];
+      }
+      stack.back() = value;
+      break;
+    }
+    case DW_OP_plus_uconst: {
+      uint64_t value;
+      if (!read_uleb(value))
+        return make_error("truncated DW_OP_plus_uconst");
+      stack.back() += value;
+      break;
+    }
+    case DW_OP_neg:
+      stack.back() = -stack.back();
+      break;
+    case DW_OP_not:
+      stack.back() = ~stack.back();
+      break;
+    default: {
+      if (num_operands != 2)
+        return make_error(llvm::formatv("unsupported operation {0:x}", op));
+      const uint64_t rhs = stack.pop_back_val();
+      const uint64_t lhs = stack.back();
+      // DWARF compares values as signed integers.
+      const int64_t slhs = lhs, srhs = rhs;
+      uint64_t &result = stack.back();
+      switch (op) {
+      case DW_OP_plus:
+        result = lhs + rhs;
+        break;
+      case DW_OP_minus:
+        result = lhs - rhs;
+        break;
+      case DW_OP_mul:
+        result = lhs * rhs;
+        break;
+      case DW_OP_and:
+        result = lhs & rhs;
+        break;
+      case DW_OP_or:
+        result = lhs | rhs;
+        break;
+      case DW_OP_xor:
+        result = lhs ^ rhs;
+        break;
+      case DW_OP_shl:
+        result = rhs < 64 ? lhs << rhs : 0;
+        break;
+      case DW_OP_shr:
+        result = rhs < 64 ? lhs >> rhs : 0;
+        break;
+      case DW_OP_shra:
+        result = slhs >> std::min<uint64_t>(rhs, 63);
+        break;
+      case DW_OP_eq:
+        result = slhs == srhs;
+        break;
+      case DW_OP_ne:
+        result = slhs != srhs;
+        break;
+      case DW_OP_lt:
+        result = slhs < srhs;
+        break;
+      case DW_OP_gt:
+        result = slhs > srhs;
+        break;
+      case DW_OP_le:
+        result = slhs <= srhs;
+        break;
+      case DW_OP_ge:
+        result = slhs >= srhs;
+        break;
+      }
+      break;
+    }
+    }
+  }
+
+  if (stack.empty())
+    return make_error("condition left no value on the stack");
+  return stack.back();
+}
+
+bool NativeProcessProtocol::BreakpointConditionSaysStop(
+    NativeThreadProtocol &thread, lldb::addr_t addr) {
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end() || it->second.conditions.empty())
+    return true;
+
+  Log *log = GetLog(LLDBLog::Breakpoints);
+  SoftwareBreakpoint &bp = it->second;
+  ++bp.condition_stats.evaluations;
+  bool should_stop = false;
+  for (const std::vector<uint8_t> &condition : bp.conditions) {
+    llvm::Expected<uint64_t> value =
+        EvaluateBreakpointCondition(condition, &thread.GetRegisterContext());
+    if (!value) {
+      // Let the client find out what is wrong with the condition.
+      LLDB_LOG_ERROR(log, value.takeError(),
+                     "pid {1} tid {2}: failed to evaluate condition of "
+                     "breakpoint at {3:x}: {0}",
+                     GetID(), thread.GetID(), addr);
+      should_stop = true;
+      break;
+    }
+    if (*value) {
+      should_stop = true;
+      break;
+    }
+  }
+  if (should_stop)
+    ++bp.condition_stats.hits;
+  return should_stop;
+}
+
+Status NativeProcessProtocol::SetSoftwareBreakpointTrap(lldb::addr_t addr,
+                                                        bool enabled) {
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end())
+    return Status("Breakpoint not found.");
+  llvm::ArrayRef<uint8_t> opcodes = enabled
+                                        ? it->second.breakpoint_opcodes
+                                        : llvm::ArrayRef<uint8_t>(
+                                              it->second.saved_opcodes);
+  size_t bytes_written = 0;
+  Status error = WriteMemory(addr, opcodes.data(), opcodes.size(),
+                             bytes_written);
+  if (error.Fail())
+    return error;
+  if (bytes_written != opcodes.size())
+    return Status("addr=0x%" PRIx64
+                  ": tried to write %zu bytes but only wrote %zu",
+                  addr, opcodes.size(), bytes_written);
+  return Status();
+}
+
 Status NativeProcessProtocol::ReadMemoryWithoutTrap(lldb::addr_t addr,
                                                     void *buf, size_t size,
                                                     size_t &bytes_read) {
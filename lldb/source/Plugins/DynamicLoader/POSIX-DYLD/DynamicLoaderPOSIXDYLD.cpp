@@ -10,6 +10,7 @@
 #include "DynamicLoaderPOSIXDYLD.h"
 
 #include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
@@ -24,6 +25,7 @@
 #include "lldb/Utility/LLDBLog.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/ProcessInfo.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <memory>
 #include <optional>
@@ -437,6 +439,7 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
       E = m_rendezvous.end();
       m_initial_modules_added = true;
     }
+    PrefetchModules(I, E);
     for (; I != E; ++I) {
       // Don't load a duplicate copy of ld.so if we have already loaded it
       // earlier in LoadInterpreterModule. If we instead loaded then unloaded it
@@ -620,6 +623,25 @@ ModuleSP DynamicLoaderPOSIXDYLD::LoadModuleAtAddress(const FileSpec &file,
   return nullptr;
 }
 
+void DynamicLoaderPOSIXDYLD::PrefetchModules(DYLDRendezvous::iterator begin,
+                                             DYLDRendezvous::iterator end) {
+  if (!m_process->GetTarget().GetParallelModuleLoad() ||
+      std::distance(begin, end) < 2)
+    return;
+
+  // The interpreter is already loaded by LoadInterpreterModule if it is
+  // known, and the callers skip it.
+  const bool skip_interpreter = m_interpreter_module.lock() != nullptr;
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  for (DYLDRendezvous::iterator it = begin; it != end; ++it) {
+    if (skip_interpreter && it->base_addr == m_interpreter_base)
+      continue;
+    FileSpec file = it->file_spec;
+    task_group.async([this, file] { FindModuleViaTarget(file); });
+  }
+  task_group.wait();
+}
+
 void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   DYLDRendezvous::iterator I;
   DYLDRendezvous::iterator E;
@@ -646,6 +668,7 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
     module_names.push_back(I->file_spec);
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
+  PrefetchModules(m_rendezvous.begin(), m_rendezvous.end());
 
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
     ModuleSP module_sp =
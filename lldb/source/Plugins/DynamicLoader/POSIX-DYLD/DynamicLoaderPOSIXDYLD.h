@@ -146,6 +146,15 @@ protected:
   /// of all dependent modules.
   virtual void LoadAllCurrentModules();
 
+  /// Find or create the modules for the given rendezvous entries in parallel,
+  /// if target.parallel-module-load is set. Creating a module parses its
+  /// object file and, with target.preload-symbols, its symbol table and debug
+  /// info index, which is most of the cost of loading a shared library. The
+  /// caller then loads the modules in order, which sets their section load
+  /// addresses on the calling thread.
+  void PrefetchModules(DYLDRendezvous::iterator begin,
+                       DYLDRendezvous::iterator end);
+
   void LoadVDSO();
 
   // Loading an interpreter module (if present) assuming m_interpreter_base
@@ -330,7 +330,7 @@ NativeProcessLinux::Manager::GetSupportedExtensions() const {
   NativeProcessLinux::Extension supported =
       Extension::multiprocess | Extension::fork | Extension::vfork |
       Extension::pass_signals | Extension::auxv | Extension::libraries_svr4 |
-      Extension::siginfo_read;
+      Extension::siginfo_read | Extension::breakpoint_conditions;
 
 #ifdef __aarch64__
   // At this point we do not have a process so read auxv directly.
@@ -657,6 +657,8 @@ void NativeProcessLinux::MonitorSIGTRAP(const siginfo_t &info,
 
     // Exec clears any pending notifications.
     m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
+    m_threads_stepping_over_condition.clear();
+    m_condition_traps_removed.clear();
 
     // Remove all but the main thread here.  Linux fork creates a new process
     // which only copies the main thread.
@@ -815,6 +817,16 @@ void NativeProcessLinux::MonitorTrace(NativeThreadLinux &thread) {
   Log *log = GetLog(POSIXLog::Process);
   LLDB_LOG(log, "received trace event, pid = {0}", thread.GetID());
 
+  if (m_threads_stepping_over_condition.erase(thread.GetID())) {
+    // The thread stepped over a breakpoint whose condition did not hold.
+    thread.SetStoppedWithNoReason();
+    if (m_pending_notification_tid != LLDB_INVALID_THREAD_ID)
+      SignalIfAllThreadsStopped();
+    else if (m_threads_stepping_over_condition.empty())
+      FinishStepOverBreakpointConditions(/*resume=*/true);
+    return;
+  }
+
   // This thread is currently stopped.
   thread.SetStoppedByTrace();
 
@@ -1009,6 +1021,17 @@ Status NativeProcessLinux::Resume(const ResumeActionList &resume_actions) {
 
   bool software_single_step = !SupportHardwareSingleStepping();
 
+  m_threads_left_stopped.clear();
+  m_resumed_stepping = false;
+  for (const auto &thread : m_threads) {
+    const ResumeAction *const action =
+        resume_actions.GetActionForThread(thread->GetID(), true);
+    if (!action || !StateIsRunningState(action->state))
+      m_threads_left_stopped.insert(thread->GetID());
+    else if (action->state == eStateStepping)
+      m_resumed_stepping = true;
+  }
+
   if (software_single_step) {
     for (const auto &thread : m_threads) {
       assert(thread && "thread list should not contain NULL threads");
@@ -1779,6 +1802,10 @@ void NativeProcessLinux::StopTrackingThread(NativeThreadLinux &thread) {
   m_threads.erase(it);
 
   NotifyTracersOfThreadDestroyed(thread_id);
+  if (m_threads_stepping_over_condition.erase(thread_id) &&
+      m_threads_stepping_over_condition.empty() &&
+      m_pending_notification_tid == LLDB_INVALID_THREAD_ID)
+    FinishStepOverBreakpointConditions(/*resume=*/true);
   SignalIfAllThreadsStopped();
 }
 
@@ -1955,6 +1982,14 @@ void NativeProcessLinux::SignalIfAllThreadsStopped() {
   // We have a pending notification and all threads have stopped.
   Log *log = GetLog(LLDBLog::Process | LLDBLog::Breakpoints);
 
+  // Something interrupted stepping threads over conditional breakpoints, so
+  // the traps that were taken out for that must go back in.
+  if (!m_condition_traps_removed.empty())
+    FinishStepOverBreakpointConditions(/*resume=*/false);
+
+  if (StepOverUnmetBreakpointConditions())
+    return;
+
   // Clear any temporary breakpoints we used to implement software single
   // stepping.
   for (const auto &thread_info : m_threads_stepping_with_breakpoint) {
@@ -1971,6 +2006,100 @@ void NativeProcessLinux::SignalIfAllThreadsStopped() {
   m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
 }
 
+bool NativeProcessLinux::StepOverUnmetBreakpointConditions() {
+  // Stepping over the breakpoint needs hardware single stepping, and the
+  // client must see every stop while it is stepping a thread itself.
+  if (m_resumed_stepping || !SupportHardwareSingleStepping() ||
+      !m_threads_stepping_with_breakpoint.empty())
+    return false;
+
+  Log *log = GetLog(LLDBLog::Breakpoints);
+  llvm::SmallVector<NativeThreadLinux *, 4> threads_to_step;
+  for (const auto &thread_sp : m_threads) {
+    auto &thread = static_cast<NativeThreadLinux &>(*thread_sp);
+    if (m_threads_left_stopped.contains(thread.GetID()))
+      continue;
+    ThreadStopInfo stop_info;
+    std::string description;
+    if (!thread.GetStopReason(stop_info, description))
+      return false;
+    // Threads that were only stopped because another one stopped.
+    if (stop_info.reason == eStopReasonNone)
+      continue;
+    if (stop_info.reason != eStopReasonBreakpoint)
+      return false;
+    const lldb::addr_t pc = thread.GetRegisterContext().GetPC();
+    auto bp = m_software_breakpoints.find(pc);
+    if (bp == m_software_breakpoints.end() || bp->second.conditions.empty() ||
+        BreakpointConditionSaysStop(thread, pc))
+      return false;
+    threads_to_step.push_back(&thread);
+  }
+  if (threads_to_step.empty())
+    return false;
+
+  // Leave the other threads stopped while the trap is out of the way, so
+  // that none of them can run past the breakpoint unnoticed.
+  const lldb::tid_t pending_notification_tid = m_pending_notification_tid;
+  m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
+  for (NativeThreadLinux *thread : threads_to_step) {
+    const lldb::addr_t pc = thread->GetRegisterContext().GetPC();
+    if (!llvm::is_contained(m_condition_traps_removed, pc)) {
+      Status error = SetSoftwareBreakpointTrap(pc, /*enabled=*/false);
+      if (error.Fail()) {
+        LLDB_LOG(log, "pid {0} failed to remove breakpoint trap at {1:x}: {2}",
+                 GetID(), pc, error);
+        FinishStepOverBreakpointConditions(/*resume=*/false);
+        m_pending_notification_tid = pending_notification_tid;
+        return false;
+      }
+      m_condition_traps_removed.push_back(pc);
+    }
+  }
+  for (NativeThreadLinux *thread : threads_to_step) {
+    LLDB_LOG(log,
+             "pid {0} tid {1}: breakpoint condition not met, stepping over",
+             GetID(), thread->GetID());
+    m_threads_stepping_over_condition.insert(thread->GetID());
+    Status error = ResumeThread(*thread, eStateStepping,
+                                LLDB_INVALID_SIGNAL_NUMBER);
+    if (error.Fail()) {
+      LLDB_LOG(log, "pid {0} tid {1}: failed to step: {2}", GetID(),
+               thread->GetID(), error);
+      m_threads_stepping_over_condition.erase(thread->GetID());
+    }
+  }
+  if (m_threads_stepping_over_condition.empty())
+    FinishStepOverBreakpointConditions(/*resume=*/true);
+  return true;
+}
+
+void NativeProcessLinux::FinishStepOverBreakpointConditions(bool resume) {
+  Log *log = GetLog(LLDBLog::Breakpoints);
+  for (lldb::addr_t addr : m_condition_traps_removed) {
+    Status error = SetSoftwareBreakpointTrap(addr, /*enabled=*/true);
+    if (error.Fail())
+      LLDB_LOG(log, "pid {0} failed to restore breakpoint trap at {1:x}: {2}",
+               GetID(), addr, error);
+  }
+  m_condition_traps_removed.clear();
+  m_threads_stepping_over_condition.clear();
+  if (!resume)
+    return;
+
+  for (const auto &thread_sp : m_threads) {
+    auto &thread = static_cast<NativeThreadLinux &>(*thread_sp);
+    if (m_threads_left_stopped.contains(thread.GetID()) ||
+        StateIsRunningState(thread.GetState()))
+      continue;
+    Status error =
+        ResumeThread(thread, eStateRunning, LLDB_INVALID_SIGNAL_NUMBER);
+    if (error.Fail())
+      LLDB_LOG(log, "pid {0} tid {1}: failed to resume: {2}", GetID(),
+               thread.GetID(), error);
+  }
+}
+
 void NativeProcessLinux::ThreadWasCreated(NativeThreadLinux &thread) {
   Log *const log = GetLog(POSIXLog::Thread);
   LLDB_LOG(log, "tid: {0}", thread.GetID());
@@ -19,6 +19,7 @@
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/lldb-types.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallPtrSet.h"
 
 #include "IntelPTCollector.h"
@@ -180,6 +181,17 @@ private:
 
   lldb::tid_t m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
 
+  /// Threads that the last Resume() left stopped, and whether it single
+  /// stepped any thread.
+  llvm::DenseSet<lldb::tid_t> m_threads_left_stopped;
+  bool m_resumed_stepping = false;
+
+  /// Threads that are being stepped over a conditional breakpoint whose
+  /// conditions did not hold, and the breakpoints whose traps were removed
+  /// for that.
+  llvm::DenseSet<lldb::tid_t> m_threads_stepping_over_condition;
+  llvm::SmallVector<lldb::addr_t, 2> m_condition_traps_removed;
+
   /// Inferior memory (allocated by us) and its size.
   llvm::DenseMap<lldb::addr_t, lldb::addr_t> m_allocated_memory;
 
@@ -257,6 +269,16 @@ private:
   // Notify the delegate if all threads have stopped.
   void SignalIfAllThreadsStopped();
 
+  /// Called once all threads have stopped. If all threads that stopped for a
+  /// reason of their own did so at conditional breakpoints whose conditions
+  /// do not hold, steps them over those breakpoints and returns true: the
+  /// process then continues without the stop being reported.
+  bool StepOverUnmetBreakpointConditions();
+
+  /// Puts back the traps taken out by StepOverUnmetBreakpointConditions and,
+  /// if \a resume is true, continues the threads that Resume() had resumed.
+  void FinishStepOverBreakpointConditions(bool resume);
+
   // Resume the given thread, optionally passing it the given signal. The type
   // of resume
   // operation (continue, single-step) depends on the state parameter.
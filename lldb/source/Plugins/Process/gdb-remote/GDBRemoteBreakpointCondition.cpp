@@ -0,0 +1,253 @@
+//===-- GDBRemoteBreakpointCondition.cpp ----------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "GDBRemoteBreakpointCondition.h"
+
+#include "lldb/lldb-defines.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/BinaryFormat/Dwarf.h"
+#include "llvm/Support/LEB128.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::process_gdb_remote;
+using namespace llvm::dwarf;
+
+namespace {
+/// A recursive descent parser that emits the expression as it goes:
+///
+///   or         := and ('||' and)*
+///   and        := unary ('&&' unary)*
+///   unary      := '!' unary | '(' or ')' | comparison
+///   comparison := operand (('==' | '!=' | '<' | '<=' | '>' | '>=') operand)?
+///   operand    := '$' register | '-'? integer
+///
+/// Every comparison leaves 0 or 1 on the stack, so the logical operators can
+/// be emitted as their bitwise counterparts.
+class ConditionCompiler {
+public:
+  ConditionCompiler(
+      llvm::StringRef text,
+      llvm::function_ref<const RegisterInfo *(llvm::StringRef)> get_register)
+      : m_text(text), m_get_register(get_register) {}
+
+  std::optional<std::vector<uint8_t>> Compile() {
+    if (!ParseOr())
+      return std::nullopt;
+    if (!m_text.ltrim().empty())
+      return std::nullopt;
+    return std::move(m_expr);
+  }
+
+private:
+  struct Operand {
+    const RegisterInfo *reg = nullptr;
+    bool negative = false;
+    uint64_t magnitude = 0;
+  };
+
+  bool Consume(llvm::StringRef token) {
+    m_text = m_text.ltrim();
+    return m_text.consume_front(token);
+  }
+
+  bool ParseOr() {
+    if (!ParseAnd())
+      return false;
+    while (Consume("||")) {
+      if (!ParseAnd())
+        return false;
+      m_expr.push_back(DW_OP_or);
+    }
+    return true;
+  }
+
+  bool ParseAnd() {
+    if (!ParseUnary())
+      return false;
+    while (Consume("&&")) {
+      if (!ParseUnary())
+        return false;
+      m_expr.push_back(DW_OP_and);
+    }
+    return true;
+  }
+
+  bool ParseUnary() {
+    if (Consume("!")) {
+      if (!ParseUnary())
+        return false;
+      m_expr.push_back(DW_OP_lit0);
+      m_expr.push_back(DW_OP_eq);
+      return true;
+    }
+    if (Consume("("))
+      return ParseOr() && Consume(")");
+    return ParseComparison();
+  }
+
+  bool ParseOperand(Operand &operand) {
+    if (Consume("$")) {
+      llvm::StringRef name = m_text.take_while(
+          [](char c) { return llvm::isAlnum(c) || c == '_'; });
+      m_text = m_text.drop_front(name.size());
+      operand.reg = name.empty() ? nullptr : m_get_register(name);
+      return operand.reg != nullptr;
+    }
+    operand.negative = Consume("-");
+    m_text = m_text.ltrim();
+    if (m_text.empty() || !llvm::isDigit(m_text.front()) ||
+        m_text.consumeInteger(0, operand.magnitude))
+      return false;
+    // Suffixes like 'u' or 'll' change the type of the literal.
+    return m_text.empty() ||
+           !(llvm::isAlnum(m_text.front()) || m_text.front() == '_');
+  }
+
+  bool ParseComparison() {
+    Operand lhs;
+    if (!ParseOperand(lhs))
+      return false;
+
+    m_text = m_text.ltrim();
+    // Shifts and assignments are not supported.
+    if (m_text.starts_with("<<") || m_text.starts_with(">>") ||
+        (m_text.starts_with("=") && !m_text.starts_with("==")))
+      return false;
+    static constexpr std::pair<llvm::StringLiteral, uint8_t> g_operators[] = {
+        {"==", DW_OP_eq}, {"!=", DW_OP_ne}, {"<=", DW_OP_le},
+        {">=", DW_OP_ge}, {"<", DW_OP_lt},  {">", DW_OP_gt},
+    };
+    uint8_t op = DW_OP_ne;
+    Operand rhs;
+    bool has_operator = false;
+    for (const auto &entry : g_operators) {
+      if (Consume(entry.first)) {
+        op = entry.second;
+        has_operator = true;
+        break;
+      }
+    }
+    if (has_operator && !ParseOperand(rhs))
+      return false;
+
+    // Bring the comparison into the form "register op literal".
+    if (!lhs.reg) {
+      std::swap(lhs, rhs);
+      switch (op) {
+      case DW_OP_lt:
+        op = DW_OP_gt;
+        break;
+      case DW_OP_gt:
+        op = DW_OP_lt;
+        break;
+      case DW_OP_le:
+        op = DW_OP_ge;
+        break;
+      case DW_OP_ge:
+        op = DW_OP_le;
+        break;
+      }
+    }
+    if (!lhs.reg || rhs.reg)
+      return false;
+    return EmitComparison(*lhs.reg, rhs, op);
+  }
+
+  bool EmitComparison(const RegisterInfo &reg, const Operand &literal,
+                      uint8_t op) {
+    const uint32_t regnum = reg.kinds[eRegisterKindProcessPlugin];
+    const uint32_t bits = reg.byte_size * 8;
+    if (regnum == LLDB_INVALID_REGNUM || bits == 0 || bits > 64)
+      return false;
+
+    // The stub compares signed 64-bit values, so sign-extend signed registers
+    // and move unsigned 64-bit ones into the signed range.
+    uint64_t value;
+    switch (reg.encoding) {
+    case eEncodingUint:
+      if (literal.negative ||
+          (bits < 64 && literal.magnitude >> bits != 0))
+        return false;
+      EmitRegister(regnum);
+      value = literal.magnitude;
+      if (bits == 64) {
+        const uint64_t bias = UINT64_C(1) << 63;
+        EmitUnsigned(bias);
+        m_expr.push_back(DW_OP_xor);
+        value ^= bias;
+      }
+      break;
+    case eEncodingSint: {
+      const uint64_t limit = UINT64_C(1) << (bits - 1);
+      if (literal.magnitude > (literal.negative ? limit : limit - 1))
+        return false;
+      EmitRegister(regnum);
+      if (bits < 64) {
+        EmitUnsigned(64 - bits);
+        m_expr.push_back(DW_OP_shl);
+        EmitUnsigned(64 - bits);
+        m_expr.push_back(DW_OP_shra);
+      }
+      value = literal.negative ? 0 - literal.magnitude : literal.magnitude;
+      break;
+    }
+    default:
+      return false;
+    }
+
+    if (static_cast<int64_t>(value) < 0) {
+      uint8_t buffer[16];
+      m_expr.push_back(DW_OP_consts);
+      unsigned size =
+          llvm::encodeSLEB128(static_cast<int64_t>(value), buffer);
+      m_expr.insert(m_expr.end(), buffer, buffer + size);
+    } else {
+      EmitUnsigned(value);
+    }
+    m_expr.push_back(op);
+    return true;
+  }
+
+  void EmitRegister(uint32_t regnum) {
+    uint8_t buffer[16];
+    if (regnum < 32) {
+      m_expr.push_back(DW_OP_breg0 + regnum);
+    } else {
+      m_expr.push_back(DW_OP_bregx);
+      unsigned size = llvm::encodeULEB128(regnum, buffer);
+      m_expr.insert(m_expr.end(), buffer, buffer + size);
+    }
+    // The offset.
+    unsigned size = llvm::encodeSLEB128(0, buffer);
+    m_expr.insert(m_expr.end(), buffer, buffer + size);
+  }
+
+  void EmitUnsigned(uint64_t value) {
+    if (value < 32) {
+      m_expr.push_back(DW_OP_lit0 + value);
+      return;
+    }
+    uint8_t buffer[16];
+    m_expr.push_back(DW_OP_constu);
+    unsigned size = llvm::encodeULEB128(value, buffer);
+    m_expr.insert(m_expr.end(), buffer, buffer + size);
+  }
+
+  llvm::StringRef m_text;
+  llvm::function_ref<const RegisterInfo *(llvm::StringRef)> m_get_register;
+  std::vector<uint8_t> m_expr;
+};
+} // namespace
+
+std::optional<std::vector<uint8_t>>
+lldb_private::process_gdb_remote::CompileBreakpointCondition(
+    llvm::StringRef condition,
+    llvm::function_ref<const RegisterInfo *(llvm::StringRef)> get_register) {
+  return ConditionCompiler(condition, get_register).Compile();
+}
@@ -0,0 +1,46 @@
+//===-- GDBRemoteBreakpointCondition.h --------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_SOURCE_PLUGINS_PROCESS_GDB_REMOTE_GDBREMOTEBREAKPOINTCONDITION_H
+#define LLDB_SOURCE_PLUGINS_PROCESS_GDB_REMOTE_GDBREMOTEBREAKPOINTCONDITION_H
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "lldb/lldb-private-types.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace lldb_private {
+namespace process_gdb_remote {
+
+/// Compile the condition of a breakpoint into a DWARF expression that the
+/// remote stub can evaluate each time the breakpoint is hit.
+///
+/// Only conditions that depend on nothing but the registers of the stopped
+/// thread are supported: comparisons of a register with an integer, like
+/// "$rdi == 3" or "$x0 >= 0x1000", combined with "!", "&&", "||" and
+/// parentheses. A register on its own is compared with zero. The integer must
+/// be representable in the type of the register, so that the comparison gives
+/// the same result as when the expression parser evaluates the condition.
+///
+/// \param[in] get_register
+///     Look up a register by name, without the leading '$'. The register is
+///     read in the expression by its eRegisterKindProcessPlugin number.
+///
+/// \return
+///     The expression, or std::nullopt if the condition is not supported.
+std::optional<std::vector<uint8_t>> CompileBreakpointCondition(
+    llvm::StringRef condition,
+    llvm::function_ref<const RegisterInfo *(llvm::StringRef)> get_register);
+
+} // namespace process_gdb_remote
+} // namespace lldb_private
+
+#endif // LLDB_SOURCE_PLUGINS_PROCESS_GDB_REMOTE_GDBREMOTEBREAKPOINTCONDITION_H
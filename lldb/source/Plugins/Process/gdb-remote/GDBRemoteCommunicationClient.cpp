@@ -184,6 +184,12 @@ bool GDBRemoteCommunicationClient::GetQXferSigInfoReadSupported() {
   return m_supports_qXfer_siginfo_read == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetBreakpointConditionsSupported() {
+  if (m_supports_breakpoint_conditions == eLazyBoolCalculate)
+    GetRemoteQSupported();
+  return m_supports_breakpoint_conditions == eLazyBoolYes;
+}
+
 bool GDBRemoteCommunicationClient::GetMultiprocessSupported() {
   if (m_supports_memory_tagging == eLazyBoolCalculate)
     GetRemoteQSupported();
@@ -285,6 +291,7 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_avoid_g_packets = eLazyBoolCalculate;
     m_supports_multiprocess = eLazyBoolCalculate;
     m_supports_qSaveCore = eLazyBoolCalculate;
+    m_supports_breakpoint_conditions = eLazyBoolCalculate;
     m_supports_qXfer_auxv_read = eLazyBoolCalculate;
     m_supports_qXfer_libraries_read = eLazyBoolCalculate;
     m_supports_qXfer_libraries_svr4_read = eLazyBoolCalculate;
@@ -345,6 +352,7 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
   m_supports_QPassSignals = eLazyBoolNo;
   m_supports_memory_tagging = eLazyBoolNo;
   m_supports_qSaveCore = eLazyBoolNo;
+  m_supports_breakpoint_conditions = eLazyBoolNo;
   m_uses_native_signals = eLazyBoolNo;
 
   m_max_packet_size = UINT64_MAX; // It's supposed to always be there, but if
@@ -394,6 +402,8 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
         m_supports_memory_tagging = eLazyBoolYes;
       else if (x == "qSaveCore+")
         m_supports_qSaveCore = eLazyBoolYes;
+      else if (x == "dwarf-breakpoint-conditions+")
+        m_supports_breakpoint_conditions = eLazyBoolYes;
       else if (x == "native-signals+")
         m_uses_native_signals = eLazyBoolYes;
       // Look for a list of compressions in the features list e.g.
@@ -2810,7 +2820,8 @@ bool GDBRemoteCommunicationClient::GetThreadStopInfo(
 
 uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
     GDBStoppointType type, bool insert, addr_t addr, uint32_t length,
-    std::chrono::seconds timeout) {
+    std::chrono::seconds timeout,
+    llvm::ArrayRef<std::vector<uint8_t>> conditions) {
   Log *log = GetLog(LLDBLog::Breakpoints);
   LLDB_LOGF(log, "GDBRemoteCommunicationClient::%s() %s at addr = 0x%" PRIx64,
             __FUNCTION__, insert ? "add" : "remove", addr);
@@ -2818,20 +2829,23 @@ uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
   // Check if the stub is known not to support this breakpoint type
   if (!SupportsGDBStoppointPacket(type))
     return UINT8_MAX;
+  assert((conditions.empty() ||
+          (insert && type == eBreakpointSoftware &&
+           GetBreakpointConditionsSupported())) &&
+         "stub cannot evaluate breakpoint conditions");
   // Construct the breakpoint packet
-  char packet[64];
-  const int packet_len =
-      ::snprintf(packet, sizeof(packet), "%c%i,%" PRIx64 ",%x",
-                 insert ? 'Z' : 'z', type, addr, length);
-  // Check we haven't overwritten the end of the packet buffer
-  assert(packet_len + 1 < (int)sizeof(packet));
-  UNUSED_IF_ASSERT_DISABLED(packet_len);
+  StreamString packet;
+  packet.Printf("%c%i,%" PRIx64 ",%x", insert ? 'Z' : 'z', type, addr, length);
+  for (const std::vector<uint8_t> &condition : conditions) {
+    packet.Printf(";X%zx,", condition.size());
+    packet.PutBytesAsRawHex8(condition.data(), condition.size());
+  }
   StringExtractorGDBRemote response;
   // Make sure the response is either "OK", "EXX" where XX are two hex digits,
   // or "" (unsupported)
   response.SetResponseValidatorToOKErrorNotSupported();
   // Try to send the breakpoint packet, and check that it was correctly sent
-  if (SendPacketAndWaitForResponse(packet, response, timeout) ==
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, timeout) ==
       PacketResult::Success) {
     // Receive and OK packet when the breakpoint successfully placed
     if (response.IsOKResponse())
@@ -2869,6 +2883,29 @@ uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
   return UINT8_MAX;
 }
 
+bool GDBRemoteCommunicationClient::GetBreakpointConditionStats(
+    lldb::addr_t addr, uint64_t &evaluations, uint64_t &hits) {
+  if (!GetBreakpointConditionsSupported())
+    return false;
+  StreamString packet;
+  packet.Printf("qBreakpointConditionStats:%" PRIx64, addr);
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet.GetString(), response) !=
+          PacketResult::Success ||
+      !response.IsNormalResponse())
+    return false;
+
+  bool has_evaluations = false, has_hits = false;
+  llvm::StringRef name, value;
+  while (response.GetNameColonValue(name, value)) {
+    if (name == "evaluations")
+      has_evaluations = !value.getAsInteger(16, evaluations);
+    else if (name == "hits")
+      has_hits = !value.getAsInteger(16, hits);
+  }
+  return has_evaluations && has_hits;
+}
+
 std::vector<std::pair<lldb::pid_t, lldb::tid_t>>
 GDBRemoteCommunicationClient::GetCurrentProcessAndThreadIDs(
     bool &sequence_mutex_unavailable) {
@@ -285,7 +285,21 @@ public:
       bool insert,           // Insert or remove?
       lldb::addr_t addr,     // Address of breakpoint or watchpoint
       uint32_t length,       // Byte Size of breakpoint or watchpoint
-      std::chrono::seconds interrupt_timeout); // Time to wait for an interrupt
+      std::chrono::seconds interrupt_timeout, // Time to wait for an interrupt
+      // Conditions for the stub to evaluate, see
+      // GetBreakpointConditionsSupported.
+      llvm::ArrayRef<std::vector<uint8_t>> conditions = {});
+
+  /// Returns true if the stub can evaluate the conditions of software
+  /// breakpoints itself. Each condition is a DWARF expression whose register
+  /// operations use the stub's register numbers, and the stub only stops if
+  /// one of the conditions is non-zero.
+  bool GetBreakpointConditionsSupported();
+
+  /// Gets how often the stub evaluated the conditions of the breakpoint at
+  /// \a addr and how many of those evaluations stopped the process.
+  bool GetBreakpointConditionStats(lldb::addr_t addr, uint64_t &evaluations,
+                                   uint64_t &hits);
 
   void TestPacketSpeed(const uint32_t num_packets, uint32_t max_send,
                        uint32_t max_recv, uint64_t recv_amount, bool json,
@@ -560,6 +574,7 @@ protected:
   LazyBool m_supports_multiprocess = eLazyBoolCalculate;
   LazyBool m_supports_memory_tagging = eLazyBoolCalculate;
   LazyBool m_supports_qSaveCore = eLazyBoolCalculate;
+  LazyBool m_supports_breakpoint_conditions = eLazyBoolCalculate;
   LazyBool m_uses_native_signals = eLazyBoolCalculate;
 
   bool m_supports_qProcessInfoPID : 1, m_supports_qfProcessInfo : 1,
@@ -193,6 +193,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
                                 &GDBRemoteCommunicationServerLLGS::Handle_Z);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_z,
                                 &GDBRemoteCommunicationServerLLGS::Handle_z);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_qBreakpointConditionStats,
+      &GDBRemoteCommunicationServerLLGS::Handle_qBreakpointConditionStats);
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_QPassSignals,
       &GDBRemoteCommunicationServerLLGS::Handle_QPassSignals);
@@ -724,6 +727,61 @@ static const char *GetStopReasonString(StopReason stop_reason) {
   return nullptr;
 }
 
+/// Append the frame pointer backchain of the thread to a stop reply as
+/// "memory:<addr>=<bytes>;" pairs, the way debugserver does. The client adds
+/// these to its memory cache, which saves a memory read packet per frame when
+/// it unwinds the stack after the stop. Only architectures whose frame records
+/// hold the caller's frame pointer followed by the return address are handled.
+static void AppendExpeditedFramePointerChain(StreamString &response,
+                                             NativeThreadProtocol &thread,
+                                             uint32_t max_frames) {
+  NativeProcessProtocol &process = thread.GetProcess();
+  switch (process.GetArchitecture().GetMachine()) {
+  case llvm::Triple::x86:
+  case llvm::Triple::x86_64:
+  case llvm::Triple::aarch64:
+    break;
+  default:
+    return;
+  }
+
+  const uint32_t addr_size = process.GetAddressByteSize();
+  if (addr_size != 4 && addr_size != 8)
+    return;
+
+  const size_t record_size = 2 * addr_size;
+  lldb::addr_t fp = thread.GetRegisterContext().GetFP(0);
+  for (uint32_t i = 0; i < max_frames && fp != 0 && fp % addr_size == 0; ++i) {
+    uint8_t record[16];
+    size_t bytes_read = 0;
+    Status error =
+        process.ReadMemoryWithoutTrap(fp, record, record_size, bytes_read);
+    if (error.Fail() || bytes_read != record_size)
+      break;
+
+    response.Printf("memory:0x%" PRIx64 "=", fp);
+    response.PutBytesAsRawHex8(record, record_size);
+    response.PutChar(';');
+
+    // The server runs on the target, so the record is in host byte order.
+    lldb::addr_t caller_fp;
+    if (addr_size == 8) {
+      uint64_t value;
+      memcpy(&value, record, sizeof(value));
+      caller_fp = value;
+    } else {
+      uint32_t value;
+      memcpy(&value, record, sizeof(value));
+      caller_fp = value;
+    }
+    // The stack grows down, so the caller's frame record must be above this
+    // one. Stop at anything else rather than following a corrupt chain.
+    if (caller_fp <= fp)
+      break;
+    fp = caller_fp;
+  }
+}
+
 static llvm::Expected<json::Array>
 GetJSONThreadsInfo(NativeProcessProtocol &process, bool abridged) {
   Log *log = GetLog(LLDBLog::Process | LLDBLog::Thread);
@@ -950,6 +1008,10 @@ GDBRemoteCommunicationServerLLGS::PrepareStopReplyPacketForThread(
     }
   }
 
+  // Expedite the frame records of the innermost frames, which the client
+  // reads to unwind the stack after almost every stop.
+  AppendExpeditedFramePointerChain(response, thread, 16);
+
   const char *reason_str = GetStopReasonString(tid_stop_info.reason);
   if (reason_str != nullptr) {
     response.Printf("reason:%s;", reason_str);
@@ -2894,10 +2956,39 @@ GDBRemoteCommunicationServerLLGS::Handle_Z(StringExtractorGDBRemote &packet) {
     return SendIllFormedResponse(
         packet, "Malformed Z packet, failed to parse size argument");
 
+  // Parse out the conditions of a software breakpoint, each of which is given
+  // as ";X<length>,<bytes>" like in gdb's cond_list. The bytes are a DWARF
+  // expression, see NativeProcessProtocol::EvaluateBreakpointCondition.
+  std::vector<std::vector<uint8_t>> conditions;
+  while (packet.GetBytesLeft() > 0) {
+    if (packet.GetChar() != ';' || packet.GetChar() != 'X')
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, expecting ';X' before condition");
+    if (stoppoint_type != eBreakpointSoftware ||
+        !bool(m_process_manager.GetSupportedExtensions() &
+              NativeProcessProtocol::Extension::breakpoint_conditions))
+      return SendUnimplementedResponse(packet.GetStringRef().data());
+    const uint32_t length =
+        packet.GetHexMaxU32(false, std::numeric_limits<uint32_t>::max());
+    if (length == std::numeric_limits<uint32_t>::max() ||
+        packet.GetChar() != ',')
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, failed to parse condition length");
+    std::vector<uint8_t> &condition = conditions.emplace_back(length);
+    if (packet.GetHexBytes(condition, 0) != length)
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, condition is shorter than its length");
+  }
+
   if (want_breakpoint) {
     // Try to set the breakpoint.
-    const Status error =
-        m_current_process->SetBreakpoint(addr, size, want_hardware);
+    Status error = m_current_process->SetBreakpoint(addr, size, want_hardware);
+    // A breakpoint set again without conditions becomes unconditional.
+    if (error.Success() && !want_hardware &&
+        bool(m_process_manager.GetSupportedExtensions() &
+             NativeProcessProtocol::Extension::breakpoint_conditions))
+      error = m_current_process->SetBreakpointConditions(
+          addr, std::move(conditions));
     if (error.Success())
       return SendOKResponse();
     Log *log = GetLog(LLDBLog::Breakpoints);
@@ -3004,6 +3095,34 @@ GDBRemoteCommunicationServerLLGS::Handle_z(StringExtractorGDBRemote &packet) {
   }
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_qBreakpointConditionStats(
+    StringExtractorGDBRemote &packet) {
+  // Ensure we have a process.
+  if (!m_current_process ||
+      (m_current_process->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    Log *log = GetLog(LLDBLog::Process);
+    LLDB_LOG(log, "failed, no process available");
+    return SendErrorResponse(0x15);
+  }
+
+  packet.SetFilePos(strlen("qBreakpointConditionStats:"));
+  const lldb::addr_t addr = packet.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+  if (addr == LLDB_INVALID_ADDRESS || packet.GetBytesLeft() != 0)
+    return SendIllFormedResponse(
+        packet, "Malformed qBreakpointConditionStats packet, bad address");
+
+  std::optional<NativeProcessProtocol::BreakpointConditionStats> stats =
+      m_current_process->GetBreakpointConditionStats(addr);
+  if (!stats)
+    return SendErrorResponse(Status("No conditional breakpoint at address"));
+
+  StreamString response;
+  response.Format("evaluations:{0:x-};hits:{1:x-};", stats->evaluations,
+                  stats->hits);
+  return SendPacketNoLock(response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_s(StringExtractorGDBRemote &packet) {
   Log *log = GetLog(LLDBLog::Process | LLDBLog::Thread);
@@ -4230,6 +4349,8 @@ std::vector<std::string> GDBRemoteCommunicationServerLLGS::HandleFeatures(
     ret.push_back("memory-tagging+");
   if (bool(plugin_features & Extension::savecore))
     ret.push_back("qSaveCore+");
+  if (bool(plugin_features & Extension::breakpoint_conditions))
+    ret.push_back("dwarf-breakpoint-conditions+");
 
   // check for client features
   m_extensions_supported = {};
@@ -211,6 +211,9 @@ protected:
 
   PacketResult Handle_z(StringExtractorGDBRemote &packet);
 
+  PacketResult
+  Handle_qBreakpointConditionStats(StringExtractorGDBRemote &packet);
+
   PacketResult Handle_s(StringExtractorGDBRemote &packet);
 
   PacketResult Handle_qXfer(StringExtractorGDBRemote &packet);
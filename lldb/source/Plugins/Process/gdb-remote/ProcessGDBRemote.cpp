@@ -23,6 +23,7 @@
 #include <ctime>
 #include <sys/types.h>
 
+#include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Breakpoint/WatchpointAlgorithms.h"
 #include "lldb/Breakpoint/WatchpointResource.h"
@@ -74,6 +75,7 @@
 #include <sstream>
 #include <thread>
 
+#include "GDBRemoteBreakpointCondition.h"
 #include "GDBRemoteRegisterContext.h"
 #include "GDBRemoteRegisterFallback.h"
 #include "Plugins/Process/Utility/GDBRemoteSignals.h"
@@ -167,6 +169,12 @@ public:
     const uint32_t idx = ePropertyUseGPacketForReading;
     return GetPropertyAtIndexAs<bool>(idx, true);
   }
+
+  bool GetServerBreakpointConditions() const {
+    const uint32_t idx = ePropertyServerBreakpointConditions;
+    return GetPropertyAtIndexAs<bool>(
+        idx, g_processgdbremote_properties[idx].default_uint_value != 0);
+  }
 };
 
 } // namespace
@@ -211,6 +219,24 @@ void ProcessGDBRemote::DumpPluginHistory(Stream &s) {
   gdb_comm.DumpHistory(s);
 }
 
+void ProcessGDBRemote::DumpBreakpointConditionStats(Stream &s) {
+  if (m_breakpoint_site_conditions.empty()) {
+    s.PutCString("No breakpoint conditions are evaluated by the stub.\n");
+    return;
+  }
+  for (const auto &entry : m_breakpoint_site_conditions) {
+    const addr_t addr = entry.first;
+    uint64_t evaluations = 0;
+    uint64_t hits = 0;
+    if (!m_gdb_comm.GetBreakpointConditionStats(addr, evaluations, hits)) {
+      s.Format("{0:x}: failed to get the statistics\n", addr);
+      continue;
+    }
+    s.Format("{0:x}: {1} conditions, {2} evaluations, {3} hits\n", addr,
+             entry.second.size(), evaluations, hits);
+  }
+}
+
 std::chrono::seconds ProcessGDBRemote::GetPacketTimeout() {
   return std::chrono::seconds(GetGlobalPluginProperties().GetPacketTimeout());
 }
@@ -1185,6 +1211,8 @@ Status ProcessGDBRemote::DoResume() {
   Log *log = GetLog(GDBRLog::Process);
   LLDB_LOGF(log, "ProcessGDBRemote::Resume()");
 
+  UpdateBreakpointSiteConditions();
+
   ListenerSP listener_sp(
       Listener::MakeListener("gdb-remote.resume-packet-sent"));
   if (listener_sp->StartListeningForEvents(
@@ -3002,12 +3030,17 @@ Status ProcessGDBRemote::EnableBreakpointSite(BreakpointSite *bp_site) {
   if (m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointSoftware) &&
       (!bp_site->HardwareRequired())) {
     // Try to send off a software breakpoint packet ($Z0)
+    std::vector<std::vector<uint8_t>> conditions =
+        GetBreakpointSiteConditions(*bp_site);
     uint8_t error_no = m_gdb_comm.SendGDBStoppointTypePacket(
-        eBreakpointSoftware, true, addr, bp_op_size, GetInterruptTimeout());
+        eBreakpointSoftware, true, addr, bp_op_size, GetInterruptTimeout(),
+        conditions);
     if (error_no == 0) {
       // The breakpoint was placed successfully
       bp_site->SetEnabled(true);
       bp_site->SetType(BreakpointSite::eExternal);
+      if (!conditions.empty())
+        m_breakpoint_site_conditions[addr] = std::move(conditions);
       return error;
     }
 
@@ -3117,6 +3150,8 @@ Status ProcessGDBRemote::DisableBreakpointSite(BreakpointSite *bp_site) {
                                                 addr, bp_op_size,
                                                 GetInterruptTimeout()))
         error.SetErrorToGenericError();
+      else
+        m_breakpoint_site_conditions.erase(addr);
     } break;
     }
     if (error.Success())
@@ -3134,6 +3169,72 @@ Status ProcessGDBRemote::DisableBreakpointSite(BreakpointSite *bp_site) {
   return error;
 }
 
+std::vector<std::vector<uint8_t>>
+ProcessGDBRemote::GetBreakpointSiteConditions(BreakpointSite &bp_site) {
+  std::vector<std::vector<uint8_t>> conditions;
+  if (!GetGlobalPluginProperties().GetServerBreakpointConditions() ||
+      !m_gdb_comm.GetBreakpointConditionsSupported() || !m_register_info_sp)
+    return conditions;
+
+  // The stub may only skip a stop that no enabled location wants, so every
+  // one of them needs a condition that it can evaluate.
+  auto get_register = [this](llvm::StringRef name) {
+    return m_register_info_sp->GetRegisterInfo(name);
+  };
+  const size_t num_constituents = bp_site.GetNumberOfConstituents();
+  for (size_t i = 0; i < num_constituents; ++i) {
+    BreakpointLocationSP loc_sp = bp_site.GetConstituentAtIndex(i);
+    if (!loc_sp || !loc_sp->IsEnabled())
+      continue;
+    const char *condition_text = loc_sp->GetConditionText();
+    std::optional<std::vector<uint8_t>> condition =
+        condition_text
+            ? CompileBreakpointCondition(condition_text, get_register)
+            : std::nullopt;
+    if (!condition)
+      return {};
+    conditions.push_back(std::move(*condition));
+  }
+  return conditions;
+}
+
+void ProcessGDBRemote::UpdateBreakpointSiteConditions() {
+  if (!m_gdb_comm.GetBreakpointConditionsSupported())
+    return;
+  Log *log = GetLog(GDBRLog::Breakpoints);
+  GetBreakpointSiteList().ForEach([&](BreakpointSite *bp_site) {
+    if (!bp_site->IsEnabled() ||
+        bp_site->GetType() != BreakpointSite::eExternal)
+      return;
+    const addr_t addr = bp_site->GetLoadAddress();
+    std::vector<std::vector<uint8_t>> conditions =
+        GetBreakpointSiteConditions(*bp_site);
+    auto pos = m_breakpoint_site_conditions.find(addr);
+    if (pos == m_breakpoint_site_conditions.end() ? conditions.empty()
+                                                   : pos->second == conditions)
+      return;
+
+    // Locations or their conditions changed since the site was enabled.
+    // Setting the breakpoint again replaces its conditions, and removing the
+    // extra reference afterwards keeps the trap in place all along.
+    const size_t bp_op_size = GetSoftwareBreakpointTrapOpcode(bp_site);
+    if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr,
+                                              bp_op_size, GetInterruptTimeout(),
+                                              conditions) != 0) {
+      LLDB_LOG(log,
+               "failed to update the conditions of the breakpoint at {0:x}",
+               addr);
+      return;
+    }
+    m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, false, addr,
+                                          bp_op_size, GetInterruptTimeout());
+    if (conditions.empty())
+      m_breakpoint_site_conditions.erase(addr);
+    else
+      m_breakpoint_site_conditions[addr] = std::move(conditions);
+  });
+}
+
 // Pre-requisite: wp != NULL.
 static GDBStoppointType
 GetGDBStoppointType(const WatchpointResourceSP &wp_res_sp) {
@@ -5347,6 +5448,33 @@ public:
   }
 };
 
+class CommandObjectProcessGDBRemoteBreakpointConditions
+    : public CommandObjectParsed {
+public:
+  CommandObjectProcessGDBRemoteBreakpointConditions(
+      CommandInterpreter &interpreter)
+      : CommandObjectParsed(
+            interpreter, "process plugin breakpoint-conditions",
+            "Show how often the remote stub evaluated the breakpoint "
+            "conditions it was sent, and how often one of them was true. See "
+            "the plugin.process.gdb-remote.server-breakpoint-conditions "
+            "setting.",
+            nullptr) {}
+
+  ~CommandObjectProcessGDBRemoteBreakpointConditions() override = default;
+
+  void DoExecute(Args &command, CommandReturnObject &result) override {
+    ProcessGDBRemote *process =
+        (ProcessGDBRemote *)m_interpreter.GetExecutionContext().GetProcessPtr();
+    if (process) {
+      process->DumpBreakpointConditionStats(result.GetOutputStream());
+      result.SetStatus(eReturnStatusSuccessFinishResult);
+      return;
+    }
+    result.SetStatus(eReturnStatusFailed);
+  }
+};
+
 class CommandObjectProcessGDBRemotePacketXferSize : public CommandObjectParsed {
 private:
 public:
@@ -5522,6 +5650,10 @@ public:
     LoadSubCommand(
         "packet",
         CommandObjectSP(new CommandObjectProcessGDBRemotePacket(interpreter)));
+    LoadSubCommand("breakpoint-conditions",
+                   CommandObjectSP(
+                       new CommandObjectProcessGDBRemoteBreakpointConditions(
+                           interpreter)));
   }
 
   ~CommandObjectMultiwordProcessGDBRemote() override = default;
@@ -5539,9 +5671,15 @@ void ProcessGDBRemote::DidForkSwitchSoftwareBreakpoints(bool enable) {
     if (bp_site->IsEnabled() &&
         (bp_site->GetType() == BreakpointSite::eSoftware ||
          bp_site->GetType() == BreakpointSite::eExternal)) {
+      const addr_t addr = bp_site->GetLoadAddress();
+      llvm::ArrayRef<std::vector<uint8_t>> conditions;
+      auto pos = m_breakpoint_site_conditions.find(addr);
+      if (enable && pos != m_breakpoint_site_conditions.end())
+        conditions = pos->second;
       m_gdb_comm.SendGDBStoppointTypePacket(
-          eBreakpointSoftware, enable, bp_site->GetLoadAddress(),
-          GetSoftwareBreakpointTrapOpcode(bp_site), GetInterruptTimeout());
+          eBreakpointSoftware, enable, addr,
+          GetSoftwareBreakpointTrapOpcode(bp_site), GetInterruptTimeout(),
+          conditions);
     }
   });
 }
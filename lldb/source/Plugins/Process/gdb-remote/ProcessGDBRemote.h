@@ -80,6 +80,10 @@ public:
   
   void DumpPluginHistory(Stream &s) override;
 
+  /// Print how often the stub evaluated the conditions of each breakpoint
+  /// site and how often it stopped because one of them was true.
+  void DumpBreakpointConditionStats(Stream &s);
+
   // Creating a new process, or attaching to an existing one
   Status DoWillLaunch(Module *module) override;
 
@@ -289,6 +293,10 @@ protected:
   uint64_t m_remote_stub_max_memory_size; // The maximum memory size the remote
                                           // gdb stub can handle
   MMapMap m_addr_to_mmap_size;
+  /// The conditions sent with the Z0 packet of each breakpoint site that has
+  /// any, see GetBreakpointSiteConditions().
+  std::map<lldb::addr_t, std::vector<std::vector<uint8_t>>>
+      m_breakpoint_site_conditions;
   lldb::BreakpointSP m_thread_create_bp_sp;
   bool m_waiting_for_attach;
   lldb::CommandObjectSP m_command_sp;
@@ -469,6 +477,17 @@ private:
   ProcessGDBRemote(const ProcessGDBRemote &) = delete;
   const ProcessGDBRemote &operator=(const ProcessGDBRemote &) = delete;
 
+  /// Compile the conditions of the enabled locations of \a bp_site for the
+  /// stub to evaluate. Returns an empty list if the stub should stop
+  /// unconditionally, which is the case if any of the conditions can't be
+  /// compiled.
+  std::vector<std::vector<uint8_t>>
+  GetBreakpointSiteConditions(BreakpointSite &bp_site);
+
+  /// Resend the conditions of the breakpoint sites whose locations changed
+  /// since they were enabled.
+  void UpdateBreakpointSiteConditions();
+
   // fork helpers
   void DidForkSwitchSoftwareBreakpoints(bool enable);
   void DidForkSwitchHardwareTraps(bool enable);
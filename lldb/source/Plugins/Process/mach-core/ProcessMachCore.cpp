@@ -10,6 +10,7 @@
 #include <cstdlib>
 
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Threading.h"
 
 #include "lldb/Core/Debugger.h"
@@ -419,26 +420,59 @@ void ProcessMachCore::LoadBinariesViaExhaustiveSearch() {
   // binaries.  There may be multiple things that look like a kernel
   // in the corefile; disambiguating to the correct one can be difficult.
 
-  std::vector<addr_t> dylds_found;
-  std::vector<addr_t> kernels_found;
-
+  // Reading the start of every page touches the whole corefile, which takes
+  // a long time for large corefiles that aren't in the file cache. Split the
+  // address ranges into chunks that are scanned on the debugger's thread
+  // pool, and combine the results in address order afterwards so that they
+  // are the same as for a scan on one thread.
+  const addr_t page_size = 0x1000;
+  const addr_t chunk_size = 0x4000 * page_size;
+  struct ScanChunk {
+    addr_t start;
+    addr_t end;
+    std::vector<addr_t> dylds;
+    std::vector<addr_t> kernels;
+  };
+  std::vector<ScanChunk> chunks;
   const size_t num_core_aranges = m_core_aranges.GetSize();
   for (size_t i = 0; i < num_core_aranges; ++i) {
     const VMRangeToFileOffset::Entry *entry = m_core_aranges.GetEntryAtIndex(i);
-    lldb::addr_t section_vm_addr_start = entry->GetRangeBase();
-    lldb::addr_t section_vm_addr_end = entry->GetRangeEnd();
-    for (lldb::addr_t section_vm_addr = section_vm_addr_start;
-         section_vm_addr < section_vm_addr_end; section_vm_addr += 0x1000) {
-      addr_t dyld, kernel;
-      if (CheckAddressForDyldOrKernel(section_vm_addr, dyld, kernel)) {
-        if (dyld != LLDB_INVALID_ADDRESS)
-          dylds_found.push_back(dyld);
-        if (kernel != LLDB_INVALID_ADDRESS)
-          kernels_found.push_back(kernel);
-      }
+    lldb::addr_t chunk_start = entry->GetRangeBase();
+    const lldb::addr_t section_vm_addr_end = entry->GetRangeEnd();
+    while (chunk_start < section_vm_addr_end) {
+      const lldb::addr_t chunk_end =
+          section_vm_addr_end - chunk_start > chunk_size
+              ? chunk_start + chunk_size
+              : section_vm_addr_end;
+      chunks.push_back({chunk_start, chunk_end, {}, {}});
+      chunk_start = chunk_end;
     }
   }
 
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  for (ScanChunk &chunk : chunks) {
+    task_group.async([this, &chunk, page_size] {
+      for (lldb::addr_t section_vm_addr = chunk.start;
+           section_vm_addr < chunk.end; section_vm_addr += page_size) {
+        addr_t dyld, kernel;
+        if (CheckAddressForDyldOrKernel(section_vm_addr, dyld, kernel)) {
+          if (dyld != LLDB_INVALID_ADDRESS)
+            chunk.dylds.push_back(dyld);
+          if (kernel != LLDB_INVALID_ADDRESS)
+            chunk.kernels.push_back(kernel);
+        }
+      }
+    });
+  }
+  task_group.wait();
+
+  std::vector<addr_t> dylds_found;
+  std::vector<addr_t> kernels_found;
+  for (const ScanChunk &chunk : chunks) {
+    llvm::append_range(dylds_found, chunk.dylds);
+    llvm::append_range(kernels_found, chunk.kernels);
+  }
+
   // If we found more than one dyld mach-o header in the corefile,
   // pick the first one.
   if (dylds_found.size() > 0)
@@ -84,8 +84,16 @@ void ManualDWARFIndex::Index() {
   // caused us to load the unit's DIEs.
   std::vector<std::optional<DWARFUnit::ScopedExtractDIEs>> clear_cu_dies(
       units_to_index.size());
+  // Sort the index of every unit on the thread that built it, so that the
+  // per-unit indexes only need to be merged below.
   auto parser_fn = [&](size_t cu_idx) {
-    IndexUnit(*units_to_index[cu_idx], dwp_dwarf, sets[cu_idx]);
+    IndexSet &set = sets[cu_idx];
+    IndexUnit(*units_to_index[cu_idx], dwp_dwarf, set);
+    for (NameToDIE *index :
+         {&set.function_basenames, &set.function_fullnames,
+          &set.function_methods, &set.function_selectors,
+          &set.objc_class_selectors, &set.globals, &set.types, &set.namespaces})
+      index->Finalize();
     progress.Increment();
   };
 
@@ -117,10 +125,11 @@ void ManualDWARFIndex::Index() {
   task_group.wait();
 
   auto finalize_fn = [this, &sets, &progress](NameToDIE(IndexSet::*index)) {
-    NameToDIE &result = m_set.*index;
+    std::vector<const NameToDIE *> unit_indexes;
+    unit_indexes.reserve(sets.size());
     for (auto &set : sets)
-      result.Append(set.*index);
-    result.Finalize();
+      unit_indexes.push_back(&(set.*index));
+    (m_set.*index).Merge(unit_indexes);
     progress.Increment();
   };
 
@@ -27,6 +27,24 @@ void NameToDIE::Finalize() {
   m_map.SizeToFit();
 }
 
+void NameToDIE::Merge(llvm::ArrayRef<const NameToDIE *> others) {
+  size_t total = 0;
+  for (const NameToDIE *other : others)
+    total += other->m_map.GetSize();
+
+  m_map.Clear();
+  m_map.Reserve(total);
+  std::vector<size_t> run_ends;
+  run_ends.reserve(others.size());
+  for (const NameToDIE *other : others) {
+    if (other->IsEmpty())
+      continue;
+    Append(*other);
+    run_ends.push_back(m_map.GetSize());
+  }
+  m_map.MergeSortedRuns(std::move(run_ends), std::less<DIERef>());
+}
+
 void NameToDIE::Insert(ConstString name, const DIERef &die_ref) {
   m_map.Append(name, die_ref);
 }
@@ -15,6 +15,7 @@
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/dwarf.h"
 #include "lldb/lldb-defines.h"
+#include "llvm/ADT/ArrayRef.h"
 
 namespace lldb_private::plugin {
 namespace dwarf {
@@ -34,6 +35,12 @@ public:
 
   void Finalize();
 
+  /// Replace the contents of this object with the union of \a others, which
+  /// must all have been finalized. The result is finalized as well. Merging
+  /// the sorted entries is much faster than appending them and sorting the
+  /// result.
+  void Merge(llvm::ArrayRef<const NameToDIE *> others);
+
   bool Find(ConstString name,
             llvm::function_ref<bool(DIERef ref)> callback) const;
 
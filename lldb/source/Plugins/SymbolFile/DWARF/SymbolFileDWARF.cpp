@@ -1648,8 +1648,17 @@ bool SymbolFileDWARF::CompleteType(CompilerType &compiler_type) {
           dwarf_die.GetID(), dwarf_die.GetTagAsCString(),
           type->GetName().AsCString());
     assert(compiler_type);
-    if (DWARFASTParser *dwarf_ast = GetDWARFParser(*dwarf_die.GetCU()))
-      return dwarf_ast->CompleteTypeFromDWARF(dwarf_die, type, compiler_type);
+    if (DWARFASTParser *dwarf_ast = GetDWARFParser(*dwarf_die.GetCU())) {
+      ++m_num_types_completed;
+      std::optional<ElapsedTime> elapsed;
+      if (m_type_completion_depth == 0)
+        elapsed.emplace(m_type_completion_time);
+      ++m_type_completion_depth;
+      bool completed =
+          dwarf_ast->CompleteTypeFromDWARF(dwarf_die, type, compiler_type);
+      --m_type_completion_depth;
+      return completed;
+    }
   }
   return false;
 }
@@ -309,6 +309,13 @@ public:
   }
   StatsDuration::Duration GetDebugInfoIndexTime() override;
 
+  StatsDuration::Duration GetDebugInfoTypeCompletionTime() override {
+    return m_type_completion_time;
+  }
+  uint64_t GetDebugInfoTypesCompletedCount() override {
+    return m_num_types_completed;
+  }
+
   StatsDuration &GetDebugInfoParseTimeRef() { return m_parse_time; }
 
   virtual lldb::offset_t
@@ -547,6 +554,12 @@ protected:
   /// address in the module.
   lldb::addr_t m_first_code_address = LLDB_INVALID_ADDRESS;
   StatsDuration m_parse_time;
+  /// Time spent in CompleteType. Types completed while completing another
+  /// type are only counted once, as part of the outermost completion.
+  StatsDuration m_type_completion_time;
+  uint64_t m_num_types_completed = 0;
+  /// The depth of nested CompleteType calls, guarded by the module mutex.
+  unsigned m_type_completion_depth = 0;
   std::atomic_flag m_dwo_warning_issued = ATOMIC_FLAG_INIT;
   /// If this DWARF file a .DWO file or a DWARF .o file on mac when
   /// no dSYM file is being used, this file index will be set to a
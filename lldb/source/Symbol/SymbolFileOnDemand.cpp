@@ -556,6 +556,19 @@ StatsDuration::Duration SymbolFileOnDemand::GetDebugInfoIndexTime() {
   return m_sym_file_impl->GetDebugInfoIndexTime();
 }
 
+StatsDuration::Duration SymbolFileOnDemand::GetDebugInfoTypeCompletionTime() {
+  // Always return the real type completion time.
+  LLDB_LOG(GetLog(), "[{0}] {1} is not skipped", GetSymbolFileName(),
+           __FUNCTION__);
+  return m_sym_file_impl->GetDebugInfoTypeCompletionTime();
+}
+
+uint64_t SymbolFileOnDemand::GetDebugInfoTypesCompletedCount() {
+  LLDB_LOG(GetLog(), "[{0}] {1} is not skipped", GetSymbolFileName(),
+           __FUNCTION__);
+  return m_sym_file_impl->GetDebugInfoTypesCompletedCount();
+}
+
 void SymbolFileOnDemand::SetLoadDebugInfoEnabled() {
   if (m_debug_info_enabled)
     return;
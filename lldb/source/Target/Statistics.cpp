@@ -59,6 +59,10 @@ json::Value ModuleStats::ToJSON() const {
   module.try_emplace("symbolTableSavedToCache", symtab_saved_to_cache);
   module.try_emplace("debugInfoParseTime", debug_parse_time);
   module.try_emplace("debugInfoIndexTime", debug_index_time);
+  module.try_emplace("debugInfoTypeCompletionTime",
+                     debug_type_completion_time);
+  module.try_emplace("debugInfoTypesCompleted",
+                     (int64_t)debug_types_completed);
   module.try_emplace("debugInfoByteSize", (int64_t)debug_info_size);
   module.try_emplace("debugInfoIndexLoadedFromCache",
                      debug_info_index_loaded_from_cache);
@@ -232,6 +236,8 @@ llvm::json::Value DebuggerStats::ReportStatistics(
   double symtab_index_time = 0.0;
   double debug_parse_time = 0.0;
   double debug_index_time = 0.0;
+  double debug_type_completion_time = 0.0;
+  uint64_t debug_types_completed = 0;
   uint32_t symtabs_loaded = 0;
   uint32_t symtabs_saved = 0;
   uint32_t debug_index_loaded = 0;
@@ -281,6 +287,10 @@ llvm::json::Value DebuggerStats::ReportStatistics(
         ++debug_index_saved;
       module_stat.debug_index_time = sym_file->GetDebugInfoIndexTime().count();
       module_stat.debug_parse_time = sym_file->GetDebugInfoParseTime().count();
+      module_stat.debug_type_completion_time =
+          sym_file->GetDebugInfoTypeCompletionTime().count();
+      module_stat.debug_types_completed =
+          sym_file->GetDebugInfoTypesCompletedCount();
       module_stat.debug_info_size =
           sym_file->GetDebugInfoSize(load_all_debug_info);
       module_stat.symtab_stripped = module->GetObjectFile()->IsStripped();
@@ -301,6 +311,8 @@ llvm::json::Value DebuggerStats::ReportStatistics(
     symtab_index_time += module_stat.symtab_index_time;
     debug_parse_time += module_stat.debug_parse_time;
     debug_index_time += module_stat.debug_index_time;
+    debug_type_completion_time += module_stat.debug_type_completion_time;
+    debug_types_completed += module_stat.debug_types_completed;
     debug_info_size += module_stat.debug_info_size;
     module->ForEachTypeSystem([&](lldb::TypeSystemSP ts) {
       if (auto stats = ts->ReportStatistics())
@@ -333,6 +345,8 @@ llvm::json::Value DebuggerStats::ReportStatistics(
       {"totalSymbolTablesSavedToCache", symtabs_saved},
       {"totalDebugInfoParseTime", debug_parse_time},
       {"totalDebugInfoIndexTime", debug_index_time},
+      {"totalDebugInfoTypeCompletionTime", debug_type_completion_time},
+      {"totalDebugInfoTypesCompleted", debug_types_completed},
       {"totalDebugInfoIndexLoadedFromCache", debug_index_loaded},
       {"totalDebugInfoIndexSavedToCache", debug_index_saved},
       {"totalDebugInfoByteSize", debug_info_size},
@@ -284,6 +284,7 @@ void Target::Destroy() {
   m_arch = ArchSpec();
   ClearModules(true);
   m_section_load_history.Clear();
+  ClearUserExpressionCache();
   const bool notify = false;
   m_breakpoint_list.RemoveAll(notify);
   m_internal_breakpoint_list.RemoveAll(notify);
@@ -1694,6 +1695,8 @@ void Target::ModulesDidLoad(ModuleList &module_list) {
       ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
       LoadScriptingResourceForModule(module_sp, this);
     }
+    // Previously parsed expressions may now resolve names differently.
+    ClearUserExpressionCache();
     m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
     m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
     if (m_process_sp) {
@@ -1724,6 +1727,7 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
   if (m_valid && module_list.GetSize()) {
     UnloadModuleSections(module_list);
+    ClearUserExpressionCache();
     auto data_sp =
         std::make_shared<TargetEventData>(shared_from_this(), module_list);
     BroadcastEvent(eBroadcastBitModulesUnloaded, data_sp);
@@ -2536,6 +2540,37 @@ UserExpression *Target::GetUserExpressionForLanguage(
   return user_expr;
 }
 
+// Bound the number of parsed expressions kept alive, each of which holds on to
+// its JIT-compiled code in the inferior.
+static constexpr size_t g_max_cached_user_expressions = 64;
+
+lldb::UserExpressionSP
+Target::TakeCachedUserExpression(llvm::StringRef key,
+                                 ExecutionContext &exe_ctx) {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  auto pos = m_user_expression_cache.find(key);
+  if (pos == m_user_expression_cache.end())
+    return {};
+  lldb::UserExpressionSP expr_sp = std::move(pos->second);
+  m_user_expression_cache.erase(pos);
+  if (!expr_sp->MatchesContext(exe_ctx))
+    return {};
+  return expr_sp;
+}
+
+void Target::CacheUserExpression(llvm::StringRef key,
+                                 lldb::UserExpressionSP expr_sp) {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  if (m_user_expression_cache.size() >= g_max_cached_user_expressions)
+    m_user_expression_cache.clear();
+  m_user_expression_cache[key] = std::move(expr_sp);
+}
+
+void Target::ClearUserExpressionCache() {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  m_user_expression_cache.clear();
+}
+
 FunctionCaller *Target::GetFunctionCallerForLanguage(
     lldb::LanguageType language, const CompilerType &return_type,
     const Address &function_address, const ValueList &arg_value_list,
@@ -4289,6 +4324,18 @@ void TargetProperties::SetPreloadSymbols(bool b) {
   SetPropertyAtIndex(idx, b);
 }
 
+bool TargetProperties::GetParallelModuleLoad() const {
+  const uint32_t idx = ePropertyParallelModuleLoad;
+  return GetPropertyAtIndexAs<bool>(
+      idx, g_target_properties[idx].default_uint_value != 0);
+}
+
+bool TargetProperties::GetCacheExpressions() const {
+  const uint32_t idx = ePropertyCacheExpressions;
+  return GetPropertyAtIndexAs<bool>(
+      idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 bool TargetProperties::GetDisableASLR() const {
   const uint32_t idx = ePropertyDisableASLR;
   return GetPropertyAtIndexAs<bool>(
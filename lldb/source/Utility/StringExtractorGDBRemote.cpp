@@ -184,6 +184,11 @@ StringExtractorGDBRemote::GetServerPacketType() const {
         return eServerPacketType_qfThreadInfo;
       break;
 
+    case 'B':
+      if (PACKET_STARTS_WITH("qBreakpointConditionStats:"))
+        return eServerPacketType_qBreakpointConditionStats;
+      break;
+
     case 'C':
       if (packet_size == 2)
         return eServerPacketType_qC;
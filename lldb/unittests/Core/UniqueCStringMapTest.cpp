@@ -66,3 +66,35 @@ TEST(UniqueCStringMap, ValueCompare) {
   EXPECT_THAT(Map.GetValues(Foo, Values), 3);
   EXPECT_THAT(Values, testing::ElementsAre(-5, 0, 5));
 }
+
+TEST(UniqueCStringMap, MergeSortedRuns) {
+  UniqueCStringMap<int> Map, Expected;
+  ConstString Foo("foo"), Bar("bar"), Baz("baz");
+
+  // Three runs, each sorted on its own.
+  std::vector<std::vector<std::pair<ConstString, int>>> Runs = {
+      {{Foo, 3}, {Bar, 1}, {Baz, 2}},
+      {{Foo, 1}, {Bar, 7}},
+      {{Baz, 0}, {Foo, 2}, {Foo, 4}, {Bar, 0}}};
+  std::vector<size_t> RunEnds;
+  for (auto &Run : Runs) {
+    UniqueCStringMap<int> RunMap;
+    for (auto &[Name, Value] : Run) {
+      RunMap.Append(Name, Value);
+      Expected.Append(Name, Value);
+    }
+    RunMap.Sort(std::less<int>());
+    for (const auto &Entry : RunMap)
+      Map.Append(Entry);
+    RunEnds.push_back(Map.GetSize());
+  }
+
+  Map.MergeSortedRuns(RunEnds, std::less<int>());
+  Expected.Sort(std::less<int>());
+  ASSERT_EQ(Map.GetSize(), Expected.GetSize());
+  for (size_t I = 0; I < Map.GetSize(); ++I) {
+    EXPECT_EQ(Map.GetCStringAtIndex(I), Expected.GetCStringAtIndex(I));
+    EXPECT_EQ(Map.GetValueAtIndexUnchecked(I),
+              Expected.GetValueAtIndexUnchecked(I));
+  }
+}
@@ -9,6 +9,7 @@
 #include "TestingSupport/Host/NativeProcessTestUtils.h"
 
 #include "lldb/Host/common/NativeProcessProtocol.h"
+#include "llvm/BinaryFormat/Dwarf.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gmock/gmock.h"
@@ -146,4 +147,72 @@ TEST(NativeProcessProtocolTest, ReadCStringFromMemory_CrossPageBoundary) {
                                                      bytes_read),
                        llvm::HasValue(llvm::StringRef("hello")));
   EXPECT_EQ(bytes_read, 6UL);
-}
\ No newline at end of file
+}
+TEST(NativeProcessProtocolTest, EvaluateBreakpointCondition) {
+  NiceMock<MockDelegate> DummyDelegate;
+  MockProcess<NativeProcessProtocol> Process(DummyDelegate,
+                                             ArchSpec("x86_64-pc-linux"));
+  FakeMemory M{{0x78, 0x56, 0x34, 0x12, 0xf0, 0xde, 0xbc, 0x9a}, 0x1000};
+  EXPECT_CALL(Process, ReadMemory(_, _))
+      .WillRepeatedly(Invoke(&M, &FakeMemory::Read));
+  const auto &Evaluate = [&](std::vector<uint8_t> Condition) {
+    return Process.EvaluateBreakpointCondition(Condition, nullptr);
+  };
+  using namespace llvm::dwarf;
+
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_lit3, DW_OP_lit4, DW_OP_plus}),
+                       llvm::HasValue(7));
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_constu, 0x80, 0x01, DW_OP_lit1,
+                                 DW_OP_shr}),
+                       llvm::HasValue(64));
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_lit1, DW_OP_lit2, DW_OP_swap,
+                                 DW_OP_minus}),
+                       llvm::HasValue(1));
+  // Comparisons are signed.
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_consts, 0x7f, DW_OP_lit0, DW_OP_lt}),
+                       llvm::HasValue(1));
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_lit5, DW_OP_lit5, DW_OP_ne}),
+                       llvm::HasValue(0));
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_constu, 0x80, 0x20, DW_OP_deref_size,
+                                 4}),
+                       llvm::HasValue(0x12345678));
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_constu, 0x80, 0x20, DW_OP_deref}),
+                       llvm::HasValue(0x9abcdef012345678));
+
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_lit1, DW_OP_plus}), llvm::Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_constu}), llvm::Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_lit0, DW_OP_deref}), llvm::Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_breg0, 0}), llvm::Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({DW_OP_call_frame_cfa}), llvm::Failed());
+}
+
+TEST(NativeProcessProtocolTest, SetBreakpointConditions) {
+  NiceMock<MockDelegate> DummyDelegate;
+  MockProcess<NativeProcessProtocol> Process(DummyDelegate,
+                                             ArchSpec("x86_64-pc-linux"));
+  FakeMemory M{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+  EXPECT_CALL(Process, ReadMemory(_, _))
+      .WillRepeatedly(Invoke(&M, &FakeMemory::Read));
+  EXPECT_CALL(Process, WriteMemory(_, _))
+      .WillRepeatedly(Invoke(&M, &FakeMemory::Write));
+
+  EXPECT_THAT_ERROR(
+      Process.SetBreakpointConditions(0x4, {{llvm::dwarf::DW_OP_lit1}})
+          .ToError(),
+      llvm::Failed());
+  EXPECT_THAT_ERROR(Process.SetBreakpoint(0x4, 0, false).ToError(),
+                    llvm::Succeeded());
+  EXPECT_EQ(std::nullopt, Process.GetBreakpointConditionStats(0x4));
+  EXPECT_THAT_ERROR(
+      Process.SetBreakpointConditions(0x4, {{llvm::dwarf::DW_OP_lit1}})
+          .ToError(),
+      llvm::Succeeded());
+  std::optional<NativeProcessProtocol::BreakpointConditionStats> Stats =
+      Process.GetBreakpointConditionStats(0x4);
+  ASSERT_TRUE(Stats);
+  EXPECT_EQ(0u, Stats->evaluations);
+  EXPECT_EQ(0u, Stats->hits);
+  EXPECT_THAT_ERROR(Process.SetBreakpointConditions(0x4, {}).ToError(),
+                    llvm::Succeeded());
+  EXPECT_EQ(std::nullopt, Process.GetBreakpointConditionStats(0x4));
+}
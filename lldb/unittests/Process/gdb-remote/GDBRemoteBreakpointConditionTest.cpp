@@ -0,0 +1,113 @@
+//===-- GDBRemoteBreakpointConditionTest.cpp ------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/Process/gdb-remote/GDBRemoteBreakpointCondition.h"
+#include "lldb/lldb-private-types.h"
+#include "llvm/BinaryFormat/Dwarf.h"
+#include "gtest/gtest.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::process_gdb_remote;
+using namespace llvm::dwarf;
+
+namespace {
+RegisterInfo MakeRegister(const char *name, uint32_t byte_size,
+                          Encoding encoding, uint32_t regnum) {
+  return RegisterInfo{name,
+                      nullptr,
+                      byte_size,
+                      0,
+                      encoding,
+                      eFormatHex,
+                      {LLDB_INVALID_REGNUM, LLDB_INVALID_REGNUM,
+                       LLDB_INVALID_REGNUM, regnum, regnum},
+                      nullptr,
+                      nullptr,
+                      nullptr};
+}
+
+const RegisterInfo g_registers[] = {
+    MakeRegister("rax", 8, eEncodingUint, 0),
+    MakeRegister("ecx", 4, eEncodingSint, 2),
+    MakeRegister("eax", 4, eEncodingUint, 40),
+    MakeRegister("xmm0", 16, eEncodingVector, 17),
+};
+
+std::optional<std::vector<uint8_t>> Compile(llvm::StringRef condition) {
+  return CompileBreakpointCondition(condition, [](llvm::StringRef name) {
+    for (const RegisterInfo &reg : g_registers)
+      if (name == reg.name)
+        return &reg;
+    return static_cast<const RegisterInfo *>(nullptr);
+  });
+}
+
+using Bytes = std::vector<uint8_t>;
+} // namespace
+
+TEST(GDBRemoteBreakpointConditionTest, Comparisons) {
+  EXPECT_EQ(Bytes({DW_OP_bregx, 40, 0, DW_OP_lit3, DW_OP_eq}),
+            Compile("$eax == 3"));
+  EXPECT_EQ(Bytes({DW_OP_bregx, 40, 0, DW_OP_constu, 0x80, 0x20, DW_OP_ge}),
+            Compile("  $eax>=0x1000 "));
+  // Literals on the left are moved to the right.
+  EXPECT_EQ(Bytes({DW_OP_bregx, 40, 0, DW_OP_lit3, DW_OP_lt}),
+            Compile("3 > $eax"));
+  // A register on its own is compared with zero.
+  EXPECT_EQ(Bytes({DW_OP_bregx, 40, 0, DW_OP_lit0, DW_OP_ne}),
+            Compile("$eax"));
+}
+
+TEST(GDBRemoteBreakpointConditionTest, Signedness) {
+  // Signed registers are sign-extended.
+  EXPECT_EQ(Bytes({DW_OP_breg2, 0, DW_OP_constu, 32, DW_OP_shl, DW_OP_constu,
+                   32, DW_OP_shra, DW_OP_consts, 0x7f, DW_OP_lt}),
+            Compile("$ecx < -1"));
+  EXPECT_TRUE(Compile("$ecx == -2147483648"));
+  EXPECT_FALSE(Compile("$ecx == 2147483648"));
+  EXPECT_FALSE(Compile("$eax == -1"));
+  EXPECT_FALSE(Compile("$eax == 0x100000000"));
+  // Unsigned 64-bit registers are moved into the signed range.
+  EXPECT_EQ(Bytes({DW_OP_breg0, 0, DW_OP_constu, 0x80, 0x80, 0x80, 0x80, 0x80,
+                   0x80, 0x80, 0x80, 0x80, 0x01, DW_OP_xor, DW_OP_consts, 0x80,
+                   0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7f,
+                   DW_OP_gt}),
+            Compile("$rax > 0"));
+  EXPECT_TRUE(Compile("$rax == 0xffffffffffffffff"));
+}
+
+TEST(GDBRemoteBreakpointConditionTest, Logic) {
+  EXPECT_EQ(Bytes({DW_OP_bregx, 40, 0, DW_OP_lit1, DW_OP_eq, DW_OP_bregx, 40,
+                   0, DW_OP_lit2, DW_OP_eq, DW_OP_or}),
+            Compile("$eax == 1 || $eax == 2"));
+  EXPECT_EQ(Bytes({DW_OP_bregx, 40, 0, DW_OP_lit0, DW_OP_ne, DW_OP_lit0,
+                   DW_OP_eq}),
+            Compile("!$eax"));
+  EXPECT_EQ(Bytes({DW_OP_breg2, 0, DW_OP_constu, 32, DW_OP_shl, DW_OP_constu,
+                   32, DW_OP_shra, DW_OP_lit0, DW_OP_ne, DW_OP_bregx, 40, 0,
+                   DW_OP_lit1, DW_OP_eq, DW_OP_bregx, 40, 0, DW_OP_lit2,
+                   DW_OP_eq, DW_OP_or, DW_OP_and}),
+            Compile("$ecx && ($eax == 1 || $eax == 2)"));
+}
+
+TEST(GDBRemoteBreakpointConditionTest, Unsupported) {
+  EXPECT_FALSE(Compile(""));
+  EXPECT_FALSE(Compile("1"));
+  EXPECT_FALSE(Compile("foo == 1"));
+  EXPECT_FALSE(Compile("$nope == 1"));
+  EXPECT_FALSE(Compile("$xmm0 == 0"));
+  EXPECT_FALSE(Compile("$eax == $ecx"));
+  EXPECT_FALSE(Compile("$eax + 1 == 2"));
+  EXPECT_FALSE(Compile("$eax = 1"));
+  EXPECT_FALSE(Compile("$eax << 1"));
+  EXPECT_FALSE(Compile("$eax == 1u"));
+  EXPECT_FALSE(Compile("$eax =="));
+  EXPECT_FALSE(Compile("($eax == 1"));
+  EXPECT_FALSE(Compile("$eax == 1 == 1"));
+}
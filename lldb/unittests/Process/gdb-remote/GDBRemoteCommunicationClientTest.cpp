@@ -615,3 +615,37 @@ TEST_F(GDBRemoteCommunicationClientTest, CalculateMD5) {
   EXPECT_EQ(expected_low, low);
   EXPECT_EQ(expected_high, high);
 }
+
+TEST_F(GDBRemoteCommunicationClientTest, BreakpointConditions) {
+  std::future<uint8_t> async_result = std::async(std::launch::async, [&] {
+    if (!client.GetBreakpointConditionsSupported())
+      return uint8_t(UINT8_MAX);
+    std::vector<uint8_t> conditions[] = {{0x30, 0x31, 0x29}, {0x50, 0x00}};
+    return client.SendGDBStoppointTypePacket(eBreakpointSoftware, true, 0x1000,
+                                             1, std::chrono::seconds(10),
+                                             conditions);
+  });
+  HandlePacket(server, testing::StartsWith("qSupported:"),
+               "PacketSize=1000;dwarf-breakpoint-conditions+");
+  HandlePacket(server, "Z0,1000,1;X3,303129;X2,5000", "OK");
+  EXPECT_EQ(0, async_result.get());
+
+  const auto &GetStats = [&](llvm::StringRef response) {
+    std::future<std::optional<std::pair<uint64_t, uint64_t>>> result =
+        std::async(std::launch::async,
+                   [&]() -> std::optional<std::pair<uint64_t, uint64_t>> {
+                     uint64_t evaluations, hits;
+                     if (!client.GetBreakpointConditionStats(
+                             0x1000, evaluations, hits))
+                       return std::nullopt;
+                     return std::make_pair(evaluations, hits);
+                   });
+    HandlePacket(server, "qBreakpointConditionStats:1000", response);
+    return result.get();
+  };
+  EXPECT_EQ(std::make_pair(uint64_t(0x1234), uint64_t(0x12)),
+            GetStats("evaluations:1234;hits:12;"));
+  EXPECT_EQ(std::nullopt, GetStats("E23"));
+  EXPECT_EQ(std::nullopt, GetStats("evaluations:1234;"));
+  EXPECT_EQ(std::nullopt, GetStats("evaluations:bogus;hits:12;"));
+}
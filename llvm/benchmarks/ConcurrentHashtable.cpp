@@ -0,0 +1,143 @@
+//===- ConcurrentHashtable.cpp - Contention of concurrent hash tables -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/ConcurrentHashtable.h"
+#include "llvm/ADT/StringMap.h"
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+constexpr unsigned MaxThreads = 64;
+constexpr size_t KeysPerThread = 1 << 14;
+
+// The benchmark library creates its own threads, which PerThreadBumpPtrAllocator
+// does not know about, so give each benchmark thread its own allocator.
+thread_local unsigned BenchThreadIdx = 0;
+
+class BenchAllocator : public AllocatorBase<BenchAllocator> {
+public:
+  void *Allocate(size_t Size, size_t Alignment) {
+    return Allocators[BenchThreadIdx].Allocate(Size, Alignment);
+  }
+  void Deallocate(const void *, size_t, size_t) {}
+  using AllocatorBase<BenchAllocator>::Allocate;
+  using AllocatorBase<BenchAllocator>::Deallocate;
+
+private:
+  BumpPtrAllocator Allocators[MaxThreads];
+};
+
+using ConcurrentMap = ConcurrentStringMap<unsigned, BenchAllocator>;
+
+// Baseline: a StringMap behind a single lock.
+class LockedStringMap {
+public:
+  LockedStringMap(uint64_t) {}
+  std::pair<StringMapEntry<unsigned> *, bool> insert(StringRef Key) {
+    std::lock_guard<std::mutex> Lock(Guard);
+    auto [It, Inserted] = Map.try_emplace(Key, 0);
+    return {&*It, Inserted};
+  }
+  StringMapEntry<unsigned> *find(StringRef Key) {
+    std::lock_guard<std::mutex> Lock(Guard);
+    auto It = Map.find(Key);
+    return It == Map.end() ? nullptr : &*It;
+  }
+  bool erase(StringRef Key) {
+    std::lock_guard<std::mutex> Lock(Guard);
+    return Map.erase(Key);
+  }
+
+private:
+  std::mutex Guard;
+  StringMap<unsigned> Map;
+};
+
+const std::vector<std::string> &keys() {
+  static std::vector<std::string> Keys = [] {
+    std::vector<std::string> Result;
+    for (size_t I = 0; I != MaxThreads * KeysPerThread; ++I)
+      Result.push_back("symbol_" + std::to_string(I * 2654435761u));
+    return Result;
+  }();
+  return Keys;
+}
+
+template <typename MapT> MapT *SharedMap = nullptr;
+
+template <typename MapT> void setUp(benchmark::State &State) {
+  BenchThreadIdx = State.thread_index();
+  keys();
+  if (State.thread_index() == 0)
+    SharedMap<MapT> = new MapT(KeysPerThread * State.threads());
+}
+
+template <typename MapT> void tearDown(benchmark::State &State) {
+  if (State.thread_index() == 0) {
+    delete SharedMap<MapT>;
+    SharedMap<MapT> = nullptr;
+  }
+  State.SetItemsProcessed(State.iterations() * KeysPerThread);
+}
+} // namespace
+
+// Every thread inserts its own keys: measures the cost of insertion and
+// resizing with no duplicates.
+template <typename MapT>
+static void BM_InsertUnique(benchmark::State &State) {
+  setUp<MapT>(State);
+  const std::vector<std::string> &Keys = keys();
+  size_t Begin = State.thread_index() * KeysPerThread;
+  for (auto _ : State)
+    for (size_t I = Begin; I != Begin + KeysPerThread; ++I)
+      benchmark::DoNotOptimize(SharedMap<MapT>->insert(Keys[I]));
+  tearDown<MapT>(State);
+}
+
+// All threads insert the same keys, as when uniquing strings or symbols
+// coming from many input files.
+template <typename MapT>
+static void BM_InsertShared(benchmark::State &State) {
+  setUp<MapT>(State);
+  const std::vector<std::string> &Keys = keys();
+  for (auto _ : State)
+    for (size_t I = 0; I != KeysPerThread; ++I)
+      benchmark::DoNotOptimize(SharedMap<MapT>->insert(Keys[I]));
+  tearDown<MapT>(State);
+}
+
+// Mostly lookups of shared keys, with each thread churning through its own
+// keys on the side.
+template <typename MapT>
+static void BM_FindMostly(benchmark::State &State) {
+  setUp<MapT>(State);
+  const std::vector<std::string> &Keys = keys();
+  size_t Begin = State.thread_index() * KeysPerThread;
+  for (auto _ : State)
+    for (size_t I = 0; I != KeysPerThread; ++I) {
+      if (I % 8 == 0) {
+        SharedMap<MapT>->insert(Keys[Begin + I]);
+        SharedMap<MapT>->erase(Keys[Begin + I]);
+      }
+      benchmark::DoNotOptimize(SharedMap<MapT>->find(Keys[I]));
+    }
+  tearDown<MapT>(State);
+}
+
+BENCHMARK(BM_InsertUnique<ConcurrentMap>)->ThreadRange(1, MaxThreads);
+BENCHMARK(BM_InsertUnique<LockedStringMap>)->ThreadRange(1, MaxThreads);
+BENCHMARK(BM_InsertShared<ConcurrentMap>)->ThreadRange(1, MaxThreads);
+BENCHMARK(BM_InsertShared<LockedStringMap>)->ThreadRange(1, MaxThreads);
+BENCHMARK(BM_FindMostly<ConcurrentMap>)->ThreadRange(1, MaxThreads);
+BENCHMARK(BM_FindMostly<LockedStringMap>)->ThreadRange(1, MaxThreads);
+
+BENCHMARK_MAIN();
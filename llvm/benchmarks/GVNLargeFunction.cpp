@@ -0,0 +1,106 @@
+//===- GVNLargeFunction.cpp - GVN on one function with a large CFG --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures GVN on a function whose loads have many non-local dependences, for
+// several values of -gvn-max-nonlocal-deps-per-function (0 stands for no
+// limit). The function is generated with the number of diamonds given by
+// LLVM_GVN_DIAMONDS, 2000 by default.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Analysis/CGSCCPassManager.h"
+#include "llvm/Analysis/LoopAnalysisManager.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Transforms/Scalar/GVN.h"
+#include <cstdlib>
+
+using namespace llvm;
+
+// Build a chain of diamonds in which one arm stores to one of a few slots and
+// every join block loads all of them, so that each load depends on the stores
+// in many preceding blocks.
+static std::unique_ptr<Module> generateModule(LLVMContext &Ctx,
+                                              unsigned Diamonds) {
+  auto M = std::make_unique<Module>("generated", Ctx);
+  IRBuilder<> B(Ctx);
+  Type *I32 = B.getInt32Ty();
+  FunctionType *FTy =
+      FunctionType::get(I32, {B.getPtrTy(), B.getPtrTy()}, false);
+  Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage, "f", *M);
+  Value *Slots = F->getArg(0);
+  Value *Conds = F->getArg(1);
+  constexpr unsigned NumSlots = 8;
+
+  BasicBlock *BB = BasicBlock::Create(Ctx, "entry", F);
+  B.SetInsertPoint(BB);
+  Value *Sum = B.getInt32(0);
+  for (unsigned I = 0; I < Diamonds; ++I) {
+    BasicBlock *Then = BasicBlock::Create(Ctx, "then", F);
+    BasicBlock *Else = BasicBlock::Create(Ctx, "else", F);
+    BasicBlock *Join = BasicBlock::Create(Ctx, "join", F);
+    Value *C = B.CreateLoad(I32, B.CreateConstGEP1_32(I32, Conds, I));
+    B.CreateCondBr(B.CreateICmpEQ(C, B.getInt32(0)), Then, Else);
+    B.SetInsertPoint(Then);
+    B.CreateStore(Sum, B.CreateConstGEP1_32(I32, Slots, I % NumSlots));
+    B.CreateBr(Join);
+    B.SetInsertPoint(Else);
+    B.CreateBr(Join);
+    B.SetInsertPoint(Join);
+    for (unsigned J = 0; J < NumSlots; ++J)
+      Sum = B.CreateAdd(Sum,
+                        B.CreateLoad(I32, B.CreateConstGEP1_32(I32, Slots, J)));
+  }
+  B.CreateRet(Sum);
+  return M;
+}
+
+static void BM_GVN(benchmark::State &State) {
+  auto &Budget = static_cast<cl::opt<uint64_t> &>(
+      *cl::getRegisteredOptions()["gvn-max-nonlocal-deps-per-function"]);
+  uint64_t Default = Budget;
+  Budget = State.range(0) ? State.range(0) : UINT64_MAX;
+  unsigned Diamonds = 2000;
+  if (std::optional<std::string> N = sys::Process::GetEnv("LLVM_GVN_DIAMONDS"))
+    Diamonds = std::atoi(N->c_str());
+
+  for (auto _ : State) {
+    State.PauseTiming();
+    LLVMContext Ctx;
+    std::unique_ptr<Module> M = generateModule(Ctx, Diamonds);
+    LoopAnalysisManager LAM;
+    FunctionAnalysisManager FAM;
+    CGSCCAnalysisManager CGAM;
+    ModuleAnalysisManager MAM;
+    PassBuilder PB;
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+    FunctionPassManager FPM;
+    FPM.addPass(GVNPass());
+    State.ResumeTiming();
+    FPM.run(*M->getFunction("f"), FAM);
+  }
+  Budget = Default;
+}
+BENCHMARK(BM_GVN)
+    ->ArgName("budget")
+    ->Arg(0)
+    ->Arg(100000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
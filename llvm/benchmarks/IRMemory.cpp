@@ -0,0 +1,163 @@
+//===- IRMemory.cpp - Memory used by loaded IR ----------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures the time to load modules and the heap memory they keep alive,
+// reported per instruction. The modules come from the files listed in the
+// LLVM_IR_MEMORY_INPUTS environment variable, separated like PATH entries, or
+// from a generated module otherwise:
+//
+//   LLVM_IR_MEMORY_INPUTS=a.bc:b.bc ./IRMemory
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace llvm;
+
+// Live heap bytes allocated through operator new. Each allocation is prefixed
+// with its size so that unsized deallocations can be accounted for.
+static std::atomic<size_t> LiveBytes;
+static constexpr size_t HeaderSize = alignof(std::max_align_t);
+
+void *operator new(size_t Size) {
+  void *P = std::malloc(Size + HeaderSize);
+  if (!P)
+    throw std::bad_alloc();
+  *static_cast<size_t *>(P) = Size;
+  LiveBytes += Size;
+  return static_cast<char *>(P) + HeaderSize;
+}
+
+void operator delete(void *P) noexcept {
+  if (!P)
+    return;
+  void *Base = static_cast<char *>(P) - HeaderSize;
+  LiveBytes -= *static_cast<size_t *>(Base);
+  std::free(Base);
+}
+
+void *operator new[](size_t Size) { return operator new(Size); }
+void operator delete[](void *P) noexcept { operator delete(P); }
+void operator delete(void *P, size_t) noexcept { operator delete(P); }
+void operator delete[](void *P, size_t) noexcept { operator delete(P); }
+
+// Build a module with many small functions containing loops, calls and
+// memory operations, and return it as bitcode.
+static SmallVector<char, 0> generateBitcode() {
+  LLVMContext Ctx;
+  Module M("generated", Ctx);
+  IRBuilder<> B(Ctx);
+  Type *I64 = B.getInt64Ty();
+  FunctionType *FTy = FunctionType::get(I64, {I64, B.getPtrTy()}, false);
+  Function *Prev = nullptr;
+  for (unsigned I = 0; I < 2000; ++I) {
+    Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage,
+                                   "f" + Twine(I), M);
+    BasicBlock *Entry = BasicBlock::Create(Ctx, "entry", F);
+    BasicBlock *Loop = BasicBlock::Create(Ctx, "loop", F);
+    BasicBlock *Exit = BasicBlock::Create(Ctx, "exit", F);
+    B.SetInsertPoint(Entry);
+    B.CreateBr(Loop);
+    B.SetInsertPoint(Loop);
+    PHINode *IV = B.CreatePHI(I64, 2);
+    PHINode *Acc = B.CreatePHI(I64, 2);
+    Value *Ptr = B.CreateGEP(I64, F->getArg(1), IV);
+    Value *V = B.CreateLoad(I64, Ptr);
+    for (unsigned J = 0; J < 8; ++J)
+      V = B.CreateXor(B.CreateMul(V, Acc), B.CreateAdd(V, IV));
+    if (Prev)
+      V = B.CreateCall(Prev, {V, Ptr});
+    B.CreateStore(V, Ptr);
+    Value *Next = B.CreateAdd(IV, B.getInt64(1));
+    Value *NewAcc = B.CreateAdd(Acc, V);
+    B.CreateCondBr(B.CreateICmpULT(Next, F->getArg(0)), Loop, Exit);
+    IV->addIncoming(B.getInt64(0), Entry);
+    IV->addIncoming(Next, Loop);
+    Acc->addIncoming(B.getInt64(0), Entry);
+    Acc->addIncoming(NewAcc, Loop);
+    B.SetInsertPoint(Exit);
+    B.CreateRet(NewAcc);
+    Prev = F;
+  }
+  SmallVector<char, 0> Buffer;
+  raw_svector_ostream OS(Buffer);
+  WriteBitcodeToFile(M, OS);
+  return Buffer;
+}
+
+static std::vector<std::unique_ptr<MemoryBuffer>> &getInputs() {
+  static std::vector<std::unique_ptr<MemoryBuffer>> Inputs = [] {
+    std::vector<std::unique_ptr<MemoryBuffer>> Inputs;
+    if (std::optional<std::string> Paths =
+            sys::Process::GetEnv("LLVM_IR_MEMORY_INPUTS")) {
+      SmallVector<StringRef, 0> List;
+      StringRef(*Paths).split(List, sys::EnvPathSeparator, -1, false);
+      for (StringRef Path : List) {
+        auto BufferOrErr = MemoryBuffer::getFile(Path);
+        if (!BufferOrErr) {
+          errs() << "cannot read " << Path << ": "
+                 << BufferOrErr.getError().message() << "\n";
+          std::exit(1);
+        }
+        Inputs.push_back(std::move(*BufferOrErr));
+      }
+    } else {
+      SmallVector<char, 0> Bitcode = generateBitcode();
+      Inputs.push_back(MemoryBuffer::getMemBufferCopy(
+          StringRef(Bitcode.data(), Bitcode.size()), "generated"));
+    }
+    return Inputs;
+  }();
+  return Inputs;
+}
+
+static void BM_LoadModules(benchmark::State &State) {
+  size_t Bytes = 0, Instructions = 0, Uses = 0;
+  for (auto _ : State) {
+    size_t Before = LiveBytes;
+    LLVMContext Ctx;
+    std::vector<std::unique_ptr<Module>> Modules;
+    for (const std::unique_ptr<MemoryBuffer> &Input : getInputs()) {
+      SMDiagnostic Err;
+      Modules.push_back(parseIR(Input->getMemBufferRef(), Err, Ctx));
+      if (!Modules.back()) {
+        Err.print("IRMemory", errs());
+        std::exit(1);
+      }
+    }
+    Bytes = LiveBytes - Before;
+    Instructions = Uses = 0;
+    for (const std::unique_ptr<Module> &M : Modules)
+      for (const Function &F : *M)
+        for (const BasicBlock &BB : F)
+          for (const Instruction &I : BB) {
+            ++Instructions;
+            Uses += I.getNumOperands();
+          }
+  }
+  size_t N = std::max<size_t>(Instructions, 1);
+  State.counters["insts"] = Instructions;
+  State.counters["bytes/inst"] = double(Bytes) / N;
+  State.counters["uses/inst"] = double(Uses) / N;
+  State.counters["use bytes/inst"] = double(Uses * sizeof(Use)) / N;
+}
+BENCHMARK(BM_LoadModules)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
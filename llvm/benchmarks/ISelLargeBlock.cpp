@@ -0,0 +1,106 @@
+//===- ISelLargeBlock.cpp - Code generation of one very large block -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures code generation for the host target of a function made of a
+// single large block, like the state machines produced by code generators,
+// for several values of -dag-isel-max-block-size (0 stands for no limit). The
+// block has LLVM_ISEL_BLOCK_SIZE instructions, 50000 by default.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/TargetParser/Host.h"
+#include <cstdlib>
+
+using namespace llvm;
+
+// Build a block that repeatedly loads a few state words, mixes them and
+// stores them back, so that values stay live across large parts of the block.
+static std::unique_ptr<Module> generateModule(LLVMContext &Ctx,
+                                              unsigned Size) {
+  auto M = std::make_unique<Module>("generated", Ctx);
+  IRBuilder<> B(Ctx);
+  Type *I64 = B.getInt64Ty();
+  FunctionType *FTy = FunctionType::get(I64, {B.getPtrTy()}, false);
+  Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage, "f", *M);
+  Value *State = F->getArg(0);
+  constexpr unsigned NumWords = 16;
+
+  B.SetInsertPoint(BasicBlock::Create(Ctx, "entry", F));
+  B.CreateBr(BasicBlock::Create(Ctx, "body", F));
+  B.SetInsertPoint(&F->back());
+  Value *Acc = B.getInt64(0);
+  // Every step emits seven instructions.
+  for (unsigned I = 0; I * 7 < Size; ++I) {
+    Value *Ptr = B.CreateConstGEP1_32(I64, State, I % NumWords);
+    Value *V = B.CreateLoad(I64, Ptr);
+    V = B.CreateXor(B.CreateMul(V, B.getInt64(I * 2 + 1)), Acc);
+    Acc = B.CreateAdd(Acc, B.CreateLShr(V, B.getInt64(I % 63 + 1)));
+    B.CreateStore(V, Ptr);
+  }
+  B.CreateRet(Acc);
+  return M;
+}
+
+static void BM_CodeGen(benchmark::State &State) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  std::string Triple = sys::getProcessTriple();
+  std::string Err;
+  const Target *T = TargetRegistry::lookupTarget(Triple, Err);
+  if (!T) {
+    State.SkipWithError(Err.c_str());
+    return;
+  }
+
+  auto &Limit = static_cast<cl::opt<unsigned> &>(
+      *cl::getRegisteredOptions()["dag-isel-max-block-size"]);
+  unsigned Default = Limit;
+  Limit = State.range(0);
+  unsigned Size = 50000;
+  if (std::optional<std::string> N = sys::Process::GetEnv("LLVM_ISEL_BLOCK_SIZE"))
+    Size = std::atoi(N->c_str());
+
+  for (auto _ : State) {
+    State.PauseTiming();
+    LLVMContext Ctx;
+    std::unique_ptr<Module> M = generateModule(Ctx, Size);
+    M->setTargetTriple(Triple);
+    std::unique_ptr<TargetMachine> TM(T->createTargetMachine(
+        Triple, sys::getHostCPUName(), "", TargetOptions(), std::nullopt));
+    M->setDataLayout(TM->createDataLayout());
+    SmallVector<char, 0> Buffer;
+    raw_svector_ostream OS(Buffer);
+    legacy::PassManager PM;
+    if (TM->addPassesToEmitFile(PM, OS, nullptr, CodeGenFileType::ObjectFile)) {
+      State.SkipWithError("target does not support object emission");
+      break;
+    }
+    State.ResumeTiming();
+    PM.run(*M);
+  }
+  Limit = Default;
+}
+BENCHMARK(BM_CodeGen)
+    ->ArgName("max-block-size")
+    ->Arg(0)
+    ->Arg(10000)
+    ->Arg(2000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,148 @@
+//===- ISelO0.cpp - Compare the instruction selectors at -O0 --------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures -O0 code generation for the host target with SelectionDAG,
+// FastISel and GlobalISel. GlobalISel falls back to SelectionDAG for the
+// functions it cannot select, and the number of fallbacks is reported as a
+// counter. The module comes from the file named by LLVM_ISEL_INPUT, or is
+// generated otherwise.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/IR/DiagnosticInfo.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/TargetParser/Host.h"
+#include <cstdlib>
+
+using namespace llvm;
+
+enum Selector { SelectionDAG, FastISel, GlobalISel };
+
+// Build many small functions with the integer and floating-point arithmetic,
+// conversions, memory accesses, compares, branches and calls of typical
+// unoptimized code.
+static void generateModule(Module &M) {
+  LLVMContext &Ctx = M.getContext();
+  IRBuilder<> B(Ctx);
+  Type *I32 = B.getInt32Ty();
+  Type *I64 = B.getInt64Ty();
+  Type *F64 = B.getDoubleTy();
+  FunctionType *FTy = FunctionType::get(F64, {B.getPtrTy(), I32, F64}, false);
+  Function *Prev = nullptr;
+  for (unsigned I = 0; I < 2000; ++I) {
+    Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage,
+                                   "f" + Twine(I), M);
+    BasicBlock *Entry = BasicBlock::Create(Ctx, "entry", F);
+    BasicBlock *Then = BasicBlock::Create(Ctx, "then", F);
+    BasicBlock *Exit = BasicBlock::Create(Ctx, "exit", F);
+    B.SetInsertPoint(Entry);
+    Value *P = F->getArg(0);
+    Value *Slot = B.CreateAlloca(F64);
+    B.CreateStore(F->getArg(2), Slot);
+    Value *N = B.CreateLoad(I32, B.CreateConstGEP1_32(I32, P, I % 16));
+    Value *X = B.CreateAdd(B.CreateMul(N, F->getArg(1)), B.getInt32(I));
+    Value *W = B.CreateShl(B.CreateZExt(X, I64), B.getInt64(I % 7));
+    Value *D = B.CreateFAdd(B.CreateUIToFP(X, F64), B.CreateSIToFP(W, F64));
+    B.CreateCondBr(B.CreateICmpULT(X, B.getInt32(1000)), Then, Exit);
+    B.SetInsertPoint(Then);
+    Value *C = Prev ? B.CreateCall(Prev, {P, B.CreateFPToUI(D, I32), D})
+                    : static_cast<Value *>(D);
+    B.CreateStore(B.CreateFMul(C, B.CreateLoad(F64, Slot)), Slot);
+    B.CreateBr(Exit);
+    B.SetInsertPoint(Exit);
+    B.CreateRet(B.CreateLoad(F64, Slot));
+    Prev = F;
+  }
+}
+
+static void BM_CodeGenO0(benchmark::State &State) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  std::string Triple = sys::getProcessTriple();
+  std::string Err;
+  const Target *T = TargetRegistry::lookupTarget(Triple, Err);
+  if (!T) {
+    State.SkipWithError(Err.c_str());
+    return;
+  }
+
+  // At -O0, FastISel is used unless it is explicitly disabled.
+  auto &FastISelOpt = static_cast<cl::opt<cl::boolOrDefault> &>(
+      *cl::getRegisteredOptions()["fast-isel"]);
+  cl::boolOrDefault Default = FastISelOpt;
+  auto Sel = static_cast<Selector>(State.range(0));
+  FastISelOpt = Sel == SelectionDAG ? cl::BOU_FALSE : cl::BOU_UNSET;
+  TargetOptions Options;
+  if (Sel == GlobalISel) {
+    Options.EnableGlobalISel = true;
+    Options.GlobalISelAbort = GlobalISelAbortMode::DisableWithDiag;
+  }
+
+  std::optional<std::string> Path = sys::Process::GetEnv("LLVM_ISEL_INPUT");
+  unsigned Fallbacks = 0;
+  for (auto _ : State) {
+    State.PauseTiming();
+    LLVMContext Ctx;
+    Fallbacks = 0;
+    Ctx.setDiagnosticHandlerCallBack(
+        [](const DiagnosticInfo *DI, void *Context) {
+          if (DI->getKind() == DK_ISelFallback)
+            ++*static_cast<unsigned *>(Context);
+        },
+        &Fallbacks);
+    std::unique_ptr<Module> M;
+    if (Path) {
+      SMDiagnostic Diag;
+      M = parseIRFile(*Path, Diag, Ctx);
+      if (!M) {
+        Diag.print("ISelO0", errs());
+        std::exit(1);
+      }
+    } else {
+      M = std::make_unique<Module>("generated", Ctx);
+      generateModule(*M);
+    }
+    M->setTargetTriple(Triple);
+    std::unique_ptr<TargetMachine> TM(
+        T->createTargetMachine(Triple, sys::getHostCPUName(), "", Options,
+                               std::nullopt, std::nullopt,
+                               CodeGenOptLevel::None));
+    M->setDataLayout(TM->createDataLayout());
+    SmallVector<char, 0> Buffer;
+    raw_svector_ostream OS(Buffer);
+    legacy::PassManager PM;
+    if (TM->addPassesToEmitFile(PM, OS, nullptr, CodeGenFileType::ObjectFile)) {
+      State.SkipWithError("target does not support object emission");
+      break;
+    }
+    State.ResumeTiming();
+    PM.run(*M);
+  }
+  State.counters["fallbacks"] = Fallbacks;
+  FastISelOpt = Default;
+}
+BENCHMARK(BM_CodeGenO0)
+    ->ArgName("selector")
+    ->Arg(SelectionDAG)
+    ->Arg(FastISel)
+    ->Arg(GlobalISel)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
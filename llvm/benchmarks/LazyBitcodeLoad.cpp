@@ -0,0 +1,157 @@
+//===- LazyBitcodeLoad.cpp - Load one function from a large module --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures what llvm-extract -func does before running any pass: lazily load
+// a module and materialize a single function, with the module-level metadata
+// either parsed eagerly or loaded on demand through the metadata index
+// (-ondemand-mds-loading). The module comes from the file named by
+// LLVM_LAZY_LOAD_INPUT, or is generated with debug info otherwise; the
+// function is the one named by LLVM_LAZY_LOAD_FUNCTION, or the middle one.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/DIBuilder.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include <cstdlib>
+
+using namespace llvm;
+
+// Build a module of many small functions with debug info. Every pair of
+// functions shares a struct type, like the methods of a C++ class, which makes
+// the types module-level metadata.
+static void generateModule(Module &M) {
+  LLVMContext &Ctx = M.getContext();
+  M.addModuleFlag(Module::Warning, "Debug Info Version",
+                  DEBUG_METADATA_VERSION);
+  DIBuilder DIB(M);
+  DIFile *File = DIB.createFile("generated.c", "/");
+  DIB.createCompileUnit(dwarf::DW_LANG_C99, File, "generated", true, "", 0);
+  DIBasicType *IntTy = DIB.createBasicType("int", 32, dwarf::DW_ATE_signed);
+
+  IRBuilder<> B(Ctx);
+  Type *I32 = B.getInt32Ty();
+  FunctionType *FTy = FunctionType::get(I32, {I32}, false);
+  DISubroutineType *SubTy = nullptr;
+  for (unsigned I = 0; I < 2000; ++I) {
+    unsigned Line = 10 * I + 1;
+    if (I % 2 == 0) {
+      SmallVector<Metadata *, 8> Members;
+      for (unsigned J = 0; J < 8; ++J)
+        Members.push_back(DIB.createMemberType(
+            nullptr, ("m" + Twine(J)).str(), File, Line, 32, 32, 32 * J,
+            DINode::FlagZero, IntTy));
+      DICompositeType *StructTy = DIB.createStructType(
+          nullptr, ("S" + Twine(I)).str(), File, Line, 256, 32,
+          DINode::FlagZero, nullptr, DIB.getOrCreateArray(Members));
+      SubTy = DIB.createSubroutineType(
+          DIB.getOrCreateTypeArray({IntTy, DIB.createPointerType(StructTy, 64)}));
+    }
+
+    Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage,
+                                   "f" + Twine(I), M);
+    DISubprogram *SP = DIB.createFunction(
+        File, F->getName(), F->getName(), File, Line, SubTy, Line,
+        DINode::FlagPrototyped, DISubprogram::SPFlagDefinition);
+    F->setSubprogram(SP);
+    B.SetInsertPoint(BasicBlock::Create(Ctx, "entry", F));
+    Value *V = F->getArg(0);
+    for (unsigned J = 0; J < 8; ++J) {
+      B.SetCurrentDebugLocation(DILocation::get(Ctx, Line + J, 3, SP));
+      V = B.CreateAdd(B.CreateMul(V, B.getInt32(I + J)), B.getInt32(J));
+      DILocalVariable *Var = DIB.createAutoVariable(
+          SP, ("v" + Twine(J)).str(), File, Line + J, IntTy);
+      DIB.insertDbgValueIntrinsic(V, Var, DIB.createExpression(),
+                                  B.getCurrentDebugLocation(),
+                                  B.GetInsertBlock());
+    }
+    B.CreateRet(V);
+  }
+  DIB.finalize();
+}
+
+static const SmallVector<char, 0> &getInput() {
+  static SmallVector<char, 0> Bitcode = [] {
+    LLVMContext Ctx;
+    std::unique_ptr<Module> M;
+    if (std::optional<std::string> Path =
+            sys::Process::GetEnv("LLVM_LAZY_LOAD_INPUT")) {
+      SMDiagnostic Err;
+      M = parseIRFile(*Path, Err, Ctx);
+      if (!M) {
+        Err.print("LazyBitcodeLoad", errs());
+        std::exit(1);
+      }
+    } else {
+      M = std::make_unique<Module>("generated", Ctx);
+      generateModule(*M);
+    }
+    SmallVector<char, 0> Buffer;
+    raw_svector_ostream OS(Buffer);
+    WriteBitcodeToFile(*M, OS);
+    return Buffer;
+  }();
+  return Bitcode;
+}
+
+static std::string getFunctionName(const Module &M) {
+  if (std::optional<std::string> Name =
+          sys::Process::GetEnv("LLVM_LAZY_LOAD_FUNCTION"))
+    return *Name;
+  SmallVector<const Function *, 0> Defined;
+  for (const Function &F : M)
+    if (!F.isDeclaration())
+      Defined.push_back(&F);
+  return Defined.empty() ? "" : Defined[Defined.size() / 2]->getName().str();
+}
+
+static void BM_MaterializeOneFunction(benchmark::State &State) {
+  auto &OnDemand = static_cast<cl::opt<bool> &>(
+      *cl::getRegisteredOptions()["ondemand-mds-loading"]);
+  OnDemand = State.range(0);
+  MemoryBufferRef Input(
+      StringRef(getInput().data(), getInput().size()), "input");
+  std::string Name;
+  for (auto _ : State) {
+    LLVMContext Ctx;
+    Expected<std::unique_ptr<Module>> M = getLazyBitcodeModule(Input, Ctx);
+    if (!M) {
+      errs() << toString(M.takeError()) << "\n";
+      std::exit(1);
+    }
+    if (Name.empty())
+      Name = getFunctionName(**M);
+    Function *F = (*M)->getFunction(Name);
+    if (!F) {
+      errs() << "no function named '" << Name << "'\n";
+      std::exit(1);
+    }
+    if (Error E = F->materialize()) {
+      errs() << toString(std::move(E)) << "\n";
+      std::exit(1);
+    }
+    benchmark::DoNotOptimize(F->getInstructionCount());
+  }
+  OnDemand = false;
+}
+BENCHMARK(BM_MaterializeOneFunction)
+    ->ArgName("ondemand")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
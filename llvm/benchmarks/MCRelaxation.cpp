@@ -0,0 +1,140 @@
+//===- MCRelaxation.cpp - Assemble code with many relaxable branches ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures what llvm-mc -filetype=obj does for x86-64 assembly in which most
+// branches start out short and many of them have to be relaxed, each one
+// moving the targets of the branches around it. The assembly comes from the
+// file named by LLVM_MC_RELAX_INPUT, or is generated otherwise with the number
+// of blocks given as the benchmark argument.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/MC/MCAsmBackend.h"
+#include "llvm/MC/MCAsmInfo.h"
+#include "llvm/MC/MCCodeEmitter.h"
+#include "llvm/MC/MCContext.h"
+#include "llvm/MC/MCInstrInfo.h"
+#include "llvm/MC/MCObjectFileInfo.h"
+#include "llvm/MC/MCObjectWriter.h"
+#include "llvm/MC/MCParser/MCAsmParser.h"
+#include "llvm/MC/MCParser/MCTargetAsmParser.h"
+#include "llvm/MC/MCRegisterInfo.h"
+#include "llvm/MC/MCStreamer.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/MC/MCTargetOptions.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include <cstdlib>
+
+using namespace llvm;
+
+// Emit blocks of a few instructions, each ending in a conditional branch to a
+// block up to 64 blocks ahead or behind. The distances are chosen so that a
+// fraction of the branches is just out of range for a one-byte displacement,
+// and relaxing them pushes others out of range too.
+static std::string generateAssembly(unsigned Blocks) {
+  std::string Asm;
+  raw_string_ostream OS(Asm);
+  OS << "\t.text\n\t.globl\tf\nf:\n";
+  for (unsigned I = 0; I < Blocks; ++I) {
+    OS << ".Lb" << I << ":\n";
+    for (unsigned J = 0; J < 1 + I % 4; ++J)
+      OS << "\taddl\t$" << I + J << ", %eax\n";
+    OS << "\tcmpl\t$" << I % 97 << ", %ecx\n";
+    unsigned Distance = 1 + (I * 37) % 64;
+    unsigned Target = I % 3 == 0 && I >= Distance
+                          ? I - Distance
+                          : std::min(I + Distance, Blocks - 1);
+    OS << "\tjne\t.Lb" << Target << '\n';
+    if (I % 8 == 0)
+      OS << "\tjmp\t.Lb" << std::min(I + 2 * Distance, Blocks - 1) << '\n';
+  }
+  OS << "\tretq\n";
+  return Asm;
+}
+
+static void BM_AssembleObject(benchmark::State &State) {
+  InitializeAllTargetInfos();
+  InitializeAllTargetMCs();
+  InitializeAllAsmParsers();
+  Triple TheTriple("x86_64-unknown-linux-gnu");
+  std::string Err;
+  const Target *T = TargetRegistry::lookupTarget(TheTriple.str(), Err);
+  if (!T) {
+    State.SkipWithError(Err.c_str());
+    return;
+  }
+
+  std::string Input;
+  if (std::optional<std::string> Path =
+          sys::Process::GetEnv("LLVM_MC_RELAX_INPUT")) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer =
+        MemoryBuffer::getFile(*Path);
+    if (!Buffer) {
+      errs() << *Path << ": " << Buffer.getError().message() << "\n";
+      std::exit(1);
+    }
+    Input = (*Buffer)->getBuffer().str();
+  } else {
+    Input = generateAssembly(State.range(0));
+  }
+
+  MCTargetOptions MCOptions;
+  std::unique_ptr<MCRegisterInfo> MRI(T->createMCRegInfo(TheTriple.str()));
+  std::unique_ptr<MCAsmInfo> MAI(
+      T->createMCAsmInfo(*MRI, TheTriple.str(), MCOptions));
+  std::unique_ptr<MCSubtargetInfo> STI(
+      T->createMCSubtargetInfo(TheTriple.str(), "", ""));
+  std::unique_ptr<MCInstrInfo> MCII(T->createMCInstrInfo());
+  uint64_t ObjectSize = 0;
+  for (auto _ : State) {
+    SourceMgr SrcMgr;
+    SrcMgr.AddNewSourceBuffer(MemoryBuffer::getMemBuffer(Input, "input"),
+                              SMLoc());
+    MCContext Ctx(TheTriple, MAI.get(), MRI.get(), STI.get(), &SrcMgr,
+                  &MCOptions);
+    std::unique_ptr<MCObjectFileInfo> MOFI(
+        T->createMCObjectFileInfo(Ctx, /*PIC=*/false));
+    Ctx.setObjectFileInfo(MOFI.get());
+
+    SmallVector<char, 0> Object;
+    raw_svector_ostream OS(Object);
+    MCCodeEmitter *CE = T->createMCCodeEmitter(*MCII, Ctx);
+    MCAsmBackend *MAB = T->createMCAsmBackend(*STI, *MRI, MCOptions);
+    std::unique_ptr<MCStreamer> Str(T->createMCObjectStreamer(
+        TheTriple, Ctx, std::unique_ptr<MCAsmBackend>(MAB),
+        MAB->createObjectWriter(OS), std::unique_ptr<MCCodeEmitter>(CE), *STI,
+        /*RelaxAll=*/false, /*IncrementalLinkerCompatible=*/false,
+        /*DWARFMustBeAtTheEnd=*/false));
+    Str->setUseAssemblerInfoForParsing(true);
+
+    std::unique_ptr<MCAsmParser> Parser(
+        createMCAsmParser(SrcMgr, Ctx, *Str, *MAI));
+    std::unique_ptr<MCTargetAsmParser> TAP(
+        T->createMCAsmParser(*STI, *Parser, *MCII, MCOptions));
+    Parser->setTargetParser(*TAP);
+    if (Parser->Run(/*NoInitialTextSection=*/false)) {
+      State.SkipWithError("failed to assemble the input");
+      break;
+    }
+    ObjectSize = Object.size();
+  }
+  State.counters["bytes"] = ObjectSize;
+}
+BENCHMARK(BM_AssembleObject)
+    ->ArgName("blocks")
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
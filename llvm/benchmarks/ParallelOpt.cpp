@@ -0,0 +1,158 @@
+//===- ParallelOpt.cpp - Optimize one module on several threads -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures the -O3 pipeline on a single large module at 1 to N threads. Since
+// an LLVMContext must only be used by one thread at a time, the module is
+// split with SplitModule and every part is optimized in its own context. The
+// module comes from the file named by LLVM_PARALLEL_OPT_INPUT, or is generated
+// otherwise.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Analysis/CGSCCPassManager.h"
+#include "llvm/Analysis/LoopAnalysisManager.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/SplitModule.h"
+#include <cstdlib>
+
+using namespace llvm;
+
+// Build a module of many functions with simple loops that the -O3 pipeline
+// can unroll, vectorize and inline.
+static void generateModule(Module &M) {
+  LLVMContext &Ctx = M.getContext();
+  IRBuilder<> B(Ctx);
+  Type *I32 = B.getInt32Ty();
+  FunctionType *FTy = FunctionType::get(I32, {B.getPtrTy(), I32}, false);
+  Function *Prev = nullptr;
+  for (unsigned I = 0; I < 1000; ++I) {
+    Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage,
+                                   "f" + Twine(I), M);
+    BasicBlock *Entry = BasicBlock::Create(Ctx, "entry", F);
+    BasicBlock *Loop = BasicBlock::Create(Ctx, "loop", F);
+    BasicBlock *Exit = BasicBlock::Create(Ctx, "exit", F);
+    B.SetInsertPoint(Entry);
+    B.CreateBr(Loop);
+    B.SetInsertPoint(Loop);
+    PHINode *IV = B.CreatePHI(I32, 2);
+    PHINode *Sum = B.CreatePHI(I32, 2);
+    Value *Ptr = B.CreateGEP(I32, F->getArg(0), IV);
+    Value *V = B.CreateLoad(I32, Ptr);
+    V = B.CreateAdd(B.CreateMul(V, B.getInt32(I + 3)), IV);
+    if (Prev && I % 4)
+      V = B.CreateCall(Prev, {Ptr, V});
+    B.CreateStore(V, Ptr);
+    Value *NewSum = B.CreateAdd(Sum, V);
+    Value *Next = B.CreateAdd(IV, B.getInt32(1));
+    B.CreateCondBr(B.CreateICmpSLT(Next, F->getArg(1)), Loop, Exit);
+    IV->addIncoming(B.getInt32(0), Entry);
+    IV->addIncoming(Next, Loop);
+    Sum->addIncoming(B.getInt32(0), Entry);
+    Sum->addIncoming(NewSum, Loop);
+    B.SetInsertPoint(Exit);
+    B.CreateRet(NewSum);
+    Prev = F;
+  }
+}
+
+static const SmallVector<char, 0> &getInput() {
+  static SmallVector<char, 0> Bitcode = [] {
+    LLVMContext Ctx;
+    std::unique_ptr<Module> M;
+    if (std::optional<std::string> Path =
+            sys::Process::GetEnv("LLVM_PARALLEL_OPT_INPUT")) {
+      SMDiagnostic Err;
+      M = parseIRFile(*Path, Err, Ctx);
+      if (!M) {
+        Err.print("ParallelOpt", errs());
+        std::exit(1);
+      }
+    } else {
+      M = std::make_unique<Module>("generated", Ctx);
+      generateModule(*M);
+    }
+    SmallVector<char, 0> Buffer;
+    raw_svector_ostream OS(Buffer);
+    WriteBitcodeToFile(*M, OS);
+    return Buffer;
+  }();
+  return Bitcode;
+}
+
+static void optimize(MemoryBufferRef Bitcode) {
+  LLVMContext Ctx;
+  Expected<std::unique_ptr<Module>> M = parseBitcodeFile(Bitcode, Ctx);
+  if (!M) {
+    errs() << toString(M.takeError()) << "\n";
+    std::exit(1);
+  }
+
+  LoopAnalysisManager LAM;
+  FunctionAnalysisManager FAM;
+  CGSCCAnalysisManager CGAM;
+  ModuleAnalysisManager MAM;
+  PassBuilder PB;
+  PB.registerModuleAnalyses(MAM);
+  PB.registerCGSCCAnalyses(CGAM);
+  PB.registerFunctionAnalyses(FAM);
+  PB.registerLoopAnalyses(LAM);
+  PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+  ModulePassManager MPM =
+      PB.buildPerModuleDefaultPipeline(OptimizationLevel::O3);
+  MPM.run(**M, MAM);
+}
+
+static void BM_OptimizeO3(benchmark::State &State) {
+  unsigned Threads = State.range(0);
+  const SmallVector<char, 0> &Input = getInput();
+  for (auto _ : State) {
+    // Split the module and serialize the parts, as each thread needs its own
+    // context.
+    std::vector<SmallVector<char, 0>> Parts;
+    {
+      LLVMContext Ctx;
+      Expected<std::unique_ptr<Module>> M = parseBitcodeFile(
+          MemoryBufferRef(StringRef(Input.data(), Input.size()), "input"),
+          Ctx);
+      if (!M) {
+        errs() << toString(M.takeError()) << "\n";
+        std::exit(1);
+      }
+      SplitModule(**M, Threads, [&](std::unique_ptr<Module> Part) {
+        raw_svector_ostream OS(Parts.emplace_back());
+        WriteBitcodeToFile(*Part, OS);
+      });
+    }
+
+    DefaultThreadPool Pool(hardware_concurrency(Threads));
+    for (const SmallVector<char, 0> &Part : Parts)
+      Pool.async([&Part] {
+        optimize(MemoryBufferRef(StringRef(Part.data(), Part.size()), "part"));
+      });
+    Pool.wait();
+  }
+}
+BENCHMARK(BM_OptimizeO3)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
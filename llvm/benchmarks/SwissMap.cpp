@@ -0,0 +1,154 @@
+//===- SwissMap.cpp - Compare SwissMap with DenseMap and StringMap --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/SwissMap.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+// Keys shaped like the ones the compiler hashes most: pointers to allocated
+// objects, identifiers, and pairs of small integers.
+std::vector<void *> makePointerKeys(size_t N) {
+  static std::vector<std::unique_ptr<char[]>> Storage;
+  std::vector<void *> Keys;
+  for (size_t I = 0; I != N; ++I) {
+    Storage.push_back(std::make_unique<char[]>(48));
+    Keys.push_back(Storage.back().get());
+  }
+  return Keys;
+}
+
+std::vector<std::string> makeStringKeys(size_t N) {
+  std::vector<std::string> Keys;
+  for (size_t I = 0; I != N; ++I)
+    Keys.push_back("identifier_" + std::to_string(I * 2654435761u));
+  return Keys;
+}
+
+std::vector<std::pair<unsigned, unsigned>> makePairKeys(size_t N) {
+  std::vector<std::pair<unsigned, unsigned>> Keys;
+  for (size_t I = 0; I != N; ++I)
+    Keys.push_back({unsigned(I), unsigned(I % 7)});
+  return Keys;
+}
+
+template <typename MapT, typename KeyT>
+void insert(MapT &M, const std::vector<KeyT> &Keys) {
+  unsigned V = 0;
+  for (const KeyT &K : Keys)
+    M[K] = V++;
+}
+
+template <typename KeyT> const std::vector<KeyT> &keys();
+template <> const std::vector<void *> &keys() {
+  static std::vector<void *> Keys = makePointerKeys(1 << 17);
+  return Keys;
+}
+template <> const std::vector<std::pair<unsigned, unsigned>> &keys() {
+  static auto Keys = makePairKeys(1 << 17);
+  return Keys;
+}
+const std::vector<StringRef> &stringKeys(bool Miss = false) {
+  static std::vector<std::string> Hit = makeStringKeys(1 << 18);
+  static std::vector<StringRef> HitRefs(Hit.begin(), Hit.begin() + (1 << 17));
+  static std::vector<StringRef> MissRefs(Hit.begin() + (1 << 17), Hit.end());
+  return Miss ? MissRefs : HitRefs;
+}
+template <> const std::vector<StringRef> &keys() { return stringKeys(); }
+
+template <typename KeyT> std::vector<KeyT> subset(size_t N) {
+  const std::vector<KeyT> &All = keys<KeyT>();
+  return std::vector<KeyT>(All.begin(), All.begin() + N);
+}
+} // namespace
+
+template <typename MapT, typename KeyT>
+static void BM_Insert(benchmark::State &State) {
+  std::vector<KeyT> Keys = subset<KeyT>(State.range(0));
+  for (auto _ : State) {
+    MapT M;
+    insert(M, Keys);
+    benchmark::DoNotOptimize(M);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <typename MapT, typename KeyT>
+static void BM_LookupHit(benchmark::State &State) {
+  std::vector<KeyT> Keys = subset<KeyT>(State.range(0));
+  MapT M;
+  insert(M, Keys);
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(0));
+  for (auto _ : State)
+    for (const KeyT &K : Keys)
+      benchmark::DoNotOptimize(M.find(K));
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <typename MapT>
+static void BM_LookupMissString(benchmark::State &State) {
+  size_t N = State.range(0);
+  std::vector<StringRef> Keys = subset<StringRef>(N);
+  const std::vector<StringRef> &Misses = stringKeys(/*Miss=*/true);
+  MapT M;
+  insert(M, Keys);
+  for (auto _ : State)
+    for (size_t I = 0; I != N; ++I)
+      benchmark::DoNotOptimize(M.find(Misses[I]));
+  State.SetItemsProcessed(State.iterations() * N);
+}
+
+// Keep a sliding window of live keys, the access pattern of worklists and
+// scoped tables, which leaves DenseMap full of tombstones.
+template <typename MapT, typename KeyT>
+static void BM_EraseHeavy(benchmark::State &State) {
+  const std::vector<KeyT> &Keys = keys<KeyT>();
+  size_t Window = State.range(0);
+  for (auto _ : State) {
+    MapT M;
+    for (size_t I = 0, E = Keys.size(); I != E; ++I) {
+      M[Keys[I]] = I;
+      if (I >= Window)
+        M.erase(Keys[I - Window]);
+    }
+    benchmark::DoNotOptimize(M);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+using PairT = std::pair<unsigned, unsigned>;
+
+#define MAP_BENCHMARKS(KEY, ...)                                               \
+  BENCHMARK(BM_Insert<SwissMap<KEY, unsigned>, KEY>)->__VA_ARGS__;             \
+  BENCHMARK(BM_Insert<DenseMap<KEY, unsigned>, KEY>)->__VA_ARGS__;             \
+  BENCHMARK(BM_LookupHit<SwissMap<KEY, unsigned>, KEY>)->__VA_ARGS__;          \
+  BENCHMARK(BM_LookupHit<DenseMap<KEY, unsigned>, KEY>)->__VA_ARGS__;          \
+  BENCHMARK(BM_EraseHeavy<SwissMap<KEY, unsigned>, KEY>)->Range(64, 4096);     \
+  BENCHMARK(BM_EraseHeavy<DenseMap<KEY, unsigned>, KEY>)->Range(64, 4096);
+
+MAP_BENCHMARKS(void *, Range(16, 1 << 17))
+MAP_BENCHMARKS(PairT, Range(16, 1 << 17))
+MAP_BENCHMARKS(StringRef, Range(16, 1 << 17))
+
+BENCHMARK(BM_Insert<StringMap<unsigned>, StringRef>)->Range(16, 1 << 17);
+BENCHMARK(BM_LookupHit<StringMap<unsigned>, StringRef>)->Range(16, 1 << 17);
+BENCHMARK(BM_EraseHeavy<StringMap<unsigned>, StringRef>)->Range(64, 4096);
+BENCHMARK(BM_LookupMissString<SwissMap<StringRef, unsigned>>)
+    ->Range(16, 1 << 17);
+BENCHMARK(BM_LookupMissString<DenseMap<StringRef, unsigned>>)
+    ->Range(16, 1 << 17);
+BENCHMARK(BM_LookupMissString<StringMap<unsigned>>)->Range(16, 1 << 17);
+
+BENCHMARK_MAIN();
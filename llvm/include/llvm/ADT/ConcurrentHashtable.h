@@ -13,9 +13,11 @@
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMapEntry.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Parallel.h"
+#include "llvm/Support/PerThreadBumpPtrAllocator.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/xxhash.h"
 #include <atomic>
@@ -223,6 +225,98 @@ public:
     return {};
   }
 
+  /// \returns the entry for \p Key, or nullptr if there is none.
+  KeyDataTy *find(const KeyTy &Key) {
+    uint64_t Hash = Info::getHashValue(Key);
+    Bucket &CurBucket = BucketsArray[getBucketIdx(Hash)];
+    uint32_t ExtHashBits = getExtHashBits(Hash);
+
+#if LLVM_ENABLE_THREADS
+    std::lock_guard<std::mutex> Lock(CurBucket.Guard);
+#endif
+
+    uint32_t EntryIdx = findEntryIdx(CurBucket, Key, ExtHashBits);
+    return EntryIdx == CurBucket.Size ? nullptr : CurBucket.Entries[EntryIdx];
+  }
+
+  /// Remove the entry for \p Key. The memory of the entry is owned by the
+  /// allocator and is not released.
+  ///
+  /// \returns the removed entry, or nullptr if there was none.
+  KeyDataTy *erase(const KeyTy &Key) {
+    uint64_t Hash = Info::getHashValue(Key);
+    Bucket &CurBucket = BucketsArray[getBucketIdx(Hash)];
+    uint32_t ExtHashBits = getExtHashBits(Hash);
+
+#if LLVM_ENABLE_THREADS
+    std::lock_guard<std::mutex> Lock(CurBucket.Guard);
+#endif
+
+    uint32_t EntryIdx = findEntryIdx(CurBucket, Key, ExtHashBits);
+    if (EntryIdx == CurBucket.Size)
+      return nullptr;
+
+    KeyDataTy *Result = CurBucket.Entries[EntryIdx];
+    HashesPtr BucketHashes = CurBucket.Hashes;
+    DataPtr BucketEntries = CurBucket.Entries;
+    uint32_t Mask = CurBucket.Size - 1;
+
+    // Shift the following entries of the probe sequence back so that no
+    // lookup stops early at the freed slot. This avoids tombstones.
+    uint32_t HoleIdx = EntryIdx;
+    for (uint32_t CurEntryIdx = (HoleIdx + 1) & Mask;
+         BucketEntries[CurEntryIdx] != nullptr;
+         CurEntryIdx = (CurEntryIdx + 1) & Mask) {
+      uint32_t StartIdx =
+          getStartIdx(BucketHashes[CurEntryIdx], CurBucket.Size);
+      // The entry stays if its start position lies cyclically in
+      // (HoleIdx, CurEntryIdx].
+      if (((CurEntryIdx - StartIdx) & Mask) < ((CurEntryIdx - HoleIdx) & Mask))
+        continue;
+      BucketHashes[HoleIdx] = BucketHashes[CurEntryIdx];
+      BucketEntries[HoleIdx] = BucketEntries[CurEntryIdx];
+      HoleIdx = CurEntryIdx;
+    }
+    BucketHashes[HoleIdx] = 0;
+    BucketEntries[HoleIdx] = nullptr;
+    CurBucket.NumberOfEntries--;
+
+    return Result;
+  }
+
+  /// Call \p Fn for every entry. Must not run concurrently with any
+  /// modification of the table.
+  template <typename FnTy> void forEach(FnTy &&Fn) {
+    for (uint32_t Idx = 0; Idx < NumberOfBuckets; Idx++) {
+      Bucket &CurBucket = BucketsArray[Idx];
+      for (uint32_t EntryIdx = 0; EntryIdx < CurBucket.Size; EntryIdx++)
+        if (KeyDataTy *Entry = CurBucket.Entries[EntryIdx])
+          Fn(*Entry);
+    }
+  }
+
+  /// \returns the number of entries. Must not run concurrently with any
+  /// modification of the table.
+  size_t size() const {
+    size_t Result = 0;
+    for (uint32_t Idx = 0; Idx < NumberOfBuckets; Idx++)
+      Result += BucketsArray[Idx].NumberOfEntries;
+    return Result;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  /// Remove all entries, keeping the current bucket sizes. Must not run
+  /// concurrently with any other operation.
+  void clear() {
+    for (uint32_t Idx = 0; Idx < NumberOfBuckets; Idx++) {
+      Bucket &CurBucket = BucketsArray[Idx];
+      memset(CurBucket.Hashes, 0, sizeof(ExtHashBitsTy) * CurBucket.Size);
+      memset(CurBucket.Entries, 0, sizeof(EntryDataTy) * CurBucket.Size);
+      CurBucket.NumberOfEntries = 0;
+    }
+  }
+
   /// Print information about current state of hash table structures.
   void printStatistic(raw_ostream &OS) {
     OS << "\n--- HashTable statistic:\n";
@@ -358,6 +452,26 @@ protected:
       delete[] SrcEntries;
   }
 
+  // \returns the index of the entry for \p Key in \p CurBucket, or the
+  // bucket size if there is none. The bucket must be locked.
+  uint32_t findEntryIdx(Bucket &CurBucket, const KeyTy &Key,
+                        uint32_t ExtHashBits) {
+    HashesPtr BucketHashes = CurBucket.Hashes;
+    DataPtr BucketEntries = CurBucket.Entries;
+    uint32_t CurEntryIdx = getStartIdx(ExtHashBits, CurBucket.Size);
+
+    // The bucket is never full, so the probe ends at an empty slot.
+    while (BucketEntries[CurEntryIdx] != nullptr) {
+      if (BucketHashes[CurEntryIdx] == ExtHashBits &&
+          Info::isEqual(Info::getKey(*BucketEntries[CurEntryIdx]), Key))
+        return CurEntryIdx;
+
+      CurEntryIdx++;
+      CurEntryIdx &= (CurBucket.Size - 1);
+    }
+    return CurBucket.Size;
+  }
+
   uint32_t getBucketIdx(hash_code Hash) { return Hash & HashMask; }
 
   uint32_t getExtHashBits(uint64_t Hash) {
@@ -395,6 +509,71 @@ protected:
   AllocatorTy &MultiThreadAllocator;
 };
 
+template <typename ValueTy, typename AllocatorTy>
+class ConcurrentStringMapInfo {
+public:
+  using EntryTy = StringMapEntry<ValueTy>;
+
+  /// \returns Hash value for the specified \p Key.
+  static inline uint64_t getHashValue(const StringRef &Key) {
+    return xxh3_64bits(Key);
+  }
+
+  /// \returns true if both \p LHS and \p RHS are equal.
+  static inline bool isEqual(const StringRef &LHS, const StringRef &RHS) {
+    return LHS == RHS;
+  }
+
+  /// \returns key for the specified \p KeyData.
+  static inline StringRef getKey(const EntryTy &KeyData) {
+    return KeyData.getKey();
+  }
+
+  /// \returns newly created entry with a value initialized value.
+  static inline EntryTy *create(const StringRef &Key, AllocatorTy &Allocator) {
+    return EntryTy::create(Key, Allocator);
+  }
+};
+
+/// ConcurrentStringMap - a ConcurrentHashTableByPtr mapping strings to values
+/// of type \p ValueTy, with StringMapEntry entries that own a copy of the key.
+/// Entries live in an allocator owned by the map, so pointers to them stay
+/// valid until the map is destroyed, even after they are erased.
+///
+/// The map only synchronizes the table itself; concurrent accesses to the
+/// value of one entry must be synchronized by the user, e.g. by using an
+/// atomic \p ValueTy. The default allocator must only be used from threads
+/// created by ThreadPoolExecutor (parallelFor, TaskGroup...).
+template <typename ValueTy,
+          typename AllocatorTy = parallel::PerThreadBumpPtrAllocator>
+class ConcurrentStringMap
+    : public ConcurrentHashTableByPtr<
+          StringRef, StringMapEntry<ValueTy>, AllocatorTy,
+          ConcurrentStringMapInfo<ValueTy, AllocatorTy>> {
+  using BaseTy =
+      ConcurrentHashTableByPtr<StringRef, StringMapEntry<ValueTy>, AllocatorTy,
+                               ConcurrentStringMapInfo<ValueTy, AllocatorTy>>;
+
+public:
+  ConcurrentStringMap(uint64_t EstimatedSize = 100000)
+      : BaseTy(Allocator, EstimatedSize) {}
+
+  /// \returns the value for \p Key, or a value initialized value if there
+  /// is none.
+  ValueTy lookup(StringRef Key) {
+    if (StringMapEntry<ValueTy> *Entry = this->find(Key))
+      return Entry->getValue();
+    return ValueTy();
+  }
+
+  bool contains(StringRef Key) { return this->find(Key) != nullptr; }
+
+  AllocatorTy &getAllocator() { return Allocator; }
+
+private:
+  AllocatorTy Allocator;
+};
+
 } // end namespace llvm
 
 #endif // LLVM_ADT_CONCURRENTHASHTABLE_H
@@ -0,0 +1,701 @@
+//===- llvm/ADT/SwissMap.h - Open addressing hash map with groups -*- C++ -*-=//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the SwissMap class, an open addressing hash map in the
+/// style of the "Swiss tables" described at https://abseil.io/about/design/swisstables.
+///
+/// Next to the buckets, the map keeps one control byte per bucket. A control
+/// byte records whether the bucket is empty, deleted, or full, and for a full
+/// bucket 7 bits of the key's hash. Lookups compare a whole group of control
+/// bytes (16 with SSE2, 8 otherwise) against the hash at once and only compare
+/// keys whose 7 bits match, so a probe rarely touches a bucket that does not
+/// hold the key. Erasing marks a bucket empty rather than deleted when no probe
+/// sequence can have passed over it, which keeps erase-heavy workloads from
+/// filling the table with tombstones.
+///
+/// Unlike DenseMap, keys need no reserved empty and tombstone values: only
+/// DenseMapInfo<KeyT>::getHashValue and isEqual are used.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_SWISSMAP_H
+#define LLVM_ADT_SWISSMAP_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/ADT/EpochTracker.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemAlloc.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LLVM_SWISSMAP_SSE2 1
+#endif
+
+namespace llvm {
+
+namespace detail {
+namespace swissmap {
+
+/// Control byte values. Full buckets store the low 7 bits of the hash, so any
+/// non-negative value means full.
+enum : int8_t {
+  CtrlEmpty = -128, // 0b10000000
+  CtrlDeleted = -2, // 0b11111110
+};
+
+/// A bit mask with one (group) lane per bucket of a group. \p Shift is log2 of
+/// the width of a lane.
+template <unsigned Width, unsigned Shift> class BitMask {
+  uint64_t Mask;
+
+public:
+  explicit BitMask(uint64_t Mask) : Mask(Mask) {}
+
+  explicit operator bool() const { return Mask != 0; }
+
+  /// Index of the lowest set lane. The mask must not be empty.
+  unsigned lowest() const { return llvm::countr_zero(Mask) >> Shift; }
+
+  /// Number of clear lanes below the lowest set one.
+  unsigned trailingEmpty() const {
+    return Mask ? lowest() : Width;
+  }
+
+  /// Number of clear lanes above the highest set one.
+  unsigned leadingEmpty() const {
+    if (!Mask)
+      return Width;
+    return (llvm::countl_zero(Mask) - (64 - (Width << Shift))) >> Shift;
+  }
+
+  /// Clears the lowest set lane. The mask must not be empty.
+  void dropLowest() { Mask &= Mask - 1; }
+};
+
+#ifdef LLVM_SWISSMAP_SSE2
+/// A group of 16 control bytes, compared with SSE2.
+struct Group {
+  static constexpr unsigned Width = 16;
+  using Mask = BitMask<Width, 0>;
+
+  __m128i Ctrl;
+
+  explicit Group(const int8_t *Pos)
+      : Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Pos))) {}
+
+  Mask match(int8_t H2) const {
+    return Mask(static_cast<uint16_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Ctrl))));
+  }
+
+  Mask matchEmpty() const { return match(CtrlEmpty); }
+
+  Mask matchEmptyOrDeleted() const {
+    // Both are the only values below -1.
+    return Mask(static_cast<uint16_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), Ctrl))));
+  }
+};
+#else
+/// A group of 8 control bytes, compared as one 64-bit word.
+struct Group {
+  static constexpr unsigned Width = 8;
+  using Mask = BitMask<Width, 3>;
+
+  static constexpr uint64_t LSBs = 0x0101010101010101ULL;
+  static constexpr uint64_t MSBs = 0x8080808080808080ULL;
+
+  uint64_t Ctrl;
+
+  explicit Group(const int8_t *Pos)
+      : Ctrl(support::endian::read64le(Pos)) {}
+
+  /// May report a lane above a real match that does not match. Callers
+  /// compare the keys anyway.
+  Mask match(int8_t H2) const {
+    uint64_t X = Ctrl ^ (LSBs * static_cast<uint8_t>(H2));
+    return Mask((X - LSBs) & ~X & MSBs);
+  }
+
+  /// Empty is the only value with the high bit set and bit 1 clear.
+  Mask matchEmpty() const { return Mask((Ctrl & ~(Ctrl << 6)) & MSBs); }
+
+  /// Empty and deleted are the only values with the high bit set and bit 0
+  /// clear.
+  Mask matchEmptyOrDeleted() const {
+    return Mask((Ctrl & ~(Ctrl << 7)) & MSBs);
+  }
+};
+#endif
+
+} // end namespace swissmap
+} // end namespace detail
+
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>,
+          typename Bucket = llvm::detail::DenseMapPair<KeyT, ValueT>,
+          bool IsConst = false>
+class SwissMapIterator;
+
+/// An open addressing hash map probing groups of buckets at once. See the file
+/// comment for the layout. Iterators and references are invalidated by any
+/// insertion that grows the table, and by erase only for the erased element.
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>,
+          typename BucketT = llvm::detail::DenseMapPair<KeyT, ValueT>>
+class SwissMap : public DebugEpochBase {
+  using Group = detail::swissmap::Group;
+
+  template <typename T>
+  using const_arg_type_t = typename const_pointer_or_const_ref<T>::type;
+
+  /// Buckets, followed by NumBuckets + Group::Width control bytes. The last
+  /// Group::Width control bytes repeat the first ones, so that a group can be
+  /// loaded at any bucket without wrapping around.
+  BucketT *Buckets = nullptr;
+  int8_t *Ctrl = nullptr;
+  unsigned NumBuckets = 0;
+  unsigned NumEntries = 0;
+  /// Number of insertions into empty buckets before the table must grow.
+  unsigned GrowthLeft = 0;
+
+public:
+  using size_type = unsigned;
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = BucketT;
+
+  using iterator = SwissMapIterator<KeyT, ValueT, KeyInfoT, BucketT>;
+  using const_iterator =
+      SwissMapIterator<KeyT, ValueT, KeyInfoT, BucketT, true>;
+
+  SwissMap() = default;
+
+  /// Create a map that can hold \p NumElementsToReserve elements without
+  /// growing.
+  explicit SwissMap(unsigned NumElementsToReserve) {
+    reserve(NumElementsToReserve);
+  }
+
+  SwissMap(std::initializer_list<std::pair<KeyT, ValueT>> Vals) {
+    reserve(Vals.size());
+    insert(Vals.begin(), Vals.end());
+  }
+
+  template <typename InputIt> SwissMap(const InputIt &I, const InputIt &E) {
+    reserve(std::distance(I, E));
+    insert(I, E);
+  }
+
+  SwissMap(const SwissMap &Other) : DebugEpochBase() { copyFrom(Other); }
+
+  SwissMap(SwissMap &&Other) : DebugEpochBase() { swap(Other); }
+
+  ~SwissMap() {
+    destroyAll();
+    deallocateBuckets();
+  }
+
+  SwissMap &operator=(const SwissMap &Other) {
+    if (&Other != this) {
+      destroyAll();
+      deallocateBuckets();
+      copyFrom(Other);
+    }
+    return *this;
+  }
+
+  SwissMap &operator=(SwissMap &&Other) {
+    destroyAll();
+    deallocateBuckets();
+    Buckets = nullptr;
+    Ctrl = nullptr;
+    NumBuckets = NumEntries = GrowthLeft = 0;
+    swap(Other);
+    return *this;
+  }
+
+  void swap(SwissMap &RHS) {
+    incrementEpoch();
+    RHS.incrementEpoch();
+    std::swap(Buckets, RHS.Buckets);
+    std::swap(Ctrl, RHS.Ctrl);
+    std::swap(NumBuckets, RHS.NumBuckets);
+    std::swap(NumEntries, RHS.NumEntries);
+    std::swap(GrowthLeft, RHS.GrowthLeft);
+  }
+
+  iterator begin() { return makeIterator(0); }
+  iterator end() { return makeIterator(NumBuckets, /*NoAdvance=*/true); }
+  const_iterator begin() const { return makeConstIterator(0); }
+  const_iterator end() const {
+    return makeConstIterator(NumBuckets, /*NoAdvance=*/true);
+  }
+
+  [[nodiscard]] bool empty() const { return NumEntries == 0; }
+  unsigned size() const { return NumEntries; }
+
+  /// Number of buckets currently allocated.
+  unsigned getNumBuckets() const { return NumBuckets; }
+
+  /// Grow the map so that it can contain at least \p NumElements items before
+  /// resizing again.
+  void reserve(size_type NumElements) {
+    incrementEpoch();
+    unsigned Needed = getMinBucketsForEntries(NumElements);
+    if (Needed > NumBuckets)
+      resize(Needed);
+  }
+
+  /// Remove all elements, keeping the allocated buckets.
+  void clear() {
+    incrementEpoch();
+    if (NumEntries == 0 && GrowthLeft == maxLoad(NumBuckets))
+      return;
+    destroyAll();
+    if (NumBuckets)
+      std::memset(Ctrl, detail::swissmap::CtrlEmpty,
+                  NumBuckets + Group::Width);
+    NumEntries = 0;
+    GrowthLeft = maxLoad(NumBuckets);
+  }
+
+  /// Return true if the specified key is in the map, false otherwise.
+  bool contains(const_arg_type_t<KeyT> Val) const {
+    return findIndex(Val) != NumBuckets;
+  }
+
+  /// Return 1 if the specified key is in the map, 0 otherwise.
+  size_type count(const_arg_type_t<KeyT> Val) const {
+    return contains(Val) ? 1 : 0;
+  }
+
+  iterator find(const_arg_type_t<KeyT> Val) {
+    unsigned I = findIndex(Val);
+    return I == NumBuckets ? end() : makeIterator(I, /*NoAdvance=*/true);
+  }
+  const_iterator find(const_arg_type_t<KeyT> Val) const {
+    unsigned I = findIndex(Val);
+    return I == NumBuckets ? end() : makeConstIterator(I, /*NoAdvance=*/true);
+  }
+
+  /// Return the entry for the specified key, or a default constructed value if
+  /// no such entry exists.
+  ValueT lookup(const_arg_type_t<KeyT> Val) const {
+    unsigned I = findIndex(Val);
+    if (I != NumBuckets)
+      return Buckets[I].getSecond();
+    return ValueT();
+  }
+
+  /// Return the entry for the specified key. Asserts that it exists.
+  const ValueT &at(const_arg_type_t<KeyT> Val) const {
+    unsigned I = findIndex(Val);
+    assert(I != NumBuckets && "SwissMap::at failed due to a missing key");
+    return Buckets[I].getSecond();
+  }
+
+  std::pair<iterator, bool> insert(const std::pair<KeyT, ValueT> &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+
+  std::pair<iterator, bool> insert(std::pair<KeyT, ValueT> &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+
+  /// Insert a value constructed from \p Args if \p Key is not in the map.
+  /// Returns the entry for \p Key, and whether it was inserted.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyT &&Key, Ts &&...Args) {
+    auto [I, Inserted] = findOrPrepareInsert(Key);
+    if (Inserted) {
+      ::new (&Buckets[I].getFirst()) KeyT(std::move(Key));
+      ::new (&Buckets[I].getSecond()) ValueT(std::forward<Ts>(Args)...);
+    }
+    return {makeIterator(I, /*NoAdvance=*/true), Inserted};
+  }
+
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(const KeyT &Key, Ts &&...Args) {
+    auto [I, Inserted] = findOrPrepareInsert(Key);
+    if (Inserted) {
+      ::new (&Buckets[I].getFirst()) KeyT(Key);
+      ::new (&Buckets[I].getSecond()) ValueT(std::forward<Ts>(Args)...);
+    }
+    return {makeIterator(I, /*NoAdvance=*/true), Inserted};
+  }
+
+  ValueT &operator[](const KeyT &Key) {
+    return try_emplace(Key).first->getSecond();
+  }
+
+  ValueT &operator[](KeyT &&Key) {
+    return try_emplace(std::move(Key)).first->getSecond();
+  }
+
+  /// Erase the entry for \p Val. Returns true if there was one.
+  bool erase(const KeyT &Val) {
+    unsigned I = findIndex(Val);
+    if (I == NumBuckets)
+      return false;
+    eraseIndex(I);
+    return true;
+  }
+
+  void erase(iterator I) {
+    assert(I.Ptr >= Buckets && I.Ptr < Buckets + NumBuckets &&
+           "erasing an iterator of another map");
+    eraseIndex(I.Ptr - Buckets);
+  }
+
+  /// Return the approximate size (in bytes) of the actual map.
+  size_t getMemorySize() const { return allocationSize(NumBuckets); }
+
+private:
+  static unsigned maxLoad(unsigned NumBuckets) {
+    // Keep at least one eighth of the buckets empty, so that unsuccessful
+    // probes end quickly.
+    return NumBuckets - NumBuckets / 8;
+  }
+
+  static unsigned getMinBucketsForEntries(unsigned NumEntries) {
+    if (NumEntries == 0)
+      return 0;
+    // maxLoad(N) >= NumEntries, for N a power of two of at least one group.
+    return std::max<unsigned>(Group::Width,
+                              NextPowerOf2(NumEntries * uint64_t(8) / 7));
+  }
+
+  static size_t allocationSize(unsigned NumBuckets) {
+    if (NumBuckets == 0)
+      return 0;
+    return sizeof(BucketT) * NumBuckets + NumBuckets + Group::Width;
+  }
+
+  static constexpr size_t allocationAlign() {
+    return std::max(alignof(BucketT), alignof(uint64_t));
+  }
+
+  /// Spreads the bits of DenseMapInfo's hash, which is often weak in its low
+  /// bits (e.g. for pointers), over the 64 bits used to pick the first group
+  /// (the upper bits) and the control byte (the low 7 bits).
+  template <typename LookupKeyT> static uint64_t hash(const LookupKeyT &Val) {
+    uint64_t H = uint64_t(KeyInfoT::getHashValue(Val)) * 0x9E3779B97F4A7C15ULL;
+    return H ^ (H >> 32);
+  }
+
+  static int8_t h2(uint64_t Hash) { return static_cast<int8_t>(Hash & 0x7F); }
+
+  /// Visits the groups of buckets in the order the key's probe sequence uses
+  /// them. The sequence steps by triangular numbers of groups, which visits
+  /// every group of a power of two sized table exactly once.
+  class ProbeSeq {
+    unsigned Mask;
+    unsigned Offset;
+    unsigned Index = 0;
+
+  public:
+    ProbeSeq(uint64_t Hash, unsigned Mask)
+        : Mask(Mask), Offset(unsigned(Hash >> 7) & Mask) {}
+    unsigned offset() const { return Offset; }
+    unsigned offset(unsigned Lane) const { return (Offset + Lane) & Mask; }
+    void next() {
+      Index += Group::Width;
+      Offset = (Offset + Index) & Mask;
+    }
+  };
+
+  template <typename LookupKeyT>
+  unsigned findIndex(const LookupKeyT &Val) const {
+    if (NumBuckets == 0)
+      return 0;
+    uint64_t Hash = hash(Val);
+    int8_t H2 = h2(Hash);
+    for (ProbeSeq Seq(Hash, NumBuckets - 1);; Seq.next()) {
+      Group G(Ctrl + Seq.offset());
+      for (auto M = G.match(H2); M; M.dropLowest()) {
+        unsigned I = Seq.offset(M.lowest());
+        if (LLVM_LIKELY(KeyInfoT::isEqual(Val, Buckets[I].getFirst())))
+          return I;
+      }
+      if (LLVM_LIKELY(G.matchEmpty()))
+        return NumBuckets;
+    }
+  }
+
+  /// Returns the first empty or deleted bucket of the probe sequence of
+  /// \p Hash.
+  unsigned findFirstNonFull(uint64_t Hash) const {
+    for (ProbeSeq Seq(Hash, NumBuckets - 1);; Seq.next()) {
+      if (auto M = Group(Ctrl + Seq.offset()).matchEmptyOrDeleted())
+        return Seq.offset(M.lowest());
+    }
+  }
+
+  void setCtrl(unsigned I, int8_t C) {
+    Ctrl[I] = C;
+    if (I < Group::Width)
+      Ctrl[NumBuckets + I] = C;
+  }
+
+  /// Returns the index of \p Key's bucket and false if it is in the map.
+  /// Otherwise claims a bucket for it, which the caller must construct, and
+  /// returns its index and true.
+  std::pair<unsigned, bool> findOrPrepareInsert(const KeyT &Key) {
+    unsigned I = findIndex(Key);
+    if (NumBuckets && I != NumBuckets)
+      return {I, false};
+
+    incrementEpoch();
+    uint64_t Hash = hash(Key);
+    if (NumBuckets == 0) {
+      resize(Group::Width);
+      I = findFirstNonFull(Hash);
+    } else {
+      I = findFirstNonFull(Hash);
+      // Reusing a deleted bucket does not use up an empty one.
+      if (GrowthLeft == 0 && Ctrl[I] == detail::swissmap::CtrlEmpty) {
+        rehashOrGrow();
+        I = findFirstNonFull(Hash);
+      }
+    }
+    if (Ctrl[I] == detail::swissmap::CtrlEmpty)
+      --GrowthLeft;
+    setCtrl(I, h2(Hash));
+    ++NumEntries;
+    return {I, true};
+  }
+
+  /// Like DenseMap, erasing does not invalidate iterators to other elements,
+  /// so it does not increment the epoch.
+  void eraseIndex(unsigned I) {
+    Buckets[I].getSecond().~ValueT();
+    Buckets[I].getFirst().~KeyT();
+    --NumEntries;
+
+    // If every window of Group::Width buckets that contains I also contains
+    // an empty bucket, no probe sequence ever continued past a full group
+    // covering I, and the bucket may become empty again instead of deleted.
+    unsigned Before = (I - Group::Width) & (NumBuckets - 1);
+    auto EmptyAfter = Group(Ctrl + I).matchEmpty();
+    auto EmptyBefore = Group(Ctrl + Before).matchEmpty();
+    bool WasNeverFull =
+        EmptyBefore && EmptyAfter &&
+        EmptyAfter.trailingEmpty() + EmptyBefore.leadingEmpty() <
+            Group::Width;
+    setCtrl(I, WasNeverFull ? detail::swissmap::CtrlEmpty
+                            : detail::swissmap::CtrlDeleted);
+    GrowthLeft += WasNeverFull;
+  }
+
+  /// Called when an insertion needs an empty bucket and none can be used up.
+  void rehashOrGrow() {
+    // If many of the used up buckets are only deleted, drop those instead of
+    // doubling the table.
+    if (NumBuckets > Group::Width &&
+        uint64_t(NumEntries) * 32 <= uint64_t(NumBuckets) * 25)
+      resize(NumBuckets);
+    else
+      resize(NumBuckets * 2);
+  }
+
+  void allocateBuckets(unsigned Num) {
+    NumBuckets = Num;
+    if (Num == 0) {
+      Buckets = nullptr;
+      Ctrl = nullptr;
+      GrowthLeft = 0;
+      return;
+    }
+    Buckets = static_cast<BucketT *>(
+        allocate_buffer(allocationSize(Num), allocationAlign()));
+    Ctrl = reinterpret_cast<int8_t *>(Buckets + Num);
+    std::memset(Ctrl, detail::swissmap::CtrlEmpty, Num + Group::Width);
+    GrowthLeft = maxLoad(Num);
+  }
+
+  void deallocateBuckets() {
+    if (NumBuckets)
+      deallocate_buffer(Buckets, allocationSize(NumBuckets), allocationAlign());
+  }
+
+  void destroyAll() {
+    if (std::is_trivially_destructible_v<KeyT> &&
+        std::is_trivially_destructible_v<ValueT>)
+      return;
+    for (unsigned I = 0; I != NumBuckets; ++I) {
+      if (Ctrl[I] >= 0) {
+        Buckets[I].getSecond().~ValueT();
+        Buckets[I].getFirst().~KeyT();
+      }
+    }
+  }
+
+  /// Move all entries into a fresh table of \p Num buckets, dropping deleted
+  /// buckets on the way.
+  void resize(unsigned Num) {
+    assert(isPowerOf2_32(Num) && Num >= Group::Width && "invalid table size");
+    BucketT *OldBuckets = Buckets;
+    int8_t *OldCtrl = Ctrl;
+    unsigned OldNumBuckets = NumBuckets;
+    allocateBuckets(Num);
+
+    for (unsigned I = 0; I != OldNumBuckets; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      BucketT &B = OldBuckets[I];
+      uint64_t Hash = hash(B.getFirst());
+      unsigned J = findFirstNonFull(Hash);
+      setCtrl(J, h2(Hash));
+      ::new (&Buckets[J].getFirst()) KeyT(std::move(B.getFirst()));
+      ::new (&Buckets[J].getSecond()) ValueT(std::move(B.getSecond()));
+      B.getSecond().~ValueT();
+      B.getFirst().~KeyT();
+    }
+    GrowthLeft -= NumEntries;
+
+    if (OldNumBuckets)
+      deallocate_buffer(OldBuckets, allocationSize(OldNumBuckets),
+                        allocationAlign());
+  }
+
+  void copyFrom(const SwissMap &Other) {
+    allocateBuckets(Other.NumBuckets);
+    NumEntries = Other.NumEntries;
+    GrowthLeft = Other.GrowthLeft;
+    if (!NumBuckets)
+      return;
+    std::memcpy(Ctrl, Other.Ctrl, NumBuckets + Group::Width);
+    for (unsigned I = 0; I != NumBuckets; ++I) {
+      if (Ctrl[I] >= 0) {
+        ::new (&Buckets[I].getFirst()) KeyT(Other.Buckets[I].getFirst());
+        ::new (&Buckets[I].getSecond()) ValueT(Other.Buckets[I].getSecond());
+      }
+    }
+  }
+
+  iterator makeIterator(unsigned I, bool NoAdvance = false) {
+    return iterator(Buckets + I, Ctrl + I, Buckets + NumBuckets, *this,
+                    NoAdvance);
+  }
+
+  const_iterator makeConstIterator(unsigned I, bool NoAdvance = false) const {
+    return const_iterator(Buckets + I, Ctrl + I, Buckets + NumBuckets, *this,
+                          NoAdvance);
+  }
+};
+
+template <typename KeyT, typename ValueT, typename KeyInfoT, typename Bucket,
+          bool IsConst>
+class SwissMapIterator : DebugEpochBase::HandleBase {
+  friend class SwissMapIterator<KeyT, ValueT, KeyInfoT, Bucket, true>;
+  friend class SwissMapIterator<KeyT, ValueT, KeyInfoT, Bucket, false>;
+  friend class SwissMap<KeyT, ValueT, KeyInfoT, Bucket>;
+
+public:
+  using difference_type = ptrdiff_t;
+  using value_type = std::conditional_t<IsConst, const Bucket, Bucket>;
+  using pointer = value_type *;
+  using reference = value_type &;
+  using iterator_category = std::forward_iterator_tag;
+
+private:
+  pointer Ptr = nullptr;
+  const int8_t *Ctrl = nullptr;
+  pointer End = nullptr;
+
+public:
+  SwissMapIterator() = default;
+
+  SwissMapIterator(pointer Pos, const int8_t *Ctrl, pointer E,
+                   const DebugEpochBase &Epoch, bool NoAdvance = false)
+      : DebugEpochBase::HandleBase(&Epoch), Ptr(Pos), Ctrl(Ctrl), End(E) {
+    assert(isHandleInSync() && "invalid construction!");
+    if (!NoAdvance)
+      advancePastNonFull();
+  }
+
+  // Converting ctor from non-const iterators to const iterators. SFINAE'd out
+  // for const iterator destinations so it doesn't end up as a user defined copy
+  // constructor.
+  template <bool IsConstSrc,
+            typename = std::enable_if_t<!IsConstSrc && IsConst>>
+  SwissMapIterator(
+      const SwissMapIterator<KeyT, ValueT, KeyInfoT, Bucket, IsConstSrc> &I)
+      : DebugEpochBase::HandleBase(I), Ptr(I.Ptr), Ctrl(I.Ctrl), End(I.End) {}
+
+  reference operator*() const {
+    assert(isHandleInSync() && "invalid iterator access!");
+    assert(Ptr != End && "dereferencing end() iterator");
+    return *Ptr;
+  }
+  pointer operator->() const { return &operator*(); }
+
+  friend bool operator==(const SwissMapIterator &LHS,
+                         const SwissMapIterator &RHS) {
+    assert((!LHS.Ptr || LHS.isHandleInSync()) && "handle not in sync!");
+    assert((!RHS.Ptr || RHS.isHandleInSync()) && "handle not in sync!");
+    assert(LHS.getEpochAddress() == RHS.getEpochAddress() &&
+           "comparing incomparable iterators!");
+    return LHS.Ptr == RHS.Ptr;
+  }
+
+  friend bool operator!=(const SwissMapIterator &LHS,
+                         const SwissMapIterator &RHS) {
+    return !(LHS == RHS);
+  }
+
+  SwissMapIterator &operator++() {
+    assert(isHandleInSync() && "invalid iterator access!");
+    assert(Ptr != End && "incrementing end() iterator");
+    ++Ptr;
+    ++Ctrl;
+    advancePastNonFull();
+    return *this;
+  }
+  SwissMapIterator operator++(int) {
+    assert(isHandleInSync() && "invalid iterator access!");
+    SwissMapIterator Tmp = *this;
+    ++*this;
+    return Tmp;
+  }
+
+private:
+  void advancePastNonFull() {
+    while (Ptr != End && *Ctrl < 0) {
+      ++Ptr;
+      ++Ctrl;
+    }
+  }
+};
+
+} // end namespace llvm
+
+#undef LLVM_SWISSMAP_SSE2
+
+#endif // LLVM_ADT_SWISSMAP_H
@@ -37,6 +37,7 @@
 #ifndef LLVM_ANALYSIS_ALIASANALYSIS_H
 #define LLVM_ANALYSIS_ALIASANALYSIS_H
 
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Sequence.h"
 #include "llvm/ADT/SmallVector.h"
@@ -624,6 +625,10 @@ class BatchAAResults {
   AAResults &AA;
   AAQueryInfo AAQI;
   SimpleCaptureInfo SimpleCI;
+  /// Underlying objects of the locations passed to aliasByObjects().
+  DenseMap<const Value *, const Value *> UnderlyingObjects;
+
+  const Value *getUnderlyingObject(const Value *V);
 
 public:
   BatchAAResults(AAResults &AAR) : AA(AAR), AAQI(AAR, &SimpleCI) {}
@@ -666,6 +671,17 @@ public:
     return AA.callCapturesBefore(I, MemLoc, DT, AAQI);
   }
 
+  /// Determine which of \p Locs are known not to alias \p Loc because they
+  /// are based on a different identified object, and set the corresponding
+  /// bits of \p NoAlias, which is resized to the number of locations. This
+  /// only implements the underlying-object check of alias(), so locations
+  /// whose bit is clear still have to be queried individually. Underlying
+  /// objects are cached for the lifetime of the batch, which makes checking
+  /// many locations against many others linear rather than quadratic in the
+  /// number of underlying object lookups.
+  void aliasByObjects(const MemoryLocation &Loc,
+                      ArrayRef<MemoryLocation> Locs, BitVector &NoAlias);
+
   /// Assume that values may come from different cycle iterations.
   void enableCrossIterationMode() {
     AAQI.MayBeCrossIteration = true;
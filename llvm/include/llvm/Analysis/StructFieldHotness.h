@@ -0,0 +1,35 @@
+//===- StructFieldHotness.h - Print struct field access hotness -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines a printer pass that reports, for every named struct type,
+// how often each of its fields is accessed, weighted by block frequency or
+// profile counts, and whether the struct looks like a candidate for hot/cold
+// field splitting.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ANALYSIS_STRUCTFIELDHOTNESS_H
+#define LLVM_ANALYSIS_STRUCTFIELDHOTNESS_H
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+class raw_ostream;
+
+class StructFieldHotnessPrinterPass
+    : public PassInfoMixin<StructFieldHotnessPrinterPass> {
+  raw_ostream &OS;
+
+public:
+  explicit StructFieldHotnessPrinterPass(raw_ostream &OS) : OS(OS) {}
+  PreservedAnalyses run(Module &M, ModuleAnalysisManager &AM);
+  static bool isRequired() { return true; }
+};
+} // end namespace llvm
+
+#endif // LLVM_ANALYSIS_STRUCTFIELDHOTNESS_H
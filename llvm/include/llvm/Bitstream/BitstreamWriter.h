@@ -102,6 +102,25 @@ class BitstreamWriter {
     Out.clear();
   }
 
+  /// Backpatch the size of the innermost block, which must end at the current
+  /// (32-bit aligned) position, and return to its parent.
+  void PopBlockScope() {
+    const Block &B = BlockScope.back();
+
+    // Compute the size of the block, in words, not counting the size field.
+    size_t SizeInWords = GetWordIndex() - B.StartSizeWord - 1;
+    uint64_t BitNo = uint64_t(B.StartSizeWord) * 32;
+
+    // Update the block size field in the header of this sub-block.
+    BackpatchWord(BitNo, SizeInWords);
+
+    // Restore the inner block's code size and abbrev table.
+    CurCodeSize = B.PrevCodeSize;
+    CurAbbrevs = std::move(B.PrevAbbrevs);
+    BlockScope.pop_back();
+    FlushToFile();
+  }
+
 public:
   /// Create a BitstreamWriter that writes to Buffer \p O.
   ///
@@ -316,25 +335,25 @@ public:
 
   void ExitBlock() {
     assert(!BlockScope.empty() && "Block scope imbalance!");
-    const Block &B = BlockScope.back();
 
     // Block tail:
     //    [END_BLOCK, <align4bytes>]
     EmitCode(bitc::END_BLOCK);
     FlushToWord();
-
-    // Compute the size of the block, in words, not counting the size field.
-    size_t SizeInWords = GetWordIndex() - B.StartSizeWord - 1;
-    uint64_t BitNo = uint64_t(B.StartSizeWord) * 32;
-
-    // Update the block size field in the header of this sub-block.
-    BackpatchWord(BitNo, SizeInWords);
-
-    // Restore the inner block's code size and abbrev table.
-    CurCodeSize = B.PrevCodeSize;
-    CurAbbrevs = std::move(B.PrevAbbrevs);
-    BlockScope.pop_back();
-    FlushToFile();
+    PopBlockScope();
+  }
+
+  /// Emit a block whose contents were encoded separately, e.g. by another
+  /// BitstreamWriter. \p Contents holds everything that follows the block
+  /// length word, up to and including the END_BLOCK marker and its padding.
+  /// It must have been encoded with the same abbreviations in scope, which is
+  /// the case if the other stream emitted the same BLOCKINFO_BLOCK.
+  void EmitEncodedBlock(unsigned BlockID, unsigned CodeLen,
+                        ArrayRef<char> Contents) {
+    assert((Contents.size() & 3) == 0 && "Block contents not 32-bit aligned");
+    EnterSubblock(BlockID, CodeLen);
+    Out.append(Contents.begin(), Contents.end());
+    PopBlockScope();
   }
 
   //===--------------------------------------------------------------------===//
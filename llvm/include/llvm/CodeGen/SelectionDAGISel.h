@@ -492,6 +492,13 @@ private:
   void SelectBasicBlock(BasicBlock::const_iterator Begin,
                         BasicBlock::const_iterator End,
                         bool &HadTailCall);
+
+  /// Like SelectBasicBlock, but build a separate DAG for every
+  /// -dag-isel-max-block-size instructions, so that the compile time of very
+  /// large blocks grows with the number of chunks rather than superlinearly.
+  void SelectBasicBlockInChunks(BasicBlock::const_iterator Begin,
+                                BasicBlock::const_iterator End,
+                                bool &HadTailCall);
   void FinishBasicBlock();
 
   void CodeGenAndEmitDAG();
@@ -92,6 +92,16 @@ public:
   void emit(std::unique_ptr<MaterializationResponsibility> R,
             ThreadSafeModule TSM) override;
 
+  /// Point the stub that calls to the function \p Name in \p TargetD go
+  /// through at \p NewAddr, e.g. at a copy of the function that has been
+  /// recompiled at a higher optimization level once it turned out to be hot.
+  /// The stub is updated atomically, so threads calling the function pick up
+  /// either the old or the new definition. This must not be called before the
+  /// function has been compiled for the first time, since compiling it points
+  /// the stub at the lazily compiled definition.
+  Error redirect(JITDylib &TargetD, const SymbolStringPtr &Name,
+                 ExecutorAddr NewAddr);
+
 private:
   struct PerDylibResources {
   public:
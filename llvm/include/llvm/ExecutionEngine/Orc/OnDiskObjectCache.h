@@ -0,0 +1,75 @@
+//===-- OnDiskObjectCache.h - Persistent cache of JIT'd objects -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that keeps compiled objects in a directory, so that they can
+// be reused by later processes that JIT the same modules.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/Error.h"
+#include <mutex>
+#include <string>
+
+namespace llvm {
+namespace orc {
+
+/// A content-addressed ObjectCache backed by a directory.
+///
+/// Objects are keyed by a hash of the module's bitcode (which records the
+/// producing LLVM version) and of the target triple, CPU, features and
+/// code generation options of the JITTargetMachineBuilder that the cache was
+/// created for. Clients that vary other TargetOptions between runs should use
+/// a separate cache directory for each configuration.
+///
+/// The directory is pruned according to the given CachePruningPolicy after
+/// objects are added to it. Failures to read or write cache entries are not
+/// reported: the module is simply compiled again.
+///
+/// The cache can be shared by concurrent compile threads, e.g. by passing it
+/// to a ConcurrentIRCompiler or to LLJITBuilder::setObjectCache.
+class OnDiskObjectCache : public ObjectCache {
+public:
+  /// Create a cache in CacheDir, creating the directory if necessary.
+  static Expected<std::unique_ptr<OnDiskObjectCache>>
+  Create(StringRef CacheDir, const JITTargetMachineBuilder &JTMB,
+         CachePruningPolicy Policy = CachePruningPolicy());
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+private:
+  OnDiskObjectCache(StringRef CacheDir, std::string TargetKey,
+                    CachePruningPolicy Policy)
+      : CacheDir(CacheDir), TargetKey(std::move(TargetKey)),
+        Policy(std::move(Policy)) {}
+
+  std::string computeKey(const Module &M) const;
+  std::string getEntryPath(StringRef Key) const;
+
+  std::string CacheDir;
+  std::string TargetKey;
+  CachePruningPolicy Policy;
+
+  // Keys of modules that missed in getObject, so that they are not computed
+  // again (from IR that codegen may have changed) when the object arrives.
+  std::mutex PendingKeysMutex;
+  DenseMap<const Module *, std::string> PendingKeys;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
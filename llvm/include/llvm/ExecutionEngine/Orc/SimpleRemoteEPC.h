@@ -93,13 +93,25 @@ public:
 
   void handleDisconnect(Error Err) override;
 
+  /// Create the memory manager that is used if the Setup object does not
+  /// provide one: an EPCGenericJITLinkMemoryManager, which sends the content
+  /// of every allocation to the executor through the transport.
+  static Expected<std::unique_ptr<jitlink::JITLinkMemoryManager>>
+  createDefaultMemoryManager(SimpleRemoteEPC &SREPC);
+
+  /// Create a memory manager that maps memory shared with the executor, so
+  /// that allocation content is written in place rather than sent through the
+  /// transport. Address space is reserved in slabs of SlabSize bytes. This
+  /// requires the executor to run on the same machine and to provide the
+  /// ExecutorSharedMemoryMapperService.
+  static Expected<std::unique_ptr<jitlink::JITLinkMemoryManager>>
+  createSharedMemoryManager(SimpleRemoteEPC &SREPC, size_t SlabSize);
+
 private:
   SimpleRemoteEPC(std::shared_ptr<SymbolStringPool> SSP,
                   std::unique_ptr<TaskDispatcher> D)
     : ExecutorProcessControl(std::move(SSP), std::move(D)) {}
 
-  static Expected<std::unique_ptr<jitlink::JITLinkMemoryManager>>
-  createDefaultMemoryManager(SimpleRemoteEPC &SREPC);
   static Expected<std::unique_ptr<MemoryAccess>>
   createDefaultMemoryAccess(SimpleRemoteEPC &SREPC);
 
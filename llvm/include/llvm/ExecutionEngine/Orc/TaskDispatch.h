@@ -129,6 +129,14 @@ private:
   std::optional<size_t> MaxMaterializationThreads;
   size_t NumMaterializationThreads = 0;
   std::deque<std::unique_ptr<Task>> MaterializationTaskQueue;
+
+  // Threads that are out of work wait a short while for more before exiting,
+  // so that a stream of small tasks doesn't start a thread for every task.
+  // Tasks handed to them are queued here, together with whether they are
+  // materialization tasks. There are never more of them than idle threads.
+  size_t NumIdleThreads = 0;
+  std::condition_variable IdleCV;
+  std::deque<std::pair<std::unique_ptr<Task>, bool>> IdleTaskQueue;
 };
 
 #endif // LLVM_ENABLE_THREADS
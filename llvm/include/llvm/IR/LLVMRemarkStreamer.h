@@ -33,10 +33,14 @@ class RemarkStreamer;
 /// objects.
 class LLVMRemarkStreamer {
   remarks::RemarkStreamer &RS;
-  /// Convert diagnostics into remark objects.
+  /// The remark that diagnostics are converted into. It is reused so that
+  /// emitting a remark does not allocate its arguments every time.
+  remarks::Remark Scratch;
+  /// Convert diagnostics into remark objects, overwriting \p R.
   /// The lifetime of the members of the result is bound to the lifetime of
   /// the LLVM diagnostics.
-  remarks::Remark toRemark(const DiagnosticInfoOptimizationBase &Diag) const;
+  void toRemark(const DiagnosticInfoOptimizationBase &Diag,
+                remarks::Remark &R) const;
 
 public:
   LLVMRemarkStreamer(remarks::RemarkStreamer &RS) : RS(RS) {}
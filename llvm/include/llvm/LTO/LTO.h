@@ -94,8 +94,11 @@ Expected<std::unique_ptr<ToolOutputFile>>
 setupStatsFile(StringRef StatsFilename);
 
 /// Produces a container ordering for optimal multi-threaded processing. Returns
-/// ordered indices to elements in the input array.
-std::vector<int> generateModulesOrdering(ArrayRef<BitcodeModule *> R);
+/// ordered indices to elements in the input array. If \p ImportedSizes is not
+/// empty, it holds for every element an estimate of the size of the bitcode
+/// its backend imports, which is added to the element's own size.
+std::vector<int> generateModulesOrdering(ArrayRef<BitcodeModule *> R,
+                                         ArrayRef<uint64_t> ImportedSizes = {});
 
 /// Updates MemProf attributes (and metadata) based on whether the index
 /// has recorded that we are linking with allocation libraries containing
@@ -104,6 +104,12 @@ public:
   /// if the Subtarget differs from the current fragment.
   MCDataFragment *getOrCreateDataFragment(const MCSubtargetInfo* STI = nullptr);
 
+  /// Encode \p Inst directly at the end of \p DF and append its fixups, with
+  /// their offsets made relative to the start of the fragment. Returns the
+  /// index of the first fixup of the instruction in \p DF.
+  unsigned encodeInstToData(MCDataFragment &DF, const MCInst &Inst,
+                            const MCSubtargetInfo &STI);
+
 protected:
   bool changeSectionImpl(MCSection *Section, const MCExpr *Subsection);
 
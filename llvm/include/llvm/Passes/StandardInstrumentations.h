@@ -15,21 +15,28 @@
 #ifndef LLVM_PASSES_STANDARDINSTRUMENTATIONS_H
 #define LLVM_PASSES_STANDARDINSTRUMENTATIONS_H
 
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StableHashing.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/CodeGen/MachineBasicBlock.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/OptBisect.h"
 #include "llvm/IR/PassTimingInfo.h"
+#include "llvm/IR/StructuralHash.h"
 #include "llvm/IR/ValueHandle.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Transforms/IPO/SampleProfileProbe.h"
 
+#include <chrono>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
@@ -482,6 +489,137 @@ private:
   void runAfterPass();
 };
 
+/// This class implements --analysis-reuse-file. It records the structural hash
+/// of every function that a function analysis is computed for, and at the end
+/// of its life-time reports how many of these computations a cache of
+/// analysis results keyed by the hash would have avoided, both within this
+/// process and across the earlier processes that recorded into the same file.
+class AnalysisReuseReporter {
+public:
+  AnalysisReuseReporter() = default;
+  ~AnalysisReuseReporter();
+  AnalysisReuseReporter(const AnalysisReuseReporter &) = delete;
+  void operator=(const AnalysisReuseReporter &) = delete;
+
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct AnalysisStats {
+    /// Hashes of the functions the analysis was computed for.
+    DenseSet<IRHash> Hashes;
+    unsigned Computed = 0;
+    /// Computations for a function with the same hash as an earlier one in
+    /// this process, or in the processes recorded in the file.
+    unsigned Repeated = 0;
+    unsigned RecordedEarlier = 0;
+    /// Time spent in the analysis, excluding the analyses it requested.
+    Clock::duration Time{};
+    Clock::duration RepeatedTime{};
+  };
+
+  struct Frame {
+    /// Null if the analysis is not run on a function.
+    AnalysisStats *Stats;
+    bool Repeated;
+    Clock::time_point Start;
+    Clock::duration ChildTime{};
+  };
+
+  void runBeforeAnalysis(StringRef PassID, Any IR);
+  void runAfterAnalysis();
+  void readFile();
+  void writeFile();
+  void printReport();
+
+  /// The (analysis, hash) pairs recorded by earlier processes.
+  StringMap<DenseSet<IRHash>> Recorded;
+  StringMap<AnalysisStats> Stats;
+  SmallVector<Frame, 4> Stack;
+  bool Enabled = false;
+};
+
+/// This class implements --incremental-reuse-file, which evaluates reusing
+/// the optimized form of a function on a rebuild. The key of a function
+/// combines the structural hash of its input IR, that of every defined
+/// function it may inline (its transitive direct callees), the target and
+/// the sequence of top-level passes. The instrumentation records the hash of
+/// the optimized function under that key, and reports for how many functions
+/// an earlier process recorded the same key, and whether it had produced the
+/// same optimized function: a different result means that the key misses an
+/// input, such as the callers that interprocedural passes look at.
+class IncrementalReuseReporter {
+public:
+  IncrementalReuseReporter() = default;
+  ~IncrementalReuseReporter();
+  IncrementalReuseReporter(const IncrementalReuseReporter &) = delete;
+  void operator=(const IncrementalReuseReporter &) = delete;
+
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  void runBeforePass(StringRef PassID, Any IR);
+  void runAfterPass(Any IR);
+  void computeKeys(const Module &M);
+
+  /// Nesting depth of the pass being run; top-level passes run at depth 0.
+  unsigned Depth = 0;
+  /// Hash of the names of the top-level passes run so far.
+  stable_hash PipelineHash = 0;
+  /// Key inputs of each function, computed before the first top-level pass.
+  StringMap<IRHash> InputHashes;
+  /// The names of the transitive defined direct callees of each function.
+  StringMap<SmallVector<std::string, 0>> Callees;
+  stable_hash TargetHash = 0;
+  /// Hashes of the functions after the last top-level pass.
+  StringMap<IRHash> OutputHashes;
+  bool Enabled = false;
+};
+
+/// This class implements --pass-cost-top: it keeps the N pass executions
+/// with the largest self time (excluding nested passes and analyses), along
+/// with the IR unit they ran on and its instruction count before and after,
+/// and writes them as JSON at the end of its life-time. Only a timestamp and
+/// an instruction count are taken for every pass, so that it can be enabled
+/// for large builds to find the functions that blow up compile time.
+class PassCostRecorder {
+public:
+  PassCostRecorder() = default;
+  ~PassCostRecorder();
+  PassCostRecorder(const PassCostRecorder &) = delete;
+  void operator=(const PassCostRecorder &) = delete;
+
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Frame {
+    Clock::time_point Start;
+    Clock::duration ChildTime{};
+    uint64_t SizeBefore;
+  };
+
+  struct Execution {
+    std::string PassID;
+    std::string IRName;
+    uint64_t SizeBefore;
+    /// Unknown if the pass deleted its IR unit.
+    std::optional<uint64_t> SizeAfter;
+    Clock::duration SelfTime;
+    Clock::duration Time;
+  };
+
+  void runBefore(Any IR);
+  void runAfter(StringRef PassID, Any IR);
+
+  SmallVector<Frame, 8> Stack;
+  /// A min-heap on SelfTime of the most expensive executions.
+  std::vector<Execution> Top;
+  unsigned N = 0;
+};
+
 // Class that holds transitions between basic blocks.  The transitions
 // are contained in a map of values to names of basic blocks.
 class DCData {
@@ -594,6 +732,9 @@ class StandardInstrumentations {
   PrintCrashIRInstrumentation PrintCrashIR;
   IRChangedTester ChangeTester;
   VerifyInstrumentation Verify;
+  AnalysisReuseReporter AnalysisReuse;
+  IncrementalReuseReporter IncrementalReuse;
+  PassCostRecorder PassCost;
 
   bool VerifyEach;
 
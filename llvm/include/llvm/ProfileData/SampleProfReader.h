@@ -592,6 +592,7 @@ public:
   /// It includes all the names that have samples either in outline instance
   /// or inline instance.
   std::vector<FunctionId> *getNameTable() override {
+    materializeNameTable();
     return &NameTable;
   }
 
@@ -654,6 +655,15 @@ protected:
   /// Function name table.
   std::vector<FunctionId> NameTable;
 
+  /// The fixed length MD5 name table in the profile, if that is what the last
+  /// name table was. Its entries are read when they are referenced instead of
+  /// being copied into NameTable up front.
+  const uint8_t *MD5NameMemStart = nullptr;
+  size_t MD5NameTableSize = 0;
+
+  /// Copy the entries of a fixed length MD5 name table into NameTable.
+  void materializeNameTable();
+
   /// CSNameTable is used to save full context vectors. It is the backing buffer
   /// for SampleContextFrames.
   std::vector<SampleContextFrameVector> CSNameTable;
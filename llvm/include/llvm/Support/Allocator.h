@@ -39,8 +39,93 @@ namespace detail {
 void printBumpPtrAllocatorStats(unsigned NumSlabs, size_t BytesAllocated,
                                 size_t TotalMemory);
 
+void *allocateSlab(size_t Size, size_t Alignment, bool HugePages);
+void deallocateSlab(void *Ptr, size_t Size, size_t Alignment, bool HugePages);
+
 } // end namespace detail
 
+/// A slab allocator for BumpPtrAllocatorImpl that keeps the slabs released
+/// by BumpPtrAllocatorImpl::Reset() and hands them out again, so an allocator
+/// reset between the phases of a long running tool does not go back to the
+/// system for every slab. Only slabs whose size is a power of two are kept,
+/// which covers the regular slabs of a BumpPtrAllocatorImpl with a power of
+/// two SlabSize but not the custom sized slabs of large allocations.
+///
+/// If \p HugePages is set, slabs are mapped with a transparent huge page hint.
+/// This is only useful with a SlabSize of at least the huge page size.
+///
+/// It is not thread safe; PerThreadAllocator gives every thread its own.
+template <bool HugePages = false>
+class RecyclingSlabAllocator
+    : public AllocatorBase<RecyclingSlabAllocator<HugePages>> {
+  struct CachedSlab {
+    void *Ptr;
+    size_t Size;
+    size_t Alignment;
+  };
+
+public:
+  RecyclingSlabAllocator() = default;
+  RecyclingSlabAllocator(RecyclingSlabAllocator &&Old)
+      : Cache(std::move(Old.Cache)), CachedBytes(Old.CachedBytes) {
+    Old.Cache.clear();
+    Old.CachedBytes = 0;
+  }
+  RecyclingSlabAllocator &operator=(RecyclingSlabAllocator &&RHS) {
+    releaseCachedSlabs();
+    Cache = std::move(RHS.Cache);
+    CachedBytes = RHS.CachedBytes;
+    RHS.Cache.clear();
+    RHS.CachedBytes = 0;
+    return *this;
+  }
+  ~RecyclingSlabAllocator() { releaseCachedSlabs(); }
+
+  LLVM_ATTRIBUTE_RETURNS_NONNULL void *Allocate(size_t Size,
+                                                size_t Alignment) {
+    for (size_t I = Cache.size(); I != 0; --I) {
+      CachedSlab &Slab = Cache[I - 1];
+      if (Slab.Size == Size && Slab.Alignment == Alignment) {
+        void *Ptr = Slab.Ptr;
+        Slab = Cache.back();
+        Cache.pop_back();
+        CachedBytes -= Size;
+        return Ptr;
+      }
+    }
+    return detail::allocateSlab(Size, Alignment, HugePages);
+  }
+
+  void Deallocate(const void *Ptr, size_t Size, size_t Alignment) {
+    if (isPowerOf2_64(Size)) {
+      Cache.push_back({const_cast<void *>(Ptr), Size, Alignment});
+      CachedBytes += Size;
+      return;
+    }
+    detail::deallocateSlab(const_cast<void *>(Ptr), Size, Alignment,
+                           HugePages);
+  }
+
+  // Pull in base class overloads.
+  using AllocatorBase<RecyclingSlabAllocator>::Allocate;
+  using AllocatorBase<RecyclingSlabAllocator>::Deallocate;
+
+  /// Return the cached slabs to the system.
+  void releaseCachedSlabs() {
+    for (CachedSlab &Slab : Cache)
+      detail::deallocateSlab(Slab.Ptr, Slab.Size, Slab.Alignment, HugePages);
+    Cache.clear();
+    CachedBytes = 0;
+  }
+
+  /// Return the number of bytes in cached slabs.
+  size_t getCachedBytes() const { return CachedBytes; }
+
+private:
+  SmallVector<CachedSlab, 0> Cache;
+  size_t CachedBytes = 0;
+};
+
 /// Allocate memory in an ever growing pool, as if by bump-pointer.
 ///
 /// This isn't strictly a bump-pointer allocator as it uses backing slabs of
@@ -0,0 +1,116 @@
+//===- AsyncFileLoader.h - Load files on a thread pool ----------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines AsyncFileLoader, which opens and reads files into
+/// MemoryBuffers on a thread pool, and PrefetchingFileSystem, a
+/// vfs::FileSystem serving the files it was asked to load ahead of time.
+///
+/// Tools that open many inputs can start loading all of them at once, so that
+/// the latency of opening, mapping and reading the files overlaps instead of
+/// adding up.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_ASYNCFILELOADER_H
+#define LLVM_SUPPORT_ASYNCFILELOADER_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/FunctionExtras.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+/// Loads files of a vfs::FileSystem on a thread pool. The file system must
+/// support concurrent reads, as the real file system does.
+class AsyncFileLoader {
+public:
+  using BufferOrError = ErrorOr<std::unique_ptr<MemoryBuffer>>;
+
+  explicit AsyncFileLoader(
+      IntrusiveRefCntPtr<vfs::FileSystem> FS = vfs::getRealFileSystem(),
+      ThreadPoolStrategy S = hardware_concurrency());
+
+  /// Waits for all pending loads.
+  ~AsyncFileLoader();
+
+  /// Start loading file \p Path.
+  std::future<BufferOrError> load(const Twine &Path,
+                                  bool RequiresNullTerminator = true,
+                                  bool IsVolatile = false);
+
+  /// Start loading all of \p Paths. The futures are in the order of \p Paths.
+  std::vector<std::future<BufferOrError>>
+  loadBatch(ArrayRef<std::string> Paths, bool RequiresNullTerminator = true,
+            bool IsVolatile = false);
+
+  /// Run \p Fn on the thread pool with the file system of the loader.
+  template <typename T>
+  std::future<T> run(unique_function<T(vfs::FileSystem &)> Fn) {
+    auto Promise = std::make_shared<std::promise<T>>();
+    std::future<T> Result = Promise->get_future();
+    auto Task =
+        std::make_shared<unique_function<T(vfs::FileSystem &)>>(std::move(Fn));
+    Pool.async([this, Promise, Task] { Promise->set_value((*Task)(*FS)); });
+    return Result;
+  }
+
+  /// Wait for all pending loads.
+  void wait() { Pool.wait(); }
+
+  vfs::FileSystem &getFileSystem() const { return *FS; }
+
+private:
+  IntrusiveRefCntPtr<vfs::FileSystem> FS;
+  DefaultThreadPool Pool;
+};
+
+/// A file system that opens and reads the files passed to prefetch() in the
+/// background. Opening one of them afterwards, with the same spelling of the
+/// path, returns a file whose first getBuffer() call returns the contents
+/// read in the background, after waiting for them if needed. Other calls go
+/// to the underlying file system.
+class PrefetchingFileSystem
+    : public RTTIExtends<PrefetchingFileSystem, vfs::ProxyFileSystem> {
+public:
+  static const char ID;
+
+  explicit PrefetchingFileSystem(IntrusiveRefCntPtr<vfs::FileSystem> FS,
+                                 ThreadPoolStrategy S = hardware_concurrency());
+
+  /// Start loading \p Paths. Paths that are already being loaded are ignored.
+  void prefetch(ArrayRef<std::string> Paths);
+
+  ErrorOr<std::unique_ptr<vfs::File>>
+  openFileForRead(const Twine &Path) override;
+
+private:
+  struct PrefetchedFile {
+    std::unique_ptr<vfs::File> File;
+    std::unique_ptr<MemoryBuffer> Buffer;
+  };
+
+  AsyncFileLoader Loader;
+  std::mutex Mutex;
+  StringMap<std::future<ErrorOr<PrefetchedFile>>> Pending;
+};
+
+} // namespace llvm
+
+#endif // LLVM_SUPPORT_ASYNCFILELOADER_H
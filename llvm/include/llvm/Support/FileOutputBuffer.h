@@ -76,6 +76,13 @@ public:
   /// but keeps the memory mapping alive.
   virtual void discard() {}
 
+  /// Hints that the bytes in [Offset, Offset + Size) have been written and
+  /// will not be modified again. A memory-mapped buffer may drop the pages
+  /// from the process's resident set, leaving their contents to the page
+  /// cache. The range can still be read and written, at the cost of
+  /// faulting the pages in again.
+  virtual void releaseRange(size_t Offset, size_t Size) {}
+
 protected:
   FileOutputBuffer(StringRef Path) : FinalPath(Path) {}
 
@@ -16,6 +16,7 @@
 #include "llvm/Support/Threading.h"
 
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
@@ -89,6 +90,9 @@ public:
 class TaskGroup {
   detail::Latch L;
   bool Parallel;
+  // Whether the group was created by a task of the default executor.
+  bool Nested;
+  std::atomic<bool> Cancelled{false};
 
 public:
   TaskGroup();
@@ -98,10 +102,20 @@ public:
   // Tasks marked with \p Sequential will be executed
   // exactly in the order which they were spawned.
   // Note: Sequential tasks may be executed on different
-  // threads, but strictly in sequential order.
+  // threads, but strictly in sequential order. In a nested
+  // group they are run immediately by the spawning thread.
   void spawn(std::function<void()> f, bool Sequential = false);
 
-  void sync() const { L.sync(); }
+  // Wait for all spawned tasks to finish. When called from a task of the
+  // default executor, the calling thread runs the pending tasks of this group
+  // while waiting.
+  void sync() const;
+
+  // Skip the tasks of this group that have not started yet. Running tasks
+  // may poll isCancelled() to stop early.
+  void cancel() { Cancelled = true; }
+
+  bool isCancelled() const { return Cancelled; }
 
   bool isParallel() const { return Parallel; }
 };
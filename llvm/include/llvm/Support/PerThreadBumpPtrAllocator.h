@@ -92,6 +92,12 @@ public:
     return BytesAllocated;
   }
 
+  /// Return the memory size used by all allocators that is not allocated,
+  /// i.e. the unused ends of slabs and alignment padding.
+  size_t getBytesWasted() const {
+    return getTotalMemory() - getBytesAllocated();
+  }
+
   /// Set red zone for all allocators.
   void setRedZoneSize(size_t NewSize) {
     for (size_t Idx = 0; Idx < getNumberOfAllocators(); Idx++)
@@ -114,6 +120,19 @@ protected:
 
 using PerThreadBumpPtrAllocator = PerThreadAllocator<BumpPtrAllocator>;
 
+/// A PerThreadBumpPtrAllocator whose slabs are kept by Reset() and reused by
+/// the following allocations of the same thread, for tools that allocate
+/// and reset in several parallel phases.
+using PerThreadRecyclingBumpPtrAllocator =
+    PerThreadAllocator<BumpPtrAllocatorImpl<RecyclingSlabAllocator<>>>;
+
+/// Like PerThreadRecyclingBumpPtrAllocator, but with 2MB slabs mapped with a
+/// transparent huge page hint, which reduces TLB misses for allocation heavy
+/// phases touching a lot of memory.
+using PerThreadHugePageBumpPtrAllocator = PerThreadAllocator<
+    BumpPtrAllocatorImpl<RecyclingSlabAllocator</*HugePages=*/true>,
+                         /*SlabSize=*/2 * 1024 * 1024>>;
+
 } // end namespace parallel
 } // end namespace llvm
 
@@ -124,7 +124,11 @@ public:
   /// A child existing on an unsigned integer implies that from the mapping
   /// represented by the current node, there is a way to reach another
   /// mapping by tacking that character on the end of the current string.
-  DenseMap<unsigned, SuffixTreeNode *> Children;
+  ///
+  /// Most internal nodes have only a few children, and a tree has about as
+  /// many internal nodes as the string has characters, so the first few
+  /// children are kept inline rather than in a separately allocated table.
+  SmallDenseMap<unsigned, SuffixTreeNode *, 4> Children;
 
   SuffixTreeInternalNode(unsigned StartIdx, unsigned EndIdx,
                          SuffixTreeInternalNode *Link)
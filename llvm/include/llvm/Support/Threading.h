@@ -129,6 +129,14 @@ constexpr bool llvm_is_multithreaded() { return LLVM_ENABLE_THREADS; }
     // threads, or hardware cores.
     bool Limit = false;
 
+    // If set, apply_thread_strategy() spreads the threads over the NUMA nodes
+    // and last level caches of the host and keeps each thread within its
+    // domain, on performance cores before efficiency cores of hybrid
+    // processors. Memory first touched by a thread, e.g. the slabs of a
+    // PerThreadBumpPtrAllocator, is then allocated on its node. Currently only
+    // implemented on Linux.
+    bool PinThreads = false;
+
     /// Retrieves the max available threads for the current strategy. This
     /// accounts for affinity masks and takes advantage of all CPU sockets.
     unsigned compute_thread_count() const;
@@ -55,6 +55,13 @@
 // Each new thread should begin with a timeTraceProfilerInitialize, and
 // finish with a timeTraceProfilerFinishThread call.
 //
+// For always-on use, timeTraceProfilerInitializeSampling starts the profiler
+// in sampling mode instead. Sections are then aggregated per stack of section
+// names without allocating, details are never computed, and only the most
+// recent sections are kept for timeTraceProfilerWrite, in a ring buffer of
+// fixed size. timeTraceProfilerWriteFoldedStacks writes the aggregate in the
+// folded stacks format of flame graph tools.
+//
 // Timestamps come from std::chrono::stable_clock. Note that threads need
 // not see the same time from that clock, and the resolution may not be
 // the best available.
@@ -81,6 +88,7 @@
 
 namespace llvm {
 
+class raw_ostream;
 class raw_pwrite_stream;
 
 struct TimeTraceProfiler;
@@ -94,6 +102,14 @@ struct TimeTraceProfilerEntry;
 void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
                                  StringRef ProcName);
 
+/// Initialize the time trace profiler in sampling mode. Sections shorter than
+/// \p TimeTraceGranularity microseconds are attributed to the enclosing
+/// section, and only the last \p RingBufferSize sections are kept for
+/// timeTraceProfilerWrite. Worker threads should use this function as well.
+void timeTraceProfilerInitializeSampling(unsigned TimeTraceGranularity,
+                                         unsigned RingBufferSize,
+                                         StringRef ProcName);
+
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
 
@@ -110,6 +126,13 @@ inline bool timeTraceProfilerEnabled() {
 /// https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview
 void timeTraceProfilerWrite(raw_pwrite_stream &OS);
 
+/// Write the time spent in each stack of section names, excluding nested
+/// sections, in the folded stacks format: one "outer;inner <microseconds>"
+/// line per stack, sorted by stack. Only sampling mode profilers contribute.
+/// The output of several processes can be merged by concatenating it and
+/// summing the values of identical stacks.
+void timeTraceProfilerWriteFoldedStacks(raw_ostream &OS);
+
 /// Write profiling data to a file.
 /// The function will write to \p PreferredFileName if provided, if not
 /// then will write to \p FallbackFileName appending .time-trace.
@@ -20,7 +20,6 @@
 #include <memory>
 #include <string>
 #include <system_error>
-#include <unordered_set>
 #include <utility>
 
 namespace llvm {
@@ -33,7 +32,9 @@ class FunctionImporter {
 public:
   /// Set of functions to import from a source module. Each entry is a set
   /// containing all the GUIDs of all functions to import for a source module.
-  using FunctionsToImportTy = std::unordered_set<GlobalValue::GUID>;
+  /// The thin link keeps one of these for every pair of importing and
+  /// exporting modules, so use a set with inline storage for the GUIDs.
+  using FunctionsToImportTy = DenseSet<GlobalValue::GUID>;
 
   /// The different reasons selectCallee will chose not to import a
   /// candidate.
@@ -131,6 +131,11 @@ struct Spec {
   // Profitability of the specialization.
   unsigned Score;
 
+  // Estimated code size added by the specialization, and estimated latency
+  // saved by each call to it.
+  unsigned CodeSize = 0;
+  unsigned Latency = 0;
+
   // List of call sites, matching this specialization.
   SmallVector<CallBase *> CallSites;
 
@@ -267,6 +272,8 @@ class FunctionSpecializer {
   DenseMap<Function *, CodeMetrics> FunctionMetrics;
   DenseMap<Function *, unsigned> FunctionGrowth;
   unsigned NGlobals = 0;
+  /// Estimated code size added by all specializations so far.
+  unsigned ModuleGrowth = 0;
 
 public:
   FunctionSpecializer(
@@ -303,6 +310,9 @@ private:
   /// Clean up fully specialized functions.
   void removeDeadFunctions();
 
+  /// Emit a remark for the specialization \p S, which has been created.
+  void emitRemark(const Spec &S);
+
   /// Remove any ssa_copy intrinsics that may have been introduced.
   void cleanUpSSA();
 
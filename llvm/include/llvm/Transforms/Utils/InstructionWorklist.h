@@ -29,6 +29,8 @@ class InstructionWorklist {
   /// combine has finished. This means that these instructions will be visited
   /// in the order they have been added.
   SmallSetVector<Instruction *, 16> Deferred;
+  /// Number of instructions that were pushed onto the worklist.
+  uint64_t NumPushes = 0;
 
 public:
   InstructionWorklist() = default;
@@ -62,6 +64,7 @@ public:
     if (WorklistMap.insert(std::make_pair(I, Worklist.size())).second) {
       LLVM_DEBUG(dbgs() << "ADD: " << *I << '\n');
       Worklist.push_back(I);
+      ++NumPushes;
     }
   }
 
@@ -76,6 +79,9 @@ public:
     return Deferred.pop_back_val();
   }
 
+  /// Return the number of instructions pushed onto the worklist so far.
+  uint64_t getNumPushes() const { return NumPushes; }
+
   void reserve(size_t Size) {
     Worklist.reserve(Size + 16);
     WorklistMap.reserve(Size);
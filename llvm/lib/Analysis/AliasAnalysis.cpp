@@ -697,6 +697,34 @@ ModRefInfo AAResults::callCapturesBefore(const Instruction *I,
   return R;
 }
 
+const Value *BatchAAResults::getUnderlyingObject(const Value *V) {
+  auto [It, Inserted] = UnderlyingObjects.try_emplace(V);
+  if (Inserted)
+    It->second = llvm::getUnderlyingObject(V);
+  return It->second;
+}
+
+void BatchAAResults::aliasByObjects(const MemoryLocation &Loc,
+                                    ArrayRef<MemoryLocation> Locs,
+                                    BitVector &NoAlias) {
+  NoAlias.clear();
+  NoAlias.resize(Locs.size());
+  if (!Loc.Ptr)
+    return;
+  const Value *Object = getUnderlyingObject(Loc.Ptr);
+  if (!isIdentifiedObject(Object))
+    return;
+  // Distinct identified objects never overlap, which is the same reasoning
+  // BasicAA applies after the pair cache lookup in alias().
+  for (auto [I, Other] : enumerate(Locs)) {
+    if (!Other.Ptr)
+      continue;
+    const Value *OtherObject = getUnderlyingObject(Other.Ptr);
+    if (OtherObject != Object && isIdentifiedObject(OtherObject))
+      NoAlias.set(I);
+  }
+}
+
 /// canBasicBlockModify - Return true if it is possible for execution of the
 /// specified basic block to modify the location Loc.
 ///
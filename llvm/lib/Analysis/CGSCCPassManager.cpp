@@ -25,6 +25,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
@@ -43,6 +44,11 @@ static cl::opt<bool> AbortOnMaxDevirtIterationsReached(
     cl::desc("Abort when the max iterations for devirtualization CGSCC repeat "
              "pass is reached"));
 
+static cl::opt<bool> ReportSCCParallelism(
+    "cgscc-report-parallelism", cl::Hidden,
+    cl::desc("Report how many SCCs a CGSCC pipeline could process concurrently "
+             "if the SCCs that do not depend on each other ran in parallel"));
+
 AnalysisKey ShouldNotRunFunctionPassesAnalysis::Key;
 
 // Explicit instantiations for the core proxy templates.
@@ -132,6 +138,66 @@ PassManager<LazyCallGraph::SCC, CGSCCAnalysisManager, LazyCallGraph &,
   return PA;
 }
 
+/// Print the amount of work that independent SCCs would allow to overlap. An
+/// SCC depends on the SCCs it has call edges to and on the RefSCCs it
+/// references, which must be visited first. The cost of an SCC is estimated by
+/// its instruction count, so the critical path is the most expensive chain of
+/// dependent SCCs.
+static void reportSCCParallelism(LazyCallGraph &CG) {
+  struct SCCInfo {
+    uint64_t Finish;
+    unsigned Level;
+  };
+  DenseMap<const LazyCallGraph::SCC *, SCCInfo> Info;
+  SmallVector<unsigned, 16> LevelWidths;
+  uint64_t TotalSize = 0, CriticalPath = 0;
+  unsigned NumSCCs = 0, NumRefSCCs = 0, CriticalLevels = 0;
+  for (LazyCallGraph::RefSCC &RC : CG.postorder_ref_sccs()) {
+    ++NumRefSCCs;
+    for (LazyCallGraph::SCC &C : RC) {
+      uint64_t Size = 0, Start = 0;
+      unsigned Level = 0;
+      for (LazyCallGraph::Node &N : C) {
+        Size += N.getFunction().getInstructionCount();
+        for (LazyCallGraph::Edge &E : *N) {
+          LazyCallGraph::SCC *Target = CG.lookupSCC(E.getNode());
+          if (!Target || Target == &C ||
+              (!E.isCall() && &Target->getOuterRefSCC() == &RC))
+            continue;
+          auto It = Info.find(Target);
+          if (It == Info.end())
+            continue;
+          Start = std::max(Start, It->second.Finish);
+          Level = std::max(Level, It->second.Level + 1);
+        }
+      }
+      Info[&C] = {Start + Size, Level};
+      if (LevelWidths.size() <= Level)
+        LevelWidths.resize(Level + 1);
+      ++LevelWidths[Level];
+      ++NumSCCs;
+      TotalSize += Size;
+      if (Start + Size > CriticalPath) {
+        CriticalPath = Start + Size;
+        CriticalLevels = Level + 1;
+      }
+    }
+  }
+
+  unsigned MaxWidth = 0;
+  for (unsigned Width : LevelWidths)
+    MaxWidth = std::max(MaxWidth, Width);
+  errs() << "CGSCC parallelism: " << NumSCCs << " SCCs in " << NumRefSCCs
+         << " RefSCCs, " << LevelWidths.size() << " levels, at most "
+         << MaxWidth << " SCCs per level; " << TotalSize
+         << " instructions, critical path " << CriticalPath
+         << " instructions through " << CriticalLevels << " SCCs";
+  if (CriticalPath)
+    errs() << format(", speedup bound %.2fx",
+                     double(TotalSize) / double(CriticalPath));
+  errs() << '\n';
+}
+
 PreservedAnalyses
 ModuleToPostOrderCGSCCPassAdaptor::run(Module &M, ModuleAnalysisManager &AM) {
   // Setup the CGSCC analysis manager from its proxy.
@@ -169,6 +235,8 @@ ModuleToPostOrderCGSCCPassAdaptor::run(Module &M, ModuleAnalysisManager &AM) {
 
   PreservedAnalyses PA = PreservedAnalyses::all();
   CG.buildRefSCCs();
+  if (ReportSCCParallelism)
+    reportSCCParallelism(CG);
   for (LazyCallGraph::RefSCC &RC :
        llvm::make_early_inc_range(CG.postorder_ref_sccs())) {
     assert(RCWorklist.empty() &&
@@ -2372,6 +2372,18 @@ bool LoopAccessInfo::canAnalyzeLoop() {
   // ScalarEvolution needs to be able to find the exit count.
   const SCEV *ExitCount = PSE->getBackedgeTakenCount();
   if (isa<SCEVCouldNotCompute>(ExitCount)) {
+    // Tell search loops, which are counted except for an exit that depends on
+    // the data, apart from loops whose trip count is unknown altogether.
+    SmallVector<BasicBlock *, 4> ExitingBlocks;
+    TheLoop->getExitingBlocks(ExitingBlocks);
+    BasicBlock *Latch = TheLoop->getLoopLatch();
+    if (ExitingBlocks.size() > 1 && Latch &&
+        !isa<SCEVCouldNotCompute>(PSE->getSE()->getExitCount(TheLoop, Latch))) {
+      recordAnalysis("UncountableEarlyExit")
+          << "loop has an early exit whose exit count cannot be computed";
+      LLVM_DEBUG(dbgs() << "LAA: loop has an uncountable early exit.\n");
+      return false;
+    }
     recordAnalysis("CantComputeNumberOfIterations")
         << "could not determine number of loop iterations";
     LLVM_DEBUG(dbgs() << "LAA: SCEV could not compute the loop exit count.\n");
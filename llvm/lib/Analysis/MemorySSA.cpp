@@ -1446,6 +1446,26 @@ void MemorySSA::OptimizeUses::optimizeUsesInBlock(
       LocInfo.LastKillValid = false;
       continue;
     }
+    // Rule out the plain stores to other identified objects above the lower
+    // bound with one batched query before walking the stack.
+    SmallVector<MemoryLocation, 16> StoreLocs;
+    SmallVector<unsigned long, 16> StorePositions;
+    if (!UseMLOC.IsCall && UseMLOC.getLoc().Ptr)
+      for (unsigned long I = UpperBound; I > LocInfo.LowerBound; --I) {
+        auto *MD = dyn_cast<MemoryDef>(VersionStack[I]);
+        if (!MD)
+          break;
+        if (auto *SI = dyn_cast<StoreInst>(MD->getMemoryInst()))
+          if (SI->isUnordered()) {
+            StoreLocs.push_back(MemoryLocation::get(SI));
+            StorePositions.push_back(I);
+          }
+      }
+    BitVector NoAliasStores;
+    if (!StoreLocs.empty())
+      AA->aliasByObjects(UseMLOC.getLoc(), StoreLocs, NoAliasStores);
+    auto *NextStore = StorePositions.begin();
+
     bool FoundClobberResult = false;
     unsigned UpwardWalkLimit = MaxCheckLimit;
     while (UpperBound > LocInfo.LowerBound) {
@@ -1466,6 +1486,15 @@ void MemorySSA::OptimizeUses::optimizeUsesInBlock(
       }
 
       MemoryDef *MD = cast<MemoryDef>(VersionStack[UpperBound]);
+      if (NextStore != StorePositions.end() && *NextStore == UpperBound) {
+        bool KnownNoAlias =
+            NoAliasStores.test(NextStore - StorePositions.begin());
+        ++NextStore;
+        if (KnownNoAlias) {
+          --UpperBound;
+          continue;
+        }
+      }
       if (instructionClobbersQuery(MD, MU, UseMLOC, *AA)) {
         FoundClobberResult = true;
         break;
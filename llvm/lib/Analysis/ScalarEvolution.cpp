@@ -142,6 +142,15 @@ STATISTIC(NumExitCountsNotComputed,
           "Number of loop exits without predictable exit counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumSCEVsCreated, "Number of SCEV expressions created");
+STATISTIC(NumSCEVCacheHits,
+          "Number of getSCEV queries answered from the value cache");
+STATISTIC(NumSCEVCacheMisses,
+          "Number of getSCEV queries that had to analyze the value");
+STATISTIC(NumSCEVsForgotten,
+          "Number of SCEV expressions whose cached results were dropped");
+STATISTIC(NumValuesForgotten,
+          "Number of values whose cached SCEV was dropped");
 
 #ifdef EXPENSIVE_CHECKS
 bool llvm::VerifySCEV = true;
@@ -484,6 +493,7 @@ const SCEV *ScalarEvolution::getConstant(ConstantInt *V) {
   if (const SCEV *S = UniqueSCEVs.FindNodeOrInsertPos(ID, IP)) return S;
   SCEV *S = new (SCEVAllocator) SCEVConstant(ID.Intern(SCEVAllocator), V);
   UniqueSCEVs.InsertNode(S, IP);
+  ++NumSCEVsCreated;
   return S;
 }
 
@@ -506,6 +516,7 @@ const SCEV *ScalarEvolution::getVScale(Type *Ty) {
     return S;
   SCEV *S = new (SCEVAllocator) SCEVVScale(ID.Intern(SCEVAllocator), Ty);
   UniqueSCEVs.InsertNode(S, IP);
+  ++NumSCEVsCreated;
   return S;
 }
 
@@ -1049,6 +1060,7 @@ const SCEV *ScalarEvolution::getLosslessPtrToIntExpr(const SCEV *Op,
     SCEV *S = new (SCEVAllocator)
         SCEVPtrToIntExpr(ID.Intern(SCEVAllocator), Op, IntPtrTy);
     UniqueSCEVs.InsertNode(S, IP);
+    ++NumSCEVsCreated;
     registerUser(S, Op);
     return S;
   }
@@ -1169,6 +1181,7 @@ const SCEV *ScalarEvolution::getTruncateExpr(const SCEV *Op, Type *Ty,
     SCEV *S =
         new (SCEVAllocator) SCEVTruncateExpr(ID.Intern(SCEVAllocator), Op, Ty);
     UniqueSCEVs.InsertNode(S, IP);
+    ++NumSCEVsCreated;
     registerUser(S, Op);
     return S;
   }
@@ -1222,6 +1235,7 @@ const SCEV *ScalarEvolution::getTruncateExpr(const SCEV *Op, Type *Ty,
   SCEV *S = new (SCEVAllocator) SCEVTruncateExpr(ID.Intern(SCEVAllocator),
                                                  Op, Ty);
   UniqueSCEVs.InsertNode(S, IP);
+  ++NumSCEVsCreated;
   registerUser(S, Op);
   return S;
 }
@@ -1594,6 +1608,7 @@ const SCEV *ScalarEvolution::getZeroExtendExprImpl(const SCEV *Op, Type *Ty,
     SCEV *S = new (SCEVAllocator) SCEVZeroExtendExpr(ID.Intern(SCEVAllocator),
                                                      Op, Ty);
     UniqueSCEVs.InsertNode(S, IP);
+    ++NumSCEVsCreated;
     registerUser(S, Op);
     return S;
   }
@@ -1878,6 +1893,7 @@ const SCEV *ScalarEvolution::getZeroExtendExprImpl(const SCEV *Op, Type *Ty,
   SCEV *S = new (SCEVAllocator) SCEVZeroExtendExpr(ID.Intern(SCEVAllocator),
                                                    Op, Ty);
   UniqueSCEVs.InsertNode(S, IP);
+  ++NumSCEVsCreated;
   registerUser(S, Op);
   return S;
 }
@@ -1935,6 +1951,7 @@ const SCEV *ScalarEvolution::getSignExtendExprImpl(const SCEV *Op, Type *Ty,
     SCEV *S = new (SCEVAllocator) SCEVSignExtendExpr(ID.Intern(SCEVAllocator),
                                                      Op, Ty);
     UniqueSCEVs.InsertNode(S, IP);
+    ++NumSCEVsCreated;
     registerUser(S, Op);
     return S;
   }
@@ -2141,6 +2158,7 @@ const SCEV *ScalarEvolution::getSignExtendExprImpl(const SCEV *Op, Type *Ty,
   SCEV *S = new (SCEVAllocator) SCEVSignExtendExpr(ID.Intern(SCEVAllocator),
                                                    Op, Ty);
   UniqueSCEVs.InsertNode(S, IP);
+  ++NumSCEVsCreated;
   registerUser(S, { Op });
   return S;
 }
@@ -2997,6 +3015,7 @@ ScalarEvolution::getOrCreateAddExpr(ArrayRef<const SCEV *> Ops,
     S = new (SCEVAllocator)
         SCEVAddExpr(ID.Intern(SCEVAllocator), O, Ops.size());
     UniqueSCEVs.InsertNode(S, IP);
+    ++NumSCEVsCreated;
     registerUser(S, Ops);
   }
   S->setNoWrapFlags(Flags);
@@ -3020,6 +3039,7 @@ ScalarEvolution::getOrCreateAddRecExpr(ArrayRef<const SCEV *> Ops,
     S = new (SCEVAllocator)
         SCEVAddRecExpr(ID.Intern(SCEVAllocator), O, Ops.size(), L);
     UniqueSCEVs.InsertNode(S, IP);
+    ++NumSCEVsCreated;
     LoopUsers[L].push_back(S);
     registerUser(S, Ops);
   }
@@ -3043,6 +3063,7 @@ ScalarEvolution::getOrCreateMulExpr(ArrayRef<const SCEV *> Ops,
     S = new (SCEVAllocator) SCEVMulExpr(ID.Intern(SCEVAllocator),
                                         O, Ops.size());
     UniqueSCEVs.InsertNode(S, IP);
+    ++NumSCEVsCreated;
     registerUser(S, Ops);
   }
   S->setNoWrapFlags(Flags);
@@ -3569,6 +3590,7 @@ const SCEV *ScalarEvolution::getUDivExpr(const SCEV *LHS,
   SCEV *S = new (SCEVAllocator) SCEVUDivExpr(ID.Intern(SCEVAllocator),
                                              LHS, RHS);
   UniqueSCEVs.InsertNode(S, IP);
+  ++NumSCEVsCreated;
   registerUser(S, {LHS, RHS});
   return S;
 }
@@ -3967,6 +3989,7 @@ const SCEV *ScalarEvolution::getMinMaxExpr(SCEVTypes Kind,
       SCEVMinMaxExpr(ID.Intern(SCEVAllocator), Kind, O, Ops.size());
 
   UniqueSCEVs.InsertNode(S, IP);
+  ++NumSCEVsCreated;
   registerUser(S, Ops);
   return S;
 }
@@ -4355,6 +4378,7 @@ ScalarEvolution::getSequentialMinMaxExpr(SCEVTypes Kind,
       SCEVSequentialMinMaxExpr(ID.Intern(SCEVAllocator), Kind, O, Ops.size());
 
   UniqueSCEVs.InsertNode(S, IP);
+  ++NumSCEVsCreated;
   registerUser(S, Ops);
   return S;
 }
@@ -4446,6 +4470,7 @@ const SCEV *ScalarEvolution::getUnknown(Value *V) {
                                             FirstUnknown);
   FirstUnknown = cast<SCEVUnknown>(S);
   UniqueSCEVs.InsertNode(S, IP);
+  ++NumSCEVsCreated;
   return S;
 }
 
@@ -4547,6 +4572,7 @@ void ScalarEvolution::eraseValueFromMap(Value *V) {
     (void) Removed;
     assert(Removed && "Value not in ExprValueMap?");
     ValueExprMap.erase(I);
+    ++NumValuesForgotten;
   }
 }
 
@@ -4566,8 +4592,11 @@ void ScalarEvolution::insertValueToMap(Value *V, const SCEV *S) {
 const SCEV *ScalarEvolution::getSCEV(Value *V) {
   assert(isSCEVable(V->getType()) && "Value is not SCEVable!");
 
-  if (const SCEV *S = getExistingSCEV(V))
+  if (const SCEV *S = getExistingSCEV(V)) {
+    ++NumSCEVCacheHits;
     return S;
+  }
+  ++NumSCEVCacheMisses;
   return createSCEVIter(V);
 }
 
@@ -13920,6 +13949,7 @@ void ScalarEvolution::forgetMemoizedResults(ArrayRef<const SCEV *> SCEVs) {
           Worklist.push_back(User);
   }
 
+  NumSCEVsForgotten += ToForget.size();
   for (const auto *S : ToForget)
     forgetMemoizedResultsImpl(S);
 
@@ -13950,8 +13980,10 @@ void ScalarEvolution::forgetMemoizedResultsImpl(const SCEV *S) {
   if (ExprIt != ExprValueMap.end()) {
     for (Value *V : ExprIt->second) {
       auto ValueIt = ValueExprMap.find_as(V);
-      if (ValueIt != ValueExprMap.end())
+      if (ValueIt != ValueExprMap.end()) {
         ValueExprMap.erase(ValueIt);
+        ++NumValuesForgotten;
+      }
     }
     ExprValueMap.erase(ExprIt);
   }
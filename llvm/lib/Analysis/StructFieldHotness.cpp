@@ -0,0 +1,152 @@
+//===- StructFieldHotness.cpp - Print struct field access hotness ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Every load and store whose address is a GEP into a named struct type is
+// attributed to the outermost field it accesses. Its weight is the profile
+// count of its block if the function has profile data, and the block's
+// frequency relative to the function entry otherwise. A struct larger than a
+// cache line whose few hottest fields take most of the accesses is reported as
+// a splitting candidate.
+//
+// This only describes the access pattern. Whether the layout of a struct is
+// observable (through casts, memcpy, external code or the ABI) is not checked,
+// so a candidate is not necessarily safe to split.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/StructFieldHotness.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <numeric>
+
+using namespace llvm;
+
+static cl::opt<unsigned> HotFieldCoverage(
+    "struct-field-hotness-coverage", cl::init(90), cl::Hidden,
+    cl::desc("Percentage of the accesses to a struct that its hot fields must "
+             "cover for it to be reported as a splitting candidate"));
+
+static cl::opt<unsigned> MaxHotFields(
+    "struct-field-hotness-max-hot-fields", cl::init(3), cl::Hidden,
+    cl::desc("Maximum number of hot fields of a splitting candidate"));
+
+namespace {
+struct StructAccesses {
+  SmallVector<double, 8> FieldWeights;
+  unsigned NumAccesses = 0;
+};
+} // namespace
+
+// Return the struct type and field index accessed through \p Ptr, if it is
+// a GEP of the form "gep %struct.T, ptr %p, i64 %i, i32 <field>, ...".
+static std::optional<std::pair<StructType *, unsigned>>
+getAccessedField(Value *Ptr) {
+  auto *GEP = dyn_cast<GetElementPtrInst>(Ptr);
+  if (!GEP || GEP->getNumIndices() < 2)
+    return std::nullopt;
+  auto *STy = dyn_cast<StructType>(GEP->getSourceElementType());
+  if (!STy || STy->isLiteral() || !STy->isSized())
+    return std::nullopt;
+  auto *Field = dyn_cast<ConstantInt>(GEP->getOperand(2));
+  if (!Field)
+    return std::nullopt;
+  return std::make_pair(STy, unsigned(Field->getZExtValue()));
+}
+
+PreservedAnalyses StructFieldHotnessPrinterPass::run(Module &M,
+                                                     ModuleAnalysisManager &AM) {
+  FunctionAnalysisManager &FAM =
+      AM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
+  const DataLayout &DL = M.getDataLayout();
+
+  MapVector<StructType *, StructAccesses> Structs;
+  for (Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    BlockFrequencyInfo *BFI = nullptr;
+    for (Instruction &I : instructions(F)) {
+      Value *Ptr = getLoadStorePointerOperand(&I);
+      if (!Ptr)
+        continue;
+      auto Access = getAccessedField(Ptr);
+      if (!Access)
+        continue;
+      if (!BFI)
+        BFI = &FAM.getResult<BlockFrequencyAnalysis>(F);
+      double Weight = double(BFI->getBlockFreq(I.getParent()).getFrequency()) /
+                      double(BFI->getEntryFreq().getFrequency());
+      if (F.getEntryCount())
+        Weight = BFI->getBlockProfileCount(I.getParent()).value_or(0);
+
+      auto [STy, Field] = *Access;
+      StructAccesses &SA = Structs[STy];
+      SA.FieldWeights.resize(STy->getNumElements());
+      SA.FieldWeights[Field] += Weight;
+      ++SA.NumAccesses;
+    }
+  }
+
+  OS << "Struct field hotness for module '" << M.getName() << "':\n";
+  for (auto &[STy, SA] : Structs) {
+    double Total = 0;
+    for (double W : SA.FieldWeights)
+      Total += W;
+    uint64_t Size = DL.getTypeAllocSize(STy);
+    OS << STy->getName() << ": " << Size << " bytes, "
+       << STy->getNumElements() << " fields, " << SA.NumAccesses
+       << " accesses, weight " << format("%.1f", Total) << '\n';
+    if (Total == 0) {
+      OS << "  not a candidate: no weighted accesses\n";
+      continue;
+    }
+
+    // Fields by decreasing weight, with the smallest set that covers the
+    // coverage threshold marked as hot.
+    SmallVector<unsigned, 8> Order(STy->getNumElements());
+    std::iota(Order.begin(), Order.end(), 0);
+    llvm::stable_sort(Order, [&](unsigned A, unsigned B) {
+      return SA.FieldWeights[A] > SA.FieldWeights[B];
+    });
+    const StructLayout *SL = DL.getStructLayout(STy);
+    unsigned NumHot = 0;
+    uint64_t HotSize = 0;
+    double Covered = 0;
+    for (unsigned Field : Order) {
+      double W = SA.FieldWeights[Field];
+      if (W == 0)
+        break;
+      bool Hot = Covered < Total * HotFieldCoverage / 100;
+      if (Hot) {
+        ++NumHot;
+        HotSize += DL.getTypeAllocSize(STy->getElementType(Field));
+        Covered += W;
+      }
+      OS << format("  field %u at offset %llu: %5.1f%%%s\n", Field,
+                   (unsigned long long)SL->getElementOffset(Field),
+                   100 * W / Total, Hot ? " hot" : "");
+    }
+
+    if (Size <= 64)
+      OS << "  not a candidate: fits in a cache line\n";
+    else if (NumHot > MaxHotFields)
+      OS << "  not a candidate: " << NumHot << " fields are needed to cover "
+         << HotFieldCoverage << "% of the accesses\n";
+    else
+      OS << "  candidate: " << NumHot << " hot fields in " << HotSize
+         << " of " << Size << " bytes\n";
+  }
+  return PreservedAnalyses::all();
+}
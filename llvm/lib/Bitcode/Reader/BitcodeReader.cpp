@@ -7290,7 +7290,15 @@ ModuleSummaryIndexBitcodeReader::makeCallList(ArrayRef<uint64_t> Record,
                                               bool IsOldProfileFormat,
                                               bool HasProfile, bool HasRelBF) {
   std::vector<FunctionSummary::EdgeTy> Ret;
-  Ret.reserve(Record.size());
+  // Every call takes one record entry for the callee, plus the hotness or
+  // relative block frequency if present. Reserving one edge per entry would
+  // keep up to twice the needed capacity for every summary in the index.
+  unsigned EntriesPerCall = 1;
+  if (IsOldProfileFormat)
+    EntriesPerCall += HasProfile ? 2 : 1;
+  else if (HasProfile || HasRelBF)
+    EntriesPerCall += 1;
+  Ret.reserve(Record.size() / EntriesPerCall);
   for (unsigned I = 0, E = Record.size(); I != E; ++I) {
     CalleeInfo::HotnessType Hotness = CalleeInfo::HotnessType::Unknown;
     bool HasTailCall = false;
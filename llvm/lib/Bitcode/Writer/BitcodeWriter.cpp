@@ -66,6 +66,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SHA1.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Triple.h"
@@ -95,6 +96,10 @@ static cl::opt<bool> WriteRelBFToSummary(
     "write-relbf-to-summary", cl::Hidden, cl::init(false),
     cl::desc("Write relative block frequency to function summary "));
 
+static cl::opt<bool> WriteFunctionsInParallel(
+    "bitcode-write-functions-in-parallel", cl::Hidden, cl::init(false),
+    cl::desc("Encode function blocks concurrently on the parallel executor"));
+
 namespace llvm {
 extern FunctionSummary::ForceSummaryHotnessType ForceSummaryEdgesCold;
 }
@@ -222,6 +227,13 @@ public:
         }
   }
 
+  /// Constructs a ModuleBitcodeWriterBase object that shares the numbering of
+  /// \p Parent, writing to \p Stream.
+  ModuleBitcodeWriterBase(const ModuleBitcodeWriterBase &Parent,
+                          BitstreamWriter &Stream)
+      : BitcodeWriterBase(Stream, Parent.StrtabBuilder), M(Parent.M),
+        VE(Parent.VE), Index(nullptr), GlobalValueId(Parent.GlobalValueId) {}
+
 protected:
   void writePerModuleGlobalValueSummary();
 
@@ -288,6 +300,14 @@ public:
         Buffer(Buffer), GenerateHash(GenerateHash), ModHash(ModHash),
         BitcodeStartBit(Stream.GetCurrentBitNo()) {}
 
+  /// Constructs a ModuleBitcodeWriter object that writes function blocks of
+  /// the module of \p Parent to the provided \p Buffer.
+  ModuleBitcodeWriter(const ModuleBitcodeWriter &Parent,
+                      SmallVectorImpl<char> &Buffer, BitstreamWriter &Stream)
+      : ModuleBitcodeWriterBase(Parent, Stream), Buffer(Buffer),
+        GenerateHash(false), ModHash(nullptr),
+        BitcodeStartBit(Stream.GetCurrentBitNo()) {}
+
   /// Emit the current module to the bitstream.
   void write();
 
@@ -413,6 +433,9 @@ private:
   void
   writeFunction(const Function &F,
                 DenseMap<const Function *, uint64_t> &FunctionToBitcodeIndex);
+  void writeFunctionBlockContents(const Function &F);
+  void writeFunctionsInParallel(
+      DenseMap<const Function *, uint64_t> &FunctionToBitcodeIndex);
   void writeBlockInfo();
   void writeModuleHash(size_t BlockStartPos);
 
@@ -3500,6 +3523,12 @@ void ModuleBitcodeWriter::writeFunction(
   FunctionToBitcodeIndex[&F] = Stream.GetCurrentBitNo();
 
   Stream.EnterSubblock(bitc::FUNCTION_BLOCK_ID, 4);
+  writeFunctionBlockContents(F);
+  Stream.ExitBlock();
+}
+
+/// Emit the records and nested blocks of a function block.
+void ModuleBitcodeWriter::writeFunctionBlockContents(const Function &F) {
   VE.incorporateFunction(F);
 
   SmallVector<unsigned, 64> Vals;
@@ -3665,7 +3694,77 @@ void ModuleBitcodeWriter::writeFunction(
   if (VE.shouldPreserveUseListOrder())
     writeUseListBlock(&F);
   VE.purgeFunction();
-  Stream.ExitBlock();
+}
+
+/// Emit the function bodies of the module, encoding groups of functions
+/// concurrently. Each group is written into a separate stream by a writer with
+/// its own copy of the enumerator; since the contents of a function block only
+/// depend on the module-level numbering and the blockinfo abbreviations, they
+/// can then be spliced into the module stream in order, producing the same
+/// output as writing them serially.
+void ModuleBitcodeWriter::writeFunctionsInParallel(
+    DenseMap<const Function *, uint64_t> &FunctionToBitcodeIndex) {
+  struct FunctionGroup {
+    SmallVector<const Function *, 0> Functions;
+    UseListOrderStack UseListOrders;
+    SmallVector<char, 0> Buffer;
+    // The byte range of each function block's contents in Buffer.
+    SmallVector<std::pair<size_t, size_t>, 0> Contents;
+  };
+
+  // Balance the groups by instruction count. Every group copies the
+  // enumerator, so create only a few per thread.
+  size_t NumInsts = 0;
+  for (const Function &F : M)
+    NumInsts += F.getInstructionCount();
+  size_t GroupSize =
+      NumInsts / (4 * parallel::strategy.compute_thread_count()) + 1;
+
+  SmallVector<FunctionGroup, 0> Groups;
+  size_t CurGroupSize = GroupSize;
+  for (const Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    if (CurGroupSize >= GroupSize) {
+      Groups.emplace_back();
+      CurGroupSize = 0;
+    }
+    FunctionGroup &G = Groups.back();
+    G.Functions.push_back(&F);
+    CurGroupSize += F.getInstructionCount();
+    // The use-list orders of the functions are on the stack in function order.
+    while (!VE.UseListOrders.empty() && VE.UseListOrders.back().F == &F) {
+      G.UseListOrders.push_back(std::move(VE.UseListOrders.back()));
+      VE.UseListOrders.pop_back();
+    }
+  }
+
+  parallelFor(0, Groups.size(), [&](size_t I) {
+    FunctionGroup &G = Groups[I];
+    BitstreamWriter GroupStream(G.Buffer);
+    ModuleBitcodeWriter Writer(*this, G.Buffer, GroupStream);
+    Writer.VE.UseListOrders.assign(
+        std::make_move_iterator(G.UseListOrders.rbegin()),
+        std::make_move_iterator(G.UseListOrders.rend()));
+    Writer.writeBlockInfo();
+    for (const Function *F : G.Functions) {
+      GroupStream.EnterSubblock(bitc::FUNCTION_BLOCK_ID, 4);
+      size_t Begin = G.Buffer.size();
+      Writer.writeFunctionBlockContents(*F);
+      GroupStream.ExitBlock();
+      G.Contents.emplace_back(Begin, G.Buffer.size());
+    }
+  });
+
+  for (FunctionGroup &G : Groups) {
+    for (auto [F, Range] : zip(G.Functions, G.Contents)) {
+      FunctionToBitcodeIndex[F] = Stream.GetCurrentBitNo();
+      Stream.EmitEncodedBlock(
+          bitc::FUNCTION_BLOCK_ID, 4,
+          ArrayRef(G.Buffer).slice(Range.first, Range.second - Range.first));
+    }
+    G.Buffer = {};
+  }
 }
 
 // Emit blockinfo, which defines the standard abbreviations etc.
@@ -4874,9 +4973,12 @@ void ModuleBitcodeWriter::write() {
 
   // Emit function bodies.
   DenseMap<const Function *, uint64_t> FunctionToBitcodeIndex;
-  for (const Function &F : M)
-    if (!F.isDeclaration())
-      writeFunction(F, FunctionToBitcodeIndex);
+  if (WriteFunctionsInParallel)
+    writeFunctionsInParallel(FunctionToBitcodeIndex);
+  else
+    for (const Function &F : M)
+      if (!F.isDeclaration())
+        writeFunction(F, FunctionToBitcodeIndex);
 
   // Need to write after the above call to WriteFunction which populates
   // the summary information in the index.
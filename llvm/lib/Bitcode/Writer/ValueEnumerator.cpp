@@ -500,6 +500,22 @@ ValueEnumerator::ValueEnumerator(const Module &M,
   organizeMetadata();
 }
 
+ValueEnumerator::ValueEnumerator(const ValueEnumerator &Other)
+    : TypeMap(Other.TypeMap), Types(Other.Types), ValueMap(Other.ValueMap),
+      Values(Other.Values), Comdats(Other.Comdats), MDs(Other.MDs),
+      FunctionMDs(Other.FunctionMDs), MetadataMap(Other.MetadataMap),
+      FunctionMDInfo(Other.FunctionMDInfo),
+      ShouldPreserveUseListOrder(Other.ShouldPreserveUseListOrder),
+      AttributeGroupMap(Other.AttributeGroupMap),
+      AttributeGroups(Other.AttributeGroups),
+      AttributeListMap(Other.AttributeListMap),
+      AttributeLists(Other.AttributeLists),
+      GlobalBasicBlockIDs(Other.GlobalBasicBlockIDs),
+      NumModuleValues(Other.NumModuleValues), NumModuleMDs(Other.NumModuleMDs),
+      NumMDStrings(Other.NumMDStrings) {
+  assert(Other.BasicBlocks.empty() && "Cannot copy in the middle of a function");
+}
+
 unsigned ValueEnumerator::getInstructionID(const Instruction *Inst) const {
   InstructionMapType::const_iterator I = InstructionMap.find(Inst);
   assert(I != InstructionMap.end() && "Instruction is not mapped!");
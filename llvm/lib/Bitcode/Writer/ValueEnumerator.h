@@ -139,7 +139,9 @@ private:
 
 public:
   ValueEnumerator(const Module &M, bool ShouldPreserveUseListOrder);
-  ValueEnumerator(const ValueEnumerator &) = delete;
+  /// Copy the module-level numbering of \p Other, but not its pending
+  /// use-list orders, so that function blocks can be written concurrently.
+  explicit ValueEnumerator(const ValueEnumerator &Other);
   ValueEnumerator &operator=(const ValueEnumerator &) = delete;
 
   void dump() const;
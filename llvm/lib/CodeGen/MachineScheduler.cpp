@@ -56,7 +56,9 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/GraphWriter.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -74,6 +76,8 @@ using namespace llvm;
 #define DEBUG_TYPE "machine-scheduler"
 
 STATISTIC(NumClustered, "Number of load/store pairs clustered");
+STATISTIC(NumHugeRegionsSkipped,
+          "Number of regions left unscheduled because of their size");
 
 namespace llvm {
 
@@ -152,6 +156,16 @@ static cl::opt<unsigned> SchedOnlyBlock("misched-only-block", cl::Hidden,
 static cl::opt<unsigned> ReadyListLimit("misched-limit", cl::Hidden,
   cl::desc("Limit ready list to N instructions"), cl::init(256));
 
+/// Building the dependence graph of a region costs more than linear time, so
+/// regions above this size keep their original order.
+static cl::opt<unsigned> MaxRegionInstrs("misched-max-region-instrs",
+  cl::Hidden, cl::init(0),
+  cl::desc("Leave regions with more than N instructions in their original "
+           "order (0 = no limit)"));
+
+static cl::opt<bool> PrintRegionTimes("misched-print-region-times", cl::Hidden,
+  cl::desc("Print the time spent scheduling every region"));
+
 static cl::opt<bool> EnableRegPressure("misched-regpressure", cl::Hidden,
   cl::desc("Enable register pressure scheduling."), cl::init(true));
 
@@ -660,9 +674,27 @@ void MachineSchedulerBase::scheduleRegions(ScheduleDAGInstrs &Scheduler,
         errs() << " " << MBB->getName() << " \n";
       }
 
+      if (MaxRegionInstrs && NumRegionInstrs > MaxRegionInstrs) {
+        LLVM_DEBUG(dbgs() << "Region too large, not scheduling it\n");
+        ++NumHugeRegionsSkipped;
+        Scheduler.exitRegion();
+        continue;
+      }
+
       // Schedule a region: possibly reorder instructions.
       // This invalidates the original region iterators.
+      TimeRecord Start;
+      if (PrintRegionTimes)
+        Start = TimeRecord::getCurrentTime(/*Start=*/true);
       Scheduler.schedule();
+      if (PrintRegionTimes) {
+        TimeRecord Elapsed = TimeRecord::getCurrentTime(/*Start=*/false);
+        Elapsed -= Start;
+        errs() << "misched region " << MF->getName() << ":"
+               << printMBBReference(*MBB) << " instrs " << NumRegionInstrs
+               << " time " << format("%.3f", Elapsed.getWallTime() * 1000)
+               << " ms\n";
+      }
 
       // Close the current region.
       Scheduler.exitRegion();
@@ -81,6 +81,11 @@ using namespace llvm;
 STATISTIC(NumGlobalSplits, "Number of split global live ranges");
 STATISTIC(NumLocalSplits,  "Number of split local live ranges");
 STATISTIC(NumEvicted,      "Number of interferences evicted");
+STATISTIC(NumSplitAttempts, "Number of attempts to split a live range");
+STATISTIC(NumEvictBudgetExceeded,
+          "Number of functions that exhausted the eviction budget");
+STATISTIC(NumSplitBudgetExceeded,
+          "Number of functions that exhausted the split budget");
 
 static cl::opt<SplitEditor::ComplementSpillMode> SplitSpillMode(
     "split-spill-mode", cl::Hidden,
@@ -127,6 +132,19 @@ static cl::opt<unsigned long> GrowRegionComplexityBudget(
              "limit its budget and bail out once we reach the limit."),
     cl::init(10000), cl::Hidden);
 
+static cl::opt<unsigned> EvictBudgetPerInstr(
+    "regalloc-evict-budget-per-instr",
+    cl::desc("Stop evicting interference for spillable live ranges after this "
+             "many evictions per instruction in the function (0 = no limit)"),
+    cl::init(16), cl::Hidden);
+
+static cl::opt<unsigned> SplitBudgetPerInstr(
+    "regalloc-split-budget-per-instr",
+    cl::desc("Spill spillable live ranges instead of splitting them after this "
+             "many split attempts per instruction in the function "
+             "(0 = no limit)"),
+    cl::init(4), cl::Hidden);
+
 static cl::opt<bool> GreedyRegClassPriorityTrumpsGlobalness(
     "greedy-regclass-priority-trumps-globalness",
     cl::desc("Change the greedy register allocator's live range priority "
@@ -515,6 +533,8 @@ void RAGreedy::evictInterference(const LiveInterval &VirtReg,
            "Cannot decrease cascade number, illegal eviction");
     ExtraInfo->setCascade(Intf->reg(), Cascade);
     ++NumEvicted;
+    if (EvictBudget && ++NumEvictionsInFunction == EvictBudget)
+      ++NumEvictBudgetExceeded;
     NewVRegs.push_back(Intf->reg());
   }
 }
@@ -2440,10 +2460,18 @@ MCRegister RAGreedy::selectOrSplitImpl(const LiveInterval &VirtReg,
   LLVM_DEBUG(dbgs() << StageName[Stage] << " Cascade "
                     << ExtraInfo->getCascade(VirtReg.reg()) << '\n');
 
+  // Once the eviction or split budget of a huge function is spent, ranges that
+  // can be spilled skip the corresponding step, so that long eviction chains
+  // and repeated splitting degrade to spilling instead.
+  bool CanEvict = !EvictBudget || NumEvictionsInFunction < EvictBudget ||
+                  !VirtReg.isSpillable();
+  bool CanSplit = !SplitBudget || NumSplitAttemptsInFunction < SplitBudget ||
+                  !VirtReg.isSpillable();
+
   // Try to evict a less worthy live range, but only for ranges from the primary
   // queue. The RS_Split ranges already failed to do this, and they should not
   // get a second chance until they have been split.
-  if (Stage != RS_Split)
+  if (Stage != RS_Split && CanEvict)
     if (Register PhysReg =
             tryEvict(VirtReg, Order, NewVRegs, CostPerUseLimit,
                      FixedRegisters)) {
@@ -2470,7 +2498,10 @@ MCRegister RAGreedy::selectOrSplitImpl(const LiveInterval &VirtReg,
     return 0;
   }
 
-  if (Stage < RS_Spill) {
+  if (Stage < RS_Spill && CanSplit) {
+    ++NumSplitAttempts;
+    if (SplitBudget && ++NumSplitAttemptsInFunction == SplitBudget)
+      ++NumSplitBudgetExceeded;
     // Try splitting VirtReg or interferences.
     unsigned NewVRegSizeBefore = NewVRegs.size();
     Register PhysReg = trySplit(VirtReg, Order, NewVRegs, FixedRegisters);
@@ -2749,6 +2780,11 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
                                : TRI->reverseLocalAssignment();
 
   ExtraInfo.emplace();
+  uint64_t NumInstrs = MF->getInstructionCount();
+  EvictBudget = uint64_t(EvictBudgetPerInstr) * NumInstrs;
+  SplitBudget = uint64_t(SplitBudgetPerInstr) * NumInstrs;
+  NumEvictionsInFunction = 0;
+  NumSplitAttemptsInFunction = 0;
   EvictAdvisor =
       getAnalysis<RegAllocEvictionAdvisorAnalysis>().getAdvisor(*MF, *this);
   PriorityAdvisor =
@@ -280,6 +280,13 @@ private:
 
   bool ReverseLocalAssignment = false;
 
+  /// The number of evictions and split attempts allowed in this function
+  /// before spillable ranges go straight to the spiller, 0 when unlimited.
+  uint64_t EvictBudget = 0;
+  uint64_t SplitBudget = 0;
+  uint64_t NumEvictionsInFunction = 0;
+  uint64_t NumSplitAttemptsInFunction = 0;
+
 public:
   RAGreedy(const RegClassFilterFunc F = allocateAllRegClasses);
 
@@ -91,6 +91,9 @@ STATISTIC(OpsNarrowed     , "Number of load/op/store narrowed");
 STATISTIC(LdStFP2Int      , "Number of fp load/store pairs transformed to int");
 STATISTIC(SlicedLoads, "Number of load sliced");
 STATISTIC(NumFPLogicOpsConv, "Number of logic ops converted to fp ops");
+STATISTIC(NodesVisited, "Number of dag nodes visited by the combiner");
+STATISTIC(NumWorklistLimitReached,
+          "Number of combiner runs stopped by the worklist limit");
 
 DEBUG_COUNTER(DAGCombineCounter, "dagcombine",
               "Controls whether a DAG combine is performed for a node");
@@ -135,6 +138,12 @@ static cl::opt<unsigned> StoreMergeDependenceLimit(
     cl::desc("Limit the number of times for the same StoreNode and RootNode "
              "to bail out in store merging dependence check"));
 
+static cl::opt<unsigned> CombinerWorklistLimit(
+    "combiner-worklist-limit", cl::Hidden, cl::init(0),
+    cl::desc("Stop a DAG combine before the DAG is legalized after visiting "
+             "this many nodes times the number of nodes in the DAG "
+             "(0 = no limit)"));
+
 static cl::opt<bool> EnableReduceLoadOpStoreWidth(
     "combiner-reduce-load-op-store-width", cl::Hidden, cl::init(true),
     cl::desc("DAG combiner enable reducing the width of load/op/store "
@@ -1709,8 +1718,22 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
   // changes of the root.
   HandleSDNode Dummy(DAG.getRoot());
 
+  // Combines are optional until the DAG has been legalized; after that, nodes
+  // created by a combine are only legalized when they are visited.
+  uint64_t MaxVisits = LegalDAG ? 0
+                                : uint64_t(CombinerWorklistLimit) *
+                                      std::max<size_t>(DAG.allnodes_size(), 1);
+  uint64_t Visits = 0;
+
   // While we have a valid worklist entry node, try to combine it.
   while (SDNode *N = getNextWorklistEntry()) {
+    if (MaxVisits && ++Visits > MaxVisits) {
+      ++NumWorklistLimitReached;
+      LLVM_DEBUG(dbgs() << "\nCombiner worklist limit reached\n");
+      break;
+    }
+    ++NodesVisited;
+
     // If N has no uses, it is dead.  Make sure to revisit all N's operands once
     // N is deleted from the DAG, since they too may now be dead or may have a
     // reduced number of uses, allowing other xforms.
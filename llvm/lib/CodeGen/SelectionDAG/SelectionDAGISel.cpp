@@ -122,6 +122,8 @@ STATISTIC(NumFastIselBlocks, "Number of blocks selected entirely by fast isel");
 STATISTIC(NumDAGBlocks, "Number of blocks selected using DAG");
 STATISTIC(NumDAGIselRetries,"Number of times dag isel has to try another path");
 STATISTIC(NumEntryBlocks, "Number of entry blocks encountered");
+STATISTIC(NumDAGBlockChunks,
+          "Number of additional DAGs built to select large blocks");
 STATISTIC(NumFastIselFailLowerArguments,
           "Number of entry blocks where fast isel failed to lower arguments");
 
@@ -138,6 +140,11 @@ static cl::opt<bool> EnableFastISelFallbackReport(
     cl::desc("Emit a diagnostic when \"fast\" instruction selection "
              "falls back to SelectionDAG."));
 
+static cl::opt<unsigned> MaxDAGBlockSize(
+    "dag-isel-max-block-size", cl::Hidden, cl::init(0),
+    cl::desc("Select blocks with more instructions than this as several "
+             "consecutive DAGs (0 = no limit)"));
+
 static cl::opt<bool>
 UseMBPI("use-mbpi",
         cl::desc("use Machine Branch Probability Info"),
@@ -738,6 +745,78 @@ void SelectionDAGISel::SelectBasicBlock(BasicBlock::const_iterator Begin,
   CodeGenAndEmitDAG();
 }
 
+void SelectionDAGISel::SelectBasicBlockInChunks(BasicBlock::const_iterator Begin,
+                                                BasicBlock::const_iterator End,
+                                                bool &HadTailCall) {
+  // Number the instructions and pick the chunk boundaries. A token cannot be
+  // passed between DAGs in a virtual register, so no boundary separates a
+  // token from its users. Swifterror values are tracked per DAG as well, so
+  // blocks that use them are selected as a whole.
+  DenseMap<const Instruction *, unsigned> Index;
+  unsigned N = 0;
+  for (BasicBlock::const_iterator I = Begin; I != End; ++I) {
+    for (const Value *Op : I->operands())
+      if (Op->isSwiftError())
+        return SelectBasicBlock(Begin, End, HadTailCall);
+    Index[&*I] = N++;
+  }
+
+  SmallVector<unsigned, 8> ChunkStarts = {0};
+  SmallVector<BasicBlock::const_iterator, 8> ChunkBegins = {Begin};
+  unsigned TokenUsedUntil = 0;
+  for (BasicBlock::const_iterator I = Begin; I != End; ++I) {
+    unsigned Idx = Index[&*I];
+    if (I->getType()->isTokenTy())
+      for (const User *U : I->users())
+        if (const auto *UI = dyn_cast<Instruction>(U)) {
+          auto It = Index.find(UI);
+          if (It != Index.end())
+            TokenUsedUntil = std::max(TokenUsedUntil, It->second);
+        }
+    if (Idx + 1 < N && Idx + 1 - ChunkStarts.back() >= MaxDAGBlockSize &&
+        Idx >= TokenUsedUntil) {
+      ChunkStarts.push_back(Idx + 1);
+      ChunkBegins.push_back(std::next(I));
+    }
+  }
+  if (ChunkStarts.size() == 1)
+    return SelectBasicBlock(Begin, End, HadTailCall);
+
+  // Values used by a later chunk are exported in virtual registers, like the
+  // values used by other blocks.
+  auto ChunkOf = [&](unsigned Idx) {
+    return std::prev(llvm::upper_bound(ChunkStarts, Idx)) -
+           ChunkStarts.begin();
+  };
+  for (BasicBlock::const_iterator I = Begin; I != End; ++I) {
+    if (I->getType()->isVoidTy() || I->getType()->isTokenTy() ||
+        FuncInfo->ValueMap.count(&*I))
+      continue;
+    if (const auto *AI = dyn_cast<AllocaInst>(I))
+      if (FuncInfo->StaticAllocaMap.count(AI))
+        continue;
+    auto DefChunk = ChunkOf(Index[&*I]);
+    bool UsedLater = any_of(I->users(), [&](const User *U) {
+      const auto *UI = dyn_cast<Instruction>(U);
+      if (!UI || isa<PHINode>(UI))
+        return false;
+      auto It = Index.find(UI);
+      return It != Index.end() && ChunkOf(It->second) > DefChunk;
+    });
+    if (UsedLater)
+      FuncInfo->ValueMap[&*I] = FuncInfo->CreateRegs(&*I);
+  }
+
+  NumDAGBlockChunks += ChunkBegins.size() - 1;
+  for (unsigned C = 0, E = ChunkBegins.size(); C != E; ++C) {
+    BasicBlock::const_iterator ChunkEnd = C + 1 < E ? ChunkBegins[C + 1] : End;
+    SelectBasicBlock(ChunkBegins[C], ChunkEnd, HadTailCall);
+    // The rest of the block is dead after a tail call.
+    if (HadTailCall)
+      return;
+  }
+}
+
 void SelectionDAGISel::ComputeLiveOutVRegInfo() {
   SmallPtrSet<SDNode *, 16> Added;
   SmallVector<SDNode*, 128> Worklist;
@@ -1749,7 +1828,14 @@ void SelectionDAGISel::SelectAllBasicBlocks(const Function &Fn) {
       // not handled by FastISel. If FastISel is not run, this is the entire
       // block.
       bool HadTailCall;
-      SelectBasicBlock(Begin, BI, HadTailCall);
+      // Arguments are lowered into the DAG of the entry block, and landing
+      // pads set up their exception registers in the first one, so neither is
+      // split.
+      if (!FastIS && MaxDAGBlockSize && LLVMBB != &Fn.getEntryBlock() &&
+          !LLVMBB->isEHPad())
+        SelectBasicBlockInChunks(Begin, BI, HadTailCall);
+      else
+        SelectBasicBlock(Begin, BI, HadTailCall);
 
       // But if FastISel was run, we already selected some of the block.
       // If we emitted a tail-call, we need to delete any previously emitted
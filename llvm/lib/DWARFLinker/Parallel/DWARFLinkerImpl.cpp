@@ -1403,11 +1403,17 @@ void DWARFLinkerImpl::cleanupDataAfterDWARFOutputIsWritten() {
 }
 
 void DWARFLinkerImpl::writeCompileUnitsToTheOutput() {
-  // Enumerate all sections and store them into the final emitter.
+  // Enumerate all sections and store them into the final emitter. The handler
+  // copies the contents, so release them right away rather than keeping a
+  // second copy of the whole output alive until the end. The statistics need
+  // the size of .debug_info afterwards.
+  bool KeepContents = GlobalData.getOptions().Statistics;
   forEachObjectSectionsSet([&](OutputSections &Sections) {
     Sections.forEach([&](std::shared_ptr<SectionDescriptor> OutSection) {
       // Emit section content.
       SectionHandler(OutSection);
+      if (!KeepContents)
+        OutSection->clearSectionContent();
     });
   });
 }
@@ -1415,5 +1421,6 @@ void DWARFLinkerImpl::writeCompileUnitsToTheOutput() {
 void DWARFLinkerImpl::writeCommonSectionsToTheOutput() {
   CommonSections.forEach([&](std::shared_ptr<SectionDescriptor> OutSection) {
     SectionHandler(OutSection);
+    OutSection->clearSectionContent();
   });
 }
@@ -134,8 +134,10 @@ public:
     if (DIE)
       return DIE;
 
+    // A weak exchange may fail spuriously, which would leave DIE null, so use
+    // a strong one: on failure, DIE is the body another thread installed.
     TypeEntryBody *NewDIE = TypeEntryBody::create(Allocator);
-    if (Entry->getValue().compare_exchange_weak(DIE, NewDIE)) {
+    if (Entry->getValue().compare_exchange_strong(DIE, NewDIE)) {
       ParentEntry->getValue().load()->Children.add(Entry);
       return NewDIE;
     }
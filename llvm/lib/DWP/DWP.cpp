@@ -633,12 +633,13 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
 
   DWPStringPool Strings(Out, StrSection);
 
-  SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
-  Objects.reserve(Inputs.size());
-
+  // Only one input is kept in memory at a time: everything taken from it is
+  // either emitted, which copies it into the output, or copied into the string
+  // pool and the index entries before the next input is opened.
   std::deque<SmallString<32>> UncompressedSections;
 
   for (const auto &Input : Inputs) {
+    UncompressedSections.clear();
     auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
     if (!ErrOrObj) {
       return handleErrors(ErrOrObj.takeError(),
@@ -647,8 +648,8 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
                           });
     }
 
-    auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+    OwningBinary<object::ObjectFile> Object = std::move(*ErrOrObj);
+    auto &Obj = *Object.getBinary();
 
     UnitIndexEntry CurEntry = {};
 
@@ -750,6 +750,11 @@ void DWARFUnit::updateAddressDieMap(DWARFDie Die) {
       }
     } else
       llvm::consumeError(DIERangesOrError.takeError());
+    // Neither an abstract instance tree nor a declaration describes any
+    // addresses, and in optimized C++ code the abstract instances of inlined
+    // functions make up a good part of the unit, so don't walk them.
+    if (Die.find({DW_AT_inline, DW_AT_declaration}))
+      return;
   }
   // Parent DIEs are added to the AddrDieMap prior to the Children DIEs to
   // simplify the logic to update AddrDieMap. The child's range will always
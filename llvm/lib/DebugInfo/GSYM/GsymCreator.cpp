@@ -228,11 +228,16 @@ llvm::Error GsymCreator::finalize(OutputAggregator &Out) {
     if (NumBefore > 1) {
       // Sort function infos so we can emit sorted functions.
       llvm::sort(Funcs);
-      std::vector<FunctionInfo> FinalizedFuncs;
-      FinalizedFuncs.reserve(Funcs.size());
-      FinalizedFuncs.emplace_back(std::move(Funcs.front()));
+      // Remove the entries in place: with a second vector, every function
+      // info would exist twice at the peak, which for large binaries is a
+      // significant part of the memory needed to create the GSYM file.
+      size_t Last = 0;
+      auto Keep = [&](FunctionInfo &FI) {
+        if (++Last != static_cast<size_t>(&FI - Funcs.data()))
+          Funcs[Last] = std::move(FI);
+      };
       for (size_t Idx=1; Idx < NumBefore; ++Idx) {
-        FunctionInfo &Prev = FinalizedFuncs.back();
+        FunctionInfo &Prev = Funcs[Last];
         FunctionInfo &Curr = Funcs[Idx];
         // Empty ranges won't intersect, but we still need to
         // catch the case where we have multiple symbols at the
@@ -271,7 +276,7 @@ llvm::Error GsymCreator::finalize(OutputAggregator &Out) {
                 << Prev << "\n"
                 << Curr << "\n";
             });
-            FinalizedFuncs.emplace_back(std::move(Curr));
+            Keep(Curr);
           }
         } else {
           if (Prev.Range.size() == 0 && Curr.Range.contains(Prev.Range.start())) {
@@ -280,11 +285,11 @@ llvm::Error GsymCreator::finalize(OutputAggregator &Out) {
             // symbol function info with the current one.
             std::swap(Prev, Curr);
           } else {
-            FinalizedFuncs.emplace_back(std::move(Curr));
+            Keep(Curr);
           }
         }
       }
-      std::swap(Funcs, FinalizedFuncs);
+      Funcs.erase(Funcs.begin() + Last + 1, Funcs.end());
     }
     // If our last function info entry doesn't have a size and if we have valid
     // text ranges, we should set the size of the last entry since any search for
@@ -14,6 +14,9 @@
 #define LIB_EXECUTIONENGINE_JITLINK_JITLINKGENERIC_H
 
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Parallel.h"
+
+#include <mutex>
 
 #define DEBUG_TYPE "jitlink"
 
@@ -129,49 +132,81 @@ private:
     return static_cast<const LinkerImpl &>(*this);
   }
 
+  // Graphs with at least this many blocks are fixed up in parallel.
+  static constexpr size_t ParallelFixUpThreshold = 1024;
+
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    std::vector<Block *> Blocks;
     for (auto &Sec : G.sections()) {
       bool NoAllocSection = Sec.getMemLifetime() == orc::MemLifetime::NoAlloc;
 
       for (auto *B : Sec.blocks()) {
-        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-        // Copy Block data and apply fixups.
-        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
-        assert((!B->isZeroFill() || all_of(B->edges(),
-                                           [](const Edge &E) {
-                                             return E.getKind() ==
-                                                    Edge::KeepAlive;
-                                           })) &&
-               "Non-KeepAlive edges in zero-fill block?");
-
         // If this is a no-alloc section then copy the block content into
         // memory allocated on the Graph's allocator (if it hasn't been
-        // already).
+        // already). The allocator is not thread safe, so this is done before
+        // any fixups are applied.
         if (NoAllocSection)
           (void)B->getMutableContent(G);
+        Blocks.push_back(B);
+      }
+    }
 
-        for (auto &E : B->edges()) {
-
-          // Skip non-relocation edges.
-          if (!E.isRelocation())
-            continue;
-
-          // If B is a block in a Standard or Finalize section then make sure
-          // that no edges point to symbols in NoAlloc sections.
-          assert((NoAllocSection || !E.getTarget().isDefined() ||
-                  E.getTarget().getBlock().getSection().getMemLifetime() !=
-                      orc::MemLifetime::NoAlloc) &&
-                 "Block in allocated section has edge pointing to no-alloc "
-                 "section");
+    // Fixups only write to the content of the block that they belong to, so
+    // large graphs can be fixed up one block per task. Small graphs, and all
+    // graphs when debug output is enabled, are fixed up on this thread.
+    bool FixUpInParallel = Blocks.size() >= ParallelFixUpThreshold;
+    LLVM_DEBUG(FixUpInParallel = false);
+    if (!FixUpInParallel) {
+      for (auto *B : Blocks)
+        if (auto Err = fixUpBlock(G, *B))
+          return Err;
+      return Error::success();
+    }
 
-          // Dispatch to LinkerImpl for fixup.
-          if (auto Err = impl().applyFixup(G, *B, E))
-            return Err;
-        }
+    std::mutex ErrMutex;
+    Error Err = Error::success();
+    parallelFor(0, Blocks.size(), [&](size_t I) {
+      if (auto BlockErr = fixUpBlock(G, *Blocks[I])) {
+        std::lock_guard<std::mutex> Lock(ErrMutex);
+        Err = joinErrors(std::move(Err), std::move(BlockErr));
       }
+    });
+    return Err;
+  }
+
+  Error fixUpBlock(LinkGraph &G, Block &B) const {
+    LLVM_DEBUG(dbgs() << "  " << B << ":\n");
+
+    // Copy Block data and apply fixups.
+    LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
+    assert((!B.isZeroFill() || all_of(B.edges(),
+                                      [](const Edge &E) {
+                                        return E.getKind() == Edge::KeepAlive;
+                                      })) &&
+           "Non-KeepAlive edges in zero-fill block?");
+
+    [[maybe_unused]] bool NoAllocSection =
+        B.getSection().getMemLifetime() == orc::MemLifetime::NoAlloc;
+
+    for (auto &E : B.edges()) {
+
+      // Skip non-relocation edges.
+      if (!E.isRelocation())
+        continue;
+
+      // If B is a block in a Standard or Finalize section then make sure
+      // that no edges point to symbols in NoAlloc sections.
+      assert((NoAllocSection || !E.getTarget().isDefined() ||
+              E.getTarget().getBlock().getSection().getMemLifetime() !=
+                  orc::MemLifetime::NoAlloc) &&
+             "Block in allocated section has edge pointing to no-alloc "
+             "section");
+
+      // Dispatch to LinkerImpl for fixup.
+      if (auto Err = impl().applyFixup(G, B, E))
+        return Err;
     }
 
     return Error::success();
@@ -181,6 +181,23 @@ void CompileOnDemandLayer::emit(
   }
 }
 
+Error CompileOnDemandLayer::redirect(JITDylib &TargetD,
+                                     const SymbolStringPtr &Name,
+                                     ExecutorAddr NewAddr) {
+  IndirectStubsManager *ISMgr = nullptr;
+  {
+    std::lock_guard<std::mutex> Lock(CODLayerMutex);
+    auto I = DylibResources.find(&TargetD);
+    if (I != DylibResources.end())
+      ISMgr = &I->second.getISManager();
+  }
+  if (!ISMgr || !ISMgr->findStub(*Name, false).getAddress())
+    return make_error<StringError>("No lazy call-through stub for " + *Name +
+                                       " in " + TargetD.getName(),
+                                   inconvertibleErrorCode());
+  return ISMgr->updatePointer(*Name, NewAddr);
+}
+
 CompileOnDemandLayer::PerDylibResources &
 CompileOnDemandLayer::getPerDylibResources(JITDylib &TargetD) {
   std::lock_guard<std::mutex> Lock(CODLayerMutex);
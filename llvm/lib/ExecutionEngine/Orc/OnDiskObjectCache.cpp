@@ -0,0 +1,113 @@
+//===------ OnDiskObjectCache.cpp - Persistent cache of JIT'd objects -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/OnDiskObjectCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+Expected<std::unique_ptr<OnDiskObjectCache>>
+OnDiskObjectCache::Create(StringRef CacheDir,
+                          const JITTargetMachineBuilder &JTMB,
+                          CachePruningPolicy Policy) {
+  if (std::error_code EC =
+          sys::fs::create_directories(CacheDir, /*IgnoreExisting=*/true))
+    return createFileError(CacheDir, EC);
+
+  std::string TargetKey;
+  raw_string_ostream OS(TargetKey);
+  OS << JTMB.getTargetTriple().str() << '\0' << JTMB.getCPU() << '\0'
+     << JTMB.getFeatures().getString() << '\0'
+     << static_cast<int>(JTMB.getCodeGenOptLevel()) << '\0';
+  if (JTMB.getRelocationModel())
+    OS << static_cast<int>(*JTMB.getRelocationModel());
+  OS << '\0';
+  if (JTMB.getCodeModel())
+    OS << static_cast<int>(*JTMB.getCodeModel());
+  OS << '\0' << JTMB.getOptions().EmulatedTLS << '\0';
+
+  return std::unique_ptr<OnDiskObjectCache>(
+      new OnDiskObjectCache(CacheDir, std::move(TargetKey), std::move(Policy)));
+}
+
+std::string OnDiskObjectCache::computeKey(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  raw_svector_ostream OS(Bitcode);
+  WriteBitcodeToFile(M, OS);
+
+  SHA1 Hasher;
+  Hasher.update(TargetKey);
+  Hasher.update(StringRef(Bitcode.data(), Bitcode.size()));
+  return toHex(Hasher.result());
+}
+
+std::string OnDiskObjectCache::getEntryPath(StringRef Key) const {
+  SmallString<128> Path(CacheDir);
+  // CachePruning only considers files with this prefix.
+  sys::path::append(Path, "llvmcache-" + Key);
+  return std::string(Path);
+}
+
+std::unique_ptr<MemoryBuffer> OnDiskObjectCache::getObject(const Module *M) {
+  std::string Key = computeKey(*M);
+  std::string Path = getEntryPath(Key);
+  auto Buffer = MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                      /*RequiresNullTerminator=*/false);
+  if (Buffer)
+    return std::move(*Buffer);
+
+  std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+  PendingKeys[M] = std::move(Key);
+  return nullptr;
+}
+
+void OnDiskObjectCache::notifyObjectCompiled(const Module *M,
+                                             MemoryBufferRef Obj) {
+  std::string Key;
+  {
+    std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+    auto I = PendingKeys.find(M);
+    if (I != PendingKeys.end()) {
+      Key = std::move(I->second);
+      PendingKeys.erase(I);
+    }
+  }
+  if (Key.empty())
+    Key = computeKey(*M);
+
+  // Write to a temporary file first, so that concurrent readers never see a
+  // partially written entry.
+  SmallString<128> TempModel(CacheDir);
+  sys::path::append(TempModel, "orc-cache-%%%%%%.tmp.o");
+  Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+      TempModel, sys::fs::owner_read | sys::fs::owner_write);
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    OS << Obj.getBuffer();
+  }
+  if (Error Err = Temp->keep(getEntryPath(Key))) {
+    consumeError(std::move(Err));
+    consumeError(Temp->discard());
+    return;
+  }
+
+  pruneCache(CacheDir, Policy);
+}
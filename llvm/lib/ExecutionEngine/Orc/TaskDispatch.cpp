@@ -9,6 +9,8 @@
 #include "llvm/ExecutionEngine/Orc/TaskDispatch.h"
 #include "llvm/ExecutionEngine/Orc/Core.h"
 
+#include <chrono>
+
 namespace llvm {
 namespace orc {
 
@@ -44,6 +46,13 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
       ++NumMaterializationThreads;
     }
 
+    // If there is an idle thread then hand the task to it.
+    if (NumIdleThreads > IdleTaskQueue.size()) {
+      IdleTaskQueue.emplace_back(std::move(T), IsMaterializationTask);
+      IdleCV.notify_one();
+      return;
+    }
+
     ++Outstanding;
   }
 
@@ -53,7 +62,7 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
       // Run the task.
       T->run();
 
-      std::lock_guard<std::mutex> Lock(DispatchMutex);
+      std::unique_lock<std::mutex> Lock(DispatchMutex);
       if (!MaterializationTaskQueue.empty()) {
         // If there are any materialization tasks running then steal that work.
         T = std::move(MaterializationTaskQueue.front());
@@ -62,14 +71,29 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
           ++NumMaterializationThreads;
           IsMaterializationTask = true;
         }
-      } else {
-        // Otherwise decrement work counters.
-        if (IsMaterializationTask)
-          --NumMaterializationThreads;
-        --Outstanding;
-        OutstandingCV.notify_all();
-        return;
+        continue;
       }
+
+      if (IsMaterializationTask)
+        --NumMaterializationThreads;
+
+      // Wait for a while for another task before giving up the thread.
+      ++NumIdleThreads;
+      IdleCV.wait_for(Lock, std::chrono::milliseconds(100), [this]() {
+        return !IdleTaskQueue.empty() || !Running;
+      });
+      --NumIdleThreads;
+      if (!IdleTaskQueue.empty()) {
+        std::tie(T, IsMaterializationTask) =
+            std::move(IdleTaskQueue.front());
+        IdleTaskQueue.pop_front();
+        continue;
+      }
+
+      // Otherwise decrement work counters.
+      --Outstanding;
+      OutstandingCV.notify_all();
+      return;
     }
   }).detach();
 }
@@ -77,6 +101,7 @@ void DynamicThreadPoolTaskDispatcher::dispatch(std::unique_ptr<Task> T) {
 void DynamicThreadPoolTaskDispatcher::shutdown() {
   std::unique_lock<std::mutex> Lock(DispatchMutex);
   Running = false;
+  IdleCV.notify_all();
   OutstandingCV.wait(Lock, [this]() { return Outstanding == 0; });
 }
 #endif
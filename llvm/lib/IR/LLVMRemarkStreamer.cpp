@@ -57,9 +57,8 @@ toRemarkLocation(const DiagnosticLocation &DL) {
 }
 
 /// LLVM Diagnostic -> Remark
-remarks::Remark
-LLVMRemarkStreamer::toRemark(const DiagnosticInfoOptimizationBase &Diag) const {
-  remarks::Remark R; // The result.
+void LLVMRemarkStreamer::toRemark(const DiagnosticInfoOptimizationBase &Diag,
+                                  remarks::Remark &R) const {
   R.RemarkType = toRemarkType(static_cast<DiagnosticKind>(Diag.getKind()));
   R.PassName = Diag.getPassName();
   R.RemarkName = Diag.getRemarkName();
@@ -68,14 +67,13 @@ LLVMRemarkStreamer::toRemark(const DiagnosticInfoOptimizationBase &Diag) const {
   R.Loc = toRemarkLocation(Diag.getLocation());
   R.Hotness = Diag.getHotness();
 
+  R.Args.clear();
   for (const DiagnosticInfoOptimizationBase::Argument &Arg : Diag.getArgs()) {
     R.Args.emplace_back();
     R.Args.back().Key = Arg.Key;
     R.Args.back().Val = Arg.Val;
     R.Args.back().Loc = toRemarkLocation(Arg.Loc);
   }
-
-  return R;
 }
 
 void LLVMRemarkStreamer::emit(const DiagnosticInfoOptimizationBase &Diag) {
@@ -83,9 +81,9 @@ void LLVMRemarkStreamer::emit(const DiagnosticInfoOptimizationBase &Diag) {
       return;
 
   // First, convert the diagnostic to a remark.
-  remarks::Remark R = toRemark(Diag);
+  toRemark(Diag, Scratch);
   // Then, emit the remark through the serializer.
-  RS.getSerializer().emit(R);
+  RS.getSerializer().emit(Scratch);
 }
 
 char LLVMRemarkSetupFileError::ID = 0;
@@ -106,6 +106,7 @@
 #include "llvm/IR/PassManager.h"
 #include "llvm/IR/Statepoint.h"
 #include "llvm/IR/Type.h"
+#include "llvm/IR/TypeFinder.h"
 #include "llvm/IR/Use.h"
 #include "llvm/IR/User.h"
 #include "llvm/IR/VFABIDemangler.h"
@@ -118,6 +119,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/ModRef.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -134,6 +136,13 @@ static cl::opt<bool> VerifyNoAliasScopeDomination(
     cl::desc("Ensure that llvm.experimental.noalias.scope.decl for identical "
              "scopes are not dominating"));
 
+namespace llvm {
+cl::opt<bool> VerifyInParallel(
+    "verify-in-parallel", cl::Hidden, cl::init(false),
+    cl::desc("Verify the functions of a module concurrently on the parallel "
+             "executor"));
+} // namespace llvm
+
 namespace llvm {
 
 struct VerifierSupport {
@@ -457,6 +466,10 @@ public:
     return !Broken;
   }
 
+  /// Verify all functions of the module concurrently. Diagnostics are printed
+  /// in the same order as when verifying the functions one after another.
+  bool verifyFunctionsInParallel();
+
   /// Verify the module that this instance of \c Verifier was initialized with.
   bool verify() {
     Broken = false;
@@ -499,6 +512,11 @@ private:
   /// Whether a metadata node is allowed to be, or contain, a DILocation.
   enum class AreDebugLocsAllowed { No, Yes };
 
+  /// Create the objects that verifying a function would otherwise create
+  /// lazily in the context, the module or the data layout, so that functions
+  /// can be verified concurrently.
+  void prepareForParallelVerification();
+
   // Verification methods...
   void visitGlobalValue(const GlobalValue &GV);
   void visitGlobalVariable(const GlobalVariable &GV);
@@ -3774,7 +3792,7 @@ static AttrBuilder getParameterABIAttributes(LLVMContext& C, unsigned I, Attribu
   if (Attrs.hasParamAttr(I, Attribute::Alignment) &&
       (Attrs.hasParamAttr(I, Attribute::ByVal) ||
        Attrs.hasParamAttr(I, Attribute::ByRef)))
-    Copy.addAlignmentAttr(Attrs.getParamAlignment(I));
+    Copy.addAttribute(Attrs.getParamAttr(I, Attribute::Alignment));
   return Copy;
 }
 
@@ -7071,14 +7089,107 @@ bool llvm::verifyFunction(const Function &f, raw_ostream *OS) {
   return !V.verify(F);
 }
 
+void Verifier::prepareForParallelVerification() {
+  ConstantTokenNone::get(Context);
+
+  // Matching and mangling intrinsic signatures may create types and unique
+  // names for unnamed types.
+  for (const Function &F : M) {
+    Intrinsic::ID ID = F.getIntrinsicID();
+    if (ID == Intrinsic::not_intrinsic)
+      continue;
+    SmallVector<Intrinsic::IITDescriptor, 8> Table;
+    getIntrinsicInfoTableEntries(ID, Table);
+    ArrayRef<Intrinsic::IITDescriptor> TableRef = Table;
+    SmallVector<Type *, 4> ArgTys;
+    if (Intrinsic::matchIntrinsicSignature(F.getFunctionType(), TableRef,
+                                           ArgTys) ==
+        Intrinsic::MatchIntrinsicTypes_Match)
+      (void)Intrinsic::getName(ID, ArgTys, const_cast<Module *>(&M),
+                               F.getFunctionType());
+  }
+
+  // Struct types cache whether they are sized, and the data layout caches
+  // their layouts.
+  TypeFinder StructTypes;
+  StructTypes.run(M, /*onlyNamed=*/false);
+  for (StructType *STy : StructTypes)
+    if (STy->isSized())
+      (void)DL.getStructLayout(STy);
+}
+
+bool Verifier::verifyFunctionsInParallel() {
+  prepareForParallelVerification();
+
+  // Functions are verified in chunks of a fixed size, each with its own
+  // Verifier, so that the output does not depend on the number of threads.
+  constexpr size_t ChunkSize = 16;
+  SmallVector<const Function *, 0> Functions(llvm::make_pointer_range(M));
+  struct Chunk {
+    std::unique_ptr<Verifier> V;
+    std::string Output;
+    bool Broken = false;
+  };
+  std::vector<Chunk> Chunks(divideCeil(Functions.size(), ChunkSize));
+  parallelFor(0, Chunks.size(), [&](size_t I) {
+    Chunk &C = Chunks[I];
+    raw_string_ostream ChunkOS(C.Output);
+    C.V = std::make_unique<Verifier>(OS ? &ChunkOS : nullptr,
+                                     TreatBrokenDebugInfoAsError, M);
+    for (size_t J = I * ChunkSize,
+                E = std::min(Functions.size(), J + ChunkSize);
+         J != E; ++J)
+      C.Broken |= !C.V->verify(*Functions[J]);
+    C.V->OS = nullptr;
+  });
+
+  // Print the diagnostics in order and merge the state needed by the checks
+  // that span functions.
+  bool Result = true;
+  for (const Chunk &C : Chunks) {
+    if (OS)
+      *OS << C.Output;
+    Result &= !C.Broken;
+    BrokenDebugInfo |= C.V->BrokenDebugInfo;
+    for (const auto &[F, Counts] : C.V->FrameEscapeInfo) {
+      auto &Entry = FrameEscapeInfo[F];
+      Entry.first = std::max(Entry.first, Counts.first);
+      Entry.second = std::max(Entry.second, Counts.second);
+    }
+    CUVisited.insert(C.V->CUVisited.begin(), C.V->CUVisited.end());
+  }
+
+  // Subprograms attached to several functions of the same chunk have been
+  // diagnosed already.
+  DenseMap<const DISubprogram *, size_t> LastAttachment;
+  for (size_t I = 0, E = Functions.size(); I != E; ++I) {
+    const Function *F = Functions[I];
+    const DISubprogram *SP = F->getSubprogram();
+    if (F->isDeclaration() || !SP)
+      continue;
+    auto [It, Inserted] = LastAttachment.try_emplace(SP, I);
+    if (!Inserted && It->second / ChunkSize != I / ChunkSize) {
+      Broken = false;
+      DebugInfoCheckFailed("DISubprogram attached to more than one function",
+                           SP, F);
+      Result &= !Broken;
+    }
+    It->second = I;
+  }
+  return Result;
+}
+
 bool llvm::verifyModule(const Module &M, raw_ostream *OS,
                         bool *BrokenDebugInfo) {
   // Don't use a raw_null_ostream.  Printing IR is expensive.
   Verifier V(OS, /*ShouldTreatBrokenDebugInfoAsError=*/!BrokenDebugInfo, M);
 
   bool Broken = false;
-  for (const Function &F : M)
-    Broken |= !V.verify(F);
+  if (VerifyInParallel)
+    Broken |= !V.verifyFunctionsInParallel();
+  else
+    for (const Function &F : M)
+      Broken |= !V.verify(F);
 
   Broken |= !V.verify();
   if (BrokenDebugInfo)
@@ -14,6 +14,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/LTO/LTOBackend.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/CGSCCPassManager.h"
 #include "llvm/Analysis/ModuleSummaryAnalysis.h"
@@ -52,6 +53,11 @@ using namespace lto;
 
 #define DEBUG_TYPE "lto-backend"
 
+STATISTIC(NumImportSourceModules,
+          "Number of modules lazily loaded to import from");
+STATISTIC(NumImportSourceBytes,
+          "Bytes of bitcode in modules lazily loaded to import from");
+
 enum class LTOBitcodeEmbedding {
   DoNotEmbed = 0,
   EmbedOptimized = 1,
@@ -629,9 +635,11 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
   auto ModuleLoader = [&](StringRef Identifier) {
     assert(Mod.getContext().isODRUniquingDebugTypes() &&
            "ODR Type uniquing should be enabled on the context");
+    ++NumImportSourceModules;
     if (ModuleMap) {
       auto I = ModuleMap->find(Identifier);
       assert(I != ModuleMap->end());
+      NumImportSourceBytes += I->second.getBuffer().size();
       return I->second.getLazyModule(Mod.getContext(),
                                      /*ShouldLazyLoadMetadata=*/true,
                                      /*IsImporting*/ true);
@@ -651,6 +659,7 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
               toString(BMOrErr.takeError()),
           inconvertibleErrorCode()));
 
+    NumImportSourceBytes += BMOrErr->getBuffer().size();
     Expected<std::unique_ptr<Module>> MOrErr =
         BMOrErr->getLazyModule(Mod.getContext(),
                                /*ShouldLazyLoadMetadata=*/true,
@@ -1220,24 +1220,20 @@ bool MCAssembler::relaxFragment(MCAsmLayout &Layout, MCFragment &F) {
 }
 
 bool MCAssembler::layoutSectionOnce(MCAsmLayout &Layout, MCSection &Sec) {
-  // Holds the first fragment which needed relaxing during this layout. It will
-  // remain NULL if none were relaxed.
-  // When a fragment is relaxed, all the fragments following it should get
-  // invalidated because their offset is going to change.
-  MCFragment *FirstRelaxedFragment = nullptr;
-
-  // Attempt to relax all the fragments in the section.
+  // Attempt to relax all the fragments in the section. When a fragment is
+  // relaxed, the fragments following it are invalidated right away, so that
+  // the rest of this pass sees their new offsets. Fragments are only laid out
+  // again as far as a later fixup needs them, and since most of the growth is
+  // accounted for in the same pass, far fewer passes are needed than when the
+  // whole section is relaid out after each one.
+  bool WasRelaxed = false;
   for (MCFragment &Frag : Sec) {
-    // Check if this is a fragment that needs relaxation.
-    bool RelaxedFrag = relaxFragment(Layout, Frag);
-    if (RelaxedFrag && !FirstRelaxedFragment)
-      FirstRelaxedFragment = &Frag;
-  }
-  if (FirstRelaxedFragment) {
-    Layout.invalidateFragmentsFrom(FirstRelaxedFragment);
-    return true;
+    if (relaxFragment(Layout, Frag)) {
+      Layout.invalidateFragmentsFrom(&Frag);
+      WasRelaxed = true;
+    }
   }
-  return false;
+  return WasRelaxed;
 }
 
 bool MCAssembler::layoutOnce(MCAsmLayout &Layout) {
@@ -1904,14 +1904,18 @@ void MCDwarfFrameEmitter::Emit(MCObjectStreamer &Streamer, MCAsmBackend *MAB,
   // Sort the FDEs by their corresponding CIE before we emit them.
   // This isn't technically necessary according to the DWARF standard,
   // but the Android libunwindstack rejects eh_frame sections where
-  // an FDE refers to a CIE other than the closest previous CIE.
-  std::vector<MCDwarfFrameInfo> FrameArrayX(FrameArray.begin(), FrameArray.end());
+  // an FDE refers to a CIE other than the closest previous CIE. Sort pointers
+  // rather than copies, since every frame owns its list of CFI instructions.
+  std::vector<const MCDwarfFrameInfo *> FrameArrayX;
+  FrameArrayX.reserve(FrameArray.size());
+  for (const MCDwarfFrameInfo &Frame : FrameArray)
+    FrameArrayX.push_back(&Frame);
   llvm::stable_sort(FrameArrayX,
-                    [](const MCDwarfFrameInfo &X, const MCDwarfFrameInfo &Y) {
-                      return CIEKey(X) < CIEKey(Y);
+                    [](const MCDwarfFrameInfo *X, const MCDwarfFrameInfo *Y) {
+                      return CIEKey(*X) < CIEKey(*Y);
                     });
   for (auto I = FrameArrayX.begin(), E = FrameArrayX.end(); I != E;) {
-    const MCDwarfFrameInfo &Frame = *I;
+    const MCDwarfFrameInfo &Frame = **I;
     ++I;
     if (CanOmitDwarf && Frame.CompactUnwindEncoding !=
           MOFI->getCompactUnwindDwarfEHFrameOnly() && IsEH)
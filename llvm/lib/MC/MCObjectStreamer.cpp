@@ -237,6 +237,22 @@ MCObjectStreamer::getOrCreateDataFragment(const MCSubtargetInfo *STI) {
   return F;
 }
 
+unsigned MCObjectStreamer::encodeInstToData(MCDataFragment &DF,
+                                            const MCInst &Inst,
+                                            const MCSubtargetInfo &STI) {
+  // The encoder appends to the buffers it is given and reports fixup offsets
+  // relative to the start of the instruction, so the encoding can go straight
+  // into the fragment without an intermediate copy.
+  SmallVectorImpl<char> &Contents = DF.getContents();
+  SmallVectorImpl<MCFixup> &Fixups = DF.getFixups();
+  uint64_t Offset = Contents.size();
+  unsigned FirstFixup = Fixups.size();
+  getAssembler().getEmitter().encodeInstruction(Inst, Contents, Fixups, STI);
+  for (MCFixup &Fixup : drop_begin(Fixups, FirstFixup))
+    Fixup.setOffset(Fixup.getOffset() + Offset);
+  return FirstFixup;
+}
+
 void MCObjectStreamer::visitUsedSymbol(const MCSymbol &Sym) {
   Assembler->registerSymbol(Sym);
 }
@@ -480,10 +496,8 @@ void MCObjectStreamer::emitInstToFragment(const MCInst &Inst,
   MCRelaxableFragment *IF = new MCRelaxableFragment(Inst, STI);
   insert(IF);
 
-  SmallString<128> Code;
-  getAssembler().getEmitter().encodeInstruction(Inst, Code, IF->getFixups(),
-                                                STI);
-  IF->getContents().append(Code.begin(), Code.end());
+  getAssembler().getEmitter().encodeInstruction(Inst, IF->getContents(),
+                                                IF->getFixups(), STI);
 }
 
 #ifndef NDEBUG
@@ -550,6 +564,17 @@ void MCObjectStreamer::emitDwarfAdvanceLineAddr(int64_t LineDelta,
                          Label, PointerSize);
     return;
   }
+  // Both labels are usually in the same fragment of a function without
+  // relaxable instructions, so the delta is known and can be encoded now
+  // instead of in a fragment of its own during layout.
+  if (!getAssembler().getContext().getTargetTriple().isRISCV())
+    if (std::optional<uint64_t> Diff = absoluteSymbolDiff(Label, LastLabel)) {
+      SmallString<16> Tmp;
+      MCDwarfLineAddr::encode(getContext(), Assembler->getDWARFLinetableParams(),
+                              LineDelta, *Diff, Tmp);
+      emitBytes(Tmp);
+      return;
+    }
   const MCExpr *AddrDelta = buildSymbolDiff(*this, Label, LastLabel, SMLoc());
   insert(new MCDwarfLineAddrFragment(LineDelta, *AddrDelta));
 }
@@ -575,6 +600,13 @@ void MCObjectStreamer::emitDwarfLineEndEntry(MCSection *Section,
 void MCObjectStreamer::emitDwarfAdvanceFrameAddr(const MCSymbol *LastLabel,
                                                  const MCSymbol *Label,
                                                  SMLoc Loc) {
+  if (!getAssembler().getContext().getTargetTriple().isRISCV())
+    if (std::optional<uint64_t> Diff = absoluteSymbolDiff(Label, LastLabel)) {
+      SmallString<8> Tmp;
+      MCDwarfFrameEmitter::encodeAdvanceLoc(getContext(), *Diff, Tmp);
+      emitBytes(Tmp);
+      return;
+    }
   const MCExpr *AddrDelta = buildSymbolDiff(*this, Label, LastLabel, Loc);
   insert(new MCDwarfCallFrameFragment(*AddrDelta, nullptr));
 }
@@ -20,6 +20,7 @@
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileOutputBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include <algorithm>
 #include <cstddef>
@@ -2078,15 +2079,40 @@ template <class ELFT> void ELFWriter<ELFT>::writeShdrs() {
 }
 
 template <class ELFT> Error ELFWriter<ELFT>::writeSectionData() {
+  // Segments are responsible for writing their contents, so only write the
+  // section data if the section is not in a segment. Note that this renders
+  // sections in segments effectively immutable.
+  std::vector<const SectionBase *> ToWrite;
   for (SectionBase &Sec : Obj.sections())
-    // Segments are responsible for writing their contents, so only write the
-    // section data if the section is not in a segment. Note that this renders
-    // sections in segments effectively immutable.
     if (Sec.ParentSegment == nullptr)
-      if (Error Err = Sec.accept(*SecWriter))
+      ToWrite.push_back(&Sec);
+
+  // Section writers don't share any state, so sections can be written (and
+  // decompressed) concurrently as long as their file ranges are disjoint.
+  // Fall back to writing in order otherwise, so that a later section keeps
+  // overwriting an earlier one.
+  std::vector<const SectionBase *> ByOffset;
+  for (const SectionBase *Sec : ToWrite)
+    if (Sec->Type != SHT_NOBITS && Sec->Size != 0)
+      ByOffset.push_back(Sec);
+  llvm::stable_sort(ByOffset, [](const SectionBase *A, const SectionBase *B) {
+    return A->Offset < B->Offset;
+  });
+  bool Disjoint = true;
+  for (size_t I = 1, E = ByOffset.size(); I < E && Disjoint; ++I)
+    Disjoint = ByOffset[I - 1]->Offset + ByOffset[I - 1]->Size <=
+               ByOffset[I]->Offset;
+
+  if (!Disjoint) {
+    for (const SectionBase *Sec : ToWrite)
+      if (Error Err = Sec->accept(*SecWriter))
         return Err;
+    return Error::success();
+  }
 
-  return Error::success();
+  return parallelForEachError(ToWrite, [&](const SectionBase *Sec) {
+    return Sec->accept(*SecWriter);
+  });
 }
 
 template <class ELFT> void ELFWriter<ELFT>::writeSegmentData() {
@@ -12,6 +12,7 @@
 
 #include "llvm/Object/ArchiveWriter.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Sequence.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
@@ -31,6 +32,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -704,10 +706,27 @@ bool isImportDescriptor(StringRef Name) {
           Name.ends_with(NullThunkDataSuffix));
 }
 
-static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
-                                                  uint16_t Index,
-                                                  raw_ostream &SymNames,
-                                                  SymMap *SymMap) {
+// Returns the names of the symbols of Obj that go into the archive symbol
+// table, in symbol order.
+static Expected<std::vector<std::string>>
+getArchiveSymbolNames(SymbolicFile &Obj) {
+  std::vector<std::string> Names;
+  for (const object::BasicSymbolRef &S : Obj.symbols()) {
+    if (!isArchiveSymbol(S))
+      continue;
+    std::string Name;
+    raw_string_ostream NameStream(Name);
+    if (Error E = S.printName(NameStream))
+      return std::move(E);
+    Names.push_back(std::move(Name));
+  }
+  return std::move(Names);
+}
+
+static std::vector<unsigned> getSymbols(SymbolicFile *Obj,
+                                        ArrayRef<std::string> Names,
+                                        uint16_t Index, raw_ostream &SymNames,
+                                        SymMap *SymMap) {
   std::vector<unsigned> Ret;
 
   if (Obj == nullptr)
@@ -717,14 +736,8 @@ static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
   if (SymMap)
     Map = SymMap->UseECMap && isECObject(*Obj) ? &SymMap->ECMap : &SymMap->Map;
 
-  for (const object::BasicSymbolRef &S : Obj->symbols()) {
-    if (!isArchiveSymbol(S))
-      continue;
+  for (const std::string &Name : Names) {
     if (Map) {
-      std::string Name;
-      raw_string_ostream NameStream(Name);
-      if (Error E = S.printName(NameStream))
-        return std::move(E);
       if (Map->find(Name) != Map->end())
         continue; // ignore duplicated symbol
       (*Map)[Name] = Index;
@@ -738,14 +751,24 @@ static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
       }
     } else {
       Ret.push_back(SymNames.tell());
-      if (Error E = S.printName(SymNames))
-        return std::move(E);
-      SymNames << '\0';
+      SymNames << Name << '\0';
     }
   }
   return Ret;
 }
 
+static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
+                                                  uint16_t Index,
+                                                  raw_ostream &SymNames,
+                                                  SymMap *SymMap) {
+  if (Obj == nullptr)
+    return std::vector<unsigned>();
+  Expected<std::vector<std::string>> NamesOrErr = getArchiveSymbolNames(*Obj);
+  if (!NamesOrErr)
+    return NamesOrErr.takeError();
+  return getSymbols(Obj, *NamesOrErr, Index, SymNames, SymMap);
+}
+
 static Expected<std::vector<MemberData>>
 computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                   object::Archive::Kind Kind, bool Thin, bool Deterministic,
@@ -817,16 +840,60 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
   std::vector<std::unique_ptr<SymbolicFile>> SymFiles;
 
+  // Reading the members dominates the time it takes to write large archives,
+  // so parse them and collect their symbol names in parallel. Bitcode members
+  // share Context, which is not thread-safe, so they are handled serially.
   if (NeedSymbols != SymtabWritingMode::NoSymtab || isAIXBigArchive(Kind)) {
-    for (const NewArchiveMember &M : NewMembers) {
+    SymFiles.resize(NewMembers.size());
+    auto IsBitcode = [&](size_t I) {
+      return identify_magic(NewMembers[I].Buf->getBuffer()) ==
+             file_magic::bitcode;
+    };
+    if (Error E = parallelForEachError(
+            seq<size_t>(0, NewMembers.size()), [&](size_t I) -> Error {
+              if (IsBitcode(I))
+                return Error::success();
+              const NewArchiveMember &M = NewMembers[I];
+              Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr =
+                  getSymbolicFile(M.Buf->getMemBufferRef(), Context);
+              if (!SymFileOrErr)
+                return createFileError(M.MemberName,
+                                       SymFileOrErr.takeError());
+              SymFiles[I] = std::move(*SymFileOrErr);
+              return Error::success();
+            }))
+      return std::move(E);
+    for (size_t I = 0, E = NewMembers.size(); I != E; ++I) {
+      if (!IsBitcode(I))
+        continue;
+      const NewArchiveMember &M = NewMembers[I];
       Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr =
           getSymbolicFile(M.Buf->getMemBufferRef(), Context);
       if (!SymFileOrErr)
         return createFileError(M.MemberName, SymFileOrErr.takeError());
-      SymFiles.push_back(std::move(*SymFileOrErr));
+      SymFiles[I] = std::move(*SymFileOrErr);
     }
   }
 
+  std::vector<std::optional<std::vector<std::string>>> SymFileNames(
+      SymFiles.size());
+  if (NeedSymbols != SymtabWritingMode::NoSymtab) {
+    if (Error E = parallelForEachError(
+            seq<size_t>(0, SymFiles.size()), [&](size_t I) -> Error {
+              SymbolicFile *SymFile = SymFiles[I].get();
+              if (!SymFile || isa<IRObjectFile>(SymFile))
+                return Error::success();
+              Expected<std::vector<std::string>> NamesOrErr =
+                  getArchiveSymbolNames(*SymFile);
+              if (!NamesOrErr)
+                return createFileError(NewMembers[I].MemberName,
+                                       NamesOrErr.takeError());
+              SymFileNames[I] = std::move(*NamesOrErr);
+              return Error::success();
+            }))
+      return std::move(E);
+  }
+
   if (SymMap) {
     if (IsEC) {
       SymMap->UseECMap = *IsEC;
@@ -933,11 +1000,16 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
     std::vector<unsigned> Symbols;
     if (NeedSymbols != SymtabWritingMode::NoSymtab) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(CurSymFile.get(), Index + 1, SymNames, SymMap);
-      if (!SymbolsOrErr)
-        return createFileError(M->MemberName, SymbolsOrErr.takeError());
-      Symbols = std::move(*SymbolsOrErr);
+      if (SymFileNames[Index]) {
+        Symbols = getSymbols(CurSymFile.get(), *SymFileNames[Index],
+                             Index + 1, SymNames, SymMap);
+      } else {
+        Expected<std::vector<unsigned>> SymbolsOrErr =
+            getSymbols(CurSymFile.get(), Index + 1, SymNames, SymMap);
+        if (!SymbolsOrErr)
+          return createFileError(M->MemberName, SymbolsOrErr.takeError());
+        Symbols = std::move(*SymbolsOrErr);
+      }
       if (CurSymFile)
         HasObject = true;
     }
@@ -1275,6 +1347,9 @@ Error writeArchive(StringRef ArcName, ArrayRef<NewArchiveMember> NewMembers,
   if (!Temp)
     return Temp.takeError();
   raw_fd_ostream Out(Temp->FD, false);
+  // Archives are mostly member contents copied as-is; write them in large
+  // chunks rather than the file system's preferred block size.
+  Out.SetBufferSize(1 << 20);
 
   if (Error E = writeArchiveToStream(Out, NewMembers, WriteSymtab, Kind,
                                      Deterministic, Thin, IsEC)) {
@@ -15,6 +15,7 @@
 #include "llvm/Passes/StandardInstrumentations.h"
 #include "llvm/ADT/Any.h"
 #include "llvm/ADT/StableHashing.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/CallGraphSCCPass.h"
 #include "llvm/Analysis/LazyCallGraph.h"
@@ -24,6 +25,7 @@
 #include "llvm/CodeGen/MachineModuleInfo.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassInstrumentation.h"
 #include "llvm/IR/PassManager.h"
@@ -34,8 +36,10 @@
 #include "llvm/Support/CrashRecoveryContext.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/GraphWriter.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
@@ -137,6 +141,31 @@ static cl::opt<std::string> IRDumpDirectory(
              "files in this directory rather than written to stderr"),
     cl::Hidden, cl::value_desc("filename"));
 
+static cl::opt<std::string> AnalysisReuseFile(
+    "analysis-reuse-file",
+    cl::desc("Record the structural hashes of the functions that function "
+             "analyses are computed for in this file, and report how many "
+             "computations were for a function with a hash recorded earlier"),
+    cl::Hidden, cl::value_desc("filename"));
+
+static cl::opt<std::string> IncrementalReuseFile(
+    "incremental-reuse-file",
+    cl::desc("Record the optimized form of every function under a key of its "
+             "inputs in this file, and report how many functions had a key "
+             "recorded earlier and whether their result was the same"),
+    cl::Hidden, cl::value_desc("filename"));
+
+static cl::opt<unsigned> PassCostTop(
+    "pass-cost-top", cl::init(0), cl::Hidden,
+    cl::desc("Record the given number of pass executions with the largest "
+             "self time, with the IR unit they ran on and its size"));
+
+static cl::opt<std::string> PassCostOutput(
+    "pass-cost-output",
+    cl::desc("Write the JSON report of -pass-cost-top to this file instead of "
+             "the info output file"),
+    cl::Hidden, cl::value_desc("filename"));
+
 template <typename IRUnitT> static const IRUnitT *unwrapIR(Any IR) {
   const IRUnitT **IRPtr = llvm::any_cast<const IRUnitT *>(&IR);
   return IRPtr ? *IRPtr : nullptr;
@@ -1573,6 +1602,374 @@ void TimeProfilingPassesHandler::runBeforePass(StringRef PassID, Any IR) {
 
 void TimeProfilingPassesHandler::runAfterPass() { timeTraceProfilerEnd(); }
 
+void AnalysisReuseReporter::registerCallbacks(
+    PassInstrumentationCallbacks &PIC) {
+  if (AnalysisReuseFile.empty())
+    return;
+  Enabled = true;
+  readFile();
+  PIC.registerBeforeAnalysisCallback(
+      [this](StringRef P, Any IR) { this->runBeforeAnalysis(P, IR); });
+  PIC.registerAfterAnalysisCallback(
+      [this](StringRef P, Any IR) { this->runAfterAnalysis(); }, true);
+}
+
+AnalysisReuseReporter::~AnalysisReuseReporter() {
+  if (!Enabled)
+    return;
+  writeFile();
+  printReport();
+}
+
+void AnalysisReuseReporter::runBeforeAnalysis(StringRef PassID, Any IR) {
+  const Function *F = unwrapIR<Function>(IR);
+  if (!F) {
+    Stack.push_back({nullptr, false, Clock::now()});
+    return;
+  }
+  // Hash before starting the clock, the cost of hashing is not part of the
+  // analysis.
+  IRHash Hash = StructuralHash(*F, /*DetailedHash=*/true);
+  AnalysisStats &S = Stats[PassID];
+  ++S.Computed;
+  bool Repeated = !S.Hashes.insert(Hash).second;
+  auto It = Recorded.find(PassID);
+  if (It != Recorded.end() && It->second.contains(Hash)) {
+    ++S.RecordedEarlier;
+    Repeated = true;
+  }
+  S.Repeated += Repeated;
+  Stack.push_back({&S, Repeated, Clock::now()});
+}
+
+void AnalysisReuseReporter::runAfterAnalysis() {
+  Frame F = Stack.pop_back_val();
+  Clock::duration Time = Clock::now() - F.Start;
+  if (!Stack.empty())
+    Stack.back().ChildTime += Time;
+  if (!F.Stats)
+    return;
+  F.Stats->Time += Time - F.ChildTime;
+  if (F.Repeated)
+    F.Stats->RepeatedTime += Time - F.ChildTime;
+}
+
+void AnalysisReuseReporter::readFile() {
+  // The file holds one "<analysis> <hash>" line per recorded pair.
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      MemoryBuffer::getFile(AnalysisReuseFile, /*IsText=*/true);
+  if (!BufOrErr)
+    return;
+  SmallVector<StringRef, 0> Lines;
+  (*BufOrErr)->getBuffer().split(Lines, '\n', -1, /*KeepEmpty=*/false);
+  for (StringRef Line : Lines) {
+    auto [Name, HashStr] = Line.rsplit(' ');
+    IRHash Hash;
+    if (!HashStr.getAsInteger(16, Hash))
+      Recorded[Name].insert(Hash);
+  }
+}
+
+void AnalysisReuseReporter::writeFile() {
+  std::error_code EC;
+  raw_fd_ostream OS(AnalysisReuseFile, EC, sys::fs::OF_Append);
+  if (EC) {
+    errs() << "could not open " << AnalysisReuseFile << ": " << EC.message()
+           << '\n';
+    return;
+  }
+  // Append the new pairs in one write, so that processes which share the
+  // file are unlikely to interleave their lines.
+  std::string Buf;
+  raw_string_ostream BufOS(Buf);
+  for (const auto &[Name, S] : Stats) {
+    auto It = Recorded.find(Name);
+    for (IRHash Hash : S.Hashes)
+      if (It == Recorded.end() || !It->second.contains(Hash))
+        BufOS << Name << ' ' << format_hex_no_prefix(Hash, 16) << '\n';
+  }
+  OS << Buf;
+}
+
+void AnalysisReuseReporter::printReport() {
+  std::unique_ptr<raw_ostream> OS = CreateInfoOutputFile();
+  auto ToSeconds = [](Clock::duration D) {
+    return std::chrono::duration<double>(D).count();
+  };
+  SmallVector<StringRef, 0> Names;
+  for (const auto &Entry : Stats)
+    Names.push_back(Entry.getKey());
+  llvm::sort(Names);
+
+  AnalysisStats Total;
+  *OS << "===" << std::string(73, '-') << "===\n"
+      << "                         Analysis reuse report\n"
+      << "===" << std::string(73, '-') << "===\n"
+      << formatv("{0,9} {1,9} {2,9} {3,10} {4,10}  {5}\n", "computed",
+                 "repeated", "recorded", "time (s)", "saved (s)", "analysis");
+  for (StringRef Name : Names) {
+    const AnalysisStats &S = Stats.find(Name)->second;
+    *OS << formatv("{0,9} {1,9} {2,9} {3,10:f4} {4,10:f4}  {5}\n", S.Computed,
+                   S.Repeated, S.RecordedEarlier, ToSeconds(S.Time),
+                   ToSeconds(S.RepeatedTime), Name);
+    Total.Computed += S.Computed;
+    Total.Repeated += S.Repeated;
+    Total.RecordedEarlier += S.RecordedEarlier;
+    Total.Time += S.Time;
+    Total.RepeatedTime += S.RepeatedTime;
+  }
+  *OS << formatv("{0,9} {1,9} {2,9} {3,10:f4} {4,10:f4}  {5}\n", Total.Computed,
+                 Total.Repeated, Total.RecordedEarlier, ToSeconds(Total.Time),
+                 ToSeconds(Total.RepeatedTime), "Total");
+}
+
+void IncrementalReuseReporter::registerCallbacks(
+    PassInstrumentationCallbacks &PIC) {
+  if (IncrementalReuseFile.empty())
+    return;
+  Enabled = true;
+  PIC.registerBeforeNonSkippedPassCallback(
+      [this](StringRef P, Any IR) { this->runBeforePass(P, IR); });
+  PIC.registerAfterPassCallback(
+      [this](StringRef P, Any IR, const PreservedAnalyses &) {
+        this->runAfterPass(IR);
+      });
+  PIC.registerAfterPassInvalidatedCallback(
+      [this](StringRef P, const PreservedAnalyses &) {
+        this->runAfterPass(Any());
+      });
+}
+
+void IncrementalReuseReporter::runBeforePass(StringRef PassID, Any IR) {
+  if (Depth++ != 0)
+    return;
+  PipelineHash =
+      stable_hash_combine(PipelineHash, stable_hash_combine_string(PassID));
+  if (InputHashes.empty())
+    if (const Module *M = unwrapIR<Module>(IR))
+      computeKeys(*M);
+}
+
+void IncrementalReuseReporter::computeKeys(const Module &M) {
+  TargetHash =
+      stable_hash_combine(stable_hash_combine_string(M.getTargetTriple()),
+                          stable_hash_combine_string(M.getDataLayoutStr()));
+  DenseMap<const Function *, SmallVector<const Function *, 4>> DirectCallees;
+  for (const Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    InputHashes[F.getName()] = StructuralHash(F, /*DetailedHash=*/true);
+    SmallPtrSet<const Function *, 8> Seen;
+    for (const Instruction &I : instructions(F))
+      if (const auto *CB = dyn_cast<CallBase>(&I))
+        if (const Function *Callee = CB->getCalledFunction())
+          if (!Callee->isDeclaration() && Seen.insert(Callee).second)
+            DirectCallees[&F].push_back(Callee);
+  }
+  for (const Function &F : M) {
+    if (F.isDeclaration())
+      continue;
+    SmallPtrSet<const Function *, 16> Visited;
+    SmallVector<const Function *, 16> Worklist{&F};
+    SmallVector<std::string, 0> &Names = Callees[F.getName()];
+    while (!Worklist.empty())
+      for (const Function *Callee : DirectCallees.lookup(Worklist.pop_back_val()))
+        if (Callee != &F && Visited.insert(Callee).second) {
+          Names.push_back(Callee->getName().str());
+          Worklist.push_back(Callee);
+        }
+    llvm::sort(Names);
+  }
+}
+
+void IncrementalReuseReporter::runAfterPass(Any IR) {
+  if (--Depth != 0)
+    return;
+  // Functions may have been removed or renamed, so start over. The module is
+  // gone by the time this object is destroyed.
+  if (const Module *M = unwrapIR<Module>(IR)) {
+    OutputHashes.clear();
+    for (const Function &F : *M)
+      if (!F.isDeclaration())
+        OutputHashes[F.getName()] = StructuralHash(F, /*DetailedHash=*/true);
+  }
+}
+
+IncrementalReuseReporter::~IncrementalReuseReporter() {
+  if (!Enabled || InputHashes.empty())
+    return;
+
+  // The file holds one "<key> <optimized hash>" line per function.
+  DenseMap<stable_hash, IRHash> Recorded;
+  if (ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+          MemoryBuffer::getFile(IncrementalReuseFile, /*IsText=*/true)) {
+    SmallVector<StringRef, 0> Lines;
+    (*BufOrErr)->getBuffer().split(Lines, '\n', -1, /*KeepEmpty=*/false);
+    for (StringRef Line : Lines) {
+      auto [KeyStr, HashStr] = Line.split(' ');
+      stable_hash Key;
+      IRHash Hash;
+      if (!KeyStr.getAsInteger(16, Key) && !HashStr.getAsInteger(16, Hash))
+        Recorded[Key] = Hash;
+    }
+  }
+
+  unsigned Functions = 0, Hits = 0, Reusable = 0;
+  std::string Buf;
+  raw_string_ostream BufOS(Buf);
+  for (const auto &[Name, InputHash] : InputHashes) {
+    auto Out = OutputHashes.find(Name);
+    // Functions that were inlined and removed need no result of their own.
+    if (Out == OutputHashes.end())
+      continue;
+    ++Functions;
+    stable_hash Key = stable_hash_combine(TargetHash, PipelineHash, InputHash);
+    for (const std::string &Callee : Callees.lookup(Name))
+      Key = stable_hash_combine(Key, InputHashes.lookup(Callee));
+    auto It = Recorded.find(Key);
+    if (It == Recorded.end()) {
+      BufOS << format_hex_no_prefix(Key, 16) << ' '
+            << format_hex_no_prefix(Out->second, 16) << '\n';
+      continue;
+    }
+    ++Hits;
+    Reusable += It->second == Out->second;
+  }
+
+  std::error_code EC;
+  raw_fd_ostream OS(IncrementalReuseFile, EC, sys::fs::OF_Append);
+  if (EC)
+    errs() << "could not open " << IncrementalReuseFile << ": "
+           << EC.message() << '\n';
+  else
+    OS << Buf;
+
+  std::unique_ptr<raw_ostream> Report = CreateInfoOutputFile();
+  *Report << "Incremental reuse report: " << Functions << " functions, "
+          << Hits << " with a recorded key, " << Reusable
+          << " with the same optimized result, " << Hits - Reusable
+          << " with a different one\n";
+}
+
+// Return the number of instructions in an IR unit.
+static uint64_t getIRSize(Any IR) {
+  if (const auto *F = unwrapIR<Function>(IR))
+    return F->getInstructionCount();
+  if (const auto *M = unwrapIR<Module>(IR))
+    return M->getInstructionCount();
+  if (const auto *C = unwrapIR<LazyCallGraph::SCC>(IR)) {
+    uint64_t Size = 0;
+    for (const LazyCallGraph::Node &N : *C)
+      Size += N.getFunction().getInstructionCount();
+    return Size;
+  }
+  if (const auto *L = unwrapIR<Loop>(IR)) {
+    uint64_t Size = 0;
+    for (const BasicBlock *BB : L->blocks())
+      Size += BB->size();
+    return Size;
+  }
+  if (const auto *MF = unwrapIR<MachineFunction>(IR)) {
+    uint64_t Size = 0;
+    for (const MachineBasicBlock &MBB : *MF)
+      Size += MBB.size();
+    return Size;
+  }
+  llvm_unreachable("Unknown wrapped IR type");
+}
+
+void PassCostRecorder::registerCallbacks(PassInstrumentationCallbacks &PIC) {
+  N = PassCostTop;
+  if (!N)
+    return;
+  PIC.registerBeforeNonSkippedPassCallback(
+      [this](StringRef P, Any IR) { this->runBefore(IR); });
+  PIC.registerAfterPassCallback(
+      [this](StringRef P, Any IR, const PreservedAnalyses &) {
+        this->runAfter(P, IR);
+      },
+      true);
+  PIC.registerAfterPassInvalidatedCallback(
+      [this](StringRef P, const PreservedAnalyses &) {
+        this->runAfter(P, Any());
+      },
+      true);
+  PIC.registerBeforeAnalysisCallback(
+      [this](StringRef P, Any IR) { this->runBefore(IR); });
+  PIC.registerAfterAnalysisCallback(
+      [this](StringRef P, Any IR) { this->runAfter(P, IR); }, true);
+}
+
+void PassCostRecorder::runBefore(Any IR) {
+  Stack.push_back({Clock::now(), {}, getIRSize(IR)});
+}
+
+void PassCostRecorder::runAfter(StringRef PassID, Any IR) {
+  Frame F = Stack.pop_back_val();
+  Clock::duration Time = Clock::now() - F.Start;
+  if (!Stack.empty())
+    Stack.back().ChildTime += Time;
+
+  auto Cheaper = [](const Execution &A, const Execution &B) {
+    return A.SelfTime > B.SelfTime;
+  };
+  Clock::duration SelfTime = Time - F.ChildTime;
+  if (Top.size() == N) {
+    if (SelfTime <= Top.front().SelfTime)
+      return;
+    std::pop_heap(Top.begin(), Top.end(), Cheaper);
+    Top.pop_back();
+  }
+  // The IR unit is only gone if the pass invalidated it.
+  bool Deleted = !IR.has_value();
+  Top.push_back({PassID.str(), Deleted ? "<deleted>" : getIRName(IR),
+                 F.SizeBefore,
+                 Deleted ? std::nullopt : std::optional(getIRSize(IR)),
+                 SelfTime, Time});
+  std::push_heap(Top.begin(), Top.end(), Cheaper);
+}
+
+PassCostRecorder::~PassCostRecorder() {
+  if (Top.empty())
+    return;
+  std::sort_heap(Top.begin(), Top.end(), [](const Execution &A,
+                                            const Execution &B) {
+    return A.SelfTime > B.SelfTime;
+  });
+
+  std::error_code EC;
+  std::unique_ptr<raw_ostream> OS;
+  if (PassCostOutput.empty()) {
+    OS = CreateInfoOutputFile();
+  } else {
+    OS = std::make_unique<raw_fd_ostream>(PassCostOutput, EC,
+                                          sys::fs::OF_TextWithCRLF);
+    if (EC) {
+      errs() << "could not open " << PassCostOutput << ": " << EC.message()
+             << '\n';
+      return;
+    }
+  }
+
+  auto ToMicroseconds = [](Clock::duration D) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(D).count();
+  };
+  json::OStream J(*OS, /*IndentSize=*/2);
+  J.array([&] {
+    for (const Execution &E : Top)
+      J.object([&] {
+        J.attribute("pass", E.PassID);
+        J.attribute("ir", E.IRName);
+        J.attribute("size_before", E.SizeBefore);
+        if (E.SizeAfter)
+          J.attribute("size_after", *E.SizeAfter);
+        J.attribute("self_us", ToMicroseconds(E.SelfTime));
+        J.attribute("total_us", ToMicroseconds(E.Time));
+      });
+  });
+  *OS << '\n';
+}
+
 namespace {
 
 class DisplayNode;
@@ -2518,6 +2915,12 @@ void StandardInstrumentations::registerCallbacks(
   // AfterCallbacks by its `registerCallbacks`. This is necessary
   // to ensure that other callbacks are not included in the timings.
   TimeProfilingPasses.registerCallbacks(PIC);
+
+  // Similarly, AnalysisReuse measures the time of analyses without that of
+  // any other callbacks, including TimeProfiling.
+  AnalysisReuse.registerCallbacks(PIC);
+  IncrementalReuse.registerCallbacks(PIC);
+  PassCost.registerCallbacks(PIC);
 }
 
 template class ChangeReporter<std::string>;
@@ -519,6 +519,17 @@ inline ErrorOr<size_t> SampleProfileReaderBinary::readStringIndex(T &Table) {
 
 ErrorOr<FunctionId>
 SampleProfileReaderBinary::readStringFromTable(size_t *RetIdx) {
+  if (MD5NameMemStart) {
+    auto Idx = readNumber<size_t>();
+    if (std::error_code EC = Idx.getError())
+      return EC;
+    if (*Idx >= MD5NameTableSize)
+      return sampleprof_error::truncated_name_table;
+    if (RetIdx)
+      *RetIdx = *Idx;
+    return FunctionId(support::endian::read64le(MD5NameMemStart +
+                                                *Idx * sizeof(uint64_t)));
+  }
   auto Idx = readStringIndex(NameTable);
   if (std::error_code EC = Idx.getError())
     return EC;
@@ -1044,11 +1055,23 @@ std::error_code SampleProfileReaderExtBinary::verifySPMagic(uint64_t Magic) {
   return sampleprof_error::bad_magic;
 }
 
+void SampleProfileReaderBinary::materializeNameTable() {
+  if (!MD5NameMemStart)
+    return;
+  NameTable.reserve(MD5NameTableSize);
+  for (size_t I = 0; I < MD5NameTableSize; ++I)
+    NameTable.emplace_back(FunctionId(support::endian::read64le(
+        MD5NameMemStart + I * sizeof(uint64_t))));
+  MD5NameMemStart = nullptr;
+}
+
 std::error_code SampleProfileReaderBinary::readNameTable() {
   auto Size = readNumber<size_t>();
   if (std::error_code EC = Size.getError())
     return EC;
 
+  MD5NameMemStart = nullptr;
+
   // Normally if useMD5 is true, the name table should have MD5 values, not
   // strings, however in the case that ExtBinary profile has multiple name
   // tables mixing string and MD5, all of them have to be normalized to use MD5,
@@ -1100,14 +1123,11 @@ SampleProfileReaderExtBinaryBase::readNameTableSec(bool IsMD5,
     if (Data + (*Size) * sizeof(uint64_t) > End)
       return sampleprof_error::truncated;
 
+    // Most entries are never referenced by the profiles that are read, so
+    // don't decode the table, which can have millions of entries.
     NameTable.clear();
-    NameTable.reserve(*Size);
-    for (size_t I = 0; I < *Size; ++I) {
-      using namespace support;
-      uint64_t FID = endian::read<uint64_t, endianness::little, unaligned>(
-          Data + I * sizeof(uint64_t));
-      NameTable.emplace_back(FunctionId(FID));
-    }
+    MD5NameMemStart = Data;
+    MD5NameTableSize = *Size;
     if (!ProfileIsCS)
       MD5SampleContextStart = reinterpret_cast<const uint64_t *>(Data);
     Data = Data + (*Size) * sizeof(uint64_t);
@@ -1122,6 +1142,7 @@ SampleProfileReaderExtBinaryBase::readNameTableSec(bool IsMD5,
 
     NameTable.clear();
     NameTable.reserve(*Size);
+    MD5NameMemStart = nullptr;
     if (!ProfileIsCS)
       MD5SampleContextTable.resize(*Size);
     for (size_t I = 0; I < *Size; ++I) {
@@ -11,6 +11,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Memory.h"
 #include "llvm/Support/raw_ostream.h"
 
 namespace llvm {
@@ -26,6 +28,29 @@ void printBumpPtrAllocatorStats(unsigned NumSlabs, size_t BytesAllocated,
          << " (includes alignment, etc)\n";
 }
 
+void *allocateSlab(size_t Size, size_t Alignment, bool HugePages) {
+  if (!HugePages)
+    return allocate_buffer(Size, Alignment);
+  // Mapped memory is page aligned, which is enough for any slab.
+  std::error_code EC;
+  sys::MemoryBlock Block = sys::Memory::allocateMappedMemory(
+      Size, nullptr,
+      sys::Memory::MF_READ | sys::Memory::MF_WRITE | sys::Memory::MF_HUGE_HINT,
+      EC);
+  if (EC)
+    report_bad_alloc_error("Allocation of a huge page slab failed");
+  return Block.base();
+}
+
+void deallocateSlab(void *Ptr, size_t Size, size_t Alignment, bool HugePages) {
+  if (!HugePages) {
+    deallocate_buffer(Ptr, Size, Alignment);
+    return;
+  }
+  sys::MemoryBlock Block(Ptr, Size);
+  sys::Memory::releaseMappedMemory(Block);
+}
+
 } // namespace detail
 
 void PrintRecyclerStats(size_t Size,
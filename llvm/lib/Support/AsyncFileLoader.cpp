@@ -0,0 +1,112 @@
+//===- AsyncFileLoader.cpp - Load files on a thread pool ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/AsyncFileLoader.h"
+
+using namespace llvm;
+
+AsyncFileLoader::AsyncFileLoader(IntrusiveRefCntPtr<vfs::FileSystem> FS,
+                                 ThreadPoolStrategy S)
+    : FS(std::move(FS)), Pool(S) {}
+
+AsyncFileLoader::~AsyncFileLoader() { Pool.wait(); }
+
+std::future<AsyncFileLoader::BufferOrError>
+AsyncFileLoader::load(const Twine &Path, bool RequiresNullTerminator,
+                      bool IsVolatile) {
+  return run<BufferOrError>(
+      [Path = Path.str(), RequiresNullTerminator,
+       IsVolatile](vfs::FileSystem &FS) -> BufferOrError {
+        return FS.getBufferForFile(Path, /*FileSize=*/-1,
+                                   RequiresNullTerminator, IsVolatile);
+      });
+}
+
+std::vector<std::future<AsyncFileLoader::BufferOrError>>
+AsyncFileLoader::loadBatch(ArrayRef<std::string> Paths,
+                           bool RequiresNullTerminator, bool IsVolatile) {
+  std::vector<std::future<BufferOrError>> Result;
+  Result.reserve(Paths.size());
+  for (const std::string &Path : Paths)
+    Result.push_back(load(Path, RequiresNullTerminator, IsVolatile));
+  return Result;
+}
+
+namespace {
+// A file whose contents were read ahead of time.
+class LoadedFile : public vfs::File {
+public:
+  LoadedFile(std::unique_ptr<vfs::File> F, std::unique_ptr<MemoryBuffer> Buffer)
+      : F(std::move(F)), Buffer(std::move(Buffer)) {}
+
+  ErrorOr<vfs::Status> status() override { return F->status(); }
+  ErrorOr<std::string> getName() override { return F->getName(); }
+
+  ErrorOr<std::unique_ptr<MemoryBuffer>>
+  getBuffer(const Twine &Name, int64_t FileSize, bool RequiresNullTerminator,
+            bool IsVolatile) override {
+    // The prefetched buffer is null terminated, which satisfies any request.
+    if (Buffer)
+      return std::move(Buffer);
+    return F->getBuffer(Name, FileSize, RequiresNullTerminator, IsVolatile);
+  }
+
+  std::error_code close() override { return F->close(); }
+
+private:
+  std::unique_ptr<vfs::File> F;
+  std::unique_ptr<MemoryBuffer> Buffer;
+};
+} // namespace
+
+const char PrefetchingFileSystem::ID = 0;
+
+PrefetchingFileSystem::PrefetchingFileSystem(
+    IntrusiveRefCntPtr<vfs::FileSystem> FS, ThreadPoolStrategy S)
+    : RTTIExtends(FS), Loader(FS, S) {}
+
+void PrefetchingFileSystem::prefetch(ArrayRef<std::string> Paths) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  for (const std::string &Path : Paths) {
+    auto [It, Inserted] = Pending.try_emplace(Path);
+    if (!Inserted)
+      continue;
+    It->second = Loader.run<ErrorOr<PrefetchedFile>>(
+        [Path](vfs::FileSystem &FS) -> ErrorOr<PrefetchedFile> {
+          ErrorOr<std::unique_ptr<vfs::File>> F = FS.openFileForRead(Path);
+          if (!F)
+            return F.getError();
+          ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer =
+              (*F)->getBuffer(Path);
+          if (!Buffer)
+            return Buffer.getError();
+          return PrefetchedFile{std::move(*F), std::move(*Buffer)};
+        });
+  }
+}
+
+ErrorOr<std::unique_ptr<vfs::File>>
+PrefetchingFileSystem::openFileForRead(const Twine &Path) {
+  std::future<ErrorOr<PrefetchedFile>> Future;
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = Pending.find(Path.str());
+    if (It != Pending.end()) {
+      Future = std::move(It->second);
+      Pending.erase(It);
+    }
+  }
+  if (Future.valid()) {
+    // On failure, let the underlying file system report the error, as the
+    // file may have been created since it was prefetched.
+    if (ErrorOr<PrefetchedFile> Prefetched = Future.get())
+      return std::make_unique<LoadedFile>(std::move(Prefetched->File),
+                                          std::move(Prefetched->Buffer));
+  }
+  return ProxyFileSystem::openFileForRead(Path);
+}
@@ -13,7 +13,9 @@
 #include "llvm/Support/FileOutputBuffer.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/TimeProfiler.h"
 #include <system_error>
 
@@ -23,6 +25,10 @@
 #include <io.h>
 #endif
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 using namespace llvm;
 using namespace llvm::sys;
 
@@ -66,6 +72,20 @@ public:
     consumeError(Temp.discard());
   }
 
+  void releaseRange(size_t Offset, size_t Size) override {
+#if defined(__linux__)
+    // Only whole pages can be released. The mapping itself is page aligned.
+    uint64_t PageSize = sys::Process::getPageSizeEstimate();
+    uint64_t Begin = alignTo(Offset, PageSize);
+    uint64_t End = alignDown(std::min(Offset + Size, Buffer.size()), PageSize);
+    if (Begin >= End)
+      return;
+    // For a shared file mapping, MADV_DONTNEED keeps dirty pages in the page
+    // cache, so this only reduces the resident set of this process.
+    ::madvise(Buffer.data() + Begin, End - Begin, MADV_DONTNEED);
+#endif
+  }
+
 private:
   fs::mapped_file_region Buffer;
   fs::TempFile Temp;
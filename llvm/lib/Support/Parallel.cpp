@@ -39,18 +39,27 @@ namespace {
 class Executor {
 public:
   virtual ~Executor() = default;
-  virtual void add(std::function<void()> func, bool Sequential = false) = 0;
+  virtual void add(std::function<void()> func, const void *Group,
+                   bool Sequential = false) = 0;
+  virtual bool runLocalTask(const void *Group) = 0;
   virtual size_t getThreadCount() const = 0;
 
   static Executor *getDefaultExecutor();
 };
 
-/// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+/// An implementation of an Executor that runs closures on a thread pool.
+///
+/// Every worker thread has its own deque. Tasks spawned by a worker are added
+/// to the back of its deque and the worker runs them in filo order; idle
+/// workers steal from the front of the deques of the other workers, which
+/// holds the oldest and usually largest tasks. Tasks spawned by other threads
+/// go to a shared queue. Only sequential tasks and sleeping and waking up
+/// workers go through the shared mutex.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(ThreadPoolStrategy S = hardware_concurrency()) {
     ThreadCount = S.compute_thread_count();
+    Queues = std::make_unique<WorkerQueue[]>(ThreadCount);
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     Threads.reserve(ThreadCount);
@@ -98,55 +107,153 @@ public:
     static void call(void *Ptr) { ((ThreadPoolExecutor *)Ptr)->stop(); }
   };
 
-  void add(std::function<void()> F, bool Sequential = false) override {
-    {
-      std::lock_guard<std::mutex> Lock(Mutex);
-      if (Sequential)
+  void add(std::function<void()> F, const void *Group,
+           bool Sequential = false) override {
+    if (Sequential) {
+      {
+        std::lock_guard<std::mutex> Lock(Mutex);
         WorkQueueSequential.emplace_front(std::move(F));
-      else
-        WorkQueue.emplace_back(std::move(F));
+        ++NumSequential;
+      }
+      Cond.notify_one();
+      return;
+    }
+
+    // Count the task before queueing it so that the count never drops below
+    // the number of queued tasks.
+    ++NumGeneral;
+    if (threadIndex < ThreadCount) {
+      WorkerQueue &Queue = Queues[threadIndex];
+      std::lock_guard<std::mutex> Lock(Queue.Mutex);
+      Queue.Tasks.push_back({std::move(F), Group});
+    } else {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      WorkQueue.push_back({std::move(F), Group});
+      ++NumShared;
+    }
+    // Pairs with the increment of NumSleeping in work(): either the sleeping
+    // worker sees the new task or we see the sleeping worker.
+    if (NumSleeping) {
+      { std::lock_guard<std::mutex> Lock(Mutex); }
+      Cond.notify_one();
+    }
+  }
+
+  // Run the newest task of the calling worker if it belongs to \p Group.
+  bool runLocalTask(const void *Group) override {
+    if (threadIndex >= ThreadCount)
+      return false;
+    Task T;
+    {
+      WorkerQueue &Queue = Queues[threadIndex];
+      std::lock_guard<std::mutex> Lock(Queue.Mutex);
+      if (Queue.Tasks.empty() || Queue.Tasks.back().Group != Group)
+        return false;
+      T = std::move(Queue.Tasks.back());
+      Queue.Tasks.pop_back();
     }
-    Cond.notify_one();
+    --NumGeneral;
+    T.F();
+    return true;
   }
 
   size_t getThreadCount() const override { return ThreadCount; }
 
 private:
+  struct Task {
+    std::function<void()> F;
+    // The TaskGroup the task was spawned in.
+    const void *Group = nullptr;
+  };
+
+  struct WorkerQueue {
+    std::mutex Mutex;
+    std::deque<Task> Tasks;
+  };
+
   bool hasSequentialTasks() const {
     return !WorkQueueSequential.empty() && !SequentialQueueIsLocked;
   }
 
-  bool hasGeneralTasks() const { return !WorkQueue.empty(); }
+  bool runSequentialTask() {
+    if (!NumSequential || SequentialQueueIsLocked)
+      return false;
+    std::unique_lock<std::mutex> Lock(Mutex);
+    if (!hasSequentialTasks())
+      return false;
+    SequentialQueueIsLocked = true;
+    auto F = std::move(WorkQueueSequential.back());
+    WorkQueueSequential.pop_back();
+    --NumSequential;
+    Lock.unlock();
+    F();
+    SequentialQueueIsLocked = false;
+    return true;
+  }
+
+  bool popTask(unsigned ThreadID, Task &T) {
+    {
+      WorkerQueue &Queue = Queues[ThreadID];
+      std::lock_guard<std::mutex> Lock(Queue.Mutex);
+      if (!Queue.Tasks.empty()) {
+        T = std::move(Queue.Tasks.back());
+        Queue.Tasks.pop_back();
+        return true;
+      }
+    }
+    if (NumShared) {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      if (!WorkQueue.empty()) {
+        T = std::move(WorkQueue.back());
+        WorkQueue.pop_back();
+        --NumShared;
+        return true;
+      }
+    }
+    for (unsigned I = 1; I < ThreadCount; ++I) {
+      WorkerQueue &Victim = Queues[(ThreadID + I) % ThreadCount];
+      std::lock_guard<std::mutex> Lock(Victim.Mutex);
+      if (!Victim.Tasks.empty()) {
+        T = std::move(Victim.Tasks.front());
+        Victim.Tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
 
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
     threadIndex = ThreadID;
     S.apply_thread_strategy(ThreadID);
-    while (true) {
+    while (!Stop) {
+      if (runSequentialTask())
+        continue;
+
+      Task T;
+      if (NumGeneral && popTask(ThreadID, T)) {
+        --NumGeneral;
+        T.F();
+        continue;
+      }
+
       std::unique_lock<std::mutex> Lock(Mutex);
+      ++NumSleeping;
       Cond.wait(Lock, [&] {
-        return Stop || hasGeneralTasks() || hasSequentialTasks();
+        return Stop || NumGeneral || hasSequentialTasks();
       });
-      if (Stop)
-        break;
-      bool Sequential = hasSequentialTasks();
-      if (Sequential)
-        SequentialQueueIsLocked = true;
-      else
-        assert(hasGeneralTasks());
-
-      auto &Queue = Sequential ? WorkQueueSequential : WorkQueue;
-      auto Task = std::move(Queue.back());
-      Queue.pop_back();
-      Lock.unlock();
-      Task();
-      if (Sequential)
-        SequentialQueueIsLocked = false;
+      --NumSleeping;
     }
   }
 
   std::atomic<bool> Stop{false};
   std::atomic<bool> SequentialQueueIsLocked{false};
-  std::deque<std::function<void()>> WorkQueue;
+  // Number of tasks in all the deques and the shared queue.
+  std::atomic<size_t> NumGeneral{0};
+  std::atomic<size_t> NumShared{0};
+  std::atomic<size_t> NumSequential{0};
+  std::atomic<unsigned> NumSleeping{0};
+  std::unique_ptr<WorkerQueue[]> Queues;
+  std::deque<Task> WorkQueue;
   std::deque<std::function<void()>> WorkQueueSequential;
   std::mutex Mutex;
   std::condition_variable Cond;
@@ -188,37 +295,51 @@ size_t getThreadCount() {
 }
 #endif
 
-// Latch::sync() called by the dtor may cause one thread to block. If is a dead
-// lock if all threads in the default executor are blocked. To prevent the dead
-// lock, only allow the root TaskGroup to run tasks parallelly. In the scenario
-// of nested parallel_for_each(), only the outermost one runs parallelly.
+// A TaskGroup created on a worker thread of the default executor is nested in
+// a task of another group. When it is synced, the worker runs the tasks of the
+// group that are still in its own deque instead of blocking; the tasks stolen
+// by other workers are already running. This avoids the dead lock of all
+// workers blocking in sync() while the tasks they wait for are queued.
 TaskGroup::TaskGroup()
 #if LLVM_ENABLE_THREADS
-    : Parallel((parallel::strategy.ThreadsRequested != 1) &&
-               (threadIndex == UINT_MAX)) {}
+    : Parallel(parallel::strategy.ThreadsRequested != 1),
+      Nested(threadIndex != UINT_MAX) {}
 #else
-    : Parallel(false) {}
+    : Parallel(false), Nested(false) {}
 #endif
 TaskGroup::~TaskGroup() {
   // We must ensure that all the workloads have finished before decrementing the
   // instances count.
-  L.sync();
+  sync();
 }
 
 void TaskGroup::spawn(std::function<void()> F, bool Sequential) {
 #if LLVM_ENABLE_THREADS
-  if (Parallel) {
+  // Sequential tasks of a nested group run right away, as the shared
+  // sequential queue could be waiting for the worker blocked on this group.
+  if (Parallel && !(Sequential && Nested)) {
     L.inc();
     detail::Executor::getDefaultExecutor()->add(
         [&, F = std::move(F)] {
-          F();
+          if (!isCancelled())
+            F();
           L.dec();
         },
-        Sequential);
+        this, Sequential);
     return;
   }
 #endif
-  F();
+  if (!isCancelled())
+    F();
+}
+
+void TaskGroup::sync() const {
+#if LLVM_ENABLE_THREADS
+  if (Parallel && Nested)
+    while (detail::Executor::getDefaultExecutor()->runLocalTask(this))
+      ;
+#endif
+  L.sync();
 }
 
 } // namespace parallel
@@ -235,17 +356,18 @@ void llvm::parallelFor(size_t Begin, size_t End,
     if (TaskSize == 0)
       TaskSize = 1;
 
+    // Spawn one task per thread, each of which keeps claiming the next chunk
+    // of TaskSize items, so threads that get cheap items take more of them.
+    size_t NumChunks = (NumItems + TaskSize - 1) / TaskSize;
+    size_t NumTasks = std::min(NumChunks, parallel::getThreadCount());
+    std::atomic<size_t> Next{Begin};
     parallel::TaskGroup TG;
-    for (; Begin + TaskSize < End; Begin += TaskSize) {
-      TG.spawn([=, &Fn] {
-        for (size_t I = Begin, E = Begin + TaskSize; I != E; ++I)
-          Fn(I);
-      });
-    }
-    if (Begin != End) {
-      TG.spawn([=, &Fn] {
-        for (size_t I = Begin; I != End; ++I)
-          Fn(I);
+    for (size_t I = 0; I != NumTasks; ++I) {
+      TG.spawn([=, &Next, &Fn] {
+        for (size_t B = Next.fetch_add(TaskSize); B < End;
+             B = Next.fetch_add(TaskSize))
+          for (size_t J = B, E = std::min(B + TaskSize, End); J != E; ++J)
+            Fn(J);
       });
     }
     return;
@@ -269,7 +269,11 @@ void SuffixTree::RepeatedSubstringIterator::advance() {
     if (RepeatedSubstringStarts.size() < 2)
       continue;
 
-    // Yes. Update the state to reflect this, and then bail out.
+    // Yes. Update the state to reflect this, and then bail out. Report the
+    // occurrences from left to right rather than in the order of the child
+    // table, so that the result does not depend on the table's layout and a
+    // greedy scan for non-overlapping occurrences keeps as many as possible.
+    llvm::sort(RepeatedSubstringStarts);
     N = Curr;
     RS.Length = Length;
     for (unsigned StartIdx : RepeatedSubstringStarts)
@@ -97,8 +97,11 @@ const std::optional<unsigned> llvm::thread::DefaultStackSize;
 
 std::optional<ThreadPoolStrategy>
 llvm::get_threadpool_strategy(StringRef Num, ThreadPoolStrategy Default) {
-  if (Num == "all")
-    return llvm::hardware_concurrency();
+  if (Num == "all") {
+    ThreadPoolStrategy S = llvm::hardware_concurrency();
+    S.PinThreads = Default.PinThreads;
+    return S;
+  }
   if (Num.empty())
     return Default;
   unsigned V;
@@ -112,5 +115,6 @@ llvm::get_threadpool_strategy(StringRef Num, ThreadPoolStrategy Default) {
   // threads on the cmd-line.
   ThreadPoolStrategy S = llvm::hardware_concurrency();
   S.ThreadsRequested = V;
+  S.PinThreads = Default.PinThreads;
   return S;
 }
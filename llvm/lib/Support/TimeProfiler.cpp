@@ -14,6 +14,8 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/JSON.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
@@ -96,12 +98,73 @@ struct llvm::TimeTraceProfilerEntry {
   }
 };
 
+// Returned by begin() in sampling mode, where entries are not materialized.
+static TimeTraceProfilerEntry &getSampledEntry() {
+  static TimeTraceProfilerEntry Entry(TimePointType(), TimePointType(),
+                                      std::string(), std::string(), false);
+  return Entry;
+}
+
+// Returned for async events, which are not recorded in sampling mode.
+static TimeTraceProfilerEntry &getIgnoredEntry() {
+  static TimeTraceProfilerEntry Entry(TimePointType(), TimePointType(),
+                                      std::string(), std::string(), true);
+  return Entry;
+}
+
+namespace {
+
+/// A node of the call tree built in sampling mode. There is one node per
+/// distinct stack of section names.
+struct CallNode {
+  StringRef Name;
+  CallNode *Parent = nullptr;
+  SmallVector<CallNode *, 4> Children;
+  // Time spent in sections with this stack that were not spent in nested
+  // sections above the threshold.
+  DurationType Self{};
+  size_t Count = 0;
+};
+
+/// A completed section kept in the ring buffer of a sampling profiler.
+struct SampleRecord {
+  const CallNode *Node;
+  TimePointType Start;
+  TimePointType End;
+};
+
+/// An open section of a sampling profiler.
+struct SampleFrame {
+  CallNode *Node;
+  TimePointType Start;
+  DurationType ChildTime{};
+};
+
+} // anonymous namespace
+
 struct llvm::TimeTraceProfiler {
-  TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "")
+  TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "",
+                    unsigned RingBufferSize = 0)
       : BeginningOfTime(system_clock::now()), StartTime(ClockType::now()),
         ProcName(ProcName), Pid(sys::Process::getProcessId()),
-        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity) {
+        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity),
+        Sampling(RingBufferSize != 0) {
     llvm::get_thread_name(ThreadName);
+    if (Sampling) {
+      Ring.resize(RingBufferSize);
+      SampleStack.push_back({&Root, StartTime});
+    }
+  }
+
+  TimeTraceProfilerEntry *begin(StringRef Name,
+                                llvm::function_ref<std::string()> Detail,
+                                bool AsyncEvent = false) {
+    if (!Sampling)
+      return begin(std::string(Name), Detail, AsyncEvent);
+    if (AsyncEvent)
+      return &getIgnoredEntry();
+    beginSample(Name);
+    return &getSampledEntry();
   }
 
   TimeTraceProfilerEntry *begin(std::string Name,
@@ -113,12 +176,56 @@ struct llvm::TimeTraceProfiler {
     return Stack.back().get();
   }
 
+  // Enter a section in sampling mode. This only allocates the first time a
+  // stack of section names is seen.
+  void beginSample(StringRef Name) {
+    StringRef Interned = Names.insert(Name).first->getKey();
+    CallNode *Parent = SampleStack.back().Node;
+    CallNode *Node = nullptr;
+    for (CallNode *Child : Parent->Children)
+      if (Child->Name.data() == Interned.data()) {
+        Node = Child;
+        break;
+      }
+    if (!Node) {
+      Node = new (Nodes.Allocate()) CallNode();
+      Node->Name = Interned;
+      Node->Parent = Parent;
+      Parent->Children.push_back(Node);
+    }
+    SampleStack.push_back({Node, ClockType::now()});
+  }
+
+  // Leave the innermost section in sampling mode. Sections shorter than the
+  // threshold are attributed to their parent.
+  void endSample() {
+    assert(SampleStack.size() > 1 && "Must call begin() first");
+    SampleFrame F = SampleStack.pop_back_val();
+    TimePointType End = ClockType::now();
+    DurationType Duration = End - F.Start;
+    if (duration_cast<microseconds>(Duration).count() < TimeTraceGranularity)
+      return;
+    F.Node->Self += Duration - F.ChildTime;
+    ++F.Node->Count;
+    SampleStack.back().ChildTime += Duration;
+    Ring[RingNext] = {F.Node, F.Start, End};
+    RingNext = RingNext + 1 == Ring.size() ? 0 : RingNext + 1;
+    RingFull |= RingNext == 0;
+  }
+
   void end() {
+    if (Sampling)
+      return endSample();
     assert(!Stack.empty() && "Must call begin() first");
     end(*Stack.back().get());
   }
 
   void end(TimeTraceProfilerEntry &E) {
+    if (Sampling) {
+      if (&E != &getIgnoredEntry())
+        endSample();
+      return;
+    }
     assert(!Stack.empty() && "Must call begin() first");
     E.End = ClockType::now();
 
@@ -155,11 +262,17 @@ struct llvm::TimeTraceProfiler {
     // Acquire Mutex as reading ThreadTimeTraceProfilerInstances.
     auto &Instances = getTimeTraceProfilerInstances();
     std::lock_guard<std::mutex> Lock(Instances.Lock);
-    assert(Stack.empty() &&
+    assert(Stack.empty() && SampleStack.size() <= 1 &&
            "All profiler sections should be ended when calling write");
     assert(llvm::all_of(Instances.List,
-                        [](const auto &TTP) { return TTP->Stack.empty(); }) &&
+                        [](const auto &TTP) {
+                          return TTP->Stack.empty() &&
+                                 TTP->SampleStack.size() <= 1;
+                        }) &&
            "All profiler sections should be ended when calling write");
+    materializeSamples();
+    for (TimeTraceProfiler *TTP : Instances.List)
+      TTP->materializeSamples();
 
     json::OStream J(OS);
     J.objectBegin();
@@ -293,6 +406,43 @@ struct llvm::TimeTraceProfiler {
     J.objectEnd();
   }
 
+  // Move the sections kept in the ring buffer to Entries, oldest first.
+  void materializeSamples() {
+    if (!Sampling)
+      return;
+    size_t First = RingFull ? RingNext : 0;
+    size_t Size = RingFull ? Ring.size() : RingNext;
+    for (size_t I = 0; I != Size; ++I) {
+      const SampleRecord &R = Ring[(First + I) % Ring.size()];
+      Entries.emplace_back(TimePointType(R.Start), TimePointType(R.End),
+                           R.Node->Name.str(), std::string(), false);
+    }
+    RingNext = 0;
+    RingFull = false;
+  }
+
+  // Add the self time of every stack of section names in the call tree to
+  // Stacks, keyed by the names separated by semicolons.
+  void collectFoldedStacks(StringMap<CountAndDurationType> &Stacks) const {
+    std::string Path;
+    auto Visit = [&](const CallNode &Node, auto &Visit) -> void {
+      size_t OldSize = Path.size();
+      if (!Path.empty())
+        Path += ';';
+      Path += Node.Name;
+      if (Node.Count) {
+        auto &CountAndTotal = Stacks[Path];
+        CountAndTotal.first += Node.Count;
+        CountAndTotal.second += Node.Self;
+      }
+      for (const CallNode *Child : Node.Children)
+        Visit(*Child, Visit);
+      Path.resize(OldSize);
+    };
+    for (const CallNode *Child : Root.Children)
+      Visit(*Child, Visit);
+  }
+
   SmallVector<std::unique_ptr<TimeTraceProfilerEntry>, 16> Stack;
   SmallVector<TimeTraceProfilerEntry, 128> Entries;
   StringMap<CountAndDurationType> CountAndTotalPerName;
@@ -307,6 +457,17 @@ struct llvm::TimeTraceProfiler {
 
   // Minimum time granularity (in microseconds)
   const unsigned TimeTraceGranularity;
+
+  // Sampling mode: sections are aggregated into a call tree and the most
+  // recent ones are kept in a fixed size ring buffer.
+  const bool Sampling;
+  StringSet<> Names;
+  SpecificBumpPtrAllocator<CallNode> Nodes;
+  CallNode Root;
+  SmallVector<SampleFrame, 16> SampleStack;
+  std::vector<SampleRecord> Ring;
+  size_t RingNext = 0;
+  bool RingFull = false;
 };
 
 void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
@@ -317,6 +478,18 @@ void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
       TimeTraceGranularity, llvm::sys::path::filename(ProcName));
 }
 
+void llvm::timeTraceProfilerInitializeSampling(unsigned TimeTraceGranularity,
+                                               unsigned RingBufferSize,
+                                               StringRef ProcName) {
+  assert(TimeTraceProfilerInstance == nullptr &&
+         "Profiler should not be initialized");
+  assert(RingBufferSize != 0 && "Ring buffer must not be empty");
+  TimeTraceProfilerInstance =
+      new TimeTraceProfiler(TimeTraceGranularity,
+                            llvm::sys::path::filename(ProcName),
+                            RingBufferSize);
+}
+
 // Removes all TimeTraceProfilerInstances.
 // Called from main thread.
 void llvm::timeTraceProfilerCleanup() {
@@ -345,6 +518,30 @@ void llvm::timeTraceProfilerWrite(raw_pwrite_stream &OS) {
   TimeTraceProfilerInstance->write(OS);
 }
 
+void llvm::timeTraceProfilerWriteFoldedStacks(raw_ostream &OS) {
+  assert(TimeTraceProfilerInstance != nullptr &&
+         "Profiler object can't be null");
+  auto &Instances = getTimeTraceProfilerInstances();
+  std::lock_guard<std::mutex> Lock(Instances.Lock);
+
+  // Merge the stacks of all threads, and emit them sorted so that outputs of
+  // different processes can be concatenated and merged line by line.
+  StringMap<CountAndDurationType> Stacks;
+  TimeTraceProfilerInstance->collectFoldedStacks(Stacks);
+  for (const TimeTraceProfiler *TTP : Instances.List)
+    TTP->collectFoldedStacks(Stacks);
+
+  std::vector<StringRef> Keys;
+  Keys.reserve(Stacks.size());
+  for (const auto &Stack : Stacks)
+    Keys.push_back(Stack.getKey());
+  llvm::sort(Keys);
+  for (StringRef Key : Keys)
+    OS << Key << ' '
+       << duration_cast<microseconds>(Stacks.lookup(Key).second).count()
+       << '\n';
+}
+
 Error llvm::timeTraceProfilerWrite(StringRef PreferredFileName,
                                    StringRef FallbackFileName) {
   assert(TimeTraceProfilerInstance != nullptr &&
@@ -369,7 +566,7 @@ TimeTraceProfilerEntry *llvm::timeTraceProfilerBegin(StringRef Name,
                                                      StringRef Detail) {
   if (TimeTraceProfilerInstance != nullptr)
     return TimeTraceProfilerInstance->begin(
-        std::string(Name), [&]() { return std::string(Detail); }, false);
+        Name, [&]() { return std::string(Detail); }, false);
   return nullptr;
 }
 
@@ -377,7 +574,7 @@ TimeTraceProfilerEntry *
 llvm::timeTraceProfilerBegin(StringRef Name,
                              llvm::function_ref<std::string()> Detail) {
   if (TimeTraceProfilerInstance != nullptr)
-    return TimeTraceProfilerInstance->begin(std::string(Name), Detail, false);
+    return TimeTraceProfilerInstance->begin(Name, Detail, false);
   return nullptr;
 }
 
@@ -385,7 +582,7 @@ TimeTraceProfilerEntry *llvm::timeTraceAsyncProfilerBegin(StringRef Name,
                                                           StringRef Detail) {
   if (TimeTraceProfilerInstance != nullptr)
     return TimeTraceProfilerInstance->begin(
-        std::string(Name), [&]() { return std::string(Detail); }, true);
+        Name, [&]() { return std::string(Detail); }, true);
   return nullptr;
 }
 
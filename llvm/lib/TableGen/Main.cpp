@@ -17,6 +17,9 @@
 #include "llvm/TableGen/Main.h"
 #include "TGLexer.h"
 #include "TGParser.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/CommandLine.h"
@@ -63,6 +66,13 @@ WriteIfChanged("write-if-changed", cl::desc("Only write output if it changed"));
 static cl::opt<bool>
 TimePhases("time-phases", cl::desc("Time phases of parser and backend"));
 
+static cl::list<std::string> EmitTo(
+    "emit-to",
+    cl::desc("Run the backend <action> and write its output to <filename>. "
+             "May be given several times to parse the input only once for "
+             "several backends"),
+    cl::value_desc("action=filename"));
+
 static cl::opt<bool> NoWarnOnUnusedTemplateArgs(
     "no-warn-on-unused-template-args",
     cl::desc("Disable unused template argument warnings."));
@@ -77,8 +87,10 @@ static int reportError(const char *ProgName, Twine Msg) {
 ///
 /// This functionality is really only for the benefit of the build system.
 /// It is similar to GCC's `-M*` family of options.
-static int createDependencyFile(const TGParser &Parser, const char *argv0) {
-  if (OutputFilename == "-")
+static int createDependencyFile(const TGParser &Parser,
+                                ArrayRef<std::string> Outputs,
+                                const char *argv0) {
+  if (Outputs.empty() || Outputs.front() == "-")
     return reportError(argv0, "the option -d must be used together with -o\n");
 
   std::error_code EC;
@@ -86,7 +98,7 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   if (EC)
     return reportError(argv0, "error opening " + DependFilename + ":" +
                                   EC.message() + "\n");
-  DepOut.os() << OutputFilename << ":";
+  DepOut.os() << join(Outputs, " ") << ":";
   for (const auto &Dep : Parser.getDependencies()) {
     DepOut.os() << ' ' << Dep;
   }
@@ -95,6 +107,79 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   return 0;
 }
 
+/// Write \p Contents to \p Filename, leaving the file alone if it is
+/// unchanged and -write-if-changed is given.
+static int writeOutput(const char *argv0, StringRef Filename,
+                       StringRef Contents) {
+  if (WriteIfChanged) {
+    // Only updates the real output file if there are any differences.
+    // This prevents recompilation of all the files depending on it if there
+    // aren't any.
+    if (auto ExistingOrErr = MemoryBuffer::getFile(Filename, /*IsText=*/true))
+      if (std::move(ExistingOrErr.get())->getBuffer() == Contents)
+        return 0;
+  }
+
+  std::error_code EC;
+  ToolOutputFile OutFile(Filename, EC, sys::fs::OF_Text);
+  if (EC)
+    return reportError(argv0, "error opening " + Filename + ": " +
+                                  EC.message() + "\n");
+  OutFile.os() << Contents;
+  if (ErrorsPrinted == 0)
+    OutFile.keep();
+  return 0;
+}
+
+/// Run every backend given with -emit-to on the records parsed once.
+///
+/// The backends run one after the other on the same RecordKeeper. They cannot
+/// run concurrently, because resolving and uniquing values as well as the
+/// derived definitions cache mutate the RecordKeeper.
+static int runEmitTo(const char *argv0, RecordKeeper &Records,
+                     const TGParser &Parser) {
+  auto &Action = *TableGen::Emitter::Action;
+  SmallVector<TableGen::Emitter::FnT> Backends;
+  SmallVector<std::string> Outputs;
+  for (StringRef Arg : EmitTo) {
+    auto [Name, Filename] = Arg.split('=');
+    Name = Name.ltrim('-');
+    if (Filename.empty())
+      return reportError(argv0, "expected <action>=<filename> in -emit-to=" +
+                                    Arg + "\n");
+    TableGen::Emitter::FnT ActionFn;
+    if (Action.getParser().parse(Action, Name, Name, ActionFn))
+      return 1;
+    Backends.push_back(ActionFn);
+    Outputs.push_back(Filename.str());
+  }
+
+  SmallVector<std::string> Contents;
+  for (auto [ActionFn, Filename] : zip_equal(Backends, Outputs)) {
+    Records.startBackendTimer("Backend " + Filename);
+    std::string OutString;
+    raw_string_ostream Out(OutString);
+    ActionFn(Records, Out);
+    Records.stopBackendTimer();
+    Contents.push_back(std::move(OutString));
+  }
+
+  if (!DependFilename.empty())
+    if (int Ret = createDependencyFile(Parser, Outputs, argv0))
+      return Ret;
+
+  Records.startTimer("Write output");
+  for (auto [Filename, Content] : zip_equal(Outputs, Contents))
+    if (int Ret = writeOutput(argv0, Filename, Content))
+      return Ret;
+  Records.stopTimer();
+  Records.stopPhaseTiming();
+
+  if (ErrorsPrinted > 0)
+    return reportError(argv0, Twine(ErrorsPrinted) + " errors.\n");
+  return 0;
+}
+
 int llvm::TableGenMain(const char *argv0,
                        std::function<TableGenMainFn> MainFn) {
   RecordKeeper Records;
@@ -126,6 +211,9 @@ int llvm::TableGenMain(const char *argv0,
     return 1;
   Records.stopTimer();
 
+  if (!EmitTo.empty())
+    return runEmitTo(argv0, Records, Parser);
+
   // Write output to memory.
   Records.startBackendTimer("Backend overall");
   std::string OutString;
@@ -147,32 +235,13 @@ int llvm::TableGenMain(const char *argv0,
   // the early exit below and someone deleted the .inc.d file but not the .inc
   // file, tablegen would never write the depfile.
   if (!DependFilename.empty()) {
-    if (int Ret = createDependencyFile(Parser, argv0))
+    if (int Ret = createDependencyFile(Parser, {OutputFilename}, argv0))
       return Ret;
   }
 
   Records.startTimer("Write output");
-  bool WriteFile = true;
-  if (WriteIfChanged) {
-    // Only updates the real output file if there are any differences.
-    // This prevents recompilation of all the files depending on it if there
-    // aren't any.
-    if (auto ExistingOrErr =
-            MemoryBuffer::getFile(OutputFilename, /*IsText=*/true))
-      if (std::move(ExistingOrErr.get())->getBuffer() == Out.str())
-        WriteFile = false;
-  }
-  if (WriteFile) {
-    std::error_code EC;
-    ToolOutputFile OutFile(OutputFilename, EC, sys::fs::OF_Text);
-    if (EC)
-      return reportError(argv0, "error opening " + OutputFilename + ": " +
-                                    EC.message() + "\n");
-    OutFile.os() << Out.str();
-    if (ErrorsPrinted == 0)
-      OutFile.keep();
-  }
-  
+  if (int Ret = writeOutput(argv0, OutputFilename, Out.str()))
+    return Ret;
   Records.stopTimer();
   Records.stopPhaseTiming();
 
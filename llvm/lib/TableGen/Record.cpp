@@ -3283,13 +3283,16 @@ Init *MapResolver::resolve(Init *VarName) {
 }
 
 Init *RecordResolver::resolve(Init *VarName) {
-  Init *Val = Cache.lookup(VarName);
-  if (Val)
-    return Val;
+  // Names that do not resolve are cached as well, so that they are not looked
+  // up in the record again for every reference.
+  auto It = Cache.find(VarName);
+  if (It != Cache.end())
+    return It->second;
 
   if (llvm::is_contained(Stack, VarName))
     return nullptr; // prevent infinite recursion
 
+  Init *Val = nullptr;
   if (RecordVal *RV = getCurrentRecord()->getValue(VarName)) {
     if (!isa<UnsetInit>(RV->getValue())) {
       Val = RV->getValue();
@@ -483,6 +483,34 @@ X86LegalizerInfo::X86LegalizerInfo(const X86Subtarget &STI,
       .clampScalar(0, s32, sMaxScalar)
       .widenScalarToNextPow2(1);
 
+  // On 64-bit targets a 32-bit unsigned value fits in a non-negative 64-bit
+  // signed one, so unsigned conversions use the 64-bit signed instructions.
+  getActionDefinitionsBuilder(G_UITOFP)
+      .customIf([=](const LegalityQuery &Query) {
+        return Is64Bit && typeIs(1, s32)(Query) &&
+               ((HasSSE1 && typeIs(0, s32)(Query)) ||
+                (HasSSE2 && typeIs(0, s64)(Query)));
+      })
+      .clampScalar(1, s32, sMaxScalar)
+      .widenScalarToNextPow2(1)
+      .clampScalar(0, s32, HasSSE2 ? s64 : s32)
+      .widenScalarToNextPow2(0);
+
+  getActionDefinitionsBuilder(G_FPTOUI)
+      .customIf([=](const LegalityQuery &Query) {
+        return Is64Bit && typeIs(0, s32)(Query) &&
+               ((HasSSE1 && typeIs(1, s32)(Query)) ||
+                (HasSSE2 && typeIs(1, s64)(Query)));
+      })
+      .lowerIf([=](const LegalityQuery &Query) {
+        return Is64Bit && typeIs(0, s64)(Query) &&
+               ((HasSSE1 && typeIs(1, s32)(Query)) ||
+                (HasSSE2 && typeIs(1, s64)(Query)));
+      })
+      .clampScalar(1, s32, HasSSE2 ? s64 : s32)
+      .widenScalarToNextPow2(0)
+      .clampScalar(0, s32, sMaxScalar);
+
   // vector ops
   getActionDefinitionsBuilder({G_EXTRACT, G_INSERT})
       .legalIf([=](const LegalityQuery &Query) {
@@ -552,6 +580,40 @@ X86LegalizerInfo::X86LegalizerInfo(const X86Subtarget &STI,
   verify(*STI.getInstrInfo());
 }
 
+bool X86LegalizerInfo::legalizeCustom(LegalizerHelper &Helper, MachineInstr &MI,
+                                      LostDebugLocObserver &LocObserver) const {
+  switch (MI.getOpcode()) {
+  default:
+    return false;
+  case TargetOpcode::G_UITOFP:
+    return legalizeUITOFP(MI, Helper);
+  case TargetOpcode::G_FPTOUI:
+    return legalizeFPTOUI(MI, Helper);
+  }
+}
+
+bool X86LegalizerInfo::legalizeUITOFP(MachineInstr &MI,
+                                      LegalizerHelper &Helper) const {
+  MachineIRBuilder &MIRBuilder = Helper.MIRBuilder;
+  auto [Dst, Src] = MI.getFirst2Regs();
+  auto Ext = MIRBuilder.buildZExt(LLT::scalar(64), Src);
+  MIRBuilder.buildSITOFP(Dst, Ext);
+  MI.eraseFromParent();
+  return true;
+}
+
+bool X86LegalizerInfo::legalizeFPTOUI(MachineInstr &MI,
+                                      LegalizerHelper &Helper) const {
+  // Values that do not fit in 32 bits give poison, so the low half of the
+  // 64-bit signed conversion is the result.
+  MachineIRBuilder &MIRBuilder = Helper.MIRBuilder;
+  auto [Dst, Src] = MI.getFirst2Regs();
+  auto FPTOSI = MIRBuilder.buildFPTOSI(LLT::scalar(64), Src);
+  MIRBuilder.buildTrunc(Dst, FPTOSI);
+  MI.eraseFromParent();
+  return true;
+}
+
 bool X86LegalizerInfo::legalizeIntrinsic(LegalizerHelper &Helper,
                                          MachineInstr &MI) const {
   return true;
@@ -30,8 +30,15 @@ private:
 public:
   X86LegalizerInfo(const X86Subtarget &STI, const X86TargetMachine &TM);
 
+  bool legalizeCustom(LegalizerHelper &Helper, MachineInstr &MI,
+                      LostDebugLocObserver &LocObserver) const override;
+
   bool legalizeIntrinsic(LegalizerHelper &Helper,
                          MachineInstr &MI) const override;
+
+private:
+  bool legalizeUITOFP(MachineInstr &MI, LegalizerHelper &Helper) const;
+  bool legalizeFPTOUI(MachineInstr &MI, LegalizerHelper &Helper) const;
 };
 } // namespace llvm
 #endif
@@ -1634,9 +1634,14 @@ Expected<bool> FunctionImporter::importFunctions(
       return std::move(Err);
 
     auto &ImportGUIDs = FunctionsToImportPerModule->second;
-    // Find the globals to import
+    // Find the globals to import. Computing the GUID of every global value
+    // is not free in large modules, so stop looking once all are found.
     SetVector<GlobalValue *> GlobalsToImport;
+    unsigned NumFound = 0;
+    auto FoundAll = [&] { return NumFound == ImportGUIDs.size(); };
     for (Function &F : *SrcModule) {
+      if (FoundAll())
+        break;
       if (!F.hasName())
         continue;
       auto GUID = F.getGUID();
@@ -1645,6 +1650,7 @@ Expected<bool> FunctionImporter::importFunctions(
                         << GUID << " " << F.getName() << " from "
                         << SrcModule->getSourceFileName() << "\n");
       if (Import) {
+        ++NumFound;
         if (Error Err = F.materialize())
           return std::move(Err);
         // MemProf should match function's definition and summary,
@@ -1667,6 +1673,8 @@ Expected<bool> FunctionImporter::importFunctions(
       }
     }
     for (GlobalVariable &GV : SrcModule->globals()) {
+      if (FoundAll())
+        break;
       if (!GV.hasName())
         continue;
       auto GUID = GV.getGUID();
@@ -1675,12 +1683,15 @@ Expected<bool> FunctionImporter::importFunctions(
                         << GUID << " " << GV.getName() << " from "
                         << SrcModule->getSourceFileName() << "\n");
       if (Import) {
+        ++NumFound;
         if (Error Err = GV.materialize())
           return std::move(Err);
         ImportedGVCount += GlobalsToImport.insert(&GV);
       }
     }
     for (GlobalAlias &GA : SrcModule->aliases()) {
+      if (FoundAll())
+        break;
       if (!GA.hasName() || isa<GlobalIFunc>(GA.getAliaseeObject()))
         continue;
       auto GUID = GA.getGUID();
@@ -1689,6 +1700,7 @@ Expected<bool> FunctionImporter::importFunctions(
                         << GUID << " " << GA.getName() << " from "
                         << SrcModule->getSourceFileName() << "\n");
       if (Import) {
+        ++NumFound;
         if (Error Err = GA.materialize())
           return std::move(Err);
         // Import alias as a copy of its aliasee.
@@ -12,6 +12,7 @@
 #include "llvm/Analysis/ConstantFolding.h"
 #include "llvm/Analysis/InlineCost.h"
 #include "llvm/Analysis/InstructionSimplify.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/Analysis/ValueLattice.h"
 #include "llvm/Analysis/ValueLatticeUtils.h"
@@ -65,6 +66,11 @@ static cl::opt<unsigned> MaxCodeSizeGrowth(
     "funcspec-max-codesize-growth", cl::init(3), cl::Hidden, cl::desc(
     "Maximum codesize growth allowed per function"));
 
+static cl::opt<unsigned> MaxModuleGrowth(
+    "funcspec-max-module-growth", cl::init(0), cl::Hidden, cl::desc(
+    "Maximum estimated number of instructions that specializations may add "
+    "to the module, 0 for no limit"));
+
 static cl::opt<unsigned> MinCodeSizeSavings(
     "funcspec-min-codesize-savings", cl::init(20), cl::Hidden, cl::desc(
     "Reject specializations whose codesize savings are less than this"
@@ -709,9 +715,30 @@ bool FunctionSpecializer::run() {
     }
   }
 
+  // Keep the most profitable specializations that fit into what is left of
+  // the module growth budget.
+  BestSpecs.resize(NSpecs);
+  if (MaxModuleGrowth) {
+    llvm::sort(BestSpecs, CompareScore);
+    SmallVector<unsigned> InBudget;
+    for (unsigned I : BestSpecs) {
+      if (ModuleGrowth + AllSpecs[I].CodeSize > MaxModuleGrowth) {
+        LLVM_DEBUG(dbgs() << "FnSpecialization: Specialization of "
+                          << AllSpecs[I].F->getName()
+                          << " exceeds the module growth budget\n");
+        continue;
+      }
+      ModuleGrowth += AllSpecs[I].CodeSize;
+      InBudget.push_back(I);
+    }
+    BestSpecs = std::move(InBudget);
+    if (BestSpecs.empty())
+      return false;
+  }
+
   LLVM_DEBUG(dbgs() << "FnSpecialization: List of specializations \n";
-             for (unsigned I = 0; I < NSpecs; ++I) {
-               const Spec &S = AllSpecs[BestSpecs[I]];
+             for (unsigned I : BestSpecs) {
+               const Spec &S = AllSpecs[I];
                dbgs() << "FnSpecialization: Function " << S.F->getName()
                       << " , score " << S.Score << "\n";
                for (const ArgInfo &Arg : S.Sig.Args)
@@ -724,9 +751,10 @@ bool FunctionSpecializer::run() {
   // Create the chosen specializations.
   SmallPtrSet<Function *, 8> OriginalFuncs;
   SmallVector<Function *> Clones;
-  for (unsigned I = 0; I < NSpecs; ++I) {
-    Spec &S = AllSpecs[BestSpecs[I]];
+  for (unsigned I : BestSpecs) {
+    Spec &S = AllSpecs[I];
     S.Clone = createSpecialization(S.F, S.Sig);
+    emitRemark(S);
 
     // Update the known call sites to call the clone.
     for (CallBase *Call : S.CallSites) {
@@ -783,6 +811,36 @@ bool FunctionSpecializer::run() {
   return true;
 }
 
+void FunctionSpecializer::emitRemark(const Spec &S) {
+  OptimizationRemarkEmitter ORE(S.F);
+  ORE.emit([&]() {
+    // With profile data, estimate the dynamic savings from the counts of the
+    // call sites that have been matched so far.
+    std::optional<uint64_t> Calls;
+    for (CallBase *Call : S.CallSites) {
+      Function *Caller = Call->getFunction();
+      if (!Caller->getEntryCount())
+        continue;
+      if (std::optional<uint64_t> Count =
+              GetBFI(*Caller).getBlockProfileCount(Call->getParent()))
+        Calls = Calls.value_or(0) + *Count;
+    }
+
+    OptimizationRemark R(DEBUG_TYPE, "FunctionSpecialized", S.F);
+    R << "specialized " << ore::NV("Function", S.F) << " as "
+      << ore::NV("Clone", S.Clone) << " for "
+      << ore::NV("NumArgs", unsigned(S.Sig.Args.size()))
+      << " constant arguments: estimated code size "
+      << ore::NV("CodeSize", S.CodeSize) << ", latency saved per call "
+      << ore::NV("Latency", S.Latency);
+    if (Calls)
+      R << ", " << ore::NV("Calls", *Calls)
+        << " profiled calls, estimated dynamic savings "
+        << ore::NV("DynamicSavings", *Calls * S.Latency);
+    return R;
+  });
+}
+
 void FunctionSpecializer::removeDeadFunctions() {
   for (Function *F : FullySpecialized) {
     LLVM_DEBUG(dbgs() << "FnSpecialization: Removing dead function "
@@ -884,7 +942,8 @@ bool FunctionSpecializer::findSpecializations(Function *F, unsigned FuncSize,
                         << B.CodeSize << ", Latency = " << B.Latency
                         << ", Inlining = " << Score << "}\n");
 
-      FunctionGrowth[F] += FuncSize - B.CodeSize;
+      unsigned Growth = FuncSize - B.CodeSize;
+      FunctionGrowth[F] += Growth;
 
       auto IsProfitable = [](Bonus &B, unsigned Score, unsigned FuncSize,
                              unsigned FuncGrowth) -> bool {
@@ -913,6 +972,8 @@ bool FunctionSpecializer::findSpecializations(Function *F, unsigned FuncSize,
       // Create a new specialisation entry.
       Score += std::max(B.CodeSize, B.Latency);
       auto &Spec = AllSpecs.emplace_back(F, S, Score);
+      Spec.CodeSize = Growth;
+      Spec.Latency = B.Latency;
       if (CS.getFunction() != F)
         Spec.CallSites.push_back(&CS);
       const unsigned Index = AllSpecs.size() - 1;
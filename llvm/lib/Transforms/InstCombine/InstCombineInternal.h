@@ -83,6 +83,10 @@ public:
   /// \returns true if the IR is changed.
   bool run();
 
+  /// If set, run() counts the instructions it combines by opcode, for
+  /// -instcombine-iteration-report.
+  SmallDenseMap<unsigned, unsigned, 8> *CombinedOpcodes = nullptr;
+
   // Visitation implementation - Implement instruction combining for different
   // instruction types.  The semantics are as follows:
   // Return Value:
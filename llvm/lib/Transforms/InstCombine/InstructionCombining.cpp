@@ -138,6 +138,12 @@ static cl::opt<unsigned> MaxSinkNumUsers(
     "instcombine-max-sink-users", cl::init(32),
     cl::desc("Maximum number of undroppable users for instruction sinking"));
 
+static cl::opt<bool> IterationReport(
+    "instcombine-iteration-report", cl::Hidden,
+    cl::desc("Print the number of iterations, worklist pushes and combines "
+             "for every function, and the opcodes of the instructions that "
+             "were only combined after the first iteration"));
+
 static cl::opt<unsigned>
 MaxArraySize("instcombine-maxarray-size", cl::init(1024),
              cl::desc("Maximum array size considered when doing a combine"));
@@ -5083,8 +5089,11 @@ bool InstCombinerImpl::run() {
     LLVM_DEBUG(raw_string_ostream SS(OrigI); I->print(SS); OrigI = SS.str(););
     LLVM_DEBUG(dbgs() << "IC: Visiting: " << OrigI << '\n');
 
+    unsigned Opcode = I->getOpcode();
     if (Instruction *Result = visit(*I)) {
       ++NumCombined;
+      if (CombinedOpcodes)
+        ++(*CombinedOpcodes)[Opcode];
       // Should we replace the old instruction with a new one?
       if (Result != I) {
         LLVM_DEBUG(dbgs() << "IC: Old = " << *I << '\n'
@@ -5362,6 +5371,12 @@ static bool combineInstructionsOverFunction(
   if (ShouldLowerDbgDeclare)
     MadeIRChange = LowerDbgDeclare(F);
 
+  // Combines in the first iteration, and the ones after it, which a perfect
+  // worklist would have found in the first one.
+  SmallDenseMap<unsigned, unsigned, 8> FirstCombines, LateCombines;
+  uint64_t PushesBefore = Worklist.getNumPushes();
+  unsigned IterationsRun = 0;
+
   // Iterate while there is work to do.
   unsigned Iteration = 0;
   while (true) {
@@ -5375,12 +5390,15 @@ static bool combineInstructionsOverFunction(
     }
 
     ++NumWorklistIterations;
+    ++IterationsRun;
     LLVM_DEBUG(dbgs() << "\n\nINSTCOMBINE ITERATION #" << Iteration << " on "
                       << F.getName() << "\n");
 
     InstCombinerImpl IC(Worklist, Builder, F.hasMinSize(), AA, AC, TLI, TTI, DT,
                         ORE, BFI, BPI, PSI, DL, LI);
     IC.MaxArraySizeForCombine = MaxArraySize;
+    if (IterationReport)
+      IC.CombinedOpcodes = Iteration == 1 ? &FirstCombines : &LateCombines;
     bool MadeChangeInThisIteration = IC.prepareWorklist(F, RPOT);
     MadeChangeInThisIteration |= IC.run();
     if (!MadeChangeInThisIteration)
@@ -5404,6 +5422,31 @@ static bool combineInstructionsOverFunction(
   else
     ++NumFourOrMoreIterations;
 
+  if (IterationReport) {
+    auto Total = [](const SmallDenseMap<unsigned, unsigned, 8> &Counts) {
+      unsigned Sum = 0;
+      for (const auto &[Opcode, Count] : Counts)
+        Sum += Count;
+      return Sum;
+    };
+    raw_ostream &OS = errs();
+    OS << "instcombine: " << F.getName() << ": "
+       << IterationsRun << " iterations, "
+       << Worklist.getNumPushes() - PushesBefore << " worklist pushes, "
+       << Total(FirstCombines) + Total(LateCombines) << " combines";
+    if (!LateCombines.empty()) {
+      SmallVector<std::pair<unsigned, unsigned>, 8> Late(LateCombines.begin(),
+                                                         LateCombines.end());
+      llvm::sort(Late, [](const auto &A, const auto &B) {
+        return A.second != B.second ? A.second > B.second : A.first < B.first;
+      });
+      OS << ", " << Total(LateCombines) << " after the first iteration:";
+      for (const auto &[Opcode, Count] : ArrayRef(Late).take_front(5))
+        OS << ' ' << Instruction::getOpcodeName(Opcode) << '=' << Count;
+    }
+    OS << '\n';
+  }
+
   return MadeIRChange;
 }
 
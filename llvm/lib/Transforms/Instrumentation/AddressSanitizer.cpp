@@ -26,7 +26,10 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Analysis/GlobalsModRef.h"
+#include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/MemoryBuiltins.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
 #include "llvm/Analysis/StackSafetyAnalysis.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/ValueTracking.h"
@@ -43,6 +46,7 @@
 #include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/DebugLoc.h"
 #include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Dominators.h"
 #include "llvm/IR/EHPersonalities.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/GlobalAlias.h"
@@ -79,6 +83,7 @@
 #include "llvm/Transforms/Utils/Local.h"
 #include "llvm/Transforms/Utils/ModuleUtils.h"
 #include "llvm/Transforms/Utils/PromoteMemToReg.h"
+#include "llvm/Transforms/Utils/ScalarEvolutionExpander.h"
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
@@ -393,6 +398,24 @@ static cl::opt<bool> ClOptStack(
     "asan-opt-stack", cl::desc("Don't instrument scalar stack variables"),
     cl::Hidden, cl::init(false));
 
+static cl::opt<bool> ClOptRedundantChecks(
+    "asan-opt-redundant-checks",
+    cl::desc("Don't instrument accesses to bytes checked by an earlier access "
+             "in the same or the single predecessor block"),
+    cl::Hidden, cl::init(true));
+
+static cl::opt<bool> ClOptMergeChecks(
+    "asan-opt-merge-checks",
+    cl::desc("Widen the check of an access to cover the adjacent accesses "
+             "which follow it, reporting errors as one wider access"),
+    cl::Hidden, cl::init(false));
+
+static cl::opt<bool> ClOptHoistLoopChecks(
+    "asan-opt-hoist-loop-checks",
+    cl::desc("Check the whole range accessed by a loop before entering it, "
+             "instead of checking each access"),
+    cl::Hidden, cl::init(false));
+
 static cl::opt<bool> ClDynamicAllocaStack(
     "asan-stack-dynamic-alloca",
     cl::desc("Use dynamic alloca to represent stack variables"), cl::Hidden,
@@ -458,6 +481,12 @@ STATISTIC(NumOptimizedAccessesToGlobalVar,
           "Number of optimized accesses to global vars");
 STATISTIC(NumOptimizedAccessesToStackVar,
           "Number of optimized accesses to stack vars");
+STATISTIC(NumOptimizedRedundantChecks,
+          "Number of accesses checked by an earlier access");
+STATISTIC(NumMergedChecks,
+          "Number of accesses merged into the check of an earlier access");
+STATISTIC(NumHoistedLoopChecks,
+          "Number of accesses checked once before their loop");
 
 namespace {
 
@@ -795,7 +824,9 @@ struct AddressSanitizer {
   void instrumentMemIntrinsic(MemIntrinsic *MI, RuntimeCallInserter &RTCI);
   Value *memToShadow(Value *Shadow, IRBuilder<> &IRB);
   bool suppressInstrumentationSiteForDebug(int &Instrumented);
-  bool instrumentFunction(Function &F, const TargetLibraryInfo *TLI);
+  bool instrumentFunction(Function &F, const TargetLibraryInfo *TLI,
+                          LoopInfo *LI = nullptr, ScalarEvolution *SE = nullptr,
+                          DominatorTree *DT = nullptr);
   bool maybeInsertAsanInitAtFunctionEntry(Function &F);
   bool maybeInsertDynamicShadowAtFunctionEntry(Function &F);
   void markEscapedLocalAllocas(Function &F);
@@ -809,6 +840,10 @@ private:
   bool GlobalIsLinkerInitialized(GlobalVariable *G);
   bool isSafeAccess(ObjectSizeOffsetVisitor &ObjSizeVis, Value *Addr,
                     TypeSize TypeStoreSize) const;
+  void hoistLoopChecks(Function &F, LoopInfo &LI, ScalarEvolution &SE,
+                       DominatorTree &DT,
+                       SmallVectorImpl<InterestingMemoryOperand> &Operands,
+                       RuntimeCallInserter &RTCI);
 
   /// Helper to cleanup per-function state.
   struct FunctionStateRAII {
@@ -1262,7 +1297,16 @@ PreservedAnalyses AddressSanitizerPass::run(Module &M,
         Options.MaxInlinePoisoningSize, Options.CompileKernel, Options.Recover,
         Options.UseAfterScope, Options.UseAfterReturn);
     const TargetLibraryInfo &TLI = FAM.getResult<TargetLibraryAnalysis>(F);
-    Modified |= FunctionSanitizer.instrumentFunction(F, &TLI);
+    LoopInfo *LI = nullptr;
+    ScalarEvolution *SE = nullptr;
+    DominatorTree *DT = nullptr;
+    if (ClOpt && ClOptHoistLoopChecks && !F.isDeclaration() &&
+        F.hasFnAttribute(Attribute::SanitizeAddress)) {
+      LI = &FAM.getResult<LoopAnalysis>(F);
+      SE = &FAM.getResult<ScalarEvolutionAnalysis>(F);
+      DT = &FAM.getResult<DominatorTreeAnalysis>(F);
+    }
+    Modified |= FunctionSanitizer.instrumentFunction(F, &TLI, LI, SE, DT);
   }
   Modified |= ModuleSanitizer.instrumentModule(M);
   if (!Modified)
@@ -2938,8 +2982,184 @@ bool AddressSanitizer::suppressInstrumentationSiteForDebug(int &Instrumented) {
   return !ShouldInstrument;
 }
 
+namespace {
+/// A range of bytes at a constant offset from a base pointer which is known to
+/// be addressable, because an access covering it was checked.
+struct CheckedRange {
+  Value *Base;
+  int64_t Begin;
+  int64_t End;
+  /// The index of the access whose check covers the range.
+  size_t OperandIdx;
+};
+} // namespace
+
+/// Splits the address of \p O into a base pointer and a constant offset, and
+/// returns the range of bytes accessed relative to that base.
+static bool getConstantAccessRange(InterestingMemoryOperand &O,
+                                   const DataLayout &DL, Value *&Base,
+                                   int64_t &Begin, int64_t &End) {
+  if (O.MaybeMask || O.TypeStoreSize.isScalable())
+    return false;
+  Value *Ptr = O.getPtr();
+  APInt Offset(DL.getIndexTypeSizeInBits(Ptr->getType()), 0);
+  Base = Ptr->stripAndAccumulateConstantOffsets(DL, Offset,
+                                                /*AllowNonInbounds=*/true);
+  if (Offset.getSignificantBits() > 48)
+    return false;
+  Begin = Offset.getSExtValue();
+  End = Begin + O.TypeStoreSize.getFixedValue() / 8;
+  return true;
+}
+
+/// Returns true if an access of \p Size bytes with alignment \p Alignment is
+/// instrumented with a single check of all its bytes, see
+/// doInstrumentAddress(). Other accesses are only checked at their ends.
+static bool isCheckedAsWhole(MaybeAlign Alignment, uint64_t Size,
+                             unsigned Granularity) {
+  return Alignment && isPowerOf2_64(Size) && Size <= 16 &&
+         (Alignment->value() >= Granularity || Alignment->value() >= Size);
+}
+
+static void recordCheckedRange(InterestingMemoryOperand &O, size_t OperandIdx,
+                               const DataLayout &DL, unsigned Granularity,
+                               SmallVectorImpl<CheckedRange> &Ranges) {
+  // Bound the quadratic lookups in isCheckedByEarlierAccess().
+  constexpr size_t MaxCheckedRanges = 64;
+  Value *Base;
+  int64_t Begin, End;
+  if (Ranges.size() >= MaxCheckedRanges ||
+      !getConstantAccessRange(O, DL, Base, Begin, End) ||
+      !isCheckedAsWhole(O.Alignment, End - Begin, Granularity))
+    return;
+  Ranges.push_back({Base, Begin, End, OperandIdx});
+}
+
+/// Returns true if the bytes accessed by \p O are covered by the check of an
+/// earlier access in \p Ranges. With -asan-opt-merge-checks, the check of an
+/// earlier access is widened to cover \p O if that keeps it a single check.
+static bool
+isCheckedByEarlierAccess(InterestingMemoryOperand &O, const DataLayout &DL,
+                         unsigned Granularity,
+                         SmallVectorImpl<CheckedRange> &Ranges,
+                         SmallVectorImpl<InterestingMemoryOperand> &Operands) {
+  Value *Base;
+  int64_t Begin, End;
+  if (!getConstantAccessRange(O, DL, Base, Begin, End))
+    return false;
+  for (const CheckedRange &R : Ranges) {
+    if (R.Base == Base && R.Begin <= Begin && End <= R.End) {
+      ++NumOptimizedRedundantChecks;
+      return true;
+    }
+  }
+  if (!ClOptMergeChecks)
+    return false;
+
+  for (CheckedRange &R : Ranges) {
+    // The widened check is done on the address of the earlier access, so it
+    // has to be the start of the merged range.
+    if (R.Base != Base || Begin < R.Begin || Begin > R.End)
+      continue;
+    InterestingMemoryOperand &Checked = Operands[R.OperandIdx];
+    // The check may have been widened through another copy of the range.
+    const uint64_t Size =
+        std::max<uint64_t>(std::max(End, R.End) - R.Begin,
+                           Checked.TypeStoreSize.getFixedValue() / 8);
+    if (!isCheckedAsWhole(Checked.Alignment, Size, Granularity))
+      continue;
+    Checked.TypeStoreSize = TypeSize::getFixed(Size * 8);
+    Checked.IsWrite |= O.IsWrite;
+    R.End = R.Begin + Size;
+    ++NumMergedChecks;
+    return true;
+  }
+  return false;
+}
+
+/// Replaces the checks of accesses which go through memory with a constant
+/// stride in every iteration of an innermost loop by one check of the whole
+/// range before entering the loop. The loop must not contain any call, which
+/// could change what is addressable, and must only exit from its latch, which
+/// the access has to dominate, so that all the bytes of the range are
+/// accessed once the loop is entered.
+void AddressSanitizer::hoistLoopChecks(
+    Function &F, LoopInfo &LI, ScalarEvolution &SE, DominatorTree &DT,
+    SmallVectorImpl<InterestingMemoryOperand> &Operands,
+    RuntimeCallInserter &RTCI) {
+  SmallDenseMap<const Loop *, bool, 8> HasCalls;
+  auto MayChangeShadow = [&](const Loop *L) {
+    auto [It, Inserted] = HasCalls.try_emplace(L, false);
+    if (Inserted)
+      It->second = any_of(L->blocks(), [](const BasicBlock *BB) {
+        return any_of(*BB, [](const Instruction &I) {
+          return isa<CallBase>(I) && !isa<DbgInfoIntrinsic>(I);
+        });
+      });
+    return It->second;
+  };
+
+  SCEVExpander Expander(SE, F.getParent()->getDataLayout(), "asan.range");
+  const uint32_t Exp = ClForceExperiment;
+  erase_if(Operands, [&](InterestingMemoryOperand &O) {
+    if (O.MaybeMask || O.TypeStoreSize.isScalable())
+      return false;
+    BasicBlock *BB = O.getInsn()->getParent();
+    Loop *L = LI.getLoopFor(BB);
+    if (!L || !L->isInnermost())
+      return false;
+    BasicBlock *Preheader = L->getLoopPreheader();
+    BasicBlock *Latch = L->getLoopLatch();
+    if (!Preheader || !Latch || L->getExitingBlock() != Latch ||
+        !DT.dominates(BB, Latch) || MayChangeShadow(L))
+      return false;
+
+    // Bytes between the accesses would be checked too, so the stride must not
+    // be larger than the access.
+    const uint64_t Size = O.TypeStoreSize.getFixedValue() / 8;
+    auto *AR = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(O.getPtr()));
+    if (!AR || AR->getLoop() != L || !AR->isAffine())
+      return false;
+    auto *Step = dyn_cast<SCEVConstant>(AR->getStepRecurrence(SE));
+    if (!Step || Step->getAPInt().abs().ugt(Size))
+      return false;
+    const SCEV *BTC = SE.getBackedgeTakenCount(L);
+    if (isa<SCEVCouldNotCompute>(BTC))
+      return false;
+    const SCEV *First = AR->getStart();
+    const SCEV *Last = AR->evaluateAtIteration(BTC, SE);
+    if (Step->getAPInt().isNegative())
+      std::swap(First, Last);
+    const SCEV *Distance = SE.getMinusSCEV(Last, First);
+    Instruction *InsertPt = Preheader->getTerminator();
+    if (isa<SCEVCouldNotCompute>(Distance) ||
+        !Expander.isSafeToExpandAt(First, InsertPt) ||
+        !Expander.isSafeToExpandAt(Distance, InsertPt))
+      return false;
+
+    Value *Begin = Expander.expandCodeFor(First, First->getType(), InsertPt);
+    Value *Length =
+        Expander.expandCodeFor(Distance, Distance->getType(), InsertPt);
+    InstrumentationIRBuilder IRB(InsertPt);
+    Value *AddrLong = IRB.CreatePointerCast(Begin, IntptrTy);
+    Value *Len = IRB.CreateAdd(IRB.CreateZExtOrTrunc(Length, IntptrTy),
+                               ConstantInt::get(IntptrTy, Size));
+    if (Exp == 0)
+      RTCI.createRuntimeCall(IRB, AsanMemoryAccessCallbackSized[O.IsWrite][0],
+                             {AddrLong, Len});
+    else
+      RTCI.createRuntimeCall(
+          IRB, AsanMemoryAccessCallbackSized[O.IsWrite][1],
+          {AddrLong, Len, ConstantInt::get(IRB.getInt32Ty(), Exp)});
+    ++NumHoistedLoopChecks;
+    return true;
+  });
+}
+
 bool AddressSanitizer::instrumentFunction(Function &F,
-                                          const TargetLibraryInfo *TLI) {
+                                          const TargetLibraryInfo *TLI,
+                                          LoopInfo *LI, ScalarEvolution *SE,
+                                          DominatorTree *DT) {
   if (F.empty())
     return false;
   if (F.getLinkage() == GlobalValue::AvailableExternallyLinkage) return false;
@@ -2978,6 +3198,14 @@ bool AddressSanitizer::instrumentFunction(Function &F,
   // are calls between uses).
   SmallPtrSet<Value *, 16> TempsToInstrument;
   SmallVector<InterestingMemoryOperand, 16> OperandsToInstrument;
+  // The bytes checked since the last call, and the ones checked at the end of
+  // the blocks visited so far, which are still checked when entering their
+  // single successors.
+  SmallVector<CheckedRange, 16> CheckedRanges;
+  DenseMap<const BasicBlock *, SmallVector<CheckedRange, 16>> CheckedAtEnd;
+  const bool OptRedundantChecks = ClOpt && ClOptRedundantChecks;
+  const DataLayout &DL = F.getParent()->getDataLayout();
+  const unsigned Granularity = 1 << Mapping.Scale;
   SmallVector<MemIntrinsic *, 16> IntrinToInstrument;
   SmallVector<Instruction *, 8> NoReturnCalls;
   SmallVector<BasicBlock *, 16> AllBlocks;
@@ -2987,6 +3215,13 @@ bool AddressSanitizer::instrumentFunction(Function &F,
   for (auto &BB : F) {
     AllBlocks.push_back(&BB);
     TempsToInstrument.clear();
+    CheckedRanges.clear();
+    if (OptRedundantChecks)
+      if (const BasicBlock *Pred = BB.getSinglePredecessor()) {
+        auto It = CheckedAtEnd.find(Pred);
+        if (It != CheckedAtEnd.end())
+          CheckedRanges = It->second;
+      }
     int NumInsnsPerBB = 0;
     for (auto &Inst : BB) {
       if (LooksLikeCodeInBug11395(&Inst)) return false;
@@ -3011,8 +3246,16 @@ bool AddressSanitizer::instrumentFunction(Function &F,
                 continue; // We've seen this temp in the current BB.
             }
           }
+          if (OptRedundantChecks &&
+              isCheckedByEarlierAccess(Operand, DL, Granularity, CheckedRanges,
+                                       OperandsToInstrument))
+            continue;
           OperandsToInstrument.push_back(Operand);
           NumInsnsPerBB++;
+          if (OptRedundantChecks)
+            recordCheckedRange(OperandsToInstrument.back(),
+                               OperandsToInstrument.size() - 1, DL,
+                               Granularity, CheckedRanges);
         }
       } else if (((ClInvalidPointerPairs || ClInvalidPointerCmp) &&
                   isInterestingPointerComparison(&Inst)) ||
@@ -3027,6 +3270,7 @@ bool AddressSanitizer::instrumentFunction(Function &F,
         if (auto *CB = dyn_cast<CallBase>(&Inst)) {
           // A call inside BB.
           TempsToInstrument.clear();
+          CheckedRanges.clear();
           if (CB->doesNotReturn())
             NoReturnCalls.push_back(CB);
         }
@@ -3035,12 +3279,17 @@ bool AddressSanitizer::instrumentFunction(Function &F,
       }
       if (NumInsnsPerBB >= ClMaxInsnsToInstrumentPerBB) break;
     }
+    // Only pass the checked ranges on if the whole block was scanned.
+    if (OptRedundantChecks && NumInsnsPerBB < ClMaxInsnsToInstrumentPerBB)
+      CheckedAtEnd[&BB] = CheckedRanges;
   }
 
+  if (LI && SE && DT)
+    hoistLoopChecks(F, *LI, *SE, *DT, OperandsToInstrument, RTCI);
+
   bool UseCalls = (InstrumentationWithCallsThreshold >= 0 &&
                    OperandsToInstrument.size() + IntrinToInstrument.size() >
                        (unsigned)InstrumentationWithCallsThreshold);
-  const DataLayout &DL = F.getParent()->getDataLayout();
   ObjectSizeOpts ObjSizeOpts;
   ObjSizeOpts.RoundToAlign = true;
   ObjectSizeOffsetVisitor ObjSizeVis(DL, TLI, F.getContext(), ObjSizeOpts);
@@ -131,6 +131,13 @@ cl::opt<bool> AtomicFirstCounter(
              "the entry counter)"),
     cl::init(false));
 
+cl::opt<unsigned> SampledInstrPeriod(
+    "sampled-instr-period",
+    cl::desc("Only update counters and profile values in one out of this many "
+             "calls of each instrumented function on a thread, and scale the "
+             "counter updates by the same factor (0 or 1 disables sampling)"),
+    cl::init(0));
+
 // If the option is not specified, the default behavior about whether
 // counter promotion is done depends on how instrumentaiton lowering
 // pipeline is setup, i.e., the default value of true of this option
@@ -246,6 +253,13 @@ private:
   /// any lowering.
   bool lowerIntrinsics(Function *F);
 
+  /// Returns true if counter updates are sampled.
+  bool isSamplingEnabled() const { return SampledInstrPeriod > 1; }
+
+  /// Make the counter increments and value profiling sites in the function
+  /// conditional on the function being sampled in this call.
+  void doSampling(Function *F);
+
   /// Register-promote counter loads and stores in loops.
   void promoteCounterLoadStores(Function *F);
 
@@ -625,6 +639,8 @@ PreservedAnalyses InstrProfilingLoweringPass::run(Module &M,
 bool InstrLowerer::lowerIntrinsics(Function *F) {
   bool MadeChange = false;
   PromotionCandidates.clear();
+  if (isSamplingEnabled())
+    doSampling(F);
   for (BasicBlock &BB : *F) {
     for (Instruction &Instr : llvm::make_early_inc_range(BB)) {
       if (auto *IPIS = dyn_cast<InstrProfIncrementInstStep>(&Instr)) {
@@ -662,6 +678,42 @@ bool InstrLowerer::lowerIntrinsics(Function *F) {
   return true;
 }
 
+void InstrLowerer::doSampling(Function *F) {
+  SmallVector<Instruction *, 16> Sites;
+  for (BasicBlock &BB : *F)
+    for (Instruction &I : BB)
+      if (isa<InstrProfIncrementInst>(I) || isa<InstrProfValueProfileInst>(I))
+        Sites.push_back(&I);
+  if (Sites.empty())
+    return;
+
+  // Each thread counts down the calls to instrumented functions, and a call is
+  // sampled when the count reaches zero. Every function tests the countdown
+  // once on entry, so the cost of a call that isn't sampled is a load, a store
+  // and one well predicted branch per counter update.
+  Type *Int32Ty = Type::getInt32Ty(M.getContext());
+  auto *Countdown = M.getGlobalVariable("__llvm_profile_sampling");
+  if (!Countdown) {
+    Countdown = new GlobalVariable(M, Int32Ty, false,
+                                   GlobalValue::LinkOnceODRLinkage,
+                                   Constant::getNullValue(Int32Ty),
+                                   "__llvm_profile_sampling", nullptr,
+                                   GlobalValue::GeneralDynamicTLSModel);
+    Countdown->setVisibility(GlobalVariable::HiddenVisibility);
+    if (TT.supportsCOMDAT())
+      Countdown->setComdat(M.getOrInsertComdat(Countdown->getName()));
+  }
+  IRBuilder<> Builder(&*F->getEntryBlock().getFirstInsertionPt());
+  Value *Left = Builder.CreateLoad(Int32Ty, Countdown, "pgosampling");
+  Value *Sampled = Builder.CreateICmpEQ(Left, Builder.getInt32(0));
+  Builder.CreateStore(
+      Builder.CreateSelect(Sampled, Builder.getInt32(SampledInstrPeriod - 1),
+                           Builder.CreateSub(Left, Builder.getInt32(1))),
+      Countdown);
+  for (Instruction *I : Sites)
+    I->moveBefore(SplitBlockAndInsertIfThen(Sampled, I, /*Unreachable=*/false));
+}
+
 bool InstrLowerer::isRuntimeCounterRelocationEnabled() const {
   // Mach-O don't support weak external references.
   if (TT.isOSBinFormatMachO())
@@ -978,14 +1030,18 @@ void InstrLowerer::lowerIncrement(InstrProfIncrementInst *Inc) {
   auto *Addr = getCounterAddress(Inc);
 
   IRBuilder<> Builder(Inc);
+  // Scale the sampled updates up so that the counts need no correction.
+  Value *IncStep = Inc->getStep();
+  if (isSamplingEnabled())
+    IncStep = Builder.CreateMul(
+        IncStep, ConstantInt::get(IncStep->getType(), SampledInstrPeriod));
   if (Options.Atomic || AtomicCounterUpdateAll ||
       (Inc->getIndex()->isZeroValue() && AtomicFirstCounter)) {
-    Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr, Inc->getStep(),
-                            MaybeAlign(), AtomicOrdering::Monotonic);
+    Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr, IncStep, MaybeAlign(),
+                            AtomicOrdering::Monotonic);
   } else {
-    Value *IncStep = Inc->getStep();
     Value *Load = Builder.CreateLoad(IncStep->getType(), Addr, "pgocount");
-    auto *Count = Builder.CreateAdd(Load, Inc->getStep());
+    auto *Count = Builder.CreateAdd(Load, IncStep);
     auto *Store = Builder.CreateStore(Count, Addr);
     if (isCounterPromotionEnabled())
       PromotionCandidates.emplace_back(cast<Instruction>(Load), Store);
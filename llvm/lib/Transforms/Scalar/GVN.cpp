@@ -101,6 +101,9 @@ STATISTIC(NumPRELoadMoved2CEPred,
 STATISTIC(IsValueFullyAvailableInBlockNumSpeculationsMax,
           "Number of blocks speculated as available in "
           "IsValueFullyAvailableInBlock(), max");
+STATISTIC(NumGVNNonLocalBudgetExceeded,
+          "Number of non-local loads skipped because the function exceeded "
+          "gvn-max-nonlocal-deps-per-function");
 STATISTIC(MaxBBSpeculationCutoffReachedTimes,
           "Number of times we we reached gvn-max-block-speculations cut-off "
           "preventing further exploration");
@@ -130,6 +133,12 @@ static cl::opt<uint32_t> MaxNumVisitedInsts(
     cl::desc("Max number of visited instructions when trying to find "
              "dominating value of select dependency (default = 100)"));
 
+static cl::opt<uint64_t> MaxNonLocalDepsPerFunction(
+    "gvn-max-nonlocal-deps-per-function", cl::Hidden, cl::init(100000),
+    cl::desc("Max number of non-local dependences of loads to compute in one "
+             "function, after which only local loads are optimized "
+             "(default = 100000)"));
+
 static cl::opt<uint32_t> MaxNumInsnsPerBlock(
     "gvn-max-num-insns", cl::Hidden, cl::init(100),
     cl::desc("Max number of instructions to scan in each basic block in GVN "
@@ -1907,6 +1916,14 @@ bool GVNPass::processNonLocalLoad(LoadInst *Load) {
           Attribute::SanitizeHWAddress))
     return false;
 
+  // The cost of the non-local queries and the size of memdep's caches grow
+  // with the number of dependences, which can be quadratic in the size of the
+  // function. Once the budget is used up, stop asking.
+  if (NumNonLocalDeps > MaxNonLocalDepsPerFunction) {
+    ++NumGVNNonLocalBudgetExceeded;
+    return false;
+  }
+
   // Step 1: Find the non-local dependencies of the load.
   LoadDepVect Deps;
   MD->getNonLocalPointerDependency(Load, Deps);
@@ -1915,6 +1932,7 @@ bool GVNPass::processNonLocalLoad(LoadInst *Load) {
   // dependencies, this load isn't worth worrying about.  Optimizing
   // it will be too expensive.
   unsigned NumDeps = Deps.size();
+  NumNonLocalDeps += NumDeps;
   if (NumDeps > MaxNumDeps)
     return false;
 
@@ -2771,6 +2789,7 @@ bool GVNPass::runImpl(Function &F, AssumptionCache &RunAC, DominatorTree &RunDT,
   VN.setMemDep(MD);
   ORE = RunORE;
   InvalidBlockRPONumbers = true;
+  NumNonLocalDeps = 0;
   MemorySSAUpdater Updater(MSSA);
   MSSAU = MSSA ? &Updater : nullptr;
 
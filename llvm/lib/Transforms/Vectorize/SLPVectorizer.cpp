@@ -139,6 +139,12 @@ static cl::opt<bool> AllowHorRdxIdenityOptimization(
     cl::desc("Allow optimization of original scalar identity operations on "
              "matched horizontal reductions."));
 
+static cl::opt<unsigned> MinReductionWidth(
+    "slp-min-reduction-width", cl::init(4), cl::Hidden,
+    cl::desc("Minimum number of reduced values to vectorize a horizontal "
+             "reduction with; the cost model decides for narrower ones "
+             "(at least 2)"));
+
 static cl::opt<int>
 MaxVectorRegSizeOption("slp-max-reg-size", cl::init(128), cl::Hidden,
     cl::desc("Attempt to vectorize for this register size in bits"));
@@ -16825,7 +16831,7 @@ public:
   /// Attempt to vectorize the tree found by matchAssociativeReduction.
   Value *tryToReduce(BoUpSLP &V, const DataLayout &DL, TargetTransformInfo *TTI,
                      const TargetLibraryInfo &TLI) {
-    constexpr int ReductionLimit = 4;
+    const unsigned ReductionLimit = std::max(2u, MinReductionWidth.getValue());
     constexpr unsigned RegMaxNumber = 4;
     constexpr unsigned RedValsMaxNumber = 128;
     // If there are a sufficient number of reduction values, reduce
@@ -37,8 +37,10 @@
 #include "llvm/Support/FileCollector.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/LLVMDriver.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/WithColor.h"
@@ -108,6 +110,7 @@ struct DsymutilOptions {
   bool Flat = false;
   bool InputIsYAMLDebugMap = false;
   bool ForceKeepFunctionForStatic = false;
+  bool SkipUnchanged = false;
   std::string OutputFile;
   std::string Toolchain;
   std::string ReproducerPath;
@@ -297,6 +300,7 @@ static Expected<DsymutilOptions> getOptions(opt::InputArgList &Args) {
   Options.DumpStab = Args.hasArg(OPT_symtab);
   Options.Flat = Args.hasArg(OPT_flat);
   Options.InputIsYAMLDebugMap = Args.hasArg(OPT_yaml_input);
+  Options.SkipUnchanged = Args.hasArg(OPT_skip_unchanged);
 
   if (Expected<DWARFVerify> Verify = getVerifyKind(Args)) {
     Options.Verify = *Verify;
@@ -598,6 +602,53 @@ getOutputFileName(StringRef InputFile, const DsymutilOptions &Options) {
   return OutputLocation(std::string(Path), ResourceDir);
 }
 
+/// Compute a key for everything the output of linking \p DebugMaps depends on
+/// that can be checked without reading any DWARF: the dsymutil executable, the
+/// command line, and the path, size and modification time of the binary and of
+/// every object file in the debug maps.
+static std::string
+computeInputsKey(StringRef ToolPath, ArrayRef<const char *> Args,
+                 ArrayRef<std::unique_ptr<DebugMap>> DebugMaps,
+                 vfs::FileSystem &VFS) {
+  SHA1 Hasher;
+  auto AddString = [&](StringRef Str) {
+    Hasher.update(Str);
+    Hasher.update(ArrayRef<uint8_t>{0});
+  };
+  auto AddUint64 = [&](uint64_t I) {
+    uint8_t Data[8];
+    support::endian::write64le(Data, I);
+    Hasher.update(Data);
+  };
+  auto AddFile = [&](StringRef Path) {
+    AddString(Path);
+    ErrorOr<vfs::Status> Status = VFS.status(Path);
+    // Objects in static archives are named "archive.a(object.o)".
+    if (!Status && Path.ends_with(")"))
+      Status = VFS.status(Path.substr(0, Path.rfind('(')));
+    if (!Status) {
+      AddUint64(-1);
+      return;
+    }
+    AddUint64(Status->getSize());
+    AddUint64(sys::toTimeT(Status->getLastModificationTime()));
+  };
+
+  AddFile(ToolPath);
+  for (const char *Arg : Args)
+    AddString(Arg);
+  for (const std::unique_ptr<DebugMap> &Map : DebugMaps) {
+    AddString(Map->getTriple().str());
+    AddFile(Map->getBinaryPath());
+    Hasher.update(Map->getUUID());
+    for (const std::unique_ptr<DebugMapObject> &Obj : *Map) {
+      AddFile(Obj->getObjectFilename());
+      AddUint64(sys::toTimeT(Obj->getTimestamp()));
+    }
+  }
+  return toHex(Hasher.final());
+}
+
 int dsymutil_main(int argc, char **argv, const llvm::ToolContext &) {
   // Parse arguments.
   DsymutilOptTable T;
@@ -608,6 +659,7 @@ int dsymutil_main(int argc, char **argv, const llvm::ToolContext &) {
 
   void *P = (void *)(intptr_t)getOutputFileName;
   std::string SDKPath = sys::fs::getMainExecutable(argv[0], P);
+  std::string ToolPath = SDKPath;
   SDKPath = std::string(sys::path::parent_path(SDKPath));
 
   for (auto *Arg : Args.filtered(OPT_UNKNOWN)) {
@@ -713,6 +765,32 @@ int dsymutil_main(int argc, char **argv, const llvm::ToolContext &) {
     }
     Options.LinkOpts.ResourceDir = OutputLocationOrErr->getResourceDir();
 
+    // With --skip-unchanged, the key of the inputs is stored in the bundle's
+    // resource directory after a successful link. It is removed before linking
+    // again, so that a failed link never leaves a stale key behind.
+    std::string InputsKey;
+    SmallString<128> InputsKeyPath;
+    if (Options.SkipUnchanged && !Options.LinkOpts.Update &&
+        !Options.LinkOpts.NoOutput && !Options.DumpDebugMap &&
+        Options.LinkOpts.ResourceDir) {
+      InputsKey = computeInputsKey(ToolPath, ArgsArr, *DebugMapPtrsOrErr,
+                                   *Options.LinkOpts.VFS);
+      InputsKeyPath = *Options.LinkOpts.ResourceDir;
+      sys::path::append(InputsKeyPath,
+                        sys::path::filename(OutputLocationOrErr->DWARFFile) +
+                            ".dsymutil-inputs");
+      ErrorOr<std::unique_ptr<MemoryBuffer>> OldKey =
+          MemoryBuffer::getFile(InputsKeyPath);
+      if (OldKey && (*OldKey)->getBuffer() == InputsKey &&
+          sys::fs::exists(OutputLocationOrErr->DWARFFile)) {
+        if (Options.LinkOpts.Verbose)
+          outs() << "skipping unchanged " << OutputLocationOrErr->DWARFFile
+                 << '\n';
+        continue;
+      }
+      sys::fs::remove(InputsKeyPath);
+    }
+
     // Statistics only require different architectures to be processed
     // sequentially, the link itself can still happen in parallel. Change the
     // thread pool strategy here instead of modifying LinkOpts.Threads.
@@ -868,6 +946,15 @@ int dsymutil_main(int argc, char **argv, const llvm::ToolContext &) {
               SDKPath, Fat64))
         return EXIT_FAILURE;
     }
+
+    if (!InputsKey.empty()) {
+      std::error_code EC;
+      raw_fd_ostream KeyOS(InputsKeyPath, EC, sys::fs::OF_None);
+      if (EC)
+        WithColor::warning() << InputsKeyPath << ": " << EC.message() << '\n';
+      else
+        KeyOS << InputsKey;
+    }
   }
 
   return EXIT_SUCCESS;
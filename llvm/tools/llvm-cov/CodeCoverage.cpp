@@ -20,6 +20,7 @@
 #include "CoverageViewOptions.h"
 #include "RenderingSupport.h"
 #include "SourceCoverageView.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Debuginfod/BuildIDFetcher.h"
@@ -85,9 +86,6 @@ private:
   /// directory, recursively collect all of the paths within the directory.
   void collectPaths(const std::string &Path);
 
-  /// Check if the two given files are the same file.
-  bool isEquivalentFile(StringRef FilePath1, StringRef FilePath2);
-
   /// Retrieve a file status with a cache.
   std::optional<sys::fs::file_status> getFileStatus(StringRef FilePath);
 
@@ -186,6 +184,9 @@ private:
   std::mutex LoadedSourceFilesLock;
   std::vector<std::pair<std::string, std::unique_ptr<MemoryBuffer>>>
       LoadedSourceFiles;
+  /// Maps the identity of each file in LoadedSourceFiles to its index, so that
+  /// looking up a file doesn't compare it with all files loaded before it.
+  DenseMap<sys::fs::UniqueID, unsigned> LoadedSourceFileIndex;
 
   /// Allowlist from -name-allowlist to be used for filtering.
   std::unique_ptr<SpecialCaseList> NameAllowlist;
@@ -276,13 +277,6 @@ CodeCoverageTool::getFileStatus(StringRef FilePath) {
   return CachedStatus;
 }
 
-bool CodeCoverageTool::isEquivalentFile(StringRef FilePath1,
-                                        StringRef FilePath2) {
-  auto Status1 = getFileStatus(FilePath1);
-  auto Status2 = getFileStatus(FilePath2);
-  return Status1 && Status2 && sys::fs::equivalent(*Status1, *Status2);
-}
-
 ErrorOr<const MemoryBuffer &>
 CodeCoverageTool::getSourceFile(StringRef SourceFile) {
   // If we've remapped filenames, look up the real location for this file.
@@ -292,14 +286,20 @@ CodeCoverageTool::getSourceFile(StringRef SourceFile) {
     if (Loc != RemappedFilenames.end())
       SourceFile = Loc->second;
   }
-  for (const auto &Files : LoadedSourceFiles)
-    if (isEquivalentFile(SourceFile, Files.first))
-      return *Files.second;
+  // Different paths may name the same file; the first one loaded is used.
+  std::optional<sys::fs::file_status> Status = getFileStatus(SourceFile);
+  if (Status) {
+    auto It = LoadedSourceFileIndex.find(Status->getUniqueID());
+    if (It != LoadedSourceFileIndex.end())
+      return *LoadedSourceFiles[It->second].second;
+  }
   auto Buffer = MemoryBuffer::getFile(SourceFile);
   if (auto EC = Buffer.getError()) {
     error(EC.message(), SourceFile);
     return EC;
   }
+  if (Status)
+    LoadedSourceFileIndex[Status->getUniqueID()] = LoadedSourceFiles.size();
   LoadedSourceFiles.emplace_back(std::string(SourceFile),
                                  std::move(Buffer.get()));
   return *LoadedSourceFiles.back().second;
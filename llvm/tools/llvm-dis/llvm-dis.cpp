@@ -31,8 +31,11 @@
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/WithColor.h"
+#include <atomic>
 #include <system_error>
 using namespace llvm;
 
@@ -80,9 +83,16 @@ static cl::opt<bool> PrintThinLTOIndexOnly(
     cl::desc("Only read thinlto index and print the index as LLVM assembly."),
     cl::init(false), cl::Hidden, cl::cat(DisCategory));
 
+static cl::opt<unsigned>
+    Threads("threads",
+            cl::desc("Number of modules to disassemble concurrently, each in "
+                     "its own context (0 = all cores)"),
+            cl::init(1), cl::cat(DisCategory));
+
 extern cl::opt<bool> WriteNewDbgInfoFormat;
 
 extern cl::opt<cl::boolOrDefault> LoadBitcodeIntoNewDbgInfoFormat;
+extern cl::opt<cl::boolOrDefault> PreserveInputDbgFormat;
 
 namespace {
 
@@ -163,6 +173,83 @@ struct LLVMDisDiagnosticHandler : public DiagnosticHandler {
 
 static ExitOnError ExitOnErr;
 
+namespace {
+/// A module of an input file to disassemble.
+struct Job {
+  StringRef InputFilename;
+  BitcodeModule Mod;
+  size_t Index;
+  size_t NumModules;
+};
+} // end anon namespace
+
+static bool disassemble(Job J, LLVMContext &Context) {
+  std::unique_ptr<Module> M;
+
+  if (!PrintThinLTOIndexOnly) {
+    M = ExitOnErr(
+        J.Mod.getLazyModule(Context, MaterializeMetadata, SetImporting));
+    if (MaterializeMetadata)
+      ExitOnErr(M->materializeMetadata());
+    else
+      ExitOnErr(M->materializeAll());
+  }
+
+  BitcodeLTOInfo LTOInfo = ExitOnErr(J.Mod.getLTOInfo());
+  std::unique_ptr<ModuleSummaryIndex> Index;
+  if (LTOInfo.HasSummary)
+    Index = ExitOnErr(J.Mod.getSummary());
+
+  std::string FinalFilename(OutputFilename);
+
+  // Just use stdout.  We won't actually print anything on it.
+  if (DontPrint)
+    FinalFilename = "-";
+
+  if (FinalFilename.empty()) { // Unspecified output, infer it.
+    if (J.InputFilename == "-") {
+      FinalFilename = "-";
+    } else {
+      StringRef IFN = J.InputFilename;
+      FinalFilename = (IFN.ends_with(".bc") ? IFN.drop_back(3) : IFN).str();
+      if (J.NumModules > 1)
+        FinalFilename += std::string(".") + std::to_string(J.Index);
+      FinalFilename += ".ll";
+    }
+  } else {
+    if (J.NumModules > 1)
+      FinalFilename += std::string(".") + std::to_string(J.Index);
+  }
+
+  std::error_code EC;
+  std::unique_ptr<ToolOutputFile> Out(
+      new ToolOutputFile(FinalFilename, EC, sys::fs::OF_TextWithCRLF));
+  if (EC) {
+    errs() << EC.message() << '\n';
+    return false;
+  }
+
+  std::unique_ptr<AssemblyAnnotationWriter> Annotator;
+  if (ShowAnnotations)
+    Annotator.reset(new CommentWriter());
+
+  // All that llvm-dis does is write the assembly to a file.
+  if (!DontPrint) {
+    if (M) {
+      M->setIsNewDbgInfoFormat(WriteNewDbgInfoFormat);
+      if (WriteNewDbgInfoFormat)
+        M->removeDebugIntrinsicDeclarations();
+      M->print(Out->os(), Annotator.get(), PreserveAssemblyUseListOrder);
+    }
+    if (Index)
+      Index->print(Out->os());
+  }
+
+  // Declare success.
+  Out->keep();
+  return true;
+}
+
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
 
@@ -175,10 +262,6 @@ int main(int argc, char **argv) {
   if (LoadBitcodeIntoNewDbgInfoFormat == cl::boolOrDefault::BOU_UNSET)
     LoadBitcodeIntoNewDbgInfoFormat = cl::boolOrDefault::BOU_TRUE;
 
-  LLVMContext Context;
-  Context.setDiagnosticHandler(
-      std::make_unique<LLVMDisDiagnosticHandler>(argv[0]));
-
   if (InputFilenames.size() < 1) {
     InputFilenames.push_back("-");
   } else if (InputFilenames.size() > 1 && !OutputFilename.empty()) {
@@ -187,90 +270,55 @@ int main(int argc, char **argv) {
     return 1;
   }
 
-  for (std::string InputFilename : InputFilenames) {
+  std::vector<std::unique_ptr<MemoryBuffer>> Buffers;
+  std::vector<Job> Jobs;
+  for (const std::string &InputFilename : InputFilenames) {
     ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
         MemoryBuffer::getFileOrSTDIN(InputFilename);
     if (std::error_code EC = BufferOrErr.getError()) {
       WithColor::error() << InputFilename << ": " << EC.message() << '\n';
       return 1;
     }
-    std::unique_ptr<MemoryBuffer> MB = std::move(BufferOrErr.get());
+    Buffers.push_back(std::move(BufferOrErr.get()));
 
-    BitcodeFileContents IF = ExitOnErr(llvm::getBitcodeFileContents(*MB));
+    BitcodeFileContents IF =
+        ExitOnErr(llvm::getBitcodeFileContents(*Buffers.back()));
 
     const size_t N = IF.Mods.size();
 
     if (OutputFilename == "-" && N > 1)
       errs() << "only single module bitcode files can be written to stdout\n";
 
-    for (size_t I = 0; I < N; ++I) {
-      BitcodeModule MB = IF.Mods[I];
-
-      std::unique_ptr<Module> M;
-
-      if (!PrintThinLTOIndexOnly) {
-        M = ExitOnErr(
-            MB.getLazyModule(Context, MaterializeMetadata, SetImporting));
-        if (MaterializeMetadata)
-          ExitOnErr(M->materializeMetadata());
-        else
-          ExitOnErr(M->materializeAll());
-      }
-
-      BitcodeLTOInfo LTOInfo = ExitOnErr(MB.getLTOInfo());
-      std::unique_ptr<ModuleSummaryIndex> Index;
-      if (LTOInfo.HasSummary)
-        Index = ExitOnErr(MB.getSummary());
-
-      std::string FinalFilename(OutputFilename);
-
-      // Just use stdout.  We won't actually print anything on it.
-      if (DontPrint)
-        FinalFilename = "-";
-
-      if (FinalFilename.empty()) { // Unspecified output, infer it.
-        if (InputFilename == "-") {
-          FinalFilename = "-";
-        } else {
-          StringRef IFN = InputFilename;
-          FinalFilename = (IFN.ends_with(".bc") ? IFN.drop_back(3) : IFN).str();
-          if (N > 1)
-            FinalFilename += std::string(".") + std::to_string(I);
-          FinalFilename += ".ll";
-        }
-      } else {
-        if (N > 1)
-          FinalFilename += std::string(".") + std::to_string(I);
-      }
+    for (size_t I = 0; I < N; ++I)
+      Jobs.push_back({InputFilename, IF.Mods[I], I, N});
+  }
 
-      std::error_code EC;
-      std::unique_ptr<ToolOutputFile> Out(
-          new ToolOutputFile(FinalFilename, EC, sys::fs::OF_TextWithCRLF));
-      if (EC) {
-        errs() << EC.message() << '\n';
+  // Reading bitcode while preserving the input debug info format updates
+  // global options, and modules written to stdout must not interleave, so
+  // these disassemble one module at a time.
+  ThreadPoolStrategy S = hardware_concurrency(Threads);
+  if (S.compute_thread_count() <= 1 || Jobs.size() <= 1 ||
+      OutputFilename == "-" ||
+      PreserveInputDbgFormat == cl::boolOrDefault::BOU_TRUE) {
+    LLVMContext Context;
+    Context.setDiagnosticHandler(
+        std::make_unique<LLVMDisDiagnosticHandler>(argv[0]));
+    for (const Job &J : Jobs)
+      if (!disassemble(J, Context))
         return 1;
-      }
-
-      std::unique_ptr<AssemblyAnnotationWriter> Annotator;
-      if (ShowAnnotations)
-        Annotator.reset(new CommentWriter());
-
-      // All that llvm-dis does is write the assembly to a file.
-      if (!DontPrint) {
-        if (M) {
-          M->setIsNewDbgInfoFormat(WriteNewDbgInfoFormat);
-          if (WriteNewDbgInfoFormat)
-            M->removeDebugIntrinsicDeclarations();
-          M->print(Out->os(), Annotator.get(), PreserveAssemblyUseListOrder);
-        }
-        if (Index)
-          Index->print(Out->os());
-      }
-
-      // Declare success.
-      Out->keep();
-    }
+    return 0;
   }
 
-  return 0;
+  std::atomic<bool> Failed = false;
+  DefaultThreadPool Pool(S);
+  for (const Job &J : Jobs)
+    Pool.async([&, argv0 = argv[0]] {
+      LLVMContext Context;
+      Context.setDiagnosticHandler(
+          std::make_unique<LLVMDisDiagnosticHandler>(argv0));
+      if (!disassemble(J, Context))
+        Failed = true;
+    });
+  Pool.wait();
+  return Failed ? 1 : 0;
 }
@@ -13,6 +13,7 @@
 #include "llvm/MC/MCTargetOptions.h"
 #include "llvm/Support/FormatVariadic.h"
 #include <limits>
+#include <set>
 #include <vector>
 
 namespace llvm {
@@ -227,6 +228,28 @@ Analysis::makePointsPerSchedClass() const {
   return Entries;
 }
 
+std::vector<Analysis::SchedClassCluster> Analysis::makeSchedClassClusters(
+    const ResolvedSchedClassAndPoints &RSCAndPoints) const {
+  std::vector<SchedClassCluster> SchedClassClusters;
+  for (const size_t PointId : RSCAndPoints.PointIds) {
+    const auto &ClusterId = Clustering_.getClusterIdForPoint(PointId);
+    if (!ClusterId.isValid())
+      continue; // Ignore noise and errors. FIXME: take noise into account ?
+    if (ClusterId.isUnstable() ^ AnalysisDisplayUnstableOpcodes_)
+      continue; // Either display stable or unstable clusters only.
+    auto SchedClassClusterIt =
+        find_if(SchedClassClusters, [ClusterId](const SchedClassCluster &C) {
+          return C.id() == ClusterId;
+        });
+    if (SchedClassClusterIt == SchedClassClusters.end()) {
+      SchedClassClusters.emplace_back();
+      SchedClassClusterIt = std::prev(SchedClassClusters.end());
+    }
+    SchedClassClusterIt->addPoint(PointId, Clustering_);
+  }
+  return SchedClassClusters;
+}
+
 // Parallel benchmarks repeat the same opcode multiple times. Just show this
 // opcode and show the whole snippet only on hover.
 static void writeParallelSnippetHtml(raw_ostream &OS,
@@ -532,24 +555,8 @@ Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
   for (const auto &RSCAndPoints : makePointsPerSchedClass()) {
     if (!RSCAndPoints.RSC.SCDesc)
       continue;
-    // Bucket sched class points into sched class clusters.
-    std::vector<SchedClassCluster> SchedClassClusters;
-    for (const size_t PointId : RSCAndPoints.PointIds) {
-      const auto &ClusterId = Clustering_.getClusterIdForPoint(PointId);
-      if (!ClusterId.isValid())
-        continue; // Ignore noise and errors. FIXME: take noise into account ?
-      if (ClusterId.isUnstable() ^ AnalysisDisplayUnstableOpcodes_)
-        continue; // Either display stable or unstable clusters only.
-      auto SchedClassClusterIt =
-          find_if(SchedClassClusters, [ClusterId](const SchedClassCluster &C) {
-            return C.id() == ClusterId;
-          });
-      if (SchedClassClusterIt == SchedClassClusters.end()) {
-        SchedClassClusters.emplace_back();
-        SchedClassClusterIt = std::prev(SchedClassClusters.end());
-      }
-      SchedClassClusterIt->addPoint(PointId, Clustering_);
-    }
+    std::vector<SchedClassCluster> SchedClassClusters =
+        makeSchedClassClusters(RSCAndPoints);
 
     // Print any scheduling class that has at least one cluster that does not
     // match the checked-in data.
@@ -582,5 +589,80 @@ Error Analysis::run<Analysis::PrintSchedClassInconsistencies>(
   return Error::success();
 }
 
+template <>
+Error Analysis::run<Analysis::PrintSchedModelDiff>(raw_ostream &OS) const {
+  if (Clustering_.getPoints().empty())
+    return Error::success();
+
+  const auto &Points = Clustering_.getPoints();
+  const Benchmark::ModeE Mode = Points.front().Mode;
+  const auto &SI = State_.getSubtargetInfo();
+  const auto &II = State_.getInstrInfo();
+
+  // Write the header.
+  OS << "sched_class" << kCsvSep << "cluster_id" << kCsvSep << "opcodes";
+  for (const auto &Measurement : Points.front().Measurements) {
+    OS << kCsvSep;
+    writeEscaped<kEscapeCsv>(OS, Measurement.Key + "_measured");
+    OS << kCsvSep;
+    writeEscaped<kEscapeCsv>(OS, Measurement.Key + "_model");
+  }
+  OS << kCsvSep << "match\n";
+
+  // One row per sched class cluster, sorted to be stable across runs.
+  std::vector<std::string> Rows;
+  for (const auto &RSCAndPoints : makePointsPerSchedClass()) {
+    if (!RSCAndPoints.RSC.SCDesc)
+      continue;
+    std::string SchedClass;
+#if !defined(NDEBUG) || defined(LLVM_ENABLE_DUMP)
+    SchedClass = RSCAndPoints.RSC.SCDesc->Name;
+#else
+    SchedClass = std::to_string(RSCAndPoints.RSC.SchedClassId);
+#endif
+    for (const SchedClassCluster &Cluster :
+         makeSchedClassClusters(RSCAndPoints)) {
+      std::string Line;
+      raw_string_ostream LineOS(Line);
+      writeEscaped<kEscapeCsv>(LineOS, SchedClass);
+      LineOS << kCsvSep;
+      writeClusterId<kEscapeCsv>(LineOS, Cluster.id());
+      LineOS << kCsvSep;
+
+      std::set<StringRef> Opcodes;
+      for (const size_t PointId : Cluster.getPointIds())
+        Opcodes.insert(II.getName(Points[PointId].keyInstruction().getOpcode()));
+      writeEscaped<kEscapeCsv>(LineOS, join(Opcodes, " "));
+
+      const std::vector<BenchmarkMeasure> Measured =
+          Cluster.getCentroid().getAsPoint();
+      std::vector<BenchmarkMeasure> Modeled;
+      if (Cluster.getCentroid().validate(Mode))
+        Modeled = RSCAndPoints.RSC.getAsPoint(Mode, SI,
+                                              Cluster.getCentroid().getStats());
+      for (size_t I = 0, E = Measured.size(); I < E; ++I) {
+        LineOS << kCsvSep;
+        writeMeasurementValue<kEscapeCsv>(LineOS,
+                                          Measured[I].PerInstructionValue);
+        LineOS << kCsvSep;
+        if (I < Modeled.size())
+          writeMeasurementValue<kEscapeCsv>(LineOS,
+                                            Modeled[I].PerInstructionValue);
+      }
+      LineOS << kCsvSep
+             << (Cluster.measurementsMatch(SI, RSCAndPoints.RSC, Clustering_,
+                                           AnalysisInconsistencyEpsilonSquared_)
+                     ? "yes"
+                     : "no");
+      Rows.push_back(std::move(Line));
+    }
+  }
+
+  llvm::sort(Rows);
+  for (const std::string &R : Rows)
+    OS << R << "\n";
+  return Error::success();
+}
+
 } // namespace exegesis
 } // namespace llvm
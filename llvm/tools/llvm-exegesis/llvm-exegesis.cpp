@@ -37,6 +37,7 @@
 #include "llvm/MC/TargetRegistry.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Errno.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/InitLLVM.h"
@@ -47,6 +48,10 @@
 #include <algorithm>
 #include <string>
 
+#ifdef __linux__
+#include <sched.h>
+#endif // __linux__
+
 namespace llvm {
 namespace exegesis {
 
@@ -210,6 +215,12 @@ static cl::opt<std::string>
                                       cl::desc(""), cl::cat(AnalysisOptions),
                                       cl::init(""));
 
+static cl::opt<std::string> AnalysisSchedModelDiffOutputFile(
+    "analysis-sched-model-diff-output-file",
+    cl::desc("Write a csv with the measured and the modeled values of every "
+             "sched class cluster, to be diffed against the sched model"),
+    cl::cat(AnalysisOptions), cl::init(""));
+
 static cl::opt<bool> AnalysisDisplayUnstableOpcodes(
     "analysis-display-unstable-clusters",
     cl::desc("if there is more than one benchmark for an opcode, said "
@@ -269,6 +280,18 @@ static cl::list<ValidationEvent> ValidationCounters(
         "counter to validate benchmarking assumptions"),
     cl::CommaSeparated, cl::cat(BenchmarkOptions), ValidationEventOptions());
 
+static cl::opt<bool> SubprocessAfterCrash(
+    "subprocess-after-crash",
+    cl::desc("Run snippets in-process until one crashes, then run that "
+             "snippet and all later ones in the subprocess execution mode"),
+    cl::cat(BenchmarkOptions), cl::init(false));
+
+static cl::opt<int> BenchmarkProcessCPU(
+    "benchmark-process-cpu",
+    cl::desc("Pin llvm-exegesis, and the subprocesses that it runs snippets "
+             "in, to this CPU (-1 to not pin)"),
+    cl::cat(BenchmarkOptions), cl::init(-1));
+
 static ExitOnError ExitOnErr("llvm-exegesis error: ");
 
 // Helper function that logs the error(s) and exits.
@@ -384,7 +407,7 @@ generateSnippets(const LLVMState &State, unsigned Opcode,
 static void runBenchmarkConfigurations(
     const LLVMState &State, ArrayRef<BenchmarkCode> Configurations,
     ArrayRef<std::unique_ptr<const SnippetRepetitor>> Repetitors,
-    const BenchmarkRunner &Runner) {
+    const BenchmarkRunner &Runner, const BenchmarkRunner *FallbackRunner) {
   assert(!Configurations.empty() && "Don't have any configurations to run.");
   std::optional<raw_fd_ostream> FileOstr;
   if (BenchmarkFile != "-") {
@@ -406,31 +429,46 @@ static void runBenchmarkConfigurations(
       RepetitionMode == Benchmark::MiddleHalfLoop)
     MinInstructionCounts.push_back(MinInstructions * 2);
 
+  const BenchmarkRunner *ActiveRunner = &Runner;
   for (const BenchmarkCode &Conf : Configurations) {
     ProgressMeter<>::ProgressMeterStep MeterStep(Meter ? &*Meter : nullptr);
     SmallVector<Benchmark, 2> AllResults;
 
-    for (const std::unique_ptr<const SnippetRepetitor> &Repetitor :
-         Repetitors) {
-      for (unsigned IterationRepetitions : MinInstructionCounts) {
-        auto RC = ExitOnErr(Runner.getRunnableConfiguration(
-            Conf, IterationRepetitions, LoopBodySize, *Repetitor));
-        std::optional<StringRef> DumpFile;
-        if (DumpObjectToDisk.getNumOccurrences())
-          DumpFile = DumpObjectToDisk;
-        auto [Err, BenchmarkResult] =
-            Runner.runConfiguration(std::move(RC), DumpFile);
-        if (Err) {
-          // Errors from executing the snippets are fine.
-          // All other errors are a framework issue and should fail.
-          if (!Err.isA<SnippetExecutionFailure>())
-            ExitOnErr(std::move(Err));
-
-          BenchmarkResult.Error = toString(std::move(Err));
+    bool Crashed;
+    do {
+      Crashed = false;
+      AllResults.clear();
+      for (const std::unique_ptr<const SnippetRepetitor> &Repetitor :
+           Repetitors) {
+        for (unsigned IterationRepetitions : MinInstructionCounts) {
+          auto RC = ExitOnErr(ActiveRunner->getRunnableConfiguration(
+              Conf, IterationRepetitions, LoopBodySize, *Repetitor));
+          std::optional<StringRef> DumpFile;
+          if (DumpObjectToDisk.getNumOccurrences())
+            DumpFile = DumpObjectToDisk;
+          auto [Err, BenchmarkResult] =
+              ActiveRunner->runConfiguration(std::move(RC), DumpFile);
+          if (Err) {
+            // Errors from executing the snippets are fine.
+            // All other errors are a framework issue and should fail.
+            if (!Err.isA<SnippetExecutionFailure>())
+              ExitOnErr(std::move(Err));
+
+            Crashed = true;
+            BenchmarkResult.Error = toString(std::move(Err));
+          }
+          AllResults.push_back(std::move(BenchmarkResult));
         }
-        AllResults.push_back(std::move(BenchmarkResult));
       }
-    }
+
+      // The crash may have left the process in a bad state, so measure this
+      // snippet again, and all later ones, in subprocesses.
+      if (!Crashed || !FallbackRunner || ActiveRunner == FallbackRunner)
+        break;
+      errs() << "llvm-exegesis: snippet crashed, switching to the subprocess "
+                "execution mode\n";
+      ActiveRunner = FallbackRunner;
+    } while (true);
 
     Benchmark &Result = AllResults.front();
 
@@ -495,6 +533,35 @@ void benchmarkMain() {
     ExitWithError("cannot create benchmark runner");
   }
 
+  std::unique_ptr<BenchmarkRunner> FallbackRunner;
+  if (SubprocessAfterCrash) {
+    if (ExecutionMode != BenchmarkRunner::ExecutionModeE::InProcess)
+      ExitWithError("--subprocess-after-crash requires the inprocess "
+                    "execution mode");
+    if (UseDummyPerfCounters)
+      ExitWithError("Dummy perf counters are not supported in the subprocess "
+                    "execution mode.");
+    FallbackRunner = ExitOnErr(State.getExegesisTarget().createBenchmarkRunner(
+        BenchmarkMode, State, BenchmarkPhaseSelector,
+        BenchmarkRunner::ExecutionModeE::SubProcess, BenchmarkRepeatCount,
+        ValidationCounters, ResultAggMode));
+    if (!FallbackRunner)
+      ExitWithError("cannot create benchmark runner");
+  }
+
+  if (BenchmarkProcessCPU >= 0) {
+#ifdef __linux__
+    cpu_set_t CPUMask;
+    CPU_ZERO(&CPUMask);
+    CPU_SET(BenchmarkProcessCPU, &CPUMask);
+    if (sched_setaffinity(0, sizeof(CPUMask), &CPUMask) == -1)
+      ExitWithError("cannot pin to CPU " + Twine(BenchmarkProcessCPU) + ": " +
+                    sys::StrError());
+#else
+    ExitWithError("--benchmark-process-cpu is only supported on Linux");
+#endif // __linux__
+  }
+
   const auto Opcodes = getOpcodesOrDie(State);
   std::vector<BenchmarkCode> Configurations;
 
@@ -565,7 +632,8 @@ void benchmarkMain() {
     BenchmarkFile = "-";
 
   if (!Configurations.empty())
-    runBenchmarkConfigurations(State, Configurations, Repetitors, *Runner);
+    runBenchmarkConfigurations(State, Configurations, Repetitors, *Runner,
+                               FallbackRunner.get());
 
   pfm::pfmTerminate();
 }
@@ -615,10 +683,12 @@ static void analysisMain() {
     ExitWithError("--benchmarks-file must be set");
 
   if (AnalysisClustersOutputFile.empty() &&
-      AnalysisInconsistenciesOutputFile.empty()) {
+      AnalysisInconsistenciesOutputFile.empty() &&
+      AnalysisSchedModelDiffOutputFile.empty()) {
     ExitWithError(
-        "for --mode=analysis: At least one of --analysis-clusters-output-file "
-        "and --analysis-inconsistencies-output-file must be specified");
+        "for --mode=analysis: At least one of --analysis-clusters-output-file, "
+        "--analysis-inconsistencies-output-file and "
+        "--analysis-sched-model-diff-output-file must be specified");
   }
 
   InitializeAllAsmPrinters();
@@ -679,6 +749,8 @@ static void analysisMain() {
   maybeRunAnalysis<Analysis::PrintSchedClassInconsistencies>(
       Analyzer, "sched class consistency analysis",
       AnalysisInconsistenciesOutputFile);
+  maybeRunAnalysis<Analysis::PrintSchedModelDiff>(
+      Analyzer, "sched model diff", AnalysisSchedModelDiffOutputFile);
 }
 
 } // namespace exegesis
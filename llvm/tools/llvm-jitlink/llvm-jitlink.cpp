@@ -59,6 +59,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/Timer.h"
 
+#include <array>
 #include <cstring>
 #include <deque>
 #include <string>
@@ -257,7 +258,8 @@ static cl::opt<bool>
 
 static cl::opt<bool> UseSharedMemory(
     "use-shared-memory",
-    cl::desc("Use shared memory to transfer generated code and data"),
+    cl::desc("Use shared memory to transfer generated code and data (the "
+             "default for executors launched with -oop-executor)"),
     cl::init(false), cl::cat(JITLinkCategory));
 
 static ExitOnError ExitOnErr;
@@ -617,19 +619,6 @@ static std::unique_ptr<JITLinkMemoryManager> createInProcessMemoryManager() {
 
 Expected<std::unique_ptr<jitlink::JITLinkMemoryManager>>
 createSharedMemoryManager(SimpleRemoteEPC &SREPC) {
-  SharedMemoryMapper::SymbolAddrs SAs;
-  if (auto Err = SREPC.getBootstrapSymbols(
-          {{SAs.Instance, rt::ExecutorSharedMemoryMapperServiceInstanceName},
-           {SAs.Reserve,
-            rt::ExecutorSharedMemoryMapperServiceReserveWrapperName},
-           {SAs.Initialize,
-            rt::ExecutorSharedMemoryMapperServiceInitializeWrapperName},
-           {SAs.Deinitialize,
-            rt::ExecutorSharedMemoryMapperServiceDeinitializeWrapperName},
-           {SAs.Release,
-            rt::ExecutorSharedMemoryMapperServiceReleaseWrapperName}}))
-    return std::move(Err);
-
 #ifdef _WIN32
   size_t SlabSize = 1024 * 1024;
 #else
@@ -639,8 +628,7 @@ createSharedMemoryManager(SimpleRemoteEPC &SREPC) {
   if (!SlabAllocateSizeString.empty())
     SlabSize = ExitOnErr(getSlabAllocSize(SlabAllocateSizeString));
 
-  return MapperJITLinkMemoryManager::CreateWithMapper<SharedMemoryMapper>(
-      SlabSize, SREPC, SAs);
+  return SimpleRemoteEPC::createSharedMemoryManager(SREPC, SlabSize);
 }
 
 
@@ -802,9 +790,21 @@ static Expected<std::unique_ptr<ExecutorProcessControl>> launchExecutor() {
   close(ToExecutor[ReadEnd]);
   close(FromExecutor[WriteEnd]);
 
+  // The executor runs on this machine, so unless told otherwise, transfer code
+  // and data through shared memory rather than copying them through the pipe.
+  // Fall back to the pipe if the executor does not support shared memory.
   auto S = SimpleRemoteEPC::Setup();
   if (UseSharedMemory)
     S.CreateMemoryManager = createSharedMemoryManager;
+  else if (UseSharedMemory.getNumOccurrences() == 0)
+    S.CreateMemoryManager = [](SimpleRemoteEPC &SREPC)
+        -> Expected<std::unique_ptr<jitlink::JITLinkMemoryManager>> {
+      auto MemMgr = createSharedMemoryManager(SREPC);
+      if (MemMgr)
+        return MemMgr;
+      consumeError(MemMgr.takeError());
+      return SimpleRemoteEPC::createDefaultMemoryManager(SREPC);
+    };
 
   return SimpleRemoteEPC::Create<FDSimpleRemoteEPCTransport>(
       std::make_unique<DynamicThreadPoolTaskDispatcher>(std::nullopt),
@@ -1139,6 +1139,32 @@ void Session::dumpSessionInfo(raw_ostream &OS) {
 
 void Session::modifyPassConfig(const Triple &TT,
                                PassConfiguration &PassConfig) {
+  // Passes that take a time stamp at each boundary between link phases and
+  // add the time since the previous one to the phase that just ended.
+  using Clock = std::chrono::steady_clock;
+  auto Stamps =
+      std::make_shared<std::array<Clock::time_point, NumLinkPhases + 1>>();
+  auto Stamp = [this, Stamps](unsigned Boundary) {
+    return [this, Stamps, Boundary](LinkGraph &) {
+      auto &Times = *Stamps;
+      Times[Boundary] = Clock::now();
+      if (Boundary != 0) {
+        std::lock_guard<std::mutex> Lock(LinkPhaseTimesMutex);
+        LinkPhaseTimes[Boundary - 1] += Times[Boundary] - Times[Boundary - 1];
+      }
+      return Error::success();
+    };
+  };
+
+  if (ShowTimes) {
+    PassConfig.PrePrunePasses.insert(PassConfig.PrePrunePasses.begin(),
+                                     Stamp(PrunePhase));
+    PassConfig.PostPrunePasses.insert(PassConfig.PostPrunePasses.begin(),
+                                      Stamp(AllocatePhase));
+    PassConfig.PostAllocationPasses.insert(
+        PassConfig.PostAllocationPasses.begin(), Stamp(LookupPhase));
+  }
+
   if (!CheckFiles.empty())
     PassConfig.PostFixupPasses.push_back([this](LinkGraph &G) {
       if (ES.getTargetTriple().getObjectFormat() == Triple::ELF)
@@ -1178,6 +1204,24 @@ void Session::modifyPassConfig(const Triple &TT,
 
   if (AddSelfRelocations)
     PassConfig.PostPrunePasses.push_back(addSelfRelocations);
+
+  if (ShowTimes) {
+    PassConfig.PreFixupPasses.push_back(Stamp(FixUpPhase));
+    PassConfig.PostFixupPasses.insert(PassConfig.PostFixupPasses.begin(),
+                                      Stamp(PostFixUpPhase));
+    PassConfig.PostFixupPasses.push_back(Stamp(NumLinkPhases));
+  }
+}
+
+void Session::printLinkPhaseTimes(raw_ostream &OS) {
+  static const char *PhaseNames[NumLinkPhases] = {"prune", "allocate", "lookup",
+                                                  "fixup", "post-fixup"};
+  std::lock_guard<std::mutex> Lock(LinkPhaseTimesMutex);
+  OS << "Link phase times, summed over all graphs:\n";
+  for (unsigned I = 0; I != NumLinkPhases; ++I)
+    OS << format("  %-10s %10.3f ms\n", PhaseNames[I],
+                 std::chrono::duration<double, std::milli>(LinkPhaseTimes[I])
+                     .count());
 }
 
 Expected<JITDylib *> Session::getOrLoadDynamicLibrary(StringRef LibPath) {
@@ -2360,8 +2404,10 @@ int main(int argc, char *argv[]) {
     S->dumpSessionInfo(outs());
 
   if (!EntryPoint) {
-    if (Timers)
+    if (Timers) {
       Timers->JITLinkTG.printAll(errs());
+      S->printLinkPhaseTimes(errs());
+    }
     reportLLVMJITLinkError(EntryPoint.takeError());
     exit(1);
   }
@@ -2380,6 +2426,9 @@ int main(int argc, char *argv[]) {
           runWithoutRuntime(*S, ExecutorAddr(EntryPoint->getAddress())));
   }
 
+  if (Timers)
+    S->printLinkPhaseTimes(errs());
+
   // Destroy the session.
   ExitOnErr(S->ES.endSession());
   S.reset();
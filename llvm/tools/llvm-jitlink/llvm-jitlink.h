@@ -25,6 +25,9 @@
 #include "llvm/TargetParser/SubtargetFeature.h"
 #include "llvm/TargetParser/Triple.h"
 
+#include <chrono>
+#include <mutex>
+
 namespace llvm {
 
 struct Session {
@@ -97,6 +100,23 @@ struct Session {
 
   std::optional<Regex> ShowGraphsRegex;
 
+  /// Phases of linking a graph, separated by the hooks of its pass pipeline.
+  enum LinkPhase {
+    PrunePhase,     // Pre-prune passes and dead-stripping.
+    AllocatePhase,  // Post-prune passes and memory allocation.
+    LookupPhase,    // Post-allocation passes, external lookup, pre-fixup passes.
+    FixUpPhase,     // Copying block content and applying fixups.
+    PostFixUpPhase, // Post-fixup passes.
+    NumLinkPhases
+  };
+
+  /// Time spent in each link phase, summed over all graphs. Only recorded if
+  /// -show-times is given.
+  std::mutex LinkPhaseTimesMutex;
+  std::chrono::steady_clock::duration LinkPhaseTimes[NumLinkPhases] = {};
+
+  void printLinkPhaseTimes(raw_ostream &OS);
+
 private:
   Session(std::unique_ptr<orc::ExecutorProcessControl> EPC, Error &Err);
 };
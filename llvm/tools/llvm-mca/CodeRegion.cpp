@@ -112,6 +112,15 @@ void AnalysisRegions::endRegion(StringRef Description, SMLoc Loc) {
   }
 }
 
+CodeRegion &AnalysisRegions::addRegion(StringRef Description, SMLoc Loc) {
+  // Replace the default region, like beginRegion does.
+  if (Regions.size() == 1 && !Regions[0]->startLoc().isValid() &&
+      !Regions[0]->endLoc().isValid() && Regions[0]->empty())
+    Regions.clear();
+  Regions.emplace_back(std::make_unique<CodeRegion>(Description, Loc));
+  return *Regions.back();
+}
+
 InstrumentRegions::InstrumentRegions(llvm::SourceMgr &S) : CodeRegions(S) {}
 
 void InstrumentRegions::beginRegion(StringRef Description, SMLoc Loc,
@@ -201,6 +201,10 @@ struct AnalysisRegions : public CodeRegions {
   void beginRegion(llvm::StringRef Description, llvm::SMLoc Loc,
                    UniqueInstrument Instrument) override {}
   void endRegion(llvm::StringRef Description, llvm::SMLoc Loc) override;
+
+  /// Append a region that is not delimited by markers in the input, e.g. one
+  /// reconstructed from a profile, and return it to add instructions to it.
+  CodeRegion &addRegion(llvm::StringRef Description, llvm::SMLoc Loc);
 };
 
 struct InstrumentRegions : public CodeRegions {
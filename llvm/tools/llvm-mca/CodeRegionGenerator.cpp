@@ -15,12 +15,19 @@
 
 #include "CodeRegionGenerator.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/MC/MCDisassembler/MCDisassembler.h"
 #include "llvm/MC/MCParser/MCTargetAsmParser.h"
 #include "llvm/MC/MCTargetOptions.h"
+#include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/SMLoc.h"
+#include "llvm/Support/WithColor.h"
+#include <map>
 #include <memory>
+#include <tuple>
 
 namespace llvm {
 namespace mca {
@@ -170,5 +177,204 @@ void InstrumentRegionCommentConsumer::HandleComment(SMLoc Loc,
   Regions.beginRegion(InstrumentKind, Loc, std::move(I));
 }
 
+namespace {
+/// A taken branch recorded in a branch stack.
+struct LBREntry {
+  uint64_t From;
+  uint64_t To;
+
+  bool operator==(const LBREntry &Other) const {
+    return From == Other.From && To == Other.To;
+  }
+  bool operator<(const LBREntry &Other) const {
+    return std::tie(From, To) < std::tie(Other.From, Other.To);
+  }
+};
+
+/// The straight-line address ranges executed by one loop iteration, in order.
+/// The end of a range is the address of its last instruction.
+using LBRTrace = std::vector<std::pair<uint64_t, uint64_t>>;
+
+struct LBRLoop {
+  uint64_t Samples = 0;
+  std::map<LBRTrace, uint64_t> Traces;
+};
+
+struct TextSection {
+  uint64_t Address;
+  ArrayRef<uint8_t> Bytes;
+};
+} // namespace
+
+/// Parse the branch stack of one line of `perf script -F ip,brstack` into
+/// \p Stack, oldest branch first. Fields without a '/' are ignored.
+static bool parseBranchStack(StringRef Line, SmallVectorImpl<LBREntry> &Stack) {
+  SmallVector<StringRef, 32> Fields;
+  Line.split(Fields, ' ', -1, /*KeepEmpty=*/false);
+  for (StringRef Field : Fields) {
+    Field = Field.trim();
+    if (!Field.contains('/'))
+      continue;
+    auto [From, Rest] = Field.split('/');
+    StringRef To = Rest.split('/').first;
+    From.consume_front("0x");
+    To.consume_front("0x");
+    LBREntry Entry;
+    if (From.getAsInteger(16, Entry.From) || To.getAsInteger(16, Entry.To))
+      return false;
+    Stack.push_back(Entry);
+  }
+  // perf prints the most recent branch first.
+  std::reverse(Stack.begin(), Stack.end());
+  return true;
+}
+
+Expected<const CodeRegions &> LBRAnalysisRegionGenerator::parseCodeRegions(
+    const std::unique_ptr<MCInstPrinter> &IP) {
+  llvm::SourceMgr &SM = Regions.getSourceMgr();
+  const MemoryBuffer *Input = SM.getMemoryBuffer(SM.getMainFileID());
+
+  // Count the back-edges, and the iterations recorded between two consecutive
+  // occurrences of the same back-edge.
+  std::map<LBREntry, LBRLoop> Loops;
+  SmallVector<StringRef, 0> Lines;
+  Input->getBuffer().split(Lines, '\n', -1, /*KeepEmpty=*/false);
+  for (auto [LineNo, Line] : enumerate(Lines)) {
+    SmallVector<LBREntry, 32> Stack;
+    if (!parseBranchStack(Line, Stack))
+      return make_error<StringError>(
+          "invalid branch stack entry on line " + Twine(LineNo + 1) + " of " +
+              Input->getBufferIdentifier(),
+          inconvertibleErrorCode());
+
+    for (auto [I, BackEdge] : enumerate(Stack)) {
+      if (BackEdge.To > BackEdge.From)
+        continue;
+      LBRLoop &Loop = Loops[BackEdge];
+      ++Loop.Samples;
+
+      auto Next = std::find(Stack.begin() + I + 1, Stack.end(), BackEdge);
+      if (Next == Stack.end())
+        continue;
+      LBRTrace Trace;
+      for (const LBREntry *E = &Stack[I]; E != Next; ++E) {
+        if (E->To > (E + 1)->From) {
+          Trace.clear();
+          break;
+        }
+        Trace.emplace_back(E->To, (E + 1)->From);
+      }
+      if (!Trace.empty())
+        ++Loop.Traces[Trace];
+    }
+  }
+
+  Expected<object::OwningBinary<object::ObjectFile>> BinaryOrErr =
+      object::ObjectFile::createObjectFile(BinaryPath);
+  if (!BinaryOrErr)
+    return BinaryOrErr.takeError();
+  SmallVector<TextSection, 4> Sections;
+  for (const object::SectionRef &Section : BinaryOrErr->getBinary()->sections()) {
+    if (!Section.isText())
+      continue;
+    Expected<StringRef> Contents = Section.getContents();
+    if (!Contents)
+      return Contents.takeError();
+    Sections.push_back({Section.getAddress(), arrayRefFromStringRef(*Contents)});
+  }
+
+  std::unique_ptr<MCDisassembler> DisAsm(
+      TheTarget.createMCDisassembler(STI, Ctx));
+  if (!DisAsm)
+    return make_error<StringError>("unable to create a disassembler for " +
+                                       STI.getTargetTriple().str(),
+                                   inconvertibleErrorCode());
+
+  // Decode the instructions from Begin up to and including the one at End.
+  // Returns false if End is not reached on an instruction boundary.
+  auto DecodeRange = [&](uint64_t Begin, uint64_t End,
+                         SmallVectorImpl<MCInst> &Insts) {
+    for (uint64_t Address = Begin; Address <= End;) {
+      const TextSection *Section = find_if(Sections, [&](const TextSection &S) {
+        return Address >= S.Address && Address - S.Address < S.Bytes.size();
+      });
+      if (Section == Sections.end())
+        return false;
+      MCInst Inst;
+      uint64_t Size;
+      if (DisAsm->getInstruction(Inst, Size,
+                                 Section->Bytes.drop_front(Address -
+                                                           Section->Address),
+                                 Address, nulls()) != MCDisassembler::Success ||
+          !Size)
+        return false;
+      Insts.push_back(Inst);
+      if (Address == End)
+        return true;
+      Address += Size;
+    }
+    return false;
+  };
+
+  // Only keep direct jumps, to drop returns and calls to lower addresses.
+  auto IsLoopBranch = [&](uint64_t Address) {
+    SmallVector<MCInst, 1> Insts;
+    if (!DecodeRange(Address, Address, Insts))
+      return false;
+    const MCInst &Inst = Insts.front();
+    return !MCIA || (MCIA->isBranch(Inst) && !MCIA->isCall(Inst) &&
+                     !MCIA->isReturn(Inst) && !MCIA->isIndirectBranch(Inst));
+  };
+
+  std::vector<std::pair<LBREntry, const LBRLoop *>> HotLoops;
+  uint64_t TotalSamples = 0;
+  for (const auto &[BackEdge, Loop] : Loops) {
+    if (!IsLoopBranch(BackEdge.From))
+      continue;
+    HotLoops.emplace_back(BackEdge, &Loop);
+    TotalSamples += Loop.Samples;
+  }
+  llvm::stable_sort(HotLoops, [](const auto &A, const auto &B) {
+    return A.second->Samples > B.second->Samples;
+  });
+  if (MaxLoops && HotLoops.size() > MaxLoops)
+    HotLoops.resize(MaxLoops);
+
+  SMLoc Loc = SMLoc::getFromPointer(Input->getBufferStart());
+  for (const auto &[BackEdge, Loop] : HotLoops) {
+    // Prefer the most frequent complete iteration, which follows the taken
+    // branches in the loop.
+    SmallVector<MCInst, 32> Insts;
+    bool Decoded = false;
+    if (!Loop->Traces.empty()) {
+      auto Best = std::max_element(
+          Loop->Traces.begin(), Loop->Traces.end(),
+          [](const auto &A, const auto &B) { return A.second < B.second; });
+      Decoded = all_of(Best->first, [&](const auto &Range) {
+        return DecodeRange(Range.first, Range.second, Insts);
+      });
+      if (!Decoded)
+        Insts.clear();
+    }
+    if (!Decoded && !DecodeRange(BackEdge.To, BackEdge.From, Insts)) {
+      WithColor::warning() << "unable to disassemble the loop at "
+                           << format_hex(BackEdge.To, 0) << ", skipping it.\n";
+      continue;
+    }
+
+    std::string Description;
+    raw_string_ostream OS(Description);
+    OS << "loop " << format_hex(BackEdge.To, 0) << "-"
+       << format_hex(BackEdge.From, 0) << " ("
+       << format("%.1f", 100.0 * Loop->Samples / TotalSamples)
+       << "% of sampled back-edges, " << Loop->Samples << " samples)";
+    CodeRegion &Region = Regions.addRegion(Saver.save(OS.str()), Loc);
+    for (const MCInst &Inst : Insts)
+      Region.addInstruction(Inst);
+  }
+
+  return Regions;
+}
+
 } // namespace mca
 } // namespace llvm
@@ -19,13 +19,16 @@
 #include "CodeRegion.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCContext.h"
+#include "llvm/MC/MCInstrAnalysis.h"
 #include "llvm/MC/MCParser/MCAsmLexer.h"
 #include "llvm/MC/MCStreamer.h"
 #include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/MC/TargetRegistry.h"
 #include "llvm/MCA/CustomBehaviour.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/StringSaver.h"
 #include <memory>
 
 namespace llvm {
@@ -268,6 +271,50 @@ public:
   }
 };
 
+/// Generates one AnalysisRegion per hot loop of a binary from the branch
+/// stacks (LBR) of perf samples, as printed by `perf script -F ip,brstack`.
+///
+/// Every taken backward branch is treated as a loop back-edge. The body of a
+/// loop is the most frequent sequence of instructions executed from the target
+/// of the back-edge up to the back-edge, as recorded between two consecutive
+/// occurrences of the back-edge in one branch stack. This follows taken
+/// branches inside the loop, including calls. Loops that never complete an
+/// iteration within one branch stack fall back to the instructions laid out
+/// between the target and the back-edge. Regions are ordered by the number of
+/// times their back-edge was sampled, and are named after their address range
+/// and their share of all sampled back-edges.
+///
+/// The sampled addresses must be the addresses the binary was linked at.
+class LBRAnalysisRegionGenerator final : public AnalysisRegionGenerator {
+  MCContext &Ctx;
+  const Target &TheTarget;
+  const MCSubtargetInfo &STI;
+  const MCInstrAnalysis *MCIA;
+  StringRef BinaryPath;
+  unsigned MaxLoops;
+  BumpPtrAllocator Alloc;
+  StringSaver Saver;
+
+public:
+  LBRAnalysisRegionGenerator(const Target &T, llvm::SourceMgr &SM,
+                             MCContext &C, const MCSubtargetInfo &S,
+                             const MCInstrAnalysis *IA, StringRef BinaryPath,
+                             unsigned MaxLoops)
+      : AnalysisRegionGenerator(SM), Ctx(C), TheTarget(T), STI(S), MCIA(IA),
+        BinaryPath(BinaryPath), MaxLoops(MaxLoops), Saver(Alloc) {}
+
+  Expected<const AnalysisRegions &>
+  parseAnalysisRegions(const std::unique_ptr<MCInstPrinter> &IP) override {
+    Expected<const CodeRegions &> RegionsOrErr = parseCodeRegions(IP);
+    if (!RegionsOrErr)
+      return RegionsOrErr.takeError();
+    return static_cast<const AnalysisRegions &>(*RegionsOrErr);
+  }
+
+  Expected<const CodeRegions &>
+  parseCodeRegions(const std::unique_ptr<MCInstPrinter> &IP) override;
+};
+
 } // namespace mca
 } // namespace llvm
 
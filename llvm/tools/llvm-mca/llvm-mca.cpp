@@ -60,6 +60,7 @@
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/TargetParser/Host.h"
+#include <optional>
 
 using namespace llvm;
 
@@ -110,6 +111,19 @@ static cl::opt<bool>
     PrintImmHex("print-imm-hex", cl::cat(ToolOptions), cl::init(false),
                 cl::desc("Prefer hex format when printing immediate values"));
 
+static cl::opt<std::string> LBRBinary(
+    "lbr-binary",
+    cl::desc("Analyze the hot loops of this binary, reconstructed from the "
+             "branch stacks of perf samples. The input is then the output of "
+             "'perf script -F ip,brstack' instead of assembly"),
+    cl::value_desc("filename"), cl::cat(ToolOptions));
+
+static cl::opt<unsigned>
+    LBRMaxLoops("lbr-max-loops",
+                cl::desc("Maximum number of hot loops to analyze with "
+                         "-lbr-binary, or 0 for all. Defaults to 10"),
+                cl::cat(ToolOptions), cl::init(10));
+
 static cl::opt<unsigned> Iterations("iterations",
                                     cl::desc("Number of iterations to run"),
                                     cl::cat(ToolOptions), cl::init(0));
@@ -325,6 +339,7 @@ int main(int argc, char **argv) {
   InitializeAllTargetInfos();
   InitializeAllTargetMCs();
   InitializeAllAsmParsers();
+  InitializeAllDisassemblers();
   InitializeAllTargetMCAs();
 
   // Register the Target and CPU printer for --version.
@@ -439,8 +454,13 @@ int main(int argc, char **argv) {
   ACtx.setObjectFileInfo(AMOFI.get());
   mca::AsmAnalysisRegionGenerator CRG(*TheTarget, SrcMgr, ACtx, *MAI, *STI,
                                       *MCII);
+  std::optional<mca::LBRAnalysisRegionGenerator> LBRG;
+  if (!LBRBinary.empty())
+    LBRG.emplace(*TheTarget, SrcMgr, ACtx, *STI, MCIA.get(), LBRBinary,
+                 LBRMaxLoops);
   Expected<const mca::AnalysisRegions &> RegionsOrErr =
-      CRG.parseAnalysisRegions(std::move(IPtemp));
+      LBRG ? LBRG->parseAnalysisRegions(IPtemp)
+           : CRG.parseAnalysisRegions(std::move(IPtemp));
   if (!RegionsOrErr) {
     if (auto Err =
             handleErrors(RegionsOrErr.takeError(), [](const StringError &E) {
@@ -481,8 +501,12 @@ int main(int argc, char **argv) {
   ICtx.setObjectFileInfo(IMOFI.get());
   mca::AsmInstrumentRegionGenerator IRG(*TheTarget, SrcMgr, ICtx, *MAI, *STI,
                                         *MCII, *IM);
+  // Instruments are given as comments in assembly input, so there are none
+  // when the input is a profile.
+  mca::InstrumentRegions NoInstrumentRegions(SrcMgr);
   Expected<const mca::InstrumentRegions &> InstrumentRegionsOrErr =
-      IRG.parseInstrumentRegions(std::move(IPtemp));
+      LBRG ? Expected<const mca::InstrumentRegions &>(NoInstrumentRegions)
+           : IRG.parseInstrumentRegions(std::move(IPtemp));
   if (!InstrumentRegionsOrErr) {
     if (auto Err = handleErrors(InstrumentRegionsOrErr.takeError(),
                                 [](const StringError &E) {
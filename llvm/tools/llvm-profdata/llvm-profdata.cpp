@@ -944,12 +944,27 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   } else {
     DefaultThreadPool Pool(hardware_concurrency(NumThreads));
 
-    // Load the inputs in parallel (N/NumThreads serial steps).
-    unsigned Ctx = 0;
+    // Load the inputs in parallel (N/NumThreads serial steps). Each input goes
+    // to whichever context is idle rather than to a fixed one, so that a large
+    // input does not hold up the inputs after it while other threads have
+    // nothing to do. There are no more threads than contexts, so there is
+    // always an idle one.
+    std::mutex IdleLock;
+    SmallVector<WriterContext *, 4> IdleContexts;
+    for (std::unique_ptr<WriterContext> &WC : Contexts)
+      IdleContexts.push_back(WC.get());
     for (const auto &Input : Inputs) {
-      Pool.async(loadInput, Input, Remapper, Correlator.get(), ProfiledBinary,
-                 Contexts[Ctx].get());
-      Ctx = (Ctx + 1) % NumThreads;
+      Pool.async([&, Input] {
+        WriterContext *WC;
+        {
+          std::lock_guard<std::mutex> Guard(IdleLock);
+          assert(!IdleContexts.empty() && "more threads than contexts");
+          WC = IdleContexts.pop_back_val();
+        }
+        loadInput(Input, Remapper, Correlator.get(), ProfiledBinary, WC);
+        std::lock_guard<std::mutex> Guard(IdleLock);
+        IdleContexts.push_back(WC);
+      });
     }
     Pool.wait();
 
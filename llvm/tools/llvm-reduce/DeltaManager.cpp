@@ -50,8 +50,11 @@
 #include "deltas/RunIRPasses.h"
 #include "deltas/SimplifyInstructions.h"
 #include "deltas/StripDebugInfo.h"
+#include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Timer.h"
 
 using namespace llvm;
 
@@ -70,6 +73,68 @@ static cl::list<std::string>
                              "default, run all delta passes."),
                     cl::cat(LLVMReduceOptions), cl::CommaSeparated);
 
+static cl::opt<bool> ReportPassStats(
+    "report-pass-stats",
+    cl::desc("Print the time spent in each delta pass, the number of "
+             "interesting-ness tests it ran and how much it reduced the input"),
+    cl::cat(LLVMReduceOptions));
+
+namespace {
+struct DeltaPassStats {
+  unsigned NumRuns = 0;
+  double WallTime = 0;
+  unsigned NumTestsRun = 0;
+  unsigned NumCacheHits = 0;
+  uint64_t ComplexityRemoved = 0;
+};
+} // namespace
+
+using DeltaPassStatsMap = MapVector<StringRef, DeltaPassStats>;
+
+static void runDeltaPass(TestRunner &Tester, StringRef Name,
+                         function_ref<void(TestRunner &)> Pass,
+                         DeltaPassStatsMap &Stats) {
+  if (!ReportPassStats) {
+    Pass(Tester);
+    return;
+  }
+
+  uint64_t OldComplexity = Tester.getProgram().getComplexityScore();
+  unsigned OldTestsRun = Tester.getNumTestsRun();
+  unsigned OldCacheHits = Tester.getNumCacheHits();
+  TimeRecord Start = TimeRecord::getCurrentTime(/*Start=*/true);
+
+  Pass(Tester);
+
+  TimeRecord Elapsed = TimeRecord::getCurrentTime(/*Start=*/false);
+  Elapsed -= Start;
+  uint64_t NewComplexity = Tester.getProgram().getComplexityScore();
+
+  DeltaPassStats &S = Stats[Name];
+  ++S.NumRuns;
+  S.WallTime += Elapsed.getWallTime();
+  S.NumTestsRun += Tester.getNumTestsRun() - OldTestsRun;
+  S.NumCacheHits += Tester.getNumCacheHits() - OldCacheHits;
+  if (NewComplexity < OldComplexity)
+    S.ComplexityRemoved += OldComplexity - NewComplexity;
+}
+
+static void printDeltaPassStats(const DeltaPassStatsMap &Stats,
+                                uint64_t InitialComplexity) {
+  errs() << "Delta pass statistics:\n";
+  errs() << format("%-32s %5s %10s %7s %7s %12s %10s\n", "pass", "runs",
+                   "time (s)", "tests", "cached", "complexity", "per test");
+  for (const auto &[Name, S] : Stats) {
+    double PerTest =
+        S.NumTestsRun ? double(S.ComplexityRemoved) / S.NumTestsRun : 0;
+    errs() << format("%-32s %5u %10.2f %7u %7u %12llu %10.2f\n",
+                     Name.str().c_str(), S.NumRuns, S.WallTime, S.NumTestsRun,
+                     S.NumCacheHits, (unsigned long long)S.ComplexityRemoved,
+                     PerTest);
+  }
+  errs() << "Initial complexity: " << InitialComplexity << "\n";
+}
+
 #define DELTA_PASSES                                                           \
   do {                                                                         \
     DELTA_PASS("strip-debug-info", stripDebugInfoDeltaPass)                    \
@@ -129,10 +194,11 @@ static cl::list<std::string>
   } while (false)
 
 static void runAllDeltaPasses(TestRunner &Tester,
-                              const SmallStringSet &SkipPass) {
+                              const SmallStringSet &SkipPass,
+                              DeltaPassStatsMap &Stats) {
 #define DELTA_PASS(NAME, FUNC)                                                 \
   if (!SkipPass.count(NAME)) {                                                 \
-    FUNC(Tester);                                                              \
+    runDeltaPass(Tester, NAME, FUNC, Stats);                                   \
   }
   if (Tester.getProgram().isMIR()) {
     DELTA_PASSES_MIR;
@@ -142,10 +208,11 @@ static void runAllDeltaPasses(TestRunner &Tester,
 #undef DELTA_PASS
 }
 
-static void runDeltaPassName(TestRunner &Tester, StringRef PassName) {
+static void runDeltaPassName(TestRunner &Tester, StringRef PassName,
+                             DeltaPassStatsMap &Stats) {
 #define DELTA_PASS(NAME, FUNC)                                                 \
   if (PassName == NAME) {                                                      \
-    FUNC(Tester);                                                              \
+    runDeltaPass(Tester, NAME, FUNC, Stats);                                   \
     return;                                                                    \
   }
   if (Tester.getProgram().isMIR()) {
@@ -204,6 +271,8 @@ static SmallStringSet handlePassList(const TestRunner &Tester,
 
 void llvm::runDeltaPasses(TestRunner &Tester, int MaxPassIterations) {
   uint64_t OldComplexity = Tester.getProgram().getComplexityScore();
+  uint64_t InitialComplexity = OldComplexity;
+  DeltaPassStatsMap Stats;
 
   SmallStringSet RunPassSet, SkipPassSet;
 
@@ -215,11 +284,11 @@ void llvm::runDeltaPasses(TestRunner &Tester, int MaxPassIterations) {
 
   for (int Iter = 0; Iter < MaxPassIterations; ++Iter) {
     if (DeltaPasses.empty()) {
-      runAllDeltaPasses(Tester, SkipPassSet);
+      runAllDeltaPasses(Tester, SkipPassSet, Stats);
     } else {
       for (StringRef PassName : DeltaPasses) {
         if (!SkipPassSet.count(PassName))
-          runDeltaPassName(Tester, PassName);
+          runDeltaPassName(Tester, PassName, Stats);
       }
     }
 
@@ -228,4 +297,7 @@ void llvm::runDeltaPasses(TestRunner &Tester, int MaxPassIterations) {
       break;
     OldComplexity = NewComplexity;
   }
+
+  if (ReportPassStats)
+    printDeltaPassStats(Stats, InitialComplexity);
 }
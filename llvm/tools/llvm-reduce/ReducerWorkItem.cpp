@@ -460,6 +460,15 @@ bool ReducerWorkItem::verify(raw_fd_ostream *OS) const {
 bool ReducerWorkItem::isReduced(const TestRunner &Test) const {
   const bool UseBitcode = Test.inputIsBitcode() || TmpFilesAsBitcode;
 
+  SmallString<0> Contents;
+  raw_svector_ostream ContentsOS(Contents);
+  writeOutput(ContentsOS, UseBitcode);
+
+  // Different chunks often produce the same candidate, e.g. when a pass can't
+  // remove anything from them. Don't run the test again on those.
+  if (std::optional<bool> Cached = Test.getCachedResult(Contents))
+    return *Cached;
+
   SmallString<128> CurrentFilepath;
 
   // Write ReducerWorkItem to tmp file
@@ -476,7 +485,7 @@ bool ReducerWorkItem::isReduced(const TestRunner &Test) const {
 
   ToolOutputFile Out(CurrentFilepath, FD);
 
-  writeOutput(Out.os(), UseBitcode);
+  Out.os() << Contents;
 
   Out.os().close();
   if (Out.os().has_error()) {
@@ -487,7 +496,9 @@ bool ReducerWorkItem::isReduced(const TestRunner &Test) const {
   }
 
   // Current Chunks aren't interesting
-  return Test.run(CurrentFilepath);
+  bool Interesting = Test.run(CurrentFilepath);
+  Test.cacheResult(Contents, Interesting);
+  return Interesting;
 }
 
 std::unique_ptr<ReducerWorkItem>
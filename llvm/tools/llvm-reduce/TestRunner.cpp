@@ -9,10 +9,21 @@
 #include "TestRunner.h"
 #include "ReducerWorkItem.h"
 #include "deltas/Utils.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/WithColor.h"
 
 using namespace llvm;
 
+extern cl::OptionCategory LLVMReduceOptions;
+
+static cl::opt<bool> CacheTestResults(
+    "cache-test-results",
+    cl::desc("Do not run the interesting-ness test again on a candidate that "
+             "is identical to one that was already tested"),
+    cl::init(true), cl::cat(LLVMReduceOptions));
+
 TestRunner::TestRunner(StringRef TestName,
                        const std::vector<std::string> &TestArgs,
                        std::unique_ptr<ReducerWorkItem> Program,
@@ -43,6 +54,7 @@ int TestRunner::run(StringRef Filename) const {
 
   std::string ErrMsg;
 
+  ++NumTestsRun;
   int Result =
       sys::ExecuteAndWait(TestName, ProgramArgs, /*Env=*/std::nullopt,
                           Verbose ? DefaultRedirects : NullRedirects,
@@ -59,6 +71,31 @@ int TestRunner::run(StringRef Filename) const {
   return !Result;
 }
 
+static std::string getResultCacheKey(StringRef Contents) {
+  std::array<uint8_t, 20> Hash = SHA1::hash(arrayRefFromStringRef(Contents));
+  return std::string(Hash.begin(), Hash.end());
+}
+
+std::optional<bool> TestRunner::getCachedResult(StringRef Contents) const {
+  if (!CacheTestResults)
+    return std::nullopt;
+  std::string Key = getResultCacheKey(Contents);
+  std::lock_guard<std::mutex> Lock(ResultCacheMutex);
+  auto It = ResultCache.find(Key);
+  if (It == ResultCache.end())
+    return std::nullopt;
+  ++NumCacheHits;
+  return It->second;
+}
+
+void TestRunner::cacheResult(StringRef Contents, bool Interesting) const {
+  if (!CacheTestResults)
+    return;
+  std::string Key = getResultCacheKey(Contents);
+  std::lock_guard<std::mutex> Lock(ResultCacheMutex);
+  ResultCache[Key] = Interesting;
+}
+
 void TestRunner::writeOutput(StringRef Message) {
   std::error_code EC;
   raw_fd_ostream Out(OutputFilename, EC,
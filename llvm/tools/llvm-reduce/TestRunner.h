@@ -15,7 +15,11 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Target/TargetMachine.h"
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include <vector>
 
 namespace llvm {
@@ -34,6 +38,18 @@ public:
   /// @returns 0 if test was successful, 1 if otherwise
   int run(StringRef Filename) const;
 
+  /// Returns the result of an earlier run on a file with the same contents,
+  /// if there was one.
+  std::optional<bool> getCachedResult(StringRef Contents) const;
+
+  /// Remembers the result of running the test on \p Contents.
+  void cacheResult(StringRef Contents, bool Interesting) const;
+
+  /// Number of times the interesting-ness test was run, and number of
+  /// candidates that were answered from the cache instead.
+  unsigned getNumTestsRun() const { return NumTestsRun; }
+  unsigned getNumCacheHits() const { return NumCacheHits; }
+
   /// Returns the most reduced version of the original testcase
   ReducerWorkItem &getProgram() const { return *Program; }
 
@@ -61,6 +77,13 @@ private:
   StringRef OutputFilename;
   const bool InputIsBitcode;
   bool EmitBitcode;
+
+  // Test results keyed by the SHA1 of the tested file. Candidates are checked
+  // from several threads with -j.
+  mutable std::mutex ResultCacheMutex;
+  mutable StringMap<bool> ResultCache;
+  mutable std::atomic<unsigned> NumTestsRun = 0;
+  mutable std::atomic<unsigned> NumCacheHits = 0;
 };
 
 } // namespace llvm
@@ -0,0 +1,172 @@
+//===- RemarkSummary.cpp --------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Summarize the remarks of many remark files, e.g. all the files of a build,
+// by function and pass.
+//
+//===----------------------------------------------------------------------===//
+
+#include "RemarkUtilHelpers.h"
+#include "RemarkUtilRegistry.h"
+#include "llvm/ADT/Sequence.h"
+#include "llvm/Remarks/BitstreamRemarkContainer.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/Regex.h"
+#include <map>
+
+using namespace llvm;
+using namespace remarks;
+using namespace llvm::remarkutil;
+
+static cl::SubCommand
+    SummarizeSub("summarize",
+                 "Summarize the remarks of several files by function and "
+                 "pass, most frequent first.");
+
+static cl::list<std::string> InputFileNames(cl::Positional, cl::OneOrMore,
+                                            cl::desc("<input files>"),
+                                            cl::sub(SummarizeSub));
+static cl::opt<std::string> OutputFileName("o", cl::init("-"),
+                                           cl::desc("Output"),
+                                           cl::value_desc("filename"),
+                                           cl::sub(SummarizeSub));
+static cl::opt<Format> InputFormat(
+    "parser",
+    cl::desc("Input remark format to parse. By default, it is detected for "
+             "each file"),
+    cl::values(clEnumValN(Format::YAML, "yaml", "YAML"),
+               clEnumValN(Format::Bitstream, "bitstream", "Bitstream")),
+    cl::sub(SummarizeSub));
+static cl::opt<Type> RemarkTypeOpt(
+    "remark-type", cl::desc("Remark type to summarize."),
+    cl::values(clEnumValN(Type::Passed, "passed", "PASSED"),
+               clEnumValN(Type::Missed, "missed", "MISSED"),
+               clEnumValN(Type::Analysis, "analysis", "ANALYSIS")),
+    cl::init(Type::Missed), cl::sub(SummarizeSub));
+static cl::opt<std::string>
+    PassNameOptRE("rpass-name",
+                  cl::desc("Only summarize remarks of passes matching this "
+                           "regular expression."),
+                  cl::sub(SummarizeSub));
+static cl::opt<unsigned>
+    TopOpt("top", cl::desc("Only print the N most frequent rows (0 = all)."),
+           cl::value_desc("N"), cl::init(0), cl::sub(SummarizeSub));
+static cl::opt<unsigned>
+    NumThreads("j", cl::desc("Number of files to parse in parallel (0 = all "
+                             "available CPUs)."),
+               cl::init(0), cl::sub(SummarizeSub));
+
+namespace {
+struct SummaryEntry {
+  uint64_t Count = 0;
+  uint64_t Hotness = 0;
+};
+
+/// Remark counts keyed by (function, pass).
+using Summary = std::map<std::pair<std::string, std::string>, SummaryEntry>;
+} // namespace
+
+static Format detectFormat(StringRef Buffer) {
+  if (InputFormat != Format::Unknown)
+    return InputFormat;
+  return Buffer.starts_with(ContainerMagic) ? Format::Bitstream : Format::YAML;
+}
+
+static Error summarizeFile(StringRef InputFileName,
+                           const std::optional<Regex> &PassFilter,
+                           Summary &Result) {
+  auto MaybeBuf = getInputMemoryBuffer(InputFileName);
+  if (!MaybeBuf)
+    return MaybeBuf.takeError();
+  StringRef Buffer = (*MaybeBuf)->getBuffer();
+  auto MaybeParser = createRemarkParser(detectFormat(Buffer), Buffer);
+  if (!MaybeParser)
+    return createFileError(InputFileName, MaybeParser.takeError());
+  auto &Parser = **MaybeParser;
+
+  auto MaybeRemark = Parser.next();
+  for (; MaybeRemark; MaybeRemark = Parser.next()) {
+    const Remark &Remark = **MaybeRemark;
+    if (Remark.RemarkType != RemarkTypeOpt)
+      continue;
+    if (PassFilter && !PassFilter->match(Remark.PassName))
+      continue;
+    SummaryEntry &Entry =
+        Result[{Remark.FunctionName.str(), Remark.PassName.str()}];
+    ++Entry.Count;
+    Entry.Hotness += Remark.Hotness.value_or(0);
+  }
+
+  auto E = MaybeRemark.takeError();
+  if (!E.isA<EndOfFileError>())
+    return createFileError(InputFileName, std::move(E));
+  consumeError(std::move(E));
+  return Error::success();
+}
+
+/// Parses the input files in parallel and prints a CSV table with the number
+/// of remarks and their summed hotness per function and pass.
+static Error trySummarize() {
+  std::optional<Regex> PassFilter;
+  if (!PassNameOptRE.empty()) {
+    PassFilter.emplace(PassNameOptRE);
+    std::string RegexError;
+    if (!PassFilter->isValid(RegexError))
+      return createStringError(make_error_code(std::errc::invalid_argument),
+                               Twine("Regex: ", RegexError));
+  }
+
+  if (NumThreads)
+    parallel::strategy = hardware_concurrency(NumThreads);
+
+  // Each file is summarized on its own, then the results are merged in input
+  // order.
+  std::vector<Summary> FileSummaries(InputFileNames.size());
+  if (Error E = parallelForEachError(
+          seq<size_t>(0, InputFileNames.size()), [&](size_t I) {
+            return summarizeFile(InputFileNames[I], PassFilter,
+                                 FileSummaries[I]);
+          }))
+    return E;
+
+  Summary Total;
+  for (Summary &FileSummary : FileSummaries) {
+    for (auto &[Key, Entry] : FileSummary) {
+      SummaryEntry &TotalEntry = Total[Key];
+      TotalEntry.Count += Entry.Count;
+      TotalEntry.Hotness += Entry.Hotness;
+    }
+    FileSummary.clear();
+  }
+
+  std::vector<const Summary::value_type *> Rows;
+  Rows.reserve(Total.size());
+  for (const Summary::value_type &Row : Total)
+    Rows.push_back(&Row);
+  llvm::stable_sort(Rows, [](const Summary::value_type *A,
+                             const Summary::value_type *B) {
+    return A->second.Count > B->second.Count;
+  });
+  if (TopOpt && Rows.size() > TopOpt)
+    Rows.resize(TopOpt);
+
+  auto MaybeOF =
+      getOutputFileWithFlags(OutputFileName, sys::fs::OF_TextWithCRLF);
+  if (!MaybeOF)
+    return MaybeOF.takeError();
+  auto OF = std::move(*MaybeOF);
+  OF->os() << "Function,Pass,Count,Hotness\n";
+  for (const Summary::value_type *Row : Rows)
+    OF->os() << Row->first.first << ',' << Row->first.second << ','
+             << Row->second.Count << ',' << Row->second.Hotness << '\n';
+  OF->keep();
+  return Error::success();
+}
+
+static CommandRegistration SummarizeReg(&SummarizeSub, trySummarize);
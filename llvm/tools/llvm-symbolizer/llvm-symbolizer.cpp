@@ -360,6 +360,59 @@ static void symbolizeInput(const opt::InputArgList &Args,
   }
 }
 
+// Symbolizes all of stdin at once. The requests are handled grouped by module
+// and in increasing address order, so that each binary is loaded only once
+// even with a small cache and its line table and DIEs are visited in order,
+// but the results are still printed in input order.
+static void symbolizeBatch(
+    const opt::InputArgList &Args, object::BuildIDRef IncomingBuildID,
+    uint64_t AdjustVMA, bool IsAddr2Line, OutputStyle Style,
+    LLVMSymbolizer &Symbolizer,
+    function_ref<std::unique_ptr<DIPrinter>(raw_ostream &)> CreatePrinter) {
+  std::vector<std::string> Inputs;
+  std::string InputString;
+  while (std::getline(std::cin, InputString)) {
+    llvm::erase_if(InputString, [](char c) { return c == '\r' || c == '\n'; });
+    Inputs.push_back(std::move(InputString));
+  }
+
+  struct SortKey {
+    std::string Module;
+    uint64_t Offset;
+    size_t Index;
+  };
+  std::vector<SortKey> Order;
+  Order.reserve(Inputs.size());
+  for (size_t I = 0, E = Inputs.size(); I != E; ++I) {
+    Command Cmd;
+    std::string ModuleName;
+    object::BuildID BuildID(IncomingBuildID.begin(), IncomingBuildID.end());
+    uint64_t Offset = 0;
+    StringRef Symbol;
+    // Malformed requests are reported when they are symbolized.
+    if (Error E = parseCommand(Args.getLastArgValue(OPT_obj_EQ), IsAddr2Line,
+                               Inputs[I], Cmd, ModuleName, BuildID, Symbol,
+                               Offset))
+      consumeError(std::move(E));
+    Order.push_back(
+        {BuildID.empty() ? std::move(ModuleName) : toHex(BuildID), Offset, I});
+  }
+  llvm::sort(Order, [](const SortKey &A, const SortKey &B) {
+    return std::tie(A.Module, A.Offset, A.Index) <
+           std::tie(B.Module, B.Offset, B.Index);
+  });
+
+  std::vector<std::string> Results(Inputs.size());
+  for (const SortKey &Key : Order) {
+    raw_string_ostream OS(Results[Key.Index]);
+    std::unique_ptr<DIPrinter> Printer = CreatePrinter(OS);
+    symbolizeInput(Args, IncomingBuildID, AdjustVMA, IsAddr2Line, Style,
+                   Inputs[Key.Index], Symbolizer, *Printer);
+  }
+  for (const std::string &Result : Results)
+    outs() << Result;
+}
+
 static void printHelp(StringRef ToolName, const SymbolizerOptTable &Tbl,
                       raw_ostream &OS) {
   const char HelpText[] = " [options] addresses...";
@@ -545,13 +598,14 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
   }
   object::BuildID BuildID = parseBuildIDArg(Args, OPT_build_id_EQ);
 
-  std::unique_ptr<DIPrinter> Printer;
-  if (Style == OutputStyle::GNU)
-    Printer = std::make_unique<GNUPrinter>(outs(), printError, Config);
-  else if (Style == OutputStyle::JSON)
-    Printer = std::make_unique<JSONPrinter>(outs(), Config);
-  else
-    Printer = std::make_unique<LLVMPrinter>(outs(), printError, Config);
+  auto CreatePrinter = [&](raw_ostream &OS) -> std::unique_ptr<DIPrinter> {
+    if (Style == OutputStyle::GNU)
+      return std::make_unique<GNUPrinter>(OS, printError, Config);
+    if (Style == OutputStyle::JSON)
+      return std::make_unique<JSONPrinter>(OS, Config);
+    return std::make_unique<LLVMPrinter>(OS, printError, Config);
+  };
+  std::unique_ptr<DIPrinter> Printer = CreatePrinter(outs());
 
   // When an input file is specified, exit immediately if the file cannot be
   // read. If getOrCreateModuleInfo succeeds, symbolizeInput will reuse the
@@ -568,7 +622,10 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
   }
 
   std::vector<std::string> InputAddresses = Args.getAllArgValues(OPT_INPUT);
-  if (InputAddresses.empty()) {
+  if (InputAddresses.empty() && Args.hasArg(OPT_batch)) {
+    symbolizeBatch(Args, BuildID, AdjustVMA, IsAddr2Line, Style, Symbolizer,
+                   CreatePrinter);
+  } else if (InputAddresses.empty()) {
     const int kMaxInputStringLength = 1024;
     char InputString[kMaxInputStringLength];
 
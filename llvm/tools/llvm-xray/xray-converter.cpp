@@ -20,6 +20,10 @@
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/YAMLTraits.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/XRay/FDRRecordProducer.h"
+#include "llvm/XRay/FDRRecords.h"
+#include "llvm/XRay/FDRTraceExpander.h"
+#include "llvm/XRay/FileHeaderReader.h"
 #include "llvm/XRay/InstrumentationMap.h"
 #include "llvm/XRay/Trace.h"
 #include "llvm/XRay/YAMLXRayRecord.h"
@@ -81,6 +85,12 @@ static cl::opt<bool> ConvertSortInput(
     cl::sub(Convert), cl::init(true));
 static cl::alias ConvertSortInput2("s", cl::aliasopt(ConvertSortInput),
                                    cl::desc("Alias for -sort"));
+static cl::opt<bool> ConvertStream(
+    "stream",
+    cl::desc("convert an FDR mode log record by record instead of loading "
+             "the whole trace; only supported for -output-format=trace_event, "
+             "and implies -sort=false"),
+    cl::sub(Convert), cl::init(false));
 
 using llvm::yaml::Output;
 
@@ -269,74 +279,91 @@ void writeTraceViewerRecord(uint16_t Version, raw_ostream &OS, int32_t FuncId,
   }
 }
 
-} // namespace
-
-void TraceConverter::exportAsChromeTraceEventFormat(const Trace &Records,
-                                                    raw_ostream &OS) {
-  const auto &FH = Records.getFileHeader();
-  auto Version = FH.Version;
-  auto CycleFreq = FH.CycleFrequency;
+// Writes records in the Chrome trace event format as they come, keeping the
+// call stack of each thread and the dictionary of stack ids for the end.
+class ChromeTraceEventWriter {
+  raw_ostream &OS;
+  const FuncIdConversionHelper &FuncIdHelper;
+  bool Symbolize;
+  uint16_t Version;
+  uint64_t CycleFreq;
 
   unsigned id_counter = 0;
   int NumOutputRecords = 0;
-
-  OS << "{\n  \"traceEvents\": [\n";
   DenseMap<uint32_t, StackTrieNode *> StackCursorByThreadId{};
   DenseMap<uint32_t, SmallVector<StackTrieNode *, 4>> StackRootsByThreadId{};
   DenseMap<unsigned, StackTrieNode *> StacksByStackId{};
   std::forward_list<StackTrieNode> NodeStore{};
-  for (const auto &R : Records) {
-    // Chrome trace event format always wants data in micros.
-    // CyclesPerMicro = CycleHertz / 10^6
-    // TSC / CyclesPerMicro == TSC * 10^6 / CycleHertz == MicroTimestamp
-    // Could lose some precision here by converting the TSC to a double to
-    // multiply by the period in micros. 52 bit mantissa is a good start though.
-    // TODO: Make feature request to Chrome Trace viewer to accept ticks and a
-    // frequency or do some more involved calculation to avoid dangers of
-    // conversion.
-    double EventTimestampUs = double(1000000) / CycleFreq * double(R.TSC);
-    StackTrieNode *&StackCursor = StackCursorByThreadId[R.TId];
-    switch (R.Type) {
-    case RecordTypes::CUSTOM_EVENT:
-    case RecordTypes::TYPED_EVENT:
-      // TODO: Support typed and custom event rendering on Chrome Trace Viewer.
+
+public:
+  ChromeTraceEventWriter(raw_ostream &OS,
+                         const FuncIdConversionHelper &FuncIdHelper,
+                         bool Symbolize, const XRayFileHeader &FH)
+      : OS(OS), FuncIdHelper(FuncIdHelper), Symbolize(Symbolize),
+        Version(FH.Version), CycleFreq(FH.CycleFrequency) {
+    OS << "{\n  \"traceEvents\": [\n";
+  }
+
+  void add(const XRayRecord &R);
+  void finish();
+};
+
+} // namespace
+
+void ChromeTraceEventWriter::add(const XRayRecord &R) {
+  // Chrome trace event format always wants data in micros.
+  // CyclesPerMicro = CycleHertz / 10^6
+  // TSC / CyclesPerMicro == TSC * 10^6 / CycleHertz == MicroTimestamp
+  // Could lose some precision here by converting the TSC to a double to
+  // multiply by the period in micros. 52 bit mantissa is a good start though.
+  // TODO: Make feature request to Chrome Trace viewer to accept ticks and a
+  // frequency or do some more involved calculation to avoid dangers of
+  // conversion.
+  double EventTimestampUs = double(1000000) / CycleFreq * double(R.TSC);
+  StackTrieNode *&StackCursor = StackCursorByThreadId[R.TId];
+  switch (R.Type) {
+  case RecordTypes::CUSTOM_EVENT:
+  case RecordTypes::TYPED_EVENT:
+    // TODO: Support typed and custom event rendering on Chrome Trace Viewer.
+    break;
+  case RecordTypes::ENTER:
+  case RecordTypes::ENTER_ARG:
+    StackCursor = findOrCreateStackNode(StackCursor, R.FuncId, R.TId,
+                                        StackRootsByThreadId, StacksByStackId,
+                                        &id_counter, NodeStore);
+    // Each record is represented as a json dictionary with function name,
+    // type of B for begin or E for end, thread id, process id,
+    // timestamp in microseconds, and a stack frame id. The ids are logged
+    // in an id dictionary after the events.
+    if (NumOutputRecords++ > 0) {
+      OS << ",\n";
+    }
+    writeTraceViewerRecord(Version, OS, R.FuncId, R.TId, R.PId, Symbolize,
+                           FuncIdHelper, EventTimestampUs, *StackCursor, "B");
+    break;
+  case RecordTypes::EXIT:
+  case RecordTypes::TAIL_EXIT:
+    // No entries to record end for.
+    if (StackCursor == nullptr)
       break;
-    case RecordTypes::ENTER:
-    case RecordTypes::ENTER_ARG:
-      StackCursor = findOrCreateStackNode(StackCursor, R.FuncId, R.TId,
-                                          StackRootsByThreadId, StacksByStackId,
-                                          &id_counter, NodeStore);
-      // Each record is represented as a json dictionary with function name,
-      // type of B for begin or E for end, thread id, process id,
-      // timestamp in microseconds, and a stack frame id. The ids are logged
-      // in an id dictionary after the events.
+    // Should we emit an END record anyway or account this condition?
+    // (And/Or in loop termination below)
+    StackTrieNode *PreviousCursor = nullptr;
+    do {
       if (NumOutputRecords++ > 0) {
         OS << ",\n";
       }
-      writeTraceViewerRecord(Version, OS, R.FuncId, R.TId, R.PId, Symbolize,
-                             FuncIdHelper, EventTimestampUs, *StackCursor, "B");
-      break;
-    case RecordTypes::EXIT:
-    case RecordTypes::TAIL_EXIT:
-      // No entries to record end for.
-      if (StackCursor == nullptr)
-        break;
-      // Should we emit an END record anyway or account this condition?
-      // (And/Or in loop termination below)
-      StackTrieNode *PreviousCursor = nullptr;
-      do {
-        if (NumOutputRecords++ > 0) {
-          OS << ",\n";
-        }
-        writeTraceViewerRecord(Version, OS, StackCursor->FuncId, R.TId, R.PId,
-                               Symbolize, FuncIdHelper, EventTimestampUs,
-                               *StackCursor, "E");
-        PreviousCursor = StackCursor;
-        StackCursor = StackCursor->Parent;
-      } while (PreviousCursor->FuncId != R.FuncId && StackCursor != nullptr);
-      break;
-    }
+      writeTraceViewerRecord(Version, OS, StackCursor->FuncId, R.TId, R.PId,
+                             Symbolize, FuncIdHelper, EventTimestampUs,
+                             *StackCursor, "E");
+      PreviousCursor = StackCursor;
+      StackCursor = StackCursor->Parent;
+    } while (PreviousCursor->FuncId != R.FuncId && StackCursor != nullptr);
+    break;
   }
+}
+
+void ChromeTraceEventWriter::finish() {
   OS << "\n  ],\n"; // Close the Trace Events array.
   OS << "  "
      << "\"displayTimeUnit\": \"ns\",\n";
@@ -364,6 +391,65 @@ void TraceConverter::exportAsChromeTraceEventFormat(const Trace &Records,
   OS << "}\n";     // Close the JSON entry.
 }
 
+void TraceConverter::exportAsChromeTraceEventFormat(const Trace &Records,
+                                                    raw_ostream &OS) {
+  ChromeTraceEventWriter Writer(OS, FuncIdHelper, Symbolize,
+                                Records.getFileHeader());
+  for (const auto &R : Records)
+    Writer.add(R);
+  Writer.finish();
+}
+
+Error TraceConverter::streamFDRLogAsChromeTraceEventFormat(StringRef Filename,
+                                                           raw_ostream &OS) {
+  auto FDOrErr = sys::fs::openNativeFileForRead(Filename);
+  if (!FDOrErr)
+    return FDOrErr.takeError();
+
+  uint64_t FileSize;
+  if (auto EC = sys::fs::file_size(Filename, FileSize))
+    return createStringError(EC, "Failed to get file size for '%s'.",
+                             Filename.str().c_str());
+
+  // Pages of the mapping are only read in as the records are produced, and
+  // the only state we keep is the call stacks.
+  std::error_code EC;
+  sys::fs::mapped_file_region MappedFile(
+      *FDOrErr, sys::fs::mapped_file_region::mapmode::readonly, FileSize, 0,
+      EC);
+  sys::fs::closeFile(*FDOrErr);
+  if (EC)
+    return make_error<StringError>(
+        Twine("Cannot read log from '") + Filename + "'", EC);
+
+  DataExtractor DE(StringRef(MappedFile.data(), MappedFile.size()), true, 8);
+  uint64_t OffsetPtr = 0;
+  auto FileHeaderOrError = readBinaryFormatHeader(DE, OffsetPtr);
+  if (!FileHeaderOrError)
+    return FileHeaderOrError.takeError();
+  auto &H = FileHeaderOrError.get();
+  // Type 1 is the flight data recorder format.
+  if (H.Type != 1)
+    return createStringError(std::make_error_code(std::errc::invalid_argument),
+                             "Only FDR mode logs can be streamed.");
+
+  ChromeTraceEventWriter Writer(OS, FuncIdHelper, Symbolize, H);
+  TraceExpander Expander([&](const XRayRecord &R) { Writer.add(R); },
+                         H.Version);
+  FileBasedRecordProducer P(H, DE, OffsetPtr);
+  while (DE.isValidOffsetForDataOfSize(OffsetPtr, 1)) {
+    auto R = P.produce();
+    if (!R)
+      return R.takeError();
+    if (auto E = R.get()->apply(Expander))
+      return E;
+  }
+  if (auto E = Expander.flush())
+    return E;
+  Writer.finish();
+  return Error::success();
+}
+
 namespace llvm {
 namespace xray {
 
@@ -398,6 +484,20 @@ static CommandRegistration Unused(&Convert, []() -> Error {
     return make_error<StringError>(
         Twine("Cannot open file '") + ConvertOutput + "' for writing.", EC);
 
+  if (ConvertStream) {
+    if (ConvertOutputFormat != ConvertFormats::CHROME_TRACE_EVENT)
+      return make_error<StringError>(
+          "-stream is only supported for -output-format=trace_event",
+          std::make_error_code(std::errc::invalid_argument));
+    if (auto E = TC.streamFDRLogAsChromeTraceEventFormat(ConvertInput, OS))
+      return joinErrors(
+          make_error<StringError>(
+              Twine("Failed converting input file '") + ConvertInput + "'.",
+              std::make_error_code(std::errc::executable_format_error)),
+          std::move(E));
+    return Error::success();
+  }
+
   auto TraceOrErr = loadTraceFile(ConvertInput, ConvertSortInput);
   if (!TraceOrErr)
     return joinErrors(
@@ -35,6 +35,13 @@ public:
   /// to be in sorted TSC order. The trace event format encodes stack traces, so
   /// the linear history is essential for correct output.
   void exportAsChromeTraceEventFormat(const Trace &Records, raw_ostream &OS);
+
+  /// Converts the FDR mode log in \p Filename to the trace event format one
+  /// record at a time, without loading the whole trace. Records are emitted in
+  /// the order of the buffers in the log, which keeps the records of each
+  /// thread in order for logs written by a single process.
+  Error streamFDRLogAsChromeTraceEventFormat(StringRef Filename,
+                                             raw_ostream &OS);
 };
 
 } // namespace xray
@@ -310,4 +310,115 @@ TEST(ConcurrentHashTableTest, AddStringEntriesParallelWithResize) {
               std::string::npos);
 }
 
+TEST(ConcurrentHashTableTest, FindAndErase) {
+  PerThreadBumpPtrAllocator Allocator;
+  const size_t NumElements = 20000;
+  ConcurrentHashTableByPtr<std::string, String, PerThreadBumpPtrAllocator,
+                           ConcurrentHashTableInfoByPtr<
+                               std::string, String, PerThreadBumpPtrAllocator>>
+      HashTable(Allocator, 100);
+
+  parallel::TaskGroup tg;
+
+  tg.spawn([&]() {
+    EXPECT_TRUE(HashTable.empty());
+    EXPECT_EQ(HashTable.find("0"), nullptr);
+    EXPECT_EQ(HashTable.erase("0"), nullptr);
+
+    for (size_t I = 0; I < NumElements; I++)
+      HashTable.insert(formatv("{0}", I));
+    EXPECT_EQ(HashTable.size(), NumElements);
+
+    // Erase every other element.
+    for (size_t I = 0; I < NumElements; I += 2) {
+      std::string StringForElement = formatv("{0}", I);
+      String *Erased = HashTable.erase(StringForElement);
+      ASSERT_NE(Erased, nullptr);
+      EXPECT_TRUE(Erased->getKey() == StringForElement);
+      EXPECT_EQ(HashTable.erase(StringForElement), nullptr);
+    }
+    EXPECT_EQ(HashTable.size(), NumElements / 2);
+
+    // Check the remaining elements are still found after erasing their
+    // neighbours in the probe sequence.
+    for (size_t I = 0; I < NumElements; I++) {
+      std::string StringForElement = formatv("{0}", I);
+      String *Entry = HashTable.find(StringForElement);
+      if (I % 2) {
+        ASSERT_NE(Entry, nullptr);
+        EXPECT_TRUE(Entry->getKey() == StringForElement);
+      } else {
+        EXPECT_EQ(Entry, nullptr);
+      }
+    }
+
+    size_t NumVisited = 0;
+    HashTable.forEach([&](String &Entry) {
+      NumVisited++;
+      EXPECT_NE(HashTable.find(Entry.getKey()), nullptr);
+    });
+    EXPECT_EQ(NumVisited, NumElements / 2);
+
+    // Check erased elements can be inserted again.
+    for (size_t I = 0; I < NumElements; I += 2)
+      EXPECT_TRUE(HashTable.insert(formatv("{0}", I)).second);
+    EXPECT_EQ(HashTable.size(), NumElements);
+
+    HashTable.clear();
+    EXPECT_TRUE(HashTable.empty());
+    EXPECT_EQ(HashTable.find("1"), nullptr);
+  });
+}
+
+TEST(ConcurrentHashTableTest, EraseEntriesParallel) {
+  PerThreadBumpPtrAllocator Allocator;
+  const size_t NumElements = 20000;
+  ConcurrentHashTableByPtr<std::string, String, PerThreadBumpPtrAllocator,
+                           ConcurrentHashTableInfoByPtr<
+                               std::string, String, PerThreadBumpPtrAllocator>>
+      HashTable(Allocator, 100);
+
+  parallelFor(0, NumElements,
+              [&](size_t I) { HashTable.insert(formatv("{0}", I)); });
+
+  // Concurrently erase odd elements and look up even ones.
+  parallelFor(0, NumElements, [&](size_t I) {
+    std::string StringForElement = formatv("{0}", I);
+    if (I % 2)
+      EXPECT_NE(HashTable.erase(StringForElement), nullptr);
+    else
+      EXPECT_NE(HashTable.find(StringForElement), nullptr);
+  });
+
+  EXPECT_EQ(HashTable.size(), NumElements / 2);
+  for (size_t I = 0; I < NumElements; I++)
+    EXPECT_EQ(HashTable.find(formatv("{0}", I)) == nullptr, I % 2 == 1);
+}
+
+TEST(ConcurrentHashTableTest, ConcurrentStringMap) {
+  const size_t NumElements = 10000;
+  ConcurrentStringMap<std::atomic<unsigned>> Map(100);
+
+  // Count how often each key is seen.
+  parallelFor(0, NumElements * 4, [&](size_t I) {
+    std::string Key = formatv("key{0}", I % NumElements);
+    Map.insert(Key).first->getValue()++;
+  });
+
+  EXPECT_EQ(Map.size(), NumElements);
+  Map.forEach([](StringMapEntry<std::atomic<unsigned>> &Entry) {
+    EXPECT_EQ(Entry.getValue(), 4u);
+  });
+  EXPECT_TRUE(Map.contains("key0"));
+  EXPECT_FALSE(Map.contains("key10000"));
+
+  ConcurrentStringMap<unsigned> Lengths;
+  parallelFor(0, NumElements, [&](size_t I) {
+    std::string Key = formatv("key{0}", I);
+    Lengths.insert(Key).first->getValue() = Key.size();
+  });
+  EXPECT_EQ(Lengths.lookup("key9999"), 7u);
+  EXPECT_EQ(Lengths.lookup("key10000"), 0u);
+}
+
 } // namespace
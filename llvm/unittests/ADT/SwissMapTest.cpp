@@ -0,0 +1,196 @@
+//===- llvm/unittest/ADT/SwissMapTest.cpp - SwissMap unit tests -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/SwissMap.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+static_assert(
+    std::is_const_v<
+        std::remove_pointer_t<SwissMap<int, int>::const_iterator::pointer>>,
+    "Iterator pointer type should be const");
+
+TEST(SwissMapTest, EmptyMap) {
+  SwissMap<unsigned, unsigned> M;
+  EXPECT_TRUE(M.empty());
+  EXPECT_EQ(0u, M.size());
+  EXPECT_EQ(0u, M.getNumBuckets());
+  EXPECT_EQ(M.begin(), M.end());
+  EXPECT_EQ(M.end(), M.find(0));
+  EXPECT_FALSE(M.contains(0));
+  EXPECT_EQ(0u, M.lookup(0));
+  EXPECT_FALSE(M.erase(0));
+}
+
+TEST(SwissMapTest, InsertFindErase) {
+  SwissMap<unsigned, unsigned> M;
+  auto [It, Inserted] = M.insert({1, 10});
+  EXPECT_TRUE(Inserted);
+  EXPECT_EQ(1u, It->first);
+  EXPECT_EQ(10u, It->second);
+
+  std::tie(It, Inserted) = M.try_emplace(1, 20);
+  EXPECT_FALSE(Inserted);
+  EXPECT_EQ(10u, It->second);
+
+  M[2] = 20;
+  EXPECT_EQ(2u, M.size());
+  EXPECT_EQ(20u, M.at(2));
+  EXPECT_EQ(1u, M.count(1));
+  EXPECT_EQ(M.find(2)->second, 20u);
+
+  EXPECT_TRUE(M.erase(1));
+  EXPECT_FALSE(M.erase(1));
+  EXPECT_FALSE(M.contains(1));
+  EXPECT_EQ(1u, M.size());
+
+  M.erase(M.find(2));
+  EXPECT_TRUE(M.empty());
+}
+
+// Keys that are the empty and tombstone keys of DenseMapInfo are ordinary keys.
+TEST(SwissMapTest, ReservedDenseMapKeys) {
+  SwissMap<unsigned, int> M;
+  M[DenseMapInfo<unsigned>::getEmptyKey()] = 1;
+  M[DenseMapInfo<unsigned>::getTombstoneKey()] = 2;
+  EXPECT_EQ(2u, M.size());
+  EXPECT_EQ(1, M.lookup(DenseMapInfo<unsigned>::getEmptyKey()));
+  EXPECT_EQ(2, M.lookup(DenseMapInfo<unsigned>::getTombstoneKey()));
+}
+
+TEST(SwissMapTest, PointerAndStringRefKeys) {
+  int Values[100];
+  SwissMap<int *, int> Pointers;
+  for (int I = 0; I != 100; ++I)
+    Pointers[&Values[I]] = I;
+  for (int I = 0; I != 100; ++I)
+    EXPECT_EQ(I, Pointers.lookup(&Values[I]));
+  const int *ConstPtr = &Values[42];
+  EXPECT_TRUE(Pointers.contains(ConstPtr));
+
+  SwissMap<StringRef, unsigned> Strings;
+  std::vector<std::string> Storage;
+  for (unsigned I = 0; I != 100; ++I)
+    Storage.push_back("key" + std::to_string(I));
+  for (unsigned I = 0; I != 100; ++I)
+    Strings[Storage[I]] = I;
+  for (unsigned I = 0; I != 100; ++I)
+    EXPECT_EQ(I, Strings.lookup("key" + std::to_string(I)));
+  EXPECT_FALSE(Strings.contains("key100"));
+}
+
+TEST(SwissMapTest, CopyAndMove) {
+  SwissMap<int, std::string> M = {{1, "one"}, {2, "two"}};
+  SwissMap<int, std::string> Copy(M);
+  Copy[3] = "three";
+  EXPECT_EQ(2u, M.size());
+  EXPECT_EQ(3u, Copy.size());
+  EXPECT_EQ("two", Copy.lookup(2));
+
+  SwissMap<int, std::string> Moved(std::move(Copy));
+  EXPECT_EQ(3u, Moved.size());
+  EXPECT_EQ("three", Moved.lookup(3));
+
+  M = Moved;
+  EXPECT_EQ(3u, M.size());
+  Moved = SwissMap<int, std::string>();
+  EXPECT_TRUE(Moved.empty());
+
+  M.swap(Moved);
+  EXPECT_TRUE(M.empty());
+  EXPECT_EQ("one", Moved.lookup(1));
+}
+
+TEST(SwissMapTest, MoveOnlyValues) {
+  SwissMap<int, std::unique_ptr<int>> M;
+  for (int I = 0; I != 1000; ++I)
+    M.try_emplace(I, std::make_unique<int>(I));
+  for (int I = 0; I != 1000; ++I)
+    EXPECT_EQ(I, *M.find(I)->second);
+}
+
+TEST(SwissMapTest, EraseWhileIterating) {
+  SwissMap<int, int> M;
+  for (int I = 0; I != 100; ++I)
+    M[I] = I;
+  for (auto It = M.begin(), E = M.end(); It != E;) {
+    auto Cur = It++;
+    if (Cur->first % 2)
+      M.erase(Cur);
+  }
+  EXPECT_EQ(50u, M.size());
+  for (const auto &KV : M)
+    EXPECT_EQ(0, KV.first % 2);
+}
+
+TEST(SwissMapTest, Reserve) {
+  SwissMap<int, int> M;
+  M.reserve(1000);
+  unsigned Buckets = M.getNumBuckets();
+  EXPECT_GE(Buckets, 1000u);
+  for (int I = 0; I != 1000; ++I)
+    M[I] = I;
+  EXPECT_EQ(Buckets, M.getNumBuckets());
+
+  M.clear();
+  EXPECT_TRUE(M.empty());
+  EXPECT_EQ(Buckets, M.getNumBuckets());
+  EXPECT_FALSE(M.contains(1));
+}
+
+// Inserting and erasing with a bounded number of live keys must not keep
+// growing the table, however many tombstones are left behind.
+TEST(SwissMapTest, EraseHeavyDoesNotGrow) {
+  SwissMap<unsigned, unsigned> M;
+  for (unsigned I = 0; I != 100000; ++I) {
+    M[I] = I;
+    if (I >= 64)
+      EXPECT_TRUE(M.erase(I - 64));
+  }
+  EXPECT_EQ(64u, M.size());
+  EXPECT_LE(M.getNumBuckets(), 256u);
+}
+
+// Compare against DenseMap on a random mix of operations.
+TEST(SwissMapTest, MatchesDenseMap) {
+  SwissMap<unsigned, unsigned> M;
+  DenseMap<unsigned, unsigned> D;
+  std::mt19937 Rand(0);
+  for (unsigned I = 0; I != 200000; ++I) {
+    unsigned Key = Rand() % 3000;
+    switch (Rand() % 3) {
+    case 0:
+      M[Key] = I;
+      D[Key] = I;
+      break;
+    case 1:
+      ASSERT_EQ(D.erase(Key), M.erase(Key));
+      break;
+    case 2:
+      ASSERT_EQ(D.lookup(Key), M.lookup(Key));
+      break;
+    }
+    ASSERT_EQ(D.size(), M.size());
+  }
+  unsigned Count = 0;
+  for (const auto &KV : M) {
+    EXPECT_EQ(D.lookup(KV.first), KV.second);
+    ++Count;
+  }
+  EXPECT_EQ(D.size(), Count);
+}
+
+} // namespace
@@ -298,6 +298,46 @@ TEST_F(AliasAnalysisTest, BatchAAPhiAssumption) {
 
 // Check that two aliased GEPs with non-constant offsets are correctly
 // analyzed and their relative offset can be requested from AA.
+TEST_F(AliasAnalysisTest, BatchAAAliasByObjects) {
+  LLVMContext C;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(R"(
+    @g = global i32 0
+    define void @f(ptr %p, i64 %i) {
+      %a = alloca [4 x i32]
+      %b = alloca [4 x i32]
+      %a1 = getelementptr i32, ptr %a, i64 %i
+      %b1 = getelementptr i32, ptr %b, i64 %i
+      %p1 = getelementptr i32, ptr %p, i64 %i
+      ret void
+    }
+  )", Err, C);
+
+  Function *F = M->getFunction("f");
+  auto Loc = [&](StringRef Name) {
+    return MemoryLocation(getInstructionByName(*F, Name),
+                          LocationSize::precise(4));
+  };
+  MemoryLocation GLoc(M->getNamedValue("g"), LocationSize::precise(4));
+  SmallVector<MemoryLocation> Locs = {Loc("a"), Loc("b1"), Loc("p1"), GLoc,
+                                      Loc("a1")};
+
+  auto &AA = getAAResults(*F);
+  BatchAAResults BatchAA(AA);
+  BitVector NoAlias;
+  BatchAA.aliasByObjects(Loc("a1"), Locs, NoAlias);
+  ASSERT_EQ(5u, NoAlias.size());
+  EXPECT_FALSE(NoAlias.test(0));
+  EXPECT_TRUE(NoAlias.test(1));
+  // %p is not an identified object, so this is left to the full query.
+  EXPECT_FALSE(NoAlias.test(2));
+  EXPECT_TRUE(NoAlias.test(3));
+  EXPECT_FALSE(NoAlias.test(4));
+
+  BatchAA.aliasByObjects(Loc("p1"), Locs, NoAlias);
+  EXPECT_TRUE(NoAlias.none());
+}
+
 TEST_F(AliasAnalysisTest, PartialAliasOffset) {
   LLVMContext C;
   SMDiagnostic Err;
@@ -17,6 +17,7 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -433,4 +434,44 @@ TEST(BitReaderTest, AccessMetadataTypeInfo) {
             "!{0, i32}}}}");
 }
 
+
+// Tests that encoding function blocks concurrently produces the same bitcode.
+TEST(BitReaderTest, WriteFunctionsInParallel) {
+  LLVMContext Context;
+  std::unique_ptr<Module> M = parseAssembly(Context,
+                                            "@table = global [2 x ptr] "
+                                            "[ptr blockaddress(@f, %a), "
+                                            "ptr blockaddress(@g, %b)]\n"
+                                            "define i32 @f(i32 %x) {\n"
+                                            "  br label %a\n"
+                                            "a:\n"
+                                            "  %y = add i32 %x, 1, !range !0\n"
+                                            "  %z = mul i32 %y, %y\n"
+                                            "  ret i32 %z\n"
+                                            "}\n"
+                                            "declare void @h(i32)\n"
+                                            "define void @g(i32 %x) {\n"
+                                            "  br label %b\n"
+                                            "b:\n"
+                                            "  %y = add i32 %x, %x\n"
+                                            "  call void @h(i32 %y)\n"
+                                            "  call void @h(i32 %y)\n"
+                                            "  call void @h(i32 %x)\n"
+                                            "  ret void\n"
+                                            "}\n"
+                                            "!0 = !{i32 0, i32 10}\n");
+
+  auto &Opt = static_cast<cl::opt<bool> &>(
+      *cl::getRegisteredOptions()["bitcode-write-functions-in-parallel"]);
+  for (bool PreserveUseListOrder : {false, true}) {
+    SmallString<1024> Serial, Parallel;
+    raw_svector_ostream SerialOS(Serial), ParallelOS(Parallel);
+    WriteBitcodeToFile(*M, SerialOS, PreserveUseListOrder);
+    Opt = true;
+    WriteBitcodeToFile(*M, ParallelOS, PreserveUseListOrder);
+    Opt = false;
+    EXPECT_EQ(Serial, Parallel);
+  }
+}
+
 } // end namespace
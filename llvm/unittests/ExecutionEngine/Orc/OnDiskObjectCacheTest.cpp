@@ -0,0 +1,54 @@
+//===- OnDiskObjectCacheTest.cpp - Unit tests for the on-disk object cache ===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/OnDiskObjectCache.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+using llvm::unittest::TempDir;
+
+namespace {
+
+TEST(OnDiskObjectCacheTest, ReusesObjectsAcrossCaches) {
+  TempDir Dir("orc-object-cache", /*Unique=*/true);
+  JITTargetMachineBuilder JTMB((Triple("x86_64-unknown-linux-gnu")));
+  LLVMContext Ctx;
+  Module M("M", Ctx);
+  StringRef Object = "not really an object file";
+
+  {
+    auto Cache = OnDiskObjectCache::Create(Dir.path(), JTMB);
+    ASSERT_THAT_EXPECTED(Cache, Succeeded());
+    EXPECT_EQ((*Cache)->getObject(&M), nullptr);
+    (*Cache)->notifyObjectCompiled(&M, MemoryBufferRef(Object, "M"));
+  }
+
+  // A cache created later for the same directory and target finds the object.
+  auto Cache = OnDiskObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+  std::unique_ptr<MemoryBuffer> Buffer = (*Cache)->getObject(&M);
+  ASSERT_NE(Buffer, nullptr);
+  EXPECT_EQ(Buffer->getBuffer(), Object);
+
+  // Different modules and targets get different entries.
+  Module Other("Other", Ctx);
+  EXPECT_EQ((*Cache)->getObject(&Other), nullptr);
+  JITTargetMachineBuilder OtherJTMB = JTMB;
+  OtherJTMB.setCPU("skylake");
+  auto OtherCache = OnDiskObjectCache::Create(Dir.path(), OtherJTMB);
+  ASSERT_THAT_EXPECTED(OtherCache, Succeeded());
+  EXPECT_EQ((*OtherCache)->getObject(&M), nullptr);
+}
+
+} // namespace
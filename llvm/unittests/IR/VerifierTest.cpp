@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/IR/Verifier.h"
+#include "llvm/AsmParser/Parser.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DIBuilder.h"
 #include "llvm/IR/DerivedTypes.h"
@@ -17,9 +18,13 @@
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/SourceMgr.h"
 #include "gtest/gtest.h"
 
 namespace llvm {
+extern cl::opt<bool> VerifyInParallel;
+
 namespace {
 
 TEST(VerifierTest, Branch_i1) {
@@ -395,5 +400,52 @@ TEST(VerifierTest, AtomicRMW) {
       << ErrorOS.str();
 }
 
+TEST(VerifierTest, ParallelMatchesSerial) {
+  // Enough functions for several chunks, with a few broken ones among them.
+  std::string Src = "%pair = type { i32, i64 }\n"
+                    "declare { i32, i1 } @llvm.uadd.with.overflow.i32(i32, "
+                    "i32)\n";
+  for (unsigned I = 0; I < 50; ++I) {
+    std::string N = std::to_string(I);
+    Src += "define i32 @f" + N + "(i32 %a, ptr %p) {\n";
+    if (I % 17 == 3)
+      Src += "  %x = add i32 %y, 1\n"
+             "  %y = add i32 %a, " + N + "\n";
+    else
+      Src += "  %x = add i32 %a, " + N + "\n";
+    Src += "  %s = load %pair, ptr %p\n"
+           "  %o = call { i32, i1 } @llvm.uadd.with.overflow.i32(i32 %x, "
+           "i32 %a)\n"
+           "  ret i32 %x\n"
+           "}\n";
+  }
+
+  LLVMContext C;
+  SMDiagnostic Err;
+  std::unique_ptr<Module> M = parseAssemblyString(Src, Err, C);
+  ASSERT_TRUE(M);
+
+  std::string Serial;
+  raw_string_ostream SerialOS(Serial);
+  EXPECT_TRUE(verifyModule(*M, &SerialOS));
+
+  VerifyInParallel = true;
+  std::string Parallel;
+  raw_string_ostream ParallelOS(Parallel);
+  bool Broken = verifyModule(*M, &ParallelOS);
+  VerifyInParallel = false;
+  EXPECT_TRUE(Broken);
+  EXPECT_EQ(Serial, Parallel);
+  EXPECT_NE(Serial.find("%y"), std::string::npos);
+
+  // Nothing is reported for a valid module.
+  M->getFunction("f3")->eraseFromParent();
+  M->getFunction("f20")->eraseFromParent();
+  M->getFunction("f37")->eraseFromParent();
+  VerifyInParallel = true;
+  EXPECT_FALSE(verifyModule(*M, &errs()));
+  VerifyInParallel = false;
+}
+
 } // end anonymous namespace
 } // end namespace llvm
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Allocator.h"
+#include "llvm/ADT/STLExtras.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
 
@@ -258,4 +259,26 @@ TEST(AllocatorTest, TestBigAlignment) {
   EXPECT_GT(MockSlabAllocator::GetLastSlabSize(), 4096u);
 }
 
+// Check that slabs are reused after a reset.
+TEST(AllocatorTest, TestRecyclingSlabs) {
+  BumpPtrAllocatorImpl<RecyclingSlabAllocator<>> Alloc;
+  SmallVector<void *, 0> First;
+  for (int I = 0; I < 100; ++I)
+    First.push_back(Alloc.Allocate(1000, 1));
+  size_t NumSlabs = Alloc.GetNumSlabs();
+  EXPECT_GT(NumSlabs, 1u);
+
+  Alloc.Reset();
+  EXPECT_EQ(1u, Alloc.GetNumSlabs());
+  // Allocating the same amount again must reuse the same slabs, possibly in
+  // a different order.
+  SmallVector<void *, 0> Second;
+  for (int I = 0; I < 100; ++I)
+    Second.push_back(Alloc.Allocate(1000, 1));
+  EXPECT_EQ(NumSlabs, Alloc.GetNumSlabs());
+  llvm::sort(First);
+  llvm::sort(Second);
+  EXPECT_EQ(First, Second);
+}
+
 }  // anonymous namespace
@@ -0,0 +1,80 @@
+//===- AsyncFileLoaderTest.cpp - AsyncFileLoader tests --------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/AsyncFileLoader.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+IntrusiveRefCntPtr<vfs::InMemoryFileSystem> makeFS(unsigned NumFiles) {
+  auto FS = makeIntrusiveRefCnt<vfs::InMemoryFileSystem>();
+  for (unsigned I = 0; I < NumFiles; ++I)
+    FS->addFile("/f" + Twine(I), 0,
+                MemoryBuffer::getMemBufferCopy("contents " + Twine(I).str()));
+  return FS;
+}
+
+TEST(AsyncFileLoaderTest, LoadBatch) {
+  AsyncFileLoader Loader(makeFS(32), hardware_concurrency(4));
+  std::vector<std::string> Paths;
+  for (unsigned I = 0; I < 32; ++I)
+    Paths.push_back("/f" + std::to_string(I));
+  Paths.push_back("/missing");
+
+  auto Futures = Loader.loadBatch(Paths);
+  ASSERT_EQ(Futures.size(), Paths.size());
+  for (unsigned I = 0; I < 32; ++I) {
+    AsyncFileLoader::BufferOrError Buffer = Futures[I].get();
+    ASSERT_TRUE(bool(Buffer));
+    EXPECT_EQ((*Buffer)->getBuffer(), "contents " + std::to_string(I));
+  }
+  EXPECT_FALSE(bool(Futures.back().get()));
+}
+
+TEST(AsyncFileLoaderTest, Load) {
+  AsyncFileLoader Loader(makeFS(1));
+  AsyncFileLoader::BufferOrError Buffer = Loader.load("/f0").get();
+  ASSERT_TRUE(bool(Buffer));
+  EXPECT_EQ((*Buffer)->getBuffer(), "contents 0");
+}
+
+TEST(AsyncFileLoaderTest, PrefetchingFileSystem) {
+  IntrusiveRefCntPtr<vfs::InMemoryFileSystem> Base = makeFS(4);
+  auto FS = makeIntrusiveRefCnt<PrefetchingFileSystem>(Base,
+                                                       hardware_concurrency(2));
+  FS->prefetch({"/f0", "/f1", "/f0", "/missing"});
+
+  // Prefetched files return the loaded buffer first and then read again.
+  auto F = FS->openFileForRead("/f0");
+  ASSERT_TRUE(bool(F));
+  auto Status = (*F)->status();
+  ASSERT_TRUE(bool(Status));
+  EXPECT_EQ(Status->getSize(), 10u);
+  for (unsigned I = 0; I < 2; ++I) {
+    auto Buffer = (*F)->getBuffer("/f0");
+    ASSERT_TRUE(bool(Buffer));
+    EXPECT_EQ((*Buffer)->getBuffer(), "contents 0");
+  }
+
+  // A file is only served from the prefetched contents once.
+  auto Again = FS->getBufferForFile("/f0");
+  ASSERT_TRUE(bool(Again));
+  EXPECT_EQ((*Again)->getBuffer(), "contents 0");
+
+  // Files that failed to load or were not prefetched come from the
+  // underlying file system.
+  EXPECT_FALSE(bool(FS->openFileForRead("/missing")));
+  auto Other = FS->getBufferForFile("/f3");
+  ASSERT_TRUE(bool(Other));
+  EXPECT_EQ((*Other)->getBuffer(), "contents 3");
+  EXPECT_TRUE(isa<PrefetchingFileSystem>(*FS));
+}
+
+} // namespace
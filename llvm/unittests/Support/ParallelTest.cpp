@@ -107,7 +107,7 @@ TEST(Parallel, TaskGroupSequentialFor) {
 TEST(Parallel, NestedTaskGroup) {
   // This test checks:
   // 1. Root TaskGroup is in Parallel mode.
-  // 2. Nested TaskGroup is not in Parallel mode.
+  // 2. Nested TaskGroup is in Parallel mode.
   parallel::TaskGroup tg;
 
   tg.spawn([&]() {
@@ -116,15 +116,17 @@ TEST(Parallel, NestedTaskGroup) {
 
   tg.spawn([&]() {
     parallel::TaskGroup nestedTG;
-    EXPECT_FALSE(nestedTG.isParallel());
+    EXPECT_TRUE(nestedTG.isParallel() ||
+                (parallel::strategy.ThreadsRequested == 1));
 
     nestedTG.spawn([&]() {
       // Check that root TaskGroup is in Parallel mode.
       EXPECT_TRUE(tg.isParallel() ||
                   (parallel::strategy.ThreadsRequested == 1));
 
-      // Check that nested TaskGroup is not in Parallel mode.
-      EXPECT_FALSE(nestedTG.isParallel());
+      // Check that nested TaskGroup is in Parallel mode.
+      EXPECT_TRUE(nestedTG.isParallel() ||
+                  (parallel::strategy.ThreadsRequested == 1));
     });
   });
 }
@@ -143,9 +145,10 @@ TEST(Parallel, ParallelNestedTaskGroup) {
         EXPECT_TRUE(tg.isParallel() ||
                     (parallel::strategy.ThreadsRequested == 1));
 
-        // Check that nested TaskGroup is not in Parallel mode.
+        // Check that nested TaskGroup is in Parallel mode.
         parallel::TaskGroup nestedTG;
-        EXPECT_FALSE(nestedTG.isParallel());
+        EXPECT_TRUE(nestedTG.isParallel() ||
+                    (parallel::strategy.ThreadsRequested == 1));
         ++Count;
 
         nestedTG.spawn([&]() {
@@ -153,8 +156,9 @@ TEST(Parallel, ParallelNestedTaskGroup) {
           EXPECT_TRUE(tg.isParallel() ||
                       (parallel::strategy.ThreadsRequested == 1));
 
-          // Check that nested TaskGroup is not in Parallel mode.
-          EXPECT_FALSE(nestedTG.isParallel());
+          // Check that nested TaskGroup is in Parallel mode.
+          EXPECT_TRUE(nestedTG.isParallel() ||
+                      (parallel::strategy.ThreadsRequested == 1));
           ++Count;
         });
       });
@@ -173,6 +177,44 @@ TEST(Parallel, ParallelNestedTaskGroup) {
   }
   EXPECT_EQ(Count, 12ul);
 }
+TEST(Parallel, NestedParallelFor) {
+  // Every outer task blocks on an inner parallelFor; the workers must run the
+  // inner tasks instead of all waiting for each other.
+  std::atomic<size_t> Count{0};
+  parallelFor(0, 64, [&](size_t) {
+    parallelFor(0, 64, [&](size_t) {
+      parallelFor(0, 16, [&](size_t) { ++Count; });
+    });
+  });
+  EXPECT_EQ(Count, 64ul * 64 * 16);
+}
+
+TEST(Parallel, NestedTaskGroupSequential) {
+  std::atomic<size_t> Count{0};
+  parallelFor(0, 16, [&](size_t) {
+    size_t LocalCount = 0;
+    {
+      parallel::TaskGroup tg;
+      for (size_t Idx = 0; Idx < 100; Idx++)
+        tg.spawn([&LocalCount, Idx]() { EXPECT_EQ(LocalCount++, Idx); }, true);
+    }
+    EXPECT_EQ(LocalCount, 100ul);
+    Count += LocalCount;
+  });
+  EXPECT_EQ(Count, 1600ul);
+}
+
+TEST(Parallel, TaskGroupCancel) {
+  std::atomic<size_t> Count{0};
+  {
+    parallel::TaskGroup tg;
+    tg.cancel();
+    for (size_t Idx = 0; Idx < 100; Idx++)
+      tg.spawn([&]() { ++Count; });
+    EXPECT_TRUE(tg.isCancelled());
+  }
+  EXPECT_EQ(Count, 0ul);
+}
 #endif
 
 #endif
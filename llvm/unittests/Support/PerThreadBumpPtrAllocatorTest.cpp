@@ -10,6 +10,7 @@
 #include "llvm/Support/Parallel.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
+#include <cstring>
 
 using namespace llvm;
 using namespace parallel;
@@ -53,4 +54,36 @@ TEST(PerThreadBumpPtrAllocatorTest, ParallelAllocation) {
   EXPECT_EQ(Allocator.getNumberOfAllocators(), parallel::getThreadCount());
 }
 
+TEST(PerThreadBumpPtrAllocatorTest, RecycleSlabs) {
+  PerThreadRecyclingBumpPtrAllocator Allocator;
+
+  static size_t constexpr NumAllocations = 10000;
+
+  for (unsigned Phase = 0; Phase < 3; ++Phase) {
+    parallelFor(0, NumAllocations, [&](size_t Idx) {
+      uint64_t *Ptr =
+          (uint64_t *)Allocator.Allocate(sizeof(uint64_t) * 16,
+                                         alignof(uint64_t));
+      *Ptr = Idx;
+    });
+    EXPECT_EQ(sizeof(uint64_t) * 16 * NumAllocations,
+              Allocator.getBytesAllocated());
+    EXPECT_EQ(Allocator.getTotalMemory() - Allocator.getBytesAllocated(),
+              Allocator.getBytesWasted());
+    Allocator.Reset();
+    EXPECT_EQ(0u, Allocator.getBytesAllocated());
+  }
+}
+
+TEST(PerThreadBumpPtrAllocatorTest, HugePages) {
+  PerThreadHugePageBumpPtrAllocator Allocator;
+
+  parallelFor(0, 1000, [&](size_t Idx) {
+    char *Ptr = (char *)Allocator.Allocate(4096, 64);
+    memset(Ptr, Idx, 4096);
+  });
+  EXPECT_EQ(4096u * 1000, Allocator.getBytesAllocated());
+  EXPECT_GE(Allocator.getTotalMemory(), 2u * 1024 * 1024);
+}
+
 } // anonymous namespace
@@ -140,4 +140,19 @@ TEST(SuffixTreeTest, TestExclusion) {
   }
 }
 
+// Tests that the occurrences of a repeated substring are reported from left to
+// right, independently of the order in which the tree stores its children.
+TEST(SuffixTreeTest, TestStartIndicesSorted) {
+  std::vector<unsigned> Data = {7, 8, 1, 9, 8, 1, 5, 8, 1, 6, 8, 1, 2};
+  SuffixTree ST(Data);
+  std::vector<SuffixTree::RepeatedSubstring> SubStrings;
+  for (auto It = ST.begin(); It != ST.end(); It++)
+    SubStrings.push_back(*It);
+  ASSERT_EQ(SubStrings.size(), 1u);
+  EXPECT_EQ(SubStrings[0].Length, 2u);
+  std::vector<unsigned> StartIndices(SubStrings[0].StartIndices.begin(),
+                                     SubStrings[0].StartIndices.end());
+  EXPECT_EQ(StartIndices, std::vector<unsigned>({1u, 4u, 7u, 10u}));
+}
+
 } // namespace
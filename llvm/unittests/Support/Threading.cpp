@@ -15,6 +15,10 @@
 #include <atomic>
 #include <condition_variable>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 using namespace llvm;
 
 namespace {
@@ -111,6 +115,30 @@ TEST(Threading, RunOnThreadSync) {
   ASSERT_EQ(Executed, true);
 }
 
+#if defined(__linux__)
+TEST(Threading, PinThreads) {
+  cpu_set_t Original;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(Original), &Original), 0);
+  ThreadPoolStrategy S = hardware_concurrency();
+  S.PinThreads = true;
+  unsigned NumThreads = S.compute_thread_count();
+  for (unsigned I = 0; I < NumThreads; ++I) {
+    llvm::thread Thread([&] {
+      S.apply_thread_strategy(I);
+      cpu_set_t Pinned;
+      ASSERT_EQ(sched_getaffinity(0, sizeof(Pinned), &Pinned), 0);
+      // Each thread must be able to run on some of the original CPUs, and
+      // only on those.
+      cpu_set_t Both;
+      CPU_AND(&Both, &Pinned, &Original);
+      EXPECT_GT(CPU_COUNT(&Pinned), 0);
+      EXPECT_TRUE(CPU_EQUAL(&Both, &Pinned));
+    });
+    Thread.join();
+  }
+}
+#endif
+
 #if defined(__APPLE__)
 TEST(Threading, AppleStackSize) {
   llvm::thread Thread([] {
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 // These are bare-minimum 'smoke' tests of the time profiler. Not tested:
 //  - multi-threading
+//  - the time values of folded stacks
 //  - 'Total' entries
 //  - elision of short or ill-formed entries
 //  - detail callback
@@ -65,6 +66,67 @@ TEST(TimeProfiler, Async_Begin_End_Smoke) {
   ASSERT_TRUE(json.find(R"("detail":"detail")") != std::string::npos);
 }
 
+std::string writeFoldedStacks() {
+  std::string Folded;
+  raw_string_ostream OS(Folded);
+  timeTraceProfilerWriteFoldedStacks(OS);
+  return Folded;
+}
+
+TEST(TimeProfiler, Sampling_Folded) {
+  timeTraceProfilerInitializeSampling(/*TimeTraceGranularity=*/0,
+                                      /*RingBufferSize=*/16, "test");
+  for (int I = 0; I < 3; ++I) {
+    TimeTraceScope Outer("outer", [] {
+      ADD_FAILURE() << "detail must not be computed";
+      return std::string();
+    });
+    { TimeTraceScope Inner("inner"); }
+    auto *Async = timeTraceAsyncProfilerBegin("async", "");
+    timeTraceProfilerEnd(Async);
+  }
+  timeTraceProfilerBegin("tail", "");
+  timeTraceProfilerEnd();
+
+  std::string Folded = writeFoldedStacks();
+  EXPECT_EQ(Folded.find("async"), std::string::npos);
+  size_t Outer = Folded.find("outer ");
+  size_t Inner = Folded.find("outer;inner ");
+  size_t Tail = Folded.find("tail ");
+  ASSERT_NE(Outer, std::string::npos);
+  ASSERT_NE(Inner, std::string::npos);
+  ASSERT_NE(Tail, std::string::npos);
+  EXPECT_LT(Outer, Inner);
+  EXPECT_LT(Inner, Tail);
+
+  std::string json = teardownProfiler();
+  ASSERT_TRUE(json.find(R"("name":"inner")") != std::string::npos);
+}
+
+TEST(TimeProfiler, Sampling_RingBuffer) {
+  timeTraceProfilerInitializeSampling(/*TimeTraceGranularity=*/0,
+                                      /*RingBufferSize=*/2, "test");
+  { TimeTraceScope Scope("first"); }
+  { TimeTraceScope Scope("second"); }
+  { TimeTraceScope Scope("third"); }
+
+  // Aggregates cover all sections, the trace only the most recent ones.
+  std::string Folded = writeFoldedStacks();
+  EXPECT_NE(Folded.find("first "), std::string::npos);
+  std::string json = teardownProfiler();
+  EXPECT_EQ(json.find(R"("name":"first")"), std::string::npos);
+  EXPECT_NE(json.find(R"("name":"second")"), std::string::npos);
+  EXPECT_NE(json.find(R"("name":"third")"), std::string::npos);
+}
+
+TEST(TimeProfiler, Sampling_Threshold) {
+  timeTraceProfilerInitializeSampling(/*TimeTraceGranularity=*/1000000,
+                                      /*RingBufferSize=*/4, "test");
+  { TimeTraceScope Scope("short"); }
+  EXPECT_EQ(writeFoldedStacks(), "");
+  teardownProfiler();
+}
+
 TEST(TimeProfiler, Begin_End_Disabled) {
   // Nothing should be observable here. The test is really just making sure
   // we've not got a stray nullptr deref.
@@ -0,0 +1,92 @@
+//===- SplitModuleTest.cpp - Unit tests for SplitModule -------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/Utils/SplitModule.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+static std::unique_ptr<Module> parseIR(LLVMContext &C, const char *IR) {
+  SMDiagnostic Err;
+  std::unique_ptr<Module> Mod = parseAssemblyString(IR, Err, C);
+  if (!Mod)
+    Err.print("SplitModuleTest", errs());
+  return Mod;
+}
+
+static unsigned countDefinitions(const Module &M) {
+  unsigned N = 0;
+  for (const Function &F : M)
+    N += !F.isDeclaration();
+  return N;
+}
+
+// Every internal function forms a cluster with its caller. The clusters are
+// balanced by their instruction count, so the single large one gets a
+// partition of its own.
+TEST(SplitModule, BalanceByInstructionCount) {
+  LLVMContext C;
+  std::unique_ptr<Module> M = parseIR(C, R"(
+    define internal i32 @bigimpl(i32 %x) {
+      %a = add i32 %x, 1
+      %b = mul i32 %a, %x
+      %c = add i32 %b, 2
+      %d = mul i32 %c, %a
+      %e = add i32 %d, 3
+      %f = mul i32 %e, %b
+      %g = add i32 %f, 4
+      %h = mul i32 %g, %c
+      ret i32 %h
+    }
+    define i32 @big(i32 %x) {
+      %r = call i32 @bigimpl(i32 %x)
+      ret i32 %r
+    }
+    define internal i32 @t1(i32 %x) {
+      ret i32 %x
+    }
+    define i32 @s1(i32 %x) {
+      %r = call i32 @t1(i32 %x)
+      ret i32 %r
+    }
+    define internal i32 @t2(i32 %x) {
+      ret i32 %x
+    }
+    define i32 @s2(i32 %x) {
+      %r = call i32 @t2(i32 %x)
+      ret i32 %r
+    }
+    define internal i32 @t3(i32 %x) {
+      ret i32 %x
+    }
+    define i32 @s3(i32 %x) {
+      %r = call i32 @t3(i32 %x)
+      ret i32 %r
+    }
+  )");
+  ASSERT_TRUE(M);
+
+  SmallVector<std::unique_ptr<Module>, 2> Parts;
+  SplitModule(
+      *M, 2,
+      [&](std::unique_ptr<Module> MPart) { Parts.push_back(std::move(MPart)); },
+      /*PreserveLocals=*/true);
+  ASSERT_EQ(Parts.size(), 2u);
+
+  for (const std::unique_ptr<Module> &Part : Parts) {
+    const Function *Impl = Part->getFunction("bigimpl");
+    if (Impl && !Impl->isDeclaration())
+      EXPECT_EQ(countDefinitions(*Part), 2u);
+    else
+      EXPECT_EQ(countDefinitions(*Part), 6u);
+  }
+}
@@ -69,11 +69,25 @@ std::unique_ptr<Pass> createSparseAssembler(bool directOut);
 // The SparseReinterpretMap pass.
 //===----------------------------------------------------------------------===//
 
-void populateSparseReinterpretMap(RewritePatternSet &patterns,
-                                  ReinterpretMapScope scope);
+/// A hook that lets a client, such as an autotuner, choose the loop order of
+/// the sparse `linalg.generic` kernels. It is called with the kernel and the
+/// order picked by the scheduler, given as a permutation from the original
+/// loops to the sorted loops, and returns the order to use instead, or a null
+/// map to keep the scheduler's choice. Orders that violate the constraints of
+/// the sparse iteration graph, or that sparsification can not handle, are
+/// ignored.
+using SparseLoopOrderingFn =
+    std::function<AffineMap(Operation *genericOp, AffineMap defaultOrder)>;
+
+void populateSparseReinterpretMap(
+    RewritePatternSet &patterns, ReinterpretMapScope scope,
+    SparseLoopOrderingFn loopOrderingFn = nullptr);
 
 std::unique_ptr<Pass> createSparseReinterpretMapPass();
 std::unique_ptr<Pass> createSparseReinterpretMapPass(ReinterpretMapScope scope);
+std::unique_ptr<Pass>
+createSparseReinterpretMapPass(ReinterpretMapScope scope,
+                               SparseLoopOrderingFn loopOrderingFn);
 
 //===----------------------------------------------------------------------===//
 // The PreSparsificationRewriting pass.
@@ -476,6 +476,18 @@ public:
   /// Returns if the parser should verify the IR after parsing.
   bool shouldVerifyAfterParse() const { return verifyAfterParse; }
 
+  /// Set whether the textual parser may parse the operations of large blocks
+  /// nested directly in an operation that is isolated from above, such as the
+  /// body of a module, or at the top level of a file, in parallel. This only
+  /// applies when multi-threading is enabled on the context, and not when the
+  /// parser populates an AsmParserState or performs code completion. All of
+  /// the dialects available to the context are loaded before parsing in
+  /// parallel.
+  void setParseInParallel(bool enable) { parseInParallel = enable; }
+
+  /// Returns if the parser may parse operations in parallel.
+  bool shouldParseInParallel() const { return parseInParallel; }
+
   /// Returns the parsing configurations associated to the bytecode read.
   BytecodeReaderConfig &getBytecodeReaderConfig() const {
     return const_cast<BytecodeReaderConfig &>(bytecodeReaderConfig);
@@ -513,6 +525,7 @@ public:
 private:
   MLIRContext *context;
   bool verifyAfterParse;
+  bool parseInParallel = false;
   DenseMap<StringRef, std::unique_ptr<AsmResourceParser>> resourceParsers;
   FallbackAsmResourceMap *fallbackResourceMap;
   BytecodeReaderConfig bytecodeReaderConfig;
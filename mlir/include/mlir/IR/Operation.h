@@ -285,6 +285,12 @@ public:
   /// Destroys this operation and its subclass data.
   void destroy();
 
+  /// Return the number of bytes allocated for this operation: the operation
+  /// itself, its results, properties, successors, regions (but not their
+  /// blocks) and operands. Attributes, types and nested operations are not
+  /// included.
+  size_t getAllocatedSize();
+
   /// This drops all operand uses from this operation, which is an essential
   /// step in breaking cyclic dependences between references when they are to
   /// be deleted.
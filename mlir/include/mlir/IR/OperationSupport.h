@@ -1111,6 +1111,15 @@ public:
   /// Return the number of operands held in the storage.
   unsigned size() { return numOperands; }
 
+  /// Return the number of operands the inline storage, trailing the owner
+  /// operation, has room for. This is zero once the operands were moved to a
+  /// dynamic allocation.
+  unsigned getInlineCapacity() const { return isStorageDynamic ? 0 : capacity; }
+
+  /// Return the number of bytes allocated for the operands outside of the
+  /// owner operation.
+  size_t getDynamicAllocatedSize() const;
+
 private:
   /// Resize the storage to the given size. Returns the array containing the new
   /// operands.
@@ -403,6 +403,23 @@ public:
   /// Returns an analysis manager for the current top-level module.
   operator AnalysisManager() { return AnalysisManager(&analyses); }
 
+  /// Returns the top-level operation.
+  Operation *getOperation() const { return analyses.getOperation(); }
+
+  /// Invalidate all of the cached analyses, for the top-level operation and
+  /// all nested operations. This must be called when the IR is modified
+  /// outside of a pass manager run using this analysis manager.
+  void invalidate() {
+    analyses.invalidate(detail::PreservedAnalyses());
+  }
+
+  /// Set the pass instrumentor notified when analyses are computed. A pass
+  /// manager running with this analysis manager sets its own instrumentor for
+  /// the duration of the run.
+  void setPassInstrumentor(PassInstrumentor *passInstrumentor) {
+    analyses.parentOrInstrumentor = passInstrumentor;
+  }
+
 private:
   /// The analyses for the owning module.
   detail::NestedAnalysisMap analyses;
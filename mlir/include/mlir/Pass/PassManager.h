@@ -24,6 +24,7 @@
 namespace mlir {
 class AnalysisManager;
 class MLIRContext;
+class ModuleAnalysisManager;
 class Operation;
 class Pass;
 class PassInstrumentation;
@@ -253,6 +254,13 @@ public:
   /// manager on construction.
   LogicalResult run(Operation *op);
 
+  /// Run the passes within this manager on the provided operation, using the
+  /// given analysis manager, which must be for this operation. Analyses that
+  /// are preserved by the run remain cached in `am`, so that they can be
+  /// reused by later runs, also of other pass managers. If the IR is modified
+  /// between runs outside of a pass manager, `am.invalidate()` must be called.
+  LogicalResult run(Operation *op, ModuleAnalysisManager &am);
+
   /// Return an instance of the context.
   MLIRContext *getContext() const { return context; }
 
@@ -87,7 +87,8 @@ public:
 private:
   /// The list that owns the patterns used within this applicator.
   const FrozenRewritePatternSet &frozenPatternList;
-  /// The set of patterns to match for each operation, stable sorted by benefit.
+  /// The set of patterns to match for each operation, stable sorted by benefit
+  /// and merged with `anyOpPatterns`.
   DenseMap<OperationName, SmallVector<const RewritePattern *, 2>> patterns;
   /// The set of patterns that may match against any operation type, stable
   /// sorted by benefit.
@@ -247,6 +247,22 @@ public:
   /// is initialized when a dialect is loaded.
   bool isParametricStorageInitialized(TypeID id);
 
+  /// Counters of the accesses to the shared tables of parametric storage
+  /// instances. Lookups that hit the thread-local caches are not counted.
+  struct Statistics {
+    /// The number of lookups that found an existing instance in a shared
+    /// table.
+    uint64_t numSharedHits = 0;
+    /// The number of storage instances that were created.
+    uint64_t numCreated = 0;
+    /// The number of times the lock of a shared table was held by another
+    /// thread and had to be waited for.
+    uint64_t numContendedLocks = 0;
+  };
+
+  /// Return the counters summed over all parametric storage classes.
+  Statistics getStatistics() const;
+
   /// Changes the mutable component of 'storage' by forwarding the trailing
   /// arguments to the 'mutate' function of the derived class.
   template <typename Storage, typename... Args>
@@ -103,6 +103,13 @@ public:
     return emitBytecodeVersion;
   }
 
+  /// Set whether to parse the operations of large modules in parallel.
+  MlirOptMainConfig &parseInParallel(bool parallel) {
+    parseInParallelFlag = parallel;
+    return *this;
+  }
+  bool shouldParseInParallel() const { return parseInParallelFlag; }
+
   /// Set the callback to populate the pass manager.
   MlirOptMainConfig &
   setPassPipelineSetupFn(std::function<LogicalResult(PassManager &)> callback) {
@@ -217,6 +224,9 @@ protected:
   /// Emit bytecode at given version.
   std::optional<int64_t> emitBytecodeVersion = std::nullopt;
 
+  /// Parse the operations of large modules in parallel.
+  bool parseInParallelFlag = false;
+
   /// The callback to populate the pass manager.
   std::function<LogicalResult(PassManager &)> passPipelineCallback;
 
@@ -15,6 +15,8 @@
 #define MLIR_TRANSFORMS_GREEDYPATTERNREWRITEDRIVER_H_
 
 #include "mlir/Rewrite/FrozenRewritePatternSet.h"
+#include "llvm/ADT/DenseMap.h"
+#include <chrono>
 
 namespace mlir {
 
@@ -80,6 +82,45 @@ public:
 
   /// An optional listener that should be notified about IR modifications.
   RewriterBase::Listener *listener = nullptr;
+
+  /// When simplifying a region, first simplify the regions of the
+  /// isolated-from-above ops nested directly in it (e.g., the functions of a
+  /// module) concurrently, then the region itself. Patterns applied to the
+  /// nested regions must not modify IR outside of them, the same requirement
+  /// as for a pass scheduled on these ops.
+  ///
+  /// Note: Only applicable when simplifying entire regions. Ignored if
+  /// multi-threading is disabled in the context, if a listener is set, or in
+  /// strict mode.
+  bool parallelizeIsolatedRegions = false;
+};
+
+/// A listener that records, for every pattern, how often the greedy pattern
+/// rewrite driver tried to apply it, how often it succeeded and how much time
+/// it spent in it. Set it as the listener of a GreedyRewriteConfig to profile
+/// a rewrite.
+class GreedyRewriteProfiler : public RewriterBase::Listener {
+public:
+  void notifyPatternBegin(const Pattern &pattern, Operation *op) override;
+  void notifyPatternEnd(const Pattern &pattern, LogicalResult status) override;
+
+  /// Print the recorded statistics, sorted by decreasing time.
+  void print(raw_ostream &os) const;
+
+  /// Forget all recorded statistics.
+  void clear() { stats.clear(); }
+
+private:
+  struct PatternStats {
+    uint64_t numAttempts = 0;
+    uint64_t numSuccesses = 0;
+    std::chrono::steady_clock::duration time{};
+  };
+
+  llvm::DenseMap<const Pattern *, PatternStats> stats;
+
+  /// The time at which the pattern that is being applied was started.
+  std::chrono::steady_clock::time_point start;
 };
 
 //===----------------------------------------------------------------------===//
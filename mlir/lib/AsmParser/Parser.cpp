@@ -42,6 +42,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/Sequence.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Alignment.h"
@@ -51,8 +52,10 @@
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -363,6 +366,7 @@ Parser::parseResourceHandle(const OpAsmDialectInterface *dialect,
   SMLoc nameLoc = getToken().getLoc();
   if (failed(parseOptionalKeyword(&name)))
     return emitError("expected identifier key for 'resource' entry");
+  std::lock_guard<std::mutex> lock(getState().symbols.mutex);
   auto &resources = getState().symbols.dialectResources;
 
   // If this is the first time encountering this handle, ask the dialect to
@@ -552,6 +556,16 @@ public:
   /// Parse an operation instance.
   ParseResult parseOperation();
 
+  /// Parse the operations from the current token up to the end of the
+  /// enclosing block into 'block', splitting them into chunks that are parsed
+  /// in parallel. 'isTopLevel' indicates that the operations are at the top
+  /// level of the file, where they extend up to the next alias definition or
+  /// file metadata dictionary instead of a closing brace. Returns false,
+  /// without consuming any token, if parallel parsing is disabled, if the
+  /// operations cannot be split, or if any chunk does not parse on its own, in
+  /// which case the operations must be parsed serially.
+  bool parseOperationsInParallel(Block *block, bool isTopLevel);
+
   /// Parse a single operation successor.
   ParseResult parseSuccessor(Block *&dest);
 
@@ -617,14 +631,18 @@ public:
 
   /// Parse a region into 'region' with the provided entry block arguments.
   /// 'isIsolatedNameScope' indicates if the naming scope of this region is
-  /// isolated from those above.
+  /// isolated from those above. 'isIsolatedFromAbove' indicates if the region
+  /// belongs to an operation that is isolated from above, in which case the
+  /// operations of its entry block may be parsed in parallel.
   ParseResult parseRegion(Region &region, ArrayRef<Argument> entryArguments,
-                          bool isIsolatedNameScope = false);
+                          bool isIsolatedNameScope = false,
+                          bool isIsolatedFromAbove = false);
 
   /// Parse a region body into 'region'.
   ParseResult parseRegionBody(Region &region, SMLoc startLoc,
                               ArrayRef<Argument> entryArguments,
-                              bool isIsolatedNameScope);
+                              bool isIsolatedNameScope,
+                              bool isIsolatedFromAbove);
 
   //===--------------------------------------------------------------------===//
   // Block Parsing
@@ -699,6 +717,14 @@ private:
     return forwardRefPlaceholders.count(value);
   }
 
+  /// Parse the operations up to 'end' into the top-level operation, as one
+  /// chunk of a block that is parsed in parallel. The chunk may neither define
+  /// nor use values at its top level, as they would have to be visible to the
+  /// other chunks. On success, the deferred location references are moved
+  /// into 'deferredLocs'.
+  ParseResult parseChunk(const char *end,
+                         std::vector<DeferredLocInfo> &deferredLocs);
+
   /// This struct represents an isolated SSA name scope. This scope may contain
   /// other nested non-isolated scopes. These scopes are used for operations
   /// that are known to be isolated to allow for reusing names within their
@@ -1338,7 +1364,9 @@ ParseResult OperationParser::parseGenericOperationAfterOpName(
       do {
         // Create temporary regions with the top level region as parent.
         result.regions.emplace_back(new Region(topLevelOp));
-        if (parseRegion(*result.regions.back(), /*entryArguments=*/{}))
+        if (parseRegion(*result.regions.back(), /*entryArguments=*/{},
+                        /*isIsolatedNameScope=*/false,
+                        result.name.hasTrait<OpTrait::IsIsolatedFromAbove>()))
           return failure();
       } while (consumeIf(Token::comma));
       if (parseToken(Token::r_paren, "expected ')' to end region list"))
@@ -1516,9 +1544,7 @@ public:
       bool isIsolatedFromAbove, StringRef opName, OperationParser &parser)
       : AsmParserImpl<OpAsmParser>(nameLoc, parser), resultIDs(resultIDs),
         parseAssembly(parseAssembly), isIsolatedFromAbove(isIsolatedFromAbove),
-        opName(opName), parser(parser) {
-    (void)isIsolatedFromAbove; // Only used in assert, silence unused warning.
-  }
+        opName(opName), parser(parser) {}
 
   /// Parse an instance of the operation described by 'opDefinition' into the
   /// provided operation state.
@@ -1784,10 +1810,10 @@ public:
   ParseResult parseRegion(Region &region, ArrayRef<Argument> arguments,
                           bool enableNameShadowing) override {
     // Try to parse the region.
-    (void)isIsolatedFromAbove;
     assert((!enableNameShadowing || isIsolatedFromAbove) &&
            "name shadowing is only allowed on isolated regions");
-    if (parser.parseRegion(region, arguments, enableNameShadowing))
+    if (parser.parseRegion(region, arguments, enableNameShadowing,
+                           isIsolatedFromAbove))
       return failure();
     return success();
   }
@@ -2111,7 +2137,8 @@ OperationParser::parseTrailingLocationSpecifier(OpOrArgument opOrArgument) {
 
 ParseResult OperationParser::parseRegion(Region &region,
                                          ArrayRef<Argument> entryArguments,
-                                         bool isIsolatedNameScope) {
+                                         bool isIsolatedNameScope,
+                                         bool isIsolatedFromAbove) {
   // Parse the '{'.
   Token lBraceTok = getToken();
   if (parseToken(Token::l_brace, "expected '{' to begin a region"))
@@ -2124,7 +2151,7 @@ ParseResult OperationParser::parseRegion(Region &region,
   // Parse the region body.
   if ((!entryArguments.empty() || getToken().isNot(Token::r_brace)) &&
       parseRegionBody(region, lBraceTok.getLoc(), entryArguments,
-                      isIsolatedNameScope)) {
+                      isIsolatedNameScope, isIsolatedFromAbove)) {
     return failure();
   }
   consumeToken(Token::r_brace);
@@ -2138,7 +2165,8 @@ ParseResult OperationParser::parseRegion(Region &region,
 
 ParseResult OperationParser::parseRegionBody(Region &region, SMLoc startLoc,
                                              ArrayRef<Argument> entryArguments,
-                                             bool isIsolatedNameScope) {
+                                             bool isIsolatedNameScope,
+                                             bool isIsolatedFromAbove) {
   auto currentPt = opBuilder.saveInsertionPoint();
 
   // Push a new named value scope.
@@ -2186,6 +2214,12 @@ ParseResult OperationParser::parseRegionBody(Region &region, SMLoc startLoc,
     }
   }
 
+  // The entry block of a region without arguments of an operation that is
+  // isolated from above, such as the body of a module, may have its operations
+  // parsed in parallel. Any operations that are left are parsed serially.
+  if (isIsolatedFromAbove && entryArguments.empty())
+    (void)parseOperationsInParallel(block, /*isTopLevel=*/false);
+
   if (parseBlock(block))
     return failure();
 
@@ -2372,6 +2406,238 @@ ParseResult OperationParser::parseOptionalBlockArgList(Block *owner) {
   });
 }
 
+//===----------------------------------------------------------------------===//
+// Parallel Parsing
+//===----------------------------------------------------------------------===//
+
+/// The minimum size of the source text of each chunk of operations that is
+/// parsed in parallel. Blocks with less than two chunks are parsed serially.
+static constexpr size_t kMinParallelChunkSize = 64 * 1024;
+
+/// The diagnostics collected for the block that the current thread parses a
+/// chunk of in parallel, along with the index of that chunk.
+static thread_local std::pair<const void *, size_t> currentParallelChunk;
+
+/// Scan the source text from 'ptr', which is the start of an operation, up to
+/// the end of the enclosing block, and collect the start of each operation
+/// into 'opStarts'. Operations are only recognized at the start of a line
+/// outside of any brackets, which is how the printer lays them out. Returns the
+/// end of the operations, which is the closing brace of the region, or at the
+/// top level the start of the next alias definition or file metadata
+/// dictionary, or the end of the buffer. Returns nullptr if the region has
+/// more than one block or the text could not be scanned.
+static const char *
+scanOperationStarts(const char *ptr, const char *bufferEnd, bool isTopLevel,
+                    SmallVectorImpl<const char *> &opStarts) {
+  opStarts.push_back(ptr);
+  unsigned depth = 0;
+  bool atLineStart = false;
+  for (; ptr != bufferEnd; ++ptr) {
+    char c = *ptr;
+    if (c == '\n') {
+      atLineStart = true;
+      continue;
+    }
+    if (c == ' ' || c == '\t' || c == '\r')
+      continue;
+
+    if (atLineStart && depth == 0) {
+      if (c == '^')
+        return nullptr;
+      if (isTopLevel &&
+          (c == '#' || c == '!' ||
+           StringRef(ptr, bufferEnd - ptr).starts_with("{-#")))
+        return ptr;
+      if (c == '%' || c == '"' || c == '_' || llvm::isAlpha(c))
+        opStarts.push_back(ptr);
+    }
+    atLineStart = false;
+
+    switch (c) {
+    case '/':
+      // Skip over comments, up to the newline that ends them.
+      if (ptr + 1 != bufferEnd && ptr[1] == '/')
+        ptr = std::find(ptr, bufferEnd, '\n') - 1;
+      break;
+    case '"':
+      // Skip over strings, which may contain brackets.
+      for (++ptr; ptr != bufferEnd && *ptr != '"'; ++ptr) {
+        if (*ptr == '\n' || (*ptr == '\\' && ++ptr == bufferEnd))
+          return nullptr;
+      }
+      if (ptr == bufferEnd)
+        return nullptr;
+      break;
+    case '{':
+    case '(':
+    case '[':
+      ++depth;
+      break;
+    case '}':
+    case ')':
+    case ']':
+      if (depth == 0)
+        return !isTopLevel && c == '}' ? ptr : nullptr;
+      --depth;
+      break;
+    }
+  }
+  return isTopLevel && depth == 0 ? ptr : nullptr;
+}
+
+bool OperationParser::parseOperationsInParallel(Block *block,
+                                                bool isTopLevel) {
+  MLIRContext *ctx = getContext();
+  if (!state.config.shouldParseInParallel() || state.isParallelChunk ||
+      state.asmState || state.codeCompleteContext ||
+      !ctx->isMultithreadingEnabled() ||
+      getToken().isAny(Token::caret_identifier, Token::r_brace, Token::eof,
+                       Token::error))
+    return false;
+
+  // Find the operations of the block and group them into chunks, several per
+  // thread to balance the load.
+  const char *begin = getToken().getLoc().getPointer();
+  const llvm::MemoryBuffer *buffer =
+      getSourceMgr().getMemoryBuffer(getSourceMgr().getMainFileID());
+  SmallVector<const char *> opStarts;
+  const char *end =
+      scanOperationStarts(begin, buffer->getBufferEnd(), isTopLevel, opStarts);
+  if (!end || size_t(end - begin) < 2 * kMinParallelChunkSize)
+    return false;
+  size_t chunkSize = std::max<size_t>(
+      kMinParallelChunkSize, (end - begin) / (4 * ctx->getNumThreads()));
+
+  struct Chunk {
+    const char *begin = nullptr;
+    const char *end = nullptr;
+    OwningOpRef<ModuleOp> container;
+    std::vector<DeferredLocInfo> deferredLocs;
+  };
+  std::vector<Chunk> chunks;
+  for (const char *opStart : opStarts) {
+    if (!chunks.empty() && size_t(opStart - chunks.back().begin) < chunkSize)
+      continue;
+    if (!chunks.empty())
+      chunks.back().end = opStart;
+    chunks.emplace_back().begin = opStart;
+  }
+  chunks.back().end = end;
+  if (chunks.size() < 2)
+    return false;
+
+  // Loading a dialect is not thread-safe, so load all the ones that may be
+  // needed up front. Encoding a location also computes the line offsets of the
+  // buffer the first time, before the chunks share them.
+  ctx->loadAllAvailableDialects();
+  (void)getEncodedSourceLocation(getToken().getLoc());
+
+  // Hold back the diagnostics of the chunks, as they are parsed again serially
+  // if any of them fails to parse.
+  std::vector<std::pair<size_t, Diagnostic>> diagnostics;
+  std::atomic<bool> chunkFailed(false);
+  {
+    std::mutex diagnosticsMutex;
+    ScopedDiagnosticHandler handler(ctx, [&](Diagnostic &diag) {
+      if (currentParallelChunk.first != &diagnostics)
+        return failure();
+      std::lock_guard<std::mutex> lock(diagnosticsMutex);
+      diagnostics.emplace_back(currentParallelChunk.second, std::move(diag));
+      return success();
+    });
+
+    std::atomic<size_t> nextChunk(0);
+    auto parseChunks = [&] {
+      while (!chunkFailed) {
+        size_t index = nextChunk++;
+        if (index >= chunks.size())
+          break;
+        Chunk &chunk = chunks[index];
+        currentParallelChunk = {&diagnostics, index};
+        ParserState chunkState(getSourceMgr(), state.config, state.symbols,
+                               /*asmState=*/nullptr,
+                               /*codeCompleteContext=*/nullptr);
+        chunkState.defaultDialectStack = state.defaultDialectStack;
+        chunkState.isParallelChunk = true;
+        chunk.container = ModuleOp::create(UnknownLoc::get(ctx));
+        {
+          OperationParser chunkParser(chunkState, *chunk.container);
+          chunkParser.resetToken(chunk.begin);
+          if (chunkParser.parseChunk(chunk.end, chunk.deferredLocs))
+            chunkFailed = true;
+        }
+        currentParallelChunk = {nullptr, 0};
+      }
+    };
+
+    llvm::ThreadPoolInterface &threadPool = ctx->getThreadPool();
+    llvm::ThreadPoolTaskGroup tasksGroup(threadPool);
+    size_t numActions = std::min<size_t>(chunks.size(),
+                                         threadPool.getMaxConcurrency());
+    for (size_t i = 0; i < numActions; ++i)
+      tasksGroup.async(parseChunks);
+    tasksGroup.wait();
+  }
+  if (chunkFailed)
+    return false;
+
+  llvm::stable_sort(diagnostics, [](const auto &lhs, const auto &rhs) {
+    return lhs.first < rhs.first;
+  });
+  for (auto &it : diagnostics)
+    ctx->getDiagEngine().emit(std::move(it.second));
+
+  // Move the operations into the block in order. The deferred location
+  // references of each chunk are appended to the ones of this parser, so the
+  // placeholder locations of its operations are renumbered accordingly.
+  auto locID = TypeID::get<DeferredLocInfo *>();
+  for (Chunk &chunk : chunks) {
+    size_t offset = deferredLocsReferences.size();
+    llvm::append_range(deferredLocsReferences, chunk.deferredLocs);
+    if (offset != 0 && !chunk.deferredLocs.empty()) {
+      auto renumberLocation = [&](auto &opOrArgument) {
+        auto fwdLoc = dyn_cast<OpaqueLoc>(opOrArgument.getLoc());
+        if (!fwdLoc || fwdLoc.getUnderlyingTypeID() != locID)
+          return;
+        opOrArgument.setLoc(
+            OpaqueLoc::get(fwdLoc.getUnderlyingLocation() + offset, locID,
+                           fwdLoc.getFallbackLocation()));
+      };
+      chunk.container->walk([&](Operation *op) {
+        renumberLocation(*op);
+        for (Region &region : op->getRegions())
+          for (Block &nestedBlock : region.getBlocks())
+            for (BlockArgument arg : nestedBlock.getArguments())
+              renumberLocation(arg);
+      });
+    }
+    block->getOperations().splice(block->end(),
+                                  chunk.container->getBody()->getOperations());
+  }
+  resetToken(end);
+  return true;
+}
+
+ParseResult
+OperationParser::parseChunk(const char *end,
+                            std::vector<DeferredLocInfo> &deferredLocs) {
+  while (getToken().getLoc().getPointer() < end)
+    if (parseOperation())
+      return failure();
+
+  // The last operation must end where the next chunk starts, which fails if
+  // the chunks were not split between operations.
+  if (getToken().getLoc().getPointer() != end)
+    return emitError("expected operation to end at the end of the chunk");
+  if (!forwardRefPlaceholders.empty() ||
+      !isolatedNameScopes.back().values.empty())
+    return emitError("chunk defines or uses values at its top level");
+  if (failed(popSSANameScope()))
+    return failure();
+  deferredLocs = std::move(deferredLocsReferences);
+  return success();
+}
+
 //===----------------------------------------------------------------------===//
 // Code Completion
 //===----------------------------------------------------------------------===//
@@ -2726,8 +2992,11 @@ ParseResult TopLevelOperationParser::parse(Block *topLevelBlock,
   while (true) {
     switch (getToken().getKind()) {
     default:
-      // Parse a top-level operation.
-      if (opParser.parseOperation())
+      // Parse the operations up to the next alias definition or file metadata
+      // dictionary in parallel if possible, or else a top-level operation.
+      if (!opParser.parseOperationsInParallel(topLevelOp->getBody(),
+                                              /*isTopLevel=*/true) &&
+          opParser.parseOperation())
         return failure();
       break;
 
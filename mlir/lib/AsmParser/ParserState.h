@@ -14,6 +14,7 @@
 #include "mlir/IR/OpImplementation.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/StringMap.h"
+#include <mutex>
 
 namespace mlir {
 class OpAsmDialectInterface;
@@ -40,6 +41,11 @@ struct SymbolState {
 
   /// A map from unique integer identifier to DistinctAttr.
   DenseMap<uint64_t, DistinctAttr> distinctAttributes;
+
+  /// Guards `dialectResources` and `distinctAttributes`, which are updated
+  /// while operations are parsed in parallel. The alias definitions are only
+  /// added at the top level, while no operations are parsed in parallel.
+  std::mutex mutex;
 };
 
 //===----------------------------------------------------------------------===//
@@ -91,6 +97,10 @@ struct ParserState {
   // popped when done. At the top-level we start with "builtin" as the
   // default, so that the top-level `module` operation parses as-is.
   SmallVector<StringRef> defaultDialectStack{"builtin"};
+
+  /// Whether this state parses one chunk of the operations of a block that is
+  /// parsed in parallel, in which case nested blocks are parsed serially.
+  bool isParallelChunk = false;
 };
 
 } // namespace detail
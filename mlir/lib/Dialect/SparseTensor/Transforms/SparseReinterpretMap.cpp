@@ -408,7 +408,9 @@ public:
 };
 
 struct GenericOpScheduler : public OpRewritePattern<linalg::GenericOp> {
-  using OpRewritePattern::OpRewritePattern;
+  GenericOpScheduler(MLIRContext *context, SparseLoopOrderingFn loopOrderingFn)
+      : OpRewritePattern(context), loopOrderingFn(std::move(loopOrderingFn)) {}
+
   LogicalResult matchAndRewrite(linalg::GenericOp linalgOp,
                                 PatternRewriter &rewriter) const override {
     if (linalgOp.getNumDpsInits() != 1 || !linalgOp.hasPureTensorSemantics() ||
@@ -457,6 +459,16 @@ struct GenericOpScheduler : public OpRewritePattern<linalg::GenericOp> {
           linalgOp, "the sparse kernel can not be scheduled.");
     }
 
+    // Let the client override the order, as long as sparse iteration still
+    // respects the level orderings of the sparse tensors.
+    if (loopOrderingFn) {
+      AffineMap custom = loopOrderingFn(linalgOp, order);
+      if (custom && custom != order &&
+          scheduler.isValidOrder(custom, SortMask::kSparseOnly) &&
+          isAdmissibleOrder(linalgOp, custom))
+        order = custom;
+    }
+
     // Marks the GenericOp to avoid recursive matching.
     rewriter.modifyOpInPlace(linalgOp, [&]() {
       linalgOp->setAttr(sorted, rewriter.getBoolAttr(true));
@@ -513,6 +525,9 @@ private:
     return static_cast<int64_t>(nest) >= linalgOp.getRank(lhs) - 1;
   };
 
+  /// The client hook for choosing the loop order, if any.
+  SparseLoopOrderingFn loopOrderingFn;
+
   // Last resort cycle resolution.
   static LogicalResult resolveCycle(IterationGraphSorter &scheduler,
                                     linalg::LinalgOp linalgOp,
@@ -790,11 +805,13 @@ struct ForeachOpDemapper
 } // namespace
 
 void mlir::populateSparseReinterpretMap(RewritePatternSet &patterns,
-                                        ReinterpretMapScope scope) {
+                                        ReinterpretMapScope scope,
+                                        SparseLoopOrderingFn loopOrderingFn) {
   if (scope == ReinterpretMapScope::kAll ||
       scope == ReinterpretMapScope::kGenericOnly) {
-    patterns.add<GenericOpReinterpretMap, GenericOpScheduler>(
-        patterns.getContext());
+    patterns.add<GenericOpReinterpretMap>(patterns.getContext());
+    patterns.add<GenericOpScheduler>(patterns.getContext(),
+                                     std::move(loopOrderingFn));
   }
   if (scope == ReinterpretMapScope::kAll ||
       scope == ReinterpretMapScope::kExceptGeneric) {
@@ -64,16 +64,21 @@ struct SparseReinterpretMap
     : public impl::SparseReinterpretMapBase<SparseReinterpretMap> {
   SparseReinterpretMap() = default;
   SparseReinterpretMap(const SparseReinterpretMap &pass) = default;
-  SparseReinterpretMap(const SparseReinterpretMapOptions &options) {
+  SparseReinterpretMap(const SparseReinterpretMapOptions &options,
+                       SparseLoopOrderingFn loopOrderingFn = nullptr)
+      : loopOrderingFn(std::move(loopOrderingFn)) {
     scope = options.scope;
   }
 
   void runOnOperation() override {
     auto *ctx = &getContext();
     RewritePatternSet patterns(ctx);
-    populateSparseReinterpretMap(patterns, scope);
+    populateSparseReinterpretMap(patterns, scope, loopOrderingFn);
     (void)applyPatternsAndFoldGreedily(getOperation(), std::move(patterns));
   }
+
+private:
+  SparseLoopOrderingFn loopOrderingFn;
 };
 
 struct PreSparsificationRewritePass
@@ -409,6 +414,15 @@ mlir::createSparseReinterpretMapPass(ReinterpretMapScope scope) {
   return std::make_unique<SparseReinterpretMap>(options);
 }
 
+std::unique_ptr<Pass>
+mlir::createSparseReinterpretMapPass(ReinterpretMapScope scope,
+                                     SparseLoopOrderingFn loopOrderingFn) {
+  SparseReinterpretMapOptions options;
+  options.scope = scope;
+  return std::make_unique<SparseReinterpretMap>(options,
+                                                std::move(loopOrderingFn));
+}
+
 std::unique_ptr<Pass> mlir::createPreSparsificationRewritePass() {
   return std::make_unique<PreSparsificationRewritePass>();
 }
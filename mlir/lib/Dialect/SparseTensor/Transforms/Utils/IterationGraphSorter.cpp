@@ -165,6 +165,32 @@ IterationGraphSorter::IterationGraphSorter(
 }
 
 AffineMap IterationGraphSorter::sort(SortMask mask, Value ignored) {
+  buildGraph(mask, ignored);
+
+  // Return the topological sort (empty for cyclic).
+  return topoSort();
+}
+
+bool IterationGraphSorter::isValidOrder(AffineMap order, SortMask mask,
+                                        Value ignored) {
+  const unsigned numLoops = getNumLoops();
+  if (!order || !order.isPermutation() || order.getNumDims() != numLoops)
+    return false;
+
+  buildGraph(mask, ignored);
+
+  // Every edge of the iteration graph must go from an outer to an inner loop.
+  SmallVector<unsigned> position(numLoops);
+  for (auto [i, expr] : llvm::enumerate(order.getResults()))
+    position[llvm::cast<AffineDimExpr>(expr).getPosition()] = i;
+  for (unsigned src = 0; src < numLoops; src++)
+    for (unsigned dst = 0; dst < numLoops; dst++)
+      if (itGraph[src][dst] && position[src] > position[dst])
+        return false;
+  return true;
+}
+
+void IterationGraphSorter::buildGraph(SortMask mask, Value ignored) {
   // Reset the adjacency matrix that represents the iteration graph.
   for (auto &row : itGraph)
     std::fill(row.begin(), row.end(), false);
@@ -186,9 +212,6 @@ AffineMap IterationGraphSorter::sort(SortMask mask, Value ignored) {
   const auto enc = getSparseTensorEncoding(out.getType());
   if ((enc || includesDenseOutput(mask)) && out != ignored)
     addConstraints(out, loop2OutLvl);
-
-  // Return the topological sort (empty for cyclic).
-  return topoSort();
 }
 
 void IterationGraphSorter::addConstraints(Value t, AffineMap loop2LvlMap) {
@@ -50,6 +50,12 @@ public:
   /// cannot be scheduled due to cyclic iteration graph.
   [[nodiscard]] AffineMap sort(SortMask mask, Value ignored = nullptr);
 
+  /// Returns true if the given loop order, in the same form as the
+  /// permutation returned by `sort`, satisfies all the ordering constraints
+  /// of the iteration graph for the given mask.
+  [[nodiscard]] bool isValidOrder(AffineMap order, SortMask mask,
+                                  Value ignored = nullptr);
+
   /// Returns the number of loops in the iteration graph.
   unsigned getNumLoops() const { return loop2OutLvl.getNumDims(); }
 
@@ -60,6 +66,9 @@ private:
                        AffineMap loop2OutLvl,
                        SmallVector<utils::IteratorType> &&iterTypes);
 
+  // Builds the iteration graph for the tensors selected by the mask.
+  void buildGraph(SortMask mask, Value ignored);
+
   // Adds all the constraints in the given loop to level map.
   void addConstraints(Value t, AffineMap loop2LvlMap);
 
@@ -1797,6 +1797,10 @@ public:
 
   /// Initialize the alias state to enable the printing of aliases.
   void initializeAliases(Operation *op) {
+    // The IR may not change while this state is in use, so the aliases of an
+    // operation that is printed again with the same state are still valid.
+    if (std::exchange(aliasesInitializedFor, op) == op)
+      return;
     aliasState.initialize(op, printerFlags, interfaces);
   }
 
@@ -1855,6 +1859,9 @@ private:
   /// The state used for attribute and type aliases.
   AliasState aliasState;
 
+  /// The top-level operation the alias state was initialized for, if any.
+  Operation *aliasesInitializedFor = nullptr;
+
   /// The state used for SSA value names.
   SSANameState nameState;
 
@@ -2737,8 +2744,27 @@ void AsmPrinter::Impl::printEscapedString(StringRef str) {
   os << "\"";
 }
 
+/// Print `data` to `os` as uppercase hexadecimal digits. The digits are
+/// produced a block at a time into a stack buffer, which avoids materializing
+/// a string twice the size of `data` for large blobs.
+static void printHexDigits(raw_ostream &os, StringRef data) {
+  constexpr size_t blockSize = 4096;
+  char buffer[2 * blockSize];
+  for (size_t offset = 0, e = data.size(); offset < e; offset += blockSize) {
+    size_t count = std::min(blockSize, e - offset);
+    for (size_t i = 0; i < count; ++i) {
+      uint8_t byte = data[offset + i];
+      buffer[2 * i] = llvm::hexdigit(byte >> 4);
+      buffer[2 * i + 1] = llvm::hexdigit(byte & 0xF);
+    }
+    os.write(buffer, 2 * count);
+  }
+}
+
 void AsmPrinter::Impl::printHexString(StringRef str) {
-  os << "\"0x" << llvm::toHex(str) << "\"";
+  os << "\"0x";
+  printHexDigits(os, str);
+  os << "\"";
 }
 void AsmPrinter::Impl::printHexString(ArrayRef<char> data) {
   printHexString(StringRef(data.data(), data.size()));
@@ -3179,33 +3205,50 @@ private:
   class ResourceBuilder : public AsmResourceBuilder {
   public:
     using ValueFn = function_ref<void(raw_ostream &)>;
-    using PrintFn = function_ref<void(StringRef, ValueFn)>;
+    /// The optional size is the number of characters `ValueFn` prints, when it
+    /// is known without printing the value.
+    using PrintFn =
+        function_ref<void(StringRef, ValueFn, std::optional<uint64_t>)>;
 
     ResourceBuilder(PrintFn printFn) : printFn(printFn) {}
     ~ResourceBuilder() override = default;
 
     void buildBool(StringRef key, bool data) final {
-      printFn(key, [&](raw_ostream &os) { os << (data ? "true" : "false"); });
+      printFn(
+          key, [&](raw_ostream &os) { os << (data ? "true" : "false"); },
+          std::nullopt);
     }
 
     void buildString(StringRef key, StringRef data) final {
-      printFn(key, [&](raw_ostream &os) {
-        os << "\"";
-        llvm::printEscapedString(data, os);
-        os << "\"";
-      });
+      printFn(
+          key,
+          [&](raw_ostream &os) {
+            os << "\"";
+            llvm::printEscapedString(data, os);
+            os << "\"";
+          },
+          std::nullopt);
     }
 
     void buildBlob(StringRef key, ArrayRef<char> data,
                    uint32_t dataAlignment) final {
-      printFn(key, [&](raw_ostream &os) {
-        // Store the blob in a hex string containing the alignment and the data.
-        llvm::support::ulittle32_t dataAlignmentLE(dataAlignment);
-        os << "\"0x"
-           << llvm::toHex(StringRef(reinterpret_cast<char *>(&dataAlignmentLE),
-                                    sizeof(dataAlignment)))
-           << llvm::toHex(StringRef(data.data(), data.size())) << "\"";
-      });
+      // The blob is printed as `"0x` followed by the hex digits of the 32-bit
+      // alignment and of the data, and a closing quote.
+      uint64_t printedSize = 4 + 2 * (sizeof(dataAlignment) + data.size());
+      printFn(
+          key,
+          [&](raw_ostream &os) {
+            // Store the blob in a hex string containing the alignment and the
+            // data.
+            llvm::support::ulittle32_t dataAlignmentLE(dataAlignment);
+            os << "\"0x";
+            printHexDigits(os,
+                           StringRef(reinterpret_cast<char *>(&dataAlignmentLE),
+                                     sizeof(dataAlignment)));
+            printHexDigits(os, StringRef(data.data(), data.size()));
+            os << "\"";
+          },
+          printedSize);
     }
 
   private:
@@ -3276,7 +3319,8 @@ void OperationPrinter::printResourceFileMetadata(
   auto processProvider = [&](StringRef dictName, StringRef name, auto &provider,
                              auto &&...providerArgs) {
     bool hadEntry = false;
-    auto printFn = [&](StringRef key, ResourceBuilder::ValueFn valueFn) {
+    auto printFn = [&](StringRef key, ResourceBuilder::ValueFn valueFn,
+                       std::optional<uint64_t> valueSize) {
       checkAddMetadataDict();
 
       auto printFormatting = [&]() {
@@ -3298,7 +3342,16 @@ void OperationPrinter::printResourceFileMetadata(
 
       std::optional<uint64_t> charLimit =
           printerFlags.getLargeResourceStringLimit();
-      if (charLimit.has_value()) {
+      if (charLimit.has_value() && valueSize.has_value()) {
+        // The size of the entry is known, so large entries (typically blobs)
+        // can be elided without printing them to a temporary string first.
+        if (*valueSize > *charLimit)
+          return;
+
+        printFormatting();
+        os << "      " << key << ": ";
+        valueFn(os);
+      } else if (charLimit.has_value()) {
         std::string resourceStr;
         llvm::raw_string_ostream ss(resourceStr);
         valueFn(ss);
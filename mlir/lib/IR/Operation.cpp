@@ -214,6 +214,25 @@ void Operation::destroy() {
   free(rawMem);
 }
 
+size_t Operation::getAllocatedSize() {
+  // This mirrors the computation in `Operation::create`. The inline operand
+  // storage that is left behind when the operands move to a dynamic
+  // allocation is not accounted for.
+  unsigned numInlineOperands = 0;
+  size_t dynamicOperandSize = 0;
+  if (hasOperandStorage) {
+    numInlineOperands = getOperandStorage().getInlineCapacity();
+    dynamicOperandSize = getOperandStorage().getDynamicAllocatedSize();
+  }
+  size_t byteSize =
+      totalSizeToAlloc<detail::OperandStorage, detail::OpProperties,
+                       BlockOperand, Region, OpOperand>(
+          hasOperandStorage ? 1 : 0, getPropertiesStorageSize(), numSuccs,
+          numRegions, numInlineOperands);
+  return byteSize + llvm::alignTo(prefixAllocSize(), alignof(Operation)) +
+         dynamicOperandSize;
+}
+
 /// Return true if this operation is a proper ancestor of the `other`
 /// operation.
 bool Operation::isProperAncestor(Operation *other) {
@@ -254,6 +254,10 @@ detail::OperandStorage::~OperandStorage() {
     free(operandStorage);
 }
 
+size_t detail::OperandStorage::getDynamicAllocatedSize() const {
+  return isStorageDynamic ? sizeof(OpOperand) * capacity : 0;
+}
+
 /// Replace the operands contained in the storage with the ones provided in
 /// 'values'.
 void detail::OperandStorage::setOperands(Operation *owner, ValueRange values) {
@@ -9,6 +9,7 @@
 #include "mlir/IR/SymbolTable.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/OpImplementation.h"
+#include "mlir/IR/Threading.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallString.h"
@@ -1053,26 +1054,39 @@ LockedSymbolTableCollection::getSymbolTable(Operation *symbolTableOp) {
 SymbolUserMap::SymbolUserMap(SymbolTableCollection &symbolTable,
                              Operation *symbolTableOp)
     : symbolTable(symbolTable) {
-  // Walk each of the symbol tables looking for discardable callgraph nodes.
-  SmallVector<Operation *> symbols;
+  // Collect the operations nested directly in each of the symbol tables. We
+  // just set `allSymUsesVisible` to false here because it isn't necessary for
+  // building the user map.
+  SmallVector<std::pair<Operation *, Operation *>> nestedOps;
   auto walkFn = [&](Operation *symbolTableOp, bool allUsesVisible) {
-    for (Operation &nestedOp : symbolTableOp->getRegion(0).getOps()) {
-      auto symbolUses = SymbolTable::getSymbolUses(&nestedOp);
-      assert(symbolUses && "expected uses to be valid");
-
-      for (const SymbolTable::SymbolUse &use : *symbolUses) {
-        symbols.clear();
-        (void)symbolTable.lookupSymbolIn(symbolTableOp, use.getSymbolRef(),
-                                         symbols);
-        for (Operation *symbolOp : symbols)
-          symbolToUsers[symbolOp].insert(use.getUser());
-      }
-    }
+    for (Operation &nestedOp : symbolTableOp->getRegion(0).getOps())
+      nestedOps.emplace_back(symbolTableOp, &nestedOp);
   };
-  // We just set `allSymUsesVisible` to false here because it isn't necessary
-  // for building the user map.
   SymbolTable::walkSymbolTables(symbolTableOp, /*allSymUsesVisible=*/false,
                                 walkFn);
+
+  // Collecting the uses walks every nested operation and its attributes, and
+  // is done in parallel. Resolving them uses the symbol table collection,
+  // which is not thread-safe, and is done in the original order so that the
+  // users of each symbol are recorded deterministically.
+  std::vector<std::optional<SymbolTable::UseRange>> symbolUses(
+      nestedOps.size());
+  parallelFor(symbolTableOp->getContext(), 0, nestedOps.size(), [&](size_t i) {
+    symbolUses[i] = SymbolTable::getSymbolUses(nestedOps[i].second);
+    assert(symbolUses[i] && "expected uses to be valid");
+  });
+
+  SmallVector<Operation *> symbols;
+  for (auto [ops, uses] : llvm::zip_equal(nestedOps, symbolUses)) {
+    for (const SymbolTable::SymbolUse &use : *uses) {
+      symbols.clear();
+      (void)symbolTable.lookupSymbolIn(ops.first, use.getSymbolRef(), symbols);
+      for (Operation *symbolOp : symbols)
+        symbolToUsers[symbolOp].insert(use.getUser());
+    }
+    // Release the uses of this operation early, there may be many of them.
+    uses.reset();
+  }
 }
 
 void SymbolUserMap::replaceAllUsesWith(Operation *symbol,
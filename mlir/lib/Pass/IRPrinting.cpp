@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "PassDetail.h"
+#include "mlir/IR/AsmState.h"
 #include "mlir/IR/SymbolTable.h"
 #include "mlir/Pass/PassManager.h"
 #include "llvm/Support/Format.h"
@@ -31,6 +32,11 @@ private:
   void runAfterPass(Pass *pass, Operation *op) override;
   void runAfterPassFailed(Pass *pass, Operation *op) override;
 
+  /// Print the IR for `op`, or for its top-level operation when printing at
+  /// module scope.
+  void printIR(Operation *op, bool printModuleScope, raw_ostream &out,
+               OpPrintingFlags flags);
+
   /// Configuration to use.
   std::unique_ptr<PassManager::IRPrinterConfig> config;
 
@@ -38,11 +44,21 @@ private:
   /// being operated on in a pass. This field is only used when the
   /// configuration asked for change detection.
   DenseMap<Pass *, OperationFingerPrint> beforePassFingerPrints;
+
+  /// The printer state of the top-level operation last printed at module
+  /// scope, and the fingerprint of that operation when the state was created.
+  /// The state is reused for as long as the fingerprint is unchanged, so that
+  /// dumping IR that a pass did not modify doesn't verify it and compute its
+  /// SSA names and aliases again. Printing at module scope requires
+  /// multi-threading to be disabled, so this isn't accessed concurrently.
+  std::unique_ptr<AsmState> topLevelState;
+  std::optional<OperationFingerPrint> topLevelFingerPrint;
 };
 } // namespace
 
-static void printIR(Operation *op, bool printModuleScope, raw_ostream &out,
-                    OpPrintingFlags flags) {
+void IRPrinterInstrumentation::printIR(Operation *op, bool printModuleScope,
+                                       raw_ostream &out,
+                                       OpPrintingFlags flags) {
   // Otherwise, check to see if we are not printing at module scope.
   if (!printModuleScope)
     return op->print(out << " //----- //\n",
@@ -59,7 +75,12 @@ static void printIR(Operation *op, bool printModuleScope, raw_ostream &out,
   auto *topLevelOp = op;
   while (auto *parentOp = topLevelOp->getParentOp())
     topLevelOp = parentOp;
-  topLevelOp->print(out, flags);
+  OperationFingerPrint fingerPrint(topLevelOp);
+  if (!topLevelState || topLevelFingerPrint != fingerPrint) {
+    topLevelState = std::make_unique<AsmState>(topLevelOp, flags);
+    topLevelFingerPrint = fingerPrint;
+  }
+  topLevelOp->print(out, *topLevelState);
 }
 
 /// Instrumentation hooks.
@@ -844,6 +844,14 @@ void PassManager::enableVerifier(bool enabled) { verifyPasses = enabled; }
 
 /// Run the passes within this manager on the provided operation.
 LogicalResult PassManager::run(Operation *op) {
+  // Construct a top level analysis manager for the pipeline.
+  ModuleAnalysisManager am(op, /*passInstrumentor=*/nullptr);
+  return run(op, am);
+}
+
+LogicalResult PassManager::run(Operation *op, ModuleAnalysisManager &am) {
+  assert(am.getOperation() == op &&
+         "analysis manager is for a different operation");
   MLIRContext *context = getContext();
   std::optional<OperationName> anchorOp = getOpName(*context);
   if (anchorOp && anchorOp != op->getName())
@@ -875,8 +883,11 @@ LogicalResult PassManager::run(Operation *op) {
     pipelineKey = pipelineInitializationKey;
   }
 
-  // Construct a top level analysis manager for the pipeline.
-  ModuleAnalysisManager am(op, instrumentor.get());
+  // Notify this pass manager's instrumentations of the analyses computed
+  // during the run. The analysis manager may outlive this pass manager.
+  am.setPassInstrumentor(instrumentor.get());
+  auto resetInstrumentor = llvm::make_scope_exit(
+      [&] { am.setPassInstrumentor(/*passInstrumentor=*/nullptr); });
 
   // If reproducer generation is enabled, run the pass manager with crash
   // handling enabled.
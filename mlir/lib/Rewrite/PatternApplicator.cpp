@@ -112,6 +112,29 @@ void PatternApplicator::applyCostModel(CostModel model) {
   for (auto &it : patterns)
     processPatternList(it.second);
   processPatternList(anyOpPatterns);
+
+  // Merge the patterns that match any operation into the list of every
+  // operation that has specific patterns, in the order in which they would be
+  // tried, so that matching walks a single list. Operations without specific
+  // patterns use `anyOpPatterns` directly.
+  if (anyOpPatterns.empty())
+    return;
+  for (auto &it : patterns) {
+    SmallVector<const RewritePattern *, 2> &opPatterns = it.second;
+    SmallVector<const RewritePattern *, 2> merged;
+    merged.reserve(opPatterns.size() + anyOpPatterns.size());
+    unsigned opIt = 0, opE = opPatterns.size();
+    unsigned anyIt = 0, anyE = anyOpPatterns.size();
+    while (opIt < opE || anyIt < anyE) {
+      if (opIt < opE &&
+          (anyIt == anyE || !(opPatterns[opIt]->getBenefit() <
+                              anyOpPatterns[anyIt]->getBenefit())))
+        merged.push_back(opPatterns[opIt++]);
+      else
+        merged.push_back(anyOpPatterns[anyIt++]);
+    }
+    opPatterns = std::move(merged);
+  }
 }
 
 void PatternApplicator::walkAllPatterns(
@@ -141,15 +164,14 @@ LogicalResult PatternApplicator::matchAndRewrite(
     bytecode->match(op, rewriter, pdlMatches, *mutableByteCodeState);
 
   // Check to see if there are patterns matching this specific operation type.
-  MutableArrayRef<const RewritePattern *> opPatterns;
+  // Their list already includes the patterns matching any operation type.
+  ArrayRef<const RewritePattern *> opPatterns = anyOpPatterns;
   auto patternIt = patterns.find(op->getName());
   if (patternIt != patterns.end())
     opPatterns = patternIt->second;
 
-  // Process the patterns for that match the specific operation type, and any
-  // operation type in an interleaved fashion.
+  // Process the native patterns and the PDL matches in an interleaved fashion.
   unsigned opIt = 0, opE = opPatterns.size();
-  unsigned anyIt = 0, anyE = anyOpPatterns.size();
   unsigned pdlIt = 0, pdlE = pdlMatches.size();
   LogicalResult result = failure();
   do {
@@ -157,16 +179,9 @@ LogicalResult PatternApplicator::matchAndRewrite(
     const Pattern *bestPattern = nullptr;
     unsigned *bestPatternIt = &opIt;
 
-    /// Operation specific patterns.
+    /// Native patterns.
     if (opIt < opE)
       bestPattern = opPatterns[opIt];
-    /// Operation agnostic patterns.
-    if (anyIt < anyE &&
-        (!bestPattern ||
-         bestPattern->getBenefit() < anyOpPatterns[anyIt]->getBenefit())) {
-      bestPatternIt = &anyIt;
-      bestPattern = anyOpPatterns[anyIt];
-    }
 
     const PDLByteCode::MatchResult *pdlMatch = nullptr;
     /// PDL patterns.
@@ -22,6 +22,19 @@ using namespace mlir;
 static std::unique_ptr<llvm::MemoryBuffer>
 openInputFileImpl(StringRef inputFilename, std::string *errorMessage,
                   std::optional<llvm::Align> alignment) {
+  // Bytecode does not need a null terminator. Without one, large files are
+  // always mapped rather than read, also when their size is a multiple of the
+  // page size, and resource blobs can then refer to the mapped file in place.
+  // The magic number is the one checked by `mlir::isBytecode`, which lives in a
+  // library that depends on this one.
+  if (inputFilename != "-") {
+    auto fileOrErr = llvm::MemoryBuffer::getFile(
+        inputFilename, /*IsText=*/false, /*RequiresNullTerminator=*/false,
+        /*IsVolatile=*/false, alignment);
+    if (fileOrErr && (*fileOrErr)->getBuffer().starts_with("ML\xefR"))
+      return std::move(*fileOrErr);
+  }
+
   auto fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(
       inputFilename, /*IsText=*/false, /*RequiresNullTerminator=*/true,
       alignment);
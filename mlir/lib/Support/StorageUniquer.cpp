@@ -11,7 +11,11 @@
 #include "mlir/Support/LLVM.h"
 #include "mlir/Support/ThreadLocalCache.h"
 #include "mlir/Support/TypeID.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/RWMutex.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 using namespace mlir;
 using namespace mlir::detail;
@@ -82,10 +86,38 @@ private:
     /// The set containing the allocated storage instances.
     StorageTypeSet instances;
 
+    /// Counters reported by StorageUniquer::getStatistics.
+    std::atomic<uint64_t> numSharedHits{0};
+    std::atomic<uint64_t> numCreated{0};
+    std::atomic<uint64_t> numContendedLocks{0};
+
 #if LLVM_ENABLE_THREADS != 0
     /// A mutex to keep uniquing thread-safe.
     llvm::sys::SmartRWMutex<true> mutex;
+
+    /// Acquire `mutex` in shared or exclusive mode, counting the times it is
+    /// held by another thread.
+    void lockShared() {
+      if (mutex.try_lock_shared())
+        return;
+      numContendedLocks.fetch_add(1, std::memory_order_relaxed);
+      mutex.lock_shared();
+    }
+    void lock() {
+      if (mutex.try_lock())
+        return;
+      numContendedLocks.fetch_add(1, std::memory_order_relaxed);
+      mutex.lock();
+    }
 #endif
+
+    /// Add the counters of this shard to `stats`.
+    void addStatistics(StorageUniquer::Statistics &stats) const {
+      stats.numSharedHits += numSharedHits.load(std::memory_order_relaxed);
+      stats.numCreated += numCreated.load(std::memory_order_relaxed);
+      stats.numContendedLocks +=
+          numContendedLocks.load(std::memory_order_relaxed);
+    }
   };
 
   /// Get or create an instance of a param derived type in an thread-unsafe
@@ -94,8 +126,10 @@ private:
                                  function_ref<BaseStorage *()> ctorFn) {
     auto existing = shard.instances.insert_as({key.hashValue}, key);
     BaseStorage *&storage = existing.first->storage;
-    if (existing.second)
+    if (existing.second) {
       storage = ctorFn();
+      shard.numCreated.fetch_add(1, std::memory_order_relaxed);
+    }
     return storage;
   }
 
@@ -109,11 +143,20 @@ private:
 
 public:
 #if LLVM_ENABLE_THREADS != 0
+  /// Return the default number of shards: one per hardware thread, so that
+  /// threads creating instances at the same time rarely wait on each other,
+  /// but at least 8.
+  static size_t getDefaultNumShards() {
+    static const size_t numShards = std::max<size_t>(
+        8, llvm::PowerOf2Ceil(std::thread::hardware_concurrency()));
+    return numShards;
+  }
+
   /// Initialize the storage uniquer with a given number of storage shards to
   /// use. The provided shard number is required to be a valid power of 2. The
   /// destructor function is used to destroy any allocated storage instances.
   ParametricStorageUniquer(function_ref<void(BaseStorage *)> destructorFn,
-                           size_t numShards = 8)
+                           size_t numShards = getDefaultNumShards())
       : shards(new std::atomic<Shard *>[numShards]), numShards(numShards),
         destructorFn(destructorFn) {
     assert(llvm::isPowerOf2_64(numShards) &&
@@ -147,18 +190,32 @@ public:
 
     // Check for an existing instance in read-only mode.
     {
-      llvm::sys::SmartScopedReader<true> typeLock(shard.mutex);
+      shard.lockShared();
       auto it = shard.instances.find_as(lookupKey);
-      if (it != shard.instances.end())
-        return localInst = it->storage;
+      BaseStorage *existing =
+          it != shard.instances.end() ? it->storage : nullptr;
+      shard.mutex.unlock_shared();
+      if (existing) {
+        shard.numSharedHits.fetch_add(1, std::memory_order_relaxed);
+        return localInst = existing;
+      }
     }
 
     // Acquire a writer-lock so that we can safely create the new storage
     // instance.
-    llvm::sys::SmartScopedWriter<true> typeLock(shard.mutex);
+    shard.lock();
+    std::unique_lock<llvm::sys::SmartRWMutex<true>> typeLock(shard.mutex,
+                                                             std::adopt_lock);
     return localInst = getOrCreateUnsafe(shard, lookupKey, ctorFn);
   }
 
+  /// Add the counters of all shards to `stats`.
+  void addStatistics(StorageUniquer::Statistics &stats) const {
+    for (size_t i = 0; i != numShards; ++i)
+      if (Shard *shard = shards[i].load(std::memory_order_acquire))
+        shard->addStatistics(stats);
+  }
+
   /// Run a mutation function on the provided storage object in a thread-safe
   /// way.
   LogicalResult mutate(bool threadingIsEnabled, BaseStorage *storage,
@@ -170,7 +227,9 @@ public:
     // be the same shard as the original allocation, but does need to be
     // deterministic.
     Shard &shard = getShard(llvm::hash_value(storage));
-    llvm::sys::SmartScopedWriter<true> lock(shard.mutex);
+    shard.lock();
+    std::unique_lock<llvm::sys::SmartRWMutex<true>> lock(shard.mutex,
+                                                         std::adopt_lock);
     return mutationFn();
   }
 
@@ -235,6 +294,11 @@ private:
     return mutationFn();
   }
 
+  /// Add the counters of the shard to `stats`.
+  void addStatistics(StorageUniquer::Statistics &stats) const {
+    shard.addStatistics(stats);
+  }
+
 private:
   /// The main uniquer shard that is used for allocating storage instances.
   Shard shard;
@@ -383,6 +447,13 @@ void StorageUniquer::registerParametricStorageTypeImpl(
       id, std::make_unique<ParametricStorageUniquer>(destructorFn));
 }
 
+auto StorageUniquer::getStatistics() const -> Statistics {
+  Statistics stats;
+  for (const auto &it : impl->parametricUniquers)
+    it.second->addStatistics(stats);
+  return stats;
+}
+
 /// Implementation for getting an instance of a derived type with default
 /// storage.
 auto StorageUniquer::getSingletonImpl(TypeID id) -> BaseStorage * {
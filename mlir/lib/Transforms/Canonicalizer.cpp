@@ -35,6 +35,7 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     this->enableRegionSimplification = config.enableRegionSimplification;
     this->maxIterations = config.maxIterations;
     this->maxNumRewrites = config.maxNumRewrites;
+    this->parallelizeIsolatedRegions = config.parallelizeIsolatedRegions;
     this->disabledPatterns = disabledPatterns;
     this->enabledPatterns = enabledPatterns;
   }
@@ -47,6 +48,7 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     config.enableRegionSimplification = enableRegionSimplification;
     config.maxIterations = maxIterations;
     config.maxNumRewrites = maxNumRewrites;
+    config.parallelizeIsolatedRegions = parallelizeIsolatedRegions;
 
     RewritePatternSet owningPatterns(context);
     for (auto *dialect : context->getLoadedDialects())
@@ -59,8 +61,21 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     return success();
   }
   void runOnOperation() override {
+    GreedyRewriteConfig runConfig = config;
+    GreedyRewriteProfiler profiler;
+    if (profilePatterns && !runConfig.listener)
+      runConfig.listener = &profiler;
     LogicalResult converged =
-        applyPatternsAndFoldGreedily(getOperation(), *patterns, config);
+        applyPatternsAndFoldGreedily(getOperation(), *patterns, runConfig);
+    if (runConfig.listener == &profiler) {
+      // Print the report at once, instances of this pass may run in parallel.
+      std::string report;
+      llvm::raw_string_ostream os(report);
+      os << "Canonicalization patterns applied to '"
+         << getOperation()->getName() << "':\n";
+      profiler.print(os);
+      llvm::errs() << os.str();
+    }
     // Canonicalization is best-effort. Non-convergence is not a pass failure.
     if (testConvergence && failed(converged))
       signalPassFailure();
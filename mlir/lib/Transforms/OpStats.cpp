@@ -41,16 +41,21 @@ struct PrintOpStatsPass : public impl::PrintOpStatsBase<PrintOpStatsPass> {
 
 private:
   llvm::StringMap<int64_t> opCount;
+  llvm::StringMap<uint64_t> opBytes;
   raw_ostream &os;
 };
 } // namespace
 
 void PrintOpStatsPass::runOnOperation() {
   opCount.clear();
+  opBytes.clear();
 
   // Compute the operation statistics for the currently visited operation.
-  getOperation()->walk(
-      [&](Operation *op) { ++opCount[op->getName().getStringRef()]; });
+  getOperation()->walk([&](Operation *op) {
+    ++opCount[op->getName().getStringRef()];
+    if (printMemory)
+      opBytes[op->getName().getStringRef()] += op->getAllocatedSize();
+  });
   if (printAsJSON) {
     printSummaryInJSON();
   } else
@@ -78,6 +83,7 @@ void PrintOpStatsPass::printSummary() {
     maxLenOpName = std::max(maxLenOpName, opName.size());
   }
 
+  uint64_t totalCount = 0, totalBytes = 0;
   for (const auto &key : sorted) {
     auto [dialectName, opName] = splitOperationName(key);
 
@@ -90,9 +96,18 @@ void PrintOpStatsPass::printSummary() {
       os << llvm::right_justify(dialectName, maxLenDialect + 2) << '.';
 
     // Left justify the operation name.
-    os << llvm::left_justify(opName, maxLenOpName) << " , " << opCount[key]
-       << '\n';
+    os << llvm::left_justify(opName, maxLenOpName) << " , " << opCount[key];
+    if (printMemory) {
+      // Print the total and the average number of bytes.
+      os << " , " << opBytes[key] << " , " << opBytes[key] / opCount[key];
+      totalCount += opCount[key];
+      totalBytes += opBytes[key];
+    }
+    os << '\n';
   }
+  if (printMemory && totalCount)
+    os << "Total: " << totalCount << " operations, " << totalBytes
+       << " bytes, " << totalBytes / totalCount << " bytes per operation\n";
 }
 
 void PrintOpStatsPass::printSummaryInJSON() {
@@ -103,7 +118,12 @@ void PrintOpStatsPass::printSummaryInJSON() {
 
   for (unsigned i = 0, e = sorted.size(); i != e; ++i) {
     const auto &key = sorted[i];
-    os << "  \"" << key << "\" : " << opCount[key];
+    os << "  \"" << key << "\" : ";
+    if (printMemory)
+      os << "{ \"count\" : " << opCount[key] << ", \"bytes\" : "
+         << opBytes[key] << " }";
+    else
+      os << opCount[key];
     if (i != e - 1)
       os << ",\n";
     else
@@ -15,6 +15,7 @@
 #include "mlir/Config/mlir-config.h"
 #include "mlir/IR/Action.h"
 #include "mlir/IR/Matchers.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/IR/Verifier.h"
 #include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Rewrite/PatternApplicator.h"
@@ -25,8 +26,10 @@
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/raw_ostream.h"
+#include <atomic>
 
 #ifdef MLIR_GREEDY_REWRITE_RANDOMIZER_SEED
 #include <random>
@@ -904,10 +907,41 @@ mlir::applyPatternsAndFoldGreedily(Region &region,
         "greedy pattern rewriter input IR failed to verify");
 #endif // MLIR_ENABLE_EXPENSIVE_PATTERN_API_CHECKS
 
+  // Simplify nested isolated-from-above ops concurrently first. The driver
+  // below processes them again, but usually finds little left to do. Its
+  // result alone tells whether the rewrite converged.
+  bool nestedChanged = false;
+  MLIRContext *ctx = region.getContext();
+  if (config.parallelizeIsolatedRegions && !config.listener &&
+      config.strictMode == GreedyRewriteStrictness::AnyOp &&
+      ctx->isMultithreadingEnabled()) {
+    SmallVector<Region *> nestedRegions;
+    for (Block &block : region)
+      for (Operation &op : block)
+        if (op.hasTrait<OpTrait::IsIsolatedFromAbove>())
+          for (Region &nested : op.getRegions())
+            if (!nested.empty())
+              nestedRegions.push_back(&nested);
+    if (nestedRegions.size() > 1) {
+      GreedyRewriteConfig nestedConfig = config;
+      nestedConfig.scope = nullptr;
+      std::atomic<bool> anyNestedChanged(false);
+      parallelForEach(ctx, nestedRegions, [&](Region *nested) {
+        bool regionChanged = false;
+        (void)applyPatternsAndFoldGreedily(*nested, patterns, nestedConfig,
+                                           &regionChanged);
+        if (regionChanged)
+          anyNestedChanged = true;
+      });
+      nestedChanged = anyNestedChanged;
+    }
+  }
+
   // Start the pattern driver.
-  RegionPatternRewriteDriver driver(region.getContext(), patterns, config,
-                                    region);
+  RegionPatternRewriteDriver driver(ctx, patterns, config, region);
   LogicalResult converged = std::move(driver).simplify(changed);
+  if (changed)
+    *changed |= nestedChanged;
   LLVM_DEBUG(if (failed(converged)) {
     llvm::dbgs() << "The pattern rewrite did not converge after scanning "
                  << config.maxIterations << " times\n";
@@ -1049,3 +1083,51 @@ LogicalResult mlir::applyOpPatternsAndFold(
   });
   return converged;
 }
+
+//===----------------------------------------------------------------------===//
+// GreedyRewriteProfiler
+//===----------------------------------------------------------------------===//
+
+void GreedyRewriteProfiler::notifyPatternBegin(const Pattern &pattern,
+                                               Operation *op) {
+  ++stats[&pattern].numAttempts;
+  start = std::chrono::steady_clock::now();
+}
+
+void GreedyRewriteProfiler::notifyPatternEnd(const Pattern &pattern,
+                                             LogicalResult status) {
+  PatternStats &entry = stats[&pattern];
+  entry.time += std::chrono::steady_clock::now() - start;
+  if (succeeded(status))
+    ++entry.numSuccesses;
+}
+
+void GreedyRewriteProfiler::print(raw_ostream &os) const {
+  auto getName = [](const Pattern *pattern) -> std::string {
+    if (!pattern->getDebugName().empty())
+      return pattern->getDebugName().str();
+    if (std::optional<OperationName> root = pattern->getRootKind())
+      return ("<unnamed> on '" + root->getStringRef() + "'").str();
+    return "<unnamed>";
+  };
+  SmallVector<std::pair<std::string, const PatternStats *>> sorted;
+  sorted.reserve(stats.size());
+  for (const auto &it : stats)
+    sorted.emplace_back(getName(it.first), &it.second);
+  llvm::sort(sorted, [](const auto &lhs, const auto &rhs) {
+    if (lhs.second->time != rhs.second->time)
+      return lhs.second->time > rhs.second->time;
+    return lhs.first < rhs.first;
+  });
+
+  os << llvm::format("%12s %10s %10s  %s\n", "time (ms)", "attempts",
+                     "successes", "pattern");
+  for (const auto &[name, entry] : sorted) {
+    double ms =
+        std::chrono::duration<double, std::milli>(entry->time).count();
+    os << llvm::format("%12.3f %10llu %10llu  ", ms,
+                       (unsigned long long)entry->numAttempts,
+                       (unsigned long long)entry->numSuccesses)
+       << name << "\n";
+  }
+}
@@ -53,6 +53,27 @@ TEST(OperandStorageTest, NonResizable) {
   useOp->destroy();
 }
 
+TEST(OperandStorageTest, AllocatedSize) {
+  MLIRContext context;
+  Builder builder(&context);
+
+  Operation *useOp =
+      createOp(&context, /*operands=*/std::nullopt, builder.getIntegerType(16));
+  Value operand = useOp->getResult(0);
+  Operation *user = createOp(&context, operand);
+  size_t inlineSize = user->getAllocatedSize();
+  EXPECT_GE(inlineSize, sizeof(Operation) + sizeof(OpOperand));
+  EXPECT_GT(useOp->getAllocatedSize(), sizeof(Operation));
+
+  // Growing the operands past the inline capacity allocates them separately.
+  user->setOperands({operand, operand, operand});
+  EXPECT_GE(user->getAllocatedSize(),
+            inlineSize - sizeof(OpOperand) + 3 * sizeof(OpOperand));
+
+  user->destroy();
+  useOp->destroy();
+}
+
 TEST(OperandStorageTest, Resizable) {
   MLIRContext context;
   Builder builder(&context);
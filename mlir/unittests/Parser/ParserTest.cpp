@@ -101,4 +101,91 @@ TEST(MLIRParser, ParseAttr) {
     EXPECT_EQ(attr, b.getI64IntegerAttr(9));
   }
 }
+
+/// Build a module with many functions, which is large enough to have its body
+/// parsed in parallel. Each function refers to a location alias that is only
+/// defined at the end of the file. 'prologue' and 'epilogue' are added at the
+/// start and the end of the body of the module.
+static std::string buildLargeModule(StringRef prologue = "",
+                                    StringRef epilogue = "") {
+  std::string moduleStr;
+  llvm::raw_string_ostream os(moduleStr);
+  os << "module {\n" << prologue;
+  for (unsigned i = 0; i < 2000; ++i) {
+    os << "  \"foo.func\"() ({\n"
+       << "    %c = \"foo.constant\"() {value = " << i
+       << " : i32} : () -> i32\n"
+       << "    \"foo.return\"(%c) : (i32) -> ()\n"
+       << "  }) {sym_name = \"f" << i << "\"} : () -> () loc(#loc" << i % 16
+       << ")\n";
+  }
+  os << epilogue << "}\n";
+  for (unsigned i = 0; i < 16; ++i)
+    os << "#loc" << i << " = loc(\"file.mlir\":" << i << ":1)\n";
+  return moduleStr;
+}
+
+/// Parse 'moduleStr' and print it back, with locations, or return an empty
+/// string if it failed to parse. The diagnostics are collected in
+/// 'diagnostics'.
+static std::string parseAndPrint(StringRef moduleStr, bool parseInParallel,
+                                 std::vector<std::string> &diagnostics) {
+  MLIRContext context;
+  context.allowUnregisteredDialects();
+  ScopedDiagnosticHandler handler(&context, [&](Diagnostic &d) {
+    llvm::raw_string_ostream(diagnostics.emplace_back())
+        << d.getLocation() << ": " << d;
+  });
+  ParserConfig config(&context);
+  config.setParseInParallel(parseInParallel);
+  OwningOpRef<ModuleOp> module = parseSourceString<ModuleOp>(moduleStr, config);
+  if (!module)
+    return "";
+  std::string result;
+  llvm::raw_string_ostream os(result);
+  module->print(os, OpPrintingFlags().enableDebugInfo());
+  return result;
+}
+
+TEST(MLIRParser, ParseInParallel) {
+  std::string moduleStr = buildLargeModule();
+  std::vector<std::string> serialDiagnostics, parallelDiagnostics;
+  std::string serial = parseAndPrint(moduleStr, /*parseInParallel=*/false,
+                                     serialDiagnostics);
+  std::string parallel = parseAndPrint(moduleStr, /*parseInParallel=*/true,
+                                       parallelDiagnostics);
+  ASSERT_FALSE(serial.empty());
+  EXPECT_EQ(serial, parallel);
+  EXPECT_TRUE(parallelDiagnostics.empty());
+}
+
+TEST(MLIRParser, ParseInParallelWithValuesAcrossChunks) {
+  // The value is defined in the first chunk and used in the last one, which
+  // cannot be parsed on its own, so the module is parsed serially instead.
+  std::string moduleStr =
+      buildLargeModule("  %def = \"foo.def\"() : () -> i32\n",
+                       "  \"foo.use\"(%def) : (i32) -> ()\n");
+  std::vector<std::string> serialDiagnostics, parallelDiagnostics;
+  std::string serial = parseAndPrint(moduleStr, /*parseInParallel=*/false,
+                                     serialDiagnostics);
+  std::string parallel = parseAndPrint(moduleStr, /*parseInParallel=*/true,
+                                       parallelDiagnostics);
+  ASSERT_FALSE(serial.empty());
+  EXPECT_EQ(serial, parallel);
+  EXPECT_TRUE(parallelDiagnostics.empty());
+}
+
+TEST(MLIRParser, ParseInParallelReportsErrorsOnce) {
+  std::string moduleStr =
+      buildLargeModule("", "  \"foo.use\"(%undefined) : (i32) -> ()\n");
+  std::vector<std::string> serialDiagnostics, parallelDiagnostics;
+  EXPECT_TRUE(parseAndPrint(moduleStr, /*parseInParallel=*/false,
+                            serialDiagnostics)
+                  .empty());
+  EXPECT_TRUE(parseAndPrint(moduleStr, /*parseInParallel=*/true,
+                            parallelDiagnostics)
+                  .empty());
+  ASSERT_EQ(serialDiagnostics.size(), 1u);
+  EXPECT_EQ(serialDiagnostics, parallelDiagnostics);
+}
 } // namespace
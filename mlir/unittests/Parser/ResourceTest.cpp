@@ -72,4 +72,37 @@ TEST(MLIRParser, ResourceKeyConflict) {
       "blob1_1: "
       "\"0x08000000040000000000000005000000000000000600000000000000\""));
 }
+
+TEST(MLIRParser, ResourceElidedAboveLimit) {
+  std::string moduleStr = R"mlir(
+    "test.use1"() {attr = #test.e1di64_elements<blob1> : tensor<3xi64> } : () -> ()
+
+    {-#
+      dialect_resources: {
+        test: {
+          blob1: "0x08000000010000000000000002000000000000000300000000000000"
+        }
+      }
+    #-}
+  )mlir";
+
+  MLIRContext context;
+  context.loadDialect<test::TestDialect>();
+  OwningOpRef<ModuleOp> module =
+      parseSourceString<ModuleOp>(moduleStr, &context);
+  ASSERT_TRUE(module);
+
+  auto print = [&](int64_t limit) {
+    std::string outputStr;
+    llvm::raw_string_ostream os(outputStr);
+    module->print(os, OpPrintingFlags().elideLargeResourceString(limit));
+    return outputStr;
+  };
+
+  // The printed blob, including its quotes, is exactly 60 characters long.
+  EXPECT_THAT(print(60),
+              ::testing::HasSubstr("blob1: \"0x0800000001000000000000000200000"
+                                   "0000000000300000000000000\""));
+  EXPECT_THAT(print(59), ::testing::Not(::testing::HasSubstr("blob1:")));
+}
 } // namespace
@@ -88,6 +88,47 @@ TEST(PassManagerTest, OpSpecificAnalysis) {
   }
 }
 
+/// Analysis that counts how often it is computed.
+struct CountingAnalysis {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(CountingAnalysis)
+
+  CountingAnalysis(Operation *) { ++numComputed; }
+  static inline unsigned numComputed = 0;
+};
+
+/// Simple pass that queries the counting analysis and preserves it.
+struct UseCountingAnalysisPass
+    : public PassWrapper<UseCountingAnalysisPass, OperationPass<ModuleOp>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(UseCountingAnalysisPass)
+
+  void runOnOperation() override {
+    (void)getAnalysis<CountingAnalysis>();
+    markAllAnalysesPreserved();
+  }
+};
+
+TEST(PassManagerTest, AnalysisManagerAcrossRuns) {
+  MLIRContext context;
+  OwningOpRef<ModuleOp> module(ModuleOp::create(UnknownLoc::get(&context)));
+  ModuleAnalysisManager am(module.get(), /*passInstrumentor=*/nullptr);
+  CountingAnalysis::numComputed = 0;
+
+  // Preserved analyses are reused by later runs, also of other pass managers.
+  for (int i = 0; i < 2; ++i) {
+    auto pm = PassManager::on<ModuleOp>(&context);
+    pm.addPass(std::make_unique<UseCountingAnalysisPass>());
+    EXPECT_TRUE(succeeded(pm.run(module.get(), am)));
+  }
+  EXPECT_EQ(CountingAnalysis::numComputed, 1u);
+
+  // Explicit invalidation drops them.
+  am.invalidate();
+  auto pm = PassManager::on<ModuleOp>(&context);
+  pm.addPass(std::make_unique<UseCountingAnalysisPass>());
+  EXPECT_TRUE(succeeded(pm.run(module.get(), am)));
+  EXPECT_EQ(CountingAnalysis::numComputed, 2u);
+}
+
 /// Simple pass to annotate a func::FuncOp with a single attribute `didProcess`.
 struct AddAttrFunctionPass
     : public PassWrapper<AddAttrFunctionPass, OperationPass<func::FuncOp>> {
@@ -58,3 +58,22 @@ TEST(StorageUniquerTest, NonTrivialDestructor) {
 
   EXPECT_TRUE(wasDestructed);
 }
+
+TEST(StorageUniquerTest, Statistics) {
+  struct IntStorage : public SimpleStorage<IntStorage, int> {
+    using Base::Base;
+  };
+
+  StorageUniquer uniquer;
+  uniquer.registerParametricStorageType<IntStorage>();
+  IntStorage *first = IntStorage::get(uniquer, 1);
+  IntStorage::get(uniquer, 2);
+
+  // The second lookup of an instance hits the thread-local cache and is not
+  // counted.
+  EXPECT_EQ(IntStorage::get(uniquer, 1), first);
+  StorageUniquer::Statistics stats = uniquer.getStatistics();
+  EXPECT_EQ(stats.numCreated, 2u);
+  EXPECT_EQ(stats.numSharedHits, 0u);
+  EXPECT_EQ(stats.numContendedLocks, 0u);
+}
@@ -83,4 +83,67 @@ TEST(CanonicalizerTest, TestDisablePatterns) {
   EXPECT_FALSE(module->lookupSymbol("A"));
 }
 
+TEST(CanonicalizerTest, TestParallelizeIsolatedRegions) {
+  MLIRContext context;
+  context.getOrLoadDialect<TestDialect>();
+
+  const char *const code = R"mlir(
+    module {
+      "test.foo"() {sym_name = "A"} : () -> ()
+    }
+    module {
+      "test.foo"() {sym_name = "B"} : () -> ()
+    }
+    "test.foo"() {sym_name = "C"} : () -> ()
+  )mlir";
+
+  OwningOpRef<ModuleOp> module = parseSourceString<ModuleOp>(code, &context);
+  ASSERT_TRUE(module);
+
+  RewritePatternSet patterns(&context);
+  patterns.add<EnabledPattern>(&context);
+  FrozenRewritePatternSet frozenPatterns(std::move(patterns));
+  GreedyRewriteConfig config;
+  config.parallelizeIsolatedRegions = true;
+  bool changed = false;
+  EXPECT_TRUE(succeeded(applyPatternsAndFoldGreedily(
+      module->getBodyRegion(), frozenPatterns, config, &changed)));
+  EXPECT_TRUE(changed);
+
+  unsigned numRemaining = 0;
+  module->walk([&](Operation *op) {
+    if (op->getName().getStringRef() == "test.foo")
+      ++numRemaining;
+  });
+  EXPECT_EQ(numRemaining, 0u);
+}
+
+TEST(CanonicalizerTest, TestProfiler) {
+  MLIRContext context;
+  context.getOrLoadDialect<TestDialect>();
+
+  const char *const code = R"mlir(
+    %0 = "test.foo"() : () -> (i32)
+    "test.foo"() : () -> ()
+  )mlir";
+
+  OwningOpRef<ModuleOp> module = parseSourceString<ModuleOp>(code, &context);
+  ASSERT_TRUE(module);
+
+  RewritePatternSet patterns(&context);
+  patterns.add<EnabledPattern>(&context);
+  FrozenRewritePatternSet frozenPatterns(std::move(patterns));
+  GreedyRewriteProfiler profiler;
+  GreedyRewriteConfig config;
+  config.listener = &profiler;
+  ASSERT_TRUE(succeeded(
+      applyPatternsAndFoldGreedily(*module, frozenPatterns, config)));
+
+  // The pattern fails to match the op with a result and erases the other one.
+  std::string report;
+  llvm::raw_string_ostream os(report);
+  profiler.print(os);
+  EXPECT_NE(os.str().find("EnabledPattern"), std::string::npos);
+}
+
 } // end anonymous namespace
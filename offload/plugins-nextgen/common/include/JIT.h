@@ -68,6 +68,19 @@ private:
   compile(const __tgt_device_image &Image, const std::string &ComputeUnitKind,
           PostProcessingFn PostProcessing);
 
+  /// Return the on-disk cache key of the device image that \p Image compiles
+  /// to for \p ComputeUnitKind. The key covers the IR and every option that
+  /// changes the generated code.
+  std::string getCacheKey(const __tgt_device_image &Image,
+                          const std::string &ComputeUnitKind) const;
+
+  /// Return the device image for \p Image from the on-disk cache, or compile
+  /// it with \p PostProcessing and add it to the cache.
+  Expected<std::unique_ptr<MemoryBuffer>>
+  getOrCreateCachedImage(const __tgt_device_image &Image, LLVMContext &Ctx,
+                         const std::string &ComputeUnitKind,
+                         PostProcessingFn PostProcessing);
+
   /// Create or retrieve the object image file from the file system or via
   /// compilation of the \p Image.
   Expected<std::unique_ptr<MemoryBuffer>>
@@ -116,6 +129,9 @@ private:
       StringEnvar("LIBOMPTARGET_JIT_POST_OPT_IR_MODULE");
   UInt32Envar JITOptLevel = UInt32Envar("LIBOMPTARGET_JIT_OPT_LEVEL", 3);
   BoolEnvar JITSkipOpt = BoolEnvar("LIBOMPTARGET_JIT_SKIP_OPT", false);
+  StringEnvar JITCacheDir = StringEnvar("LIBOMPTARGET_JIT_CACHE_DIR");
+  UInt64Envar JITCacheSize =
+      UInt64Envar("LIBOMPTARGET_JIT_CACHE_SIZE", 1024 * 1024 * 1024);
 };
 
 } // namespace target
@@ -11,11 +11,13 @@
 #ifndef OPENMP_LIBOMPTARGET_PLUGINS_NEXTGEN_COMMON_PLUGININTERFACE_H
 #define OPENMP_LIBOMPTARGET_PLUGINS_NEXTGEN_COMMON_PLUGININTERFACE_H
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <list>
 #include <map>
+#include <mutex>
 #include <shared_mutex>
 #include <vector>
 
@@ -36,6 +38,7 @@
 #endif
 
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Frontend/OpenMP/OMPConstants.h"
 #include "llvm/Frontend/OpenMP/OMPGridValues.h"
 #include "llvm/Support/Allocator.h"
@@ -604,6 +607,39 @@ public:
   }
 };
 
+/// Counters of the allocations and data transfers a device has served. They
+/// are printed when the device is deinitialized if the environment variable
+/// LIBOMPTARGET_DEVICE_STATISTICS is set.
+struct DeviceStatisticsTy {
+  std::atomic<uint64_t> NumAllocations = 0;
+  std::atomic<uint64_t> BytesAllocated = 0;
+  std::atomic<uint64_t> NumDeallocations = 0;
+  std::atomic<uint64_t> NumSubmits = 0;
+  std::atomic<uint64_t> BytesSubmitted = 0;
+  /// Bytes submitted from pageable host memory through pinned staging buffers.
+  std::atomic<uint64_t> BytesStaged = 0;
+  std::atomic<uint64_t> NumRetrieves = 0;
+  std::atomic<uint64_t> BytesRetrieved = 0;
+  std::atomic<uint64_t> NumExchanges = 0;
+  std::atomic<uint64_t> BytesExchanged = 0;
+
+  /// Host time spent in the launches of one kernel, from the launch request
+  /// until the launch is enqueued on the device.
+  struct KernelLaunchesTy {
+    uint64_t NumLaunches = 0;
+    uint64_t Nanoseconds = 0;
+    uint64_t MaxNanoseconds = 0;
+  };
+  llvm::StringMap<KernelLaunchesTy> KernelLaunches;
+  std::mutex KernelLaunchesMutex;
+
+  /// Record a launch of the kernel \p Name that took \p Nanoseconds.
+  void addKernelLaunch(StringRef Name, uint64_t Nanoseconds);
+
+  /// Print the counters of the device \p DeviceId.
+  void print(int32_t DeviceId);
+};
+
 /// Class implementing common functionalities of offload devices. Each plugin
 /// should define the specific device class, derive from this generic one, and
 /// implement the necessary virtual function members.
@@ -904,6 +940,15 @@ private:
   UInt32Envar OMPX_MinThreadsForLowTripCount =
       UInt32Envar("LIBOMPTARGET_MIN_THREADS_FOR_LOW_TRIP_COUNT", 32);
 
+  /// Environment flag to print the allocation and transfer statistics of the
+  /// device when it is deinitialized.
+  BoolEnvar OMPX_PrintStatistics =
+      BoolEnvar("LIBOMPTARGET_DEVICE_STATISTICS", false);
+
+  /// Environment flag to print the host latency of every kernel launch.
+  BoolEnvar OMPX_TraceKernelLaunches =
+      BoolEnvar("LIBOMPTARGET_KERNEL_LAUNCH_TRACE", false);
+
 protected:
   /// Environment variables defined by the LLVM OpenMP implementation
   /// regarding the initial number of streams and events.
@@ -938,6 +983,9 @@ protected:
   /// Map of host pinned allocations used for optimize device transfers.
   PinnedAllocationMapTy PinnedAllocs;
 
+  /// Allocation and transfer counters of the device.
+  DeviceStatisticsTy Statistics;
+
   /// A pointer to an RPC server instance attached to this device if present.
   /// This is used to run the RPC server during task synchronization.
   RPCServerTy *RPCServer;
@@ -17,8 +17,10 @@
 #include "omptarget.h"
 
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/CodeGen/CommandFlags.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/LLVMRemarkStreamer.h"
 #include "llvm/IR/LegacyPassManager.h"
@@ -28,7 +30,10 @@
 #include "llvm/Object/IRObjectFile.h"
 #include "llvm/Passes/OptimizationLevel.h"
 #include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/Caching.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -282,6 +287,94 @@ JITEngine::getOrCreateObjFile(const __tgt_device_image &Image, LLVMContext &Ctx,
   return backend(*Mod, ComputeUnitKind, JITOptLevel);
 }
 
+std::string JITEngine::getCacheKey(const __tgt_device_image &Image,
+                                   const std::string &ComputeUnitKind) const {
+  StringRef Binary(reinterpret_cast<const char *>(Image.ImageStart),
+                   target::getPtrDiff(Image.ImageEnd, Image.ImageStart));
+
+  // Separate the fields so that adjacent strings cannot run into each other.
+  SHA1 Hasher;
+  auto AddString = [&](StringRef Str) {
+    Hasher.update(Str);
+    Hasher.update(ArrayRef<uint8_t>{0});
+  };
+  AddString(LLVM_VERSION_STRING);
+  AddString(TT.str());
+  AddString(ComputeUnitKind);
+  AddString(utostr(JITOptLevel.get()));
+  AddString(JITSkipOpt ? "skip-opt" : "opt");
+  Hasher.update(Binary);
+
+  return toHex(Hasher.result());
+}
+
+Expected<std::unique_ptr<MemoryBuffer>>
+JITEngine::getOrCreateCachedImage(const __tgt_device_image &Image,
+                                  LLVMContext &Ctx,
+                                  const std::string &ComputeUnitKind,
+                                  PostProcessingFn PostProcessing) {
+  auto Compile = [&]() -> Expected<std::unique_ptr<MemoryBuffer>> {
+    auto ObjMBOrErr = getOrCreateObjFile(Image, Ctx, ComputeUnitKind);
+    if (!ObjMBOrErr)
+      return ObjMBOrErr.takeError();
+    return PostProcessing(std::move(*ObjMBOrErr));
+  };
+
+  // The replacement and IR dump options exist to inspect the compilation, so
+  // they always bypass the cache.
+  if (!JITCacheDir.isPresent() || JITCacheDir.get().empty() ||
+      ReplacementObjectFileName.isPresent() ||
+      ReplacementModuleFileName.isPresent() ||
+      PreOptIRModuleFileName.isPresent() || PostOptIRModuleFileName.isPresent())
+    return Compile();
+
+  std::unique_ptr<MemoryBuffer> CachedMB;
+  auto CacheOrErr = localCache(
+      "JIT", "omptarget-jit", JITCacheDir.get(),
+      [&](size_t, const Twine &, std::unique_ptr<MemoryBuffer> MB) {
+        CachedMB = std::move(MB);
+      });
+  if (!CacheOrErr)
+    return CacheOrErr.takeError();
+
+  std::string Key = getCacheKey(Image, ComputeUnitKind);
+  auto AddStreamOrErr = (*CacheOrErr)(/*Task=*/0, Key, ComputeUnitKind);
+  if (!AddStreamOrErr)
+    return AddStreamOrErr.takeError();
+
+  if (!*AddStreamOrErr) {
+    DP("JIT cache hit for %s image %s\n", ComputeUnitKind.c_str(),
+       Key.c_str());
+    return std::move(CachedMB);
+  }
+  DP("JIT cache miss for %s image %s\n", ComputeUnitKind.c_str(),
+     Key.c_str());
+
+  auto ImageMBOrErr = Compile();
+  if (!ImageMBOrErr)
+    return ImageMBOrErr.takeError();
+
+  // A failure to write the cache entry only costs the next run a compilation.
+  auto StreamOrErr = (*AddStreamOrErr)(/*Task=*/0, ComputeUnitKind);
+  if (!StreamOrErr) {
+    DP("Failed to add JIT image to the cache: %s\n",
+       toString(StreamOrErr.takeError()).c_str());
+    return ImageMBOrErr;
+  }
+  *(*StreamOrErr)->OS << (*ImageMBOrErr)->getBuffer();
+  StreamOrErr->reset();
+
+  // Keep the cache directory within its size bound, evicting the least
+  // recently used images first.
+  CachePruningPolicy Policy;
+  Policy.Interval = std::chrono::seconds(0);
+  Policy.Expiration = std::chrono::seconds(0);
+  Policy.MaxSizeBytes = JITCacheSize;
+  pruneCache(JITCacheDir.get(), Policy);
+
+  return ImageMBOrErr;
+}
+
 Expected<const __tgt_device_image *>
 JITEngine::compile(const __tgt_device_image &Image,
                    const std::string &ComputeUnitKind,
@@ -293,11 +386,8 @@ JITEngine::compile(const __tgt_device_image &Image,
   if (__tgt_device_image *JITedImage = CUI.TgtImageMap.lookup(&Image))
     return JITedImage;
 
-  auto ObjMBOrErr = getOrCreateObjFile(Image, CUI.Context, ComputeUnitKind);
-  if (!ObjMBOrErr)
-    return ObjMBOrErr.takeError();
-
-  auto ImageMBOrErr = PostProcessing(std::move(*ObjMBOrErr));
+  auto ImageMBOrErr = getOrCreateCachedImage(Image, CUI.Context,
+                                              ComputeUnitKind, PostProcessing);
   if (!ImageMBOrErr)
     return ImageMBOrErr.takeError();
 
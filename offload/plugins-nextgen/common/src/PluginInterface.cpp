@@ -31,7 +31,10 @@
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 
+#include <chrono>
+#include <cinttypes>
 #include <cstdint>
+#include <cstdio>
 #include <limits>
 
 using namespace llvm;
@@ -798,6 +801,46 @@ Error GenericDeviceTy::init(GenericPluginTy &Plugin) {
   return Plugin::success();
 }
 
+void DeviceStatisticsTy::addKernelLaunch(StringRef Name,
+                                         uint64_t Nanoseconds) {
+  std::lock_guard<std::mutex> Lock(KernelLaunchesMutex);
+  KernelLaunchesTy &Launches = KernelLaunches[Name];
+  ++Launches.NumLaunches;
+  Launches.Nanoseconds += Nanoseconds;
+  Launches.MaxNanoseconds = std::max(Launches.MaxNanoseconds, Nanoseconds);
+}
+
+void DeviceStatisticsTy::print(int32_t DeviceId) {
+  fprintf(stderr,
+          "\n|-----------------------\n"
+          "| Device %d statistics:\n"
+          "|-----------------------\n"
+          "| #Allocations: %" PRIu64 " (%" PRIu64 " bytes)\n"
+          "| #Deallocations: %" PRIu64 "\n"
+          "| #Host to device: %" PRIu64 " (%" PRIu64 " bytes, %" PRIu64
+          " staged)\n"
+          "| #Device to host: %" PRIu64 " (%" PRIu64 " bytes)\n"
+          "| #Device to device: %" PRIu64 " (%" PRIu64 " bytes)\n"
+          "|-----------------------\n\n",
+          DeviceId, NumAllocations.load(), BytesAllocated.load(),
+          NumDeallocations.load(), NumSubmits.load(), BytesSubmitted.load(),
+          BytesStaged.load(), NumRetrieves.load(), BytesRetrieved.load(),
+          NumExchanges.load(), BytesExchanged.load());
+
+  std::lock_guard<std::mutex> Lock(KernelLaunchesMutex);
+  if (KernelLaunches.empty())
+    return;
+  fprintf(stderr, "| Kernel launches (host latency):\n");
+  for (const auto &[Name, Launches] : KernelLaunches)
+    fprintf(stderr,
+            "| %s: %" PRIu64 " launches, avg %" PRIu64 " ns, max %" PRIu64
+            " ns\n",
+            Name.str().c_str(), Launches.NumLaunches,
+            Launches.Nanoseconds / Launches.NumLaunches,
+            Launches.MaxNanoseconds);
+  fprintf(stderr, "|-----------------------\n\n");
+}
+
 Error GenericDeviceTy::deinit(GenericPluginTy &Plugin) {
   for (DeviceImageTy *Image : LoadedImages)
     if (auto Err = callGlobalDestructors(Plugin, *Image))
@@ -833,6 +876,9 @@ Error GenericDeviceTy::deinit(GenericPluginTy &Plugin) {
            DeviceMemoryPoolTracking.AllocationMax);
   }
 
+  if (OMPX_PrintStatistics)
+    Statistics.print(DeviceId);
+
   // Delete the memory manager before deinitializing the device. Otherwise,
   // we may delete device allocations after the device is deinitialized.
   if (MemoryManager)
@@ -1339,6 +1385,8 @@ Expected<void *> GenericDeviceTy::dataAlloc(int64_t Size, void *HostPtr,
     if (auto Err = PinnedAllocs.registerHostBuffer(Alloc, Alloc, Size))
       return std::move(Err);
 
+  Statistics.NumAllocations.fetch_add(1, std::memory_order_relaxed);
+  Statistics.BytesAllocated.fetch_add(Size, std::memory_order_relaxed);
   return Alloc;
 }
 
@@ -1361,11 +1409,15 @@ Error GenericDeviceTy::dataDelete(void *TgtPtr, TargetAllocTy Kind) {
     if (auto Err = PinnedAllocs.unregisterHostBuffer(TgtPtr))
       return Err;
 
+  Statistics.NumDeallocations.fetch_add(1, std::memory_order_relaxed);
   return Plugin::success();
 }
 
 Error GenericDeviceTy::dataSubmit(void *TgtPtr, const void *HstPtr,
                                   int64_t Size, __tgt_async_info *AsyncInfo) {
+  Statistics.NumSubmits.fetch_add(1, std::memory_order_relaxed);
+  Statistics.BytesSubmitted.fetch_add(Size, std::memory_order_relaxed);
+
   AsyncInfoWrapperTy AsyncInfoWrapper(*this, AsyncInfo);
 
   auto Err = dataSubmitImpl(TgtPtr, HstPtr, Size, AsyncInfoWrapper);
@@ -1375,6 +1427,9 @@ Error GenericDeviceTy::dataSubmit(void *TgtPtr, const void *HstPtr,
 
 Error GenericDeviceTy::dataRetrieve(void *HstPtr, const void *TgtPtr,
                                     int64_t Size, __tgt_async_info *AsyncInfo) {
+  Statistics.NumRetrieves.fetch_add(1, std::memory_order_relaxed);
+  Statistics.BytesRetrieved.fetch_add(Size, std::memory_order_relaxed);
+
   AsyncInfoWrapperTy AsyncInfoWrapper(*this, AsyncInfo);
 
   auto Err = dataRetrieveImpl(HstPtr, TgtPtr, Size, AsyncInfoWrapper);
@@ -1385,6 +1440,9 @@ Error GenericDeviceTy::dataRetrieve(void *HstPtr, const void *TgtPtr,
 Error GenericDeviceTy::dataExchange(const void *SrcPtr, GenericDeviceTy &DstDev,
                                     void *DstPtr, int64_t Size,
                                     __tgt_async_info *AsyncInfo) {
+  Statistics.NumExchanges.fetch_add(1, std::memory_order_relaxed);
+  Statistics.BytesExchanged.fetch_add(Size, std::memory_order_relaxed);
+
   AsyncInfoWrapperTy AsyncInfoWrapper(*this, AsyncInfo);
 
   auto Err = dataExchangeImpl(SrcPtr, DstDev, DstPtr, Size, AsyncInfoWrapper);
@@ -1402,9 +1460,27 @@ Error GenericDeviceTy::launchKernel(void *EntryPtr, void **ArgPtrs,
   GenericKernelTy &GenericKernel =
       *reinterpret_cast<GenericKernelTy *>(EntryPtr);
 
+  // Only read the clock if someone looks at the launch latency.
+  bool TimeLaunch = OMPX_PrintStatistics || OMPX_TraceKernelLaunches;
+  std::chrono::steady_clock::time_point LaunchStart;
+  if (TimeLaunch)
+    LaunchStart = std::chrono::steady_clock::now();
+
   auto Err = GenericKernel.launch(*this, ArgPtrs, ArgOffsets, KernelArgs,
                                   AsyncInfoWrapper);
 
+  if (TimeLaunch && !Err) {
+    uint64_t Nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - LaunchStart)
+            .count();
+    if (OMPX_TraceKernelLaunches)
+      fprintf(stderr, "Device %d launched kernel %s in %" PRIu64 " ns\n",
+              DeviceId, GenericKernel.getName(), Nanoseconds);
+    if (OMPX_PrintStatistics)
+      Statistics.addKernelLaunch(GenericKernel.getName(), Nanoseconds);
+  }
+
   // 'finalize' here to guarantee next record-replay actions are in-sync
   AsyncInfoWrapper.finalize(Err);
 
@@ -12,7 +12,9 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <cuda.h>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -251,12 +253,108 @@ private:
   HandleTy Event;
 };
 
+/// Ring of pinned host buffers used to stage host to device transfers from
+/// pageable memory. A copy from pageable memory makes the CUDA driver block
+/// the calling thread until the copy is done. Copying the data into a pinned
+/// buffer instead lets the transfer run asynchronously on the stream, and
+/// large transfers are split over the buffers, so the host copy of the next
+/// piece overlaps with the DMA of the previous one.
+struct CUDAStagingRingTy {
+  /// Number of staging buffers in the ring.
+  static constexpr uint32_t NumSlots = 4;
+
+  /// Allocate the staging buffers of \p SlotSize bytes each.
+  Error init(size_t SlotSize) {
+    for (SlotTy &Slot : Slots) {
+      CUresult Res = cuMemAllocHost(&Slot.Buffer, SlotSize);
+      if (auto Err = Plugin::check(Res, "Error in cuMemAllocHost: %s"))
+        return Err;
+
+      Res = cuEventCreate(&Slot.Event, CU_EVENT_DISABLE_TIMING);
+      if (auto Err = Plugin::check(Res, "Error in cuEventCreate: %s"))
+        return Err;
+    }
+    this->SlotSize = SlotSize;
+    return Plugin::success();
+  }
+
+  /// Release the staging buffers once the pending copies are done.
+  Error deinit() {
+    for (SlotTy &Slot : Slots) {
+      if (Slot.Event) {
+        CUresult Res = cuEventSynchronize(Slot.Event);
+        if (auto Err = Plugin::check(Res, "Error in cuEventSynchronize: %s"))
+          return Err;
+
+        Res = cuEventDestroy(Slot.Event);
+        if (auto Err = Plugin::check(Res, "Error in cuEventDestroy: %s"))
+          return Err;
+        Slot.Event = nullptr;
+      }
+      if (Slot.Buffer) {
+        CUresult Res = cuMemFreeHost(Slot.Buffer);
+        if (auto Err = Plugin::check(Res, "Error in cuMemFreeHost: %s"))
+          return Err;
+        Slot.Buffer = nullptr;
+      }
+    }
+    SlotSize = 0;
+    return Plugin::success();
+  }
+
+  /// Whether the staging buffers are available.
+  bool isEnabled() const { return SlotSize > 0; }
+
+  /// Copy \p Size bytes from \p HstPtr to \p TgtPtr on \p Stream through the
+  /// staging buffers. The host buffer can be reused as soon as this returns.
+  Error submit(CUdeviceptr TgtPtr, const void *HstPtr, size_t Size,
+               CUstream Stream) {
+    // Copies from different threads wait for each other here, as they would
+    // in the driver when copying from pageable memory.
+    std::lock_guard<std::mutex> Lock(Mutex);
+    for (size_t Offset = 0; Offset < Size; Offset += SlotSize) {
+      size_t PieceSize = std::min(SlotSize, Size - Offset);
+      SlotTy &Slot = Slots[Next];
+      Next = (Next + 1) % NumSlots;
+
+      // Wait for the previous copy out of this buffer. An event that was
+      // never recorded is complete already.
+      CUresult Res = cuEventSynchronize(Slot.Event);
+      if (auto Err = Plugin::check(Res, "Error in cuEventSynchronize: %s"))
+        return Err;
+
+      std::memcpy(Slot.Buffer, advanceVoidPtr(HstPtr, Offset), PieceSize);
+      Res = cuMemcpyHtoDAsync(TgtPtr + Offset, Slot.Buffer, PieceSize, Stream);
+      if (auto Err = Plugin::check(Res, "Error in cuMemcpyHtoDAsync: %s"))
+        return Err;
+
+      Res = cuEventRecord(Slot.Event, Stream);
+      if (auto Err = Plugin::check(Res, "Error in cuEventRecord: %s"))
+        return Err;
+    }
+    return Plugin::success();
+  }
+
+private:
+  struct SlotTy {
+    void *Buffer = nullptr;
+    CUevent Event = nullptr;
+  };
+
+  SlotTy Slots[NumSlots];
+  size_t SlotSize = 0;
+  uint32_t Next = 0;
+  std::mutex Mutex;
+};
+
 /// Class implementing the CUDA device functionalities which derives from the
 /// generic device class.
 struct CUDADeviceTy : public GenericDeviceTy {
   // Create a CUDA device with a device id and the default CUDA grid values.
   CUDADeviceTy(GenericPluginTy &Plugin, int32_t DeviceId, int32_t NumDevices)
       : GenericDeviceTy(Plugin, DeviceId, NumDevices, NVPTXGridValues),
+        OMPX_StagingBufferSize("LIBOMPTARGET_CUDA_STAGING_BUFFER_SIZE",
+                               1024 * 1024),
         CUDAStreamManager(*this), CUDAEventManager(*this) {}
 
   ~CUDADeviceTy() {}
@@ -311,6 +409,11 @@ struct CUDADeviceTy : public GenericDeviceTy {
     if (auto Err = CUDAEventManager.init(OMPX_InitialNumEvents))
       return Err;
 
+    // Allocate the pinned buffers that stage copies from pageable memory.
+    if (OMPX_StagingBufferSize > 0)
+      if (auto Err = StagingRing.init(OMPX_StagingBufferSize))
+        return Err;
+
     // Query attributes to determine number of threads/block and blocks/grid.
     if (auto Err = getDeviceAttr(CU_DEVICE_ATTRIBUTE_MAX_GRID_DIM_X,
                                  GridValues.GV_Max_Teams))
@@ -363,6 +466,9 @@ struct CUDADeviceTy : public GenericDeviceTy {
     if (auto Err = CUDAEventManager.deinit())
       return Err;
 
+    if (auto Err = StagingRing.deinit())
+      return Err;
+
     // Close modules if necessary.
     if (!LoadedImages.empty()) {
       assert(Context && "Invalid CUDA context");
@@ -809,6 +915,13 @@ struct CUDADeviceTy : public GenericDeviceTy {
     if (auto Err = getStream(AsyncInfoWrapper, Stream))
       return Err;
 
+    // Copies from pageable memory block the host in the driver. Stage them
+    // through pinned buffers so they stay asynchronous.
+    if (StagingRing.isEnabled() && !PinnedAllocs.isHostPinnedBuffer(HstPtr)) {
+      Statistics.BytesStaged.fetch_add(Size, std::memory_order_relaxed);
+      return StagingRing.submit((CUdeviceptr)TgtPtr, HstPtr, Size, Stream);
+    }
+
     CUresult Res = cuMemcpyHtoDAsync((CUdeviceptr)TgtPtr, HstPtr, Size, Stream);
     return Plugin::check(Res, "Error in cuMemcpyHtoDAsync: %s");
   }
@@ -1242,12 +1355,19 @@ private:
     return Err;
   }
 
+  /// Envar for the size of every pinned buffer used to stage host to device
+  /// copies from pageable memory. A size of zero disables the staging.
+  UInt64Envar OMPX_StagingBufferSize;
+
   /// Stream manager for CUDA streams.
   CUDAStreamManagerTy CUDAStreamManager;
 
   /// Event manager for CUDA events.
   CUDAEventManagerTy CUDAEventManager;
 
+  /// Pinned buffers staging host to device copies from pageable memory.
+  CUDAStagingRingTy StagingRing;
+
   /// The device's context. This context should be set before performing
   /// operations on the device.
   CUcontext Context = nullptr;
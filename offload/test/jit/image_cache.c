@@ -0,0 +1,32 @@
+// clang-format off
+// RUN: %libomptarget-compileopt-generic -fopenmp-target-jit
+// RUN: rm -rf %t.cache
+// RUN: env LIBOMPTARGET_JIT_CACHE_DIR=%t.cache                \
+// RUN:     %libomptarget-run-generic | %fcheck-generic
+// RUN: ls %t.cache | %fcheck-plain-generic --check-prefix=CACHE
+// RUN: env LIBOMPTARGET_JIT_CACHE_DIR=%t.cache                \
+// RUN:     %libomptarget-run-generic | %fcheck-generic
+// clang-format on
+
+// UNSUPPORTED: aarch64-unknown-linux-gnu
+// UNSUPPORTED: aarch64-unknown-linux-gnu-LTO
+// UNSUPPORTED: x86_64-pc-linux-gnu
+// UNSUPPORTED: x86_64-pc-linux-gnu-LTO
+// UNSUPPORTED: s390x-ibm-linux-gnu
+// UNSUPPORTED: s390x-ibm-linux-gnu-LTO
+
+// The first run compiles the image and stores it in the cache, the second run
+// loads it from there.
+//
+// CACHE: llvmcache-
+
+#include <stdio.h>
+
+int main() {
+  int N = 0;
+#pragma omp target map(tofrom : N)
+  N = 42;
+  // CHECK: N = 42
+  printf("N = %d\n", N);
+  return 0;
+}
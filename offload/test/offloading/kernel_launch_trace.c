@@ -0,0 +1,35 @@
+// RUN: %libomptarget-compile-generic
+// RUN: env LIBOMPTARGET_KERNEL_LAUNCH_TRACE=1 \
+// RUN:   %libomptarget-run-generic 2>&1 | %fcheck-generic --check-prefix=TRACE
+// RUN: env LIBOMPTARGET_DEVICE_STATISTICS=1 \
+// RUN:   %libomptarget-run-generic 2>&1 | %fcheck-generic --check-prefix=STATS
+
+// UNSUPPORTED: aarch64-unknown-linux-gnu
+// UNSUPPORTED: aarch64-unknown-linux-gnu-LTO
+// UNSUPPORTED: x86_64-pc-linux-gnu
+// UNSUPPORTED: x86_64-pc-linux-gnu-LTO
+// UNSUPPORTED: s390x-ibm-linux-gnu
+// UNSUPPORTED: s390x-ibm-linux-gnu-LTO
+
+// Check that every kernel launch is traced and that the device statistics
+// summarize the launches per kernel.
+
+#include <stdio.h>
+
+int main() {
+  int N = 0;
+  for (int I = 0; I < 3; ++I) {
+#pragma omp target map(tofrom : N)
+    ++N;
+  }
+
+  // TRACE-COUNT-3: Device {{[0-9]+}} launched kernel __omp_offloading_{{.*}}main{{.*}} in {{[0-9]+}} ns
+  // TRACE: N = 3
+  // STATS: N = 3
+  printf("N = %d\n", N);
+  fflush(stdout);
+
+  // STATS: Kernel launches (host latency):
+  // STATS: __omp_offloading_{{.*}}main{{.*}}: 3 launches, avg {{[0-9]+}} ns, max {{[0-9]+}} ns
+  return N != 3;
+}
@@ -0,0 +1,47 @@
+// RUN: %libomptarget-compile-generic
+// RUN: env LIBOMPTARGET_DEVICE_STATISTICS=1 \
+// RUN:   %libomptarget-run-generic 2>&1 | %fcheck-generic
+// RUN: env LIBOMPTARGET_CUDA_STAGING_BUFFER_SIZE=0 \
+// RUN:   %libomptarget-run-generic 2>&1 | %fcheck-generic --check-prefix=SUM
+// RUN: env LIBOMPTARGET_CUDA_STAGING_BUFFER_SIZE=4096 \
+// RUN:   %libomptarget-run-generic 2>&1 | %fcheck-generic --check-prefix=SUM
+
+// Check that host to device copies from pageable memory reach the device
+// intact, whether they fit a staging buffer, span several of them or wrap
+// around the ring, and that the device statistics count them.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N (3 * 1024 * 1024 + 17)
+
+int main() {
+  int *Data = (int *)malloc(N * sizeof(int));
+  for (int I = 0; I < N; ++I)
+    Data[I] = I % 1000;
+
+  long long Sum = 0;
+  for (int Rep = 0; Rep < 4; ++Rep) {
+#pragma omp target map(to : Data[0 : N]) map(tofrom : Sum)
+    for (int I = 0; I < N; ++I)
+      Sum += Data[I];
+    // Change the host data right away, the previous copy must not see it.
+    for (int I = 0; I < N; ++I)
+      Data[I] = (Data[I] + 1) % 1000;
+  }
+
+  long long Expected = 0;
+  for (int Rep = 0; Rep < 4; ++Rep)
+    for (int I = 0; I < N; ++I)
+      Expected += (I + Rep) % 1000;
+
+  // SUM: OK
+  // CHECK: OK
+  printf("%s\n", Sum == Expected ? "OK" : "FAIL");
+  fflush(stdout);
+  free(Data);
+
+  // CHECK: Device {{[0-9]+}} statistics:
+  // CHECK: #Host to device: {{[1-9][0-9]*}} ({{[1-9][0-9]*}} bytes
+  return Sum != Expected;
+}
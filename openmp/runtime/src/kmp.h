@@ -1878,7 +1878,8 @@ typedef struct kmp_sched_flags {
   unsigned contains_last : 1;
   unsigned use_hier : 1; // Used in KMP_USE_HIER_SCHED code
   unsigned use_hybrid : 1; // Used in KMP_WEIGHTED_ITERATIONS_SUPPORTED code
-  unsigned unused : 27;
+  unsigned use_adaptive : 1; // schedule(auto) with KMP_SCHEDULE=auto,adaptive
+  unsigned unused : 26;
 } kmp_sched_flags_t;
 
 KMP_BUILD_ASSERT(sizeof(kmp_sched_flags_t) == 4);
@@ -2054,6 +2055,10 @@ typedef struct dispatch_shared_info {
   volatile kmp_int32 doacross_buf_idx; // teamwise index
   volatile kmp_uint32 *doacross_flags; // shared array of iteration flags (0/1)
   kmp_int32 doacross_num_done; // count finished threads
+  // Adaptive schedule(auto) only, see __kmp_adaptive_chunk()
+  volatile kmp_int64 adaptive_chunks; // chunks per thread of this loop
+  volatile kmp_int64 adaptive_start; // when the first thread started
+  volatile kmp_int64 adaptive_first_done; // when the first thread ran dry
 #if KMP_USE_HIER_SCHED
   void *hier;
 #endif
@@ -2424,6 +2429,10 @@ extern kmp_tasking_mode_t
     __kmp_tasking_mode; /* determines how/when to execute tasks */
 extern int __kmp_task_stealing_constraint;
 extern int __kmp_enable_task_throttling;
+extern int __kmp_task_steal_local_tries;
+#if KMP_AFFINITY_SUPPORTED
+extern kmp_hw_t __kmp_task_steal_domain;
+#endif
 extern kmp_int32 __kmp_default_device; // Set via OMP_DEFAULT_DEVICE if
 // specified, defaults to 0 otherwise
 // Set via OMP_MAX_TASK_PRIORITY if specified, defaults to 0 otherwise
@@ -3373,6 +3382,8 @@ extern char const *__kmp_barrier_branch_bit_env_name[bs_last_barrier];
 extern char const *__kmp_barrier_pattern_env_name[bs_last_barrier];
 extern char const *__kmp_barrier_type_name[bs_last_barrier];
 extern char const *__kmp_barrier_pattern_name[bp_last_bar];
+extern int __kmp_barrier_auto; /* pick barrier patterns from the topology */
+extern int __kmp_env_barrier; /* was KMP_*_BARRIER[_PATTERN] specified? */
 
 /* Global Locks */
 extern kmp_bootstrap_lock_t __kmp_initz_lock; /* control initialization */
@@ -3398,6 +3409,7 @@ extern enum sched_type __kmp_sched; /* default runtime scheduling */
 extern enum sched_type __kmp_static; /* default static scheduling method */
 extern enum sched_type __kmp_guided; /* default guided scheduling method */
 extern enum sched_type __kmp_auto; /* default auto scheduling method */
+extern int __kmp_auto_adaptive; /* tune schedule(auto) from loop timings */
 extern int __kmp_chunk; /* default runtime chunk size */
 extern int __kmp_force_monotonic; /* whether monotonic scheduling forced */
 
@@ -168,6 +168,103 @@ enum { // values for steal_flag (possible states of private per-loop buffer)
   // 3 -> 2 owner only, async
   // 3 -> 0 last thread finishing the loop, async
 };
+
+// Adaptive schedule(auto), enabled with KMP_SCHEDULE=auto,adaptive.
+// The loop runs as static steal with a chunk size of
+// tc / (nproc * chunks per thread). When the loop completes, the time between
+// the first thread running out of work and the last one is compared with the
+// time the loop took. A large gap means the chunks were too coarse to balance
+// the iterations, a tiny gap means they are finer than needed. The number of
+// chunks per thread is doubled or halved accordingly and remembered for the
+// loop location, so the next execution of the loop starts from there.
+#define KMP_ADAPTIVE_LOOPS 256 // power of two
+#define KMP_ADAPTIVE_PROBES 8
+#define KMP_ADAPTIVE_MIN_CHUNKS 1
+#define KMP_ADAPTIVE_MAX_CHUNKS 1024
+#define KMP_ADAPTIVE_INIT_CHUNKS 8
+
+typedef struct kmp_adaptive_loop {
+  std::atomic<ident_t *> loc;
+  std::atomic<kmp_int32> chunks; // chunks per thread
+} kmp_adaptive_loop_t;
+
+static kmp_adaptive_loop_t __kmp_adaptive_loops[KMP_ADAPTIVE_LOOPS];
+
+// Returns the entry remembered for loc, creating it if needed, or NULL when
+// the table has no room left for loc.
+static kmp_adaptive_loop_t *__kmp_adaptive_find(ident_t *loc) {
+  if (loc == NULL)
+    return NULL;
+  kmp_uintptr_t hash = (kmp_uintptr_t)loc;
+  hash ^= hash >> 12;
+  for (int i = 0; i < KMP_ADAPTIVE_PROBES; ++i) {
+    kmp_adaptive_loop_t *entry =
+        &__kmp_adaptive_loops[(hash + i) & (KMP_ADAPTIVE_LOOPS - 1)];
+    ident_t *cur = entry->loc.load(std::memory_order_acquire);
+    if (cur == NULL) {
+      entry->chunks.store(KMP_ADAPTIVE_INIT_CHUNKS, std::memory_order_relaxed);
+      if (entry->loc.compare_exchange_strong(cur, loc,
+                                             std::memory_order_acq_rel))
+        return entry;
+    }
+    if (cur == loc)
+      return entry;
+  }
+  return NULL;
+}
+
+// Returns the chunk size of an adaptive loop with tc iterations. The first
+// thread to get here picks the number of chunks per thread for all threads of
+// the team, because static steal needs every thread to split the loop alike.
+template <typename T>
+static T __kmp_adaptive_chunk(ident_t *loc,
+                              dispatch_shared_info_template<T> volatile *sh,
+                              typename traits_t<T>::unsigned_t tc, T nproc) {
+  typedef typename traits_t<T>::unsigned_t UT;
+  kmp_int64 chunks = sh->adaptive_chunks;
+  if (chunks == 0) {
+    kmp_adaptive_loop_t *entry = __kmp_adaptive_find(loc);
+    kmp_int64 mine = entry ? entry->chunks.load(std::memory_order_relaxed)
+                           : KMP_ADAPTIVE_INIT_CHUNKS;
+    kmp_int64 start = (kmp_int64)KMP_NOW();
+    if (KMP_COMPARE_AND_STORE_ACQ64(&sh->adaptive_chunks, 0, mine))
+      sh->adaptive_start = start;
+    chunks = sh->adaptive_chunks;
+  }
+  UT chunk = tc / ((UT)nproc * (UT)chunks);
+  return chunk ? (T)chunk : (T)1;
+}
+
+// Called by every thread of an adaptive loop once it runs out of iterations.
+// The last one adjusts the chunks per thread remembered for loc and clears
+// the shared state for the next loop that uses the buffer.
+template <typename T>
+static void
+__kmp_adaptive_thread_done(ident_t *loc,
+                           dispatch_shared_info_template<T> volatile *sh,
+                           bool last) {
+  kmp_int64 now = (kmp_int64)KMP_NOW();
+  KMP_COMPARE_AND_STORE_ACQ64(&sh->adaptive_first_done, 0, now);
+  if (!last)
+    return;
+  kmp_int64 duration = now - sh->adaptive_start;
+  kmp_int64 tail = now - sh->adaptive_first_done;
+  kmp_adaptive_loop_t *entry = __kmp_adaptive_find(loc);
+  if (entry && duration > 0) {
+    kmp_int32 chunks = (kmp_int32)sh->adaptive_chunks;
+    if (tail * 16 > duration) // threads idled for over 6% of the loop
+      chunks = KMP_MIN(chunks * 2, KMP_ADAPTIVE_MAX_CHUNKS);
+    else if (tail * 64 < duration) // under 1.5%, try coarser chunks
+      chunks = KMP_MAX(chunks / 2, KMP_ADAPTIVE_MIN_CHUNKS);
+    entry->chunks.store(chunks, std::memory_order_relaxed);
+    KD_TRACE(100, ("__kmp_adaptive_thread_done: loc:%p tail:%lld "
+                   "duration:%lld chunks:%d\n",
+                   loc, (long long)tail, (long long)duration, chunks));
+  }
+  sh->adaptive_chunks = 0;
+  sh->adaptive_start = 0;
+  sh->adaptive_first_done = 0;
+}
 #endif
 
 // Initialize a dispatch_private_info_template<T> buffer for a particular
@@ -258,6 +355,8 @@ void __kmp_dispatch_init_algorithm(ident_t *loc, int gtid,
     monotonicity = SCHEDULE_MONOTONIC;
   }
 
+  pr->flags.use_adaptive = FALSE;
+
   if (schedule == kmp_sch_static) {
     schedule = __kmp_static;
   } else {
@@ -306,6 +405,14 @@ void __kmp_dispatch_init_algorithm(ident_t *loc, int gtid,
     if (schedule == kmp_sch_auto) {
       // mapping and differentiation: in the __kmp_do_serial_initialize()
       schedule = __kmp_auto;
+#if KMP_STATIC_STEAL_ENABLED
+      // Hierarchical scheduling keeps its own shared buffers, so it stays
+      // with __kmp_auto.
+      if (__kmp_auto_adaptive && active && !use_hier && !pr->flags.ordered) {
+        schedule = kmp_sch_static_steal;
+        pr->flags.use_adaptive = TRUE;
+      }
+#endif
 #ifdef KMP_DEBUG
       {
         char *buff;
@@ -408,6 +515,19 @@ void __kmp_dispatch_init_algorithm(ident_t *loc, int gtid,
   }
 #endif
 
+#if KMP_STATIC_STEAL_ENABLED
+  if (pr->flags.use_adaptive) {
+    // __kmp_dispatch_init() has already moved to the next buffer
+    kmp_uint32 idx =
+        (th->th.th_dispatch->th_disp_index - 1) % __kmp_dispatch_num_buffers;
+    dispatch_shared_info_template<T> volatile *sh =
+        reinterpret_cast<dispatch_shared_info_template<T> volatile *>(
+            &team->t.t_disp_buffer[idx]);
+    chunk = __kmp_adaptive_chunk<T>(loc, sh, tc, nproc);
+    pr->u.p.parm1 = chunk;
+  }
+#endif
+
   pr->u.p.lb = lb;
   pr->u.p.ub = ub;
   pr->u.p.st = st;
@@ -2345,6 +2465,12 @@ static int __kmp_dispatch_next(ident_t *loc, int gtid, kmp_int32 *p_last,
     // status == 0: no more iterations to execute
     if (status == 0) {
       ST num_done;
+#if KMP_STATIC_STEAL_ENABLED
+      // Record the time before num_done is bumped, the last thread clears
+      // the shared state afterwards
+      if (pr->flags.use_adaptive)
+        __kmp_adaptive_thread_done<T>(loc, sh, false);
+#endif
       num_done = test_then_inc<ST>(&sh->u.s.num_done);
 #ifdef KMP_DEBUG
       {
@@ -2384,6 +2510,8 @@ static int __kmp_dispatch_next(ident_t *loc, int gtid, kmp_int32 *p_last,
             }
           }
         }
+        if (pr->flags.use_adaptive)
+          __kmp_adaptive_thread_done<T>(loc, sh, true);
 #endif
         /* NOTE: release shared buffer to be reused */
 
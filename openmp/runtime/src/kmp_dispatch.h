@@ -179,6 +179,10 @@ template <typename T> struct dispatch_shared_info_template {
   volatile kmp_int32 doacross_buf_idx; // teamwise index
   kmp_uint32 *doacross_flags; // array of iteration flags (0/1)
   kmp_int32 doacross_num_done; // count finished threads
+  // Adaptive schedule(auto) only, see __kmp_adaptive_chunk()
+  volatile kmp_int64 adaptive_chunks; // chunks per thread of this loop
+  volatile kmp_int64 adaptive_start; // when the first thread started
+  volatile kmp_int64 adaptive_first_done; // when the first thread ran dry
 #if KMP_USE_HIER_SCHED
   kmp_hier_t<T> *hier;
 #endif
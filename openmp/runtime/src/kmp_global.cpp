@@ -113,6 +113,8 @@ char const *__kmp_barrier_type_name[bs_last_barrier] = {"plain", "forkjoin"
 };
 char const *__kmp_barrier_pattern_name[bp_last_bar] = {
     "linear", "tree", "hyper", "hierarchical", "dist"};
+int __kmp_barrier_auto = TRUE; /* KMP_BARRIER_AUTO */
+int __kmp_env_barrier = FALSE; /* KMP_*_BARRIER[_PATTERN] specified? */
 
 int __kmp_allThreadsSpecified = 0;
 size_t __kmp_align_alloc = CACHE_LINE;
@@ -149,6 +151,7 @@ enum sched_type __kmp_guided =
     kmp_sch_guided_iterative_chunked; /* default guided scheduling method */
 enum sched_type __kmp_auto =
     kmp_sch_guided_analytical_chunked; /* default auto scheduling method */
+int __kmp_auto_adaptive = FALSE; /* KMP_SCHEDULE=auto,adaptive */
 #if KMP_USE_HIER_SCHED
 int __kmp_dispatch_hand_threading = 0;
 int __kmp_hier_max_units[kmp_hier_layer_e::LAYER_LAST + 1];
@@ -354,6 +357,11 @@ KMP_BUILD_ASSERT(sizeof(kmp_tasking_flags_t) == 4);
 
 int __kmp_task_stealing_constraint = 1; /* Constrain task stealing by default */
 int __kmp_enable_task_throttling = 1;
+int __kmp_task_steal_local_tries = 4; /* KMP_TASK_STEAL_LOCAL_TRIES */
+#if KMP_AFFINITY_SUPPORTED
+/* Topology layer whose threads are preferred as victims when stealing tasks */
+kmp_hw_t __kmp_task_steal_domain = KMP_HW_UNKNOWN;
+#endif
 
 #ifdef DEBUG_SUSPEND
 int __kmp_suspend_count = 0;
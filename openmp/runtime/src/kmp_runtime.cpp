@@ -7388,6 +7388,41 @@ void __kmp_serial_initialize(void) {
   __kmp_release_bootstrap_lock(&__kmp_initz_lock);
 }
 
+#if KMP_AFFINITY_SUPPORTED
+// Switch the default barriers to the hierarchical pattern on machines with more
+// than one socket or last level cache. The hierarchical barrier takes its
+// fan-in at every level from the machine topology, so threads first
+// synchronize with their neighbours on the same core and cache and only one
+// thread per domain touches the flags of the other domains. The hyper barrier
+// ignores the topology and sends most of its traffic across sockets on such
+// machines. Barriers requested through the environment are left alone.
+static void __kmp_select_barrier_patterns() {
+  if (!__kmp_barrier_auto || __kmp_env_barrier)
+    return;
+  if (__kmp_topology == NULL || __kmp_topology->get_depth() <= 0)
+    return;
+  // Small machines are served well by the hyper barrier.
+  if (__kmp_avail_proc < 16)
+    return;
+  int domains = 1;
+  int level = __kmp_topology->get_level(KMP_HW_SOCKET);
+  if (level >= 0)
+    domains = __kmp_topology->get_count(level);
+  level = __kmp_topology->get_level(KMP_HW_LLC);
+  if (level >= 0 && __kmp_topology->get_count(level) > domains)
+    domains = __kmp_topology->get_count(level);
+  if (domains <= 1)
+    return;
+  for (int i = bs_plain_barrier; i < bs_last_barrier; i++) {
+    __kmp_barrier_gather_pattern[i] = bp_hierarchical_bar;
+    __kmp_barrier_release_pattern[i] = bp_hierarchical_bar;
+  }
+  KA_TRACE(10, ("__kmp_select_barrier_patterns: using hierarchical barriers "
+                "for %d domains and %d procs\n",
+                domains, __kmp_avail_proc));
+}
+#endif /* KMP_AFFINITY_SUPPORTED */
+
 static void __kmp_do_middle_initialize(void) {
   int i, j;
   int prev_dflt_team_nth;
@@ -7420,6 +7455,19 @@ static void __kmp_do_middle_initialize(void) {
     __kmp_avail_proc = __kmp_xproc;
   }
 
+#if KMP_AFFINITY_SUPPORTED
+  // No barrier has run yet, so the patterns can still change.
+  __kmp_select_barrier_patterns();
+  // Task stealing prefers victims on the same last level cache, or on the
+  // same socket when the cache layout is unknown.
+  if (__kmp_topology) {
+    __kmp_task_steal_domain = __kmp_topology->get_equivalent_type(KMP_HW_LLC);
+    if (__kmp_task_steal_domain == KMP_HW_UNKNOWN)
+      __kmp_task_steal_domain =
+          __kmp_topology->get_equivalent_type(KMP_HW_SOCKET);
+  }
+#endif /* KMP_AFFINITY_SUPPORTED */
+
   // If there were empty places in num_threads list (OMP_NUM_THREADS=,,2,3),
   // correct them now
   j = 0;
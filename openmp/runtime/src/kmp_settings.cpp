@@ -1701,6 +1701,7 @@ static void __kmp_stg_parse_barrier_branch_bit(char const *name,
     if ((strcmp(var, name) == 0) && (value != 0)) {
       char *comma;
 
+      __kmp_env_barrier = TRUE;
       comma = CCAST(char *, strchr(value, ','));
       __kmp_barrier_gather_branch_bits[i] =
           (kmp_uint32)__kmp_str_to_int(value, ',');
@@ -1749,6 +1750,19 @@ static void __kmp_stg_print_barrier_branch_bit(kmp_str_buf_t *buffer,
   }
 } // __kmp_stg_print_barrier_branch_bit
 
+// ----------------------------------------------------------------------------
+// KMP_BARRIER_AUTO
+
+static void __kmp_stg_parse_barrier_auto(char const *name, char const *value,
+                                         void *data) {
+  __kmp_stg_parse_bool(name, value, &__kmp_barrier_auto);
+} // __kmp_stg_parse_barrier_auto
+
+static void __kmp_stg_print_barrier_auto(kmp_str_buf_t *buffer,
+                                         char const *name, void *data) {
+  __kmp_stg_print_bool(buffer, name, __kmp_barrier_auto);
+} // __kmp_stg_print_barrier_auto
+
 // ----------------------------------------------------------------------------
 // KMP_PLAIN_BARRIER_PATTERN, KMP_FORKJOIN_BARRIER_PATTERN,
 // KMP_REDUCTION_BARRIER_PATTERN
@@ -1770,6 +1784,8 @@ static void __kmp_stg_parse_barrier_pattern(char const *name, char const *value,
       int j;
       char *comma = CCAST(char *, strchr(value, ','));
 
+      __kmp_env_barrier = TRUE;
+
       /* handle first parameter: gather pattern */
       for (j = bp_linear_bar; j < bp_last_bar; j++) {
         if (__kmp_match_with_sentinel(__kmp_barrier_pattern_name[j], value, 1,
@@ -4183,6 +4199,16 @@ static void __kmp_stg_parse_schedule(char const *name, char const *value,
               __kmp_guided = kmp_sch_guided_analytical_chunked;
               continue;
             }
+          } else if (!__kmp_strcasecmp_with_sentinel("auto", value,
+                                                     sentinel)) {
+            if (!__kmp_strcasecmp_with_sentinel("adaptive", comma, ';')) {
+              __kmp_auto_adaptive = TRUE;
+              continue;
+            } else if (!__kmp_strcasecmp_with_sentinel("default", comma,
+                                                       ';')) {
+              __kmp_auto_adaptive = FALSE;
+              continue;
+            }
           }
           KMP_WARNING(InvalidClause, name, value);
         } else
@@ -4206,10 +4232,14 @@ static void __kmp_stg_print_schedule(kmp_str_buf_t *buffer, char const *name,
     __kmp_str_buf_print(buffer, "%s", "static,balanced");
   }
   if (__kmp_guided == kmp_sch_guided_iterative_chunked) {
-    __kmp_str_buf_print(buffer, ";%s'\n", "guided,iterative");
+    __kmp_str_buf_print(buffer, ";%s", "guided,iterative");
   } else if (__kmp_guided == kmp_sch_guided_analytical_chunked) {
-    __kmp_str_buf_print(buffer, ";%s'\n", "guided,analytical");
+    __kmp_str_buf_print(buffer, ";%s", "guided,analytical");
   }
+  if (__kmp_auto_adaptive) {
+    __kmp_str_buf_print(buffer, ";%s", "auto,adaptive");
+  }
+  __kmp_str_buf_print(buffer, "'\n");
 } // __kmp_stg_print_schedule
 
 // -----------------------------------------------------------------------------
@@ -5354,6 +5384,21 @@ static void __kmp_stg_print_task_throttling(kmp_str_buf_t *buffer,
   __kmp_stg_print_bool(buffer, name, __kmp_enable_task_throttling);
 } // __kmp_stg_print_task_throttling
 
+// -----------------------------------------------------------------------------
+// KMP_TASK_STEAL_LOCAL_TRIES
+
+static void __kmp_stg_parse_task_steal_local_tries(char const *name,
+                                                   char const *value,
+                                                   void *data) {
+  __kmp_stg_parse_int(name, value, 0, 64, &__kmp_task_steal_local_tries);
+} // __kmp_stg_parse_task_steal_local_tries
+
+static void __kmp_stg_print_task_steal_local_tries(kmp_str_buf_t *buffer,
+                                                   char const *name,
+                                                   void *data) {
+  __kmp_stg_print_int(buffer, name, __kmp_task_steal_local_tries);
+} // __kmp_stg_print_task_steal_local_tries
+
 #if KMP_HAVE_MWAIT || KMP_HAVE_UMWAIT
 // -----------------------------------------------------------------------------
 // KMP_USER_LEVEL_MWAIT
@@ -5621,6 +5666,8 @@ static kmp_setting_t __kmp_stg_table[] = {
     {"KMP_ALIGN_ALLOC", __kmp_stg_parse_align_alloc,
      __kmp_stg_print_align_alloc, NULL, 0, 0},
 
+    {"KMP_BARRIER_AUTO", __kmp_stg_parse_barrier_auto,
+     __kmp_stg_print_barrier_auto, NULL, 0, 0},
     {"KMP_PLAIN_BARRIER", __kmp_stg_parse_barrier_branch_bit,
      __kmp_stg_print_barrier_branch_bit, NULL, 0, 0},
     {"KMP_PLAIN_BARRIER_PATTERN", __kmp_stg_parse_barrier_pattern,
@@ -5743,6 +5790,8 @@ static kmp_setting_t __kmp_stg_table[] = {
 #endif
     {"KMP_ENABLE_TASK_THROTTLING", __kmp_stg_parse_task_throttling,
      __kmp_stg_print_task_throttling, NULL, 0, 0},
+    {"KMP_TASK_STEAL_LOCAL_TRIES", __kmp_stg_parse_task_steal_local_tries,
+     __kmp_stg_print_task_steal_local_tries, NULL, 0, 0},
 
     {"OMP_DISPLAY_ENV", __kmp_stg_parse_omp_display_env,
      __kmp_stg_print_omp_display_env, NULL, 0, 0},
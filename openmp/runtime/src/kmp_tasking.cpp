@@ -3350,6 +3350,20 @@ static kmp_task_t *__kmp_steal_task(kmp_int32 victim_tid, kmp_int32 gtid,
   return task;
 }
 
+#if KMP_AFFINITY_SUPPORTED
+// Tells whether victim shares the cache domain of thief. Tasks stolen from such
+// a victim were likely created from data that is still in the shared cache.
+// Threads that are not bound to a single domain have no preferred victims.
+static inline bool __kmp_is_local_victim(kmp_info_t *thief,
+                                         kmp_info_t *victim) {
+  kmp_hw_t type = __kmp_task_steal_domain;
+  if (type == KMP_HW_UNKNOWN)
+    return true;
+  int id = thief->th.th_topology_ids.ids[type];
+  return id < 0 || id == victim->th.th_topology_ids.ids[type];
+}
+#endif
+
 // __kmp_execute_tasks_template: Choose and execute tasks until either the
 // condition is statisfied (return true) or there are none left (return false).
 //
@@ -3418,6 +3432,7 @@ static inline int __kmp_execute_tasks_template(
           asleep = 0;
         } else if (!new_victim) { // no recent steals and we haven't already
           // used a new victim; select a random thread
+          int local_tries = __kmp_task_steal_local_tries;
           do { // Find a different thread to steal work from.
             // Pick a random thread. Initial plan was to cycle through all the
             // threads, and only return if we tried to steal from every thread,
@@ -3428,6 +3443,17 @@ static inline int __kmp_execute_tasks_template(
             }
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
+#if KMP_AFFINITY_SUPPORTED
+            // Draw again a few times if the victim is on another cache domain,
+            // then take whichever thread comes up so that remote work is still
+            // found.
+            if (local_tries > 0 &&
+                !__kmp_is_local_victim(thread, other_thread)) {
+              --local_tries;
+              asleep = 1;
+              continue;
+            }
+#endif
             // There is a slight chance that __kmp_enable_tasking() did not wake
             // up all threads waiting at the barrier.  If victim is sleeping,
             // then wake it up. Since we were going to pay the cache miss
@@ -0,0 +1,53 @@
+// RUN: %libomp-compile
+// RUN: env KMP_BARRIER_AUTO=true %libomp-run
+// RUN: env KMP_BARRIER_AUTO=false %libomp-run
+// RUN: env KMP_BARRIER_AUTO=true KMP_FORKJOIN_BARRIER_PATTERN=hyper,hyper \
+// RUN:   %libomp-run
+// RUN: env KMP_BARRIER_AUTO=true OMP_PROC_BIND=close %libomp-run
+//
+// Check that the barriers stay correct whichever pattern the runtime picks
+// from the machine topology, for teams smaller and larger than the machine.
+#include <stdio.h>
+#include "omp_testsuite.h"
+
+#define ROUNDS 100
+
+static int run(int nthreads) {
+  int counts[ROUNDS] = {0};
+  int errors = 0;
+#pragma omp parallel num_threads(nthreads) reduction(+ : errors)
+  {
+    int n = omp_get_num_threads();
+    for (int i = 0; i < ROUNDS; ++i) {
+#pragma omp atomic
+      counts[i]++;
+#pragma omp barrier
+      int seen;
+#pragma omp atomic read
+      seen = counts[i];
+      if (seen != n)
+        errors++;
+    }
+  }
+  int sum = 0;
+#pragma omp parallel for num_threads(nthreads) reduction(+ : sum)
+  for (int i = 0; i < 1000; ++i)
+    sum += i;
+  if (sum != 999 * 1000 / 2)
+    errors++;
+  return errors;
+}
+
+int main() {
+  int procs = omp_get_num_procs();
+  int errors = 0;
+  errors += run(1);
+  errors += run(2);
+  errors += run(procs);
+  errors += run(procs + 3);
+  if (errors) {
+    fprintf(stderr, "%d errors\n", errors);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,47 @@
+// RUN: %libomp-compile
+// RUN: env KMP_SCHEDULE=auto,adaptive %libomp-run
+// RUN: env KMP_SCHEDULE=auto,adaptive OMP_SCHEDULE=auto %libomp-run
+//
+// Check that every iteration of an adaptive schedule(auto) loop runs exactly
+// once while the chunk size changes between executions of the same loop,
+// including nowait loops that overlap with the next one.
+#include <stdio.h>
+#include <stdlib.h>
+#include "omp_testsuite.h"
+
+#define N 10007
+#define REPS 50
+
+static int count[N];
+
+// Iterations near the end are much more expensive than the others.
+static void work(int i) {
+  volatile int x = 0;
+  int cost = i > N - N / 8 ? 2000 : 10;
+  for (int j = 0; j < cost; ++j)
+    x += j;
+#pragma omp atomic
+  count[i]++;
+}
+
+int main() {
+  int errors = 0;
+  for (int rep = 0; rep < REPS; ++rep) {
+#pragma omp parallel
+    {
+#pragma omp for schedule(auto) nowait
+      for (int i = 0; i < N; ++i)
+        work(i);
+#pragma omp for schedule(runtime)
+      for (long long i = 0; i < N; ++i)
+        work((int)i);
+    }
+  }
+  for (int i = 0; i < N; ++i) {
+    if (count[i] != 2 * REPS) {
+      if (errors++ < 10)
+        fprintf(stderr, "count[%d] = %d\n", i, count[i]);
+    }
+  }
+  return errors != 0;
+}
@@ -26,6 +26,7 @@
 #include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLTools.h"
 #include "llvm/ADT/Sequence.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Debug.h"
 #include "isl/aff.h"
 #include "isl/ctx.h"
@@ -48,6 +49,9 @@ static cl::opt<int> OptComputeOut(
              "computational steps (0 means no bound)"),
     cl::Hidden, cl::init(500000), cl::cat(PollyCategory));
 
+STATISTIC(DepsComputeOut, "Number of dependence computations that exceeded "
+                          "the computeout");
+
 static cl::opt<bool>
     LegalityCheckDisabled("disable-polly-legality",
                           cl::desc("Disable polly legality check"), cl::Hidden,
@@ -479,6 +483,7 @@ void Dependences::calculateDependences(Scop &S) {
   }
 
   if (isl_ctx_last_error(IslCtx.get()) == isl_error_quota) {
+    DepsComputeOut++;
     isl_union_map_free(RAW);
     isl_union_map_free(WAW);
     isl_union_map_free(WAR);
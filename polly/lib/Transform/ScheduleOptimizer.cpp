@@ -60,6 +60,7 @@
 #include "llvm/InitializePasses.h"
 #include "llvm/Support/CommandLine.h"
 #include "isl/options.h"
+#include <chrono>
 
 using namespace llvm;
 using namespace polly;
@@ -104,6 +105,13 @@ static cl::opt<int>
                        cl::Hidden, cl::init(300000), cl::ZeroOrMore,
                        cl::cat(PollyCategory));
 
+static cl::opt<bool> ScheduleComputeOutFallback(
+    "polly-schedule-computeout-fallback",
+    cl::desc("When the scheduler exceeds its computeout, retry with a cheaper "
+             "configuration that does not fuse SCCs, so that tiling can still "
+             "be applied"),
+    cl::Hidden, cl::init(true), cl::cat(PollyCategory));
+
 static cl::opt<bool>
     GreedyFusion("polly-loopfusion-greedy",
                  cl::desc("Aggressively try to fuse everything"), cl::Hidden,
@@ -201,6 +209,10 @@ static cl::opt<bool> OptimizedScops(
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
+STATISTIC(ScopsScheduleComputeOut,
+          "Number of scops whose scheduling exceeded the computeout");
+STATISTIC(ScopsScheduleFallback,
+          "Number of scops scheduled with the computeout fallback");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
 STATISTIC(NumBoxedLoopsOptimized, "Number of boxed loops optimized");
@@ -869,17 +881,63 @@ static void runIslScheduleOptimizer(
     SC = SC.set_validity(Validity);
     SC = SC.set_coincidence(Validity);
 
+    auto ScheduleStart = std::chrono::steady_clock::now();
+    bool ComputedOut = false;
     {
       IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
       Schedule = SC.compute_schedule();
 
-      if (MaxOpGuard.hasQuotaExceeded())
+      if (MaxOpGuard.hasQuotaExceeded()) {
         POLLY_DEBUG(
             dbgs() << "Schedule optimizer calculation exceeds ISL quota\n");
+        ScopsScheduleComputeOut++;
+        ComputedOut = true;
+      }
+    }
+
+    // Scheduling the SCoP as a whole was too expensive. Scheduling every SCC
+    // on its own is a much smaller problem and still yields permutable bands,
+    // so tiling and prevectorization can be applied, only fusion is lost.
+    bool FellBack = false;
+    if (ComputedOut && ScheduleComputeOutFallback) {
+      int OldSerializeSCCs = isl_options_get_schedule_serialize_sccs(Ctx);
+      isl_options_set_schedule_serialize_sccs(Ctx, 1);
+      isl_options_set_schedule_outer_coincidence(Ctx, 0);
+      {
+        IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
+        Schedule = SC.compute_schedule();
+
+        if (MaxOpGuard.hasQuotaExceeded())
+          POLLY_DEBUG(dbgs() << "Fallback schedule calculation exceeds ISL "
+                                "quota as well\n");
+        else
+          FellBack = true;
+      }
+      isl_options_set_schedule_serialize_sccs(Ctx, OldSerializeSCCs);
     }
 
     isl_options_set_on_error(Ctx, OnErrorStatus);
 
+    if (ComputedOut) {
+      auto Millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - ScheduleStart)
+                        .count();
+      if (FellBack)
+        ScopsScheduleFallback++;
+      POLLY_DEBUG(dbgs() << "Spent " << Millis << " ms scheduling\n");
+      if (ORE) {
+        DebugLoc Begin, End;
+        getDebugLocations(getBBPairForRegion(&S.getRegion()), Begin, End);
+        OptimizationRemarkAnalysis R(DEBUG_TYPE, "ScheduleComputeOut", Begin,
+                                     S.getEntry());
+        R << "maximal number of operations exceeded during scheduling; "
+          << (FellBack ? "scheduled SCCs separately"
+                       : "keeping the original schedule")
+          << " (" << ore::NV("Milliseconds", (int64_t)Millis) << " ms)";
+        ORE->emit(R);
+      }
+    }
+
     ScopsRescheduled++;
     POLLY_DEBUG(printSchedule(dbgs(), Schedule, "After rescheduling"));
   }